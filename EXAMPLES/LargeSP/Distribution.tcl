@@ -0,0 +1,53 @@
+# ----------------------------------------------------------------------
+# Times the distribution of a large brick model to the subdomains.
+#
+#   mpirun -np 8 OpenSeesSP Distribution.tcl ?nz? ?sendBuffer?
+#
+# nz is the number of element layers (10 x 10 bricks each, default 400)
+# and sendBuffer the bytes held per channel while the model is sent
+# (default 4194304; 0 sends every message as it is given).
+# ----------------------------------------------------------------------
+
+set nz 400
+set sendBuffer 4194304
+if {[llength $argv] > 0} {set nz [lindex $argv 0]}
+if {[llength $argv] > 1} {set sendBuffer [lindex $argv 1]}
+
+model basic -ndm 3 -ndf 3
+
+nDMaterial ElasticIsotropic   1   100   0.25  1.27
+
+set nx 10
+set ny 10
+set nn [expr ($nz+1)*($nx+1)*($ny+1) ]
+
+block3D $nx $ny $nz   1 1  stdBrick  "1" {
+    1   -1     -1      0
+    2    1     -1      0
+    3    1      1      0
+    4   -1      1      0 
+    5   -1     -1     10
+    6    1     -1     10
+    7    1      1     10
+    8   -1      1     10
+}
+
+pattern Plain 1 Linear {
+   load $nn  0.1  0.1  0.0
+}
+
+fixZ 0.0   1 1 1 
+
+integrator LoadControl  1.0  1 
+test NormUnbalance     1.0e-10    20     0
+algorithm Newton
+numberer RCM
+constraints Plain
+system Mumps
+analysis Static
+
+set start [clock microseconds]
+partition -sendBuffer $sendBuffer
+set end [clock microseconds]
+
+puts "distributed [expr $nx*$ny*$nz] elements and $nn nodes with a send buffer of $sendBuffer bytes in [expr ($end-$start)/1.0e6] s"
@@ -0,0 +1,106 @@
+# ----------------------------------------------------------------------
+# Measures the memory and throughput of the subdomains run with threads.
+#
+#   mpirun -np 3 OpenSeesSP Threads.tcl ?nz? ?numThreads? ?numSteps?
+#   OpenSees Threads.tcl ?nz? ?numThreads? ?numSteps?
+#
+# A block of 10 x 10 x nz plastic bricks (default nz 40) is pushed in
+# numSteps load steps (default 10). With more than one process the model
+# is partitioned with -threads numThreads (default 1); otherwise the
+# domain itself is given the threads. Run it with np processes and 1
+# thread and then with fewer processes and more threads to compare them.
+#
+# Printed are the steps per second of the analysis and the resident
+# memory, at its peak, of this process and of all the OpenSees processes
+# on this machine (from ps, if there is one).
+# ----------------------------------------------------------------------
+
+set nz 40
+set nThreads 1
+set nSteps 10
+if {[llength $argv] > 0} {set nz [lindex $argv 0]}
+if {[llength $argv] > 1} {set nThreads [lindex $argv 1]}
+if {[llength $argv] > 2} {set nSteps [lindex $argv 2]}
+
+model basic -ndm 3 -ndf 3
+
+nDMaterial J2Plasticity 1 100.0 50.0 0.2 0.3 0.0 1.0
+
+set nx 10
+set ny 10
+set nn [expr ($nz+1)*($nx+1)*($ny+1) ]
+
+block3D $nx $ny $nz   1 1  stdBrick  "1" {
+    1   -1     -1      0
+    2    1     -1      0
+    3    1      1      0
+    4   -1      1      0 
+    5   -1     -1     10
+    6    1     -1     10
+    7    1      1     10
+    8   -1      1     10
+}
+
+pattern Plain 1 Linear {
+   load $nn  0.002  0.002  0.0
+}
+
+fixZ 0.0   1 1 1 
+
+integrator LoadControl  [expr 1.0/$nSteps]
+test NormDispIncr     1.0e-8    20     0
+algorithm Newton
+numberer RCM
+constraints Plain
+if {[getNP] > 1} {
+    system Mumps
+} else {
+    system ProfileSPD
+}
+analysis Static
+
+if {[getNP] > 1} {
+    partition -threads $nThreads
+} else {
+    threads $nThreads
+}
+
+set start [clock microseconds]
+set ok [analyze $nSteps]
+set end [clock microseconds]
+
+# the peak resident memory of this process, in kB
+proc peakMemory {} {
+    if {[catch {open /proc/[pid]/status r} in]} {
+	return 0
+    }
+    set peak 0
+    foreach line [split [read $in] "\n"] {
+	if {[lindex $line 0] == "VmHWM:"} {
+	    set peak [lindex $line 1]
+	}
+    }
+    close $in
+    return $peak
+}
+
+# the resident memory of all the OpenSees processes, in kB
+proc totalMemory {} {
+    if {[catch {exec ps -eo rss=,comm=} lines]} {
+	return 0
+    }
+    set total 0
+    foreach line [split $lines "\n"] {
+	if {[string match OpenSees* [lindex $line 1]]} {
+	    incr total [lindex $line 0]
+	}
+    }
+    return $total
+}
+
+set seconds [expr ($end-$start)/1.0e6]
+puts "[expr $nx*$ny*$nz] bricks on [getNP] processes with $nThreads threads: ok $ok"
+puts [format "  %.3f s, %.2f steps/s" $seconds [expr $nSteps/$seconds]]
+puts "  peak memory of this process [peakMemory] kB, all OpenSees processes [totalMemory] kB"
+
+wipe
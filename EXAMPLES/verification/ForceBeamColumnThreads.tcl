@@ -0,0 +1,183 @@
+# Threaded state determination of force based beam-columns
+
+# Two and three dimensional frames of force based fiber beam-columns with
+# distributed element loads and P-Delta columns are analysed with one
+# thread and then with eight threads, first with Newton and then with the
+# initial stiffness of ModifiedNewton. The nodal displacements and the element forces obtained
+# from the threads must agree with the serial ones. The reinforcement is
+# Steel01: Steel02 takes a reversal from the sign of a strain increment,
+# and the round-off of the threaded assembly flips that sign for fibers
+# whose strain hardly changes.
+
+puts "ForceBeamColumnThreads.tcl: Verification of threaded force based beam-columns"
+
+proc forceBeamColumnThreadsRun {ndm nThreads} {
+
+    wipe
+    if {$ndm == 2} {
+	model Basic -ndm 2 -ndf 3
+    } else {
+	model Basic -ndm 3 -ndf 6
+    }
+
+    threads $nThreads
+
+    uniaxialMaterial Concrete02 1 -4.0 -0.002 -0.8 -0.006 0.1 0.4 200.0
+    uniaxialMaterial Steel01 2 60.0 29000.0 0.01
+
+    if {$ndm == 2} {
+	section Fiber 1 {
+	    patch rect 1 10 1 -9.0 -6.0 9.0 6.0
+	    layer straight 2 3 0.79 -7.0 -4.0 -7.0 4.0
+	    layer straight 2 3 0.79  7.0 -4.0  7.0 4.0
+	}
+	geomTransf Linear 1
+	geomTransf PDelta 3
+	set loadArgs {0.0 0.0}
+	set beamLoad {-0.02}
+    } else {
+	section Fiber 1 -GJ 1.0e6 {
+	    patch rect 1 6 6 -9.0 -6.0 9.0 6.0
+	    layer straight 2 3 0.79 -7.0 -4.0 -7.0 4.0
+	    layer straight 2 3 0.79  7.0 -4.0  7.0 4.0
+	}
+	geomTransf Linear 1 1.0 0.0 0.0
+	geomTransf Linear 2 0.0 0.0 1.0
+	geomTransf PDelta 3 1.0 0.0 0.0
+	set loadArgs {0.0 0.0 0.0 0.0 0.0}
+	set beamLoad {-0.02 0.0}
+    }
+
+    # columns along x, storeys along y; in 3d the frame is doubled along z
+    set nBays 6
+    set nStoreys 5
+    set nFrames [expr $ndm == 2 ? 1 : 2]
+    set H 120.0
+    set B 240.0
+
+    for {set k 0} {$k < $nFrames} {incr k} {
+	for {set j 0} {$j <= $nStoreys} {incr j} {
+	    for {set i 0} {$i <= $nBays} {incr i} {
+		set n [expr 1000*$k+100*$j+$i+1]
+		if {$ndm == 2} {
+		    node $n [expr $i*$B] [expr $j*$H]
+		    if {$j == 0} {fix $n 1 1 1}
+		} else {
+		    node $n [expr $i*$B] [expr $j*$H] [expr $k*$B]
+		    if {$j == 0} {fix $n 1 1 1 1 1 1}
+		}
+	    }
+	}
+    }
+
+    set beams {}
+    set e 0
+    for {set k 0} {$k < $nFrames} {incr k} {
+	for {set j 0} {$j < $nStoreys} {incr j} {
+	    for {set i 0} {$i <= $nBays} {incr i} {
+		set nI [expr 1000*$k+100*$j+$i+1]
+		element forceBeamColumn [incr e] $nI [expr $nI+100] 5 1 3
+	    }
+	    for {set i 0} {$i < $nBays} {incr i} {
+		set nI [expr 1000*$k+100*($j+1)+$i+1]
+		element forceBeamColumn [incr e] $nI [expr $nI+1] 4 1 [expr $ndm == 2 ? 1 : 2]
+		lappend beams $e
+	    }
+	}
+    }
+    if {$nFrames == 2} {
+	for {set j 1} {$j <= $nStoreys} {incr j} {
+	    for {set i 0} {$i <= $nBays} {incr i} {
+		set nI [expr 100*$j+$i+1]
+		element forceBeamColumn [incr e] $nI [expr $nI+1000] 4 1 1
+	    }
+	}
+    }
+    set numEle $e
+
+    timeSeries Constant 1
+    pattern Plain 1 1 {
+	eval eleLoad -ele $beams -type -beamUniform $beamLoad
+    }
+
+    constraints Plain
+    numberer RCM
+    system BandGeneral
+    test NormDispIncr 1.0e-10 50
+    algorithm Newton
+    integrator LoadControl 0.1
+    analysis Static
+    if {[analyze 10] != 0} {
+	return {}
+    }
+    loadConst -time 0.0
+
+    set top [expr 100*$nStoreys+1]
+    timeSeries Linear 2
+    pattern Plain 2 2 {
+	for {set j 1} {$j <= $nStoreys} {incr j} {
+	    eval load [expr 100*$j+1] [expr 0.2*$j] $loadArgs
+	}
+    }
+
+    set response {}
+    foreach algo {Newton {ModifiedNewton -initial}} dU {0.1 -0.05} nSteps {30 30} {
+	eval algorithm $algo
+	integrator DisplacementControl $top 1 $dU
+	analysis Static
+	for {set n 0} {$n < $nSteps} {incr n} {
+	    if {[analyze 1] != 0} {
+		return {}
+	    }
+	    lappend response [getLoadFactor 2]
+	    for {set j 1} {$j <= $nStoreys} {incr j} {
+		lappend response [nodeDisp [expr 100*$j+1] 1] [nodeDisp [expr 100*$j+$nBays+1] 2]
+	    }
+	}
+    }
+    for {set e 1} {$e <= $numEle} {incr e} {
+	foreach f [eleResponse $e force] {
+	    lappend response $f
+	}
+    }
+
+    return $response
+}
+
+set testOK 0
+foreach ndm {2 3} {
+    set serial [forceBeamColumnThreadsRun $ndm 1]
+    set threaded [forceBeamColumnThreadsRun $ndm 8]
+
+    if {[llength $serial] == 0 || [llength $serial] != [llength $threaded]} {
+	set testOK -1
+	puts "failed to complete the analyses in ${ndm}d"
+	continue
+    }
+
+    set tol 1.0e-8
+    set maxDiff 0.0
+    foreach a $serial b $threaded {
+	set diff [expr abs($a-$b)/(1.0+abs($a))]
+	if {$diff > $maxDiff} {
+	    set maxDiff $diff
+	}
+    }
+    puts [format "\n%10s%15s\n%10s%15d\n%10s%15.4e" Model: ${ndm}d Values: [llength $serial] MaxDiff: $maxDiff]
+    if {$maxDiff > $tol} {
+	set testOK -1
+	puts "failed threaded response in ${ndm}d -> $maxDiff $tol"
+    }
+}
+threads 1
+wipe
+
+set results [open results.out a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test ForceBeamColumnThreads.tcl \n\n"
+    puts $results "PASSED : ForceBeamColumnThreads.tcl"
+} else {
+    puts "\nFAILED Verification Test ForceBeamColumnThreads.tcl \n\n"
+    puts $results "FAILED : ForceBeamColumnThreads.tcl"
+}
+close $results
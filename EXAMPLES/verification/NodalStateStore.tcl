@@ -0,0 +1,117 @@
+# Contiguous nodal state
+
+# A braced two storey frame with yielding braces is loaded dynamically,
+# first with the nodes keeping their own response and then with the
+# response of all the nodes in a NodalStateStore, which commits and
+# reverts them in passes over its blocks. Steps that do not converge in a
+# few iterations are reverted and taken again with more. The response
+# must not change.
+
+puts "NodalStateStore.tcl: Verification of the nodal state store"
+
+proc nodalStateStoreRun {useStore} {
+
+    wipe
+    model Basic -ndm 2 -ndf 3
+
+    nodalStateStore $useStore
+
+    node 1 0.0 0.0
+    node 2 240.0 0.0
+    node 3 0.0 144.0 -mass 0.5 0.5 0.0
+    node 4 240.0 144.0 -mass 0.5 0.5 0.0
+    node 5 0.0 288.0 -mass 0.4 0.4 0.0
+    node 6 240.0 288.0 -mass 0.4 0.4 0.0
+    fix 1 1 1 1
+    fix 2 1 1 1
+
+    uniaxialMaterial Steel01 1 36.0 29000.0 0.02
+
+    geomTransf PDelta 1
+    element elasticBeamColumn 1 1 3 20.0 29000.0 800.0 1
+    element elasticBeamColumn 2 2 4 20.0 29000.0 800.0 1
+    element elasticBeamColumn 3 3 5 20.0 29000.0 800.0 1
+    element elasticBeamColumn 4 4 6 20.0 29000.0 800.0 1
+    element elasticBeamColumn 5 3 4 20.0 29000.0 1200.0 1
+    element elasticBeamColumn 6 5 6 20.0 29000.0 1200.0 1
+    element truss 7 1 4 2.0 1
+    element truss 8 2 3 2.0 1
+    element truss 9 3 6 1.5 1
+    element truss 10 4 5 1.5 1
+
+    rayleigh 0.0 0.0 0.0 0.001
+
+    timeSeries Trig 1 0.0 100.0 0.6 -factor 30.0
+    pattern Plain 1 1 {
+	load 3 0.5 0.0 0.0
+	load 5 1.0 0.0 0.0
+    }
+
+    constraints Plain
+    numberer RCM
+    system BandGeneral
+    algorithm Newton
+    integrator Newmark 0.5 0.25
+    analysis Transient
+
+    set response {}
+    set numReverted 0
+    for {set i 0} {$i < 200} {incr i} {
+	test NormDispIncr 1.0e-12 4
+	if {[analyze 1 0.01] != 0} {
+	    incr numReverted
+	    test NormDispIncr 1.0e-12 50
+	    if {[analyze 1 0.01] != 0} {
+		return {}
+	    }
+	}
+	foreach node {3 4 5 6} {
+	    lappend response [nodeDisp $node 1] [nodeVel $node 1] [nodeAccel $node 1]
+	}
+	lappend response [lindex [eleResponse 9 axialForce] 0]
+    }
+    lappend response $numReverted [nodalStateStore]
+
+    return $response
+}
+
+set testOK 0
+set withoutStore [nodalStateStoreRun off]
+set withStore [nodalStateStoreRun on]
+wipe
+nodalStateStore off
+
+if {[llength $withoutStore] == 0 || [llength $withoutStore] != [llength $withStore]} {
+    set testOK -1
+    puts "failed to complete the analysis"
+} elseif {[lindex $withoutStore end] != 0 || [lindex $withStore end] != 1} {
+    set testOK -1
+    puts "the store was not switched off and on"
+} else {
+    set maxDiff 0.0
+    foreach a [lrange $withoutStore 0 end-1] b [lrange $withStore 0 end-1] {
+	set diff [expr abs($a-$b)]
+	if {$diff > $maxDiff} {
+	    set maxDiff $diff
+	}
+    }
+    puts [format "%15s%5d%15s%15.4e" Reverted: [lindex $withStore end-1] MaxDiff: $maxDiff]
+    if {[lindex $withStore end-1] == 0} {
+	set testOK -1
+	puts "no step was reverted"
+    }
+    if {$maxDiff != 0.0} {
+	set testOK -1
+	puts "failed response with the store -> $maxDiff"
+    }
+}
+
+set results [open results.out a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test NodalStateStore.tcl \n\n"
+    puts $results "PASSED : NodalStateStore.tcl"
+} else {
+    puts "\nFAILED Verification Test NodalStateStore.tcl \n\n"
+    puts $results "FAILED : NodalStateStore.tcl"
+}
+close $results
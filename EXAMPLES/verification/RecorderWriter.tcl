@@ -0,0 +1,99 @@
+# Background recorder writer
+
+# A two storey frame is loaded dynamically with node and element recorders
+# writing to files, first directly and then through the background writer
+# with a ring buffer small enough to wrap many times. The files must be the
+# same once the recorders are removed.
+
+puts "RecorderWriter.tcl: Verification of the background recorder writer"
+
+proc recorderWriterRun {useWriter suffix} {
+
+    wipe
+    model Basic -ndm 2 -ndf 3
+
+    if {$useWriter} {
+	recorderWriter on -buffer 0.01 -flush 0.0
+    } else {
+	recorderWriter off
+    }
+
+    node 1 0.0 0.0
+    node 2 240.0 0.0
+    node 3 0.0 144.0 -mass 0.5 0.5 0.0
+    node 4 240.0 144.0 -mass 0.5 0.5 0.0
+    node 5 0.0 288.0 -mass 0.4 0.4 0.0
+    node 6 240.0 288.0 -mass 0.4 0.4 0.0
+    fix 1 1 1 1
+    fix 2 1 1 1
+
+    geomTransf Linear 1
+    element elasticBeamColumn 1 1 3 20.0 29000.0 800.0 1
+    element elasticBeamColumn 2 2 4 20.0 29000.0 800.0 1
+    element elasticBeamColumn 3 3 5 20.0 29000.0 800.0 1
+    element elasticBeamColumn 4 4 6 20.0 29000.0 800.0 1
+    element elasticBeamColumn 5 3 4 20.0 29000.0 1200.0 1
+    element elasticBeamColumn 6 5 6 20.0 29000.0 1200.0 1
+
+    timeSeries Trig 1 0.0 100.0 0.6 -factor 30.0
+    pattern Plain 1 1 {
+	load 3 0.5 0.0 0.0
+	load 5 1.0 0.0 0.0
+    }
+
+    recorder Node -file nodeDisp$suffix.out -time -node 3 4 5 6 -dof 1 2 3 disp
+    recorder Node -file nodeAccel$suffix.out -node 3 5 -dof 1 accel
+    recorder Element -file eleForce$suffix.out -time -ele 1 2 3 4 5 6 localForce
+
+    constraints Plain
+    numberer RCM
+    system BandGeneral
+    test NormDispIncr 1.0e-12 10
+    algorithm Newton
+    integrator Newmark 0.5 0.25
+    analysis Transient
+
+    set ok [analyze 500 0.01]
+    set running [recorderWriter]
+    remove recorders
+
+    return [list $ok $running]
+}
+
+proc recorderWriterRead {fileName} {
+    set theFile [open $fileName r]
+    set contents [read $theFile]
+    close $theFile
+    return $contents
+}
+
+set testOK 0
+set direct [recorderWriterRun 0 Direct]
+set written [recorderWriterRun 1 Writer]
+wipe
+recorderWriter off
+
+if {$direct != {0 0} || $written != {0 1}} {
+    set testOK -1
+    puts "failed to run the analyses -> $direct $written"
+}
+
+foreach name {nodeDisp nodeAccel eleForce} {
+    set a [recorderWriterRead ${name}Direct.out]
+    set b [recorderWriterRead ${name}Writer.out]
+    puts [format "%15s%10d%10d" $name [llength [split $a \n]] [llength [split $b \n]]]
+    if {[llength [split $a \n]] < 500 || $a != $b} {
+	set testOK -1
+	puts "failed file $name"
+    }
+}
+
+set results [open results.out a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test RecorderWriter.tcl \n\n"
+    puts $results "PASSED : RecorderWriter.tcl"
+} else {
+    puts "\nFAILED Verification Test RecorderWriter.tcl \n\n"
+    puts $results "FAILED : RecorderWriter.tcl"
+}
+close $results
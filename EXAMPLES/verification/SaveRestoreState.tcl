@@ -0,0 +1,95 @@
+# In-memory states of the domain
+
+# A braced portal frame with yielding braces is loaded dynamically. The
+# committed state is saved halfway through and the analysis continued; it
+# is then restored twice and the analysis continued each time. The
+# response after each restore must be that after the save, which needs
+# the Newmark integrator to take its history from the restored nodes.
+
+puts "SaveRestoreState.tcl: Verification of saveState and restoreState"
+
+wipe
+model Basic -ndm 2 -ndf 3
+
+node 1 0.0 0.0
+node 2 240.0 0.0
+node 3 0.0 144.0 -mass 0.5 0.5 0.0
+node 4 240.0 144.0 -mass 0.5 0.5 0.0
+fix 1 1 1 1
+fix 2 1 1 1
+
+uniaxialMaterial Steel01 1 36.0 29000.0 0.02
+
+geomTransf Linear 1
+element elasticBeamColumn 1 1 3 20.0 29000.0 800.0 1
+element elasticBeamColumn 2 2 4 20.0 29000.0 800.0 1
+element elasticBeamColumn 3 3 4 20.0 29000.0 1200.0 1
+element truss 4 1 4 2.0 1
+element truss 5 2 3 2.0 1
+
+rayleigh 0.0 0.0 0.0 0.001
+
+timeSeries Trig 1 0.0 100.0 0.6 -factor 30.0
+pattern Plain 1 1 {
+    load 3 1.0 0.0 0.0
+}
+
+constraints Plain
+numberer RCM
+system BandGeneral
+test NormDispIncr 1.0e-12 50
+algorithm Newton
+integrator Newmark 0.5 0.25
+analysis Transient
+
+proc saveRestoreStateRun {nSteps} {
+    set response {}
+    for {set i 0} {$i < $nSteps} {incr i} {
+	if {[analyze 1 0.01] != 0} {
+	    return {}
+	}
+	lappend response [getTime] [nodeDisp 3 1] [nodeVel 3 1] [nodeAccel 3 1] \
+	    [lindex [eleResponse 4 axialForce] 0]
+    }
+    return $response
+}
+
+saveRestoreStateRun 100
+saveState 1
+set saved [saveRestoreStateRun 100]
+
+set testOK 0
+foreach restore {1 2} {
+    restoreState 1
+    set restored [saveRestoreStateRun 100]
+
+    if {[llength $saved] == 0 || [llength $saved] != [llength $restored]} {
+	set testOK -1
+	puts "failed to complete the analysis after restore $restore"
+	continue
+    }
+    set maxDiff 0.0
+    foreach a $saved b $restored {
+	set diff [expr abs($a-$b)/(1.0+abs($a))]
+	if {$diff > $maxDiff} {
+	    set maxDiff $diff
+	}
+    }
+    puts [format "%10s%5d%15s%15.4e" Restore: $restore MaxDiff: $maxDiff]
+    if {$maxDiff > 1.0e-10} {
+	set testOK -1
+	puts "failed response after restore $restore -> $maxDiff"
+    }
+}
+removeState 1
+wipe
+
+set results [open results.out a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test SaveRestoreState.tcl \n\n"
+    puts $results "PASSED : SaveRestoreState.tcl"
+} else {
+    puts "\nFAILED Verification Test SaveRestoreState.tcl \n\n"
+    puts $results "FAILED : SaveRestoreState.tcl"
+}
+close $results
@@ -0,0 +1,150 @@
+# Snapshots of the analysis
+
+# A braced portal frame with a yielding brace is loaded dynamically and
+# then pushed statically. Halfway through each analysis a snapshot is
+# saved and the analysis continued; the snapshot is then restored, in the
+# same domain and, for the dynamic analysis, after wipe, and the analysis
+# continued again. The response after each restore must be that after
+# the save.
+
+puts "Snapshot.tcl: Verification of snapshot save and restore"
+
+set snapshotFile snapshot.bin
+
+proc snapshotModel {} {
+
+    wipe
+    model Basic -ndm 2 -ndf 3
+
+    node 1 0.0 0.0
+    node 2 240.0 0.0
+    node 3 0.0 144.0 -mass 0.5 0.5 0.0
+    node 4 240.0 144.0 -mass 0.5 0.5 0.0
+    fix 1 1 1 1
+    fix 2 1 1 1
+
+    uniaxialMaterial Steel01 1 36.0 29000.0 0.02
+
+    geomTransf Linear 1
+    element elasticBeamColumn 1 1 3 20.0 29000.0 800.0 1
+    element elasticBeamColumn 2 2 4 20.0 29000.0 800.0 1
+    element elasticBeamColumn 3 3 4 20.0 29000.0 1200.0 1
+    element truss 4 1 4 2.0 1
+    element truss 5 2 3 2.0 1
+
+    rayleigh 0.0 0.0 0.0 0.001
+}
+
+proc snapshotTransientAnalysis {} {
+    constraints Plain
+    numberer RCM
+    system BandGeneral
+    test NormDispIncr 1.0e-12 50
+    algorithm Newton
+    integrator Newmark 0.5 0.25
+    analysis Transient
+}
+
+proc snapshotStaticAnalysis {} {
+    constraints Plain
+    numberer RCM
+    system BandGeneral
+    test NormDispIncr 1.0e-12 50
+    algorithm Newton
+    integrator LoadControl 0.5 3 0.05 1.0
+    analysis Static
+}
+
+# the response of nSteps steps, dt 0 for a static analysis
+proc snapshotRun {nSteps dt} {
+    set response {}
+    for {set i 0} {$i < $nSteps} {incr i} {
+	if {$dt > 0.0} {
+	    set ok [analyze 1 $dt]
+	} else {
+	    set ok [analyze 1]
+	}
+	if {$ok != 0} {
+	    return {}
+	}
+	lappend response [getTime] [nodeDisp 3 1] [nodeVel 3 1] [lindex [eleResponse 4 axialForce] 0]
+    }
+    return $response
+}
+
+proc snapshotCompare {name a b} {
+    if {[llength $a] == 0 || [llength $a] != [llength $b]} {
+	puts "failed to complete the analysis: $name"
+	return -1
+    }
+    set maxDiff 0.0
+    foreach x $a y $b {
+	set diff [expr abs($x-$y)/(1.0+abs($x))]
+	if {$diff > $maxDiff} {
+	    set maxDiff $diff
+	}
+    }
+    puts [format "%40s%15.4e" $name $maxDiff]
+    if {$maxDiff > 1.0e-10} {
+	puts "failed $name -> $maxDiff"
+	return -1
+    }
+    return 0
+}
+
+set testOK 0
+
+# dynamic analysis
+snapshotModel
+timeSeries Trig 1 0.0 100.0 0.6 -factor 30.0
+pattern Plain 1 1 {
+    load 3 1.0 0.0 0.0
+}
+snapshotTransientAnalysis
+snapshotRun 100 0.01
+snapshot save $snapshotFile
+set saved [snapshotRun 100 0.01]
+
+snapshot restore $snapshotFile
+set restored [snapshotRun 100 0.01]
+if {[snapshotCompare "transient, restored in the domain" $saved $restored] != 0} {
+    set testOK -1
+}
+
+wipe
+snapshot restore $snapshotFile
+snapshotTransientAnalysis
+set restored [snapshotRun 100 0.01]
+if {[snapshotCompare "transient, restored after wipe" $saved $restored] != 0} {
+    set testOK -1
+}
+
+# static analysis, the load increment of which depends on the iterations
+snapshotModel
+timeSeries Linear 1
+pattern Plain 1 1 {
+    load 3 1.0 0.0 0.0
+}
+snapshotStaticAnalysis
+snapshotRun 60 0.0
+snapshot save $snapshotFile
+set saved [snapshotRun 40 0.0]
+
+snapshot restore $snapshotFile
+set restored [snapshotRun 40 0.0]
+if {[snapshotCompare "static, restored in the domain" $saved $restored] != 0} {
+    set testOK -1
+}
+
+wipe
+file delete $snapshotFile
+
+set results [open results.out a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test Snapshot.tcl \n\n"
+    puts $results "PASSED : Snapshot.tcl"
+} else {
+    puts "\nFAILED Verification Test Snapshot.tcl \n\n"
+    puts $results "FAILED : Snapshot.tcl"
+}
+close $results
@@ -0,0 +1,123 @@
+# Threaded element sweep
+
+# A two bay, three storey RC frame of force and displacement based fiber
+# beam-columns with P-Delta columns on one line and a truss brace is pushed
+# cyclically, first with one thread and then with several. The truss,
+# which is not reentrant, is swept serially, the others by the threads;
+# the response must not change.
+
+puts "ThreadedSweep.tcl: Verification of the threaded element sweep"
+
+proc threadedSweepRun {nThreads} {
+
+    wipe
+    model Basic -ndm 2 -ndf 3
+
+    threads $nThreads
+
+    set H 120.0
+    set B 240.0
+    for {set j 0} {$j <= 3} {incr j} {
+	for {set i 0} {$i <= 2} {incr i} {
+	    node [expr 10*$j+$i+1] [expr $i*$B] [expr $j*$H]
+	}
+    }
+    fix 1 1 1 1
+    fix 2 1 1 1
+    fix 3 1 1 1
+
+    uniaxialMaterial Concrete02 1 -4.0 -0.002 -0.8 -0.006 0.1 0.4 200.0
+    uniaxialMaterial Steel02 2 60.0 29000.0 0.01 18.0 0.925 0.15
+    uniaxialMaterial Steel01 3 36.0 29000.0 0.02
+
+    section Fiber 1 {
+	patch rect 1 10 1 -9.0 -6.0 9.0 6.0
+	layer straight 2 3 0.79 -7.0 -4.0 -7.0 4.0
+	layer straight 2 3 0.79  7.0 -4.0  7.0 4.0
+    }
+
+    geomTransf Linear 1
+    geomTransf PDelta 2
+
+    set e 0
+    for {set j 0} {$j < 3} {incr j} {
+	for {set i 0} {$i <= 2} {incr i} {
+	    set nI [expr 10*$j+$i+1]
+	    set nJ [expr $nI+10]
+	    if {$i == 2} {
+		element forceBeamColumn [incr e] $nI $nJ 5 1 2
+	    } else {
+		element forceBeamColumn [incr e] $nI $nJ 5 1 1
+	    }
+	}
+	for {set i 0} {$i < 2} {incr i} {
+	    set nI [expr 10*($j+1)+$i+1]
+	    element dispBeamColumn [incr e] $nI [expr $nI+1] 4 1 1
+	}
+	element truss [incr e] [expr 10*$j+1] [expr 10*($j+1)+2] 2.0 3
+    }
+
+    timeSeries Linear 1
+    pattern Plain 1 1 {
+	load 31 1.0 0.0 0.0
+	load 21 0.67 0.0 0.0
+	load 11 0.33 0.0 0.0
+    }
+
+    constraints Plain
+    numberer RCM
+    system BandGeneral
+    test NormDispIncr 1.0e-10 50
+    algorithm Newton
+
+    set response {}
+    foreach dU {0.05 -0.05 0.05} nSteps {40 80 80} {
+	integrator DisplacementControl 31 1 $dU
+	analysis Static
+	for {set k 0} {$k < $nSteps} {incr k} {
+	    if {[analyze 1] != 0} {
+		return {}
+	    }
+	    lappend response [getLoadFactor 1] [nodeDisp 21 1] [nodeDisp 11 1]
+	}
+    }
+
+    return $response
+}
+
+set serial [threadedSweepRun 1]
+set threaded [threadedSweepRun 4]
+threads 1
+wipe
+
+# determine PASS/FAILURE of test
+set testOK 0
+
+if {[llength $serial] == 0 || [llength $serial] != [llength $threaded]} {
+    set testOK -1
+    puts "failed to complete the analyses"
+} else {
+    set tol 1.0e-8
+    set maxDiff 0.0
+    foreach a $serial b $threaded {
+	set diff [expr abs($a-$b)/(1.0+abs($a))]
+	if {$diff > $maxDiff} {
+	    set maxDiff $diff
+	}
+    }
+    puts [format "\n%10s%15d\n%10s%15.4e" Values: [llength $serial] MaxDiff: $maxDiff]
+    if {$maxDiff > $tol} {
+	set testOK -1
+	puts "failed threaded response -> $maxDiff $tol"
+    }
+}
+
+set results [open results.out a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test ThreadedSweep.tcl \n\n"
+    puts $results "PASSED : ThreadedSweep.tcl"
+} else {
+    puts "\nFAILED Verification Test ThreadedSweep.tcl \n\n"
+    puts $results "FAILED : ThreadedSweep.tcl"
+}
+close $results
@@ -14,5 +14,11 @@ source EigenFrame.Extra.tcl
 source AISC25.tcl
 source PlanarShearWall.tcl
 source PinchedCylinder.tcl
+source ThreadedSweep.tcl
+source ForceBeamColumnThreads.tcl
+source Snapshot.tcl
+source SaveRestoreState.tcl
+source NodalStateStore.tcl
+source RecorderWriter.tcl
 
 exit
@@ -68,6 +68,19 @@ Channel::getTag(void)
 		return tag;
 }
 
+int
+Channel::setSendBuffer(int numBytes)
+{
+  // the data is sent as it is given
+  return -1;
+}
+
+int
+Channel::flush(void)
+{
+  return 0;
+}
+
 int
 Channel::recvMsgUnknownSize(int dataTag, int commitTag, Message &, ChannelAddress *theAddress)
 {
@@ -62,6 +62,13 @@ class Channel
     virtual int isDatastore(void);
     virtual int getDbTag(void);
     int getTag(void);
+
+    // methods to coalesce the data sent into fewer, larger messages: with
+    // a buffer of numBytes > 0 the data sent is held until flush() is
+    // invoked, the buffer is full or the channel receives; 0 turns it off.
+    // The receiving channel needs no setting.
+    virtual int setSendBuffer(int numBytes);
+    virtual int flush(void);
     
     // methods to send/receive messages and objects on channels.
     virtual int sendObj(int commitTag,
@@ -36,13 +36,18 @@
 #include <Message.h>
 #include <MPI_ChannelAddress.h>
 #include <MovableObject.h>
+#include <string.h>
 
 // MPI_Channel(unsigned int other_Port, char *other_InetAddr): 
 // 	constructor to open a socket with my inet_addr and with a port number 
 //	given by the OS. 
 
 MPI_Channel::MPI_Channel(int other)
- :otherTag(other), otherComm(MPI_COMM_WORLD)
+ :otherTag(other), otherComm(MPI_COMM_WORLD),
+  sendBuffer(0), sendBufferSize(0), numBuffered(0),
+  bufferedTag(other), bufferedComm(MPI_COMM_WORLD),
+  recvBuffer(0), recvBufferSize(0), recvLength(0), recvPos(0),
+  recvTag(other)
 {
   
 }    
@@ -52,7 +57,121 @@ MPI_Channel::MPI_Channel(int other)
 
 MPI_Channel::~MPI_Channel()
 {
+  if (sendBuffer != 0)
+    delete [] sendBuffer;
+  if (recvBuffer != 0)
+    delete [] recvBuffer;
+}
+
+
+int
+MPI_Channel::setSendBuffer(int numBytes)
+{
+  if (this->flush() != 0)
+    return -1;
+
+  if (sendBuffer != 0)
+    delete [] sendBuffer;
+  sendBuffer = 0;
+  sendBufferSize = 0;
+
+  if (numBytes > 0) {
+    sendBuffer = new char[numBytes];
+    sendBufferSize = numBytes;
+  }
+  return 0;
+}
+
+
+int
+MPI_Channel::flush(void)
+{
+  if (numBuffered == 0)
+    return 0;
+
+  int numBytes = numBuffered;
+  numBuffered = 0;
+  if (MPI_Send((void *)sendBuffer, numBytes, MPI_CHAR, bufferedTag, 0, bufferedComm) != MPI_SUCCESS) {
+    opserr << "MPI_Channel::flush() - failed to send the data held\n";
+    return -1;
+  }
+  return 0;
+}
+
 
+// sends the data or, if there is room, places it in the send buffer; the
+// data held is sent in one message. Like any other it has the tag 0, so
+// that messages sent with other tags, as by the send command, are never
+// taken for those of the channel
+int
+MPI_Channel::writeData(void *data, int count, MPI_Datatype type, int size)
+{
+  int numBytes = count*size;
+
+  // an empty send still goes as a message of its own
+  if (sendBufferSize > 0 && numBytes > 0) {
+    if (numBuffered != 0 &&
+	(numBuffered + numBytes > sendBufferSize || 
+	 bufferedTag != otherTag || bufferedComm != otherComm))
+      this->flush();
+
+    if (numBytes <= sendBufferSize) {
+      memcpy(sendBuffer + numBuffered, data, numBytes);
+      numBuffered += numBytes;
+      bufferedTag = otherTag;
+      bufferedComm = otherComm;
+      return 0;
+    }
+  }
+
+  if (numBuffered != 0)
+    this->flush();
+  MPI_Send(data, count, type, otherTag, 0, otherComm);
+  return 0;
+}
+
+
+// receives the data, from the last message received whole if it holds any
+// more data, and returns the number of entries received. A message longer
+// than the data can only hold the data of several sends; it is received
+// whole and the following receives are served from it
+int
+MPI_Channel::readData(void *data, int count, MPI_Datatype type, int size)
+{
+  // anything held must go before waiting for the other process
+  this->flush();
+
+  MPI_Status status;
+  if (recvPos == recvLength || recvTag != otherTag) {
+    MPI_Probe(otherTag, 0, otherComm, &status);
+
+    int numBytes = 0;
+    MPI_Get_count(&status, MPI_CHAR, &numBytes);
+    if (numBytes <= count*size) {
+      int received = 0;
+      MPI_Recv(data, count, type, otherTag, 0, otherComm, &status);
+      MPI_Get_count(&status, type, &received);
+      return received;
+    }
+
+    if (numBytes > recvBufferSize) {
+      if (recvBuffer != 0)
+	delete [] recvBuffer;
+      recvBuffer = new char[numBytes];
+      recvBufferSize = numBytes;
+    }
+    MPI_Recv((void *)recvBuffer, numBytes, MPI_CHAR, otherTag, 0, otherComm, &status);
+    recvLength = numBytes;
+    recvPos = 0;
+    recvTag = otherTag;
+  }
+
+  int numBytes = count*size;
+  if (numBytes > recvLength - recvPos)
+    numBytes = (recvLength - recvPos)/size*size;
+  memcpy(data, recvBuffer + recvPos, numBytes);
+  recvPos += numBytes;
+  return numBytes/size;
 }
 
 
@@ -167,10 +286,7 @@ MPI_Channel::recvMsg(int dbTag, int commitTag, Message &msg, ChannelAddress *the
     gMsg = msg.data;
     nleft = msg.length;
 
-    MPI_Status status;
-    MPI_Recv((void *)gMsg, nleft, MPI_CHAR, otherTag, 0, otherComm, &status);
-    int count =0;
-    MPI_Get_count(&status, MPI_CHAR, &count);
+    int count = this->readData((void *)gMsg, nleft, MPI_CHAR, sizeof(char));
     if (count != nleft) {
       opserr << "MPI_Channel::recvMesg() -";
       opserr << " incorrect size of Message received ";
@@ -214,12 +330,12 @@ MPI_Channel::sendMsg(int dbTag, int commitTag, const Message &msg, ChannelAddres
 
     // if o.k. get a pointer to the data in the message and 
     // place the incoming data there
-    int nwrite, nleft;    
+    int nleft;
     char *gMsg;
     gMsg = msg.data;
     nleft = msg.length;
 
-    MPI_Send((void *)gMsg, nleft, MPI_CHAR, otherTag, 0, otherComm);
+    this->writeData((void *)gMsg, nleft, MPI_CHAR, sizeof(char));
     return 0;
 }
 
@@ -249,11 +365,7 @@ MPI_Channel::recvMatrix(int dbTag, int commitTag, Matrix &theMatrix, ChannelAddr
     char *gMsg = (char *)data;;
     nleft =  theMatrix.dataSize;
 
-    MPI_Status status;
-    MPI_Recv((void *)gMsg, nleft, MPI_DOUBLE, otherTag, 0, 
-	     otherComm, &status);
-    int count = 0;
-    MPI_Get_count(&status, MPI_DOUBLE, &count);
+    int count = this->readData((void *)gMsg, nleft, MPI_DOUBLE, sizeof(double));
     if (count != nleft) {
       opserr << "MPI_Channel::recvMatrix() -";
       opserr << " incorrect number of entries for Matrix received: " << count << "\n";
@@ -287,12 +399,12 @@ MPI_Channel::sendMatrix(int dbTag, int commitTag, const Matrix &theMatrix, Chann
 
     // if o.k. get a pointer to the data in the Matrix and 
     // place the incoming data there
-    int nwrite, nleft;    
+    int nleft;
     double *data = theMatrix.data;
     char *gMsg = (char *)data;
     nleft =  theMatrix.dataSize;
 
-    MPI_Send((void *)gMsg, nleft, MPI_DOUBLE, otherTag, 0, otherComm);
+    this->writeData((void *)gMsg, nleft, MPI_DOUBLE, sizeof(double));
 
     return 0;
 }
@@ -332,10 +444,7 @@ MPI_Channel::recvVector(int dbTag, int commitTag, Vector &theVector, ChannelAddr
     char *gMsg = (char *)data;;
     nleft =  theVector.sz;
 
-    MPI_Status status;
-    MPI_Recv((void *)gMsg, nleft, MPI_DOUBLE, otherTag, 0, otherComm, &status);
-    int count =0;
-    MPI_Get_count(&status, MPI_DOUBLE, &count);
+    int count = this->readData((void *)gMsg, nleft, MPI_DOUBLE, sizeof(double));
     if (count != nleft) {
       opserr << "MPI_Channel::recvVector() -";
       opserr << " incorrect number of entries for Vector received: " << count << 
@@ -371,14 +480,14 @@ MPI_Channel::sendVector(int dbTag, int commitTag, const Vector &theVector, Chann
 
     // if o.k. get a pointer to the data in the Vector and 
     // place the incoming data there
-    int nwrite, nleft;    
+    int nleft;
     double *data = theVector.theData;
     char *gMsg = (char *)data;
     nleft =  theVector.sz;
 
     //    opserr << "MPI:sendVector " << otherTag << " " << theVector.Size() << endln;
 
-    MPI_Send((void *)gMsg, nleft, MPI_DOUBLE, otherTag, 0, otherComm);
+    this->writeData((void *)gMsg, nleft, MPI_DOUBLE, sizeof(double));
     
     return 0;
 }
@@ -413,10 +522,7 @@ MPI_Channel::recvID(int dbTag, int commitTag, ID &theID, ChannelAddress *theAddr
 
     //    opserr << "MPI:recvID " << otherTag << " " << theID.Size() << endln;
 
-    MPI_Status status;
-    MPI_Recv((void *)gMsg, nleft, MPI_INT, otherTag, 0, otherComm, &status);
-    int count =0;
-    MPI_Get_count(&status, MPI_INT, &count);
+    int count = this->readData((void *)gMsg, nleft, MPI_INT, sizeof(int));
 
     //    int rank;
     //MPI_Comm_rank(MPI_COMM_WORLD, &rank);
@@ -455,14 +561,14 @@ MPI_Channel::sendID(int dbTag, int commitTag, const ID &theID, ChannelAddress *t
 
     // if o.k. get a pointer to the data in the ID and 
     // place the incoming data there
-    int nwrite, nleft;    
+    int nleft;
     int *data = theID.data;
     char *gMsg = (char *)data;
     nleft =  theID.sz;
 
     //    opserr << "MPI:sendID " << otherTag << " " << theID.Size() << endln;
 
-    MPI_Send((void *)gMsg, nleft, MPI_INT, otherTag, 0, otherComm);
+    this->writeData((void *)gMsg, nleft, MPI_INT, sizeof(int));
 
     // int rank;
     // MPI_Comm_rank(MPI_COMM_WORLD, &rank);
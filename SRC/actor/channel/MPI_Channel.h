@@ -73,13 +73,30 @@ class MPI_Channel : public Channel
     
     int sendID(int dbTag, int commitTag, const ID &theID, ChannelAddress *theAddress =0);
     int recvID(int dbTag, int commitTag, ID &theID, ChannelAddress *theAddress =0);    
-    
+
+    int setSendBuffer(int numBytes);
+    int flush(void);
     
   protected:
 	
   private:
+    int writeData(void *data, int count, MPI_Datatype type, int size);
+    int readData(void *data, int count, MPI_Datatype type, int size);
+
     int otherTag;
     MPI_Comm otherComm;    
+
+    char *sendBuffer;        // data held until flush(), if sendBufferSize > 0
+    int sendBufferSize;
+    int numBuffered;
+    int bufferedTag;         // where the data held is to go
+    MPI_Comm bufferedComm;
+
+    char *recvBuffer;        // the last message with several sends
+    int recvBufferSize;
+    int recvLength;
+    int recvPos;
+    int recvTag;
 };
 
 
@@ -0,0 +1,435 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Purpose: This file contains the implementation of SharedMemoryChannel.
+//
+// The segment starts with a SharedMemoryHeader, followed by the ring
+// written by the process that created it and then the ring written by
+// the process that attached. Each ring has a head, advanced by its writer,
+// and a tail, advanced by its reader, counting bytes from the start; a
+// process waiting on the other spins briefly and then sleeps.
+//
+#include <SharedMemoryChannel.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <Message.h>
+#include <MovableObject.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+
+struct SharedMemoryRing {
+  std::atomic<unsigned long long> head;
+  char pad0[64 - sizeof(std::atomic<unsigned long long>)];
+  std::atomic<unsigned long long> tail;
+  char pad1[64 - sizeof(std::atomic<unsigned long long>)];
+};
+
+struct SharedMemoryHeader {
+  std::atomic<int> state;       // 0 being created, 1 ready, 2 attached
+  std::atomic<int> closed;      // set when either process is done
+  long long capacity;           // bytes in each ring
+  char pad[48];
+  SharedMemoryRing rings[2];
+};
+
+enum {Creating = 0, Ready = 1, Attached = 2};
+
+static void
+waitForOther(int &numWaits)
+{
+#ifndef _WIN32
+  numWaits++;
+  if (numWaits < 1000)
+    return;
+  else if (numWaits < 2000)
+    sched_yield();
+  else
+    usleep(50);
+#endif
+}
+
+// waits for the state of the segment to become theState, for at most
+// timeOut seconds
+static int
+waitForState(SharedMemoryHeader *theHeader, int theState, int timeOut)
+{
+#ifndef _WIN32
+  time_t deadline = time(0) + timeOut;
+  int numWaits = 0;
+  while (theHeader->state.load(std::memory_order_acquire) != theState) {
+    waitForOther(numWaits);
+    if ((numWaits & 1023) == 0 && time(0) > deadline)
+      return -1;
+  }
+#endif
+  return 0;
+}
+
+SharedMemoryChannel::SharedMemoryChannel(int size, int seconds)
+  :creator(true), bufferSize(size), timeOut(seconds),
+   theHeader(0), segmentSize(0), sendBuffer(0), recvBuffer(0),
+   sendRing(0), recvRing(1)
+{
+  name[0] = '\0';
+#ifdef _WIN32
+  opserr << "SharedMemoryChannel::SharedMemoryChannel() - not available on Windows\n";
+#else
+  if (bufferSize < 4096)
+    bufferSize = 4096;
+  bufferSize = (bufferSize + 63) & ~63;
+
+  snprintf(name, sizeof(name), "/opensees-%d-%d", (int)getpid(), this->getTag());
+
+  int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    opserr << "SharedMemoryChannel::SharedMemoryChannel() - could not create " << name << endln;
+    name[0] = '\0';
+    return;
+  }
+
+  segmentSize = sizeof(SharedMemoryHeader) + 2*(long long)bufferSize;
+  void *segment = MAP_FAILED;
+  if (ftruncate(fd, segmentSize) == 0)
+    segment = mmap(0, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (segment == MAP_FAILED) {
+    opserr << "SharedMemoryChannel::SharedMemoryChannel() - could not map " << name << endln;
+    shm_unlink(name);
+    name[0] = '\0';
+    return;
+  }
+
+  // the segment is zero filled, so the rings are empty
+  theHeader = (SharedMemoryHeader *)segment;
+  theHeader->capacity = bufferSize;
+  sendBuffer = (char *)segment + sizeof(SharedMemoryHeader);
+  recvBuffer = sendBuffer + bufferSize;
+  theHeader->state.store(Ready, std::memory_order_release);
+#endif
+}
+
+SharedMemoryChannel::SharedMemoryChannel(const char *theName, int seconds)
+  :creator(false), bufferSize(0), timeOut(seconds),
+   theHeader(0), segmentSize(0), sendBuffer(0), recvBuffer(0),
+   sendRing(1), recvRing(0)
+{
+  strncpy(name, theName, sizeof(name)-1);
+  name[sizeof(name)-1] = '\0';
+}
+
+SharedMemoryChannel::~SharedMemoryChannel()
+{
+#ifndef _WIN32
+  if (theHeader != 0) {
+    theHeader->closed.store(1, std::memory_order_release);
+    munmap((void *)theHeader, segmentSize);
+  }
+  // removes the name if the other process never attached
+  if (creator == true && name[0] != '\0')
+    shm_unlink(name);
+#endif
+}
+
+const char *
+SharedMemoryChannel::getName(void) const
+{
+  return name;
+}
+
+char *
+SharedMemoryChannel::addToProgram(void)
+{
+  char *newStuff = (char *)malloc(100*sizeof(char));
+  snprintf(newStuff, 100, " 4 %s ", name);
+  return newStuff;
+}
+
+int
+SharedMemoryChannel::setUpConnection(void)
+{
+#ifdef _WIN32
+  return -1;
+#else
+  if (creator == true) {
+    if (theHeader == 0)
+      return -1;
+
+    // wait for the other process, then remove the name; the segment
+    // stays until both have unmapped it
+    if (waitForState(theHeader, Attached, timeOut) != 0) {
+      opserr << "SharedMemoryChannel::setUpConnection() - no process attached to " << name;
+      opserr << " within " << timeOut << " seconds\n";
+      return -1;
+    }
+    shm_unlink(name);
+    name[0] = '\0';
+    return 0;
+  }
+
+  if (theHeader != 0)
+    return 0;
+
+  // the segment may not have been created yet
+  int fd = -1;
+  struct stat theStat;
+  for (int i = 0; i < timeOut*1000; i++) {
+    if (fd < 0)
+      fd = shm_open(name, O_RDWR, 0600);
+    if (fd >= 0 && fstat(fd, &theStat) == 0 && theStat.st_size > (off_t)sizeof(SharedMemoryHeader))
+      break;
+    usleep(1000);
+  }
+  if (fd < 0) {
+    opserr << "SharedMemoryChannel::setUpConnection() - could not open " << name << endln;
+    return -1;
+  }
+  if (theStat.st_size <= (off_t)sizeof(SharedMemoryHeader)) {
+    opserr << "SharedMemoryChannel::setUpConnection() - " << name << " was not sized in time\n";
+    close(fd);
+    return -1;
+  }
+
+  segmentSize = theStat.st_size;
+  void *segment = mmap(0, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (segment == MAP_FAILED) {
+    opserr << "SharedMemoryChannel::setUpConnection() - could not map " << name << endln;
+    return -1;
+  }
+
+  theHeader = (SharedMemoryHeader *)segment;
+  if (waitForState(theHeader, Ready, timeOut) != 0) {
+    opserr << "SharedMemoryChannel::setUpConnection() - " << name << " is not ready\n";
+    munmap(segment, segmentSize);
+    theHeader = 0;
+    return -1;
+  }
+
+  // the rings must lie within what was mapped
+  long long capacity = theHeader->capacity;
+  if (capacity <= 0 || capacity > 0x7fffffff ||
+      sizeof(SharedMemoryHeader) + 2*capacity > (unsigned long long)segmentSize) {
+    opserr << "SharedMemoryChannel::setUpConnection() - " << name << " of " << (double)segmentSize;
+    opserr << " bytes is too small for rings of " << (double)capacity << " bytes\n";
+    munmap(segment, segmentSize);
+    theHeader = 0;
+    return -1;
+  }
+
+  bufferSize = (int)capacity;
+  recvBuffer = (char *)segment + sizeof(SharedMemoryHeader);
+  sendBuffer = recvBuffer + bufferSize;
+  theHeader->state.store(Attached, std::memory_order_release);
+  return 0;
+#endif
+}
+
+int
+SharedMemoryChannel::setNextAddress(const ChannelAddress &theAddress)
+{
+  return 0;
+}
+
+ChannelAddress *
+SharedMemoryChannel::getLastSendersAddress(void)
+{
+  return 0;
+}
+
+int
+SharedMemoryChannel::write(const char *data, long long numBytes)
+{
+  if (theHeader == 0) {
+    opserr << "SharedMemoryChannel::write() - channel not connected\n";
+    return -1;
+  }
+
+  SharedMemoryRing &theRing = theHeader->rings[sendRing];
+  unsigned long long head = theRing.head.load(std::memory_order_relaxed);
+  int numWaits = 0;
+
+  while (numBytes > 0) {
+    unsigned long long tail = theRing.tail.load(std::memory_order_acquire);
+    long long space = bufferSize - (long long)(head - tail);
+    if (space == 0) {
+      if (theHeader->closed.load(std::memory_order_acquire) != 0) {
+	opserr << "SharedMemoryChannel::write() - the other process has closed the channel\n";
+	return -1;
+      }
+      waitForOther(numWaits);
+      continue;
+    }
+
+    long long loc = head % bufferSize;
+    long long n = numBytes;
+    if (n > space)
+      n = space;
+    if (n > bufferSize - loc)
+      n = bufferSize - loc;
+
+    memcpy(sendBuffer + loc, data, n);
+    head += n;
+    theRing.head.store(head, std::memory_order_release);
+    data += n;
+    numBytes -= n;
+    numWaits = 0;
+  }
+
+  return 0;
+}
+
+int
+SharedMemoryChannel::read(char *data, long long numBytes)
+{
+  if (theHeader == 0) {
+    opserr << "SharedMemoryChannel::read() - channel not connected\n";
+    return -1;
+  }
+
+  SharedMemoryRing &theRing = theHeader->rings[recvRing];
+  unsigned long long tail = theRing.tail.load(std::memory_order_relaxed);
+  int numWaits = 0;
+
+  while (numBytes > 0) {
+    unsigned long long head = theRing.head.load(std::memory_order_acquire);
+    long long available = (long long)(head - tail);
+    if (available == 0) {
+      if (theHeader->closed.load(std::memory_order_acquire) != 0 &&
+	  theRing.head.load(std::memory_order_acquire) == tail) {
+	opserr << "SharedMemoryChannel::read() - the other process has closed the channel\n";
+	return -1;
+      }
+      waitForOther(numWaits);
+      continue;
+    }
+
+    long long loc = tail % bufferSize;
+    long long n = numBytes;
+    if (n > available)
+      n = available;
+    if (n > bufferSize - loc)
+      n = bufferSize - loc;
+
+    memcpy(data, recvBuffer + loc, n);
+    tail += n;
+    theRing.tail.store(tail, std::memory_order_release);
+    data += n;
+    numBytes -= n;
+    numWaits = 0;
+  }
+
+  return 0;
+}
+
+int
+SharedMemoryChannel::sendObj(int commitTag, MovableObject &theObject, ChannelAddress *theAddress)
+{
+  return theObject.sendSelf(commitTag, *this);
+}
+
+int
+SharedMemoryChannel::recvObj(int commitTag, MovableObject &theObject,
+			     FEM_ObjectBroker &theBroker, ChannelAddress *theAddress)
+{
+  return theObject.recvSelf(commitTag, *this, theBroker);
+}
+
+int
+SharedMemoryChannel::sendMsg(int dbTag, int commitTag, const Message &msg, ChannelAddress *theAddress)
+{
+  return this->write(msg.data, msg.length);
+}
+
+int
+SharedMemoryChannel::recvMsg(int dbTag, int commitTag, Message &msg, ChannelAddress *theAddress)
+{
+  return this->read(msg.data, msg.length);
+}
+
+int
+SharedMemoryChannel::recvMsgUnknownSize(int dbTag, int commitTag, Message &msg, ChannelAddress *theAddress)
+{
+  // as for a TCP_Socket the message ends with a '\0' or a '\n'
+  char *gMsg = msg.data;
+  for (int i = 0; i < msg.length-1; i++) {
+    if (this->read(gMsg, 1) != 0)
+      return -1;
+    if (*gMsg == '\0')
+      return 0;
+    if (*gMsg == '\n') {
+      *(gMsg+1) = '\0';
+      return 0;
+    }
+    gMsg++;
+  }
+  *gMsg = '\0';
+  return 0;
+}
+
+int
+SharedMemoryChannel::sendMatrix(int dbTag, int commitTag, const Matrix &theMatrix, ChannelAddress *theAddress)
+{
+  return this->write((const char *)theMatrix.data, theMatrix.dataSize*(long long)sizeof(double));
+}
+
+int
+SharedMemoryChannel::recvMatrix(int dbTag, int commitTag, Matrix &theMatrix, ChannelAddress *theAddress)
+{
+  return this->read((char *)theMatrix.data, theMatrix.dataSize*(long long)sizeof(double));
+}
+
+int
+SharedMemoryChannel::sendVector(int dbTag, int commitTag, const Vector &theVector, ChannelAddress *theAddress)
+{
+  return this->write((const char *)theVector.theData, theVector.sz*(long long)sizeof(double));
+}
+
+int
+SharedMemoryChannel::recvVector(int dbTag, int commitTag, Vector &theVector, ChannelAddress *theAddress)
+{
+  return this->read((char *)theVector.theData, theVector.sz*(long long)sizeof(double));
+}
+
+int
+SharedMemoryChannel::sendID(int dbTag, int commitTag, const ID &theID, ChannelAddress *theAddress)
+{
+  return this->write((const char *)theID.data, theID.sz*(long long)sizeof(int));
+}
+
+int
+SharedMemoryChannel::recvID(int dbTag, int commitTag, ID &theID, ChannelAddress *theAddress)
+{
+  return this->read((char *)theID.data, theID.sz*(long long)sizeof(int));
+}
@@ -0,0 +1,112 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Purpose: This file contains the class definition for SharedMemoryChannel.
+// SharedMemoryChannel is a sub-class of channel for two processes on the
+// same machine. It is implemented with a POSIX shared memory segment
+// holding a ring buffer for each direction; the data of a Vector, Matrix,
+// ID or Message is copied straight between its storage and the ring, with
+// no system call unless a process has to wait.
+//
+// One process creates the segment, the other attaches to it by the name
+// given by getName() or addToProgram(). As with a TCP_Socket the
+// communication is with that one other process only, and both must agree
+// on the size of what is sent and received. setUpConnection() fails if
+// the other process has not turned up within timeOut seconds.
+//
+#ifndef SharedMemoryChannel_h
+#define SharedMemoryChannel_h
+
+#include <Channel.h>
+
+struct SharedMemoryHeader;
+
+class SharedMemoryChannel : public Channel
+{
+  public:
+    // creates a segment with rings of the given number of bytes
+    SharedMemoryChannel(int bufferSize = 4194304, int timeOut = 60);
+    // attaches to the segment of the given name
+    SharedMemoryChannel(const char *name, int timeOut = 60);
+    ~SharedMemoryChannel();
+
+    char *addToProgram(void);
+    int setUpConnection(void);
+    int setNextAddress(const ChannelAddress &otherChannelAddress);
+    ChannelAddress *getLastSendersAddress(void);
+
+    const char *getName(void) const;
+
+    int sendObj(int commitTag,
+		MovableObject &theObject, 
+		ChannelAddress *theAddress =0);
+    int recvObj(int commitTag,
+		MovableObject &theObject, 
+		FEM_ObjectBroker &theBroker,
+		ChannelAddress *theAddress =0);
+		
+    int sendMsg(int dbTag, int commitTag, 
+		const Message &, 
+		ChannelAddress *theAddress =0);    
+    int recvMsg(int dbTag, int commitTag, 
+		Message &, 
+		ChannelAddress *theAddress =0);        
+    int recvMsgUnknownSize(int dbTag, int commitTag, 
+		Message &, 
+		ChannelAddress *theAddress =0);        
+
+    int sendMatrix(int dbTag, int commitTag, 
+		   const Matrix &theMatrix, 
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag, 
+		   Matrix &theMatrix, 
+		   ChannelAddress *theAddress =0);
+    
+    int sendVector(int dbTag, int commitTag, 
+		   const Vector &theVector,
+		   ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag, 
+		   Vector &theVector, 
+		   ChannelAddress *theAddress =0);
+    
+    int sendID(int dbTag, int commitTag, 
+	       const ID &theID, 
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag, 
+	       ID &theID, 
+	       ChannelAddress *theAddress =0);    
+    
+  private:
+    int write(const char *data, long long numBytes);
+    int read(char *data, long long numBytes);
+
+    char name[64];
+    bool creator;
+    int bufferSize;
+    int timeOut;
+
+    SharedMemoryHeader *theHeader;
+    long long segmentSize;
+    char *sendBuffer;     // the ring this process writes
+    char *recvBuffer;     // the ring this process reads
+    int sendRing, recvRing;
+};
+
+#endif 
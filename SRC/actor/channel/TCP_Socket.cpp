@@ -52,7 +52,8 @@ static void byte_swap(void *array, long long nArray,int size);
 //	given by the OS. 
 TCP_Socket::TCP_Socket()
     : myPort(0), connectType(0),
-    checkEndianness(false), endiannessProblem(false), noDelay(0)
+    checkEndianness(false), endiannessProblem(false), noDelay(0),
+    sendBuffer(0), sendBufferSize(0), numBuffered(0)
 {
     // initialize sockets
     startup_sockets();
@@ -89,7 +90,8 @@ TCP_Socket::TCP_Socket()
 TCP_Socket::TCP_Socket(unsigned int port, bool checkendianness, int nodelay) 
     : myPort(0), connectType(0),
     checkEndianness(checkendianness), endiannessProblem(false),
-    noDelay(nodelay)
+    noDelay(nodelay),
+    sendBuffer(0), sendBufferSize(0), numBuffered(0)
 {
     // initialize sockets
     startup_sockets();
@@ -132,7 +134,8 @@ TCP_Socket::TCP_Socket(unsigned int other_Port,
     const char *other_InetAddr, bool checkendianness, int nodelay)
     : myPort(0), connectType(1),
     checkEndianness(checkendianness), endiannessProblem(false),
-    noDelay(nodelay)
+    noDelay(nodelay),
+    sendBuffer(0), sendBufferSize(0), numBuffered(0)
 {
     // initialize sockets
     startup_sockets();
@@ -182,6 +185,10 @@ TCP_Socket::TCP_Socket(unsigned int other_Port,
 //	destructor
 TCP_Socket::~TCP_Socket()
 {
+    this->flush();
+    if (sendBuffer != 0)
+        delete [] sendBuffer;
+
 #ifdef _WIN32
     closesocket(sockfd);
 #else
@@ -411,6 +418,9 @@ TCP_Socket::recvMsg(int dbTag, int commitTag,
     gMsg = msg.data;
     nleft = msg.length;
 
+    // anything held must go before waiting for the other process
+    this->flush();
+
     while (nleft > 0) {
         nread = recv(sockfd,gMsg,nleft,0);
         nleft -= nread;
@@ -454,6 +464,9 @@ TCP_Socket::recvMsgUnknownSize(int dbTag, int commitTag,
     char *gMsg;
     gMsg = msg.data;
 
+    // anything held must go before waiting for the other process
+    this->flush();
+
     while (!eol) {
         nleft = this->getBytesAvailable();
         while (nleft > 0) {
@@ -501,17 +514,12 @@ TCP_Socket::sendMsg(int dbTag, int commitTag,
 
     // if o.k. get a pointer to the data in the message and 
     // place the incoming data there
-    int nwrite, nleft;    
+    int nleft;
     char *gMsg;
     gMsg = msg.data;
     nleft = msg.length;
 
-    while (nleft > 0) {
-        nwrite = send(sockfd,gMsg,nleft,0);
-        nleft -= nwrite;
-
-        gMsg +=  nwrite;
-    }
+    this->writeData(gMsg, nleft);
 
     return 0;
 }
@@ -548,6 +556,9 @@ TCP_Socket::recvMatrix(int dbTag, int commitTag,
     char *gMsg = (char *)data;;
     nleft = theMatrix.dataSize * sizeof(double);
 
+    // anything held must go before waiting for the other process
+    this->flush();
+
     while (nleft > 0) {
         nread = recv(sockfd,gMsg,nleft,0);
         nleft -= nread;
@@ -594,7 +605,7 @@ TCP_Socket::sendMatrix(int dbTag, int commitTag,
 
     // if o.k. get a pointer to the data in the Matrix and 
     // place the incoming data there
-    int nwrite, nleft;    
+    int nleft;
     double *data = theMatrix.data;
     char *gMsg = (char *)data;
     nleft = theMatrix.dataSize * sizeof(double);
@@ -606,11 +617,7 @@ TCP_Socket::sendMatrix(int dbTag, int commitTag,
     }
 #endif
 
-    while (nleft > 0) {
-        nwrite = send(sockfd,gMsg,nleft,0);
-        nleft -= nwrite;
-        gMsg +=  nwrite;
-    }
+    this->writeData(gMsg, nleft);
 
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -654,6 +661,9 @@ TCP_Socket::recvVector(int dbTag, int commitTag,
     char *gMsg = (char *)data;;
     nleft = theVector.sz * sizeof(double);
 
+    // anything held must go before waiting for the other process
+    this->flush();
+
     while (nleft > 0) {
         nread = recv(sockfd,gMsg,nleft,0);
         nleft -= nread;
@@ -699,7 +709,7 @@ TCP_Socket::sendVector(int dbTag, int commitTag,
 
     // if o.k. get a pointer to the data in the Vector and 
     // place the incoming data there
-    int nwrite, nleft;    
+    int nleft;
     double *data = theVector.theData;
     char *gMsg = (char *)data;
     nleft = theVector.sz * sizeof(double);
@@ -711,11 +721,7 @@ TCP_Socket::sendVector(int dbTag, int commitTag,
     }
 #endif
 
-    while (nleft > 0) {
-        nwrite = send(sockfd,gMsg,nleft,0);
-        nleft -= nwrite;
-        gMsg +=  nwrite;
-    }
+    this->writeData(gMsg, nleft);
 
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -759,6 +765,9 @@ TCP_Socket::recvID(int dbTag, int commitTag,
     char *gMsg = (char *)data;;
     nleft = theID.sz * sizeof(int);
 
+    // anything held must go before waiting for the other process
+    this->flush();
+
     while (nleft > 0) {
         nread = recv(sockfd,gMsg,nleft,0);
         nleft -= nread;
@@ -804,7 +813,7 @@ TCP_Socket::sendID(int dbTag, int commitTag,
 
     // if o.k. get a pointer to the data in the ID and 
     // place the incoming data there
-    int nwrite, nleft;    
+    int nleft;
     int *data = theID.data;
     char *gMsg = (char *)data;
     nleft = theID.sz * sizeof(int);
@@ -816,11 +825,7 @@ TCP_Socket::sendID(int dbTag, int commitTag,
     }
 #endif
 
-    while (nleft > 0) {
-        nwrite = send(sockfd,gMsg,nleft,0);
-        nleft -= nwrite;
-        gMsg +=  nwrite;
-    }
+    this->writeData(gMsg, nleft);
 
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -840,6 +845,70 @@ TCP_Socket::getPortNumber() const
 }
 
 
+int
+TCP_Socket::setSendBuffer(int numBytes)
+{
+    if (this->flush() != 0)
+        return -1;
+
+    if (sendBuffer != 0)
+        delete [] sendBuffer;
+    sendBuffer = 0;
+    sendBufferSize = 0;
+
+    if (numBytes > 0) {
+        sendBuffer = new char[numBytes];
+        sendBufferSize = numBytes;
+    }
+    return 0;
+}
+
+
+int
+TCP_Socket::flush()
+{
+    char *gMsg = sendBuffer;
+    int nleft = numBuffered;
+    numBuffered = 0;
+
+    while (nleft > 0) {
+        int nwrite = send(sockfd,gMsg,nleft,0);
+        if (nwrite < 0) {
+            opserr << "TCP_Socket::flush() - failed to send the data held\n";
+            return -1;
+        }
+        nleft -= nwrite;
+        gMsg +=  nwrite;
+    }
+    return 0;
+}
+
+
+// writes the data to the socket or, if there is room, to the send buffer
+int
+TCP_Socket::writeData(const char *gMsg, int nleft)
+{
+    if (sendBufferSize > 0) {
+        if (numBuffered + nleft > sendBufferSize && this->flush() != 0)
+            return -1;
+        if (nleft <= sendBufferSize) {
+            memcpy(sendBuffer + numBuffered, gMsg, nleft);
+            numBuffered += nleft;
+            return 0;
+        }
+    }
+
+    while (nleft > 0) {
+        int nwrite = send(sockfd,gMsg,nleft,0);
+        if (nwrite < 0)
+            return -1;
+        nleft -= nwrite;
+        gMsg +=  nwrite;
+    }
+    return 0;
+}
+
+
 unsigned int
 TCP_Socket::getBytesAvailable()
 {
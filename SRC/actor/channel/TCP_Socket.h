@@ -93,10 +93,14 @@ class TCP_Socket : public Channel
     int recvID(int dbTag, int commitTag, 
 	       ID &theID, 
 	       ChannelAddress *theAddress =0);    
+
+    int setSendBuffer(int numBytes);
+    int flush(void);
     
   protected:
     unsigned int getPortNumber() const;
     unsigned int getBytesAvailable();
+    int writeData(const char *data, int numBytes);
     
   private:
     socket_type sockfd;
@@ -117,6 +121,10 @@ class TCP_Socket : public Channel
     bool checkEndianness;
     bool endiannessProblem;
     int noDelay;
+
+    char *sendBuffer;   // data held until flush(), if sendBufferSize > 0
+    int sendBufferSize;
+    int numBuffered;
 };
 
 #endif 
@@ -0,0 +1,145 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: a test and benchmark of the send buffer of MPI_Channel, run on
+// two processes, e.g. mpirun -np 2 testMPI_Channel. Process 0 sends many
+// small IDs, Vectors and Matrices, a Vector larger than the buffer and an
+// empty ID, first unbuffered and then buffered, with a message of another
+// tag sent ahead of them on MPI_COMM_WORLD as the send command does.
+// Process 1 receives the channel data before that message and checks all
+// of it; process 0 prints the time of each pass.
+
+#include <StandardStream.h>
+#include <MPI_Channel.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <Message.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <mpi.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+int main(int argc, char **argv)
+{
+  MPI_Init(&argc, &argv);
+
+  int rank = 0;
+  int np = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &np);
+  if (np != 2) {
+    if (rank == 0)
+      opserr << "Usage: mpirun -np 2 testMPI_Channel\n";
+    MPI_Finalize();
+    return 1;
+  }
+
+  MPI_Channel theChannel(1-rank);
+  const int numSends = 200000;
+  const int bigSize = 300000;
+  int numErrors = 0;
+
+  for (int pass = 0; pass < 2; pass++) {
+    MPI_Barrier(MPI_COMM_WORLD);
+    double t0 = MPI_Wtime();
+
+    if (rank == 0) {
+      int other = 1234;
+      MPI_Send((void *)&other, 1, MPI_INT, 1, 1, MPI_COMM_WORLD);
+
+      theChannel.setSendBuffer(pass == 0 ? 0 : 1048576);
+      ID theID(3);
+      Vector theVector(6);
+      Matrix theMatrix(2,2);
+      for (int i = 0; i < numSends; i++) {
+	theID(0) = i;
+	theVector(5) = i;
+	theMatrix(1,1) = i;
+	theChannel.sendID(0, 0, theID);
+	theChannel.sendVector(0, 0, theVector);
+	theChannel.sendMatrix(0, 0, theMatrix);
+      }
+      Vector bigVector(bigSize);
+      bigVector(bigSize-1) = 7.0;
+      theChannel.sendVector(0, 0, bigVector);
+      ID emptyID(0);
+      theChannel.sendID(0, 0, emptyID);
+      char text[] = "done";
+      Message theMessage(text, 5);
+      theChannel.sendMsg(0, 0, theMessage);
+
+      ID result(1);
+      theChannel.recvID(0, 0, result);
+      theChannel.setSendBuffer(0);
+      numErrors += result(0);
+
+      fprintf(stderr, "%s: %.3f s, %d errors\n", pass == 0 ? "unbuffered" : "buffered",
+	      MPI_Wtime()-t0, result(0));
+
+    } else {
+      ID theID(3);
+      Vector theVector(6);
+      Matrix theMatrix(2,2);
+      int bad = 0;
+      for (int i = 0; i < numSends; i++) {
+	theChannel.recvID(0, 0, theID);
+	theChannel.recvVector(0, 0, theVector);
+	theChannel.recvMatrix(0, 0, theMatrix);
+	if (theID(0) != i || theVector(5) != i || theMatrix(1,1) != i)
+	  bad++;
+      }
+      Vector bigVector(bigSize);
+      theChannel.recvVector(0, 0, bigVector);
+      if (bigVector(bigSize-1) != 7.0)
+	bad++;
+      ID emptyID(0);
+      theChannel.recvID(0, 0, emptyID);
+      char text[5];
+      Message theMessage(text, 5);
+      theChannel.recvMsg(0, 0, theMessage);
+      if (strcmp(text, "done") != 0)
+	bad++;
+
+      int other = 0;
+      MPI_Status status;
+      MPI_Recv((void *)&other, 1, MPI_INT, 0, 1, MPI_COMM_WORLD, &status);
+      if (other != 1234)
+	bad++;
+
+      ID result(1);
+      result(0) = bad;
+      theChannel.sendID(0, 0, result);
+    }
+  }
+
+  if (rank == 0) {
+    if (numErrors == 0)
+      fprintf(stderr, "PASSED testMPI_Channel\n");
+    else
+      fprintf(stderr, "FAILED testMPI_Channel: %d errors\n", numErrors);
+  }
+
+  MPI_Finalize();
+  return numErrors == 0 ? 0 : 1;
+}
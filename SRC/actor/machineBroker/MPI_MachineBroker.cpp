@@ -40,7 +40,11 @@ MPI_MachineBroker::MPI_MachineBroker(FEM_ObjectBroker *theBroker, int argc, char
   int flag = 0;
   MPI_Initialized(&flag);
   if (!flag) {
-      MPI_Init(&argc, &argv);
+      // the subdomains may run threads of their own, which may each send
+      // to the other processes; a partitioned model is given more than
+      // one thread only if the library provides MPI_THREAD_MULTIPLE
+      int provided = 0;
+      MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
   }
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
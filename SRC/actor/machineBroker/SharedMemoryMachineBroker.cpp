@@ -0,0 +1,172 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#include <FEM_ObjectBroker.h>
+#include <SharedMemoryMachineBroker.h>
+#include <SharedMemoryChannel.h>
+#include <ID.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+SharedMemoryMachineBroker::SharedMemoryMachineBroker(FEM_ObjectBroker *theBroker,
+						     const char *program, int np,
+						     int ringSize, int seconds)
+  :MachineBroker(theBroker), rank(0), size(np), actorProgram(0),
+   bufferSize(ringSize), timeOut(seconds),
+   numStarted(0), usedChannels(0), theChannels(0), myChannel(0)
+{
+  if (size < 1)
+    size = 1;
+
+  actorProgram = new char[strlen(program)+1];
+  strcpy(actorProgram, program);
+
+  theChannels = new SharedMemoryChannel *[size];
+  for (int i=0; i<size; i++)
+    theChannels[i] = 0;
+  usedChannels = new ID(size);
+  usedChannels->Zero();
+}
+
+SharedMemoryMachineBroker::SharedMemoryMachineBroker(FEM_ObjectBroker *theBroker,
+						     int argc, char **argv)
+  :MachineBroker(theBroker), rank(0), size(1), actorProgram(0),
+   bufferSize(0), timeOut(60),
+   numStarted(0), usedChannels(0), theChannels(0), myChannel(0)
+{
+  if (argc < 5 || strcmp(argv[1], "4") != 0) {
+    opserr << "SharedMemoryMachineBroker::SharedMemoryMachineBroker() - ";
+    opserr << "not started by a SharedMemoryMachineBroker\n";
+    return;
+  }
+
+  rank = atoi(argv[3]);
+  size = atoi(argv[4]);
+  myChannel = new SharedMemoryChannel(argv[2], timeOut);
+}
+
+SharedMemoryMachineBroker::~SharedMemoryMachineBroker()
+{
+  if (theChannels != 0) {
+    for (int i=0; i<size; i++)
+      if (theChannels[i] != 0)
+	delete theChannels[i];
+    delete [] theChannels;
+  }
+  if (usedChannels != 0)
+    delete usedChannels;
+  if (myChannel != 0)
+    delete myChannel;
+  if (actorProgram != 0)
+    delete [] actorProgram;
+}
+
+int 
+SharedMemoryMachineBroker::getPID(void)
+{
+  return rank;
+}
+
+int 
+SharedMemoryMachineBroker::getNP(void)
+{
+  return size;
+}
+
+Channel *
+SharedMemoryMachineBroker::getMyChannel(void)
+{
+  if (myChannel == 0) {
+    opserr << "SharedMemoryMachineBroker::getMyChannel() - not an actor process\n";
+    return 0;
+  }
+
+  if (myChannel->setUpConnection() != 0) {
+    opserr << "SharedMemoryMachineBroker::getMyChannel() - could not attach to ";
+    opserr << myChannel->getName() << endln;
+    return 0;
+  }
+
+  return myChannel;
+}
+
+Channel *
+SharedMemoryMachineBroker::getRemoteProcess(void)
+{
+  if (actorProgram == 0) {
+    opserr << "SharedMemoryMachineBroker::getRemoteProcess() - an actor process cannot start processes\n";
+    return 0;
+  }
+
+  // a process started before and since freed
+  for (int i=1; i<=numStarted; i++)
+    if ((*usedChannels)(i) == 0) {
+      (*usedChannels)(i) = 1;
+      return theChannels[i];
+    }
+
+  if (numStarted+1 >= size) {
+    // no processes available
+    return 0;
+  }
+
+  int pid = numStarted+1;
+  SharedMemoryChannel *theChannel = new SharedMemoryChannel(bufferSize, timeOut);
+  if (theChannel->getName()[0] == '\0') {
+    delete theChannel;
+    return 0;
+  }
+
+  // start the process in the background, then wait for it to attach
+  char *channelArgs = theChannel->addToProgram();
+  char *command = new char[strlen(actorProgram) + strlen(channelArgs) + 64];
+  sprintf(command, "%s%s%d %d &", actorProgram, channelArgs, pid, size);
+  free(channelArgs);
+
+  int res = system(command);
+  delete [] command;
+
+  if (res != 0 || theChannel->setUpConnection() != 0) {
+    opserr << "SharedMemoryMachineBroker::getRemoteProcess() - failed to start ";
+    opserr << actorProgram << endln;
+    delete theChannel;
+    return 0;
+  }
+
+  theChannels[pid] = theChannel;
+  (*usedChannels)(pid) = 1;
+  numStarted++;
+  return theChannel;
+}
+
+int 
+SharedMemoryMachineBroker::freeProcess(Channel *theChannel)
+{
+  for (int i=1; i<=numStarted; i++)
+    if (theChannels[i] == theChannel) {
+      (*usedChannels)(i) = 0;
+      return 0;
+    }
+
+  // channel not found!
+  return -1;
+}
@@ -0,0 +1,77 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Purpose: This file contains the class definition for
+// SharedMemoryMachineBroker. SharedMemoryMachineBroker is the broker for
+// actor processes on the same machine, each connected to the process
+// that started it by a SharedMemoryChannel.
+//
+// The starting process gives the program to run and the number of
+// processes; each call of getRemoteProcess() runs the program with the
+// arguments " 4 segment pid np " and waits for it to attach. The program
+// then creates its broker from these arguments and gets the channel with
+// getMyChannel(), usually from runActors().
+//
+// What: "@(#) SharedMemoryMachineBroker.h, revA"
+
+#ifndef SharedMemoryMachineBroker_h
+#define SharedMemoryMachineBroker_h
+
+#include <MachineBroker.h>
+class ID;
+class SharedMemoryChannel;
+class FEM_ObjectBroker;
+
+class SharedMemoryMachineBroker : public MachineBroker
+{
+  public:
+    // the starting process, of np-1 actor processes running actorProgram
+    SharedMemoryMachineBroker(FEM_ObjectBroker *theBroker,
+			      const char *actorProgram, int np,
+			      int bufferSize = 4194304, int timeOut = 60);
+    // an actor process, given the arguments it was started with
+    SharedMemoryMachineBroker(FEM_ObjectBroker *theBroker, int argc, char **argv);
+    ~SharedMemoryMachineBroker();
+
+    // methods to return info about local process id and num processes
+    int getPID(void);
+    int getNP(void);
+
+    // methods to get and free Channels (processes)
+    Channel *getMyChannel(void);
+    Channel *getRemoteProcess(void);
+    int freeProcess(Channel *);
+
+  protected:
+    
+  private:
+    int rank;
+    int size;
+    char *actorProgram;
+    int bufferSize;
+    int timeOut;
+
+    int numStarted;
+    ID *usedChannels;
+    SharedMemoryChannel **theChannels;  // those of the processes started
+    SharedMemoryChannel *myChannel;     // that of an actor process
+};
+
+#endif
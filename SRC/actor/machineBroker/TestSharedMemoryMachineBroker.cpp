@@ -0,0 +1,212 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: a test of SharedMemoryMachineBroker and SharedMemoryChannel.
+// The program starts a copy of itself as an actor process, which echoes
+// back Vectors, Matrices, IDs and Messages several times the size of the
+// rings, scaled by 2. It then checks that a creating channel gives up when
+// no process attaches and that an attaching one rejects a segment too
+// small for its rings.
+//
+// Usage: testSharedMemory
+
+#include <StandardStream.h>
+#include <SharedMemoryMachineBroker.h>
+#include <SharedMemoryChannel.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <Message.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+static int
+runActor(int argc, char **argv)
+{
+  SharedMemoryMachineBroker theMachine(0, argc, argv);
+  Channel *theChannel = theMachine.getMyChannel();
+  if (theChannel == 0)
+    return -1;
+
+  ID request(3);
+  while (theChannel->recvID(0, 0, request) == 0 && request(0) != 0) {
+    int n = request(1);
+    int m = request(2);
+    if (request(0) == 1) {
+      Vector theVector(n);
+      theChannel->recvVector(0, 0, theVector);
+      theVector *= 2.0;
+      theChannel->sendVector(0, 0, theVector);
+    } else if (request(0) == 2) {
+      Matrix theMatrix(n, m);
+      theChannel->recvMatrix(0, 0, theMatrix);
+      theMatrix *= 2.0;
+      theChannel->sendMatrix(0, 0, theMatrix);
+    } else if (request(0) == 3) {
+      ID theID(n);
+      theChannel->recvID(0, 0, theID);
+      for (int i=0; i<n; i++)
+	theID(i) *= 2;
+      theChannel->sendID(0, 0, theID);
+    } else {
+      char *data = new char[n];
+      Message theMessage(data, n);
+      theChannel->recvMsg(0, 0, theMessage);
+      for (int i=0; i<n; i++)
+	data[i] = data[i] + 1;
+      theChannel->sendMsg(0, 0, theMessage);
+      delete [] data;
+    }
+  }
+
+  return 0;
+}
+
+static int
+testEcho(Channel &theChannel, int size)
+{
+  int numErrors = 0;
+  ID request(3);
+
+  Vector theVector(size);
+  for (int i=0; i<size; i++)
+    theVector(i) = i + 0.5;
+  request(0) = 1; request(1) = size; request(2) = 0;
+  theChannel.sendID(0, 0, request);
+  theChannel.sendVector(0, 0, theVector);
+  Vector echoVector(size);
+  theChannel.recvVector(0, 0, echoVector);
+  for (int i=0; i<size; i++)
+    if (echoVector(i) != 2.0*theVector(i))
+      numErrors++;
+
+  int nCols = 7;
+  Matrix theMatrix(size, nCols);
+  for (int i=0; i<size; i++)
+    for (int j=0; j<nCols; j++)
+      theMatrix(i,j) = i - 0.25*j;
+  request(0) = 2; request(1) = size; request(2) = nCols;
+  theChannel.sendID(0, 0, request);
+  theChannel.sendMatrix(0, 0, theMatrix);
+  Matrix echoMatrix(size, nCols);
+  theChannel.recvMatrix(0, 0, echoMatrix);
+  for (int i=0; i<size; i++)
+    for (int j=0; j<nCols; j++)
+      if (echoMatrix(i,j) != 2.0*theMatrix(i,j))
+	numErrors++;
+
+  ID theID(size);
+  for (int i=0; i<size; i++)
+    theID(i) = 3*i - 1;
+  request(0) = 3; request(1) = size; request(2) = 0;
+  theChannel.sendID(0, 0, request);
+  theChannel.sendID(0, 0, theID);
+  ID echoID(size);
+  theChannel.recvID(0, 0, echoID);
+  for (int i=0; i<size; i++)
+    if (echoID(i) != 2*theID(i))
+      numErrors++;
+
+  char *data = new char[size];
+  for (int i=0; i<size; i++)
+    data[i] = (char)(i % 100);
+  Message theMessage(data, size);
+  request(0) = 4; request(1) = size; request(2) = 0;
+  theChannel.sendID(0, 0, request);
+  theChannel.sendMsg(0, 0, theMessage);
+  theChannel.recvMsg(0, 0, theMessage);
+  for (int i=0; i<size; i++)
+    if (data[i] != (char)(i % 100 + 1))
+      numErrors++;
+  delete [] data;
+
+  opserr << "echo of " << size << " values: " << numErrors << " errors\n";
+  return numErrors;
+}
+
+int main(int argc, char **argv)
+{
+  // the actor process
+  if (argc > 1)
+    return runActor(argc, argv);
+
+  int numErrors = 0;
+
+  // rings of 4096 bytes, so that what is sent wraps around them
+  SharedMemoryMachineBroker theMachine(0, argv[0], 2, 4096, 10);
+  Channel *theChannel = theMachine.getRemoteProcess();
+  if (theChannel == 0) {
+    opserr << "failed to start the actor process\n";
+    numErrors++;
+  } else {
+    numErrors += testEcho(*theChannel, 1);
+    numErrors += testEcho(*theChannel, 1000);
+    numErrors += testEcho(*theChannel, 10001);
+
+    ID request(3);
+    request.Zero();
+    theChannel->sendID(0, 0, request);
+
+    if (theMachine.getRemoteProcess() != 0) {
+      opserr << "started more processes than asked for\n";
+      numErrors++;
+    }
+    theMachine.freeProcess(theChannel);
+  }
+
+  // no process attaches
+  SharedMemoryChannel lonelyChannel(4096, 1);
+  if (lonelyChannel.setUpConnection() == 0) {
+    opserr << "connected with no process attached\n";
+    numErrors++;
+  }
+
+  // the segment is cut short after it was created
+  SharedMemoryChannel shortChannel(4096, 1);
+  int fd = shm_open(shortChannel.getName(), O_RDWR, 0600);
+  struct stat theStat;
+  if (fd < 0 || fstat(fd, &theStat) != 0 || ftruncate(fd, theStat.st_size - 4096) != 0) {
+    opserr << "failed to cut short " << shortChannel.getName() << endln;
+    numErrors++;
+  } else {
+    SharedMemoryChannel attachChannel(shortChannel.getName(), 1);
+    if (attachChannel.setUpConnection() == 0) {
+      opserr << "attached to a segment too small for its rings\n";
+      numErrors++;
+    }
+  }
+  if (fd >= 0)
+    close(fd);
+
+  if (numErrors == 0)
+    opserr << "PASSED testSharedMemory\n";
+  else
+    opserr << "FAILED testSharedMemory: " << numErrors << " errors\n";
+
+  return numErrors == 0 ? 0 : 1;
+}
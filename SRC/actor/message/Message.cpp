@@ -71,7 +71,7 @@ extern "C" void bcopy(const char *scource, char *dest, int length);
 int
 Message::putData(char *theData, int startLoc, int endLoc)
 {
-    if (startLoc > 0 && startLoc <= length &&
+    if (startLoc >= 0 && startLoc < length &&
 	endLoc <= length && endLoc > startLoc) {
 	int theLength = endLoc - startLoc;
 	char *dataPos = &data[startLoc];
@@ -695,6 +695,8 @@
 #include "bandSPD/BandSPDLinSOE.h"
 #include "profileSPD/ProfileSPDLinSOE.h"
 #include "profileSPD/ProfileSPDLinSubstrSolver.h"
+#include "supernodal/SupernodalSymLinSOE.h"
+#include "supernodal/SupernodalSymLinSubstrSolver.h"
 #include "sparseGEN/SparseGenColLinSOE.h"
 #include "DomainDecompositionAnalysis.h"
 
@@ -3246,6 +3248,22 @@ FEM_ObjectBrokerAllClasses::getPtrNewDDLinearSOE(int classTagSOE,
 	    opserr << classTagDDSolver << endln;
 	    return 0;		 
 	}	     
+
+      case LinSOE_TAGS_SupernodalSymLinSOE:
+
+	if (classTagDDSolver == SOLVER_TAGS_SupernodalSymLinSubstrSolver) {
+	    SupernodalSymLinSubstrSolver *theSupernodalSolver =
+		new SupernodalSymLinSubstrSolver();
+	    LinearSOE *theSOE = new SupernodalSymLinSOE(*theSupernodalSolver);
+	    lastDomainSolver = theSupernodalSolver;
+	    return theSOE;
+	}
+	else {
+	    opserr << "FEM_ObjectBrokerAllClasses::getNewLinearSOE - ";
+	    opserr << " - no Supernodal Domain Solver type exists for class tag ";
+	    opserr << classTagDDSolver << endln;
+	    return 0;
+	}
 	
 					    
       default:
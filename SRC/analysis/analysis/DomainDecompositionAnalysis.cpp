@@ -105,7 +105,8 @@ DomainDecompositionAnalysis::DomainDecompositionAnalysis(Subdomain &the_Domain,
 							 IncrementalIntegrator &integrator,
 							 LinearSOE &theLinSOE,
 							 DomainSolver &theDDSolver,
-							 ConvergenceTest *theTest)
+							 ConvergenceTest *theTest,
+							 bool setLinks)
 
 
 :Analysis(the_Domain),
@@ -120,12 +121,16 @@ DomainDecompositionAnalysis::DomainDecompositionAnalysis(Subdomain &the_Domain,
  theSolver( &theDDSolver),
  theResidual(0),numEqn(0),numExtEqn(0),tangFormed(false),tangFormedCount(0)
 {
-    theModel->setLinks(the_Domain, handler);
-    theHandler->setLinks(*theSubdomain,*theModel,*theIntegrator);
-    theNumberer->setLinks(*theModel);
-    theIntegrator->setLinks(*theModel,*theSOE, theTest);
-    theAlgorithm->setLinks(*theModel,*theIntegrator,*theSOE,
-			   *theSolver,*theSubdomain);
+    // the objects of an analysis that is only sent to a remote subdomain
+    // may be shared with the analysis of the main domain
+    if (setLinks == true) {
+      theModel->setLinks(the_Domain, handler);
+      theHandler->setLinks(*theSubdomain,*theModel,*theIntegrator);
+      theNumberer->setLinks(*theModel);
+      theIntegrator->setLinks(*theModel,*theSOE, theTest);
+      theAlgorithm->setLinks(*theModel,*theIntegrator,*theSOE,
+			     *theSolver,*theSubdomain);
+    }
 
     theSubdomain->setDomainDecompAnalysis(*this);
 }    
@@ -715,6 +720,22 @@ DomainDecompositionAnalysis::setConvergenceTest(ConvergenceTest &theTest)
 
 
 
+int
+DomainDecompositionAnalysis::setNumThreads(int numThreads)
+{
+  if (numThreads < 1)
+    return -1;
+
+  if (theModel != 0)
+    theModel->setNumThreads(numThreads);
+
+  if (theIntegrator != 0)
+    return theIntegrator->setNumThreads(numThreads);
+
+  return 0;
+}
+
+
 int 
 DomainDecompositionAnalysis::checkAllResult(int mine)
 {
@@ -72,7 +72,8 @@ class DomainDecompositionAnalysis: public Analysis, public MovableObject
 				IncrementalIntegrator &theIntegrator,	
 				LinearSOE &theSOE,
 				DomainSolver &theSolver,
-				ConvergenceTest *theTest);
+				ConvergenceTest *theTest,
+				bool setLinks = true);
 
 
 
@@ -111,6 +112,10 @@ class DomainDecompositionAnalysis: public Analysis, public MovableObject
     virtual int setLinearSOE(LinearSOE &theSOE);
     virtual int setEigenSOE(EigenSOE &theSOE);
     virtual int setConvergenceTest(ConvergenceTest &theTest);
+
+    // number of threads used to form and assemble the subdomain tangent
+    // and residual, and to build the graphs of the analysis model
+    virtual int setNumThreads(int numThreads);
     
   protected: 
     Subdomain		*getSubdomainPtr(void) const;
@@ -784,6 +784,22 @@ StaticDomainDecompositionAnalysis::setIntegrator(IncrementalIntegrator &theNewIn
 }
 
 
+int
+StaticDomainDecompositionAnalysis::setNumThreads(int numThreads)
+{
+  if (numThreads < 1)
+    return -1;
+
+  if (theAnalysisModel != 0)
+    theAnalysisModel->setNumThreads(numThreads);
+
+  if (theIntegrator != 0)
+    return theIntegrator->setNumThreads(numThreads);
+
+  return 0;
+}
+
+
 int 
 StaticDomainDecompositionAnalysis::setLinearSOE(LinearSOE &theNewSOE)
 {
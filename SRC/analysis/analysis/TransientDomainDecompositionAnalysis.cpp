@@ -773,6 +773,22 @@ TransientDomainDecompositionAnalysis::setIntegrator(IncrementalIntegrator &theNe
 }
 
 
+int
+TransientDomainDecompositionAnalysis::setNumThreads(int numThreads)
+{
+  if (numThreads < 1)
+    return -1;
+
+  if (theAnalysisModel != 0)
+    theAnalysisModel->setNumThreads(numThreads);
+
+  if (theIntegrator != 0)
+    return theIntegrator->setNumThreads(numThreads);
+
+  return 0;
+}
+
+
 int 
 TransientDomainDecompositionAnalysis::setLinearSOE(LinearSOE &theNewSOE)
 {
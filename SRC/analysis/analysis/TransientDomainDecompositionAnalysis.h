@@ -96,6 +96,7 @@ class TransientDomainDecompositionAnalysis: public DomainDecompositionAnalysis
     int setLinearSOE(LinearSOE &theSOE);
     int setEigenSOE(EigenSOE &theSOE);
     int setConvergenceTest(ConvergenceTest &theTest);
+    int setNumThreads(int numThreads);
 
     // methods to send/receive
     int sendSelf(int commitTag, Channel &theChannel);
@@ -42,15 +42,39 @@
 #include <AnalysisModel.h>
 #include <Matrix.h>
 #include <Vector.h>
+#include <ScratchArena.h>
 
 #define MAX_NUM_DOF 64
 
 // static variables initialisation
 Matrix FE_Element::errMatrix(1, 1);
 Vector FE_Element::errVector(1);
-Matrix** FE_Element::theMatrices; // pointers to class wide matrices
-Vector** FE_Element::theVectors;  // pointers to class widde vectors
-int FE_Element::numFEs(0);           // number of objects
+
+// matrix and vector objects used to return the tangent and residual of
+// FE_Elements with up to MAX_NUM_DOF dof; each thread obtains its own set
+// from its ScratchArena so that FE_Elements can be formed concurrently
+namespace {
+struct FE_ElementWorkspace {
+	Matrix* theMatrices[MAX_NUM_DOF + 1];
+	Vector* theVectors[MAX_NUM_DOF + 1];
+
+	FE_ElementWorkspace() {
+		for (int i = 0; i <= MAX_NUM_DOF; i++) {
+			theMatrices[i] = 0;
+			theVectors[i] = 0;
+		}
+	}
+	~FE_ElementWorkspace() {
+		for (int i = 0; i <= MAX_NUM_DOF; i++) {
+			if (theMatrices[i] != 0)
+				delete theMatrices[i];
+			if (theVectors[i] != 0)
+				delete theVectors[i];
+		}
+	}
+};
+const int workspaceSlot = ScratchArena::newSlot();
+}
 
 //  FE_Element(Element *, Integrator *theIntegrator);
 //	construictor that take the corresponding model element.
@@ -96,50 +120,13 @@ FE_Element::FE_Element(int tag, Element* ele)
 		}
 	}
 
-	// if this is the first FE_Element we now
-	// create the arrays used to store pointers to class wide
-	// matrix and vector objects used to return tangent and residual
-	if (numFEs == 0) {
-		theMatrices = new Matrix * [MAX_NUM_DOF + 1];
-		theVectors = new Vector * [MAX_NUM_DOF + 1];
-
-		if (theMatrices == 0 || theVectors == 0) {
-			opserr << "FE_Element::FE_Element(Element *) ";
-			opserr << " ran out of memory";
-		}
-		for (int i = 0; i < MAX_NUM_DOF; i++) {
-			theMatrices[i] = 0;
-			theVectors[i] = 0;
-		}
-	}
-
 	if (ele->isSubdomain() == false) {
 
-		// if Elements are not subdomains, set up pointers to
-		// objects to return tangent Matrix and residual Vector.
-
-		if (numDOF <= MAX_NUM_DOF) {
-			// use class wide objects
-			if (theVectors[numDOF] == 0) {
-				theVectors[numDOF] = new Vector(numDOF);
-				theMatrices[numDOF] = new Matrix(numDOF, numDOF);
-				theResidual = theVectors[numDOF];
-				theTangent = theMatrices[numDOF];
-				if (theResidual == 0 || theResidual->Size() != numDOF ||
-					theTangent == 0 || theTangent->noCols() != numDOF) {
-					opserr << "FE_Element::FE_Element(Element *) ";
-					opserr << " ran out of memory for vector/Matrix of size :";
-					opserr << numDOF << endln;
-					exit(-1);
-				}
-			}
-			else {
-				theResidual = theVectors[numDOF];
-				theTangent = theMatrices[numDOF];
-			}
-		}
-		else {
-			// create matrices and vectors for each object instance
+		// if Elements are not subdomains, elements with more than
+		// MAX_NUM_DOF dof get their own tangent Matrix and residual
+		// Vector; the others use the class wide objects of the thread
+		// forming them (see tangent() and residual()).
+		if (numDOF > MAX_NUM_DOF) {
 			theResidual = new Vector(numDOF);
 			theTangent = new Matrix(numDOF, numDOF);
 			if (theResidual == 0 || theTangent == 0 ||
@@ -161,9 +148,6 @@ FE_Element::FE_Element(int tag, Element* ele)
 		Subdomain* theSub = (Subdomain*)ele;
 		theSub->setFE_ElementPtr(this);
 	}
-
-	// increment number of FE_Elements by 1
-	numFEs++;
 }
 
 
@@ -173,24 +157,6 @@ FE_Element::FE_Element(int tag, int numDOF_Group, int ndof)
 	myEle(0), theResidual(0), theTangent(0), theIntegrator(0)
 {
 	// this is for a subtype, the subtype must set the myDOF_Groups ID array
-	numFEs++;
-
-	// if this is the first FE_Element we now
-	// create the arrays used to store pointers to class wide
-	// matrix and vector objects used to return tangent and residual
-	if (numFEs == 0) {
-		theMatrices = new Matrix * [MAX_NUM_DOF + 1];
-		theVectors = new Vector * [MAX_NUM_DOF + 1];
-
-		if (theMatrices == 0 || theVectors == 0) {
-			opserr << "FE_Element::FE_Element(Element *) ";
-			opserr << " ran out of memory";
-		}
-		for (int i = 0; i < MAX_NUM_DOF; i++) {
-			theMatrices[i] = 0;
-			theVectors[i] = 0;
-		}
-	}
 
 	// as subtypes have no access to the tangent or residual we don't set them
 	// this way we can detect if subclass does not provide all methods it should
@@ -202,28 +168,11 @@ FE_Element::FE_Element(int tag, int numDOF_Group, int ndof)
 //	destructor.
 FE_Element::~FE_Element()
 {
-
-	// decrement number of FE_Elements
-	numFEs--;
-
 	// delete tangent and residual if created specially
-	if (numDOF > MAX_NUM_DOF) {
-		if (theTangent != 0) delete theTangent;
-		if (theResidual != 0) delete theResidual;
-	}
-
-	// if this is the last FE_Element, clean up the
-	// storage for the matrix and vector objects
-	if (numFEs == 0) {
-		for (int i = 0; i < MAX_NUM_DOF; i++) {
-			if (theVectors[i] != 0)
-				delete theVectors[i];
-			if (theMatrices[i] != 0)
-				delete theMatrices[i];
-		}
-		delete[] theMatrices;
-		delete[] theVectors;
-	}
+	if (theTangent != 0)
+		delete theTangent;
+	if (theResidual != 0)
+		delete theResidual;
 }
 
 
@@ -302,7 +251,7 @@ FE_Element::getTangent(Integrator* theNewIntegrator)
 		if (theNewIntegrator != 0)
 			theNewIntegrator->formEleTangent(this);
 
-		return *theTangent;
+		return *this->tangent();
 	}
 	else {
 		Subdomain* theSub = (Subdomain*)myEle;
@@ -317,7 +266,7 @@ FE_Element::getResidual(Integrator* theNewIntegrator)
 	theIntegrator = theNewIntegrator;
 
 	if (theIntegrator == 0)
-		return *theResidual;
+		return *this->residual();
 
 	if (myEle == 0) {
 		opserr << "FATAL FE_Element::getTangent() - no Element *given ";
@@ -328,7 +277,7 @@ FE_Element::getResidual(Integrator* theNewIntegrator)
 
 	if (myEle->isSubdomain() == false) {
 		theNewIntegrator->formEleResidual(this);
-		return *theResidual;
+		return *this->residual();
 	}
 	else {
 		Subdomain* theSub = (Subdomain*)myEle;
@@ -344,7 +293,7 @@ FE_Element::zeroTangent(void)
 {
 	if (myEle != 0) {
 		if (myEle->isSubdomain() == false)
-			theTangent->Zero();
+			this->tangent()->Zero();
 		else {
 			opserr << "WARNING FE_Element::zeroTangent() - ";
 			opserr << "- this should not be called on a Subdomain!\n";
@@ -363,7 +312,7 @@ FE_Element::addKtToTang(double fact)
 		else if (myEle->isSubdomain() == false)
 		{
 			const Matrix& Kt = myEle->getTangentStiff();
-			theTangent->addMatrix(1.0, Kt, fact);
+			this->tangent()->addMatrix(1.0, Kt, fact);
 		}
 		else {
 			opserr << "WARNING FE_Element::addKToTang() - ";
@@ -381,7 +330,7 @@ FE_Element::addCtoTang(double fact)
 		if (fact == 0.0)
 			return;
 		else if (myEle->isSubdomain() == false)
-			theTangent->addMatrix(1.0, myEle->getDamp(), fact);
+			this->tangent()->addMatrix(1.0, myEle->getDamp(), fact);
 		else {
 			opserr << "WARNING FE_Element::addCToTang() - ";
 			opserr << "- this should not be called on a Subdomain!\n";
@@ -398,7 +347,7 @@ FE_Element::addMtoTang(double fact)
 		if (fact == 0.0)
 			return;
 		else if (myEle->isSubdomain() == false)
-			theTangent->addMatrix(1.0, myEle->getMass(), fact);
+			this->tangent()->addMatrix(1.0, myEle->getMass(), fact);
 		else {
 			opserr << "WARNING FE_Element::addMToTang() - ";
 			opserr << "- this should not be called on a Subdomain!\n";
@@ -415,7 +364,7 @@ FE_Element::addKiToTang(double fact)
 		if (fact == 0.0)
 			return;
 		else if (myEle->isSubdomain() == false)
-			theTangent->addMatrix(1.0, myEle->getInitialStiff(), fact);
+			this->tangent()->addMatrix(1.0, myEle->getInitialStiff(), fact);
 		else {
 			opserr << "WARNING FE_Element::addKiToTang() - ";
 			opserr << "- this should not be called on a Subdomain!\n";
@@ -431,7 +380,7 @@ FE_Element::addKgToTang(double fact)
 		if (fact == 0.0)
 			return;
 		else if (myEle->isSubdomain() == false)
-			theTangent->addMatrix(1.0, myEle->getGeometricTangentStiff(), fact);
+			this->tangent()->addMatrix(1.0, myEle->getGeometricTangentStiff(), fact);
 		else {
 			opserr << "WARNING FE_Element::addKgToTang() - ";
 			opserr << "- this should not be called on a Subdomain!\n";
@@ -449,7 +398,7 @@ FE_Element::addKpToTang(double fact, int numP)
 		else if (myEle->isSubdomain() == false) {
 			const Matrix* thePrevMat = myEle->getPreviousK(numP);
 			if (thePrevMat != 0)
-				theTangent->addMatrix(1.0, *thePrevMat, fact);
+				this->tangent()->addMatrix(1.0, *thePrevMat, fact);
 		}
 		else {
 			opserr << "WARNING FE_Element::addKpToTang() - ";
@@ -475,7 +424,7 @@ FE_Element::zeroResidual(void)
 {
 	if (myEle != 0) {
 		if (myEle->isSubdomain() == false)
-			theResidual->Zero();
+			this->residual()->Zero();
 		else {
 			opserr << "WARNING FE_Element::zeroResidual() - ";
 			opserr << "- this should not be called on a Subdomain!\n";
@@ -496,7 +445,7 @@ FE_Element::addRtoResidual(double fact)
 			return;
 		else if (myEle->isSubdomain() == false) {
 			const Vector& eleResisting = myEle->getResistingForce();
-			theResidual->addVector(1.0, eleResisting, -fact);
+			this->residual()->addVector(1.0, eleResisting, -fact);
 		}
 		else {
 			opserr << "WARNING FE_Element::addRtoResidual() - ";
@@ -519,7 +468,7 @@ FE_Element::addRIncInertiaToResidual(double fact)
 			return;
 		else if (myEle->isSubdomain() == false) {
 			const Vector& eleResisting = myEle->getResistingForceIncInertia();
-			theResidual->addVector(1.0, eleResisting, -fact);
+			this->residual()->addVector(1.0, eleResisting, -fact);
 		}
 		else {
 			opserr << "WARNING FE_Element::addRtoResidual() - ";
@@ -539,11 +488,11 @@ FE_Element::getTangForce(const Vector& disp, double fact)
 	if (myEle != 0) {
 
 		// zero out the force vector
-		theResidual->Zero();
+		this->residual()->Zero();
 
 		// check for a quick return
 		if (fact == 0.0 || !myEle->isActive())
-			return *theResidual;
+			return *this->residual();
 
 		// get the components we need out of the vector
 		// and place in a temporary vector
@@ -559,19 +508,19 @@ FE_Element::getTangForce(const Vector& disp, double fact)
 		if (myEle->isSubdomain() == false) {
 			// form the tangent again and then add the force
 			theIntegrator->formEleTangent(this);
-			if (theResidual->addMatrixVector(1.0, *theTangent, tmp, fact) < 0) {
+			if (this->residual()->addMatrixVector(1.0, *this->tangent(), tmp, fact) < 0) {
 				opserr << "WARNING FE_Element::getTangForce() - ";
 				opserr << "- addMatrixVector returned error\n";
 			}
 		}
 		else {
 			Subdomain* theSub = (Subdomain*)myEle;
-			if (theResidual->addMatrixVector(1.0, theSub->getTang(), tmp, fact) < 0) {
+			if (this->residual()->addMatrixVector(1.0, theSub->getTang(), tmp, fact) < 0) {
 				opserr << "WARNING FE_Element::getTangForce() - ";
 				opserr << "- addMatrixVector returned error\n";
 			}
 		}
-		return *theResidual;
+		return *this->residual();
 	}
 	else {
 		opserr << "WARNING FE_Element::addTangForce() - no Element *given ";
@@ -588,11 +537,11 @@ FE_Element::getK_Force(const Vector& disp, double fact)
 	if (myEle != 0) {
 
 		// zero out the force vector
-		theResidual->Zero();
+		this->residual()->Zero();
 
 		// check for a quick return
 		if (fact == 0.0 || !myEle->isActive())
-			return *theResidual;
+			return *this->residual();
 
 		// get the components we need out of the vector
 		// and place in a temporary vector
@@ -605,12 +554,12 @@ FE_Element::getK_Force(const Vector& disp, double fact)
 				tmp(i) = 0.0;
 		}
 
-		if (theResidual->addMatrixVector(1.0, myEle->getTangentStiff(), tmp, fact) < 0) {
+		if (this->residual()->addMatrixVector(1.0, myEle->getTangentStiff(), tmp, fact) < 0) {
 			opserr << "WARNING FE_Element::getKForce() - ";
 			opserr << "- addMatrixVector returned error\n";
 		}
 
-		return *theResidual;
+		return *this->residual();
 	}
 	else {
 		opserr << "WARNING FE_Element::getKForce() - no Element *given ";
@@ -626,11 +575,11 @@ FE_Element::getKi_Force(const Vector& disp, double fact)
 	if (myEle != 0) {
 
 		// zero out the force vector
-		theResidual->Zero();
+		this->residual()->Zero();
 
 		// check for a quick return
 		if (fact == 0.0 || !myEle->isActive())
-			return *theResidual;
+			return *this->residual();
 
 		// get the components we need out of the vector
 		// and place in a temporary vector
@@ -643,12 +592,12 @@ FE_Element::getKi_Force(const Vector& disp, double fact)
 				tmp(i) = 0.0;
 		}
 
-		if (theResidual->addMatrixVector(1.0, myEle->getInitialStiff(), tmp, fact) < 0) {
+		if (this->residual()->addMatrixVector(1.0, myEle->getInitialStiff(), tmp, fact) < 0) {
 			opserr << "WARNING FE_Element::getKForce() - ";
 			opserr << "- addMatrixVector returned error\n";
 		}
 
-		return *theResidual;
+		return *this->residual();
 	}
 	else {
 		opserr << "WARNING FE_Element::getKForce() - no Element *given ";
@@ -664,11 +613,11 @@ FE_Element::getM_Force(const Vector& disp, double fact)
 	if (myEle != 0) {
 
 		// zero out the force vector
-		theResidual->Zero();
+		this->residual()->Zero();
 
 		// check for a quick return
 		if (fact == 0.0 || !myEle->isActive())
-			return *theResidual;
+			return *this->residual();
 
 		// get the components we need out of the vector
 		// and place in a temporary vector
@@ -681,13 +630,13 @@ FE_Element::getM_Force(const Vector& disp, double fact)
 				tmp(i) = 0.0;
 		}
 
-		if (theResidual->addMatrixVector(1.0, myEle->getMass(), tmp, fact) < 0) {
+		if (this->residual()->addMatrixVector(1.0, myEle->getMass(), tmp, fact) < 0) {
 			opserr << "WARNING FE_Element::getMForce() - ";
 			opserr << "- addMatrixVector returned error\n";
 		}
 
 
-		return *theResidual;
+		return *this->residual();
 	}
 	else {
 		opserr << "WARNING FE_Element::getMForce() - no Element *given ";
@@ -702,11 +651,11 @@ FE_Element::getC_Force(const Vector& disp, double fact)
 	if (myEle != 0) {
 
 		// zero out the force vector
-		theResidual->Zero();
+		this->residual()->Zero();
 
 		// check for a quick return
 		if (fact == 0.0 || !myEle->isActive())
-			return *theResidual;
+			return *this->residual();
 
 		// get the components we need out of the vector
 		// and place in a temporary vector
@@ -719,12 +668,12 @@ FE_Element::getC_Force(const Vector& disp, double fact)
 				tmp(i) = 0.0;
 		}
 
-		if (theResidual->addMatrixVector(1.0, myEle->getDamp(), tmp, fact) < 0) {
+		if (this->residual()->addMatrixVector(1.0, myEle->getDamp(), tmp, fact) < 0) {
 			opserr << "WARNING FE_Element::getDForce() - ";
 			opserr << "- addMatrixVector returned error\n";
 		}
 
-		return *theResidual;
+		return *this->residual();
 	}
 	else {
 		opserr << "WARNING FE_Element::getDForce() - no Element *given ";
@@ -746,18 +695,18 @@ FE_Element::getLastResponse(void)
 {
 	if (myEle != 0) {
 		if (theIntegrator != 0) {
-			if (theIntegrator->getLastResponse(*theResidual, myID) < 0) {
+			if (theIntegrator->getLastResponse(*this->residual(), myID) < 0) {
 				opserr << "WARNING FE_Element::getLastResponse(void)";
 				opserr << " - the Integrator had problems with getLastResponse()\n";
 			}
 		}
 		else {
-			theResidual->Zero();
+			this->residual()->Zero();
 			opserr << "WARNING  FE_Element::getLastResponse()";
 			opserr << " No Integrator yet passed\n";
 		}
 
-		Vector& result = *theResidual;
+		Vector& result = *this->residual();
 		return result;
 	}
 	else {
@@ -787,7 +736,7 @@ FE_Element::addM_Force(const Vector& accel, double fact)
 					tmp(i) = 0.0;
 			}
 
-			if (theResidual->addMatrixVector(1.0, myEle->getMass(), tmp, fact) < 0) {
+			if (this->residual()->addMatrixVector(1.0, myEle->getMass(), tmp, fact) < 0) {
 				opserr << "WARNING FE_Element::addM_Force() - ";
 				opserr << "- addMatrixVector returned error\n";
 			}
@@ -823,7 +772,7 @@ FE_Element::addD_Force(const Vector& accel, double fact)
 					tmp(i) = 0.0;
 			}
 
-			if (theResidual->addMatrixVector(1.0, myEle->getDamp(), tmp, fact) < 0) {
+			if (this->residual()->addMatrixVector(1.0, myEle->getDamp(), tmp, fact) < 0) {
 				opserr << "WARNING FE_Element::addD_Force() - ";
 				opserr << "- addMatrixVector returned error\n";
 			}
@@ -859,7 +808,7 @@ FE_Element::addK_Force(const Vector& disp, double fact)
 					tmp(i) = 0.0;
 			}
 
-			if (theResidual->addMatrixVector(1.0, myEle->getTangentStiff(), tmp, fact) < 0) {
+			if (this->residual()->addMatrixVector(1.0, myEle->getTangentStiff(), tmp, fact) < 0) {
 				opserr << "WARNING FE_Element::addK_Force() - ";
 				opserr << "- addMatrixVector returned error\n";
 			}
@@ -895,7 +844,7 @@ FE_Element::addKg_Force(const Vector& disp, double fact)
 					tmp(i) = 0.0;
 			}
 
-			if (theResidual->addMatrixVector(1.0, myEle->getGeometricTangentStiff(), tmp, fact) < 0) {
+			if (this->residual()->addMatrixVector(1.0, myEle->getGeometricTangentStiff(), tmp, fact) < 0) {
 				opserr << "WARNING FE_Element::addKg_Force() - ";
 				opserr << "- addMatrixVector returned error\n";
 			}
@@ -921,7 +870,7 @@ FE_Element::addLocalM_Force(const Vector& accel, double fact)
 		if (fact == 0.0 || !myEle->isActive())
 			return;
 		if (myEle->isSubdomain() == false) {
-			if (theResidual->addMatrixVector(1.0, myEle->getMass(),
+			if (this->residual()->addMatrixVector(1.0, myEle->getMass(),
 				accel, fact) < 0) {
 
 				opserr << "WARNING FE_Element::addLocalM_Force() - ";
@@ -948,7 +897,7 @@ FE_Element::addLocalD_Force(const Vector& accel, double fact)
 		if (fact == 0.0 || !myEle->isActive())
 			return;
 		if (myEle->isSubdomain() == false) {
-			if (theResidual->addMatrixVector(1.0, myEle->getDamp(),
+			if (this->residual()->addMatrixVector(1.0, myEle->getDamp(),
 				accel, fact) < 0) {
 
 				opserr << "WARNING FE_Element::addLocalD_Force() - ";
@@ -973,12 +922,20 @@ FE_Element::getElement(void)
 	return myEle;
 }
 
+bool
+FE_Element::isReentrant(void) const
+{
+	// FE_Elements without an Element are formed by subclasses, which
+	// are not assumed to be reentrant; Subdomains form their own tangent
+	return myEle != 0 && myEle->isSubdomain() == false && myEle->isReentrant();
+}
+
 
 // AddingSensitivity:BEGIN /////////////////////////////////
 void
 FE_Element::addResistingForceSensitivity(int gradNumber, double fact)
 {
-	theResidual->addVector(1.0, myEle->getResistingForceSensitivity(gradNumber), -fact);
+	this->residual()->addVector(1.0, myEle->getResistingForceSensitivity(gradNumber), -fact);
 }
 
 void
@@ -996,7 +953,7 @@ FE_Element::addM_ForceSensitivity(int gradNumber, const Vector& vect, double fac
 			tmp(i) = 0.0;
 		}
 	}
-	if (theResidual->addMatrixVector(1.0, myEle->getMassSensitivity(gradNumber), tmp, fact) < 0) {
+	if (this->residual()->addMatrixVector(1.0, myEle->getMassSensitivity(gradNumber), tmp, fact) < 0) {
 		opserr << "WARNING FE_Element::addM_ForceSensitivity() - ";
 		opserr << "- addMatrixVector returned error\n";
 	}
@@ -1021,7 +978,7 @@ FE_Element::addD_ForceSensitivity(int gradNumber, const Vector& vect, double fac
 				else
 					tmp(i) = 0.0;
 			}
-			if (theResidual->addMatrixVector(1.0, myEle->getDampSensitivity(gradNumber), tmp, fact) < 0) {
+			if (this->residual()->addMatrixVector(1.0, myEle->getDampSensitivity(gradNumber), tmp, fact) < 0) {
 				opserr << "WARNING FE_Element::addD_ForceSensitivity() - ";
 				opserr << "- addMatrixVector returned error\n";
 			}
@@ -1046,7 +1003,7 @@ FE_Element::addLocalD_ForceSensitivity(int gradNumber, const Vector& accel, doub
 		if (fact == 0.0)
 			return;
 		if (myEle->isSubdomain() == false) {
-			if (theResidual->addMatrixVector(1.0, myEle->getDampSensitivity(gradNumber),
+			if (this->residual()->addMatrixVector(1.0, myEle->getDampSensitivity(gradNumber),
 				accel, fact) < 0) {
 
 				opserr << "WARNING FE_Element::addLocalD_ForceSensitivity() - ";
@@ -1073,7 +1030,7 @@ FE_Element::addLocalM_ForceSensitivity(int gradNumber, const Vector& accel, doub
 		if (fact == 0.0)
 			return;
 		if (myEle->isSubdomain() == false) {
-			if (theResidual->addMatrixVector(1.0, myEle->getMassSensitivity(gradNumber),
+			if (this->residual()->addMatrixVector(1.0, myEle->getMassSensitivity(gradNumber),
 				accel, fact) < 0) {
 
 				opserr << "WARNING FE_Element::addLocalD_ForceSensitivity() - ";
@@ -1144,3 +1101,40 @@ bool FE_Element::isActive()
 		return false;
 	}
 }
+
+
+Matrix*
+FE_Element::tangent(void)
+{
+	if (theTangent != 0)
+		return theTangent;
+
+	if (numDOF > MAX_NUM_DOF) {
+		theTangent = new Matrix(numDOF, numDOF);
+		return theTangent;
+	}
+
+	FE_ElementWorkspace &theWorkspace = ScratchArena::local().get<FE_ElementWorkspace>(workspaceSlot);
+	Matrix*& theMatrix = theWorkspace.theMatrices[numDOF];
+	if (theMatrix == 0)
+		theMatrix = new Matrix(numDOF, numDOF);
+	return theMatrix;
+}
+
+Vector*
+FE_Element::residual(void)
+{
+	if (theResidual != 0)
+		return theResidual;
+
+	if (numDOF > MAX_NUM_DOF) {
+		theResidual = new Vector(numDOF);
+		return theResidual;
+	}
+
+	FE_ElementWorkspace &theWorkspace = ScratchArena::local().get<FE_ElementWorkspace>(workspaceSlot);
+	Vector*& theVector = theWorkspace.theVectors[numDOF];
+	if (theVector == 0)
+		theVector = new Vector(numDOF);
+	return theVector;
+}
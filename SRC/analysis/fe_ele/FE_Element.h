@@ -93,6 +93,10 @@ class FE_Element: public TaggedObject
     virtual const Vector &getLastResponse(void);
     Element *getElement(void);
 
+    // returns true if getTangent() and getResidual() may be invoked on
+    // this object while other FE_Elements are formed on other threads
+    virtual bool isReentrant(void) const;
+
     virtual void  Print(OPS_Stream&, int = 0) {return;};
 
     // AddingSensitivity:BEGIN ////////////////////////////////////
@@ -118,20 +122,22 @@ class FE_Element: public TaggedObject
     ID myID;
 
   private:
+    // tangent and residual objects of this FE_Element; these are the
+    // thread's class wide objects unless the FE_Element owns its own
+    Matrix *tangent(void);
+    Vector *residual(void);
+
     // private variables - a copy for each object of the class    
     int numDOF;
     AnalysisModel *theModel;
     Element *myEle;
-    Vector *theResidual;
-    Matrix *theTangent;
+    Vector *theResidual;       // owned residual, 0 if class wide object used
+    Matrix *theTangent;        // owned tangent, 0 if class wide object used
     Integrator *theIntegrator; // need for Subdomain
     
     // static variables - single copy for all objects of the class	
     static Matrix errMatrix;
     static Vector errVector;
-    static Matrix **theMatrices; // array of pointers to class wide matrices
-    static Vector **theVectors;  // array of pointers to class widde vectors
-    static int numFEs;           // number of objects
     
 
 };
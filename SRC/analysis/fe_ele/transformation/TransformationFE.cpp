@@ -952,6 +952,12 @@ TransformationFE::addM_Force(const Vector &disp,  double fact)
 
 
 
+bool
+TransformationFE::isReentrant(void) const
+{
+  return false;
+}
+
 // CHANGE THE ID SENT
 const Vector &
 TransformationFE::getLastResponse(void)
@@ -69,6 +69,9 @@ class TransformationFE: public FE_Element
     const Vector &getLastResponse(void);
     int addSP(SP_Constraint &theSP);
 
+    // the transformation uses class wide work storage
+    virtual bool isReentrant(void) const;
+
 
     // AddingSensitivity:BEGIN ////////////////////////////////////
     virtual void addM_ForceSensitivity       (int gradNumber, const Vector &vect, double fact = 1.0);
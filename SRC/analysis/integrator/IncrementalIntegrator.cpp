@@ -39,16 +39,21 @@
 #include <FE_EleIter.h>
 #include <DOF_GrpIter.h>
 #include <EigenSOE.h>
+#include <ThreadPool.h>
 #include <cmath>
+#include <atomic>
+#include <chrono>
 
 IncrementalIntegrator::IncrementalIntegrator(int clasTag)
 :Integrator(clasTag),
  statusFlag(CURRENT_TANGENT), theEigenSOE(0), 
  eigenVectors(0), eigenValues(0), dampingForces(0),isDiagonal(false),diagMass(0),
  mV(0),tmpV1(0),tmpV2(0),
- theSOE(0), theAnalysisModel(0), theTest(0)
+ theSOE(0), theAnalysisModel(0), theTest(0),
+ theThreadPool(0), graphStamp(-1)
 {
-  
+  for (int i=0; i<NumAssemblyPhases; i++)
+    assemblyTime[i] = 0.0;
 }
 
 IncrementalIntegrator::~IncrementalIntegrator()
@@ -65,6 +70,8 @@ IncrementalIntegrator::~IncrementalIntegrator()
     delete tmpV1;
   if (tmpV2 != 0)
     delete tmpV2;
+  if (theThreadPool != 0)
+    delete theThreadPool;
 }
 
 void
@@ -100,14 +107,8 @@ IncrementalIntegrator::formTangent(int statFlag)
     // efficiency when performing parallel computations - CHANGE
 
     // loop through the FE_Elements adding their contributions to the tangent
-    FE_Element *elePtr;
-    FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
-    while((elePtr = theEles2()) != 0)     
-	if (theSOE->addA(elePtr->getTangent(this),elePtr->getID()) < 0) {
-	    opserr << "WARNING IncrementalIntegrator::formTangent -";
-	    opserr << " failed in addA for ID " << elePtr->getID();	    
-	    result = -3;
-	}
+    if (this->formElementTangent() < 0)
+	result = -3;
 
     return result;
 }
@@ -266,6 +267,12 @@ IncrementalIntegrator::formNodalUnbalance(void)
 int 
 IncrementalIntegrator::formElementResidual(void)
 {
+    if (theThreadPool != 0 && theThreadPool->getNumThreads() > 1 &&
+	theSOE->canAddConcurrently())
+	return this->assembleColored(false);
+
+    auto start = std::chrono::steady_clock::now();
+
     // loop through the FE_Elements and add the residual
     FE_Element *elePtr;
 
@@ -281,9 +288,245 @@ IncrementalIntegrator::formElementResidual(void)
 	}
     }
 
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    assemblyTime[ResidualPhase] += elapsed.count();
+
     return res;	    
 }
 
+int 
+IncrementalIntegrator::formElementTangent(void)
+{
+    if (theThreadPool != 0 && theThreadPool->getNumThreads() > 1 &&
+	theSOE->canAddConcurrently())
+	return this->assembleColored(true);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // loop through the FE_Elements adding their contributions to the tangent
+    FE_Element *elePtr;
+
+    int res = 0;
+
+    FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
+    while((elePtr = theEles2()) != 0)     
+	if (theSOE->addA(elePtr->getTangent(this), *elePtr) < 0) {
+	    opserr << "WARNING IncrementalIntegrator::formTangent -";
+	    opserr << " failed in addA for ID " << elePtr->getID();	    
+	    res = -3;
+	}
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    assemblyTime[TangentPhase] += elapsed.count();
+
+    return res;
+}
+
+int
+IncrementalIntegrator::setNumThreads(int numThreads)
+{
+    if (numThreads < 1) {
+	opserr << "WARNING IncrementalIntegrator::setNumThreads() -";
+	opserr << " number of threads must be positive\n";
+	return -1;
+    }
+
+    if (theThreadPool != 0) {
+	if (theThreadPool->getNumThreads() == numThreads)
+	    return 0;
+	delete theThreadPool;
+	theThreadPool = 0;
+    }
+
+    // with a single thread the serial loops are used, which add the
+    // contributions in the same order as before
+    if (numThreads > 1)
+	theThreadPool = new ThreadPool(numThreads);
+
+    return 0;
+}
+
+int
+IncrementalIntegrator::getNumThreads(void) const
+{
+    if (theThreadPool == 0)
+	return 1;
+    return theThreadPool->getNumThreads();
+}
+
+int
+IncrementalIntegrator::getNumColors(void) const
+{
+    if (graphStamp < 0)
+	return 0;
+    return colorStart.size() - 1;
+}
+
+double
+IncrementalIntegrator::getAssemblyTime(int phase) const
+{
+    if (phase < 0 || phase >= NumAssemblyPhases)
+	return 0.0;
+    return assemblyTime[phase];
+}
+
+void
+IncrementalIntegrator::zeroAssemblyTimes(void)
+{
+    for (int i=0; i<NumAssemblyPhases; i++)
+	assemblyTime[i] = 0.0;
+}
+
+//
+// Greedy coloring of the FE_Elements: each FE_Element is given the lowest
+// color not used by an already colored FE_Element sharing one of its
+// equations. FE_Elements that are not reentrant are kept aside and added
+// serially after the colors.
+//
+int
+IncrementalIntegrator::colorElements(void)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    theColoredFEs.clear();
+    theSerialFEs.clear();
+    colorStart.clear();
+
+    FE_Element *elePtr;
+    std::vector<FE_Element *> theFEs;
+    FE_EleIter &theEles = theAnalysisModel->getFEs();
+    while ((elePtr = theEles()) != 0) {
+	if (elePtr->isReentrant())
+	    theFEs.push_back(elePtr);
+	else
+	    theSerialFEs.push_back(elePtr);
+    }
+
+    int numFEs = theFEs.size();
+    int numEqn = theSOE->getNumEqn();
+
+    // FE_Elements connected to each equation, in compressed row form
+    std::vector<int> eqnStart(numEqn+1, 0);
+    for (int e=0; e<numFEs; e++) {
+	const ID &id = theFEs[e]->getID();
+	for (int i=0; i<id.Size(); i++)
+	    if (id(i) >= 0 && id(i) < numEqn)
+		eqnStart[id(i)+1]++;
+    }
+    for (int i=0; i<numEqn; i++)
+	eqnStart[i+1] += eqnStart[i];
+
+    std::vector<int> eqnFEs(eqnStart[numEqn]);
+    std::vector<int> fill(eqnStart.begin(), eqnStart.end()-1);
+    for (int e=0; e<numFEs; e++) {
+	const ID &id = theFEs[e]->getID();
+	for (int i=0; i<id.Size(); i++)
+	    if (id(i) >= 0 && id(i) < numEqn)
+		eqnFEs[fill[id(i)]++] = e;
+    }
+
+    std::vector<int> color(numFEs, -1);
+    std::vector<int> usedBy(numFEs+1, -1);  // last FE_Element to see each color
+    int numColors = 0;
+    for (int e=0; e<numFEs; e++) {
+	const ID &id = theFEs[e]->getID();
+	for (int i=0; i<id.Size(); i++) {
+	    int eqn = id(i);
+	    if (eqn < 0 || eqn >= numEqn)
+		continue;
+	    for (int j=eqnStart[eqn]; j<eqnStart[eqn+1]; j++) {
+		int c = color[eqnFEs[j]];
+		if (c >= 0)
+		    usedBy[c] = e;
+	    }
+	}
+	int c = 0;
+	while (usedBy[c] == e)
+	    c++;
+	color[e] = c;
+	if (c == numColors)
+	    numColors++;
+    }
+
+    // order the FE_Elements by color, keeping their original order within
+    colorStart.assign(numColors+1, 0);
+    for (int e=0; e<numFEs; e++)
+	colorStart[color[e]+1]++;
+    for (int c=0; c<numColors; c++)
+	colorStart[c+1] += colorStart[c];
+
+    theColoredFEs.resize(numFEs);
+    fill.assign(colorStart.begin(), colorStart.end()-1);
+    for (int e=0; e<numFEs; e++)
+	theColoredFEs[fill[color[e]]++] = theFEs[e];
+
+    graphStamp = theAnalysisModel->getGraphStamp();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    assemblyTime[ColoringPhase] += elapsed.count();
+
+    return 0;
+}
+
+int
+IncrementalIntegrator::assembleColored(bool tangent)
+{
+    if (graphStamp != theAnalysisModel->getGraphStamp())
+	this->colorElements();
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::atomic<int> numFailed(0);
+    int numThreads = theThreadPool->getNumThreads();
+    int numColors = colorStart.size() - 1;
+
+    for (int c=0; c<numColors; c++) {
+	int first = colorStart[c];
+	int numFEs = colorStart[c+1] - first;
+
+	// hand out a few chunks per thread to balance uneven elements
+	int chunkSize = numFEs / (8*numThreads);
+	if (chunkSize < 1)
+	    chunkSize = 1;
+	int numChunks = (numFEs + chunkSize - 1) / chunkSize;
+
+	theThreadPool->run(numChunks, [&](int chunk, int) {
+	    int end = first + (chunk+1)*chunkSize;
+	    if (end > first + numFEs)
+		end = first + numFEs;
+	    for (int i=first + chunk*chunkSize; i<end; i++) {
+		FE_Element *elePtr = theColoredFEs[i];
+		int res = tangent ?
+		    theSOE->addA(elePtr->getTangent(this), *elePtr) :
+		    theSOE->addB(elePtr->getResidual(this), elePtr->getID());
+		if (res < 0)
+		    numFailed++;
+	    }
+	});
+    }
+
+    for (FE_Element *elePtr : theSerialFEs) {
+	int res = tangent ?
+	    theSOE->addA(elePtr->getTangent(this), *elePtr) :
+	    theSOE->addB(elePtr->getResidual(this), elePtr->getID());
+	if (res < 0)
+	    numFailed++;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    assemblyTime[tangent ? TangentPhase : ResidualPhase] += elapsed.count();
+
+    if (numFailed > 0) {
+	opserr << "WARNING IncrementalIntegrator::" 
+	       << (tangent ? "formTangent" : "formElementResidual") << " -";
+	opserr << " failed in " << (tangent ? "addA" : "addB")
+	       << " for " << numFailed.load() << " FE_Elements\n";
+	return tangent ? -3 : -2;
+    }
+
+    return 0;
+}
+
 /*
 int
 IncrementalIntegrator::setModalDampingFactors(const Vector &factors)
@@ -37,6 +37,7 @@
 // What: "@(#) IncrementalIntegrator.h, revA"
 
 #include <Integrator.h>
+#include <vector>
 
 class LinearSOE;
 class EigenSOE;
@@ -45,6 +46,7 @@ class ConvergenceTest;
 class FE_Element;
 class DOF_Group;
 class Vector;
+class ThreadPool;
 
 #define CURRENT_TANGENT 0
 #define INITIAL_TANGENT 1
@@ -103,6 +105,19 @@ class IncrementalIntegrator : public Integrator
     
     // method introduced for domain decomposition
     virtual int getLastResponse(Vector &result, const ID &id);
+
+    // methods for threaded assembly of the FE_Element contributions
+    enum AssemblyPhase {
+      ColoringPhase,   // grouping FE_Elements into conflict free colors
+      TangentPhase,    // forming and adding the FE_Element tangents
+      ResidualPhase,   // forming and adding the FE_Element residuals
+      NumAssemblyPhases
+    };
+    int    setNumThreads(int numThreads);
+    int    getNumThreads(void) const;
+    int    getNumColors(void) const;
+    double getAssemblyTime(int phase) const;
+    void   zeroAssemblyTimes(void);
     
   protected:
     LinearSOE *getLinearSOE(void) const;
@@ -111,6 +126,7 @@ class IncrementalIntegrator : public Integrator
 
     virtual int  formNodalUnbalance(void);        
     virtual int  formElementResidual(void);            
+    int formElementTangent(void);
     int statusFlag;
     double iFactor;
     double cFactor;
@@ -127,10 +143,23 @@ class IncrementalIntegrator : public Integrator
     Vector *tmpV2;
     
   private:
+    int colorElements(void);
+    int assembleColored(bool tangent);
+
     LinearSOE *theSOE;
     AnalysisModel *theAnalysisModel;
     ConvergenceTest *theTest;
 
+    // threaded assembly; the FE_Elements are grouped into colors such
+    // that no two FE_Elements of a color share an equation, so each
+    // color can be formed and added to the LinearSOE concurrently
+    ThreadPool *theThreadPool;
+    int graphStamp;                      // AnalysisModel stamp of the colors
+    std::vector<FE_Element *> theColoredFEs;
+    std::vector<int> colorStart;         // start of each color in theColoredFEs
+    std::vector<FE_Element *> theSerialFEs; // FE_Elements that are not reentrant
+    double assemblyTime[NumAssemblyPhases];
+
 };
 
 #endif
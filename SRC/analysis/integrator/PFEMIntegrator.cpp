@@ -379,7 +379,7 @@ PFEMIntegrator::formTangent(int statFlag)
     FE_EleIter &theEles2 = theModel->getFEs();
     FE_Element *elePtr;
     while((elePtr = theEles2()) != 0)     {
-        if (theLinSOE->addA(elePtr->getTangent(this),elePtr->getID()) < 0) {
+        if (theLinSOE->addA(elePtr->getTangent(this), *elePtr) < 0) {
             opserr << "TransientIntegrator::formTangent() - failed to addA:ele\n";
             result = -2;
         }
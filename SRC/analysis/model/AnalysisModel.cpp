@@ -45,6 +45,9 @@
 #include <DOF_GrpIter.h>
 #include <FE_EleIter.h>
 #include <Graph.h>
+#include <CSRGraph.h>
+#include <ThreadPool.h>
+#include <vector>
 #include <Vertex.h>
 #include <Node.h>
 #include <NodeIter.h>
@@ -63,7 +66,8 @@ AnalysisModel::AnalysisModel(int theClassTag)
 :MovableObject(theClassTag),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ myCSRDOFGraph(0), myCSRGroupGraph(0), theThreadPool(0),
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0), graphStamp(0)
 {
     theFEs     = new ArrayOfTaggedObjects(1024);
     theDOFs    =  new ArrayOfTaggedObjects(1024);
@@ -77,7 +81,8 @@ AnalysisModel::AnalysisModel()
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ myCSRDOFGraph(0), myCSRGroupGraph(0), theThreadPool(0),
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0), graphStamp(0)
 {
   theFEs     = new ArrayOfTaggedObjects(256);
   theDOFs    = new ArrayOfTaggedObjects(256);
@@ -90,7 +95,8 @@ AnalysisModel::AnalysisModel(TaggedObjectStorage &theFes, TaggedObjectStorage &t
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ myCSRDOFGraph(0), myCSRGroupGraph(0), theThreadPool(0),
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0), graphStamp(0)
 {
   theFEs     = &theFes;
   theDOFs    = &theDofs;
@@ -125,6 +131,15 @@ AnalysisModel::~AnalysisModel()
   if (myDOFGraph != 0) {
     delete myDOFGraph;
   }
+
+  if (myCSRGroupGraph != 0)
+    delete myCSRGroupGraph;
+
+  if (myCSRDOFGraph != 0)
+    delete myCSRDOFGraph;
+
+  if (theThreadPool != 0)
+    delete theThreadPool;
 }    
 
 void
@@ -215,10 +230,18 @@ AnalysisModel::clearAll(void)
 
     myDOFGraph = 0;
     myGroupGraph = 0;
+
+    if (myCSRDOFGraph != 0)
+	delete myCSRDOFGraph;
+    if (myCSRGroupGraph != 0)
+	delete myCSRGroupGraph;
+    myCSRDOFGraph = 0;
+    myCSRGroupGraph = 0;
     
     numFE_Ele =0;
     numDOF_Grp = 0;
     numEqn = 0;    
+    graphStamp++;
 }
 
 void
@@ -227,7 +250,12 @@ AnalysisModel::clearDOFGraph(void)
   if (myDOFGraph != 0)
     delete myDOFGraph;
 
+  if (myCSRDOFGraph != 0)
+    delete myCSRDOFGraph;
+
     myDOFGraph = 0;
+    myCSRDOFGraph = 0;
+    graphStamp++;
 }
 
 void
@@ -235,8 +263,12 @@ AnalysisModel::clearDOFGroupGraph(void)
 {
   if (myGroupGraph != 0)
     delete myGroupGraph;    
+
+  if (myCSRGroupGraph != 0)
+    delete myCSRGroupGraph;
   
   myGroupGraph = 0;
+  myCSRGroupGraph = 0;
 }
 
 
@@ -287,76 +319,106 @@ AnalysisModel::getNumEqn(void) const
     return numEqn;
 }
 
+int
+AnalysisModel::getGraphStamp(void) const
+{
+    return graphStamp;
+}
+
 
 Graph &
 AnalysisModel::getDOFGraph(void)
 {
-  if (myDOFGraph == 0) {
-    int numVertex = this->getNumDOF_Groups();
+  // the vertices and their adjacency are set in one go from the
+  // compressed graph, rather than an edge at a time
+  if (myDOFGraph == 0)
+    myDOFGraph = new Graph(this->getCSRDOFGraph());
 
-    //    myDOFGraph = new Graph(numVertex);
-    MapOfTaggedObjects *graphStorage = new MapOfTaggedObjects();
-    myDOFGraph = new Graph(*graphStorage);
+  return *myDOFGraph;
+}
 
-    //
-    // create a vertex for each dof
-    //
-    
+
+const CSRGraph &
+AnalysisModel::getCSRDOFGraph(void)
+{
+  if (myCSRDOFGraph == 0) {
+    myCSRDOFGraph = new CSRGraph();
+
+    // a vertex for each equation number of the DOF_Groups
+    int numVertex = 0;
     DOF_Group *dofPtr =0;
     DOF_GrpIter &theDOFs = this->getDOFs();
     while ((dofPtr = theDOFs()) != 0) {
       const ID &id = dofPtr->getID();
       int size = id.Size();
-      for (int i=0; i<size; i++) {
-	int dofTag = id(i);
-	if (dofTag >= START_EQN_NUM) {
-	  Vertex *vertexPtr = myDOFGraph->getVertexPtr(dofTag);
-	  if (vertexPtr == 0) {
-	    Vertex *vertexPtr = new Vertex(dofTag, dofTag);      
-	    if (vertexPtr == 0) {
-	      opserr << "WARNING AnalysisModel::getDOFGraph";
-	      opserr << " - Not Enough Memory to create " << i+1 << "th Vertex\n";
-	      return *myDOFGraph;
-	    }
-	    if (myDOFGraph->addVertex(vertexPtr, false) == false) {
-	      opserr << "WARNING AnalysisModel::getDOFGraph - error adding vertex\n";
-	      return *myDOFGraph;
-	    }
-	  }
-	}
-      }
+      for (int i=0; i<size; i++)
+	if (id(i) - START_EQN_NUM + START_VERTEX_NUM >= numVertex)
+	  numVertex = id(i) - START_EQN_NUM + START_VERTEX_NUM + 1;
     }
-    
-    // now add the edges, by looping over the FE_elements, getting their
-    // IDs and adding edges between DOFs for equation numbers >= START_EQN_NUM
-    
+
+    // and an edge between all the equations of each FE_Element
+    std::vector<const ID *> theIDs;
+    theIDs.reserve(numFE_Ele);
     FE_Element *elePtr =0;
     FE_EleIter &eleIter = this->getFEs();
-    int cnt = 0;
-    
-	myDOFGraph->startAddEdge();
-    while((elePtr = eleIter()) != 0) {
-      const ID &id = elePtr->getID();
-      cnt++;
-      int size = id.Size();
-      for (int i=0; i<size; i++) {
-	int eqn1 = id(i);
-	
-	// if eqnNum of DOF is a valid eqn number add an edge
-	// to all other DOFs with valid eqn numbers.
-	if (eqn1 >=START_EQN_NUM) {
-	  for (int j=i+1; j<size; j++) {
-	    int eqn2 = id(j);
-	    if (eqn2 >=START_EQN_NUM)
-	      myDOFGraph->addEdgeFast(eqn1-START_EQN_NUM+START_VERTEX_NUM,
-				  eqn2-START_EQN_NUM+START_VERTEX_NUM);
-	  }
-	}
-      }
+    while((elePtr = eleIter()) != 0)
+      theIDs.push_back(&elePtr->getID());
+
+    if (myCSRDOFGraph->build(numVertex, theIDs, theThreadPool) < 0)
+      opserr << "WARNING AnalysisModel::getCSRDOFGraph - failed to build the graph\n";
+  }
+
+  return *myCSRDOFGraph;
+}
+
+
+const CSRGraph &
+AnalysisModel::getCSRDOFGroupGraph(void)
+{
+  if (myCSRGroupGraph == 0) {
+    myCSRGroupGraph = new CSRGraph();
+
+    // the DOF_Group tags are used as the vertices
+    DOF_Group *dofPtr;
+    DOF_GrpIter &theDOFs = this->getDOFs();
+    while ((dofPtr = theDOFs()) != 0) {
+      int tag = dofPtr->getTag();
+      if (tag < 0 || tag >= numDOF_Grp)
+	return *myCSRGroupGraph;
     }
-  }    
 
-  return *myDOFGraph;
+    std::vector<const ID *> theTags;
+    theTags.reserve(numFE_Ele);
+    FE_Element *elePtr;
+    FE_EleIter &eleIter = this->getFEs();
+    while((elePtr = eleIter()) != 0)
+      theTags.push_back(&elePtr->getDOFtags());
+
+    if (myCSRGroupGraph->build(numDOF_Grp, theTags, theThreadPool) < 0)
+      opserr << "WARNING AnalysisModel::getCSRDOFGroupGraph - failed to build the graph\n";
+  }
+
+  return *myCSRGroupGraph;
+}
+
+
+int
+AnalysisModel::setNumThreads(int numThreads)
+{
+  if (numThreads < 1)
+    return -1;
+
+  if (theThreadPool != 0) {
+    if (theThreadPool->getNumThreads() == numThreads)
+      return 0;
+    delete theThreadPool;
+    theThreadPool = 0;
+  }
+
+  if (numThreads > 1)
+    theThreadPool = new ThreadPool(numThreads);
+
+  return 0;
 }
 
 
@@ -46,6 +46,8 @@ class Domain;
 class FE_EleIter;
 class DOF_GrpIter;
 class Graph;
+class CSRGraph;
+class ThreadPool;
 class FE_Element;
 class DOF_Group;
 class Vector;
@@ -79,6 +81,19 @@ class AnalysisModel: public MovableObject
     virtual int getNumEqn(void) const ; 
     virtual Graph &getDOFGraph(void);
     virtual Graph &getDOFGroupGraph(void);
+
+    // the same connectivity in compressed form, vertex i being equation
+    // i or DOF_Group i; the DOF_Group graph has no vertices if the
+    // DOF_Group tags are not 0 through getNumDOF_Groups()-1
+    virtual const CSRGraph &getCSRDOFGraph(void);
+    virtual const CSRGraph &getCSRDOFGroupGraph(void);
+
+    // threads used to build the compressed graphs
+    int setNumThreads(int numThreads);
+
+    // stamp that changes whenever the FE_Elements, DOF_Groups or the
+    // equation numbering may have changed; lets users cache connectivity
+    int getGraphStamp(void) const;
     
     // methods to update the response quantities at the DOF_Groups,
     // which in turn set the new nodal trial response quantities.
@@ -130,10 +145,14 @@ class AnalysisModel: public MovableObject
 
     Graph *myDOFGraph;
     Graph *myGroupGraph;    
+    CSRGraph *myCSRDOFGraph;
+    CSRGraph *myCSRGroupGraph;
+    ThreadPool *theThreadPool;
     
     int numFE_Ele;             // number of FE_Elements objects added
     int numDOF_Grp;            // number of DOF_Group objects added
     int numEqn;                // numEqn set by the ConstraintHandler typically
+    int graphStamp;            // incremented when the model connectivity is cleared
 
     TaggedObjectStorage  *theFEs;
     TaggedObjectStorage  *theDOFs;
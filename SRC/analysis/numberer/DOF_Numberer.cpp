@@ -47,6 +47,7 @@
 #include <FEM_ObjectBroker.h>
 
 #include <Graph.h>
+#include <CSRGraph.h>
 
 #include <Domain.h>
 #include <MP_Constraint.h>
@@ -119,10 +120,14 @@ DOF_Numberer::numberDOF(int lastDOF_Group)
     if (theAnalysisModel->getNumDOF_Groups() == 0)
 	return 0;
 
-    // we first number the dofs using the dof group graph
+    // we first number the dofs using the dof group graph, in its
+    // compressed form unless the DOF_Group tags do not allow it
 
-    const ID &orderedRefs = theGraphNumberer->
-      number(theAnalysisModel->getDOFGroupGraph(), lastDOF_Group);     
+    const CSRGraph &theGroupGraph = theAnalysisModel->getCSRDOFGroupGraph();
+    const ID &orderedRefs = 
+      (theGroupGraph.getNumVertex() == theAnalysisModel->getNumDOF_Groups()) ?
+      theGraphNumberer->number(theGroupGraph, lastDOF_Group) :
+      theGraphNumberer->number(theAnalysisModel->getDOFGroupGraph(), lastDOF_Group);
 
     theAnalysisModel->clearDOFGroupGraph();
 
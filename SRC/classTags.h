@@ -1137,6 +1137,7 @@
 #define LinSOE_TAGS_PFEMCompressibleLinSOE 28
 #define LinSOE_TAGS_PFEMQuasiLinSOE 29
 #define LinSOE_TAGS_PFEMDiaLinSOE 30
+#define LinSOE_TAGS_SupernodalSymLinSOE 31
 #define LinSOE_TAGS_PARDISOGenLinSOE 99990
 
 
@@ -1173,6 +1174,10 @@
 #define SOLVER_TAGS_CuSP                                31
 #define SOLVER_TAGS_PFEMQuasiSolver                     32
 #define SOLVER_TAGS_PFEMDiaSolver                       33
+#define SOLVER_TAGS_SupernodalSymLinSolver              34
+#define SOLVER_TAGS_SparseGenRowAMGCLSolver             35
+#define SOLVER_TAGS_SparseGenColAMGCLSolver             36
+#define SOLVER_TAGS_SupernodalSymLinSubstrSolver        37
 
 #define RECORDER_TAGS_ElementRecorder		1
 #define RECORDER_TAGS_NodeRecorder		2
@@ -1218,6 +1223,7 @@
 #define OPS_STREAM_TAGS_ChannelStream           9
 #define OPS_STREAM_TAGS_DataTurbineStream      10
 #define OPS_STREAM_TAGS_DataFileStreamAdd      11
+#define OPS_STREAM_TAGS_ColumnarFileStream     12
 
 
 #define DomDecompALGORITHM_TAGS_DomainDecompAlgo 1
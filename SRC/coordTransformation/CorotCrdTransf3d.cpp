@@ -36,6 +36,7 @@
 #include <math.h>
 #include <Vector.h>
 #include <Matrix.h>
+#include <MatrixND.h>
 #include <Node.h>
 #include <Channel.h>
 #include <elementAPI.h>
@@ -1177,33 +1178,49 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     this->update();
     
     int i, j, k;   
+
+    // the products below are formed with the sizes known to the compiler
+    MatrixND<6,7> Tpnd;
+    MatrixND<7,12> Tnd;
+    MatrixND<12,3> Lr2nd, Lr3nd;
+    MatrixND<3,3> And;
+    MatrixND<6,6> kbnd;
+    VectorND<6> pbnd;
+    Tpnd = Tp;
+    Tnd = T;
+    Lr2nd = Lr2;
+    Lr3nd = Lr3;
+    And = A;
+    kbnd = kb;
+    pbnd = pb;
+
     // transform tangent stiffness matrix from the basic system to local coordinates
-    static Matrix kl(7,7);
-    kl.addMatrixTripleProduct(0.0, Tp, kb, 1.0);      // kl = Tp ^ kb * Tp;
+    MatrixND<7,7> kl;
+    kl.addMatrixTripleProduct(0.0, Tpnd, kbnd, 1.0);      // kl = Tp ^ kb * Tp;
 
     //    opserr << "kb: " << kb;
     //    opserr << "Tp: " << Tp;
     
     // transform resisting forces from the basic system to local coordinates
-    static Vector pl(7);
-    pl.addMatrixTransposeVector(0.0, Tp, pb, 1.0);    // pl = Tp ^ pb;
+    VectorND<7> pl;
+    pl.addMatrixTransposeVector(0.0, Tpnd, pbnd, 1.0);    // pl = Tp ^ pb;
     
     // transform tangent  stiffness matrix from local to global coordinates
-    //static Matrix kg(12,12);
+    MatrixND<12,12> kgnd;
     
     // compute the tangent stiffness matrix in global coordinates
-    kg.addMatrixTripleProduct(0.0, T, kl, 1.0);
+    kgnd.addMatrixTripleProduct(0.0, Tnd, kl, 1.0);
     
-    static Vector m(6);
+    VectorND<6> m;
     for (i = 0; i < 6; i++)
         m(i) = pl(i)/(2*cos(ul(i)));
     
     // compute the basic rotations
     
-    static Vector e1(3), e2(3), e3(3);
-    static Vector r1(3), r2(3), r3(3);
-    static Vector rI1(3), rI2(3), rI3(3);
-    static Vector rJ1(3), rJ2(3), rJ3(3);
+    VectorND<3> e1, e2, e3;
+    VectorND<3> r1, r2, r3;
+    VectorND<3> rI1, rI2, rI3;
+    VectorND<3> rJ1, rJ2, rJ3;
     
     for (k = 0; k < 3; k ++)
     {
@@ -1230,9 +1247,9 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     //        m(5)*ks2r2u1 + m(6)*ks2r3u1 + ...
     //        ks3 + ks3' + ks4 + ks5;
     
-    static Matrix Se1(3,3), Se2(3,3), Se3(3,3);
-    static Matrix SrI1(3,3), SrI2(3,3), SrI3(3,3);
-    static Matrix SrJ1(3,3), SrJ2(3,3), SrJ3(3,3);
+    MatrixND<3,3> Se1, Se2, Se3;
+    MatrixND<3,3> SrI1, SrI2, SrI3;
+    MatrixND<3,3> SrJ1, SrJ2, SrJ3;
     
     Se1 = this->getSkewSymMatrix(e1);
     Se2 = this->getSkewSymMatrix(e2);
@@ -1256,10 +1273,10 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     
     double factor;
     
-    kg.Assemble(A, 0, 0,  pl(6));
-    kg.Assemble(A, 0, 6, -pl(6));
-    kg.Assemble(A, 6, 0, -pl(6));
-    kg.Assemble(A, 6, 6,  pl(6));
+    kgnd.Assemble(And, 0, 0,  pl(6));
+    kgnd.Assemble(And, 0, 6, -pl(6));
+    kgnd.Assemble(And, 6, 0, -pl(6));
+    kgnd.Assemble(And, 6, 6,  pl(6));
     
     //opserr << "kg += ksigma1: " << kg;
     
@@ -1272,34 +1289,34 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     
     //     ks3 = [o kbar2 o kbar4];
     
-    static Matrix Sm(3,3);
-    static Matrix kbar(12,3);
+    MatrixND<3,3> Sm;
+    MatrixND<12,3> kbar;
     
     Sm.addMatrix(0.0, SrI3,  m(3));
     Sm.addMatrix(1.0, SrI1,  m(1));
     
-    kbar.addMatrixProduct(0.0, Lr2, Sm, -1.0);
+    kbar.addMatrixProduct(0.0, Lr2nd, Sm, -1.0);
     
     Sm.addMatrix(0.0, SrI2,  m(3));
     Sm.addMatrix(1.0, SrI1, -m(2));
     
-    kbar.addMatrixProduct(1.0, Lr3, Sm,  1.0);
+    kbar.addMatrixProduct(1.0, Lr3nd, Sm,  1.0);
     
-    kg.Assemble(kbar, 0, 3, 1.0);
-    kg.AssembleTranspose(kbar, 3, 0, 1.0);
+    kgnd.Assemble(kbar, 0, 3, 1.0);
+    kgnd.AssembleTranspose(kbar, 3, 0, 1.0);
     
     Sm.addMatrix(0.0, SrJ3,  m(3));
     Sm.addMatrix(1.0, SrJ1, -m(4));
     
-    kbar.addMatrixProduct(0.0, Lr2, Sm, 1.0);
+    kbar.addMatrixProduct(0.0, Lr2nd, Sm, 1.0);
     
     Sm.addMatrix(0.0, SrJ2, m(3));
     Sm.addMatrix(1.0, SrJ1, m(5));
     
-    kbar.addMatrixProduct(1.0, Lr3, Sm,  -1.0);
+    kbar.addMatrixProduct(1.0, Lr3nd, Sm,  -1.0);
     
-    kg.Assemble(kbar, 0, 9, 1.0);
-    kg.AssembleTranspose(kbar, 9, 0, 1.0);
+    kgnd.Assemble(kbar, 0, 9, 1.0);
+    kgnd.AssembleTranspose(kbar, 9, 0, 1.0);
     
     //opserr << "kg += ksigma3: " << kg;
     
@@ -1317,7 +1334,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     //           O    O     O    O;
     //           O    O     O  Ks4_44];
     
-    static Matrix ks33(3,3);
+    MatrixND<3,3> ks33;
     
     ks33.addMatrixProduct(0.0, Se2, SrI3,  m(3));
     ks33.addMatrixProduct(1.0, Se3, SrI2, -m(3));
@@ -1328,7 +1345,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     ks33.addMatrixProduct(1.0, Se3, SrI1,  m(2));
     ks33.addMatrixProduct(1.0, Se1, SrI3, -m(2));
     
-    kg.Assemble(ks33, 3, 3, 1.0);
+    kgnd.Assemble(ks33, 3, 3, 1.0);
     
     ks33.addMatrixProduct(0.0, Se2, SrJ3, -m(3));
     ks33.addMatrixProduct(1.0, Se3, SrJ2,  m(3));
@@ -1339,7 +1356,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     ks33.addMatrixProduct(1.0, Se3, SrJ1,  m(5));
     ks33.addMatrixProduct(1.0, Se1, SrJ3, -m(5));
     
-    kg.Assemble(ks33, 9, 9, 1.0);
+    kgnd.Assemble(ks33, 9, 9, 1.0);
     
     //opserr << "kg += ksigma4: " << kg;
     
@@ -1351,7 +1368,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     //          Ks5_14t     O   -Ks5_14t   O];
     
     // v = (1/Ln)*(m(2)*rI2 + m(3)*rI3 + m(5)*rJ2 + m(6)*rJ3);
-    static Vector v(3);
+    VectorND<3> v;
     v.addVector (0.0, rI2, m(1));
     v.addVector (1.0, rI3, m(2));
     v.addVector (1.0, rJ2, m(4));
@@ -1360,75 +1377,75 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     v /= Ln;
     
     //Ks5_11 = A*v*e1' + e1*v'*A + (e1'*v)*A;
-    static Matrix m33(3,3);
+    MatrixND<3,3> m33;
     double  e1tv = 0;   // dot product e1. v
     
     for (i = 0; i < 3; i++)
         e1tv += e1(i) * v(i);
     
-    ks33.addMatrix (0.0, A, e1tv);
+    ks33.addMatrix (0.0, And, e1tv);
     
     for (i = 0; i < 3; i++)
         for (j = 0; j < 3; j++)
             m33(i,j) = v(i)*e1(j);
         
-        ks33.addMatrixProduct (1.0, A, m33, 1.0);
+        ks33.addMatrixProduct (1.0, And, m33, 1.0);
         
         for (i = 0; i < 3; i++)
             for (j = 0; j < 3; j++)
                 m33(i,j) = e1(i)*v(j);
             
-            ks33.addMatrixProduct (1.0, m33, A, 1.0);
+            ks33.addMatrixProduct (1.0, m33, And, 1.0);
             
-            kg.Assemble(ks33, 0, 0,  1.0);
-            kg.Assemble(ks33, 0, 6, -1.0);
-            kg.Assemble(ks33, 6, 0, -1.0);
-            kg.Assemble(ks33, 6, 6,  1.0);
+            kgnd.Assemble(ks33, 0, 0,  1.0);
+            kgnd.Assemble(ks33, 0, 6, -1.0);
+            kgnd.Assemble(ks33, 6, 0, -1.0);
+            kgnd.Assemble(ks33, 6, 6,  1.0);
             
             //Ks5_12 = -(m(2)*A*S(rI2) + m(3)*A*S(rI3));
             
-            ks33.addMatrixProduct(0.0, A, SrI2, -m(1));
-            ks33.addMatrixProduct(1.0, A, SrI3, -m(2));
+            ks33.addMatrixProduct(0.0, And, SrI2, -m(1));
+            ks33.addMatrixProduct(1.0, And, SrI3, -m(2));
             
-            kg.Assemble(ks33, 0, 3,  1.0);
-            kg.Assemble(ks33, 6, 3, -1.0);
+            kgnd.Assemble(ks33, 0, 3,  1.0);
+            kgnd.Assemble(ks33, 6, 3, -1.0);
             
-            kg.AssembleTranspose(ks33, 3, 0,  1.0);
-            kg.AssembleTranspose(ks33, 3, 6, -1.0);
+            kgnd.AssembleTranspose(ks33, 3, 0,  1.0);
+            kgnd.AssembleTranspose(ks33, 3, 6, -1.0);
             
             //  Ks5_14 = -(m(5)*A*S(rJ2) + m(6)*A*S(rJ3));
             
-            ks33.addMatrixProduct(0.0, A, SrJ2, -m(4));
-            ks33.addMatrixProduct(1.0, A, SrJ3, -m(5));
+            ks33.addMatrixProduct(0.0, And, SrJ2, -m(4));
+            ks33.addMatrixProduct(1.0, And, SrJ3, -m(5));
             
-            kg.Assemble(ks33, 0, 9,  1.0);
-            kg.Assemble(ks33, 6, 9, -1.0);
+            kgnd.Assemble(ks33, 0, 9,  1.0);
+            kgnd.Assemble(ks33, 6, 9, -1.0);
             
-            kg.AssembleTranspose(ks33, 9, 0,  1.0);
-            kg.AssembleTranspose(ks33, 9, 6, -1.0);
+            kgnd.AssembleTranspose(ks33, 9, 0,  1.0);
+            kgnd.AssembleTranspose(ks33, 9, 6, -1.0);
             
             //opserr << "kg += ksigma5: " << kg;
             
             // Ksigma -------------------------------
-            static Vector rm(3);
+            VectorND<3> rm;
             
             rm = rI3;
             rm.addVector (1.0, rJ3, -1.0); 
             //opserr << "ks2(r2,rI3-rJ3):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r2, rm), m(3));
+            kgnd.addMatrix (1.0, this->getKs2Matrix(r2, rm), m(3));
             
             rm = rJ2;
             rm.addVector (1.0, rI2, -1.0); 
             //opserr << "ks2(r3,rJ2-rI2):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r3, rm), m(3));
+            kgnd.addMatrix (1.0, this->getKs2Matrix(r3, rm), m(3));
             //opserr << "ks2(r2,rI1):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r2, rI1), m(1));
+            kgnd.addMatrix (1.0, this->getKs2Matrix(r2, rI1), m(1));
             //opserr << "ks2(r3,rI1):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r3, rI1), m(2));
+            kgnd.addMatrix (1.0, this->getKs2Matrix(r3, rI1), m(2));
             //opserr << "ks2(r2,rJ1):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r2, rJ1), m(4));
+            kgnd.addMatrix (1.0, this->getKs2Matrix(r2, rJ1), m(4));
             //opserr << "ks2(r3,rJ1):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r3, rJ1), m(5));
+            kgnd.addMatrix (1.0, this->getKs2Matrix(r3, rJ1), m(5));
             
             //opserr << "kg += ksigma2: " << kg;
             
@@ -1439,9 +1456,11 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
                 factor = pl(k) * tan(ul(k));
                 for (i = 0; i < 12; i++)
                     for (j = 0; j < 12; j++)
-                        kg(i,j) += T(k,i) * factor * T(k,j);
+                        kgnd(i,j) += Tnd(k,i) * factor * Tnd(k,j);
             }
             
+            kg = kgnd;
+
 	    //            opserr << "COROATIONAL 3d: kg final: " << kg;
             
             return kg;
@@ -1452,14 +1471,22 @@ const Matrix &
 CorotCrdTransf3d::getInitialGlobalStiffMatrix(const Matrix &kb)
 {
     // transform tangent stiffness matrix from the basic system to local coordinates
-    static Matrix kl(7,7);
-    kl.addMatrixTripleProduct(0.0, Tp, kb, 1.0);      // kl = Tp ^ kb * Tp;
+    MatrixND<6,7> Tpnd;
+    MatrixND<7,12> Tnd;
+    MatrixND<6,6> kbnd;
+    Tpnd = Tp;
+    Tnd = T;
+    kbnd = kb;
+
+    MatrixND<7,7> kl;
+    kl.addMatrixTripleProduct(0.0, Tpnd, kbnd, 1.0);      // kl = Tp ^ kb * Tp;
     
     // transform tangent  stiffness matrix from local to global coordinates
-    //static Matrix kg(12,12);
+    MatrixND<12,12> kgnd;
     
     // compute the tangent stiffness matrix in global coordinates
-    kg.addMatrixTripleProduct(0.0, T, kl, 1.0);
+    kgnd.addMatrixTripleProduct(0.0, Tnd, kl, 1.0);
+    kg = kgnd;
     
     return kg;
 }
@@ -68,6 +68,11 @@ public:
     virtual int commitState(void) = 0;
     virtual int revertToLastCommit(void) = 0;
     virtual int revertToStart(void) = 0;
+
+    // returns true if the methods used in the state determination of an
+    // element may be invoked on this object while other transformations
+    // are used on other threads
+    virtual bool isReentrant(void) const {return false;}
     
     virtual const Vector &getBasicTrialDisp(void) = 0;
     virtual const Vector &getBasicIncrDisp(void) = 0;
@@ -43,11 +43,23 @@
 #include <Channel.h>
 #include <elementAPI.h>
 #include <string>
+#include <ScratchArena.h>
 #include <LinearCrdTransf2d.h>
 
-// initialize static variables
-Matrix LinearCrdTransf2d::Tlg(6,6);
-Matrix LinearCrdTransf2d::kg(6,6);
+// work storage of LinearCrdTransf2d; each thread obtains its own copy from its
+// ScratchArena so that transformations can be used concurrently
+struct LinearCrdTransf2d::Workspace {
+    Matrix Tlg;  // matrix that transforms from global to local coordinates
+    Matrix kg;   // global stiffness matrix
+    Vector ub, dub, Dub, vb, ab, pg;
+
+    Workspace()
+      :Tlg(6,6), kg(6,6),
+       ub(3), dub(3), Dub(3), vb(3), ab(3), pg(6)
+    {}
+};
+
+static const int workSlot = ScratchArena::newSlot();
 
 void* OPS_LinearCrdTransf2d()
 {
@@ -170,6 +182,14 @@ LinearCrdTransf2d::revertToStart(void)
 }
 
 
+bool
+LinearCrdTransf2d::isReentrant(void) const
+{
+    // the work storage of the state determination is per thread
+    return true;
+}
+
+
 int 
 LinearCrdTransf2d::initialize(Node *nodeIPointer, Node *nodeJPointer)
 {       
@@ -305,11 +325,12 @@ LinearCrdTransf2d::getDeformedLength(void)
 const Vector &
 LinearCrdTransf2d::getBasicTrialDisp(void)
 {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // determine global displacements
     const Vector &disp1 = nodeIPtr->getTrialDisp();
     const Vector &disp2 = nodeJPtr->getTrialDisp();
     
-    static double ug[6];
+    double ug[6];
     for (int i = 0; i < 3; i++) {
         ug[i]   = disp1(i);
         ug[i+3] = disp2(i);
@@ -325,7 +346,7 @@ LinearCrdTransf2d::getBasicTrialDisp(void)
             ug[j+3] -= nodeJInitialDisp[j];
     }
     
-    static Vector ub(3);
+    Vector &ub = theWork.ub;
     
     double oneOverL = 1.0/L;
     double sl = sinTheta*oneOverL;
@@ -360,17 +381,18 @@ LinearCrdTransf2d::getBasicTrialDisp(void)
 const Vector &
 LinearCrdTransf2d::getBasicIncrDisp(void)
 {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // determine global displacements
     const Vector &disp1 = nodeIPtr->getIncrDisp();
     const Vector &disp2 = nodeJPtr->getIncrDisp();
     
-    static double dug[6];
+    double dug[6];
     for (int i = 0; i < 3; i++) {
         dug[i]   = disp1(i);
         dug[i+3] = disp2(i);
     }
     
-    static Vector dub(3);
+    Vector &dub = theWork.dub;
     
     double oneOverL = 1.0/L;
     double sl = sinTheta*oneOverL;
@@ -405,17 +427,18 @@ LinearCrdTransf2d::getBasicIncrDisp(void)
 const Vector &
 LinearCrdTransf2d::getBasicIncrDeltaDisp(void)
 {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // determine global displacements
     const Vector &disp1 = nodeIPtr->getIncrDeltaDisp();
     const Vector &disp2 = nodeJPtr->getIncrDeltaDisp();
     
-    static double Dug[6];
+    double Dug[6];
     for (int i = 0; i < 3; i++) {
         Dug[i]   = disp1(i);
         Dug[i+3] = disp2(i);
     }
     
-    static Vector Dub(3);
+    Vector &Dub = theWork.Dub;
     
     double oneOverL = 1.0/L;
     double sl = sinTheta*oneOverL;
@@ -450,17 +473,18 @@ LinearCrdTransf2d::getBasicIncrDeltaDisp(void)
 const Vector &
 LinearCrdTransf2d::getBasicTrialVel(void)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// determine global velocities
 	const Vector &vel1 = nodeIPtr->getTrialVel();
 	const Vector &vel2 = nodeJPtr->getTrialVel();
 	
-	static double vg[6];
+	double vg[6];
 	for (int i = 0; i < 3; i++) {
 		vg[i]   = vel1(i);
 		vg[i+3] = vel2(i);
 	}
 	
-	static Vector vb(3);
+	Vector &vb = theWork.vb;
 	
 	double oneOverL = 1.0/L;
 	double sl = sinTheta*oneOverL;
@@ -495,17 +519,18 @@ LinearCrdTransf2d::getBasicTrialVel(void)
 const Vector &
 LinearCrdTransf2d::getBasicTrialAccel(void)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// determine global accelerations
 	const Vector &accel1 = nodeIPtr->getTrialAccel();
 	const Vector &accel2 = nodeJPtr->getTrialAccel();
 	
-	static double ag[6];
+	double ag[6];
 	for (int i = 0; i < 3; i++) {
 		ag[i]   = accel1(i);
 		ag[i+3] = accel2(i);
 	}
 	
-	static Vector ab(3);
+	Vector &ab = theWork.ab;
 	
 	double oneOverL = 1.0/L;
 	double sl = sinTheta*oneOverL;
@@ -540,8 +565,9 @@ LinearCrdTransf2d::getBasicTrialAccel(void)
 const Vector &
 LinearCrdTransf2d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
 {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // transform resisting forces from the basic system to local coordinates
-    static double pl[6];
+    double pl[6];
     
     double q0 = pb(0);
     double q1 = pb(1);
@@ -563,7 +589,7 @@ LinearCrdTransf2d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
     pl[4] += p0(2);
     
     // transform resisting forces  from local to global coordinates
-    static Vector pg(6);
+    Vector &pg = theWork.pg;
     
     pg(0) = cosTheta*pl[0] - sinTheta*pl[1];
     pg(1) = sinTheta*pl[0] + cosTheta*pl[1];
@@ -676,7 +702,8 @@ LinearCrdTransf2d::getGlobalResistingForceShapeSensitivity(const Vector &pb, con
 const Matrix &
 LinearCrdTransf2d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
 {
-    static double tmp [6][6];
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+    double tmp [6][6];
     double oneOverL = 1.0/L;
     double kb00, kb01, kb02, kb10, kb11, kb12, kb20, kb21, kb22;
     
@@ -728,76 +755,77 @@ LinearCrdTransf2d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     tmp[2][4] = -tmp[2][1];
     tmp[2][5] = (nodeJOffset) ? t05*kb20 + t15*kb21 + t25*kb22 : kb22;
     
-    kg(0,0) = -cosTheta*tmp[0][0] - sl*(tmp[1][0]+tmp[2][0]);
-    kg(0,1) = -cosTheta*tmp[0][1] - sl*(tmp[1][1]+tmp[2][1]);
-    kg(0,2) = -cosTheta*tmp[0][2] - sl*(tmp[1][2]+tmp[2][2]);
-    kg(0,3) = -cosTheta*tmp[0][3] - sl*(tmp[1][3]+tmp[2][3]);
-    kg(0,4) = -cosTheta*tmp[0][4] - sl*(tmp[1][4]+tmp[2][4]);
-    kg(0,5) = -cosTheta*tmp[0][5] - sl*(tmp[1][5]+tmp[2][5]);
+    theWork.kg(0,0) = -cosTheta*tmp[0][0] - sl*(tmp[1][0]+tmp[2][0]);
+    theWork.kg(0,1) = -cosTheta*tmp[0][1] - sl*(tmp[1][1]+tmp[2][1]);
+    theWork.kg(0,2) = -cosTheta*tmp[0][2] - sl*(tmp[1][2]+tmp[2][2]);
+    theWork.kg(0,3) = -cosTheta*tmp[0][3] - sl*(tmp[1][3]+tmp[2][3]);
+    theWork.kg(0,4) = -cosTheta*tmp[0][4] - sl*(tmp[1][4]+tmp[2][4]);
+    theWork.kg(0,5) = -cosTheta*tmp[0][5] - sl*(tmp[1][5]+tmp[2][5]);
     
-    kg(1,0) = -sinTheta*tmp[0][0] + cl*(tmp[1][0]+tmp[2][0]);
-    kg(1,1) = -sinTheta*tmp[0][1] + cl*(tmp[1][1]+tmp[2][1]);
-    kg(1,2) = -sinTheta*tmp[0][2] + cl*(tmp[1][2]+tmp[2][2]);
-    kg(1,3) = -sinTheta*tmp[0][3] + cl*(tmp[1][3]+tmp[2][3]);
-    kg(1,4) = -sinTheta*tmp[0][4] + cl*(tmp[1][4]+tmp[2][4]);
-    kg(1,5) = -sinTheta*tmp[0][5] + cl*(tmp[1][5]+tmp[2][5]);
+    theWork.kg(1,0) = -sinTheta*tmp[0][0] + cl*(tmp[1][0]+tmp[2][0]);
+    theWork.kg(1,1) = -sinTheta*tmp[0][1] + cl*(tmp[1][1]+tmp[2][1]);
+    theWork.kg(1,2) = -sinTheta*tmp[0][2] + cl*(tmp[1][2]+tmp[2][2]);
+    theWork.kg(1,3) = -sinTheta*tmp[0][3] + cl*(tmp[1][3]+tmp[2][3]);
+    theWork.kg(1,4) = -sinTheta*tmp[0][4] + cl*(tmp[1][4]+tmp[2][4]);
+    theWork.kg(1,5) = -sinTheta*tmp[0][5] + cl*(tmp[1][5]+tmp[2][5]);
     
     if (nodeIOffset) {
-        kg(2,0) =  t02*tmp[0][0] + t12*tmp[1][0] + t22*tmp[2][0];
-        kg(2,1) =  t02*tmp[0][1] + t12*tmp[1][1] + t22*tmp[2][1];
-        kg(2,2) =  t02*tmp[0][2] + t12*tmp[1][2] + t22*tmp[2][2];
-        kg(2,3) =  t02*tmp[0][3] + t12*tmp[1][3] + t22*tmp[2][3];
-        kg(2,4) =  t02*tmp[0][4] + t12*tmp[1][4] + t22*tmp[2][4];
-        kg(2,5) =  t02*tmp[0][5] + t12*tmp[1][5] + t22*tmp[2][5];
+        theWork.kg(2,0) =  t02*tmp[0][0] + t12*tmp[1][0] + t22*tmp[2][0];
+        theWork.kg(2,1) =  t02*tmp[0][1] + t12*tmp[1][1] + t22*tmp[2][1];
+        theWork.kg(2,2) =  t02*tmp[0][2] + t12*tmp[1][2] + t22*tmp[2][2];
+        theWork.kg(2,3) =  t02*tmp[0][3] + t12*tmp[1][3] + t22*tmp[2][3];
+        theWork.kg(2,4) =  t02*tmp[0][4] + t12*tmp[1][4] + t22*tmp[2][4];
+        theWork.kg(2,5) =  t02*tmp[0][5] + t12*tmp[1][5] + t22*tmp[2][5];
     }
     else {
-        kg(2,0) = tmp[1][0];
-        kg(2,1) = tmp[1][1];
-        kg(2,2) = tmp[1][2];
-        kg(2,3) = tmp[1][3];
-        kg(2,4) = tmp[1][4];
-        kg(2,5) = tmp[1][5];
-    }
-    
-    kg(3,0) = -kg(0,0);
-    kg(3,1) = -kg(0,1);
-    kg(3,2) = -kg(0,2);
-    kg(3,3) = -kg(0,3);
-    kg(3,4) = -kg(0,4);
-    kg(3,5) = -kg(0,5);
-    
-    kg(4,0) = -kg(1,0);
-    kg(4,1) = -kg(1,1);
-    kg(4,2) = -kg(1,2);
-    kg(4,3) = -kg(1,3);
-    kg(4,4) = -kg(1,4);
-    kg(4,5) = -kg(1,5);
+        theWork.kg(2,0) = tmp[1][0];
+        theWork.kg(2,1) = tmp[1][1];
+        theWork.kg(2,2) = tmp[1][2];
+        theWork.kg(2,3) = tmp[1][3];
+        theWork.kg(2,4) = tmp[1][4];
+        theWork.kg(2,5) = tmp[1][5];
+    }
+    
+    theWork.kg(3,0) = -theWork.kg(0,0);
+    theWork.kg(3,1) = -theWork.kg(0,1);
+    theWork.kg(3,2) = -theWork.kg(0,2);
+    theWork.kg(3,3) = -theWork.kg(0,3);
+    theWork.kg(3,4) = -theWork.kg(0,4);
+    theWork.kg(3,5) = -theWork.kg(0,5);
+    
+    theWork.kg(4,0) = -theWork.kg(1,0);
+    theWork.kg(4,1) = -theWork.kg(1,1);
+    theWork.kg(4,2) = -theWork.kg(1,2);
+    theWork.kg(4,3) = -theWork.kg(1,3);
+    theWork.kg(4,4) = -theWork.kg(1,4);
+    theWork.kg(4,5) = -theWork.kg(1,5);
     
     if (nodeJOffset) {
-        kg(5,0) =  t05*tmp[0][0] + t15*tmp[1][0] + t25*tmp[2][0];
-        kg(5,1) =  t05*tmp[0][1] + t15*tmp[1][1] + t25*tmp[2][1];
-        kg(5,2) =  t05*tmp[0][2] + t15*tmp[1][2] + t25*tmp[2][2];
-        kg(5,3) =  t05*tmp[0][3] + t15*tmp[1][3] + t25*tmp[2][3];
-        kg(5,4) =  t05*tmp[0][4] + t15*tmp[1][4] + t25*tmp[2][4];
-        kg(5,5) =  t05*tmp[0][5] + t15*tmp[1][5] + t25*tmp[2][5];
+        theWork.kg(5,0) =  t05*tmp[0][0] + t15*tmp[1][0] + t25*tmp[2][0];
+        theWork.kg(5,1) =  t05*tmp[0][1] + t15*tmp[1][1] + t25*tmp[2][1];
+        theWork.kg(5,2) =  t05*tmp[0][2] + t15*tmp[1][2] + t25*tmp[2][2];
+        theWork.kg(5,3) =  t05*tmp[0][3] + t15*tmp[1][3] + t25*tmp[2][3];
+        theWork.kg(5,4) =  t05*tmp[0][4] + t15*tmp[1][4] + t25*tmp[2][4];
+        theWork.kg(5,5) =  t05*tmp[0][5] + t15*tmp[1][5] + t25*tmp[2][5];
     }
     else {
-        kg(5,0) =  tmp[2][0];
-        kg(5,1) =  tmp[2][1];
-        kg(5,2) =  tmp[2][2];
-        kg(5,3) =  tmp[2][3];
-        kg(5,4) =  tmp[2][4];
-        kg(5,5) =  tmp[2][5];
+        theWork.kg(5,0) =  tmp[2][0];
+        theWork.kg(5,1) =  tmp[2][1];
+        theWork.kg(5,2) =  tmp[2][2];
+        theWork.kg(5,3) =  tmp[2][3];
+        theWork.kg(5,4) =  tmp[2][4];
+        theWork.kg(5,5) =  tmp[2][5];
     }
     
-    return kg;
+    return theWork.kg;
 }
 
 
 const Matrix &
 LinearCrdTransf2d::getInitialGlobalStiffMatrix(const Matrix &kb)
 {
-    static double tmp [6][6];
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+    double tmp [6][6];
     double oneOverL = 1.0/L;
     double kb00, kb01, kb02, kb10, kb11, kb12, kb20, kb21, kb22;
     
@@ -849,69 +877,69 @@ LinearCrdTransf2d::getInitialGlobalStiffMatrix(const Matrix &kb)
     tmp[2][4] = -tmp[2][1];
     tmp[2][5] = (nodeJOffset) ? t05*kb20 + t15*kb21 + t25*kb22 : kb22;
     
-    kg(0,0) = -cosTheta*tmp[0][0] - sl*(tmp[1][0]+tmp[2][0]);
-    kg(0,1) = -cosTheta*tmp[0][1] - sl*(tmp[1][1]+tmp[2][1]);
-    kg(0,2) = -cosTheta*tmp[0][2] - sl*(tmp[1][2]+tmp[2][2]);
-    kg(0,3) = -cosTheta*tmp[0][3] - sl*(tmp[1][3]+tmp[2][3]);
-    kg(0,4) = -cosTheta*tmp[0][4] - sl*(tmp[1][4]+tmp[2][4]);
-    kg(0,5) = -cosTheta*tmp[0][5] - sl*(tmp[1][5]+tmp[2][5]);
+    theWork.kg(0,0) = -cosTheta*tmp[0][0] - sl*(tmp[1][0]+tmp[2][0]);
+    theWork.kg(0,1) = -cosTheta*tmp[0][1] - sl*(tmp[1][1]+tmp[2][1]);
+    theWork.kg(0,2) = -cosTheta*tmp[0][2] - sl*(tmp[1][2]+tmp[2][2]);
+    theWork.kg(0,3) = -cosTheta*tmp[0][3] - sl*(tmp[1][3]+tmp[2][3]);
+    theWork.kg(0,4) = -cosTheta*tmp[0][4] - sl*(tmp[1][4]+tmp[2][4]);
+    theWork.kg(0,5) = -cosTheta*tmp[0][5] - sl*(tmp[1][5]+tmp[2][5]);
     
-    kg(1,0) = -sinTheta*tmp[0][0] + cl*(tmp[1][0]+tmp[2][0]);
-    kg(1,1) = -sinTheta*tmp[0][1] + cl*(tmp[1][1]+tmp[2][1]);
-    kg(1,2) = -sinTheta*tmp[0][2] + cl*(tmp[1][2]+tmp[2][2]);
-    kg(1,3) = -sinTheta*tmp[0][3] + cl*(tmp[1][3]+tmp[2][3]);
-    kg(1,4) = -sinTheta*tmp[0][4] + cl*(tmp[1][4]+tmp[2][4]);
-    kg(1,5) = -sinTheta*tmp[0][5] + cl*(tmp[1][5]+tmp[2][5]);
+    theWork.kg(1,0) = -sinTheta*tmp[0][0] + cl*(tmp[1][0]+tmp[2][0]);
+    theWork.kg(1,1) = -sinTheta*tmp[0][1] + cl*(tmp[1][1]+tmp[2][1]);
+    theWork.kg(1,2) = -sinTheta*tmp[0][2] + cl*(tmp[1][2]+tmp[2][2]);
+    theWork.kg(1,3) = -sinTheta*tmp[0][3] + cl*(tmp[1][3]+tmp[2][3]);
+    theWork.kg(1,4) = -sinTheta*tmp[0][4] + cl*(tmp[1][4]+tmp[2][4]);
+    theWork.kg(1,5) = -sinTheta*tmp[0][5] + cl*(tmp[1][5]+tmp[2][5]);
     
     if (nodeIOffset) {
-        kg(2,0) =  t02*tmp[0][0] + t12*tmp[1][0] + t22*tmp[2][0];
-        kg(2,1) =  t02*tmp[0][1] + t12*tmp[1][1] + t22*tmp[2][1];
-        kg(2,2) =  t02*tmp[0][2] + t12*tmp[1][2] + t22*tmp[2][2];
-        kg(2,3) =  t02*tmp[0][3] + t12*tmp[1][3] + t22*tmp[2][3];
-        kg(2,4) =  t02*tmp[0][4] + t12*tmp[1][4] + t22*tmp[2][4];
-        kg(2,5) =  t02*tmp[0][5] + t12*tmp[1][5] + t22*tmp[2][5];
+        theWork.kg(2,0) =  t02*tmp[0][0] + t12*tmp[1][0] + t22*tmp[2][0];
+        theWork.kg(2,1) =  t02*tmp[0][1] + t12*tmp[1][1] + t22*tmp[2][1];
+        theWork.kg(2,2) =  t02*tmp[0][2] + t12*tmp[1][2] + t22*tmp[2][2];
+        theWork.kg(2,3) =  t02*tmp[0][3] + t12*tmp[1][3] + t22*tmp[2][3];
+        theWork.kg(2,4) =  t02*tmp[0][4] + t12*tmp[1][4] + t22*tmp[2][4];
+        theWork.kg(2,5) =  t02*tmp[0][5] + t12*tmp[1][5] + t22*tmp[2][5];
     }
     else {
-        kg(2,0) = tmp[1][0];
-        kg(2,1) = tmp[1][1];
-        kg(2,2) = tmp[1][2];
-        kg(2,3) = tmp[1][3];
-        kg(2,4) = tmp[1][4];
-        kg(2,5) = tmp[1][5];
-    }
-    
-    kg(3,0) = -kg(0,0);
-    kg(3,1) = -kg(0,1);
-    kg(3,2) = -kg(0,2);
-    kg(3,3) = -kg(0,3);
-    kg(3,4) = -kg(0,4);
-    kg(3,5) = -kg(0,5);
-    
-    kg(4,0) = -kg(1,0);
-    kg(4,1) = -kg(1,1);
-    kg(4,2) = -kg(1,2);
-    kg(4,3) = -kg(1,3);
-    kg(4,4) = -kg(1,4);
-    kg(4,5) = -kg(1,5);
+        theWork.kg(2,0) = tmp[1][0];
+        theWork.kg(2,1) = tmp[1][1];
+        theWork.kg(2,2) = tmp[1][2];
+        theWork.kg(2,3) = tmp[1][3];
+        theWork.kg(2,4) = tmp[1][4];
+        theWork.kg(2,5) = tmp[1][5];
+    }
+    
+    theWork.kg(3,0) = -theWork.kg(0,0);
+    theWork.kg(3,1) = -theWork.kg(0,1);
+    theWork.kg(3,2) = -theWork.kg(0,2);
+    theWork.kg(3,3) = -theWork.kg(0,3);
+    theWork.kg(3,4) = -theWork.kg(0,4);
+    theWork.kg(3,5) = -theWork.kg(0,5);
+    
+    theWork.kg(4,0) = -theWork.kg(1,0);
+    theWork.kg(4,1) = -theWork.kg(1,1);
+    theWork.kg(4,2) = -theWork.kg(1,2);
+    theWork.kg(4,3) = -theWork.kg(1,3);
+    theWork.kg(4,4) = -theWork.kg(1,4);
+    theWork.kg(4,5) = -theWork.kg(1,5);
     
     if (nodeJOffset) {
-        kg(5,0) =  t05*tmp[0][0] + t15*tmp[1][0] + t25*tmp[2][0];
-        kg(5,1) =  t05*tmp[0][1] + t15*tmp[1][1] + t25*tmp[2][1];
-        kg(5,2) =  t05*tmp[0][2] + t15*tmp[1][2] + t25*tmp[2][2];
-        kg(5,3) =  t05*tmp[0][3] + t15*tmp[1][3] + t25*tmp[2][3];
-        kg(5,4) =  t05*tmp[0][4] + t15*tmp[1][4] + t25*tmp[2][4];
-        kg(5,5) =  t05*tmp[0][5] + t15*tmp[1][5] + t25*tmp[2][5];
+        theWork.kg(5,0) =  t05*tmp[0][0] + t15*tmp[1][0] + t25*tmp[2][0];
+        theWork.kg(5,1) =  t05*tmp[0][1] + t15*tmp[1][1] + t25*tmp[2][1];
+        theWork.kg(5,2) =  t05*tmp[0][2] + t15*tmp[1][2] + t25*tmp[2][2];
+        theWork.kg(5,3) =  t05*tmp[0][3] + t15*tmp[1][3] + t25*tmp[2][3];
+        theWork.kg(5,4) =  t05*tmp[0][4] + t15*tmp[1][4] + t25*tmp[2][4];
+        theWork.kg(5,5) =  t05*tmp[0][5] + t15*tmp[1][5] + t25*tmp[2][5];
     }
     else {
-        kg(5,0) =  tmp[2][0];
-        kg(5,1) =  tmp[2][1];
-        kg(5,2) =  tmp[2][2];
-        kg(5,3) =  tmp[2][3];
-        kg(5,4) =  tmp[2][4];
-        kg(5,5) =  tmp[2][5];
+        theWork.kg(5,0) =  tmp[2][0];
+        theWork.kg(5,1) =  tmp[2][1];
+        theWork.kg(5,2) =  tmp[2][2];
+        theWork.kg(5,3) =  tmp[2][3];
+        theWork.kg(5,4) =  tmp[2][4];
+        theWork.kg(5,5) =  tmp[2][5];
     }
     
-    return kg;
+    return theWork.kg;
 }
 
 
@@ -1075,10 +1103,11 @@ LinearCrdTransf2d::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &the
 const Matrix &
 LinearCrdTransf2d::getGlobalMatrixFromLocal(const Matrix &ml)
 {
-    this->compTransfMatrixLocalGlobal(Tlg);  // OPTIMIZE LATER
-    kg.addMatrixTripleProduct(0.0, Tlg, ml, 1.0);  // OPTIMIZE LATER
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+    this->compTransfMatrixLocalGlobal(theWork.Tlg);  // OPTIMIZE LATER
+    theWork.kg.addMatrixTripleProduct(0.0, theWork.Tlg, ml, 1.0);  // OPTIMIZE LATER
 
-    return kg;
+    return theWork.kg;
 }
 
 
@@ -62,6 +62,7 @@ public:
     int commitState(void);
     int revertToLastCommit(void);        
     int revertToStart(void);
+    bool isReentrant(void) const;
     
     const Vector &getBasicTrialDisp(void);
     const Vector &getBasicIncrDisp(void);
@@ -122,8 +123,9 @@ private:
     double cosTheta, sinTheta;  // direction cosines of undeformed element wrt to global system 
     double L;  // undeformed element length
 
-    static Matrix Tlg;  // matrix that transforms from global to local coordinates
-    static Matrix kg;   // global stiffness matrix
+    // work storage shared by all transformations of this class; every
+    // thread obtains its own Workspace from its ScratchArena
+    struct Workspace;
 
     double *nodeIInitialDisp, *nodeJInitialDisp;
     bool initialDispChecked;
@@ -61,6 +61,7 @@ public:
     int commitState(void);
     int revertToLastCommit(void);        
     int revertToStart(void);
+    bool isReentrant(void) const;
     
     const Vector &getBasicTrialDisp(void);
     const Vector &getBasicIncrDisp(void);
@@ -105,8 +106,9 @@ private:
     double R[3][3];	 // rotation matrix
     double L;        // undeformed element length
 
-    static Matrix Tlg;  // matrix that transforms from global to local coordinates
-    static Matrix kg;   // global stiffness matrix
+    // work storage shared by all transformations of this class; every
+    // thread obtains its own Workspace from its ScratchArena
+    struct Workspace;
 
     double *nodeIInitialDisp, *nodeJInitialDisp;
     bool initialDispChecked;
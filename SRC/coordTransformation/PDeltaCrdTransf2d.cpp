@@ -41,11 +41,23 @@
 #include <Channel.h>
 #include <elementAPI.h>
 #include <string>
+#include <ScratchArena.h>
 #include <PDeltaCrdTransf2d.h>
 
-// initialize static variables
-Matrix PDeltaCrdTransf2d::Tlg(6,6);
-Matrix PDeltaCrdTransf2d::kg(6,6);
+// work storage of PDeltaCrdTransf2d; each thread obtains its own copy from its
+// ScratchArena so that transformations can be used concurrently
+struct PDeltaCrdTransf2d::Workspace {
+    Matrix Tlg;  // matrix that transforms from global to local coordinates
+    Matrix kg;   // global stiffness matrix
+    Vector ub, dub, Dub, vb, ab, pg;
+
+    Workspace()
+      :Tlg(6,6), kg(6,6),
+       ub(3), dub(3), Dub(3), vb(3), ab(3), pg(6)
+    {}
+};
+
+static const int workSlot = ScratchArena::newSlot();
 
 void* OPS_PDeltaCrdTransf2d()
 {
@@ -169,6 +181,15 @@ PDeltaCrdTransf2d::revertToStart(void)
 }
 
 
+bool
+PDeltaCrdTransf2d::isReentrant(void) const
+{
+    // the work storage of the state determination is per thread and the
+    // P-Delta offset per instance
+    return true;
+}
+
+
 int 
 PDeltaCrdTransf2d::initialize(Node *nodeIPointer, Node *nodeJPointer)
 {       
@@ -219,35 +240,38 @@ PDeltaCrdTransf2d::initialize(Node *nodeIPointer, Node *nodeJPointer)
 int
 PDeltaCrdTransf2d::update(void)
 {
-    static Vector nodeIDisp(3);
-    static Vector nodeJDisp(3);
-    nodeIDisp = nodeIPtr->getTrialDisp();
-    nodeJDisp = nodeJPtr->getTrialDisp();
+    const Vector &dispI = nodeIPtr->getTrialDisp();
+    const Vector &dispJ = nodeJPtr->getTrialDisp();
+    double nodeIDisp[3], nodeJDisp[3];
+    for (int j=0; j<3; j++) {
+        nodeIDisp[j] = dispI(j);
+        nodeJDisp[j] = dispJ(j);
+    }
     
     if (nodeIInitialDisp != 0) {
         for (int j=0; j<3; j++)
-            nodeIDisp(j) -= nodeIInitialDisp[j];
+            nodeIDisp[j] -= nodeIInitialDisp[j];
     }
     
     if (nodeJInitialDisp != 0) {
         for (int j=0; j<3; j++)
-            nodeJDisp(j) -= nodeJInitialDisp[j];
+            nodeJDisp[j] -= nodeJInitialDisp[j];
     }
     
     double ul1;
     double ul4;
     
-    ul1 = -sinTheta*nodeIDisp(0) + cosTheta*nodeIDisp(1);
-    ul4 = -sinTheta*nodeJDisp(0) + cosTheta*nodeJDisp(1);
+    ul1 = -sinTheta*nodeIDisp[0] + cosTheta*nodeIDisp[1];
+    ul4 = -sinTheta*nodeJDisp[0] + cosTheta*nodeJDisp[1];
     
     if (nodeIOffset != 0) {
         double t12 = sinTheta*nodeIOffset[1] + cosTheta*nodeIOffset[0];
-        ul1 += t12*nodeIDisp(2);
+        ul1 += t12*nodeIDisp[2];
     }
     
     if (nodeJOffset != 0) {
         double t45 = sinTheta*nodeJOffset[1] + cosTheta*nodeJOffset[0];
-        ul4 += t45*nodeJDisp(2);
+        ul4 += t45*nodeJDisp[2];
     }
     
     ul14 = ul1-ul4;
@@ -337,11 +361,12 @@ PDeltaCrdTransf2d::getDeformedLength(void)
 const Vector &
 PDeltaCrdTransf2d::getBasicTrialDisp(void)
 {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // determine global displacements
     const Vector &disp1 = nodeIPtr->getTrialDisp();
     const Vector &disp2 = nodeJPtr->getTrialDisp();
     
-    static double ug[6];
+    double ug[6];
     for (int i = 0; i < 3; i++) {
         ug[i]   = disp1(i);
         ug[i+3] = disp2(i);
@@ -357,7 +382,7 @@ PDeltaCrdTransf2d::getBasicTrialDisp(void)
             ug[j+3] -= nodeJInitialDisp[j];
     }
     
-    static Vector ub(3);
+    Vector &ub = theWork.ub;
     
     double oneOverL = 1.0/L;
     double sl = sinTheta*oneOverL;
@@ -392,17 +417,18 @@ PDeltaCrdTransf2d::getBasicTrialDisp(void)
 const Vector &
 PDeltaCrdTransf2d::getBasicIncrDisp(void)
 {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // determine global displacements
     const Vector &disp1 = nodeIPtr->getIncrDisp();
     const Vector &disp2 = nodeJPtr->getIncrDisp();
     
-    static double dug[6];
+    double dug[6];
     for (int i = 0; i < 3; i++) {
         dug[i]   = disp1(i);
         dug[i+3] = disp2(i);
     }
     
-    static Vector dub(3);
+    Vector &dub = theWork.dub;
     
     double oneOverL = 1.0/L;
     double sl = sinTheta*oneOverL;
@@ -437,17 +463,18 @@ PDeltaCrdTransf2d::getBasicIncrDisp(void)
 const Vector &
 PDeltaCrdTransf2d::getBasicIncrDeltaDisp(void)
 {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // determine global displacements
     const Vector &disp1 = nodeIPtr->getIncrDeltaDisp();
     const Vector &disp2 = nodeJPtr->getIncrDeltaDisp();
     
-    static double Dug[6];
+    double Dug[6];
     for (int i = 0; i < 3; i++) {
         Dug[i]   = disp1(i);
         Dug[i+3] = disp2(i);
     }
     
-    static Vector Dub(3);
+    Vector &Dub = theWork.Dub;
     
     double oneOverL = 1.0/L;
     double sl = sinTheta*oneOverL;
@@ -482,17 +509,18 @@ PDeltaCrdTransf2d::getBasicIncrDeltaDisp(void)
 const Vector &
 PDeltaCrdTransf2d::getBasicTrialVel(void)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// determine global velocities
 	const Vector &vel1 = nodeIPtr->getTrialVel();
 	const Vector &vel2 = nodeJPtr->getTrialVel();
 	
-	static double vg[6];
+	double vg[6];
 	for (int i = 0; i < 3; i++) {
 		vg[i]   = vel1(i);
 		vg[i+3] = vel2(i);
 	}
 	
-	static Vector vb(3);
+	Vector &vb = theWork.vb;
 	
 	double oneOverL = 1.0/L;
 	double sl = sinTheta*oneOverL;
@@ -527,17 +555,18 @@ PDeltaCrdTransf2d::getBasicTrialVel(void)
 const Vector &
 PDeltaCrdTransf2d::getBasicTrialAccel(void)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// determine global accelerations
 	const Vector &accel1 = nodeIPtr->getTrialAccel();
 	const Vector &accel2 = nodeJPtr->getTrialAccel();
 	
-	static double ag[6];
+	double ag[6];
 	for (int i = 0; i < 3; i++) {
 		ag[i]   = accel1(i);
 		ag[i+3] = accel2(i);
 	}
 	
-	static Vector ab(3);
+	Vector &ab = theWork.ab;
 	
 	double oneOverL = 1.0/L;
 	double sl = sinTheta*oneOverL;
@@ -572,8 +601,9 @@ PDeltaCrdTransf2d::getBasicTrialAccel(void)
 const Vector &
 PDeltaCrdTransf2d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
 {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // transform resisting forces from the basic system to local coordinates
-    static double pl[6];
+    double pl[6];
     
     double q0 = pb(0);
     double q1 = pb(1);
@@ -600,7 +630,7 @@ PDeltaCrdTransf2d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
     pl[4] -= NoverL;
     
     // transform resisting forces  from local to global coordinates
-    static Vector pg(6);
+    Vector &pg = theWork.pg;
     
     pg(0) = cosTheta*pl[0] - sinTheta*pl[1];
     pg(1) = sinTheta*pl[0] + cosTheta*pl[1];
@@ -632,8 +662,10 @@ PDeltaCrdTransf2d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
 const Matrix &
 PDeltaCrdTransf2d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
 {
-    static double kl[6][6];
-    static double tmp[6][6];
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+    Matrix &kg = theWork.kg;
+    double kl[6][6];
+    double tmp[6][6];
     double oneOverL = 1.0/L;
     
     // Basic stiffness
@@ -840,7 +872,9 @@ PDeltaCrdTransf2d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
 const Matrix &
 PDeltaCrdTransf2d::getInitialGlobalStiffMatrix(const Matrix &kb)
 {
-    static double tmp [6][6];
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+    Matrix &kg = theWork.kg;
+    double tmp [6][6];
     double oneOverL = 1.0/L;
     double kb00, kb01, kb02, kb10, kb11, kb12, kb20, kb21, kb22;
     
@@ -1121,10 +1155,11 @@ PDeltaCrdTransf2d::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &the
 const Matrix &
 PDeltaCrdTransf2d::getGlobalMatrixFromLocal(const Matrix &ml)
 {
-    this->compTransfMatrixLocalGlobal(Tlg);  // OPTIMIZE LATER
-    kg.addMatrixTripleProduct(0.0, Tlg, ml, 1.0);  // OPTIMIZE LATER
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+    this->compTransfMatrixLocalGlobal(theWork.Tlg);  // OPTIMIZE LATER
+    theWork.kg.addMatrixTripleProduct(0.0, theWork.Tlg, ml, 1.0);  // OPTIMIZE LATER
 
-    return kg;
+    return theWork.kg;
 }
 
 
@@ -64,6 +64,7 @@ public:
     int commitState(void);
     int revertToLastCommit(void);        
     int revertToStart(void);
+    bool isReentrant(void) const;
     
     const Vector &getBasicTrialDisp(void);
     const Vector &getBasicIncrDisp(void);
@@ -106,8 +107,9 @@ private:
     double L;     // undeformed element length
     double ul14;  // Transverse local displacement offset of P-Delta
     
-    static Matrix Tlg;  // matrix that transforms from global to local coordinates
-    static Matrix kg;   // global stiffness matrix
+    // work storage shared by all transformations of this class; every
+    // thread obtains its own Workspace from its ScratchArena
+    struct Workspace;
     
     double *nodeIInitialDisp, *nodeJInitialDisp;
     bool initialDispChecked;
@@ -40,11 +40,23 @@
 #include <Channel.h>
 #include <elementAPI.h>
 #include <string>
+#include <ScratchArena.h>
 #include <PDeltaCrdTransf3d.h>
 
-// initialize static variables
-Matrix PDeltaCrdTransf3d::Tlg(12,12);
-Matrix PDeltaCrdTransf3d::kg(12,12);
+// work storage of PDeltaCrdTransf3d; each thread obtains its own copy from its
+// ScratchArena so that transformations can be used concurrently
+struct PDeltaCrdTransf3d::Workspace {
+    Matrix Tlg;  // matrix that transforms from global to local coordinates
+    Matrix kg;   // global stiffness matrix
+    Vector ubTrial, ubIncr, ubIncrDelta, vb, ab, pg;
+
+    Workspace()
+      :Tlg(12,12), kg(12,12),
+       ubTrial(6), ubIncr(6), ubIncrDelta(6), vb(6), ab(6), pg(12)
+    {}
+};
+
+static const int workSlot = ScratchArena::newSlot();
 
 void* OPS_PDeltaCrdTransf3d()
 {
@@ -193,6 +205,15 @@ PDeltaCrdTransf3d::revertToStart(void)
 }
 
 
+bool
+PDeltaCrdTransf3d::isReentrant(void) const
+{
+    // the work storage of the state determination is per thread and the
+    // P-Delta offsets per instance
+    return true;
+}
+
+
 int 
 PDeltaCrdTransf3d::initialize(Node *nodeIPointer, Node *nodeJPointer)
 {       
@@ -253,7 +274,7 @@ PDeltaCrdTransf3d::update(void)
     const Vector &disp1 = nodeIPtr->getTrialDisp();
     const Vector &disp2 = nodeJPtr->getTrialDisp();
     
-    static double ug[12];
+    double ug[12];
     for (int i = 0; i < 6; i++) {
         ug[i]   = disp1(i);
         ug[i+6] = disp2(i);
@@ -277,7 +298,7 @@ PDeltaCrdTransf3d::update(void)
     ul7 = R[1][0]*ug[6] + R[1][1]*ug[7] + R[1][2]*ug[8];
     ul8 = R[2][0]*ug[6] + R[2][1]*ug[7] + R[2][2]*ug[8];
     
-    static double Wu[3];
+    double Wu[3];
     
     if (nodeIOffset) {
         Wu[0] =  nodeIOffset[2]*ug[4] - nodeIOffset[1]*ug[5];
@@ -462,11 +483,12 @@ PDeltaCrdTransf3d::getDeformedLength(void)
 const Vector &
 PDeltaCrdTransf3d::getBasicTrialDisp(void)
 {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // determine global displacements
     const Vector &disp1 = nodeIPtr->getTrialDisp();
     const Vector &disp2 = nodeJPtr->getTrialDisp();
     
-    static double ug[12];
+    double ug[12];
     for (int i = 0; i < 6; i++) {
         ug[i]   = disp1(i);
         ug[i+6] = disp2(i);
@@ -484,9 +506,9 @@ PDeltaCrdTransf3d::getBasicTrialDisp(void)
     
     double oneOverL = 1.0/L;
     
-    static Vector ub(6);
+    Vector &ub = theWork.ubTrial;
     
-    static double ul[12];
+    double ul[12];
     
     ul[0]  = R[0][0]*ug[0] + R[0][1]*ug[1] + R[0][2]*ug[2];
     ul[1]  = R[1][0]*ug[0] + R[1][1]*ug[1] + R[1][2]*ug[2];
@@ -504,7 +526,7 @@ PDeltaCrdTransf3d::getBasicTrialDisp(void)
     ul[10] = R[1][0]*ug[9] + R[1][1]*ug[10] + R[1][2]*ug[11];
     ul[11] = R[2][0]*ug[9] + R[2][1]*ug[10] + R[2][2]*ug[11];
     
-    static double Wu[3];
+    double Wu[3];
     if (nodeIOffset) {
         Wu[0] =  nodeIOffset[2]*ug[4] - nodeIOffset[1]*ug[5];
         Wu[1] = -nodeIOffset[2]*ug[3] + nodeIOffset[0]*ug[5];
@@ -542,11 +564,12 @@ PDeltaCrdTransf3d::getBasicTrialDisp(void)
 const Vector &
 PDeltaCrdTransf3d::getBasicIncrDisp(void)
 {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // determine global displacements
     const Vector &disp1 = nodeIPtr->getIncrDisp();
     const Vector &disp2 = nodeJPtr->getIncrDisp();
     
-    static double ug[12];
+    double ug[12];
     for (int i = 0; i < 6; i++) {
         ug[i]   = disp1(i);
         ug[i+6] = disp2(i);
@@ -554,9 +577,9 @@ PDeltaCrdTransf3d::getBasicIncrDisp(void)
     
     double oneOverL = 1.0/L;
     
-    static Vector ub(6);
+    Vector &ub = theWork.ubIncr;
     
-    static double ul[12];
+    double ul[12];
     
     ul[0]  = R[0][0]*ug[0] + R[0][1]*ug[1] + R[0][2]*ug[2];
     ul[1]  = R[1][0]*ug[0] + R[1][1]*ug[1] + R[1][2]*ug[2];
@@ -574,7 +597,7 @@ PDeltaCrdTransf3d::getBasicIncrDisp(void)
     ul[10] = R[1][0]*ug[9] + R[1][1]*ug[10] + R[1][2]*ug[11];
     ul[11] = R[2][0]*ug[9] + R[2][1]*ug[10] + R[2][2]*ug[11];
     
-    static double Wu[3];
+    double Wu[3];
     if (nodeIOffset) {
         Wu[0] =  nodeIOffset[2]*ug[4] - nodeIOffset[1]*ug[5];
         Wu[1] = -nodeIOffset[2]*ug[3] + nodeIOffset[0]*ug[5];
@@ -612,11 +635,12 @@ PDeltaCrdTransf3d::getBasicIncrDisp(void)
 const Vector &
 PDeltaCrdTransf3d::getBasicIncrDeltaDisp(void)
 {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // determine global displacements
     const Vector &disp1 = nodeIPtr->getIncrDeltaDisp();
     const Vector &disp2 = nodeJPtr->getIncrDeltaDisp();
     
-    static double ug[12];
+    double ug[12];
     for (int i = 0; i < 6; i++) {
         ug[i]   = disp1(i);
         ug[i+6] = disp2(i);
@@ -624,9 +648,9 @@ PDeltaCrdTransf3d::getBasicIncrDeltaDisp(void)
     
     double oneOverL = 1.0/L;
     
-    static Vector ub(6);
+    Vector &ub = theWork.ubIncrDelta;
     
-    static double ul[12];
+    double ul[12];
     
     ul[0]  = R[0][0]*ug[0] + R[0][1]*ug[1] + R[0][2]*ug[2];
     ul[1]  = R[1][0]*ug[0] + R[1][1]*ug[1] + R[1][2]*ug[2];
@@ -644,7 +668,7 @@ PDeltaCrdTransf3d::getBasicIncrDeltaDisp(void)
     ul[10] = R[1][0]*ug[9] + R[1][1]*ug[10] + R[1][2]*ug[11];
     ul[11] = R[2][0]*ug[9] + R[2][1]*ug[10] + R[2][2]*ug[11];
     
-    static double Wu[3];
+    double Wu[3];
     if (nodeIOffset) {
         Wu[0] =  nodeIOffset[2]*ug[4] - nodeIOffset[1]*ug[5];
         Wu[1] = -nodeIOffset[2]*ug[3] + nodeIOffset[0]*ug[5];
@@ -682,11 +706,12 @@ PDeltaCrdTransf3d::getBasicIncrDeltaDisp(void)
 const Vector &
 PDeltaCrdTransf3d::getBasicTrialVel(void)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// determine global velocities
 	const Vector &vel1 = nodeIPtr->getTrialVel();
 	const Vector &vel2 = nodeJPtr->getTrialVel();
 	
-	static double vg[12];
+	double vg[12];
 	for (int i = 0; i < 6; i++) {
 		vg[i]   = vel1(i);
 		vg[i+6] = vel2(i);
@@ -694,9 +719,9 @@ PDeltaCrdTransf3d::getBasicTrialVel(void)
 	
 	double oneOverL = 1.0/L;
 	
-	static Vector vb(6);
+	Vector &vb = theWork.vb;
 	
-	static double vl[12];
+	double vl[12];
 	
 	vl[0]  = R[0][0]*vg[0] + R[0][1]*vg[1] + R[0][2]*vg[2];
 	vl[1]  = R[1][0]*vg[0] + R[1][1]*vg[1] + R[1][2]*vg[2];
@@ -714,7 +739,7 @@ PDeltaCrdTransf3d::getBasicTrialVel(void)
 	vl[10] = R[1][0]*vg[9] + R[1][1]*vg[10] + R[1][2]*vg[11];
 	vl[11] = R[2][0]*vg[9] + R[2][1]*vg[10] + R[2][2]*vg[11];
 	
-	static double Wu[3];
+	double Wu[3];
 	if (nodeIOffset) {
 		Wu[0] =  nodeIOffset[2]*vg[4] - nodeIOffset[1]*vg[5];
 		Wu[1] = -nodeIOffset[2]*vg[3] + nodeIOffset[0]*vg[5];
@@ -752,11 +777,12 @@ PDeltaCrdTransf3d::getBasicTrialVel(void)
 const Vector &
 PDeltaCrdTransf3d::getBasicTrialAccel(void)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// determine global accelerations
 	const Vector &accel1 = nodeIPtr->getTrialAccel();
 	const Vector &accel2 = nodeJPtr->getTrialAccel();
 	
-	static double ag[12];
+	double ag[12];
 	for (int i = 0; i < 6; i++) {
 		ag[i]   = accel1(i);
 		ag[i+6] = accel2(i);
@@ -764,9 +790,9 @@ PDeltaCrdTransf3d::getBasicTrialAccel(void)
 	
 	double oneOverL = 1.0/L;
 	
-	static Vector ab(6);
+	Vector &ab = theWork.ab;
 	
-	static double al[12];
+	double al[12];
 	
 	al[0]  = R[0][0]*ag[0] + R[0][1]*ag[1] + R[0][2]*ag[2];
 	al[1]  = R[1][0]*ag[0] + R[1][1]*ag[1] + R[1][2]*ag[2];
@@ -784,7 +810,7 @@ PDeltaCrdTransf3d::getBasicTrialAccel(void)
 	al[10] = R[1][0]*ag[9] + R[1][1]*ag[10] + R[1][2]*ag[11];
 	al[11] = R[2][0]*ag[9] + R[2][1]*ag[10] + R[2][2]*ag[11];
 	
-	static double Wu[3];
+	double Wu[3];
 	if (nodeIOffset) {
 		Wu[0] =  nodeIOffset[2]*ag[4] - nodeIOffset[1]*ag[5];
 		Wu[1] = -nodeIOffset[2]*ag[3] + nodeIOffset[0]*ag[5];
@@ -822,8 +848,9 @@ PDeltaCrdTransf3d::getBasicTrialAccel(void)
 const Vector &
 PDeltaCrdTransf3d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
 {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // transform resisting forces from the basic system to local coordinates
-    static double pl[12];
+    double pl[12];
     
     double q0 = pb(0);
     double q1 = pb(1);
@@ -863,7 +890,7 @@ PDeltaCrdTransf3d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
     pl[8] -= NoverL;
     
     // transform resisting forces  from local to global coordinates
-    static Vector pg(12);
+    Vector &pg = theWork.pg;
     
     pg(0)  = R[0][0]*pl[0] + R[1][0]*pl[1] + R[2][0]*pl[2];
     pg(1)  = R[0][1]*pl[0] + R[1][1]*pl[1] + R[2][1]*pl[2];
@@ -900,9 +927,11 @@ PDeltaCrdTransf3d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
 const Matrix &
 PDeltaCrdTransf3d::getGlobalStiffMatrix(const Matrix &KB, const Vector &pb)
 {
-    static double kb[6][6];		// Basic stiffness
-    static double kl[12][12];	// Local stiffness
-    static double tmp[12][12];	// Temporary storage
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+    Matrix &kg = theWork.kg;
+    double kb[6][6];		// Basic stiffness
+    double kl[12][12];	// Local stiffness
+    double tmp[12][12];	// Temporary storage
     double oneOverL = 1.0/L;
     
     int i,j;
@@ -954,7 +983,7 @@ PDeltaCrdTransf3d::getGlobalStiffMatrix(const Matrix &KB, const Vector &pb)
         kl[2][8] -= NoverL;
         kl[8][2] -= NoverL;
         
-        static double RWI[3][3];
+        double RWI[3][3];
         
         if (nodeIOffset) {
             // Compute RWI
@@ -971,7 +1000,7 @@ PDeltaCrdTransf3d::getGlobalStiffMatrix(const Matrix &KB, const Vector &pb)
             RWI[2][2] = -R[2][0]*nodeIOffset[1] + R[2][1]*nodeIOffset[0];
         }
         
-        static double RWJ[3][3];
+        double RWJ[3][3];
         
         if (nodeJOffset) {
             // Compute RWJ
@@ -1060,9 +1089,11 @@ PDeltaCrdTransf3d::getGlobalStiffMatrix(const Matrix &KB, const Vector &pb)
 const Matrix &
 PDeltaCrdTransf3d::getInitialGlobalStiffMatrix(const Matrix &KB)
 {
-    static double kb[6][6];		// Basic stiffness
-    static double kl[12][12];	// Local stiffness
-    static double tmp[12][12];	// Temporary storage
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+    Matrix &kg = theWork.kg;
+    double kb[6][6];		// Basic stiffness
+    double kl[12][12];	// Local stiffness
+    double tmp[12][12];	// Temporary storage
     double oneOverL = 1.0/L;
     
     int i,j;
@@ -1115,7 +1146,7 @@ PDeltaCrdTransf3d::getInitialGlobalStiffMatrix(const Matrix &KB)
         //kl[8][2] -= NoverL;
         
         
-        static double RWI[3][3];
+        double RWI[3][3];
         
         if (nodeIOffset) {
             // Compute RWI
@@ -1132,7 +1163,7 @@ PDeltaCrdTransf3d::getInitialGlobalStiffMatrix(const Matrix &KB)
             RWI[2][2] = -R[2][0]*nodeIOffset[1] + R[2][1]*nodeIOffset[0];
         }
         
-        static double RWJ[3][3];
+        double RWJ[3][3];
         
         if (nodeJOffset) {
             // Compute RWJ
@@ -1408,10 +1439,11 @@ PDeltaCrdTransf3d::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &the
 const Matrix &
 PDeltaCrdTransf3d::getGlobalMatrixFromLocal(const Matrix &ml)
 {
-    this->compTransfMatrixLocalGlobal(Tlg);  // OPTIMIZE LATER
-    kg.addMatrixTripleProduct(0.0, Tlg, ml, 1.0);  // OPTIMIZE LATER
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+    this->compTransfMatrixLocalGlobal(theWork.Tlg);  // OPTIMIZE LATER
+    theWork.kg.addMatrixTripleProduct(0.0, theWork.Tlg, ml, 1.0);  // OPTIMIZE LATER
 
-    return kg;
+    return theWork.kg;
 }
 
 
@@ -61,6 +61,7 @@ public:
     int commitState(void);
     int revertToLastCommit(void);        
     int revertToStart(void);
+    bool isReentrant(void) const;
     
     const Vector &getBasicTrialDisp(void);
     const Vector &getBasicIncrDisp(void);
@@ -104,8 +105,9 @@ private:
     double ul17;	// Transverse local displacement offsets of P-Delta
     double ul28;
 
-    static Matrix Tlg;  // matrix that transforms from global to local coordinates
-    static Matrix kg;   // global stiffness matrix
+    // work storage shared by all transformations of this class; every
+    // thread obtains its own Workspace from its ScratchArena
+    struct Workspace;
 
     double *nodeIInitialDisp, *nodeJInitialDisp;
     bool initialDispChecked;
@@ -0,0 +1,481 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of SnapshotDatastore.
+//
+// The file starts with a 48 byte header:
+//   char[8]  "OPSSNAP1"
+//   int32    version
+//   int32    0x01020304, to detect a file written on a machine of
+//            different byte order
+//   int32    commit tag of the snapshot
+//   int32    0
+//   int64    number of messages
+//   int64    number of bytes of data
+//   int64    0
+// followed by a table with for each message its kind, dbTag, commitTag
+// and size as int32 and the offset of its data as int64, and then the
+// data of all the messages.
+//
+#include <SnapshotDatastore.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <Message.h>
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <Integrator.h>
+
+static const char SNAPSHOT_MAGIC[8] = {'O','P','S','S','N','A','P','1'};
+static const int32_t SNAPSHOT_VERSION = 1;
+static const int32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+// the dbTags of the state of the analysis, below those handed out to the
+// domain and its components
+static const int SNAPSHOT_ANALYSIS_DBTAG = -2;
+static const int SNAPSHOT_INTEGRATOR_DBTAG = -1;
+
+struct SnapshotHeader {
+  char magic[8];
+  int32_t version;
+  int32_t byteOrder;
+  int32_t commitTag;
+  int32_t unused;
+  int64_t numEntries;
+  int64_t dataSize;
+  int64_t reserved;
+};
+
+struct SnapshotEntry {
+  int32_t kind;
+  int32_t dbTag;
+  int32_t commitTag;
+  int32_t size;
+  int64_t offset;
+};
+
+bool
+SnapshotDatastore::Key::operator<(const Key &other) const
+{
+  if (kind != other.kind)
+    return kind < other.kind;
+  if (dbTag != other.dbTag)
+    return dbTag < other.dbTag;
+  if (commitTag != other.commitTag)
+    return commitTag < other.commitTag;
+  return size < other.size;
+}
+
+SnapshotDatastore::SnapshotDatastore(Domain &theDomain, FEM_ObjectBroker &theBroker)
+  :FE_Datastore(theDomain, theBroker), commitTag(0)
+{
+
+}
+
+SnapshotDatastore::~SnapshotDatastore()
+{
+
+}
+
+int
+SnapshotDatastore::getCommitTag(void) const
+{
+  return commitTag;
+}
+
+void
+SnapshotDatastore::clear(void)
+{
+  theEntries.clear();
+  theData.clear();
+}
+
+void
+SnapshotDatastore::remove(int cTag)
+{
+  // the data of the messages kept is moved together
+  std::vector<char> newData;
+  newData.reserve(theData.size());
+  std::map<Key, size_t>::iterator theEntry = theEntries.begin();
+  while (theEntry != theEntries.end()) {
+    if (theEntry->first.commitTag == cTag) {
+      theEntries.erase(theEntry++);
+      continue;
+    }
+    size_t numBytes = getNumBytes(theEntry->first.kind, theEntry->first.size);
+    size_t offset = (newData.size() + 7) & ~(size_t)7;
+    newData.resize(offset + numBytes);
+    memcpy(&newData[0] + offset, &theData[0] + theEntry->second, numBytes);
+    theEntry->second = offset;
+    theEntry++;
+  }
+  theData.swap(newData);
+}
+
+int
+SnapshotDatastore::commitState(int cTag)
+{
+  commitTag = cTag;
+  return this->FE_Datastore::commitState(cTag);
+}
+
+int
+SnapshotDatastore::commitAnalysis(Integrator &theIntegrator)
+{
+  ID analysisData(1);
+  analysisData(0) = theIntegrator.getClassTag();
+  if (this->sendID(SNAPSHOT_ANALYSIS_DBTAG, commitTag, analysisData) < 0)
+    return -1;
+
+  // the integrator sends its state with its own dbTag
+  int dbTag = theIntegrator.getDbTag();
+  theIntegrator.setDbTag(SNAPSHOT_INTEGRATOR_DBTAG);
+  int result = theIntegrator.sendSelf(commitTag, *this);
+  theIntegrator.setDbTag(dbTag);
+
+  if (result < 0) {
+    opserr << "SnapshotDatastore::commitAnalysis() - the integrator failed to send its state\n";
+    return -1;
+  }
+  return 0;
+}
+
+int
+SnapshotDatastore::restoreAnalysis(Integrator &theIntegrator)
+{
+  if (this->find(IntData, SNAPSHOT_ANALYSIS_DBTAG, commitTag, 1) == 0)
+    return 1;
+
+  ID analysisData(1);
+  if (this->recvID(SNAPSHOT_ANALYSIS_DBTAG, commitTag, analysisData) < 0)
+    return -1;
+  if (analysisData(0) != theIntegrator.getClassTag()) {
+    opserr << "SnapshotDatastore::restoreAnalysis() - the snapshot holds the state of an "
+	   << "integrator with class tag " << analysisData(0) << ", not "
+	   << theIntegrator.getClassTag() << endln;
+    return -1;
+  }
+
+  int dbTag = theIntegrator.getDbTag();
+  theIntegrator.setDbTag(SNAPSHOT_INTEGRATOR_DBTAG);
+  int result = theIntegrator.recvSelf(commitTag, *this, *(this->getObjectBroker()));
+  theIntegrator.setDbTag(dbTag);
+
+  if (result < 0) {
+    opserr << "SnapshotDatastore::restoreAnalysis() - the integrator failed to receive its state\n";
+    return -1;
+  }
+  return 0;
+}
+
+size_t
+SnapshotDatastore::getNumBytes(int kind, int size)
+{
+  if (kind == IntData)
+    return size*sizeof(int);
+  else if (kind == Msg)
+    return size;
+  return size*sizeof(double);
+}
+
+// returns the location for the data of a message, the data of an earlier
+// message with the same key being overwritten
+char *
+SnapshotDatastore::store(int kind, int dbTag, int cTag, int size, int numBytes)
+{
+  Key theKey = {kind, dbTag, cTag, size};
+  std::map<Key, size_t>::iterator theEntry = theEntries.find(theKey);
+  if (theEntry != theEntries.end())
+    return &theData[0] + theEntry->second;
+
+  // keep the data of each message aligned for the doubles
+  size_t offset = (theData.size() + 7) & ~(size_t)7;
+  theData.resize(offset + numBytes);
+  theEntries[theKey] = offset;
+  return &theData[0] + offset;
+}
+
+const char *
+SnapshotDatastore::find(int kind, int dbTag, int cTag, int size) const
+{
+  Key theKey = {kind, dbTag, cTag, size};
+  std::map<Key, size_t>::const_iterator theEntry = theEntries.find(theKey);
+  if (theEntry == theEntries.end())
+    return 0;
+  return &theData[0] + theEntry->second;
+}
+
+int
+SnapshotDatastore::sendMsg(int dbTag, int cTag, const Message &theMessage, ChannelAddress *theAddress)
+{
+  Message &msg = const_cast<Message &>(theMessage);
+  int size = msg.getSize();
+  if (size > 0)
+    memcpy(this->store(Msg, dbTag, cTag, size, size), msg.getData(), size);
+  return 0;
+}
+
+int
+SnapshotDatastore::recvMsg(int dbTag, int cTag, Message &theMessage, ChannelAddress *theAddress)
+{
+  int size = theMessage.getSize();
+  if (size == 0)
+    return 0;
+
+  const char *data = this->find(Msg, dbTag, cTag, size);
+  if (data == 0) {
+    opserr << "SnapshotDatastore::recvMsg() - no message with dbTag " << dbTag
+	   << " commitTag " << cTag << " and size " << size << endln;
+    return -1;
+  }
+  theMessage.putData(const_cast<char *>(data), 0, size);
+  return 0;
+}
+
+int
+SnapshotDatastore::recvMsgUnknownSize(int dbTag, int cTag, Message &theMessage, ChannelAddress *theAddress)
+{
+  Key theKey = {Msg, dbTag, cTag, 0};
+  std::map<Key, size_t>::iterator theEntry = theEntries.lower_bound(theKey);
+  if (theEntry == theEntries.end() || theEntry->first.kind != Msg ||
+      theEntry->first.dbTag != dbTag || theEntry->first.commitTag != cTag) {
+    opserr << "SnapshotDatastore::recvMsgUnknownSize() - no message with dbTag " << dbTag
+	   << " commitTag " << cTag << endln;
+    return -1;
+  }
+
+  // the message is left pointing at the data held, which is valid until
+  // the datastore is cleared or destroyed
+  theMessage.setData(&theData[0] + theEntry->second, theEntry->first.size);
+  return 0;
+}
+
+int
+SnapshotDatastore::sendMatrix(int dbTag, int cTag, const Matrix &theMatrix, ChannelAddress *theAddress)
+{
+  int numRows = theMatrix.noRows();
+  int numCols = theMatrix.noCols();
+  int size = numRows*numCols;
+  if (size == 0)
+    return 0;
+
+  // stored by column, as the data of the matrix
+  double *data = (double *)this->store(MatrixData, dbTag, cTag, size, size*sizeof(double));
+  for (int j = 0; j < numCols; j++)
+    for (int i = 0; i < numRows; i++)
+      *data++ = theMatrix(i, j);
+  return 0;
+}
+
+int
+SnapshotDatastore::recvMatrix(int dbTag, int cTag, Matrix &theMatrix, ChannelAddress *theAddress)
+{
+  int numRows = theMatrix.noRows();
+  int numCols = theMatrix.noCols();
+  int size = numRows*numCols;
+  if (size == 0)
+    return 0;
+
+  const char *data = this->find(MatrixData, dbTag, cTag, size);
+  if (data == 0) {
+    opserr << "SnapshotDatastore::recvMatrix() - no matrix with dbTag " << dbTag
+	   << " commitTag " << cTag << " and size " << size << endln;
+    return -1;
+  }
+  const double *values = (const double *)data;
+  for (int j = 0; j < numCols; j++)
+    for (int i = 0; i < numRows; i++)
+      theMatrix(i, j) = *values++;
+  return 0;
+}
+
+int
+SnapshotDatastore::sendVector(int dbTag, int cTag, const Vector &theVector, ChannelAddress *theAddress)
+{
+  int size = theVector.Size();
+  if (size == 0)
+    return 0;
+
+  double *data = (double *)this->store(VectorData, dbTag, cTag, size, size*sizeof(double));
+  for (int i = 0; i < size; i++)
+    data[i] = theVector(i);
+  return 0;
+}
+
+int
+SnapshotDatastore::recvVector(int dbTag, int cTag, Vector &theVector, ChannelAddress *theAddress)
+{
+  int size = theVector.Size();
+  if (size == 0)
+    return 0;
+
+  const char *data = this->find(VectorData, dbTag, cTag, size);
+  if (data == 0) {
+    opserr << "SnapshotDatastore::recvVector() - no vector with dbTag " << dbTag
+	   << " commitTag " << cTag << " and size " << size << endln;
+    return -1;
+  }
+  const double *values = (const double *)data;
+  for (int i = 0; i < size; i++)
+    theVector(i) = values[i];
+  return 0;
+}
+
+int
+SnapshotDatastore::sendID(int dbTag, int cTag, const ID &theID, ChannelAddress *theAddress)
+{
+  int size = theID.Size();
+  if (size == 0)
+    return 0;
+
+  int *data = (int *)this->store(IntData, dbTag, cTag, size, size*sizeof(int));
+  for (int i = 0; i < size; i++)
+    data[i] = theID(i);
+  return 0;
+}
+
+int
+SnapshotDatastore::recvID(int dbTag, int cTag, ID &theID, ChannelAddress *theAddress)
+{
+  int size = theID.Size();
+  if (size == 0)
+    return 0;
+
+  const char *data = this->find(IntData, dbTag, cTag, size);
+  if (data == 0) {
+    opserr << "SnapshotDatastore::recvID() - no ID with dbTag " << dbTag
+	   << " commitTag " << cTag << " and size " << size << endln;
+    return -1;
+  }
+  const int *values = (const int *)data;
+  for (int i = 0; i < size; i++)
+    theID(i) = values[i];
+  return 0;
+}
+
+int
+SnapshotDatastore::write(const char *fileName)
+{
+  FILE *theFile = fopen(fileName, "wb");
+  if (theFile == 0) {
+    opserr << "SnapshotDatastore::write() - could not open file " << fileName << endln;
+    return -1;
+  }
+
+  SnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.byteOrder = SNAPSHOT_BYTE_ORDER;
+  header.commitTag = commitTag;
+  header.numEntries = theEntries.size();
+  header.dataSize = theData.size();
+
+  std::vector<SnapshotEntry> table;
+  table.reserve(theEntries.size());
+  for (std::map<Key, size_t>::const_iterator theEntry = theEntries.begin();
+       theEntry != theEntries.end(); theEntry++) {
+    SnapshotEntry entry;
+    entry.kind = theEntry->first.kind;
+    entry.dbTag = theEntry->first.dbTag;
+    entry.commitTag = theEntry->first.commitTag;
+    entry.size = theEntry->first.size;
+    entry.offset = theEntry->second;
+    table.push_back(entry);
+  }
+
+  bool ok = fwrite(&header, sizeof(header), 1, theFile) == 1;
+  if (ok && !table.empty())
+    ok = fwrite(&table[0], sizeof(SnapshotEntry), table.size(), theFile) == table.size();
+  if (ok && !theData.empty())
+    ok = fwrite(&theData[0], 1, theData.size(), theFile) == theData.size();
+  if (fclose(theFile) != 0)
+    ok = false;
+
+  if (!ok) {
+    opserr << "SnapshotDatastore::write() - failed to write file " << fileName << endln;
+    return -2;
+  }
+  return 0;
+}
+
+int
+SnapshotDatastore::read(const char *fileName)
+{
+  FILE *theFile = fopen(fileName, "rb");
+  if (theFile == 0) {
+    opserr << "SnapshotDatastore::read() - could not open file " << fileName << endln;
+    return -1;
+  }
+
+  SnapshotHeader header;
+  if (fread(&header, sizeof(header), 1, theFile) != 1 ||
+      memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+    opserr << "SnapshotDatastore::read() - " << fileName << " is not a snapshot file\n";
+    fclose(theFile);
+    return -2;
+  }
+  if (header.version != SNAPSHOT_VERSION || header.byteOrder != SNAPSHOT_BYTE_ORDER) {
+    opserr << "SnapshotDatastore::read() - " << fileName
+	   << " was written by another version or on a machine of different byte order\n";
+    fclose(theFile);
+    return -2;
+  }
+  if (header.numEntries < 0 || header.dataSize < 0) {
+    opserr << "SnapshotDatastore::read() - " << fileName << " is corrupt\n";
+    fclose(theFile);
+    return -2;
+  }
+
+  this->clear();
+  std::vector<SnapshotEntry> table(header.numEntries);
+  theData.resize(header.dataSize);
+
+  bool ok = true;
+  if (!table.empty())
+    ok = fread(&table[0], sizeof(SnapshotEntry), table.size(), theFile) == table.size();
+  if (ok && !theData.empty())
+    ok = fread(&theData[0], 1, theData.size(), theFile) == theData.size();
+  fclose(theFile);
+
+  for (size_t i = 0; ok && i < table.size(); i++) {
+    const SnapshotEntry &entry = table[i];
+    size_t numBytes = getNumBytes(entry.kind, entry.size);
+    if (entry.size < 0 || entry.offset < 0 ||
+	(size_t)entry.offset + numBytes > theData.size()) {
+      ok = false;
+      break;
+    }
+    Key theKey = {entry.kind, entry.dbTag, entry.commitTag, entry.size};
+    theEntries[theKey] = entry.offset;
+  }
+
+  if (!ok) {
+    opserr << "SnapshotDatastore::read() - failed to read file " << fileName << endln;
+    this->clear();
+    return -3;
+  }
+
+  commitTag = header.commitTag;
+  return 0;
+}
@@ -0,0 +1,123 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for SnapshotDatastore.
+// SnapshotDatastore is an FE_Datastore that keeps the data sent to it by
+// the domain and its components in memory, each message keyed by its
+// dbTag, commitTag and size as in the FileDatastore, and writes them to or
+// reads them from a single binary file: a header, a table of the
+// messages and then the data of all the messages in one block.
+//
+// A snapshot of the analysis is made with commitState(), commitAnalysis()
+// for the state of its integrator and write(); it is brought back, also
+// into an empty domain, with read(), restoreState() with the commit tag
+// of the snapshot and restoreAnalysis(), after which the analysis is to
+// be told the domain has changed.
+//
+#ifndef SnapshotDatastore_h
+#define SnapshotDatastore_h
+
+#include <FE_Datastore.h>
+#include <map>
+#include <vector>
+#include <cstddef>
+
+class Integrator;
+
+class SnapshotDatastore: public FE_Datastore
+{
+  public:
+    SnapshotDatastore(Domain &theDomain, FEM_ObjectBroker &theBroker);
+    ~SnapshotDatastore();
+
+    // methods for sending and receiving the data
+    int sendMsg(int dbTag, int commitTag, 
+		const Message &, 
+		ChannelAddress *theAddress =0);    
+    int recvMsg(int dbTag, int commitTag, 
+		Message &, 
+		ChannelAddress *theAddress =0);        
+    int recvMsgUnknownSize(int dbTag, int commitTag, 
+		Message &, 
+		ChannelAddress *theAddress =0);        
+
+    int sendMatrix(int dbTag, int commitTag, 
+		   const Matrix &theMatrix, 
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag, 
+		   Matrix &theMatrix, 
+		   ChannelAddress *theAddress =0);
+    
+    int sendVector(int dbTag, int commitTag, 
+		   const Vector &theVector, 
+		   ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag, 
+		   Vector &theVector, 
+		   ChannelAddress *theAddress =0);
+    
+    int sendID(int dbTag, int commitTag,
+	       const ID &theID,
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag,
+	       ID &theID,
+	       ChannelAddress *theAddress =0);
+
+    int commitState(int commitTag);
+
+    // saves the state of the integrator of the analysis with the data of
+    // the last commitState(), or brings it back; restoreAnalysis() returns
+    // 1 if the snapshot holds no integrator, -1 if it holds one of another
+    // class or the integrator fails to receive its state
+    int commitAnalysis(Integrator &theIntegrator);
+    int restoreAnalysis(Integrator &theIntegrator);
+
+    // writes the data held to the file, or replaces it with the data in
+    // the file; 0 if successful, a negative number otherwise
+    int write(const char *fileName);
+    int read(const char *fileName);
+
+    // the commit tag of the last commitState() or of the snapshot read
+    int getCommitTag(void) const;
+    void clear(void);
+
+    // removes the data sent with the given commit tag
+    void remove(int commitTag);
+
+  private:
+    enum DataKind {Msg = 0, IntData = 1, VectorData = 2, MatrixData = 3};
+
+    struct Key {
+      int kind;
+      int dbTag;
+      int commitTag;
+      int size;
+      bool operator<(const Key &other) const;
+    };
+
+    static size_t getNumBytes(int kind, int size);
+    char *store(int kind, int dbTag, int commitTag, int size, int numBytes);
+    const char *find(int kind, int dbTag, int commitTag, int size) const;
+
+    std::map<Key, size_t> theEntries;  // location in theData of each message
+    std::vector<char> theData;
+    int commitTag;
+};
+
+#endif
@@ -79,6 +79,10 @@
 #include <Analysis.h>
 #include <FE_Datastore.h>
 #include <FEM_ObjectBroker.h>
+#include <ThreadPool.h>
+#include <NodalStateStore.h>
+#include <SnapshotDatastore.h>
+#include <chrono>
 
 #ifdef _CSS
 #include <ElementRecorder.h>
@@ -107,7 +111,9 @@ Domain::Domain()
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
  lastChannel(0),
- paramIndex(0), paramSize(0), numParameters(0)
+ paramIndex(0), paramSize(0), numParameters(0),
+ theThreadPool(0), sweepListsBuilt(false), timeElements(false),
+ theNodalStore(0), nodalStoreBuilt(false), theStates(0)
 {
 
 	// init the arrays for storing the domain components
@@ -162,7 +168,9 @@ Domain::Domain(int numNodes, int numElements, int numSPs, int numMPs,
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0), paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0), paramIndex(0), paramSize(0), numParameters(0),
+ theThreadPool(0), sweepListsBuilt(false), timeElements(false),
+ theNodalStore(0), nodalStoreBuilt(false), theStates(0)
 {
 	// init the arrays for storing the domain components
 	theElements = new MapOfTaggedObjects();
@@ -223,7 +231,9 @@ Domain::Domain(TaggedObjectStorage &theNodesStorage,
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0),paramIndex(0), paramSize(0), numParameters(0),
+ theThreadPool(0), sweepListsBuilt(false), timeElements(false),
+ theNodalStore(0), nodalStoreBuilt(false), theStates(0)
 {
 	// init the arrays for storing the domain components
 	thePCs = new MapOfTaggedObjects();
@@ -282,7 +292,9 @@ Domain::Domain(TaggedObjectStorage &theStorage)
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0),paramIndex(0), paramSize(0), numParameters(0),
+ theThreadPool(0), sweepListsBuilt(false), timeElements(false),
+ theNodalStore(0), nodalStoreBuilt(false), theStates(0)
 {
 	// init the arrays for storing the domain components
 	theStorage.clearAll(); // clear the storage just in case populated
@@ -338,6 +350,15 @@ Domain::~Domain()
 	// delete the objects in the domain
 	this->Domain::clearAll();
 
+	if (theThreadPool != 0)
+		delete theThreadPool;
+
+	if (theNodalStore != 0)
+		delete theNodalStore;
+
+	if (theStates != 0)
+		delete theStates;
+
 	// delete all the storage objects
 	// SEGMENT FAULT WILL OCCUR IF THESE OBJECTS WERE NOT CONSTRUCTED
 	// USING NEW
@@ -360,20 +381,9 @@ Domain::~Domain()
 	if (theLoadPatterns != 0)
 		delete theLoadPatterns;
 
-  if (theParameters != 0)
-    delete theParameters;
-
   if (paramIndex != 0)
     delete [] paramIndex;
-  
-  if (theEleIter != 0)
-    delete theEleIter;
-  
-  if (theNodIter != 0)
-    delete theNodIter;
-  
-  if (theSP_Iter != 0)
-    delete theSP_Iter;
+
 	if (theParameters != 0)
 		delete theParameters;
 
@@ -1030,6 +1040,11 @@ Domain::clearAll(void) {
 
 	theElements->clearAll();
 	theNodes->clearAll();
+	if (theNodalStore != 0)
+		theNodalStore->release();
+	if (theStates != 0)
+		theStates->clear();
+	theStateTags.clear();
 	theSPs->clearAll();
 	thePCs->clearAll();
 	theMPs->clearAll();
@@ -1095,6 +1110,8 @@ Domain::clearAll(void) {
 	hasDomainChangedFlag = false;
 	nodeGraphBuiltFlag = false;
 	eleGraphBuiltFlag = false;
+	sweepListsBuilt = false;
+	nodalStoreBuilt = false;
 
 	if (theNodeGraph != 0)
 		delete theNodeGraph;
@@ -1194,6 +1211,10 @@ Domain::removeNode(int tag)
   // perform a downward cast to a Node (safe as only Node added to
   // this container and return the result of the cast
   Node *result = (Node *)mc;
+
+  // the node takes its response with it
+  if (theNodalStore != 0)
+	  theNodalStore->remove(result);
   // result->setDomain(0);
   
 #if _DLL
@@ -2177,16 +2198,33 @@ Domain::commit(void)
 	// 
 	// first invoke commit on all nodes and elements in the domain
 	//
-	Node* nodePtr;
-	NodeIter& theNodeIter = this->getNodes();
-	while ((nodePtr = theNodeIter()) != 0) {
-		nodePtr->commitState();
-	}
+	NodalStateStore* theStore = this->getNodalStateStore();
+	if (theStore != 0) {
+		theStore->commitState();
+		if (theThreadPool != 0)
+			this->sweepElements(CommitSweep);
+		else {
+			Element* elePtr;
+			ElementIter& theElemIter = this->getElements();
+			while ((elePtr = theElemIter()) != 0) {
+				elePtr->commitState();
+			}
+		}
+	} else if (theThreadPool != 0) {
+		this->sweepNodes(CommitSweep);
+		this->sweepElements(CommitSweep);
+	} else {
+		Node* nodePtr;
+		NodeIter& theNodeIter = this->getNodes();
+		while ((nodePtr = theNodeIter()) != 0) {
+			nodePtr->commitState();
+		}
 
-	Element* elePtr;
-	ElementIter& theElemIter = this->getElements();
-	while ((elePtr = theElemIter()) != 0) {
-		elePtr->commitState();
+		Element* elePtr;
+		ElementIter& theElemIter = this->getElements();
+		while ((elePtr = theElemIter()) != 0) {
+			elePtr->commitState();
+		}
 	}
 
 	// set the new committed time in the domain
@@ -2210,15 +2248,32 @@ Domain::revertToLastCommit(void)
 	// first invoke revertToLastCommit  on all nodes and elements in the domain
 	//
 
-	Node* nodePtr;
-	NodeIter& theNodeIter = this->getNodes();
-	while ((nodePtr = theNodeIter()) != 0)
-		nodePtr->revertToLastCommit();
-
-	Element* elePtr;
-	ElementIter& theElemIter = this->getElements();
-	while ((elePtr = theElemIter()) != 0) {
-		elePtr->revertToLastCommit();
+	NodalStateStore* theStore = this->getNodalStateStore();
+	if (theStore != 0) {
+		theStore->revertToLastCommit();
+		if (theThreadPool != 0)
+			this->sweepElements(RevertSweep);
+		else {
+			Element* elePtr;
+			ElementIter& theElemIter = this->getElements();
+			while ((elePtr = theElemIter()) != 0) {
+				elePtr->revertToLastCommit();
+			}
+		}
+	} else if (theThreadPool != 0) {
+		this->sweepNodes(RevertSweep);
+		this->sweepElements(RevertSweep);
+	} else {
+		Node* nodePtr;
+		NodeIter& theNodeIter = this->getNodes();
+		while ((nodePtr = theNodeIter()) != 0)
+			nodePtr->revertToLastCommit();
+
+		Element* elePtr;
+		ElementIter& theElemIter = this->getElements();
+		while ((elePtr = theElemIter()) != 0) {
+			elePtr->revertToLastCommit();
+		}
 	}
 
 	// set the current time and load factor in the domain to last committed
@@ -2277,12 +2332,35 @@ Domain::update(void)
 	int ok = 0;
 
 	// invoke update on all the ele's
-	ElementIter& theEles = this->getElements();
-	Element* theEle;
+	if (theThreadPool != 0)
+		ok = this->sweepElements(UpdateSweep);
+	else if (timeElements == true) {
+		if (sweepListsBuilt == false)
+			this->buildSweepLists();
+
+		int numEle = theSweepElements.size();
+		for (int i=0; i<numEle; i++) {
+			Element* theEle = theSweepElements[i];
+			ops_TheActiveElement = theEle;
+			auto start = std::chrono::steady_clock::now();
+			ok += theEle->update();
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			double &cost = elementCost[i];
+			cost = (cost > 0.0) ? 0.5*(cost + elapsed.count()) : elapsed.count();
+		}
 
-	while ((theEle = theEles()) != 0) {
-		ops_TheActiveElement = theEle;
-		ok += theEle->update();
+		for (Element* theEle : theSerialElements) {
+			ops_TheActiveElement = theEle;
+			ok += theEle->update();
+		}
+	} else {
+		ElementIter& theEles = this->getElements();
+		Element* theEle;
+
+		while ((theEle = theEles()) != 0) {
+			ops_TheActiveElement = theEle;
+			ok += theEle->update();
+		}
 	}
 
 	if (ok != 0)
@@ -2302,6 +2380,345 @@ Domain::update(double newTime, double dT)
 }
 
 
+int
+Domain::setNumThreads(int numThreads)
+{
+	if (numThreads < 1) {
+		opserr << "WARNING Domain::setNumThreads() - number of threads must be positive\n";
+		return -1;
+	}
+
+	if (theThreadPool != 0) {
+		if (theThreadPool->getNumThreads() == numThreads)
+			return 0;
+		delete theThreadPool;
+		theThreadPool = 0;
+	}
+
+	// with a single thread the original serial loops are used
+	if (numThreads > 1) {
+		theThreadPool = new ThreadPool(numThreads);
+
+		// the next sweep rebuilds the lists and reports the serial elements
+		sweepListsBuilt = false;
+	}
+
+	return 0;
+}
+
+
+int
+Domain::getNumThreads(void) const
+{
+	if (theThreadPool == 0)
+		return 1;
+	return theThreadPool->getNumThreads();
+}
+
+
+int
+Domain::setElementTiming(bool timeThem)
+{
+	timeElements = timeThem;
+	return 0;
+}
+
+
+// the measured cost of an update of all the elements of the domain,
+// subdomains excluded; 0 until every element has been timed
+double
+Domain::getUpdateTime(void)
+{
+	if (sweepListsBuilt == false)
+		return 0.0;
+
+	double cost = 0.0;
+	for (double eleCost : elementCost) {
+		if (eleCost <= 0.0)
+			return 0.0;
+		cost += eleCost;
+	}
+
+	return cost;
+}
+
+
+int
+Domain::getElementCosts(ID &eleTags, Vector &costs)
+{
+	if (sweepListsBuilt == false)
+		this->buildSweepLists();
+
+	int numEle = theSweepElements.size();
+	eleTags.resize(numEle);
+	costs.resize(numEle);
+	for (int i=0; i<numEle; i++) {
+		eleTags(i) = theSweepElements[i]->getTag();
+		costs(i) = elementCost[i];
+	}
+
+	return numEle;
+}
+
+
+int
+Domain::setNodalStateStore(bool useStore)
+{
+	if (useStore == false) {
+		// the nodes go back to their own arrays
+		if (theNodalStore != 0)
+			delete theNodalStore;
+		theNodalStore = 0;
+		nodalStoreBuilt = false;
+		return 0;
+	}
+
+	if (theNodalStore == 0) {
+		theNodalStore = new NodalStateStore();
+		nodalStoreBuilt = false;
+	}
+
+	return 0;
+}
+
+
+NodalStateStore*
+Domain::getNodalStateStore(void)
+{
+	if (theNodalStore == 0)
+		return 0;
+
+	if (nodalStoreBuilt == false) {
+		NodeIter& theNodeIter = this->getNodes();
+		if (theNodalStore->build(theNodeIter) != 0) {
+			opserr << "WARNING Domain::getNodalStateStore() - failed to build the store\n";
+			return 0;
+		}
+		nodalStoreBuilt = true;
+	}
+
+	return theNodalStore;
+}
+
+
+int
+Domain::saveState(int id, FEM_ObjectBroker &theBroker)
+{
+	if (theStates == 0)
+		theStates = new SnapshotDatastore(*this, theBroker);
+
+	// each state is sent with its id as the commit tag
+	int lastCommitTag = commitTag;
+	int res = this->sendSelf(id, *theStates);
+	commitTag = lastCommitTag;
+	if (res < 0) {
+		opserr << "WARNING Domain::saveState() - failed to save state " << id << endln;
+		theStates->remove(id);
+		theStateTags.erase(id);
+		return res;
+	}
+
+	theStateTags[id] = std::pair<int, int>(commitTag, currentGeoTag);
+	return 0;
+}
+
+
+int
+Domain::restoreState(int id, FEM_ObjectBroker &theBroker)
+{
+	std::map<int, std::pair<int, int> >::iterator theState = theStateTags.find(id);
+	if (theState == theStateTags.end()) {
+		opserr << "WARNING Domain::restoreState() - no state " << id << endln;
+		return -1;
+	}
+
+	if (this->hasDomainChanged() != theState->second.second) {
+		opserr << "WARNING Domain::restoreState() - the domain has changed since state "
+		       << id << " was saved\n";
+		return -2;
+	}
+
+	// the stamp being that of the state, the components receive their
+	// state in place
+	lastChannel = theStates->getTag();
+	int res = this->recvSelf(id, *theStates, theBroker);
+	commitTag = theState->second.first;
+	if (res < 0) {
+		opserr << "WARNING Domain::restoreState() - failed to restore state " << id << endln;
+		return res;
+	}
+
+	// the trial state is that committed; an analysis keeping a copy of
+	// the response, e.g. the U, Udot and Udotdot of the Newmark family,
+	// takes it from the nodes again in Integrator::domainChanged()
+	return this->revertToLastCommit();
+}
+
+
+int
+Domain::removeState(int id)
+{
+	if (theStateTags.erase(id) == 0)
+		return -1;
+
+	theStates->remove(id);
+	return 0;
+}
+
+
+// collects the elements and nodes swept by the threads; Subdomains and
+// the elements that are not reentrant are kept aside and swept serially
+void
+Domain::buildSweepLists(void)
+{
+	theSweepElements.clear();
+	theSerialElements.clear();
+	theSweepNodes.clear();
+
+	int numSerial = 0;
+	Element* theEle;
+	ElementIter& theEles = this->getElements();
+	while ((theEle = theEles()) != 0) {
+		if (theEle->isSubdomain() || theEle->isReentrant() == false) {
+			theSerialElements.push_back(theEle);
+			if (theEle->isSubdomain() == false)
+				numSerial++;
+		}
+		else
+			theSweepElements.push_back(theEle);
+	}
+
+	// tell the user how much of the model is left to one thread
+	if (theThreadPool != 0 && numSerial != 0)
+		opserr << "WARNING Domain::buildSweepLists() - " << numSerial << " of "
+		       << this->getNumElements() << " elements are not reentrant and are processed serially\n";
+
+	Node* theNode;
+	NodeIter& theNodes = this->getNodes();
+	while ((theNode = theNodes()) != 0)
+		theSweepNodes.push_back(theNode);
+
+	// no cost is known until the first update
+	elementCost.assign(theSweepElements.size(), 0.0);
+
+	sweepListsBuilt = true;
+}
+
+
+// splits the elements into a few chunks per thread of about equal cost,
+// keeping the order of the elements; chunks of equal size are used
+// until the cost of every element has been measured
+void
+Domain::partitionElements(void)
+{
+	int numEle = theSweepElements.size();
+	int numChunks = 4*theThreadPool->getNumThreads();
+	if (numChunks > numEle)
+		numChunks = numEle;
+
+	chunkStart.clear();
+	chunkStart.push_back(0);
+	if (numEle == 0)
+		return;
+
+	double totalCost = 0.0;
+	bool measured = true;
+	for (int i=0; i<numEle; i++) {
+		totalCost += elementCost[i];
+		if (elementCost[i] <= 0.0)
+			measured = false;
+	}
+
+	if (measured == false) {
+		for (int c=1; c<=numChunks; c++)
+			chunkStart.push_back((int)((long long)c*numEle/numChunks));
+		return;
+	}
+
+	double target = totalCost/numChunks;
+	double cost = 0.0;
+	for (int i=0; i<numEle; i++) {
+		cost += elementCost[i];
+		if (cost >= target*chunkStart.size() && i+1 < numEle)
+			chunkStart.push_back(i+1);
+	}
+	chunkStart.push_back(numEle);
+}
+
+
+int
+Domain::sweepElements(SweepType type)
+{
+	if (sweepListsBuilt == false)
+		this->buildSweepLists();
+
+	this->partitionElements();
+
+	int numChunks = chunkStart.size() - 1;
+	std::vector<int> result(numChunks, 0);
+
+	theThreadPool->run(numChunks, [&](int chunk, int) {
+		int ok = 0;
+		for (int i=chunkStart[chunk]; i<chunkStart[chunk+1]; i++) {
+			Element* theEle = theSweepElements[i];
+			ops_TheActiveElement = theEle;
+			if (type == UpdateSweep) {
+				auto start = std::chrono::steady_clock::now();
+				ok += theEle->update();
+				std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+				// smooth the cost over the updates
+				double &cost = elementCost[i];
+				cost = (cost > 0.0) ? 0.5*(cost + elapsed.count()) : elapsed.count();
+			} else if (type == CommitSweep)
+				theEle->commitState();
+			else
+				theEle->revertToLastCommit();
+		}
+		result[chunk] = ok;
+	});
+
+	int ok = 0;
+	for (int c=0; c<numChunks; c++)
+		ok += result[c];
+
+	for (Element* theEle : theSerialElements) {
+		ops_TheActiveElement = theEle;
+		if (type == UpdateSweep)
+			ok += theEle->update();
+		else if (type == CommitSweep)
+			theEle->commitState();
+		else
+			theEle->revertToLastCommit();
+	}
+
+	return ok;
+}
+
+
+void
+Domain::sweepNodes(SweepType type)
+{
+	if (sweepListsBuilt == false)
+		this->buildSweepLists();
+
+	int numNodes = theSweepNodes.size();
+	int numChunks = 4*theThreadPool->getNumThreads();
+	if (numChunks > numNodes)
+		numChunks = numNodes;
+
+	theThreadPool->run(numChunks, [&](int chunk, int) {
+		int first = (int)((long long)chunk*numNodes/numChunks);
+		int end = (int)((long long)(chunk+1)*numNodes/numChunks);
+		for (int i=first; i<end; i++) {
+			if (type == CommitSweep)
+				theSweepNodes[i]->commitState();
+			else
+				theSweepNodes[i]->revertToLastCommit();
+		}
+	});
+}
+
+
 int
 Domain::updateParameter(int tag, int value)
 {
@@ -2475,6 +2892,8 @@ void
 Domain::domainChange(void)
 {
 	hasDomainChangedFlag = true;
+	sweepListsBuilt = false;
+	nodalStoreBuilt = false;
 }
 
 
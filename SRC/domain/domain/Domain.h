@@ -39,6 +39,8 @@
 
 #include <OPS_Stream.h>
 #include <Vector.h>
+#include <vector>
+#include <map>
 class DomainModalProperties;
 
 class Element;
@@ -76,6 +78,9 @@ class Channel;
 class FEM_ObjectBroker;
 
 class TaggedObjectStorage;
+class ThreadPool;
+class NodalStateStore;
+class SnapshotDatastore;
 
 #if _DLL
 typedef int(__stdcall* DomainEvent_AddNode) (Node* node);
@@ -215,6 +220,33 @@ class Domain
     virtual  int  updateParameter(int tag, int value);
     virtual  int  updateParameter(int tag, double value);    
     
+    // methods for sweeping the elements and nodes in commit(),
+    // revertToLastCommit() and update() with a pool of threads
+    virtual int setNumThreads(int numThreads);
+    virtual int getNumThreads(void) const;
+
+    // methods for the measured cost of the element state determination in
+    // update(), which is always timed when the threads sweep the elements;
+    // the cost of an element is in seconds per update, 0 if not measured
+    virtual int setElementTiming(bool timeElements);
+    virtual double getUpdateTime(void);
+    virtual int getElementCosts(ID &eleTags, Vector &costs);
+
+    // methods for keeping the response of the nodes in a NodalStateStore,
+    // the store returned being up to date with the nodes of the domain
+    virtual int setNodalStateStore(bool useStore);
+    virtual NodalStateStore *getNodalStateStore(void);
+
+    // methods for keeping copies of the committed state of the domain in
+    // memory under an id and going back to any of them; the components of
+    // the domain must be those it had when the state was saved, theBroker
+    // creating any object they need to receive their state. A restore
+    // does not change the domain stamp; the caller has the integrator of
+    // the analysis take the response from the nodes again
+    virtual int saveState(int id, FEM_ObjectBroker &theBroker);
+    virtual int restoreState(int id, FEM_ObjectBroker &theBroker);
+    virtual int removeState(int id);
+
     virtual  int  analysisStep(double dT);
     virtual  int  eigenAnalysis(int numMode, bool generalized, bool findSmallest);
     
@@ -294,6 +326,16 @@ class Domain
 #endif
 
   private:
+    enum SweepType {
+      CommitSweep,
+      RevertSweep,
+      UpdateSweep
+    };
+    void buildSweepLists(void);
+    void partitionElements(void);
+    int  sweepElements(SweepType type);
+    void sweepNodes(SweepType type);
+
     double currentTime;               // current pseudo time
     double committedTime;             // the committed pseudo time
     double dT;                        // difference between committed and current time
@@ -350,6 +392,28 @@ class Domain
     enum {paramSize_grow = 20};
     int paramSize;
     int numParameters;
+
+    // threaded sweeps; the elements are split into chunks of about equal
+    // cost, as measured in the last update(), which the threads take
+    // in turn. Subdomains and the elements that are not reentrant are
+    // swept serially after the chunks.
+    ThreadPool *theThreadPool;
+    bool sweepListsBuilt;
+    std::vector<Element *> theSweepElements;
+    std::vector<Element *> theSerialElements;
+    std::vector<Node *> theSweepNodes;
+    std::vector<double> elementCost;        // seconds per update of each element
+    bool timeElements;                      // time the elements in serial update()
+    std::vector<int> chunkStart;            // start of each chunk in theSweepElements
+
+    // contiguous nodal response, rebuilt when the domain changes
+    NodalStateStore *theNodalStore;
+    bool nodalStoreBuilt;
+
+    // the saved states, with the commit tag and geometry tag of the domain
+    // when each was saved
+    SnapshotDatastore *theStates;
+    std::map<int, std::pair<int, int> > theStateTags;
 };
 
 #endif
@@ -55,6 +55,7 @@
 #include <PartitionedDomainSubIter.h>
 #include <SingleDomEleIter.h>
 #include <Vertex.h>
+#include <VertexIter.h>
 #include <Graph.h>
 #include <LoadPattern.h>
 #include <NodalLoad.h>
@@ -86,7 +87,8 @@ typedef MAP_VERTEX::iterator     MAP_VERTEX_ITERATOR;
 PartitionedDomain::PartitionedDomain()
   : Domain(),
     theSubdomains(0), theDomainPartitioner(0),
-    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false)
+    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false),
+    balanceRatio(0.0), balanceInterval(1), commitsSinceBalance(0)
 {
   elements = new MapOfTaggedObjects();//(1024);
   theSubdomains = new ArrayOfTaggedObjects(32);
@@ -109,7 +111,8 @@ PartitionedDomain::PartitionedDomain()
 PartitionedDomain::PartitionedDomain(DomainPartitioner &thePartitioner)
   : Domain(),
     theSubdomains(0), theDomainPartitioner(&thePartitioner),
-    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false)
+    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false),
+    balanceRatio(0.0), balanceInterval(1), commitsSinceBalance(0)
 {
   elements = new MapOfTaggedObjects();//(1024);
   theSubdomains = new ArrayOfTaggedObjects(32);
@@ -136,7 +139,8 @@ PartitionedDomain::PartitionedDomain(int numNodes, int numElements,
 
   : Domain(numNodes, 0, numSPs, numMPs, numLoadPatterns),
     theSubdomains(0), theDomainPartitioner(&thePartitioner),
-    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false)
+    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false),
+    balanceRatio(0.0), balanceInterval(1), commitsSinceBalance(0)
 {
   elements = new MapOfTaggedObjects();//(numElements);
   theSubdomains = new ArrayOfTaggedObjects(numSubdomains);
@@ -561,7 +565,9 @@ PartitionedDomain::addLoadPattern(LoadPattern *loadPattern)
     SubdomainIter &theSubdomains = this->getSubdomains();
     Subdomain *theSub;
     while ((theSub = theSubdomains()) != 0) {
-      bool res = theSub->addLoadPattern(loadPattern);
+      // each subdomain gets a copy of its own, as when partitioning
+      LoadPattern *thePatternCopy = loadPattern->getCopy();
+      bool res = (thePatternCopy != 0) ? theSub->addLoadPattern(thePatternCopy) : false;
       if (res != true) {
         opserr << "PartitionedDomain::addLoadPattern - cannot add as LoadPattern with tag: " <<
                tag << " to subdomain\n";
@@ -1018,6 +1024,44 @@ PartitionedDomain::setRayleighDampingFactors(double alphaM, double betaK, double
 }
 
 
+int
+PartitionedDomain::setNumThreads(int numThreads)
+{
+  int res = this->Domain::setNumThreads(numThreads);
+  if (res != 0)
+    return res;
+
+  // each subdomain, local or remote, uses its own threads
+  if (theSubdomains != 0) {
+    ArrayOfTaggedObjectsIter theSubsIter(*theSubdomains);
+    TaggedObject *theObject;
+    while ((theObject = theSubsIter()) != 0) {
+      Subdomain *theSub = (Subdomain *)theObject;
+      if (theSub->setNumThreads(numThreads) != 0)
+        res = -1;
+    }
+  }
+  return res;
+}
+
+
+// the subdomains are balanced at a commit if the weight of the heaviest,
+// its measured update time, exceeds ratio times the mean weight; the
+// imbalance is checked every interval commits, a ratio of 0 turning the
+// balancing off
+int
+PartitionedDomain::setLoadBalancing(double ratio, int interval)
+{
+  balanceRatio = (ratio > 0.0) ? ratio : 0.0;
+  balanceInterval = (interval > 0) ? interval : 1;
+  commitsSinceBalance = 0;
+
+  // the elements of the main domain are weighed as the subdomains weigh
+  // theirs, in getCost()
+  return this->Domain::setElementTiming(balanceRatio > 0.0);
+}
+
+
 int
 PartitionedDomain::update(void)
 {
@@ -1285,12 +1329,31 @@ PartitionedDomain::commit(void)
   // opserr << "Subdomain # MASTER " << " update_time = " << this->Domain::update_time_committed << endln;
 
 
-  // now we load balance if we have subdomains and a partitioner
+  // now we load balance if we have subdomains and a partitioner, every
+  // balanceInterval commits, and only if the heaviest subdomain is more
+  // than balanceRatio times as heavy as the mean
   int numSubdomains = this->getNumSubdomains();
-  if (numSubdomains != 0 && theDomainPartitioner != 0)  {
-    // opserr << "Subdomain # MASTER " << " BALANCING! " << endln;
+  if (numSubdomains != 0 && theDomainPartitioner != 0 && balanceRatio > 0.0 &&
+      ++commitsSinceBalance >= balanceInterval)  {
+    commitsSinceBalance = 0;
     Graph &theSubGraphs = this->getSubdomainGraph();
-    theDomainPartitioner->balance(theSubGraphs);
+
+    double maxWeight = 0.0;
+    double sumWeight = 0.0;
+    int numWeights = 0;
+    VertexIter &theVertices = theSubGraphs.getVertices();
+    Vertex *vertexPtr;
+    while ((vertexPtr = theVertices()) != 0) {
+      double weight = vertexPtr->getWeight();
+      if (weight > maxWeight)
+        maxWeight = weight;
+      sumWeight += weight;
+      numWeights++;
+    }
+
+    // the weights are 0 until the subdomains have timed their elements
+    if (sumWeight > 0.0 && maxWeight*numWeights > balanceRatio*sumWeight)
+      theDomainPartitioner->balance(theSubGraphs);
   }
 
   return 0;
@@ -1533,6 +1596,23 @@ PartitionedDomain::partition(int numPartitions, bool usingMain, int mainPartitio
     }
   }
 
+  //
+  // give the new subdomains the threads of this domain
+  //
+  int numThreads = this->getNumThreads();
+  if (numThreads > 1 && theSubdomains != 0) {
+    ArrayOfTaggedObjectsIter theSubsIter(*theSubdomains);
+    TaggedObject *theObject;
+    while ((theObject = theSubsIter()) != 0) {
+      Subdomain *theSub = (Subdomain *)theObject;
+      if (theSub->setNumThreads(numThreads) != 0) {
+        opserr << "PartitionedDomain::partition(void)";
+        opserr << " - failed to set the number of threads of a subdomain\n";
+        return -1;
+      }
+    }
+  }
+
   //
   // add parameters
   //
@@ -1638,6 +1718,23 @@ PartitionedDomain::buildEleGraph(Graph *theEleGraph)
   MAP_INT theEleToVertexMap;
   MAP_INT_ITERATOR theEleToVertexMapEle;
 
+  // if the update of every element has been timed, as it is when the model
+  // has been run with the element timing on before it is partitioned, the
+  // elements are weighed with their measured cost rather than their dof
+  std::map<int, double> eleCosts;
+  ID measuredTags(0);
+  Vector measuredCosts(0);
+  int numMeasured = this->Domain::getElementCosts(measuredTags, measuredCosts);
+  if (numMeasured == numVertex) {
+    for (int i=0; i<numMeasured; i++) {
+      if (measuredCosts(i) <= 0.0) {
+	eleCosts.clear();
+	break;
+      }
+      eleCosts[measuredTags(i)] = measuredCosts(i);
+    }
+  }
+
 
   TaggedObject *theTagged;
   TaggedObjectIter &theElements = elements->getComponents();
@@ -1653,7 +1750,9 @@ PartitionedDomain::buildEleGraph(Graph *theEleGraph)
 
     // Get the compute cost and communications cost.
     Element * theElement =  static_cast<Element *>(theTagged);
-    double eleWeight = (double) theElement->getNumDOF(); //theElement->getTime();
+    double eleWeight = (double) theElement->getNumDOF();
+    if (eleCosts.empty() == false)
+      eleWeight = eleCosts[eleTag];
     int eleCommCost = 0;//theElement->getMoveCost();
     vertexPtr->setWeight(eleWeight);
     // vertexPtr->setTmp(eleCommCost);
@@ -1826,16 +1925,20 @@ PartitionedDomain::getSubdomainGraph(void)
   //Mapping element tags to vertex corresponding vertex
   MAP_INT subDTagToVtxTag;
 
-  //Add P0 to the graph
+  //Add P0 to the graph if it has elements of its own; the subdomains are
+  //numbered from 1, so P0 is given the tag 0 of the main partition
   SubdomainIter &theSubdomains = this->getSubdomains();
   Subdomain *subDPtr = 0;
-  int subDTag = 1;
-  double myCostP0 = 0.0;//this->getUpdateTime();
+  bool hasP0 = (this->Domain::getNumElements() != 0);
+  if (hasP0) {
+    int subDTag = 0;
+    double myCostP0 = this->Domain::getUpdateTime();
 
-  Vertex *selfvertexPtr = new Vertex(subDTag, subDTag, myCostP0);
-  mySubdomainGraph->addVertex(selfvertexPtr);
+    Vertex *selfvertexPtr = new Vertex(subDTag, subDTag, myCostP0);
+    mySubdomainGraph->addVertex(selfvertexPtr);
   
-  subDTagToVtxTag.insert(MAP_INT_TYPE(subDTag, subDTag));
+    subDTagToVtxTag.insert(MAP_INT_TYPE(subDTag, subDTag));
+  }
 
   while ((subDPtr = theSubdomains()) != 0) {    
     int subDTag = subDPtr->getTag();
@@ -1866,7 +1969,8 @@ PartitionedDomain::getSubdomainGraph(void)
   while ((nodPtr = niter()) != 0) {
     int nodeTag = nodPtr->getTag();
     Vertex *vertexPtr = new Vertex(count++, nodeTag);
-    vertexPtr->addEdge(1);
+    if (hasP0)
+      vertexPtr->addEdge(0);
 
     nodeTagToVtx.insert(MAP_VERTEX_TYPE(nodeTag, vertexPtr));
   }
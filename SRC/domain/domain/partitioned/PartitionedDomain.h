@@ -103,6 +103,7 @@ class PartitionedDomain: public Domain
     virtual  void applyLoad(double pseudoTime);
     virtual  void setLoadConstant(void);    
     virtual  int  setRayleighDampingFactors(double alphaM, double betaK, double betaK0, double betaKc);
+    virtual  int  setNumThreads(int numThreads);
 
     virtual  int commit(void);    
     virtual  int revertToLastCommit(void);        
@@ -139,6 +140,7 @@ class PartitionedDomain: public Domain
     virtual SubdomainIter &getSubdomains(void);
     virtual Node *removeExternalNode(int tag);        
     virtual Graph &getSubdomainGraph(void);
+    virtual int setLoadBalancing(double ratio, int interval = 1);
 
     // nodal methods required in domain interface for parallel interprter
     virtual const Vector *getNodeResponse(int nodeTag, NodeResponseType); 
@@ -174,6 +176,10 @@ class PartitionedDomain: public Domain
     Graph *mySubdomainGraph;    // a graph of subdomain connectivity
 
     bool has_sent_yet;
+
+    double balanceRatio;        // max/mean subdomain weight that triggers
+    int balanceInterval;        // a balance, checked every interval commits
+    int commitsSinceBalance;
 };
 
 #endif
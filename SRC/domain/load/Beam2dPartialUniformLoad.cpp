@@ -30,12 +30,10 @@
 #include <Information.h>
 #include <Parameter.h>
 
-Vector Beam2dPartialUniformLoad::data(6);
-
 Beam2dPartialUniformLoad::Beam2dPartialUniformLoad(int tag, double wt, double wa,
 						   int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam2dPartialUniformLoad, theElementTag),
-   wTrans_a(wt), wTrans_b(wt), wAxial_a(wa), wAxial_b(wa), aOverL(0.0), bOverL(1.0), parameterID(0)
+   wTrans_a(wt), wTrans_b(wt), wAxial_a(wa), wAxial_b(wa), aOverL(0.0), bOverL(1.0), parameterID(0), data(6)
 {
 
 }
@@ -43,7 +41,7 @@ Beam2dPartialUniformLoad::Beam2dPartialUniformLoad(int tag, double wt, double wa
 Beam2dPartialUniformLoad::Beam2dPartialUniformLoad(int tag, double wt, double wa,
 						   double aL, double bL, int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam2dPartialUniformLoad, theElementTag),
-   wTrans_a(wt), wTrans_b(wt), wAxial_a(wa), wAxial_b(wa), aOverL(aL), bOverL(bL), parameterID(0)
+   wTrans_a(wt), wTrans_b(wt), wAxial_a(wa), wAxial_b(wa), aOverL(aL), bOverL(bL), parameterID(0), data(6)
 {
 
 }
@@ -51,14 +49,14 @@ Beam2dPartialUniformLoad::Beam2dPartialUniformLoad(int tag, double wt, double wa
 Beam2dPartialUniformLoad::Beam2dPartialUniformLoad(int tag, double wta, double wtb, double waa, double wab,
 						   double aL, double bL, int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam2dPartialUniformLoad, theElementTag),
-   wTrans_a(wta), wTrans_b(wtb), wAxial_a(waa), wAxial_b(wab), aOverL(aL), bOverL(bL), parameterID(0)
+   wTrans_a(wta), wTrans_b(wtb), wAxial_a(waa), wAxial_b(wab), aOverL(aL), bOverL(bL), parameterID(0), data(6)
 {
 
 }
 
 Beam2dPartialUniformLoad::Beam2dPartialUniformLoad()
   :ElementalLoad(LOAD_TAG_Beam2dPartialUniformLoad),
-   wTrans_a(0.0), wTrans_b(0.0), wAxial_a(0.0), wAxial_b(0.0), aOverL(0.0), bOverL(0.0), parameterID(0)
+   wTrans_a(0.0), wTrans_b(0.0), wAxial_a(0.0), wAxial_b(0.0), aOverL(0.0), bOverL(0.0), parameterID(0), data(6)
 {
 
 }
@@ -61,9 +61,9 @@ class Beam2dPartialUniformLoad : public ElementalLoad
   double wAxial_b;
   double aOverL;
   double bOverL;
-  static Vector data;
   
   int parameterID;
+  Vector data;  // returned by getData()
 };
 
 #endif
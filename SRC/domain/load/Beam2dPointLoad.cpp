@@ -33,19 +33,17 @@
 #include <Information.h>
 #include <Parameter.h>
 
-Vector Beam2dPointLoad::data(3);
-
 Beam2dPointLoad::Beam2dPointLoad(int tag, double Pt, double dist,
 				 int theElementTag, double Pa)
   :ElementalLoad(tag, LOAD_TAG_Beam2dPointLoad, theElementTag),
-   Ptrans(Pt), Paxial(Pa), x(dist), parameterID(0)
+   Ptrans(Pt), Paxial(Pa), x(dist), parameterID(0), data(3)
 {
 
 }
 
 Beam2dPointLoad::Beam2dPointLoad()
   :ElementalLoad(LOAD_TAG_Beam2dPointLoad),
-   Ptrans(0.0), Paxial(0.0), x(0.0), parameterID(0)
+   Ptrans(0.0), Paxial(0.0), x(0.0), parameterID(0), data(3)
 {
 
 }
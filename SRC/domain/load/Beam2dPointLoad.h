@@ -58,9 +58,9 @@ class Beam2dPointLoad : public ElementalLoad
     double Ptrans;     // magnitude of the transverse load
     double Paxial;     // magnitude of the axial load
     double x;     // relative distance (x/L) along length from end 1 of element
-    static Vector data;
 
     int parameterID;
+    Vector data;  // returned by getData()
 };
 
 #endif
@@ -30,14 +30,12 @@
 #include <Beam2dTempLoad.h>
 #include <Vector.h>
 
-Vector Beam2dTempLoad::data(4);
-
 Beam2dTempLoad::Beam2dTempLoad(int tag, 
 			       double temp1, double temp2, 
 			       double temp3, double temp4, 
 			       int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam2dTempLoad, theElementTag), 
-   Ttop1(temp1),  Tbot1(temp2), Ttop2(temp3), Tbot2(temp4)
+   Ttop1(temp1),  Tbot1(temp2), Ttop2(temp3), Tbot2(temp4), data(4)
 {
 
 }
@@ -45,7 +43,7 @@ Beam2dTempLoad::Beam2dTempLoad(int tag,
 			       double temp1, 
 			       int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam2dTempLoad, theElementTag), 
-   Ttop1(temp1),  Tbot1(temp1), Ttop2(temp1), Tbot2(temp1)
+   Ttop1(temp1),  Tbot1(temp1), Ttop2(temp1), Tbot2(temp1), data(4)
 {
 
 }
@@ -54,19 +52,19 @@ Beam2dTempLoad::Beam2dTempLoad(int tag,
 			       double temp1, double temp2, 
 			       int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam2dTempLoad, theElementTag), 
-  Ttop1(temp1),  Tbot1(temp2), Ttop2(temp1), Tbot2(temp2)
+  Ttop1(temp1),  Tbot1(temp2), Ttop2(temp1), Tbot2(temp2), data(4)
 {
 
 }
 Beam2dTempLoad::Beam2dTempLoad(int tag, int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam2dTempLoad, theElementTag), 
-  Ttop1(0.0), Tbot1(0.0), Ttop2(0.0), Tbot2(0.0)
+  Ttop1(0.0), Tbot1(0.0), Ttop2(0.0), Tbot2(0.0), data(4)
 {
 
 }
 Beam2dTempLoad::Beam2dTempLoad()
   :ElementalLoad(LOAD_TAG_Beam2dTempLoad), 
-  Ttop1(0.0), Tbot1(0.0), Ttop2(0.0), Tbot2(0.0)
+  Ttop1(0.0), Tbot1(0.0), Ttop2(0.0), Tbot2(0.0), data(4)
 {
 
 }
@@ -69,7 +69,7 @@ class Beam2dTempLoad : public ElementalLoad
   double Tbot1;       // Temp change at bottom node 1 end of member
   double Ttop2;       // Temp change at top node 2 end of member
   double Tbot2;	      // Temp change at bottom node 2 end of member	
-  static Vector data; // data for temp loads
+  Vector data;  // data for temp loads
 };
 
 #endif
@@ -39,7 +39,6 @@
 #include <Beam2dThermalAction.h>
 #include <Vector.h>
 #include <Element.h>
-Vector Beam2dThermalAction::data(18);
 
 Beam2dThermalAction::Beam2dThermalAction(int tag, 
 					 double t1, double locY1, double t2, double locY2,
@@ -49,7 +48,7 @@ Beam2dThermalAction::Beam2dThermalAction(int tag,
 					 double t9, double locY9, 
 					 int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam2dThermalAction, theElementTag), 
-   ThermalActionType(LOAD_TAG_Beam2dThermalAction),theSeries(0)
+   ThermalActionType(LOAD_TAG_Beam2dThermalAction),theSeries(0), data(18)
 {
   Temp[0]=t1; Temp[1] = t2; Temp[2] = t3; Temp[3] = t4; Temp[4] = t5;
   Temp[5]=t6; Temp[6] = t7; Temp[7] = t8; Temp[8] = t9; 
@@ -66,7 +65,7 @@ Beam2dThermalAction::Beam2dThermalAction(int tag,
 					 TimeSeries* theSeries,int theElementTag
 					 )
 :ElementalLoad(tag, LOAD_TAG_Beam2dThermalAction, theElementTag),theSeries(theSeries),
-ThermalActionType(LOAD_TAG_Beam2dThermalAction)
+ThermalActionType(LOAD_TAG_Beam2dThermalAction), data(18)
 {
   Loc[0]=locY1;
   Loc[8]=locY2;
@@ -90,7 +89,7 @@ Beam2dThermalAction::Beam2dThermalAction(int tag,
 					 TimeSeries* theSeries,int theElementTag
 					 )
 :ElementalLoad(tag, LOAD_TAG_Beam2dThermalAction, theElementTag),theSeries(theSeries),
-ThermalActionType(LOAD_TAG_Beam2dThermalAction)
+ThermalActionType(LOAD_TAG_Beam2dThermalAction), data(18)
 {
 	if (locs.Size()!=9){
 		opserr<<" WARNING::Beam2DThermalAction constructor failed to get 9 loc values"<<endln;
@@ -113,7 +112,7 @@ ThermalActionType(LOAD_TAG_Beam2dThermalAction)
 
 Beam2dThermalAction::Beam2dThermalAction(int tag,  
 					 int theElementTag)
-  :ElementalLoad(tag, LOAD_TAG_Beam2dThermalAction, theElementTag),ThermalActionType(LOAD_TAG_NodalThermalAction),theSeries(0)  
+  :ElementalLoad(tag, LOAD_TAG_Beam2dThermalAction, theElementTag),ThermalActionType(LOAD_TAG_NodalThermalAction),theSeries(0), data(18)
 {
 	 for(int i=0 ;i<9;i++) {
 		Temp[i]=0;
@@ -85,7 +85,6 @@ class Beam2dThermalAction : public ElementalLoad
   double Temp[9]; //Initial Temperature 
   double TempApp[9]; // Temperature applied
   double Loc[9]; // Location through the depth of section
-  static Vector data; // data for temperature and locations
 
   int ThermalActionType;
 
@@ -95,6 +94,7 @@ class Beam2dThermalAction : public ElementalLoad
   Vector Factors;
   TimeSeries* theSeries;
   //--Adding a factor vector for FireLoadPattern [-END-]: by L.J&P.K(university of Edinburgh)-07-MAY-2012-///
+  Vector data;  // data for temperature and locations
  };
 
 
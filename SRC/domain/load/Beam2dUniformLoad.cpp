@@ -34,19 +34,17 @@
 #include <Information.h>
 #include <Parameter.h>
 
-Vector Beam2dUniformLoad::data(2);
-
 Beam2dUniformLoad::Beam2dUniformLoad(int tag, double wt, double wa,
 				     int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam2dUniformLoad, theElementTag),
-   wTrans(wt), wAxial(wa), parameterID(0)
+   wTrans(wt), wAxial(wa), parameterID(0), data(2)
 {
 
 }
 
 Beam2dUniformLoad::Beam2dUniformLoad()
   :ElementalLoad(LOAD_TAG_Beam2dUniformLoad),
-   wTrans(0.0), wAxial(0.0), parameterID(0)
+   wTrans(0.0), wAxial(0.0), parameterID(0), data(2)
 {
 
 }
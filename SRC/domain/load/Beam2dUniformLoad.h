@@ -55,9 +55,9 @@ class Beam2dUniformLoad : public ElementalLoad
   private:
     double wTrans;
     double wAxial;
-    static Vector data;
 
     int parameterID;
+    Vector data;  // returned by getData()
 };
 
 #endif
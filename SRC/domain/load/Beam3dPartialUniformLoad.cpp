@@ -30,19 +30,17 @@
 #include <Information.h>
 #include <Parameter.h>
 
-Vector Beam3dPartialUniformLoad::data(8);
-
 Beam3dPartialUniformLoad::Beam3dPartialUniformLoad(int tag, double wya, double wza, double waa,
 						   double aL, double bL, double wyb, double wzb, double wab, int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam3dPartialUniformLoad, theElementTag),
-   wTransya(wya), wTransza(wza), wAxiala(waa), aOverL(aL), bOverL(bL), wTransyb(wyb), wTranszb(wzb), wAxialb(wab), parameterID(0)
+   wTransya(wya), wTransza(wza), wAxiala(waa), aOverL(aL), bOverL(bL), wTransyb(wyb), wTranszb(wzb), wAxialb(wab), parameterID(0), data(8)
 {
 
 }
 
 Beam3dPartialUniformLoad::Beam3dPartialUniformLoad()
   :ElementalLoad(LOAD_TAG_Beam3dPartialUniformLoad),
-   wTransya(0.0), wTransza(0.0), wAxiala(0.0), aOverL(0.0), bOverL(0.0), wTransyb(0.0), wTranszb(0.0), wAxialb(0.0), parameterID(0)
+   wTransya(0.0), wTransza(0.0), wAxiala(0.0), aOverL(0.0), bOverL(0.0), wTransyb(0.0), wTranszb(0.0), wAxialb(0.0), parameterID(0), data(8)
 {
 
 }
@@ -61,9 +61,9 @@ class Beam3dPartialUniformLoad : public ElementalLoad
   double wTransyb;
   double wTranszb;
   double wAxialb;
-  static Vector data;
   
   int parameterID;
+  Vector data;  // returned by getData()
 };
 
 #endif
@@ -31,19 +31,17 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 
-Vector Beam3dPointLoad::data(4);
-
 Beam3dPointLoad::Beam3dPointLoad(int tag, double py, double pz, double dist,
 				 int theElementTag, double px)
   :ElementalLoad(tag, LOAD_TAG_Beam3dPointLoad, theElementTag),
-   Py(py), Pz(pz), Px(px), x(dist)
+   Py(py), Pz(pz), Px(px), x(dist), data(4)
 {
 
 }
 
 Beam3dPointLoad::Beam3dPointLoad()
   :ElementalLoad(LOAD_TAG_Beam3dPointLoad),
-   Py(0.0), Pz(0.0), Px(0.0), x(0.0)
+   Py(0.0), Pz(0.0), Px(0.0), x(0.0), data(4)
 {
 
 }
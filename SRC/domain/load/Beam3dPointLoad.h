@@ -51,7 +51,7 @@ class Beam3dPointLoad : public ElementalLoad
     double Pz;    // magnitude of the transverse load
     double Px;    // magnitude of the axial load
     double x;     // relative distance (x/L) along length from end 1 of element
-    static Vector data;
+    Vector data;  // returned by getData()
 };
 
 #endif
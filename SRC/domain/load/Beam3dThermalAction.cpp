@@ -39,14 +39,13 @@
 #include <Beam3dThermalAction.h>
 #include <Vector.h>
 #include <Element.h>
-Vector Beam3dThermalAction::data(35);
 
 // It allows for linear interpolation in a 5x5 grid (5 locs in Z and Y)
 Beam3dThermalAction::Beam3dThermalAction(int tag,
 	double indata[],
 	int theElementTag)
 	:ElementalLoad(tag, LOAD_TAG_Beam3dThermalAction, theElementTag),
-	ThermalActionType(LOAD_TAG_Beam3dThermalAction), theSeries(0)
+	ThermalActionType(LOAD_TAG_Beam3dThermalAction), theSeries(0), data(35)
 {
 	for (int i = 0; i < 5; i++) {
 		Loc[i] = indata[i]; Loc[i + 5] = indata[i + 5];
@@ -69,7 +68,7 @@ Beam3dThermalAction::Beam3dThermalAction(int tag,
                          double t12, double t13, double locZ4, double t14, double t15,double locZ5,
 			             int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam3dThermalAction, theElementTag),
-  ThermalActionType(LOAD_TAG_Beam3dThermalAction), theSeries(0)
+  ThermalActionType(LOAD_TAG_Beam3dThermalAction), theSeries(0), data(35)
 {
   Temp[0]=t1; Temp[1] = t2; Temp[2] = t3; Temp[3] = t4; Temp[4] = t5;
   Temp[5]=t6; Temp[6] = t8; Temp[7] = t10; Temp[8] = t12; Temp[9] = t14;
@@ -90,7 +89,7 @@ Beam3dThermalAction::Beam3dThermalAction(int tag,
 					 double t9, double locY9, 
 					 int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam3dThermalAction, theElementTag), 
-   ThermalActionType(LOAD_TAG_Beam3dThermalAction), theSeries(0)
+   ThermalActionType(LOAD_TAG_Beam3dThermalAction), theSeries(0), data(35)
 {
   Temp[0]=t1; Temp[1] = t2; Temp[2] = t3; Temp[3] = t4; Temp[4] = t5;
   Temp[5]=t6; Temp[6] = t7; Temp[7] = t8; Temp[8] = t9; 
@@ -106,7 +105,7 @@ Beam3dThermalAction::Beam3dThermalAction(int tag,
                          TimeSeries* theSeries, 
                          int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam3dThermalAction, theElementTag),theSeries(theSeries),
-  ThermalActionType(LOAD_TAG_Beam3dThermalAction)
+  ThermalActionType(LOAD_TAG_Beam3dThermalAction), data(35)
 {
     Loc[0]=locY1;Loc[4]=locY2; Loc[5]=locZ1 ;Loc[9] = locZ2;
 
@@ -131,7 +130,7 @@ Beam3dThermalAction::Beam3dThermalAction(int tag,
                          TimeSeries* theSeries, 
                          int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam3dThermalAction, theElementTag),theSeries(theSeries),
-  ThermalActionType(LOAD_TAG_Beam3dThermalAction)
+  ThermalActionType(LOAD_TAG_Beam3dThermalAction), data(35)
 {
 	if (locs.Size()!=9){
 		opserr<<" WARNING::Beam3DThermalAction constructor failed to get 9 loc values"<<endln;
@@ -154,7 +153,7 @@ Beam3dThermalAction::Beam3dThermalAction(int tag,
 
 Beam3dThermalAction::Beam3dThermalAction(int tag,  
 					 int theElementTag)
-  :ElementalLoad(tag, LOAD_TAG_Beam3dThermalAction, theElementTag),ThermalActionType(LOAD_TAG_NodalThermalAction), theSeries(0)
+  :ElementalLoad(tag, LOAD_TAG_Beam3dThermalAction, theElementTag),ThermalActionType(LOAD_TAG_NodalThermalAction), theSeries(0), data(35)
 {
 	 Factors.Zero();
 	 for(int i=0 ;i<15;i++) {
@@ -96,13 +96,13 @@ class Beam3dThermalAction : public ElementalLoad
   double Temp[25]; //Initial Temperature for using plain patterns
   double TempApp[25]; // Temperature applied
   double Loc[10]; // 5 Locsthrough the depth of section+ 5 locs through the width
-  static Vector data; // data for temperature and locations
   int ThermalActionType;
 
   //--The BeamThermalAction are modified by Liming and having a new structure for applying the fire action
  int indicator; //indicator if fireloadpattern was called
   Vector Factors;
   TimeSeries* theSeries;
+  Vector data;  // data for temperature and locations
 };
 
 #endif
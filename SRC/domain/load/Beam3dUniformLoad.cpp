@@ -32,19 +32,17 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 
-Vector Beam3dUniformLoad::data(3);
-
 Beam3dUniformLoad::Beam3dUniformLoad(int tag, double wY, double wZ, double wX,
 				     int theElementTag)
   :ElementalLoad(tag, LOAD_TAG_Beam3dUniformLoad, theElementTag),
-   wy(wY), wz(wZ), wx(wX)
+   wy(wY), wz(wZ), wx(wX), data(3)
 {
 
 }
 
 Beam3dUniformLoad::Beam3dUniformLoad()
   :ElementalLoad(LOAD_TAG_Beam3dUniformLoad),
-   wy(0.0), wz(0.0), wx(0.0)
+   wy(0.0), wz(0.0), wx(0.0), data(3)
 {
 
 }
@@ -51,7 +51,7 @@ class Beam3dUniformLoad : public ElementalLoad
     double wy;  // Transverse
     double wz;  // Transverse
     double wx;  // Axial
-    static Vector data;
+    Vector data;  // returned by getData()
 };
 
 #endif
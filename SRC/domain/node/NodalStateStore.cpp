@@ -0,0 +1,216 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of NodalStateStore.
+//
+#include <NodalStateStore.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Domain.h>
+#include <string.h>
+#include <typeinfo>
+
+NodalStateStore::NodalStateStore()
+  :numDOF(0)
+{
+
+}
+
+NodalStateStore::~NodalStateStore()
+{
+  this->clear();
+}
+
+int
+NodalStateStore::build(NodeIter &theIter)
+{
+  std::vector<Node *> newNodes;
+  std::vector<int> newOffset;
+  int newNumDOF = 0;
+
+  Node *theNode;
+  while ((theNode = theIter()) != 0) {
+    newNodes.push_back(theNode);
+    newOffset.push_back(newNumDOF);
+    newNumDOF += theNode->getNumberDOF();
+  }
+
+  // the nodes copy their values from their current arrays, which may
+  // be the old blocks, so these are kept until all have moved
+  std::vector<double> newValues(NumQuantities*(size_t)newNumDOF, 0.0);
+  int numNodes = newNodes.size();
+  if (newNumDOF > 0)
+    for (int i=0; i<numNodes; i++)
+      newNodes[i]->moveState(&newValues[0] + newOffset[i], newNumDOF);
+
+  theNodes.swap(newNodes);
+  offset.swap(newOffset);
+  values.swap(newValues);
+  numDOF = newNumDOF;
+
+  // the dofs the store commits and reverts itself
+  exactNodes.clear();
+  runStart.clear();
+  runSize.clear();
+  otherNodes.clear();
+  for (int i=0; i<numNodes; i++) {
+    Node *theNode = theNodes[i];
+    int nodeDOF = theNode->getNumberDOF();
+    if (typeid(*theNode) != typeid(Node)) {
+      otherNodes.push_back(theNode);
+      continue;
+    }
+    exactNodes.push_back(theNode);
+    if (!runStart.empty() && runStart.back() + runSize.back() == offset[i])
+      runSize.back() += nodeDOF;
+    else {
+      runStart.push_back(offset[i]);
+      runSize.push_back(nodeDOF);
+    }
+  }
+
+  return 0;
+}
+
+int
+NodalStateStore::remove(Node *theNode)
+{
+  int numNodes = theNodes.size();
+  for (int i=0; i<numNodes; i++)
+    if (theNodes[i] == theNode) {
+      theNodes[i] = 0;
+      for (size_t j=0; j<exactNodes.size(); j++)
+	if (exactNodes[j] == theNode) {
+	  exactNodes.erase(exactNodes.begin() + j);
+	  break;
+	}
+      for (size_t j=0; j<otherNodes.size(); j++)
+	if (otherNodes[j] == theNode) {
+	  otherNodes.erase(otherNodes.begin() + j);
+	  break;
+	}
+      return theNode->moveState(0, 0);
+    }
+
+  return 0;
+}
+
+void
+NodalStateStore::clear(void)
+{
+  int numNodes = theNodes.size();
+  for (int i=0; i<numNodes; i++)
+    if (theNodes[i] != 0)
+      theNodes[i]->moveState(0, 0);
+
+  this->release();
+}
+
+void
+NodalStateStore::release(void)
+{
+  theNodes.clear();
+  offset.clear();
+  values.clear();
+  numDOF = 0;
+  exactNodes.clear();
+  runStart.clear();
+  runSize.clear();
+  otherNodes.clear();
+}
+
+void
+NodalStateStore::commitState(void)
+{
+#ifdef _CSS
+  // Node::commitState() also keeps the last committed response and
+  // accumulates the energy terms, from the response before and after
+  int numExact = exactNodes.size();
+  for (int i=0; i<numExact; i++) {
+    Node *theNode = exactNodes[i];
+    theNode->lastCommitDisp = *(theNode->commitDisp);
+    theNode->lastCommitVel = *(theNode->commitVel);
+    theNode->lastCommitAccel = *(theNode->commitAccel);
+  }
+#endif // _CSS
+
+  // commit = trial and the increments zero, as Node::commitState()
+  double *v = values.empty() ? 0 : &values[0];
+  size_t n = numDOF;
+  int numRuns = runStart.size();
+  for (int r=0; r<numRuns; r++) {
+    double *u = v + runStart[r];
+    size_t size = runSize[r]*sizeof(double);
+    memcpy(u + CommitDisp*n, u + TrialDisp*n, size);
+    memset(u + IncrDisp*n, 0, size);
+    memset(u + IncrDeltaDisp*n, 0, size);
+    memcpy(u + CommitVel*n, u + TrialVel*n, size);
+    memcpy(u + CommitAccel*n, u + TrialAccel*n, size);
+  }
+
+#ifdef _CSS
+  double time = ops_TheActiveDomain->getCurrentTime();
+  for (int i=0; i<numExact; i++) {
+    Node *theNode = exactNodes[i];
+    theNode->prevT = theNode->curT;
+    theNode->curT = time;
+    theNode->computeDampEnergy();
+    theNode->computeMotionEnergy();
+  }
+#endif // _CSS
+
+  int numOther = otherNodes.size();
+  for (int i=0; i<numOther; i++)
+    otherNodes[i]->commitState();
+}
+
+void
+NodalStateStore::revertToLastCommit(void)
+{
+  // trial = commit and the increments zero, as Node::revertToLastCommit()
+  double *v = values.empty() ? 0 : &values[0];
+  size_t n = numDOF;
+  int numRuns = runStart.size();
+  for (int r=0; r<numRuns; r++) {
+    double *u = v + runStart[r];
+    size_t size = runSize[r]*sizeof(double);
+    memcpy(u + TrialDisp*n, u + CommitDisp*n, size);
+    memset(u + IncrDisp*n, 0, size);
+    memset(u + IncrDeltaDisp*n, 0, size);
+    memcpy(u + TrialVel*n, u + CommitVel*n, size);
+    memcpy(u + TrialAccel*n, u + CommitAccel*n, size);
+  }
+
+  int numOther = otherNodes.size();
+  for (int i=0; i<numOther; i++)
+    otherNodes[i]->revertToLastCommit();
+}
+
+int
+NodalStateStore::getNumNodes(void) const
+{
+  return theNodes.size();
+}
+
+int
+NodalStateStore::getNumDOF(void) const
+{
+  return numDOF;
+}
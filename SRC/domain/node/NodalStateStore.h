@@ -0,0 +1,90 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for
+// NodalStateStore. A NodalStateStore keeps the response of a set of
+// Nodes in one contiguous block per quantity, each holding the values of
+// all the nodes one after the other, instead of in arrays owned by each
+// node. The Vectors returned by the Node accessors then view the block,
+// and the commit and revert of the nodes become passes over the blocks.
+// Only the nodes that are of class Node itself are committed and reverted
+// that way; those of a subclass, which may override Node::commitState()
+// and revertToLastCommit(), are still committed and reverted by a call
+// to each.
+//
+#ifndef NodalStateStore_h
+#define NodalStateStore_h
+
+#include <vector>
+
+class Node;
+class NodeIter;
+
+class NodalStateStore
+{
+  public:
+    // the quantities, in the order of their blocks
+    enum Quantity {
+      TrialDisp,
+      CommitDisp,
+      IncrDisp,
+      IncrDeltaDisp,
+      TrialVel,
+      CommitVel,
+      TrialAccel,
+      CommitAccel,
+      UnbalLoad,
+      NumQuantities
+    };
+
+    NodalStateStore();
+    ~NodalStateStore();
+
+    // moves the response of the nodes into new blocks, in the order of
+    // the iter, from the store or the nodes' own arrays
+    int build(NodeIter &theNodes);
+
+    // returns the response of theNode to arrays it owns
+    int remove(Node *theNode);
+    // returns the response of all the nodes to arrays they own
+    void clear(void);
+    // forgets the nodes without touching them, as they are being deleted
+    void release(void);
+
+    // as Node::commitState() and revertToLastCommit() on every node
+    void commitState(void);
+    void revertToLastCommit(void);
+
+    int getNumNodes(void) const;
+    int getNumDOF(void) const;
+
+  private:
+    std::vector<Node *> theNodes;
+    std::vector<int> offset;       // first dof of each node in the blocks
+    int numDOF;                    // length of each block
+    std::vector<double> values;    // the NumQuantities blocks
+
+    std::vector<Node *> exactNodes;  // the nodes of class Node and their
+    std::vector<int> runStart;       // dofs, as runs of consecutive dofs
+    std::vector<int> runSize;
+    std::vector<Node *> otherNodes;  // the nodes of a subclass
+};
+
+#endif
@@ -43,6 +43,7 @@
 #include <Renderer.h>
 #include <string.h>
 #include <Information.h>
+#include <NodalStateStore.h>
 #include <Parameter.h>
 
 // AddingSensitivity:BEGIN //////////////////////////
@@ -229,7 +230,7 @@ Node::Node(int theClassTag)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0), 
  incrDeltaDisp(0),
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), stateInStore(false), load(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
  index(-1), reaction(0), displayLocation(0), temperature(0)
 #ifdef _CSS
@@ -256,7 +257,7 @@ Node::Node(int tag, int theClassTag)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), stateInStore(false), load(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
   R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
  index(-1), reaction(0), displayLocation(0), temperature(0)
 #ifdef _CSS
@@ -282,7 +283,7 @@ Node::Node(int tag, int ndof, double Crd1, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), stateInStore(false), load(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
  index(-1), reaction(0), displayLocation(0), temperature(0)
 #ifdef _CSS
@@ -316,7 +317,7 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), stateInStore(false), load(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
  reaction(0), displayLocation(0), temperature(0)
 #ifdef _CSS
@@ -353,7 +354,7 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), stateInStore(false), load(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
  reaction(0), displayLocation(0), temperature(0)
 #ifdef _CSS
@@ -391,7 +392,7 @@ Node::Node(const Node &otherNode, bool copyMass)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), stateInStore(false), load(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
    reaction(0), displayLocation(0), temperature(0)
 #ifdef _CSS
@@ -422,8 +423,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for displacement\n";
       exit(-1);
     }
-    for (int i=0; i<4*numberDOF; i++)
-      disp[i] = otherNode.disp[i];
+    for (int k=0; k<4; k++)
+      for (int i=0; i<numberDOF; i++)
+	disp[i+k*stateStride] = otherNode.disp[i+k*otherNode.stateStride];
   }    
   
   if (otherNode.commitVel != 0) {
@@ -431,8 +433,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for velocity\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      vel[i] = otherNode.vel[i];
+    for (int k=0; k<2; k++)
+      for (int i=0; i<numberDOF; i++)
+	vel[i+k*stateStride] = otherNode.vel[i+k*otherNode.stateStride];
   }    
   
   if (otherNode.commitAccel != 0) {
@@ -440,8 +443,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for acceleration\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      accel[i] = otherNode.accel[i];
+    for (int k=0; k<2; k++)
+      for (int i=0; i<numberDOF; i++)
+	accel[i+k*stateStride] = otherNode.accel[i+k*otherNode.stateStride];
   }    
   
   
@@ -525,15 +529,20 @@ Node::~Node()
     
     if (unbalLoad != 0)
 	delete unbalLoad;
+    if (load != 0)
+	delete [] load;
     
-    if (disp != 0)
+    // the arrays of a node in a NodalStateStore belong to the store
+    if (stateInStore == false) {
+      if (disp != 0)
 	delete [] disp;
 
-    if (vel != 0)
+      if (vel != 0)
 	delete [] vel;
 
-    if (accel != 0)
+      if (accel != 0)
 	delete [] accel;
+    }
 
     if (mass != 0)
 	delete mass;
@@ -752,8 +761,8 @@ Node::setTrialDisp(double value, int dof)
     // perform the assignment .. we dont't go through Vector interface
     // as we are sure of size and this way is quicker
     double tDisp = value;
-    disp[dof+2*numberDOF] = tDisp - disp[dof+numberDOF];
-    disp[dof+3*numberDOF] = tDisp - disp[dof];	
+    disp[dof+2*stateStride] = tDisp - disp[dof+stateStride];
+    disp[dof+3*stateStride] = tDisp - disp[dof];	
     disp[dof] = tDisp;
 
     return 0;
@@ -783,8 +792,8 @@ Node::setTrialDisp(const Vector &newTrialDisp)
     // as we are sure of size and this way is quicker
     for (int i=0; i<numberDOF; i++) {
         double tDisp = newTrialDisp(i);
-	disp[i+2*numberDOF] = tDisp - disp[i+numberDOF];
-	disp[i+3*numberDOF] = tDisp - disp[i];	
+	disp[i+2*stateStride] = tDisp - disp[i+stateStride];
+	disp[i+3*stateStride] = tDisp - disp[i];	
 	disp[i] = tDisp;
     }
 
@@ -859,8 +868,8 @@ Node::incrTrialDisp(const Vector &incrDispl)
 	for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] = incrDispI;
-	  disp[i+2*numberDOF] = incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] = incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
 	}
 	return 0;
     }
@@ -869,8 +878,8 @@ Node::incrTrialDisp(const Vector &incrDispl)
     for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] += incrDispI;
-	  disp[i+2*numberDOF] += incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] += incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
     }
 
     return 0;
@@ -1107,9 +1116,9 @@ Node::commitState()
 #endif // _CSS
     if (trialDisp != 0) {
       for (int i=0; i<numberDOF; i++) {
-	disp[i+numberDOF] = disp[i];  
-        disp[i+2*numberDOF] = 0.0;
-        disp[i+3*numberDOF] = 0.0;
+	disp[i+stateStride] = disp[i];  
+        disp[i+2*stateStride] = 0.0;
+        disp[i+3*stateStride] = 0.0;
       }
     }		    
     
@@ -1119,7 +1128,7 @@ Node::commitState()
 		lastCommitVel = *commitVel;
 #endif // _CSS
 		for (int i=0; i<numberDOF; i++)
-	vel[i+numberDOF] = vel[i];
+	vel[i+stateStride] = vel[i];
     }
     
     // check accel exists, if does set commit = trial        
@@ -1128,7 +1137,7 @@ Node::commitState()
 		lastCommitAccel = *commitAccel;
 #endif // _CSS
 		for (int i=0; i<numberDOF; i++)
-	accel[i+numberDOF] = accel[i];
+	accel[i+stateStride] = accel[i];
     }
 
 #ifdef _CSS
@@ -1149,22 +1158,22 @@ Node::revertToLastCommit()
     // check disp exists, if does set trial = last commit, incr = 0
     if (disp != 0) {
       for (int i=0 ; i<numberDOF; i++) {
-	disp[i] = disp[i+numberDOF];
-	disp[i+2*numberDOF] = 0.0;
-	disp[i+3*numberDOF] = 0.0;
+	disp[i] = disp[i+stateStride];
+	disp[i+2*stateStride] = 0.0;
+	disp[i+3*stateStride] = 0.0;
       }
     }
     
     // check vel exists, if does set trial = last commit
     if (vel != 0) {
       for (int i=0 ; i<numberDOF; i++)
-	vel[i] = vel[numberDOF+i];
+	vel[i] = vel[stateStride+i];
     }
 
     // check accel exists, if does set trial = last commit
     if (accel != 0) {    
       for (int i=0 ; i<numberDOF; i++)
-	accel[i] = accel[numberDOF+i];
+	accel[i] = accel[stateStride+i];
     }
 
     // if we get here we are done
@@ -1177,20 +1186,23 @@ Node::revertToStart()
 {
     // check disp exists, if does set all to zero
     if (disp != 0) {
-      for (int i=0 ; i<4*numberDOF; i++)
-	disp[i] = 0.0;
+      for (int k=0; k<4; k++)
+	for (int i=0 ; i<numberDOF; i++)
+	  disp[i+k*stateStride] = 0.0;
     }
 
     // check vel exists, if does set all to zero
     if (vel != 0) {
-      for (int i=0 ; i<2*numberDOF; i++)
-	vel[i] = 0.0;
+      for (int k=0; k<2; k++)
+	for (int i=0 ; i<numberDOF; i++)
+	  vel[i+k*stateStride] = 0.0;
     }
 
     // check accel exists, if does set all to zero
     if (accel != 0) {    
-      for (int i=0 ; i<2*numberDOF; i++)
-	accel[i] = 0.0;
+      for (int k=0; k<2; k++)
+	for (int i=0 ; i<numberDOF; i++)
+	  accel[i+k*stateStride] = 0.0;
     }
     
     if (unbalLoad != 0) 
@@ -1642,7 +1654,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantities equal to committed
       for (int i=0; i<numberDOF; i++)
-	disp[i] = disp[i+numberDOF];  // set trial equal commited
+	disp[i] = disp[i+stateStride];  // set trial equal commited
 
     } else if (commitDisp != 0) {
       // if going back to initial we will just zero the vectors
@@ -1664,7 +1676,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantity
       for (int i=0; i<numberDOF; i++)
-	vel[i] = vel[i+numberDOF];  // set trial equal commited
+	vel[i] = vel[i+stateStride];  // set trial equal commited
     }
 
     if (data(4) == 0) {
@@ -1680,7 +1692,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
       
       // set the trial values
       for (int i=0; i<numberDOF; i++)
-	accel[i] = accel[i+numberDOF];  // set trial equal commited
+	accel[i] = accel[i+stateStride];  // set trial equal commited
     }
 
     if (data(5) == 0) {
@@ -1885,6 +1897,7 @@ Node::createDisp(void)
 {
   // trial , committed, incr = (committed-trial)
   disp = new double[4*numberDOF];
+  stateStride = numberDOF;
     
   if (disp == 0) {
     opserr << "WARNING - Node::createDisp() ran out of memory for array of size " << 2*numberDOF << endln;
@@ -1913,6 +1926,7 @@ int
 Node::createVel(void)
 {
     vel = new double[2*numberDOF];
+    stateStride = numberDOF;
     
     if (vel == 0) {
       opserr << "WARNING - Node::createVel() ran out of memory for array of size " << 2*numberDOF << endln;
@@ -1937,6 +1951,7 @@ int
 Node::createAccel(void)
 {
     accel = new double[2*numberDOF];
+    stateStride = numberDOF;
     
     if (accel == 0) {
       opserr << "WARNING - Node::createAccel() ran out of memory for array of size " << 2*numberDOF << endln;
@@ -1957,6 +1972,104 @@ Node::createAccel(void)
 }
 
 
+int
+Node::moveState(double *store, int stride)
+{
+    if (numberDOF == 0)
+      return 0;
+
+    double *newDisp, *newVel, *newAccel;
+    int newStride;
+    if (store != 0) {
+      newDisp = store;
+      newVel = store + NodalStateStore::TrialVel*stride;
+      newAccel = store + NodalStateStore::TrialAccel*stride;
+      newStride = stride;
+    } else {
+      newDisp = new double[4*numberDOF];
+      newVel = new double[2*numberDOF];
+      newAccel = new double[2*numberDOF];
+      newStride = numberDOF;
+    }
+
+    // copy the values, zero for quantities not yet formed
+    for (int i=0; i<numberDOF; i++) {
+      for (int k=0; k<4; k++)
+	newDisp[i+k*newStride] = (disp != 0) ? disp[i+k*stateStride] : 0.0;
+      for (int k=0; k<2; k++) {
+	newVel[i+k*newStride] = (vel != 0) ? vel[i+k*stateStride] : 0.0;
+	newAccel[i+k*newStride] = (accel != 0) ? accel[i+k*stateStride] : 0.0;
+      }
+    }
+
+    if (stateInStore == false) {
+      if (disp != 0)
+	delete [] disp;
+      if (vel != 0)
+	delete [] vel;
+      if (accel != 0)
+	delete [] accel;
+    }
+
+    disp = newDisp;
+    vel = newVel;
+    accel = newAccel;
+    stateStride = newStride;
+    stateInStore = (store != 0);
+
+    // point the Vectors at the new arrays, keeping the objects that
+    // references may have been taken to
+    if (trialDisp == 0) {
+      trialDisp = new Vector(disp, numberDOF);
+      commitDisp = new Vector(&disp[stateStride], numberDOF);
+      incrDisp = new Vector(&disp[2*stateStride], numberDOF);
+      incrDeltaDisp = new Vector(&disp[3*stateStride], numberDOF);
+    } else {
+      trialDisp->setData(disp, numberDOF);
+      commitDisp->setData(&disp[stateStride], numberDOF);
+      incrDisp->setData(&disp[2*stateStride], numberDOF);
+      incrDeltaDisp->setData(&disp[3*stateStride], numberDOF);
+    }
+
+    if (trialVel == 0) {
+      trialVel = new Vector(vel, numberDOF);
+      commitVel = new Vector(&vel[stateStride], numberDOF);
+    } else {
+      trialVel->setData(vel, numberDOF);
+      commitVel->setData(&vel[stateStride], numberDOF);
+    }
+
+    if (trialAccel == 0) {
+      trialAccel = new Vector(accel, numberDOF);
+      commitAccel = new Vector(&accel[stateStride], numberDOF);
+    } else {
+      trialAccel->setData(accel, numberDOF);
+      commitAccel->setData(&accel[stateStride], numberDOF);
+    }
+
+    // the unbalanced load, also keeping its Vector; out of the store
+    // the values are held in the node's own load array
+    if (store != 0 || unbalLoad != 0) {
+      double *newLoad;
+      if (store != 0)
+	newLoad = store + NodalStateStore::UnbalLoad*stride;
+      else
+	newLoad = new double[numberDOF];
+      for (int i=0; i<numberDOF; i++)
+	newLoad[i] = (unbalLoad != 0) ? (*unbalLoad)(i) : 0.0;
+      if (unbalLoad == 0)
+	unbalLoad = new Vector(newLoad, numberDOF);
+      else
+	unbalLoad->setData(newLoad, numberDOF);
+      if (load != 0)
+	delete [] load;
+      load = (store != 0) ? 0 : newLoad;
+    }
+
+    return 0;
+}
+
+
 // AddingSensitivity:BEGIN ///////////////////////////////////////
 
 Matrix
@@ -49,6 +49,7 @@ class Renderer;
 
 class DOF_Group;
 class NodalThermalAction; //L.Jiang [ SIF ]
+class NodalStateStore;
 
 #ifdef _CSS
 class TimeSeries;
@@ -202,12 +203,19 @@ class Node : public DomainComponent
 #endif // _CSS
 
    private:
+    friend class NodalStateStore;
+
     // priavte methods used to create the Vector objects 
     // for the committed and trial response quantities.
     int createDisp(void);
     int createVel(void);
     int createAccel(void); 
 
+    // private method to move the response quantities into the blocks of
+    // a NodalStateStore, quantity q of dof i at store[q*stride+i], or
+    // back to arrays owned by the node if store is 0
+    int moveState(double *store, int stride);
+
     // private method to set up global matrices
     int setGlobalMatrices();
 
@@ -229,6 +237,9 @@ class Node : public DomainComponent
 
     double *disp, *vel, *accel; // double arrays holding the displ, 
                                 // vel and accel values
+    int stateStride;            // distance between the quantities in them
+    bool stateInStore;          // arrays belong to a NodalStateStore
+    double *load;               // values of unbalLoad once out of a store
 
     int dbTag1, dbTag2, dbTag3, dbTag4; // needed for database
     Matrix *R;                          // nodal participation matrix
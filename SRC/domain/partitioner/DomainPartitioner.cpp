@@ -61,6 +61,7 @@
 //#include <Timer.h>
 
 #include <MapOfTaggedObjects.h>
+#include <Domain.h>
 
 #include <FileStream.h>
 
@@ -128,7 +129,8 @@ typedef MAP_ID::iterator     MAP_ID_ITERATOR;
 DomainPartitioner::DomainPartitioner(GraphPartitioner &theGraphPartitioner)
   :  myDomain(0), thePartitioner(theGraphPartitioner), theBalancer(0),
  theElementGraph(0), theBoundaryElements(0), 
- theNodeLocations(0),elementPlace(0), numPartitions(0), partitionFlag(false), usingMainDomain(false)
+ theNodeLocations(0),elementPlace(0), numPartitions(0), partitionFlag(false), usingMainDomain(false),
+ numSwapped(0)
 {
 
 }    
@@ -137,7 +139,8 @@ DomainPartitioner::DomainPartitioner(GraphPartitioner &theGraphPartitioner,
 				     LoadBalancer &theLoadBalancer)
   :  myDomain(0), thePartitioner(theGraphPartitioner), theBalancer(&theLoadBalancer),
  theElementGraph(0), theBoundaryElements(0),
- theNodeLocations(0),elementPlace(0), numPartitions(0), partitionFlag(false), usingMainDomain(false)
+ theNodeLocations(0),elementPlace(0), numPartitions(0), partitionFlag(false), usingMainDomain(false),
+ numSwapped(0)
 {
     // set the links the loadBalancer needs
     theLoadBalancer.setLinks(*this);
@@ -145,13 +148,41 @@ DomainPartitioner::DomainPartitioner(GraphPartitioner &theGraphPartitioner,
 
 
 DomainPartitioner::~DomainPartitioner()
+{
+  this->clearGraphs();
+}
+
+
+// the boundary graphs hold vertices of the element graph, which are
+// removed from them before they are deleted
+void
+DomainPartitioner::clearGraphs(void)
 {
   if (theBoundaryElements != 0) {
     for (int i=0; i<numPartitions; i++)
-      if (theBoundaryElements[i] != 0)
-	delete theBoundaryElements[i];
+      if (theBoundaryElements[i] != 0) {
+	Graph *theBoundary = theBoundaryElements[i];
+	ID vertexTags(0, theBoundary->getNumVertex());
+	VertexIter &theVertices = theBoundary->getVertices();
+	Vertex *vertexPtr;
+	while ((vertexPtr = theVertices()) != 0)
+	  vertexTags[vertexTags.Size()] = vertexPtr->getTag();
+	for (int j=0; j<vertexTags.Size(); j++)
+	  theBoundary->removeVertex(vertexTags(j), false);
+	delete theBoundary;
+      }
     delete []theBoundaryElements;
   }
+  theBoundaryElements = 0;
+
+  if (theElementGraph != 0)
+    delete theElementGraph;
+  theElementGraph = 0;
+
+  elementVertices.clear();
+  elementNodes.clear();
+  nodeSPs.clear();
+  constrainedNodes.clear();
 }
 
 
@@ -188,7 +219,10 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
   //    Graph &theEleGraph = myDomain->getElementGraph();
   //    theElementGraph = new Graph(myDomain->getElementGraph());
 
-  theElementGraph = &(myDomain->getElementGraph());
+  // the partitioner keeps its own copy of the element graph, the one of
+  // the domain going as the elements are moved
+  this->clearGraphs();
+  theElementGraph = new Graph(myDomain->getElementGraph());
 
   int theError = thePartitioner.partition(*theElementGraph, numParts);
 
@@ -249,9 +283,6 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
   // we do not invoke the destructor on the individual graphs as 
   // this would invoke the destructor on the individual vertices
 
-  if (theBoundaryElements != 0)
-    delete [] theBoundaryElements;
-  
   theBoundaryElements = new Graph * [numParts];
   if (theBoundaryElements == 0) {
     opserr << "DomainPartitioner::partition(int numParts)";
@@ -339,6 +370,8 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     //Also for each element, transverse its connected nodes
     Element *elePtr = myDomain->getElement(eleTag);
     const ID &nodes = elePtr->getExternalNodes();
+    elementVertices[eleTag] = vertexPtr->getTag();
+    elementNodes[eleTag] = nodes;
     size = nodes.Size();
     for (int j=0; j<size; j++) {
       int nodeTag = nodes(j);
@@ -380,6 +413,8 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     
     NodeLocations *theRetainedLocation = (NodeLocations *)theRetainedObject;
     NodeLocations *theConstrainedLocation = (NodeLocations *)theConstrainedObject;
+    constrainedNodes.insert(retained);
+    constrainedNodes.insert(constrained);
 
     ID &theConstrainedNodesPartitions = theConstrainedLocation->nodePartitions;
     int numPartitions = theConstrainedNodesPartitions.Size();
@@ -567,6 +602,7 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     SP_Constraint *spPtr;
     while ((spPtr = theSPs()) != 0) {
       int nodeTag = spPtr->getNodeTag();
+      constrainedNodes.insert(nodeTag);
       
       TaggedObject *theTaggedObject = theNodeLocations->getComponentPtr(nodeTag);
       if (theTaggedObject == 0) {
@@ -620,6 +656,7 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
   SP_Constraint *spPtr;
   while ((spPtr = theDomainSP()) != 0) {
     int nodeTag = spPtr->getNodeTag();
+    nodeSPs[nodeTag].push_back(spPtr);
 
     TaggedObject *theTaggedObject = theNodeLocations->getComponentPtr(nodeTag);
     if (theTaggedObject == 0) {
@@ -731,31 +768,35 @@ DomainPartitioner::balance(Graph &theWeightedPGraph)
 
     if (theBalancer != 0) {
 
-	// call on the LoadBalancer to partition		
+	// weigh the elements with their measured cost, so that the weights
+	// of the partitions change as the elements are moved
+	SubdomainIter &theSubs = myDomain->getSubdomains();
+	Subdomain *theSub;
+	while ((theSub = theSubs()) != 0) {
+	  ID eleTags(0);
+	  Vector costs(0);
+	  int numEle = theSub->getElementCosts(eleTags, costs);
+	  for (int i=0; i<numEle; i++) {
+	    std::map<int, int>::iterator theVertex = elementVertices.find(eleTags(i));
+	    if (theVertex != elementVertices.end() && costs(i) > 0.0)
+	      theElementGraph->getVertexPtr(theVertex->second)->setWeight(costs(i));
+	  }
+	}
 
-    // timer.start();
-    // If we have a balancer, then call the balance function
+	// call on the LoadBalancer to partition		
+	numSwapped = 0;
 	res = theBalancer->balance(theWeightedPGraph);
 	    
-	// now invoke domainChanged on Subdomains and PartitionedDomain
-    // { 
-
-
-      // All domains are informed that there has been a domain change
-	SubdomainIter &theSubDomains = myDomain->getSubdomains();
-	Subdomain *theSubDomain;
-
-	while ((theSubDomain = theSubDomains()) != 0) 
-	  theSubDomain->domainChange();
-        myDomain->domainChange();
-	
-	// we invoke change on the PartitionedDomain
-
-      // if(res > 0)
-      // {
-        // fid << myDomain->getCurrentTime() << " " << timer.getReal() << endln;
-      // }
-    // }
+	// if elements were moved, all domains are informed that there has
+	// been a domain change
+	if (numSwapped != 0) {
+	  SubdomainIter &theSubDomains = myDomain->getSubdomains();
+	  Subdomain *theSubDomain;
+
+	  while ((theSubDomain = theSubDomains()) != 0) 
+	    theSubDomain->domainChange();
+	  myDomain->domainChange();
+	}
     }
   else
   {
@@ -795,6 +836,10 @@ DomainPartitioner::getColoredGraph(void)
       opserr << " - No domain has been set";
       exit(0);
     }
+
+    // once partitioned, the graph colored with the partitions
+    if (theElementGraph != 0)
+      return *theElementGraph;
     
     return myDomain->getElementGraph();
 }
@@ -804,17 +849,18 @@ int
 DomainPartitioner::swapVertex(int from, int to, int vertexTag,
 			      bool adjacentVertexNotInOther)
 {
-  opserr << "DomainPartitioner::swapVertex() " << from << " " << to << " " << vertexTag << endln;
-
-  /*
   // check that the object did the partitioning
   if (partitionFlag == false) {
-    opserr << "DomainPartitioner::balance(const Vector &load)";
+    opserr << "DomainPartitioner::swapVertex()";
     opserr << " - not partitioned or DomainPartitioner did not partition\n";
     return -1;
   }
-  
-  // check that the subdomain exist in partitioned domain
+
+  // the elements of the main domain are not moved
+  if (from == to || from == mainPartition || to == mainPartition)
+    return -1;
+
+  // check that the subdomains exist in partitioned domain
   Subdomain *fromSubdomain = myDomain->getSubdomainPtr(from);
   if (fromSubdomain == 0) {
     opserr << "DomainPartitioner::swapVertex - No from Subdomain: ";
@@ -826,34 +872,25 @@ DomainPartitioner::swapVertex(int from, int to, int vertexTag,
     opserr << "DomainPartitioner::swapVertex - No to Subdomain: ";
     opserr << to << " exists\n";
     return -3;
-  }    
-  
-  // remove the vertex from the boundary if there
-  // if not there we have to get a pointer to it from the ele graph.
-  
-  //    Graph &theEleGraph = myDomain->getElementGraph();    
+  }
+
   Graph *fromBoundary = theBoundaryElements[from-1];
   Graph *toBoundary = theBoundaryElements[to-1];    
-  Vertex *vertexPtr;
-  
+
   // get a pointer to the vertex in the element graph
-  if (adjacentVertexNotInOther  == false) {
-    vertexPtr = fromBoundary->removeVertex(vertexTag,false);    
-    if (vertexPtr == 0) 
-      vertexPtr = theElementGraph->getVertexPtr(vertexTag);
-
-    if (vertexPtr == 0)  // if still 0 no vertex given by tag exists
-      return -4;
-  } else { // get a pointer and check vertex not adjacent to another partition
-    vertexPtr = fromBoundary->getVertexPtr(vertexTag);    
-    if (vertexPtr == 0) 
-      vertexPtr = theElementGraph->getVertexPtr(vertexTag);
-    if (vertexPtr == 0)  // if still 0 no vertex given by tag exists
-      return -4;	
-    const ID &adjacent = vertexPtr->getAdjacency();
+  Vertex *vertexPtr = fromBoundary->getVertexPtr(vertexTag);    
+  if (vertexPtr == 0) 
+    vertexPtr = theElementGraph->getVertexPtr(vertexTag);
+  if (vertexPtr == 0 || vertexPtr->getColor() != from)
+    return -4;
+
+  const ID &adjacent = vertexPtr->getAdjacency();
+  int adjacentSize = adjacent.Size();
+
+  // check vertex adjacent to to and not to another partition
+  if (adjacentVertexNotInOther == true) {
     bool inTo = false;
     bool inOther = false;
-    int adjacentSize = adjacent.Size();
     for (int i=0; i<adjacentSize; i++) {
       Vertex *other = theElementGraph->getVertexPtr(adjacent(i));
       if (other->getColor() == to) 
@@ -863,658 +900,320 @@ DomainPartitioner::swapVertex(int from, int to, int vertexTag,
 	i = adjacentSize;
       }
     }
-    if (inTo != true || inOther == true) // we cannot remove the vertex
+    if (inTo != true || inOther == true) // we cannot move the vertex
       return -5;
-    // if can remove the vertex from the fromBoundary
-    Vertex *theVertex = fromBoundary->removeVertex(vertexTag,false);
   }
-  
+
   int eleTag = vertexPtr->getRef();
-  
-  //
-  // in the FROM subdomain we:
-  //  1. remove the element
-  //  2. remove all nodes connected to the element divide color by prime
-  //  3. see if have to add nodes back as external
-  //  4. remove from the PartitionedDomain if node was external
-  //  5. add new elements to the boundary vertices for from
-  
-  //  1. remove the element from the fromSubdomain
-    //          this gives us a pointer to the element as well.
-
-    Element *elePtr = fromSubdomain->removeElement(eleTag);
-    if (elePtr == 0) // if ele not there we can just return but ERROR it should be
-  return -6;
-
-    //  2. remove all nodes connected to the element divide color by prime    
-    //  3. add back if still in subdomain
-    //  4. if node external remove from PartitionedDomains external nodes
-    int primeFrom = primes(from);
-    const ID  &nodes1 = elePtr->getExternalNodes(); // create a copy, need after send ele
-    ID  nodes(nodes1);
-
-    int nodesSize = nodes.Size();
-    Node **nodesArray = new Node *[nodesSize];
-    for (int i=0; i<nodesSize; i++) {
-  int nodeTag = nodes(i);
-
-  // remove the node
-  Node *nodePtr = fromSubdomain->removeNode(nodeTag);
-
-  (*nodePlace)(nodeTag) /= primeFrom;
-  nodesArray[i] = nodePtr;
-        // opserr << "DomainPartitioner::swapVertex -NODE " << *nodePtr;
-  // add back as external if still needed
-  if ((*nodePlace)(nodeTag)%primeFrom == 0)
-      fromSubdomain->addExternalNode(nodePtr);
-
-  // if it was external remove from PartitionedDomains external nodes
-  int partition = (*nodePlace)(nodeTag);
-  for (int j=1; j<=numPartitions; j++) 
-      if (j != from) {
-    int prime = primes(j);
-    if (partition%prime == 0) {
-        myDomain->removeExternalNode(nodeTag);
-        j = numPartitions+1;
-    }
+  std::map<int, ID>::iterator theEleNodes = elementNodes.find(eleTag);
+  if (theEleNodes == elementNodes.end())
+    return -6;
+
+  const ID &nodes = theEleNodes->second;
+  int numNodes = nodes.Size();
+
+  // elements at nodes with MP_Constraints or SP_Constraints of a load
+  // pattern stay where they are, as do elements at nodes of the main domain
+  ID staysInFrom(numNodes);
+  for (int i=0; i<numNodes; i++) {
+    int nodeTag = nodes(i);
+    if (constrainedNodes.find(nodeTag) != constrainedNodes.end())
+      return -7;
+    NodeLocations *theLocation = (NodeLocations *)theNodeLocations->getComponentPtr(nodeTag);
+    if (theLocation == 0 || theLocation->nodePartitions.getLocation(mainPartition) >= 0)
+      return -7;
+
+    // the node stays in from if another element of from is connected to it
+    staysInFrom(i) = 0;
+    for (int a=0; a<adjacentSize && staysInFrom(i) == 0; a++) {
+      Vertex *other = theElementGraph->getVertexPtr(adjacent(a));
+      if (other->getColor() == from) {
+	std::map<int, ID>::iterator otherNodes = elementNodes.find(other->getRef());
+	if (otherNodes != elementNodes.end() && otherNodes->second.getLocation(nodeTag) >= 0)
+	  staysInFrom(i) = 1;
       }
     }
+  }
 
-    // 5. add new elements to boundary vertices of from if connected to
-    //    vertex we just removed and of color of from and not already in boundary
-
-    const ID &eleAdjacent = vertexPtr->getAdjacency();
-    int eleAdjacentSize = eleAdjacent.Size();
-
-    for (int a=0; a<eleAdjacentSize; a++) {
-	int otherEleVertexTag = eleAdjacent(a);
-	Vertex *other = fromBoundary->getVertexPtr(otherEleVertexTag);
-	if (other == 0) {
-	    other = theElementGraph->getVertexPtr(otherEleVertexTag);
-	    if (other->getColor() == from)
-		fromBoundary->addVertex(other,false);
+  // remove the element from from, its state coming with it
+  Element *elePtr = fromSubdomain->removeElement(eleTag);
+  if (elePtr == 0)
+    return -8;
+
+  // move the nodes; a node removed from a subdomain is a copy if it is
+  // external, the node of the main domain remaining, and the node itself
+  // if it is internal. where the node object of from or to is replaced,
+  // the elements there connected to it still hold the old one; they are
+  // noted and set up again below, and the old nodes deleted after
+  ID replacedInFrom(0, numNodes);
+  ID replacedInTo(0, numNodes);
+  std::vector<Node *> oldNodes;
+  for (int i=0; i<numNodes; i++) {
+    int nodeTag = nodes(i);
+    NodeLocations *theLocation = (NodeLocations *)theNodeLocations->getComponentPtr(nodeTag);
+    bool inTo = (theLocation->nodePartitions.getLocation(to) >= 0);
+    int numLocations = theLocation->numPartitions;
+
+    std::vector<SP_Constraint *> theSPs;
+    std::map<int, std::vector<SP_Constraint *> >::iterator theNodeSPs = nodeSPs.find(nodeTag);
+    if (theNodeSPs != nodeSPs.end())
+      theSPs = theNodeSPs->second;
+    int numSPs = theSPs.size();
+
+    if (staysInFrom(i) == 1) {
+      if (inTo == true)
+	continue;
+
+      if (numLocations == 1) {
+	// an internal node of from becomes external to from and to, the
+	// constraints from has on it staying
+	Node *nodePtr = fromSubdomain->removeNode(nodeTag);
+	myDomain->Domain::addNode(nodePtr);
+	fromSubdomain->addExternalNode(nodePtr);
+	toSubdomain->addExternalNode(nodePtr);
+	replacedInFrom[replacedInFrom.Size()] = nodeTag;
+	for (int j=0; j<numSPs; j++) {
+	  myDomain->Domain::addSP_Constraint(theSPs[j]);
+	  toSubdomain->addSP_Constraint(theSPs[j]);
 	}
-    }
-
+      } else {
+	toSubdomain->addExternalNode(myDomain->Domain::getNode(nodeTag));
+	for (int j=0; j<numSPs; j++)
+	  toSubdomain->addSP_Constraint(theSPs[j]);
+      }
 
-    
-    // in the TO subdomain we:
-    //  1. remove all nodes connected to the element, may or may not be there
-    //     if there don't divide by primeTo. 
-    //  2. mark all connecting nodes of elements as belonging to To
-    //  3. add the nodes, checking if external or internal
-    //  3. add the element
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of boundary
-    //     of boundary of to vertices
-
-    //  1. remove all nodes connected to the element, may or may not be there
-    //      if there divide by primeTo, do this as may have been added as extnl
-    int primeTo = primes(to);
-    for (int l=0; l<nodesSize; l++) {    
-  int nodeTag = nodesArray[l]->getTag();
-  int nodeColor = (*nodePlace)(nodeTag);
-  if (nodeColor % primeTo == 0) {
-      Node *nodePtr;
-      nodePtr = toSubdomain->removeNode(nodes(l));
-  }
+      theLocation->addPartition(to);
+      continue;
     }
 
-
-    for (int m=0; m<nodesSize; m++) {
-  Node *nodePtr = nodesArray[m];
-  int nodeTag = nodePtr->getTag();
-  
-  //  2. mark all connecting nodes of elements as belonging to To      
-  (*nodePlace)(nodeTag) *= primeTo;
-
-  //  3. add the nodes, checking if external or internal  
-  int internal = 0;
-  for (int n=1; n<=numPartitions; n++) 
-      if (n != to) {
-    int prime = primes(n);
-    if ((*nodePlace)(nodeTag)%prime == 0) { // its external
-        internal = 1;
-        n = numPartitions+1;
-    }
-      }
-  
-  if (internal == 0)
+    // from no longer has the node
+    Node *fromNode = fromSubdomain->removeNode(nodeTag);
+    for (int j=0; j<numSPs; j++)
+      fromSubdomain->removeSP_Constraint(theSPs[j]->getTag());
+
+    if (numLocations == 1) {
+      // an internal node of from becomes an internal node of to
+      toSubdomain->addNode(fromNode);
+      for (int j=0; j<numSPs; j++)
+	toSubdomain->addSP_Constraint(theSPs[j]);
+      theLocation->addPartition(to);
+
+    } else if (inTo == true && numLocations == 2) {
+      // an external node becomes an internal node of to
+      if (fromNode != 0)
+	oldNodes.push_back(fromNode);
+      Node *toNode = toSubdomain->removeNode(nodeTag);
+      if (toNode != 0)
+	oldNodes.push_back(toNode);
+      replacedInTo[replacedInTo.Size()] = nodeTag;
+      for (int j=0; j<numSPs; j++)
+	myDomain->Domain::removeSP_Constraint(theSPs[j]->getTag());
+      Node *nodePtr = myDomain->removeExternalNode(nodeTag);
       toSubdomain->addNode(nodePtr);
-  else {
-      toSubdomain->addExternalNode(nodePtr);
-      myDomain->addNode(nodePtr);
-  }
-    }
-
-    delete [] nodesArray; // DELETE nodesArray here should not use nodePtrs
-                          // after here as node objects deleted if parallel    
-    
-    //  3. add the element
-    
-    toSubdomain->addElement(elePtr);
-    
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of to's boundary vertices
-
-
-    vertexPtr->setColor(to);
-    toBoundary->addVertex(vertexPtr,false);
-
-    for (int n=0; n<eleAdjacentSize; n++) {
-	int otherEleVertexTag = eleAdjacent(n);
-	Vertex *other = toBoundary->removeVertex(otherEleVertexTag,false);
-	if (other != 0) {
-	    const ID &othersAdjacency = other->getAdjacency();
-	    int otherSize = othersAdjacency.Size();
-	    for (int b=0; b<otherSize; b++) {
-		int anotherEleVertexTag = othersAdjacency(b);
-		Vertex *otherOther = theElementGraph->getVertexPtr(anotherEleVertexTag);
-		if (otherOther->getColor() != to) {
-		    toBoundary->addVertex(other,false);
-		    b=otherSize;
-		}
-	    }
-	}
+      moveNodalLoads(nodeTag, *myDomain, *toSubdomain);
+
+    } else {
+      // the node stays external
+      if (fromNode != 0)
+	oldNodes.push_back(fromNode);
+      if (inTo == false) {
+	toSubdomain->addExternalNode(myDomain->Domain::getNode(nodeTag));
+	for (int j=0; j<numSPs; j++)
+	  toSubdomain->addSP_Constraint(theSPs[j]);
+	theLocation->addPartition(to);
+      }
     }
 
+    // the loads on the node that from held go with it
+    moveNodalLoads(nodeTag, *fromSubdomain, *toSubdomain);
 
-    // now remove any SP_Constraints that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    SP_ConstraintIter &theSPs = myDomain->getSPs();
-    SP_Constraint *spPtr;
-    while ((spPtr = theSPs()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
-      }
-        }
-    if (internal == 0) { // add to toSubdomain if inteernal
-        myDomain->removeSP_Constraint(spPtr->getTag());
-        toSubdomain->addSP_Constraint(spPtr);
-    }
-      }
+    theLocation->nodePartitions.removeValue(from);
+    theLocation->numPartitions--;
   }
-    }
 
-    
-    
-    // now remove any SP_Constraints that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-    SP_ConstraintIter &theSPs2 = fromSubdomain->getSPs();
-    while ((spPtr = theSPs2()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    fromSubdomain->removeSP_Constraint(spPtr->getTag());
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
+  // move the element and its loads
+  toSubdomain->addElement(elePtr);
+  moveElementalLoads(eleTag, *fromSubdomain, *toSubdomain);
+
+  // the elements holding a replaced node are removed and added again, so
+  // that setDomain() gives them the node now in their subdomain
+  if (replacedInFrom.Size() != 0 || replacedInTo.Size() != 0) {
+    for (int a=0; a<adjacentSize; a++) {
+      Vertex *other = theElementGraph->getVertexPtr(adjacent(a));
+      int color = other->getColor();
+      Subdomain *theSubdomain = 0;
+      const ID *replaced = 0;
+      if (color == from) {
+	theSubdomain = fromSubdomain;
+	replaced = &replacedInFrom;
+      } else if (color == to) {
+	theSubdomain = toSubdomain;
+	replaced = &replacedInTo;
+      } else
+	continue;
+
+      std::map<int, ID>::iterator otherNodes = elementNodes.find(other->getRef());
+      if (otherNodes == elementNodes.end())
+	continue;
+      bool holdsReplaced = false;
+      for (int j=0; j<replaced->Size() && holdsReplaced == false; j++)
+	if (otherNodes->second.getLocation((*replaced)(j)) >= 0)
+	  holdsReplaced = true;
+      if (holdsReplaced == false)
+	continue;
+
+      Element *otherPtr = theSubdomain->removeElement(other->getRef());
+      if (otherPtr == 0 || theSubdomain->addElement(otherPtr) == false) {
+	opserr << "DomainPartitioner::swapVertex - failed to set up element ";
+	opserr << other->getRef() << " again in subdomain " << color << endln;
+	return -9;
       }
-        }
-    if (internal == 0) 
-        toSubdomain->addSP_Constraint(spPtr);
-    else
-        myDomain->addSP_Constraint(spPtr);
-      }
-  }
     }
+  }
 
+  for (std::size_t i=0; i<oldNodes.size(); i++)
+    delete oldNodes[i];
 
-
-  */
-    /*
-    // now remove any NodalLoads that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    NodalLoadIter &theNodalLoads = myDomain->getNodalLoads();
-    NodalLoad *loadPtr;
-    while ((loadPtr = theNodalLoads()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
-      }
-        }
-    if (internal == 0) { // add to toSubdomain if inteernal
-        myDomain->removeNodalLoad(loadPtr->getTag());
-        toSubdomain->addNodalLoad(loadPtr);
-    }
-      }
+  // the elements of from connected to the vertex are now on its boundary
+  fromBoundary->removeVertex(vertexTag, false);
+  for (int a=0; a<adjacentSize; a++) {
+    int otherTag = adjacent(a);
+    Vertex *other = theElementGraph->getVertexPtr(otherTag);
+    if (other->getColor() == from && fromBoundary->getVertexPtr(otherTag) == 0)
+      fromBoundary->addVertex(other, false);
   }
-    }
-
 
-    // now remove any NodalLoads that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-
-    NodalLoadIter &theNodalLoads2 = myDomain->getNodalLoads();
-    while ((loadPtr = theNodalLoads2()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    fromSubdomain->removeNodalLoad(loadPtr->getTag());
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
+  // the vertex is on the boundary of to, and elements of to connected to
+  // it may no longer be
+  vertexPtr->setColor(to);
+  toBoundary->addVertex(vertexPtr, false);
+  for (int a=0; a<adjacentSize; a++) {
+    Vertex *other = toBoundary->removeVertex(adjacent(a), false);
+    if (other != 0) {
+      const ID &othersAdjacency = other->getAdjacency();
+      int otherSize = othersAdjacency.Size();
+      for (int b=0; b<otherSize; b++) {
+	Vertex *otherOther = theElementGraph->getVertexPtr(othersAdjacency(b));
+	if (otherOther->getColor() != to) {
+	  toBoundary->addVertex(other, false);
+	  b = otherSize;
+	}
       }
-        }
-    if (internal == 0) 
-        toSubdomain->addNodalLoad(loadPtr);
-    else
-        myDomain->addNodalLoad(loadPtr);
-      }  
-  }
     }
-    */
+  }
 
-    return 0;
+  numSwapped++;
 
+  return 0;
 }
 
 
-
 // method to move from from to to, all elements on the interface of 
 // from that are adjacent with to.
 
 int 
 DomainPartitioner::swapBoundary(int from, int to, bool adjacentVertexNotInOther)
-          
 {
-  opserr << "DomainPartitioner::swapBoundary: from "  << from << " to " << to << endln;
-  /***********************************************************************************
-    opserr << "DomainPartitioner::swapBoundary from " << from << "  to " << to << endln;
-    Timer timer;
-    timer.start();
-
-    // check that the object did the partitioning
-    if (partitionFlag == false) {
-  opserr << "DomainPartitioner::balance(const Vector &load)";
-  opserr << " - not partitioned or DomainPartitioner did not partition\n";
-  return -1;
-    }
-
-    // check that the subdomains exist in partitioned domain
-    Subdomain *fromSubdomain = myDomain->getSubdomainPtr(from);
-    if (fromSubdomain == 0) {
-  opserr << "DomainPartitioner::swapBoundary - No from Subdomain: ";
-  opserr << from << " exists\n";
-  return -2;
-    }
-
-    Subdomain *toSubdomain = myDomain->getSubdomainPtr(to);
-    if (toSubdomain == 0) {
-  opserr << "DomainPartitioner::swapBoundary - No to Subdomain: ";
-  opserr << to << " exists\n";
-  return -3;
-    }    
-
-    // get the element graph
-    //    Graph &theEleGraph = myDomain->getElementGraph();    
-    Graph *fromBoundary = theBoundaryElements[from-1];
-    Graph *toBoundary = theBoundaryElements[to-1];
-
-    // into a new graph place the vertices that are to be swapped
-    Graph *swapVertices = new Graph(fromBoundary->getNumVertex());
-
-    VertexIter &swappableVertices = fromBoundary->getVertices();
-    Vertex *vertexPtr;
-
-    while ((vertexPtr = swappableVertices()) != 0) {
-	if (adjacentVertexNotInOther == false) {   
-	    const ID &adjacency=vertexPtr->getAdjacency();
-	    int size = adjacency.Size();
-	    for (int i=0; i<size; i++) {
-		int otherTag = adjacency(i);
-		Vertex *otherVertex = toBoundary->getVertexPtr(otherTag);
-		if (otherVertex != 0) {
-		    swapVertices->addVertex(vertexPtr,false);
-		    i = size;
-		}
-	    }
-	}
-	else {
-	    const ID &adjacent = vertexPtr->getAdjacency();
-	    bool inTo = false;
-	    bool inOther = false;
-	    int adjacentSize = adjacent.Size();
-	    for (int i=0; i<adjacentSize; i++) {
-		Vertex *other = theElementGraph->getVertexPtr(adjacent(i));
-		if (other->getColor() == to) 
-		    inTo = true;
-		else if (other->getColor() != from) {
-		    inOther = true;
-		    i = adjacentSize;
-		}
-	    }
-	    if (inTo == true && inOther == false) { // we remove the vertex
-		swapVertices->addVertex(vertexPtr,false);
-		vertexPtr->setColor(to);
-	    }
-	}
-    }
-
-    //
-    // in the FROM subdomain we:
-    //  1. remove the elements corresponding to the vertices
-    //  2. remove all nodes connected to the elements divide color by prime
-    //  3. see if have to add nodes back as external
-    //  4. remove from the PartitionedDomain if node was external
-    //  5. add new elements to the boundary vertices for from
-
-    // 1. first remove all the elements from from subdomain
-    VertexIter &verticesToSwap = swapVertices->getVertices();
-
-    int numEleToSwap = swapVertices->getNumVertex();
-    Element **elementsArray = new Element *[numEleToSwap];
-
-    int count =0; 
-    int numCannotRemove =0;
-    for (int i=0; i<numEleToSwap; i++) {
-      vertexPtr = verticesToSwap();
-  if (vertexPtr == 0) 
-      return -1;
-
-  int vertexTag = vertexPtr->getTag();
-  int eleTag = vertexPtr->getRef();
-
-  // remove the vertex from fromBoundary, set color to to
-  // and add to toBoundary
-  bool inFrom = true;
-  vertexPtr = fromBoundary->removeVertex(vertexTag,false);
+  // check that the object did the partitioning
+  if (partitionFlag == false) {
+    opserr << "DomainPartitioner::swapBoundary()";
+    opserr << " - not partitioned or DomainPartitioner did not partition\n";
+    return -1;
+  }
 
+  if (from < 1 || from > numPartitions || to < 1 || to > numPartitions)
+    return -2;
 
-  if (inFrom == true) {
-      vertexPtr->setColor(to);
-      toBoundary->addVertex(vertexPtr,false);
-      Element *elePtr = fromSubdomain->removeElement(eleTag);
-      if (elePtr == 0) // if ele not there we can just return IT SHOULD BE
-    return -4;
-      elementsArray[count] = elePtr;
-      count++;
-  }
-  else  // we cannot remove the element
-      numCannotRemove++;
-    }
-    numEleToSwap -= numCannotRemove;
-
-    //  2. remove all nodes connected to the elements divide color by prime    
-    //     for each element and add back if still in subdomain
-    //  3. add back if still in subdomain
-    //  4. if node external remove from PartitionedDomains external nodes
-
-    // first determine which nodes to remove
-    int primeFrom = primes(from);
-    int primeTo = primes(to);
-    int numNodToSwap = 0;
-    ID nodesToRemove(0,128);
-    for (int j=0; j<numEleToSwap; j++) {
-  Element *elePtr = elementsArray[j];
-  const ID  &nodes = elePtr->getExternalNodes(); 
-  
-  int nodesSize = nodes.Size();
-
-  for (int k=0; k<nodesSize; k++) {
-      int nodeTag = nodes(k);
-      int loc = nodesToRemove.getLocation(nodeTag);
-      if (loc < 0) {
-    nodesToRemove[numNodToSwap] = nodeTag;
-    numNodToSwap++;
+  // the boundary of from changes as the vertices are swapped
+  Graph *fromBoundary = theBoundaryElements[from-1];
+  ID vertexTags(0, fromBoundary->getNumVertex());
+  VertexIter &theVertices = fromBoundary->getVertices();
+  Vertex *vertexPtr;
+  while ((vertexPtr = theVertices()) != 0) {
+    const ID &adjacent = vertexPtr->getAdjacency();
+    for (int i=0; i<adjacent.Size(); i++)
+      if (theElementGraph->getVertexPtr(adjacent(i))->getColor() == to) {
+	vertexTags[vertexTags.Size()] = vertexPtr->getTag();
+	i = adjacent.Size();
       }
-      (*nodePlace)(nodeTag) /= primeFrom;    
-      (*nodePlace)(nodeTag) *= primeTo;        
   }
-    }
 
-    // remove the nodes
-    Node **nodesArray = new Node *[numNodToSwap];  
-    for (int k=0; k<numNodToSwap; k++) {
-  int nodeTag = nodesToRemove(k); 
-  Node *nodePtr = fromSubdomain->removeNode(nodeTag);
-  nodesArray[k] = nodePtr;
-
-  // add the node back to from if still external
-  if ((*nodePlace)(nodeTag)%primeFrom == 0)
-      fromSubdomain->addExternalNode(nodePtr);
-
-  // if it was external remove from PartitionedDomains external nodes
-  int partition = (*nodePlace)(nodeTag);
-  for (int j=1; j<=numPartitions; j++) 
-      if (j != from) {
-    int prime = primes(j);
-    if (partition%prime == 0) {
-        myDomain->removeExternalNode(nodeTag);
-        j = numPartitions+1;
-    }
-      }
-    }
+  for (int i=0; i<vertexTags.Size(); i++)
+    this->swapVertex(from, to, vertexTags(i), adjacentVertexNotInOther);
 
-    // 5. add new vertices to boundary vertices of from if connected to
-    //    vertex we just removed and of color of from and not already in boundary
-
-    VertexIter &verticesToSwap2 = swapVertices->getVertices();
-    while ((vertexPtr = verticesToSwap2()) != 0) {
-  const ID &vertexAdjacent = vertexPtr->getAdjacency();
-  int vertexAdjacentSize = vertexAdjacent.Size();
-
-	for (int a=0; a<vertexAdjacentSize; a++) {
-	    int otherEleVertexTag = vertexAdjacent(a);
-	    Vertex *other = fromBoundary->getVertexPtr(otherEleVertexTag);
-	    if (other == 0) {
-		other = theElementGraph->getVertexPtr(otherEleVertexTag);
-		if (other->getColor() == from)
-		    fromBoundary->addVertex(other,false);
-	    }
-	}	
-    }
-
-
-    // in the TO subdomain we:
-    //  1. remove all nodes connected to the element, may or may not be there
-    //     if there don't divide by primeTo. 
-    //  2. mark all connecting nodes of elements as belonging to To
-    //  3. add the nodes, checking if external or internal
-    //  3. add the element
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of boundary
-    //     of boundary of to vertices
-
-    //  1. remove all nodes connected to the element, may or may not be there
-    //      if there divide by primeTo, do this as may have been added as extnl
-
-    for (int l=0; l<numNodToSwap; l++) {    
-  int nodeTag = nodesArray[l]->getTag();
-  Node *nodePtr;
-  nodePtr = toSubdomain->removeNode(nodesToRemove(l));
-    }
+  return 0;
+}
 
 
-    for (int m=0; m<numNodToSwap; m++) {
-  Node *nodePtr = nodesArray[m];
-  int nodeTag = nodePtr->getTag();
-  
-  //  3. add the nodes, checking if external or internal  
-  int internal = 0;
-  for (int n=1; n<=numPartitions; n++) 
-      if (n != to) {
-    int prime = primes(n);
-    if ((*nodePlace)(nodeTag)%prime == 0) { // its external
-        internal = 1;
-        n = numPartitions+1;
+// moves the nodal loads on a node that from holds to the same load
+// patterns of to
+int
+DomainPartitioner::moveNodalLoads(int nodeTag, Domain &from, Subdomain &to)
+{
+  ID patternTags(0, 8);
+  LoadPatternIter &thePatterns = myDomain->getLoadPatterns();
+  LoadPattern *thePattern;
+  while ((thePattern = thePatterns()) != 0)
+    patternTags[patternTags.Size()] = thePattern->getTag();
+
+  int numMoved = 0;
+  for (int i=0; i<patternTags.Size(); i++) {
+    int patternTag = patternTags(i);
+    LoadPattern *fromPattern = from.getLoadPattern(patternTag);
+    if (fromPattern == 0)
+      continue;
+
+    ID loadTags(0, 4);
+    NodalLoadIter &theLoads = fromPattern->getNodalLoads();
+    NodalLoad *theLoad;
+    while ((theLoad = theLoads()) != 0)
+      if (theLoad->getNodeTag() == nodeTag)
+	loadTags[loadTags.Size()] = theLoad->getTag();
+
+    for (int j=0; j<loadTags.Size(); j++) {
+      theLoad = from.removeNodalLoad(loadTags(j), patternTag);
+      if (theLoad != 0 && to.addNodalLoad(theLoad, patternTag) == true)
+	numMoved++;
     }
-      }
-  
-  if (internal == 0)
-      toSubdomain->addNode(nodePtr);
-  else {
-      toSubdomain->addExternalNode(nodePtr);
-      myDomain->addNode(nodePtr);
   }
-    }
-
-
-    delete [] nodesArray; // DELETE nodesArray here should not use nodePtrs
-                          // after here as node objects deleted if parallel    
-    
-    //  3. add the elements
-    for (int a=0; a<numEleToSwap; a++)
-  toSubdomain->addElement(elementsArray[a]);
-
-
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of to's boundary vertices
-
-    VertexIter &verticesToSwap3 = swapVertices->getVertices();
-    while ((vertexPtr = verticesToSwap3()) != 0) {
-	const ID &vertexAdjacent = vertexPtr->getAdjacency();
-	int vertexAdjacentSize = vertexAdjacent.Size();
-	for (int n=0; n<vertexAdjacentSize; n++) {
-	    int otherEleVertexTag = vertexAdjacent(n);
-	    Vertex *other = toBoundary->removeVertex(otherEleVertexTag,false);
-	    if (other != 0) {
-		const ID &othersAdjacency = other->getAdjacency();
-		int otherSize = othersAdjacency.Size();
-		for (int b=0; b<otherSize; b++) {
-		    int anotherEleVertexTag = othersAdjacency(b);
-		    Vertex *otherOther 
-			= theElementGraph->getVertexPtr(anotherEleVertexTag);
-		    if (otherOther->getColor() != to) {
-			toBoundary->addVertex(other,false);
-			b=otherSize;
-		    }
-		}
-	    }
-	}
-    }
 
-    // now remove any SP_Constraints that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    SP_ConstraintIter &theSPs = myDomain->getSPs();
-    SP_Constraint *spPtr;
-    while ((spPtr = theSPs()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) { // add to toSubdomain if inteernal
-    myDomain->removeSP_Constraint(spPtr->getTag());
-    toSubdomain->addSP_Constraint(spPtr);
-      }
-  }
-    }
+  return numMoved;
+}
 
-    
-    // now remove any SP_Constraints that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-    SP_ConstraintIter &theSPs2 = fromSubdomain->getSPs();
-    while ((spPtr = theSPs2()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-      fromSubdomain->removeSP_Constraint(spPtr->getTag());
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) 
-    toSubdomain->addSP_Constraint(spPtr);
-      else
-    myDomain->addSP_Constraint(spPtr);
-  }  
-    }
 
-    // now remove any NodalLoads that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    NodalLoadIter &theNodalLoads = myDomain->getNodalLoads();
-    NodalLoad *loadPtr;
-    while ((loadPtr = theNodalLoads()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
+// moves the loads on an element that from holds to the same load
+// patterns of to
+int
+DomainPartitioner::moveElementalLoads(int eleTag, Subdomain &from, Subdomain &to)
+{
+  ID patternTags(0, 8);
+  LoadPatternIter &thePatterns = myDomain->getLoadPatterns();
+  LoadPattern *thePattern;
+  while ((thePattern = thePatterns()) != 0)
+    patternTags[patternTags.Size()] = thePattern->getTag();
+
+  int numMoved = 0;
+  for (int i=0; i<patternTags.Size(); i++) {
+    int patternTag = patternTags(i);
+    LoadPattern *fromPattern = from.getLoadPattern(patternTag);
+    if (fromPattern == 0)
+      continue;
+
+    ID loadTags(0, 4);
+    ElementalLoadIter &theLoads = fromPattern->getElementalLoads();
+    ElementalLoad *theLoad;
+    while ((theLoad = theLoads()) != 0)
+      if (theLoad->getElementTag() == eleTag)
+	loadTags[loadTags.Size()] = theLoad->getTag();
+
+    for (int j=0; j<loadTags.Size(); j++) {
+      theLoad = from.removeElementalLoad(loadTags(j), patternTag);
+      if (theLoad != 0 && to.addElementalLoad(theLoad, patternTag) == true)
+	numMoved++;
     }
-      if (internal == 0) { // add to toSubdomain if inteernal
-    myDomain->removeNodalLoad(loadPtr->getTag());
-    toSubdomain->addNodalLoad(loadPtr);
-      }
   }
-    }
-
-
-    // now remove any NodalLoads that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-
-    NodalLoadIter &theNodalLoads2 = myDomain->getNodalLoads();
-    while ((loadPtr = theNodalLoads2()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-      fromSubdomain->removeNodalLoad(loadPtr->getTag());
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) 
-    toSubdomain->addNodalLoad(loadPtr);
-      else
-    myDomain->addNodalLoad(loadPtr);
-  }  
-    }
 
-
-    delete swapVertices;
-
-    timer.pause();
-    opserr << "DomainPartitioner::swapBoundary DONE" << timer.getReal() << endln;
-
-  ***************************************************************************/
-    return 0;
+  return numMoved;
 }
 
 
@@ -1586,14 +1285,17 @@ DomainPartitioner::releaseVertex(int from,
     double fromWeight = fromVertex->getWeight();
     double toWeight  = toVertex->getWeight();
     
-    if (fromWeight == toWeight)
-      opserr << "DomainPartitioner::releaseVertex - TO CHANGE >= to >\n";
-
-    if (fromWeight >= toWeight) {
-      if (toWeight == 0.0) 
-	return swapVertex(from,partition,vertexTag,adjacentVertexNotInOther);	    
-      if (fromWeight/toWeight > factorGreater)        
-	return swapVertex(from,partition,vertexTag,adjacentVertexNotInOther);	    
+    // the weights of the partitions follow the moved element, so that
+    // releasing stops once from is no longer the heavier
+    if (fromWeight > toWeight &&
+	(toWeight == 0.0 || fromWeight/toWeight > factorGreater)) {
+      double weight = vertexPtr->getWeight();
+      int res = swapVertex(from,partition,vertexTag,adjacentVertexNotInOther);
+      if (res == 0) {
+	fromVertex->setWeight(fromWeight - weight);
+	toVertex->setWeight(toWeight + weight);
+      }
+      return res;
     }
   }
   
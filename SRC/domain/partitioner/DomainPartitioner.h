@@ -39,6 +39,9 @@
 #endif
 
 #include <ID.h>
+#include <map>
+#include <set>
+#include <vector>
 
 class GraphPartitioner;
 class LoadBalancer;
@@ -46,6 +49,9 @@ class PartitionedDomain;
 class Vector;
 class Graph;
 class TaggedObjectStorage;
+class Domain;
+class Subdomain;
+class SP_Constraint;
 
 class DomainPartitioner
 {
@@ -94,6 +100,10 @@ class DomainPartitioner
   protected:    
     
   private:
+    void clearGraphs(void);
+    int moveNodalLoads(int nodeTag, Domain &from, Subdomain &to);
+    int moveElementalLoads(int eleTag, Subdomain &from, Subdomain &to);
+
     PartitionedDomain *myDomain; 
     GraphPartitioner  &thePartitioner;
     LoadBalancer      *theBalancer;    
@@ -109,6 +119,15 @@ class DomainPartitioner
     
     bool usingMainDomain;
     int mainPartition;
+
+    // what is needed to move the elements once they are in the subdomains
+    std::map<int, int> elementVertices;        // vertex of each element
+    std::map<int, ID> elementNodes;            // nodes of each element
+    std::map<int, std::vector<SP_Constraint *> > nodeSPs;  // SP_Constraints of
+                                               // the domain on each node
+    std::set<int> constrainedNodes;            // nodes of MP_Constraints and of
+                                               // the SP_Constraints of patterns
+    int numSwapped;                            // elements moved in balance()
 };
 
 #endif
@@ -0,0 +1,182 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: a test of the rebalancing of DomainPartitioner. A braced truss
+// of trusses is split into two subdomains at its middle bay, and the
+// elements on the boundary are swapped from one subdomain to the other
+// and back several times, as a LoadBalancer does. After each swap every
+// element of a subdomain must hold the nodes that subdomain has, each
+// subdomain must have the nodes of its elements and none other, and no
+// element may be lost.
+//
+// Usage: testDomainPartitioner
+
+#include <StandardStream.h>
+#include <PartitionedDomain.h>
+#include <DomainPartitioner.h>
+#include <GraphPartitioner.h>
+#include <Subdomain.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Element.h>
+#include <ElementIter.h>
+#include <Truss.h>
+#include <ElasticMaterial.h>
+#include <SP_Constraint.h>
+#include <ID.h>
+
+#include <set>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+static const int numBays = 8;
+
+// the element tags are 10*bay+k, the elements of the left half of the
+// bays going to subdomain 1 and the others to 2
+class BayPartitioner : public GraphPartitioner
+{
+  public:
+    int partition(Graph &theGraph, int numPart) {
+      VertexIter &theVertices = theGraph.getVertices();
+      Vertex *vertexPtr;
+      while ((vertexPtr = theVertices()) != 0)
+	vertexPtr->setColor(vertexPtr->getRef()/10 < numBays/2 ? 1 : 2);
+      return 0;
+    }
+};
+
+// returns the number of faults found in the subdomain
+static int
+checkSubdomain(Subdomain &theSub)
+{
+  int numFaults = 0;
+  std::set<int> eleNodes;
+
+  ElementIter &theElements = theSub.getElements();
+  Element *elePtr;
+  while ((elePtr = theElements()) != 0) {
+    const ID &nodes = elePtr->getExternalNodes();
+    Node **nodePtrs = elePtr->getNodePtrs();
+    for (int i=0; i<nodes.Size(); i++) {
+      eleNodes.insert(nodes(i));
+      if (nodePtrs[i] != theSub.getNode(nodes(i))) {
+	opserr << "element " << elePtr->getTag() << " of subdomain " << theSub.getTag();
+	opserr << " does not hold node " << nodes(i) << " of the subdomain\n";
+	numFaults++;
+      }
+    }
+  }
+
+  int numNodes = 0;
+  NodeIter &theNodes = theSub.getNodes();
+  Node *nodePtr;
+  while ((nodePtr = theNodes()) != 0) {
+    numNodes++;
+    if (eleNodes.find(nodePtr->getTag()) == eleNodes.end()) {
+      opserr << "subdomain " << theSub.getTag() << " has node " << nodePtr->getTag();
+      opserr << " without an element\n";
+      numFaults++;
+    }
+  }
+  if (numNodes != (int)eleNodes.size()) {
+    opserr << "subdomain " << theSub.getTag() << " has " << numNodes;
+    opserr << " nodes for elements at " << (int)eleNodes.size() << endln;
+    numFaults++;
+  }
+
+  return numFaults;
+}
+
+int main(int argc, char **argv)
+{
+  BayPartitioner theGraphPartitioner;
+  DomainPartitioner thePartitioner(theGraphPartitioner);
+  PartitionedDomain theDomain(thePartitioner);
+
+  // nodes 1.. along the bottom chord and 101.. along the top
+  for (int i=0; i<=numBays; i++) {
+    theDomain.addNode(new Node(i+1, 2, (double)i, 0.0));
+    theDomain.addNode(new Node(100+i+1, 2, (double)i, 1.0));
+  }
+  theDomain.addSP_Constraint(new SP_Constraint(1, 0, 0.0, true));
+  theDomain.addSP_Constraint(new SP_Constraint(1, 1, 0.0, true));
+  theDomain.addSP_Constraint(new SP_Constraint(101, 0, 0.0, true));
+
+  ElasticMaterial theMaterial(1, 1000.0);
+  int numElements = 0;
+  for (int i=0; i<numBays; i++) {
+    int nodeI = i+1;
+    theDomain.addElement(new Truss(10*i+1, 2, nodeI, nodeI+1, theMaterial, 1.0));
+    theDomain.addElement(new Truss(10*i+2, 2, 100+nodeI, 100+nodeI+1, theMaterial, 1.0));
+    theDomain.addElement(new Truss(10*i+3, 2, nodeI+1, 100+nodeI+1, theMaterial, 1.0));
+    theDomain.addElement(new Truss(10*i+4, 2, nodeI, 100+nodeI+1, theMaterial, 1.0));
+    numElements += 4;
+  }
+  theDomain.addElement(new Truss(10*numBays+3, 2, 1, 101, theMaterial, 1.0));
+  numElements++;
+
+  theDomain.addSubdomain(new Subdomain(1));
+  theDomain.addSubdomain(new Subdomain(2));
+
+  if (theDomain.partition(2) < 0) {
+    opserr << "FAILED - the domain could not be partitioned\n";
+    return -1;
+  }
+
+  Subdomain *theSubs[2] = {theDomain.getSubdomainPtr(1), theDomain.getSubdomainPtr(2)};
+
+  int numFaults = 0;
+  int numSwapped = 0;
+  int swaps[6][2] = {{1, 2}, {1, 2}, {2, 1}, {2, 1}, {2, 1}, {1, 2}};
+  for (int s=0; s<6; s++) {
+    int from = swaps[s][0];
+    int to = swaps[s][1];
+    int numBefore = theSubs[from-1]->getNumElements();
+    thePartitioner.swapBoundary(from, to);
+    numSwapped += numBefore - theSubs[from-1]->getNumElements();
+
+    for (int i=0; i<2; i++)
+      numFaults += checkSubdomain(*theSubs[i]);
+
+    int numNow = theSubs[0]->getNumElements() + theSubs[1]->getNumElements() +
+      theDomain.Domain::getNumElements();
+    if (numNow != numElements) {
+      opserr << "the subdomains have " << numNow << " elements of " << numElements << endln;
+      numFaults++;
+    }
+  }
+
+  opserr << "elements swapped: " << numSwapped << endln;
+  if (numSwapped == 0) {
+    opserr << "no element was swapped\n";
+    numFaults++;
+  }
+
+  if (numFaults == 0)
+    opserr << "PASSED\n";
+  else
+    opserr << "FAILED - " << numFaults << " faults\n";
+
+  return numFaults == 0 ? 0 : -1;
+}
@@ -177,6 +177,19 @@ ActorSubdomain::run(void)
 	    this->sendVector(theVect);
 	    break;	    
 
+	  case ShadowActorSubdomain_getElementCosts:
+	    {
+	      ID eleTags(0);
+	      Vector costs(0);
+	      msgData(0) = this->getElementCosts(eleTags, costs);
+	      this->sendID(msgData);
+	      if (msgData(0) != 0) {
+		this->sendID(eleTags);
+		this->sendVector(costs);
+	      }
+	    }
+	    break;
+
  	  case ShadowActorSubdomain_addElement:
 	    theType = msgData(1);
 	    dbTag = msgData(2);
@@ -959,6 +972,11 @@ opserr << "ActorSubdomain::addSP_AXIS :: DONE\n";
 	   delete theV;
 	   break;
 
+         case ShadowActorSubdomain_setNumThreads:
+	   msgData(0) = this->Subdomain::setNumThreads(msgData(1));
+	   this->sendID(msgData);
+	   break;
+
 
          case ShadowActorSubdomain_addParameter:
 	    theType = msgData(1);
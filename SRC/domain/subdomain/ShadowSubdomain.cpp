@@ -89,7 +89,7 @@ ShadowSubdomain::ShadowSubdomain(int tag,
    theLoadCases(0,128),
    theShadowSPs(0), theShadowMPs(0), theShadowLPs(0),
    numDOF(0),numElements(0),numNodes(0),numExternalNodes(0),
-   numSPs(0),numMPs(0), buildRemote(false), gotRemoteData(false), 
+   numSPs(0),numMPs(0), numThreads(1), buildRemote(false), gotRemoteData(false), 
    theFEele(0),
    theVector(0), theMatrix(0)
 {
@@ -136,7 +136,7 @@ ShadowSubdomain::ShadowSubdomain(int tag,
    theLoadCases(0,128),
    theShadowSPs(0), theShadowMPs(0), theShadowLPs(0),
    numDOF(0),numElements(0),numNodes(0),numExternalNodes(0),
-   numSPs(0),numMPs(0), buildRemote(false), gotRemoteData(false), 
+   numSPs(0),numMPs(0), numThreads(1), buildRemote(false), gotRemoteData(false), 
    theFEele(0),
    theVector(0), theMatrix(0)
 {
@@ -464,6 +464,11 @@ ShadowSubdomain::addNodalLoad(NodalLoad *theLoad, int loadPattern)
   msgData(3) = loadPattern;
   this->sendID(msgData);
   this->sendObject(*theLoad);
+
+  // keep the load in the shadow of the pattern, so it can be removed again
+  LoadPattern *thePattern = this->getLoadPattern(loadPattern);
+  if (thePattern != 0)
+    thePattern->addNodalLoad(theLoad);
   
   return true;    
 }
@@ -490,6 +495,10 @@ ShadowSubdomain::addElementalLoad(ElementalLoad *theLoad, int loadPattern)
   this->sendID(msgData);
   this->sendObject(*theLoad);
 
+  LoadPattern *thePattern = this->getLoadPattern(loadPattern);
+  if (thePattern != 0)
+    thePattern->addElementalLoad(theLoad);
+
   return true;    
 }
 
@@ -645,6 +654,17 @@ ShadowSubdomain::removeMP_Constraint(int tag)
   return result;
 }
 
+LoadPattern *
+ShadowSubdomain::getLoadPattern(int tag)
+{
+  TaggedObject *mc = theShadowLPs->getComponentPtr(tag);
+  if (mc == 0)
+    return 0;
+
+  LoadPattern *result = (LoadPattern *)mc;
+  return result;
+}
+
 LoadPattern *
 ShadowSubdomain::removeLoadPattern(int loadTag)
 {
@@ -966,6 +986,34 @@ ShadowSubdomain::setRayleighDampingFactors(double alphaM, double betaK, double b
 }
 
 
+int
+ShadowSubdomain::setNumThreads(int newNumThreads)
+{
+    if (newNumThreads < 1) {
+      opserr << "WARNING ShadowSubdomain::setNumThreads() - number of threads must be positive\n";
+      return -1;
+    }
+
+    msgData(0) = ShadowActorSubdomain_setNumThreads;
+    msgData(1) = newNumThreads;
+
+    this->sendID(msgData);
+    this->recvID(msgData);
+
+    if (msgData(0) == 0)
+      numThreads = newNumThreads;
+
+    return msgData(0);
+}
+
+
+int
+ShadowSubdomain::getNumThreads(void) const
+{
+    return numThreads;
+}
+
+
 
 int
 ShadowSubdomain::update(void)
@@ -1443,15 +1491,32 @@ ShadowSubdomain::eigenAnalysis(int numMode, bool generalized, bool findSmallest)
 double
 ShadowSubdomain::getCost(void)    
 {
-  /*
     msgData(0) = ShadowActorSubdomain_getCost;
     
     this->sendID(msgData);
-    Vector cost(2);
+    Vector cost(4);
     this->recvVector(cost);
     return cost(0);
-  */
-  return 0.0;
+}
+
+
+int
+ShadowSubdomain::getElementCosts(ID &eleTags, Vector &costs)
+{
+    msgData(0) = ShadowActorSubdomain_getElementCosts;
+
+    this->sendID(msgData);
+    this->recvID(msgData);
+    int numEle = msgData(0);
+
+    eleTags.resize(numEle);
+    costs.resize(numEle);
+    if (numEle != 0) {
+      this->recvID(eleTags);
+      this->recvVector(costs);
+    }
+
+    return numEle;
 }
 
 
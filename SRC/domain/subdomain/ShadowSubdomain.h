@@ -84,6 +84,7 @@ class ShadowSubdomain: public Shadow, public Subdomain
     virtual SP_Constraint *removeSP_Constraint(int tag);
     virtual MP_Constraint *removeMP_Constraint(int tag);
     virtual LoadPattern   *removeLoadPattern(int tag);
+    virtual LoadPattern   *getLoadPattern(int tag);
     virtual NodalLoad     *removeNodalLoad(int tag, int loadPattern);
     virtual ElementalLoad *removeElementalLoad(int tag, int loadPattern);
     virtual SP_Constraint * removeSP_Constraint(int tag, int loadPattern);
@@ -121,6 +122,8 @@ class ShadowSubdomain: public Shadow, public Subdomain
     virtual  void applyLoad(double pseudoTime);
     virtual  void setLoadConstant(void);    
     virtual  int  setRayleighDampingFactors(double alphaM, double betaK, double betaK0, double betaKc);
+    virtual  int  setNumThreads(int numThreads);
+    virtual  int  getNumThreads(void) const;
 
     virtual  int update(void);    
     virtual  int update(double newTime, double dT);    
@@ -166,6 +169,7 @@ class ShadowSubdomain: public Shadow, public Subdomain
 			 FEM_ObjectBroker &theBroker);    
 
     virtual double getCost(void);
+    virtual int getElementCosts(ID &eleTags, Vector &costs);
     
     virtual  void Print(OPS_Stream &s, int flag =0);
     virtual void Print(OPS_Stream &s, ID *nodeTags, ID *eleTags, int flag =0);
@@ -203,6 +207,7 @@ class ShadowSubdomain: public Shadow, public Subdomain
     int numSPs;
     int numMPs;
     int numLoadPatterns;
+    int numThreads;     // threads of the remote subdomain
 
     bool buildRemote;
     bool gotRemoteData;
@@ -33,6 +33,7 @@
 #include <ActorSubdomain.h>
 #include <FEM_ObjectBroker.h>
 #include <TCP_Socket.h>
+#include <SharedMemoryChannel.h>
 // #include <TCP_SocketNoDelay.h>
 #include <UDP_Socket.h>
 #include <SocketAddress.h>
@@ -53,6 +54,10 @@ int main(int argv, char **argc)
 	int port = atoi(argc[3]);	
 	theChannel = new TCP_Socket(port,machine);
     }
+    else if (channelType == 4) {
+	char *segment = argc[2];
+	theChannel = new SharedMemoryChannel(segment);
+    }
     //    else if (channelType == 2) {
     //	char *machine = argc[2];    	
     //	int port = atoi(argc[3]);	    
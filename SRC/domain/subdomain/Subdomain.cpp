@@ -67,7 +67,6 @@ Subdomain::Subdomain(int tag)
 :Element(tag,ELE_TAG_Subdomain),
  Domain(),
  mapBuilt(false),map(0),mappedVect(0),mappedMatrix(0),
- realCost(0.0),cpuCost(0),pageCost(0),
  theAnalysis(0), extNodes(0), theFEele(0) 
 {
 
@@ -106,7 +105,6 @@ Subdomain::Subdomain(int tag,
    mapBuilt(false),map(0),mappedVect(0),mappedMatrix(0),
    internalNodes(&theInternalNodeStorage),
    externalNodes(&theExternalNodeStorage), 
-   realCost(0.0),cpuCost(0),pageCost(0),
    theAnalysis(0), extNodes(0), theFEele(0)
 {
   //thePartitionedModelBuilder = 0;
@@ -454,6 +452,10 @@ Subdomain::setDomainDecompAnalysis(DomainDecompositionAnalysis &theNewAnalysis)
 {
     theAnalysis = &theNewAnalysis;
 //    this->Domain::setAnalysis(theNewAnalysis);
+
+    int numThreads = this->getNumThreads();
+    if (numThreads > 1)
+      theAnalysis->setNumThreads(numThreads);
 }
 
 
@@ -469,11 +471,28 @@ Subdomain::setAnalysisAlgorithm(EquiSolnAlgo &theAlgorithm)
 int 
 Subdomain::setAnalysisIntegrator(IncrementalIntegrator &theIntegrator)
 {
-  if (theAnalysis != 0)
-    return theAnalysis->setIntegrator(theIntegrator);
+  if (theAnalysis != 0) {
+    int res = theAnalysis->setIntegrator(theIntegrator);
+
+    int numThreads = this->getNumThreads();
+    if (res == 0 && numThreads > 1)
+      res = theAnalysis->setNumThreads(numThreads);
+
+    return res;
+  }
   return 0;
 }
 
+int
+Subdomain::setNumThreads(int numThreads)
+{
+  int res = this->Domain::setNumThreads(numThreads);
+  if (res == 0 && theAnalysis != 0)
+    res = theAnalysis->setNumThreads(numThreads);
+
+  return res;
+}
+
 int 
 Subdomain::setAnalysisLinearSOE(LinearSOE &theSOE)
 {
@@ -683,8 +702,6 @@ int
 Subdomain::computeTang(void)
 {   
   if (theAnalysis != 0) {
-    //    theTimer.start();
-    
     int res =0;
     res = theAnalysis->formTangent();
     
@@ -703,16 +720,9 @@ int
 Subdomain::computeResidual(void)
 {
   if (theAnalysis != 0) {
-    //    theTimer.start();
-    
     int res =0;
     res = theAnalysis->formResidual();
     
-    //theTimer.pause();
-    //    realCost += theTimer.getReal();
-    //    cpuCost += theTimer.getCPU();
-    //    pageCost += theTimer.getNumPageFaults();
-    
     return res;
     
     } else {
@@ -866,16 +876,13 @@ Subdomain::recvSelf(int cTag, Channel &theChannel,
     return -1;
 }
 
+// the measured cost of an update of the elements of the subdomain; the
+// elements are timed from the first request for the cost on
 double    
 Subdomain::getCost(void) 
 {
-    double lastRealCost = realCost;
-
-    realCost = 0.0;
-    cpuCost = 0.0;
-    pageCost = 0;
-
-    return lastRealCost;
+    this->setElementTiming(true);
+    return this->getUpdateTime();
 }
 
 
@@ -113,6 +113,10 @@ class Subdomain: public Element, public Domain
     virtual int setAnalysisEigenSOE(EigenSOE &theSOE);
     virtual int setAnalysisConvergenceTest(ConvergenceTest &theTest);
     virtual int invokeChangeOnAnalysis(void);
+
+    // the threads sweep the subdomain elements and nodes and are given to
+    // its analysis to form and assemble the condensed tangent and residual
+    virtual int setNumThreads(int numThreads);
     
     // Element methods which must be written
     virtual int getNumExternalNodes(void) const;    
@@ -175,9 +179,6 @@ class Subdomain: public Element, public Domain
     DomainDecompositionAnalysis *getDDAnalysis(void);
 
   private:
-    double realCost;
-    double cpuCost;
-    int pageCost;
     DomainDecompositionAnalysis *theAnalysis;
     ID *extNodes;
     FE_Element *theFEele;
@@ -43,13 +43,25 @@
 #include <Matrix.h>
 #include <Node.h>
 #include <Domain.h>
+#include <ScratchArena.h>
+#include <map>
+#include <tuple>
 
-Element  *ops_TheActiveElement = 0;
+thread_local Element  *ops_TheActiveElement = 0;
 
-Matrix **Element::theMatrices; 
-Vector **Element::theVectors1; 
-Vector **Element::theVectors2; 
-int  Element::numMatrices(0);
+// the matrix and vectors returned by the default mass, damping and
+// sensitivity methods; each thread has a set for each number of dof
+struct Element::Workspace {
+  Matrix theMatrix;
+  Vector theVector1;
+  Vector theVector2;
+
+  Workspace(int numDOF)
+    :theMatrix(numDOF, numDOF), theVector1(numDOF), theVector2(numDOF)
+  {}
+};
+
+static const int workSlot = ScratchArena::newSlot();
 
 // Element(int tag, int noExtNodes);
 // 	constructor that takes the element's unique tag and the number
@@ -126,67 +138,10 @@ Element::setRayleighDampingFactors(double alpham, double betak, double betak0, d
   betaK0 = betak0;
   betaKc = betakc;
 
-  // check that memory has been allocated to store compute/return
-  // damping matrix & residual force calculations
-  if (index == -1) {
-    int numDOF = this->getNumDOF();
-
-    for (int i=0; i<numMatrices; i++) {
-      Matrix *aMatrix = theMatrices[i];
-      if (aMatrix->noRows() == numDOF) {
-	index = i;
-	i = numMatrices;
-      }
-    }
-    if (index == -1) {
-      Matrix **nextMatrices = new Matrix *[numMatrices+1];
-      if (nextMatrices == 0) {
-	opserr << "Element::getTheMatrix - out of memory\n";
-      }
-	  int j;
-      for (j=0; j<numMatrices; j++)
-	nextMatrices[j] = theMatrices[j];
-      Matrix *theMatrix = new Matrix(numDOF, numDOF);
-      if (theMatrix == 0) {
-	opserr << "Element::getTheMatrix - out of memory\n";
-	exit(-1);
-      }
-      nextMatrices[numMatrices] = theMatrix;
-
-      Vector **nextVectors1 = new Vector *[numMatrices+1];
-      Vector **nextVectors2 = new Vector *[numMatrices+1];
-      if (nextVectors1 == 0 || nextVectors2 == 0) {
-	opserr << "Element::getTheVector - out of memory\n";
-	exit(-1);
-      }
-
-      for (j=0; j<numMatrices; j++) {
-	nextVectors1[j] = theVectors1[j];
-	nextVectors2[j] = theVectors2[j];
-      }
-	
-      Vector *theVector1 = new Vector(numDOF);
-      Vector *theVector2 = new Vector(numDOF);
-      if (theVector1 == 0 || theVector2 == 0) {
-	opserr << "Element::getTheVector - out of memory\n";
-	exit(-1);
-      }
-
-      nextVectors1[numMatrices] = theVector1;
-      nextVectors2[numMatrices] = theVector2;
-
-      if (numMatrices != 0) {
-	delete [] theMatrices;
-	delete [] theVectors1;
-	delete [] theVectors2;
-      }
-      index = numMatrices;
-      numMatrices++;
-      theMatrices = nextMatrices;
-      theVectors1 = nextVectors1;
-      theVectors2 = nextVectors2;
-    }
-  }
+  // the work storage of the damping and residual force calculations
+  // is kept per thread for each number of dof
+  if (index == -1)
+    index = this->getNumDOF();
 
   // if need storage for Kc go get it
   if (betaKc != 0.0) {  
@@ -216,12 +171,10 @@ Element::setDamping(Domain *theDomain, Damping *theDamping)
 const Matrix &
 Element::getDamp(void) 
 {
-  if (index  == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  Workspace &theWork = this->getWorkspace();
 
   // now compute the damping matrix
-  Matrix *theMatrix = theMatrices[index]; 
+  Matrix *theMatrix = &theWork.theMatrix;
   theMatrix->Zero();
   if (alphaM != 0.0)
     theMatrix->addMatrix(0.0, this->getMass(), alphaM);
@@ -241,12 +194,10 @@ Element::getDamp(void)
 const Matrix &
 Element::getMass(void)
 {
-  if (index  == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  Workspace &theWork = this->getWorkspace();
 
   // zero the matrix & return it
-  Matrix *theMatrix = theMatrices[index]; 
+  Matrix *theMatrix = &theWork.theMatrix;
   theMatrix->Zero();
   return *theMatrix;
 }
@@ -254,13 +205,11 @@ Element::getMass(void)
 const Vector &
 Element::getResistingForceIncInertia(void) 
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  Workspace &theWork = this->getWorkspace();
 
-  Matrix *theMatrix = theMatrices[index]; 
-  Vector *theVector = theVectors2[index];
-  Vector *theVector2 = theVectors1[index];
+  Matrix *theMatrix = &theWork.theMatrix;
+  Vector *theVector = &theWork.theVector2;
+  Vector *theVector2 = &theWork.theVector1;
 
   //
   // perform: R = P(U) - Pext(t);
@@ -321,13 +270,11 @@ const Vector &
 Element::getRayleighDampingForces(void) 
 {
 
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  Workspace &theWork = this->getWorkspace();
 
-  Matrix *theMatrix = theMatrices[index]; 
-  Vector *theVector = theVectors2[index];
-  Vector *theVector2 = theVectors1[index];
+  Matrix *theMatrix = &theWork.theMatrix;
+  Vector *theVector = &theWork.theVector2;
+  Vector *theVector2 = &theWork.theVector1;
 
   //
   // perform: R = (alphaM * M + betaK0 * K0 + betaK * K) * v
@@ -421,6 +368,29 @@ Element::isSubdomain(void)
     return false;
 }
 
+bool
+Element::isReentrant(void) const
+{
+    return false;
+}
+
+Element::Workspace &
+Element::getWorkspace(void)
+{
+  if (index == -1)
+    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
+
+  typedef std::map<int, Workspace> WorkspaceMap;
+  WorkspaceMap &theWorkspaces = ScratchArena::local().get<WorkspaceMap>(workSlot);
+  WorkspaceMap::iterator theWork = theWorkspaces.find(index);
+  if (theWork == theWorkspaces.end())
+    theWork = theWorkspaces.emplace(std::piecewise_construct,
+				    std::forward_as_tuple(index),
+				    std::forward_as_tuple(index)).first;
+
+  return theWork->second;
+}
+
 Response*
 Element::setResponse(const char **argv, int argc, OPS_Stream &output)
 {
@@ -530,11 +500,9 @@ Element::getResponseSensitivity(int responseID, int gradIndex,
 const Vector &
 Element::getResistingForceSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  Workspace &theWork = this->getWorkspace();
 
-  Vector *theVector = theVectors1[index];
+  Vector *theVector = &theWork.theVector1;
   theVector->Zero();
 
   return *theVector;
@@ -543,9 +511,7 @@ Element::getResistingForceSensitivity(int gradIndex)
 const Matrix &
 Element::getTangentStiffSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  Workspace &theWork = this->getWorkspace();
 
   static bool warningShown = false;
   if (!warningShown) {
@@ -553,7 +519,7 @@ Element::getTangentStiffSensitivity(int gradIndex)
     warningShown = true;
   }
 
-  Matrix *theMatrix = theMatrices[index];
+  Matrix *theMatrix = &theWork.theMatrix;
   theMatrix->Zero();
 
   return *theMatrix;
@@ -563,9 +529,7 @@ const Matrix &
 
 Element::getInitialStiffSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  Workspace &theWork = this->getWorkspace();
 
   static bool warningShown = false;
   if (!warningShown) {
@@ -573,7 +537,7 @@ Element::getInitialStiffSensitivity(int gradIndex)
     warningShown = true;
   }
 
-  Matrix *theMatrix = theMatrices[index];
+  Matrix *theMatrix = &theWork.theMatrix;
   theMatrix->Zero();
 
   return *theMatrix;
@@ -582,9 +546,7 @@ Element::getInitialStiffSensitivity(int gradIndex)
 const Matrix &
 Element::getCommittedStiffSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  Workspace &theWork = this->getWorkspace();
 
   static bool warningShown = false;
   if (!warningShown) {
@@ -592,7 +554,7 @@ Element::getCommittedStiffSensitivity(int gradIndex)
     warningShown = true;
   }
 
-  Matrix *theMatrix = theMatrices[index];
+  Matrix *theMatrix = &theWork.theMatrix;
   theMatrix->Zero();
 
   return *theMatrix;
@@ -601,11 +563,9 @@ Element::getCommittedStiffSensitivity(int gradIndex)
 const Matrix &
 Element::getMassSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  Workspace &theWork = this->getWorkspace();
 
-  Matrix *theMatrix = theMatrices[index];
+  Matrix *theMatrix = &theWork.theMatrix;
   theMatrix->Zero();
 
   return *theMatrix;
@@ -631,12 +591,10 @@ Element::addInertiaLoadSensitivityToUnbalance(const Vector &accel, bool tag)
 const Matrix &
 Element::getDampSensitivity(int gradIndex) 
 {
-  if (index  == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  Workspace &theWork = this->getWorkspace();
 
   // now compute the damping matrix
-  Matrix *theMatrix = theMatrices[index]; 
+  Matrix *theMatrix = &theWork.theMatrix;
   theMatrix->Zero();
   if (alphaM != 0.0) {
     theMatrix->addMatrix(0.0, this->getMassSensitivity(gradIndex), alphaM);
@@ -791,11 +749,9 @@ Element::displaySelf(Renderer &, int mode, float fact, const char **displayModes
 const Matrix &
 Element::getGeometricTangentStiff()
 {
-    if (index == -1) {
-	this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-    }
+    Workspace &theWork = this->getWorkspace();
     
-    Matrix *theMatrix = theMatrices[index];
+    Matrix *theMatrix = &theWork.theMatrix;
     theMatrix->Zero();
     
     return *theMatrix;
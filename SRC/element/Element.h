@@ -67,6 +67,12 @@ class Element : public DomainComponent
     virtual int revertToStart(void);                
     virtual int update(void);
     virtual bool isSubdomain(void);
+    // returns true if update(), commitState(), revertToLastCommit() and the
+    // methods returning the stiffness, mass, damping and resisting force
+    // may be invoked on this object while other elements are used on other
+    // threads; elements that keep shared work storage, directly or through
+    // their materials, keep the default of false and are used serially
+    virtual bool isReentrant(void) const;
     
     // methods to return the current linearized stiffness,
     // damping and mass matrices
@@ -137,12 +143,7 @@ protected:
     Matrix **previousK;
     int numPreviousK;
 
-    int index, nodeIndex;
-
-    static Matrix ** theMatrices; 
-    static Vector ** theVectors1; 
-    static Vector ** theVectors2; 
-    static int numMatrices;
+    int index, nodeIndex;   // index: number of dof of the work storage, -1 until set
 #ifdef _CSS
 	double getDampingEnergy();
 	void computeEnergies();
@@ -150,6 +151,8 @@ protected:
 #endif
    bool is_this_element_active;
   private:
+    struct Workspace;
+    Workspace &getWorkspace(void);
 #ifdef _CSS
 	  Vector prevDampingForces;
 	  Vector prevResistingForces;
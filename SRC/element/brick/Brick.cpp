@@ -108,8 +108,6 @@ void* OPS_Brick()
 }
 
 //static data
-double  Brick::xl[3][8] ;
-
 Matrix  Brick::stiff(24,24) ;
 Vector  Brick::resid(24) ;
 Matrix  Brick::mass(24,24) ;
@@ -125,16 +123,12 @@ const double  Brick::sg[] = { -one_over_root3,
 const double  Brick::wg[] = { 1.0, 1.0, 1.0, 1.0, 
                               1.0, 1.0, 1.0, 1.0  } ;
 
-  
-static Matrix B(6,3) ;
 
 //null constructor
 Brick::Brick( ) 
 :Element( 0, ELE_TAG_Brick ),
  connectedExternalNodes(8), applyLoad(0), load(0), Ki(0)
 {
-  B.Zero();
-
   for (int i=0; i<8; i++ ) {
     materialPointers[i] = 0;
     nodePointers[i] = 0;
@@ -166,8 +160,6 @@ Brick::Brick(int tag,
   :Element(tag, ELE_TAG_Brick),
    connectedExternalNodes(8), applyLoad(0), load(0), Ki(0)
 {
-  B.Zero();
-
   connectedExternalNodes(0) = node1 ;
   connectedExternalNodes(1) = node2 ;
   connectedExternalNodes(2) = node3 ;
@@ -489,26 +481,23 @@ const Matrix&  Brick::getInitialStiff( )
   int jj, kk ;
 
   
-  static double volume ;
-  static double xsj ;  // determinant jacaobian matrix 
-  static double dvol[numberGauss] ; //volume element
-  static double gaussPoint[ndm] ;
-  static Vector strain(nstress) ;  //strain
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
-  static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
-  static Matrix stiffJK(ndf,ndf) ; //nodeJK stiffness 
-  static Matrix dd(nstress,nstress) ;  //material tangent
+  double volume ;
+  double xsj ;  // determinant jacaobian matrix 
+  double dvol[numberGauss] ; //volume element
+  double gaussPoint[ndm] ;
+  double shp[nShape][numberNodes] ;  //shape functions at a gauss point
+  double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
+  MatrixND<ndf,ndf> stiffJK ; //nodeJK stiffness 
+  MatrixND<nstress,nstress> dd ;  //material tangent
 
 
   //---------B-matrices------------------------------------
 
-    static Matrix BJ(nstress,ndf) ;      // B matrix node J
+    MatrixND<nstress,ndf> BJ = {} ;      // B matrix node J
 
-    static Matrix BJtran(ndf,nstress) ;
+    MatrixND<nstress,ndf> BK = {} ;      // B matrix node k
 
-    static Matrix BK(nstress,ndf) ;      // B matrix node k
-
-    static Matrix BJtranD(ndf,nstress) ;
+    MatrixND<ndf,nstress> BJtranD ;      // BJ' * dd
 
   //-------------------------------------------------------
 
@@ -571,22 +560,15 @@ const Matrix&  Brick::getInitialStiff( )
     jj = 0;
     for ( j = 0; j < numberNodes; j++ ) {
 
-      BJ = computeB( j, shp ) ;
-   
-      //transpose 
-      //BJtran = transpose( nstress, ndf, BJ ) ;
-      for (p=0; p<ndf; p++) {
-	for (q=0; q<nstress; q++) 
-	  BJtran(p,q) = BJ(q,p) ;
-      }//end for p
+      computeB( j, shp, BJ ) ;
 
       //BJtranD = BJtran * dd ;
-      BJtranD.addMatrixProduct(0.0,  BJtran, dd, 1.0) ;
+      BJtranD.addMatrixTransposeProduct(0.0,  BJ, dd, 1.0) ;
       
       kk = 0 ;
       for ( k = 0; k < numberNodes; k++ ) {
 	
-	BK = computeB( k, shp ) ;
+	computeB( k, shp, BK ) ;
 	
 	
 	//stiffJK =  BJtranD * BK  ;
@@ -770,13 +752,13 @@ void   Brick::formInertiaTerms( int tangFlag )
 
   double dvol[numberGauss] ; //volume element
 
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
+  double shp[nShape][numberNodes] ;  //shape functions at a gauss point
 
-  static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
+  double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
 
-  static double gaussPoint[ndm] ;
+  double gaussPoint[ndm] ;
 
-  static Vector momentum(ndf) ;
+  VectorND<ndf> momentum ;
 
   int i, j, k, p, q ;
   int jj, kk ;
@@ -835,11 +817,12 @@ void   Brick::formInertiaTerms( int tangFlag )
 
     //node loop to compute acceleration
     momentum.Zero( ) ;
-    for ( j = 0; j < numberNodes; j++ ) 
+    for ( j = 0; j < numberNodes; j++ ) {
       //momentum += shp[massIndex][j] * ( nodePointers[j]->getTrialAccel()  ) ; 
-      momentum.addVector( 1.0,
-			  nodePointers[j]->getTrialAccel(),
-			  shp[massIndex][j] ) ;
+      const Vector &accel = nodePointers[j]->getTrialAccel( ) ;
+      for ( p = 0; p < ndf; p++ )
+	momentum(p) += shp[massIndex][j] * accel(p) ;
+    }
 
 
     //density
@@ -897,8 +880,6 @@ Brick::update(void)
 
   static const int ndm = 3 ;
 
-  static const int ndf = 3 ; 
-
   static const int nstress = 6 ;
  
   static const int numberNodes = 8 ;
@@ -910,31 +891,19 @@ Brick::update(void)
   int i, j, k, p, q ;
   int success ;
   
-  static double volume ;
-
-  static double xsj ;  // determinant jacaobian matrix 
-
-  static double dvol[numberGauss] ; //volume element
+  double volume ;
 
-  static double gaussPoint[ndm] ;
-
-  static Vector strain(nstress) ;  //strain
-
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
-
-  static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
-
-  //---------B-matrices------------------------------------
+  double xsj ;  // determinant jacaobian matrix 
 
-    static Matrix BJ(nstress,ndf) ;      // B matrix node J
+  double dvol[numberGauss] ; //volume element
 
-    static Matrix BJtran(ndf,nstress) ;
+  double gaussPoint[ndm] ;
 
-    static Matrix BK(nstress,ndf) ;      // B matrix node k
+  VectorND<nstress> strain ;  //strain
 
-    static Matrix BJtranD(ndf,nstress) ;
+  double shp[nShape][numberNodes] ;  //shape functions at a gauss point
 
-  //-------------------------------------------------------
+  double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
 
   
   //compute basis vectors and local nodal coordinates
@@ -1077,38 +1046,36 @@ void  Brick::formResidAndTangent( int tang_flag )
   int i, j, k, p, q ;
 
 
-  static double volume ;
+  double volume ;
 
-  static double xsj ;  // determinant jacaobian matrix 
+  double xsj ;  // determinant jacaobian matrix 
 
-  static double dvol[numberGauss] ; //volume element
+  double dvol[numberGauss] ; //volume element
 
-  static double gaussPoint[ndm] ;
+  double gaussPoint[ndm] ;
 
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
+  double shp[nShape][numberNodes] ;  //shape functions at a gauss point
 
-  static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
+  double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
 
-  static Vector residJ(ndf) ; //nodeJ residual 
+  VectorND<ndf> residJ ; //nodeJ residual 
 
-  static Matrix stiffJK(ndf,ndf) ; //nodeJK stiffness 
+  MatrixND<ndf,ndf> stiffJK ; //nodeJK stiffness 
 
-  static Vector stress(nstress) ;  //stress
+  VectorND<nstress> stress ;  //stress
 
-  static Vector dampingStress(nstress) ;  //damping stress
+  VectorND<nstress> dampingStress = {} ;  //damping stress
 
-  static Matrix dd(nstress,nstress) ;  //material tangent
+  MatrixND<nstress,nstress> dd ;  //material tangent
 
 
   //---------B-matrices------------------------------------
 
-    static Matrix BJ(nstress,ndf) ;      // B matrix node J
+    MatrixND<nstress,ndf> BJ = {} ;      // B matrix node J
 
-    static Matrix BJtran(ndf,nstress) ;
+    MatrixND<nstress,ndf> BK = {} ;      // B matrix node k
 
-    static Matrix BK(nstress,ndf) ;      // B matrix node k
-
-    static Matrix BJtranD(ndf,nstress) ;
+    MatrixND<ndf,nstress> BJtranD ;      // BJ' * dd
 
   //-------------------------------------------------------
 
@@ -1235,16 +1202,6 @@ void  Brick::formResidAndTangent( int tang_flag )
       residJ(1) += b11 * dampingStress[1] + b31 * dampingStress[3] + b41 * dampingStress[4];
       residJ(2) += b22 * dampingStress[2] + b42 * dampingStress[4] + b52 * dampingStress[5];
       
-      BJ = computeB( j, shp ) ;
-   
-      //transpose 
-      //BJtran = transpose( nstress, ndf, BJ ) ;
-      for (p=0; p<ndf; p++) {
-	for (q=0; q<nstress; q++) 
-	  BJtran(p,q) = BJ(q,p) ;
-      }//end for p
-
-
       //residual 
       for ( p = 0; p < ndf; p++ ) {
         resid( jj + p ) += residJ(p)  ;
@@ -1257,12 +1214,13 @@ void  Brick::formResidAndTangent( int tang_flag )
       if ( tang_flag == 1 ) {
 
 	//BJtranD = BJtran * dd ;
-	BJtranD.addMatrixProduct(0.0,  BJtran,dd,1.0) ;
+	computeB( j, shp, BJ ) ;
+	BJtranD.addMatrixTransposeProduct(0.0,  BJ,dd,1.0) ;
 
 	int kk = 0 ;
          for ( k = 0; k < numberNodes; k++ ) {
 
-            BK = computeB( k, shp ) ;
+            computeB( k, shp, BK ) ;
   
  
             //stiffJK =  BJtranD * BK  ;
@@ -1313,8 +1271,8 @@ void   Brick::computeBasis( )
 //*************************************************************************
 //compute B
 
-const Matrix&   
-Brick::computeB( int node, const double shp[4][8] )
+void
+Brick::computeB( int node, const double shp[4][8], MatrixND<6,3> &B )
 {
 
 //---B Matrix in standard {1,2,3} mechanics notation---------
@@ -1343,8 +1301,6 @@ Brick::computeB( int node, const double shp[4][8] )
   B(5,0) = shp[2][node] ;
   B(5,2) = shp[0][node] ;
 
-  return B ;
-
 }
 
 //***********************************************************************
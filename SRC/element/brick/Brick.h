@@ -38,6 +38,7 @@
 #include <ID.h> 
 #include <Vector.h>
 #include <Matrix.h>
+#include <MatrixND.h>
 #include <Element.h>
 #include <Node.h>
 #include <NDMaterial.h>
@@ -162,8 +163,8 @@ class Brick : public Element {
     static const double sg[2] ;
     static const double wg[8] ;
   
-    //local nodal coordinates, three coordinates for each of four nodes
-    static double xl[3][8] ; 
+    //local nodal coordinates, three coordinates for each of eight nodes
+    double xl[3][8] ; 
 
     //
     // private methods
@@ -179,7 +180,7 @@ class Brick : public Element {
     void computeBasis( ) ;
 
     //compute B matrix
-    const Matrix& computeB( int node, const double shp[4][8] ) ;
+    void computeB( int node, const double shp[4][8], MatrixND<6,3> &B ) ;
   
     //Matrix transpose
     Matrix transpose( int dim1, int dim2, const Matrix &M ) ;
@@ -47,6 +47,7 @@
 #include <ElementalLoad.h>
 #include <elementAPI.h>
 #include <string>
+#include <ScratchArena.h>
 #include <string.h>
 #include <map>
 #include <ElementIter.h>
@@ -55,9 +56,24 @@
 #include <Beam2dUniformLoad.h>
 #endif // _CSS
 
-Matrix DispBeamColumn2d::K(6, 6);
-Vector DispBeamColumn2d::P(6);
-double DispBeamColumn2d::workArea[100];
+// work storage of DispBeamColumn2d; each thread obtains its own copy from
+// its ScratchArena so that elements can be formed concurrently
+struct DispBeamColumn2d::Workspace {
+  Matrix K;                 // element stiffness, damping, and mass matrix
+  Vector P;                 // element resisting force vector
+  double workArea[100];
+
+  Matrix kb, kbInit;        // basic stiffness
+  Matrix ml;                // local mass matrix
+  Vector Raccel, accel;
+
+  Workspace()
+    :K(6, 6), P(6), kb(3, 3), kbInit(3, 3), ml(6, 6),
+     Raccel(6), accel(6)
+  {}
+};
+
+static const int workSlot = ScratchArena::newSlot();
 
 void* OPS_DispBeamColumn2d()
 {
@@ -653,9 +669,25 @@ DispBeamColumn2d::revertToStart()
     return retVal;
 }
 
+bool
+DispBeamColumn2d::isReentrant(void) const
+{
+  // the element keeps its work storage per thread; its sections and
+  // transformation must be reentrant as well, its damping is not assumed to be
+  if (theDamping != 0 || crdTransf->isReentrant() == false)
+    return false;
+
+  for (int i = 0; i < numSections; i++)
+    if (theSections[i]->isReentrant() == false)
+      return false;
+
+  return true;
+}
+
 int
 DispBeamColumn2d::update(void)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	int err = 0;
 
 	// Update the transformation
@@ -677,7 +709,7 @@ DispBeamColumn2d::update(void)
 		int order = theSections[i]->getOrder();
 		const ID& code = theSections[i]->getType();
 
-		Vector e(workArea, order);
+		Vector e(theWork.workArea, order);
 
 		//double xi6 = 6.0*pts(i,0);
 		double xi6 = 6.0 * xi[i];
@@ -709,6 +741,7 @@ DispBeamColumn2d::update(void)
 void
 DispBeamColumn2d::getBasicStiff(Matrix& kb, int initial)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// Zero for integral
 	kb.Zero();
 
@@ -726,7 +759,7 @@ DispBeamColumn2d::getBasicStiff(Matrix& kb, int initial)
 		int order = theSections[i]->getOrder();
 		const ID& code = theSections[i]->getType();
 
-		Matrix ka(workArea, order, 3);
+		Matrix ka(theWork.workArea, order, 3);
 		ka.Zero();
 
 		double xi6 = 6.0 * xi[i];
@@ -779,7 +812,8 @@ DispBeamColumn2d::getBasicStiff(Matrix& kb, int initial)
 const Matrix&
 DispBeamColumn2d::getTangentStiff()
 {
-	static Matrix kb(3, 3);
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+	Matrix &kb = theWork.kb;
 
 	this->getBasicStiff(kb);
 
@@ -832,41 +866,43 @@ DispBeamColumn2d::getTangentStiff()
 	q(2) += q0[2];
 
 	// Transform to global stiffness
-	K = crdTransf->getGlobalStiffMatrix(kb, q);
+	theWork.K = crdTransf->getGlobalStiffMatrix(kb, q);
 
-	return K;
+	return theWork.K;
 }
 
 const Matrix&
 DispBeamColumn2d::getInitialStiff()
 {
-  static Matrix kb(3,3);
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+  Matrix &kb = theWork.kbInit;
   this->getBasicStiff(kb, 1);
   if(theDamping) kb *= theDamping->getStiffnessMultiplier();
 
   // Transform to global stiffness
-  K = crdTransf->getInitialGlobalStiffMatrix(kb);
+  theWork.K = crdTransf->getInitialGlobalStiffMatrix(kb);
 
-	return K;
+	return theWork.K;
 }
 
 const Matrix&
 DispBeamColumn2d::getMass()
 {
-	K.Zero();
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+	theWork.K.Zero();
 
 	if (rho == 0.0)
-		return K;
+		return theWork.K;
 
 	double L = crdTransf->getInitialLength();
 	if (cMass == 0) {
 		// lumped mass matrix
 		double m = 0.5 * rho * L;
-		K(0, 0) = K(1, 1) = K(3, 3) = K(4, 4) = m;
+		theWork.K(0, 0) = theWork.K(1, 1) = theWork.K(3, 3) = theWork.K(4, 4) = m;
 	}
 	else {
 		// consistent mass matrix
-		static Matrix ml(6, 6);
+		Matrix &ml = theWork.ml;
 		double m = rho * L / 420.0;
 		ml(0, 0) = ml(3, 3) = m * 140.0;
 		ml(0, 3) = ml(3, 0) = m * 70.0;
@@ -881,10 +917,10 @@ DispBeamColumn2d::getMass()
 		ml(2, 4) = ml(4, 2) = -ml(1, 5);
 
 		// transform local mass matrix to global system
-		K = crdTransf->getGlobalMatrixFromLocal(ml);
+		theWork.K = crdTransf->getGlobalMatrixFromLocal(ml);
 	}
 
-	return K;
+	return theWork.K;
 }
 
 void
@@ -995,6 +1031,7 @@ DispBeamColumn2d::addLoad(ElementalLoad* theLoad, double loadFactor)
 int
 DispBeamColumn2d::addInertiaLoadToUnbalance(const Vector& accel)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// Check for a quick return
 	if (rho == 0.0)
 		return 0;
@@ -1021,7 +1058,7 @@ DispBeamColumn2d::addInertiaLoadToUnbalance(const Vector& accel)
 	}
 	else {
 		// use matrix vector multip. for consistent mass matrix
-		static Vector Raccel(6);
+		Vector &Raccel = theWork.Raccel;
 		for (int i = 0; i < 3; i++) {
 			Raccel(i) = Raccel1(i);
 			Raccel(i + 3) = Raccel2(i);
@@ -1035,6 +1072,7 @@ DispBeamColumn2d::addInertiaLoadToUnbalance(const Vector& accel)
 const Vector&
 DispBeamColumn2d::getResistingForce()
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	double L = crdTransf->getInitialLength();
 
 	double oneOverL = 1.0 / L;
@@ -1089,13 +1127,13 @@ DispBeamColumn2d::getResistingForce()
   // Vector for reactions in basic system
   Vector p0Vec(p0, 3);
 
-	P = crdTransf->getGlobalResistingForce(q, p0Vec);
+	theWork.P = crdTransf->getGlobalResistingForce(q, p0Vec);
 
 	// Subtract other external nodal loads ... P_res = P_int - P_ext
 	if (rho != 0)
-		P.addVector(1.0, Q, -1.0);
+		theWork.P.addVector(1.0, Q, -1.0);
 
-	return P;
+	return theWork.P;
 }
 
 const Vector &
@@ -1109,9 +1147,10 @@ DispBeamColumn2d::getDampingForce(void)
 const Vector&
 DispBeamColumn2d::getResistingForceIncInertia()
 {
-  P = this->getResistingForce();
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+  theWork.P = this->getResistingForce();
   
-  if (theDamping) P += this->getDampingForce();
+  if (theDamping) theWork.P += this->getDampingForce();
   
   if (rho != 0.0) {
     const Vector &accel1 = theNodes[0]->getTrialAccel();
@@ -1122,33 +1161,33 @@ DispBeamColumn2d::getResistingForceIncInertia()
     double L = crdTransf->getInitialLength();
     double m = 0.5*rho*L;
     
-    P(0) += m*accel1(0);
-    P(1) += m*accel1(1);
-    P(3) += m*accel2(0);
-    P(4) += m*accel2(1);
+    theWork.P(0) += m*accel1(0);
+    theWork.P(1) += m*accel1(1);
+    theWork.P(3) += m*accel2(0);
+    theWork.P(4) += m*accel2(1);
   } else  {
     // use matrix vector multip. for consistent mass matrix
-    static Vector accel(6);
+    Vector &accel = theWork.accel;
     for (int i=0; i<3; i++)  {
       accel(i)   = accel1(i);
       accel(i+3) = accel2(i);
     }
-    P.addMatrixVector(1.0, this->getMass(), accel, 1.0);
+    theWork.P.addMatrixVector(1.0, this->getMass(), accel, 1.0);
   }
     
     // add the damping forces if rayleigh damping
     if (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
-      P.addVector(1.0, this->getRayleighDampingForces(), 1.0);
+      theWork.P.addVector(1.0, this->getRayleighDampingForces(), 1.0);
 
 	}
 	else {
 
 		// add the damping forces if rayleigh damping
 		if (betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
-			P.addVector(1.0, this->getRayleighDampingForces(), 1.0);
+			theWork.P.addVector(1.0, this->getRayleighDampingForces(), 1.0);
 	}
 
-	return P;
+	return theWork.P;
 }
 
 int
@@ -1594,6 +1633,7 @@ Response*
 DispBeamColumn2d::setResponse(const char** argv, int argc,
 	OPS_Stream& output)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 #ifdef _CSS
 	Response* theResponse = Element::setResponse(argv, argc, output);
 	if (theResponse != 0)
@@ -1619,7 +1659,7 @@ DispBeamColumn2d::setResponse(const char** argv, int argc,
 		output.tag("ResponseType", "Py_2");
 		output.tag("ResponseType", "Mz_2");
 
-		theResponse = new ElementResponse(this, 1, P);
+		theResponse = new ElementResponse(this, 1, theWork.P);
 
 
 		// local force -
@@ -1633,7 +1673,7 @@ DispBeamColumn2d::setResponse(const char** argv, int argc,
 		output.tag("ResponseType", "V2");
 		output.tag("ResponseType", "M2");
 
-		theResponse = new ElementResponse(this, 2, P);
+		theResponse = new ElementResponse(this, 2, theWork.P);
 
 
 		// basic force -
@@ -1656,7 +1696,7 @@ DispBeamColumn2d::setResponse(const char** argv, int argc,
     output.tag("ResponseType","Py_2");
     output.tag("ResponseType","Mz_2");
 
-    theResponse =  new ElementResponse(this, 21, P);
+    theResponse =  new ElementResponse(this, 21, theWork.P);
   
   
   // local damping force -
@@ -1669,7 +1709,7 @@ DispBeamColumn2d::setResponse(const char** argv, int argc,
     output.tag("ResponseType","V2");
     output.tag("ResponseType","M2");
 
-    theResponse =  new ElementResponse(this, 22, P);
+    theResponse =  new ElementResponse(this, 22, theWork.P);
   
 
   // basic damping force -
@@ -1716,7 +1756,7 @@ DispBeamColumn2d::setResponse(const char** argv, int argc,
 		strcmp(argv[0], "rayleighForces") == 0 ||
 		strcmp(argv[0], "dampingForces") == 0) {
 
-		theResponse = new ElementResponse(this, 12, P);
+		theResponse = new ElementResponse(this, 12, theWork.P);
 	}
 
   // section response -
@@ -1872,6 +1912,7 @@ DispBeamColumn2d::setResponse(const char** argv, int argc,
 int
 DispBeamColumn2d::getResponse(int responseID, Information& eleInfo)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 #ifdef _CSS
 	if (Element::getResponse(responseID, eleInfo) == 0)
 		return 0;
@@ -1887,20 +1928,20 @@ DispBeamColumn2d::getResponse(int responseID, Information& eleInfo)
 		return eleInfo.setVector(this->getResistingForce());
 
 	else if (responseID == 12) {
-		P.Zero();
-		P.addVector(1.0, this->getRayleighDampingForces(), 1.0);
-		return eleInfo.setVector(P);
+		theWork.P.Zero();
+		theWork.P.addVector(1.0, this->getRayleighDampingForces(), 1.0);
+		return eleInfo.setVector(theWork.P);
 
 	}
 	else if (responseID == 2) {
-		P(3) = q(0);
-		P(0) = -q(0) + p0[0];
-		P(2) = q(1);
-		P(5) = q(2);
+		theWork.P(3) = q(0);
+		theWork.P(0) = -q(0) + p0[0];
+		theWork.P(2) = q(1);
+		theWork.P(5) = q(2);
 		V = (q(1) + q(2)) / L;
-		P(1) = V + p0[1];
-		P(4) = -V + p0[2];
-		return eleInfo.setVector(P);
+		theWork.P(1) = V + p0[1];
+		theWork.P(4) = -V + p0[2];
+		return eleInfo.setVector(theWork.P);
 	}
 
 	else if (responseID == 9) {
@@ -1919,14 +1960,14 @@ DispBeamColumn2d::getResponse(int responseID, Information& eleInfo)
   else if (responseID == 22) {
     Vector Sd(3);
     Sd = theDamping->getDampingForce();
-    P(3) =  Sd(0);
-    P(0) = -Sd(0);
-    P(2) = Sd(1);
-    P(5) = Sd(2);
+    theWork.P(3) =  Sd(0);
+    theWork.P(0) = -Sd(0);
+    theWork.P(2) = Sd(1);
+    theWork.P(5) = Sd(2);
     V = (Sd(1)+Sd(2))/L;
-    P(1) =  V;
-    P(4) = -V;
-    return eleInfo.setVector(P);
+    theWork.P(1) =  V;
+    theWork.P(4) = -V;
+    return eleInfo.setVector(theWork.P);
   }
 
   else if (responseID == 23)
@@ -2225,6 +2266,7 @@ DispBeamColumn2d::activateParameter(int passedParameterID)
 const Matrix&
 DispBeamColumn2d::getInitialStiffSensitivity(int gradNumber)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	static Matrix kb(3, 3);
 
 	// Zero for integral
@@ -2244,7 +2286,7 @@ DispBeamColumn2d::getInitialStiffSensitivity(int gradNumber)
 		int order = theSections[i]->getOrder();
 		const ID& code = theSections[i]->getType();
 
-		Matrix ka(workArea, order, 3);
+		Matrix ka(theWork.workArea, order, 3);
 		ka.Zero();
 
 		double xi6 = 6.0 * xi[i];
@@ -2295,25 +2337,26 @@ DispBeamColumn2d::getInitialStiffSensitivity(int gradNumber)
 	}
 
 	// Transform to global stiffness
-	K = crdTransf->getInitialGlobalStiffMatrix(kb);
+	theWork.K = crdTransf->getInitialGlobalStiffMatrix(kb);
 
-	return K;
+	return theWork.K;
 }
 
 const Matrix&
 DispBeamColumn2d::getMassSensitivity(int gradNumber)
 {
-	K.Zero();
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+	theWork.K.Zero();
 
 	if (rho == 0.0 || parameterID != 1)
-		return K;
+		return theWork.K;
 
 	double L = crdTransf->getInitialLength();
 	if (cMass == 0) {
 		// lumped mass matrix
 		//double m = 0.5*rho*L;
 		double m = 0.5 * L;
-		K(0, 0) = K(1, 1) = K(3, 3) = K(4, 4) = m;
+		theWork.K(0, 0) = theWork.K(1, 1) = theWork.K(3, 3) = theWork.K(4, 4) = m;
 	}
 	else {
 		// consistent mass matrix
@@ -2333,10 +2376,10 @@ DispBeamColumn2d::getMassSensitivity(int gradNumber)
 		ml(2, 4) = ml(4, 2) = -ml(1, 5);
 
 		// transform local mass matrix to global system
-		K = crdTransf->getGlobalMatrixFromLocal(ml);
+		theWork.K = crdTransf->getGlobalMatrixFromLocal(ml);
 	}
 
-	return K;
+	return theWork.K;
 }
 
 
@@ -2344,6 +2387,7 @@ DispBeamColumn2d::getMassSensitivity(int gradNumber)
 const Vector&
 DispBeamColumn2d::getResistingForceSensitivity(int gradNumber)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	double L = crdTransf->getInitialLength();
 	double oneOverL = 1.0 / L;
 
@@ -2427,7 +2471,7 @@ DispBeamColumn2d::getResistingForceSensitivity(int gradNumber)
 	// Transform forces
 	static Vector dp0dh(3);		// No distributed loads
 
-	P.Zero();
+	theWork.P.Zero();
 
 	//////////////////////////////////////////////////////////////
 
@@ -2456,7 +2500,7 @@ DispBeamColumn2d::getResistingForceSensitivity(int gradNumber)
 			const Vector& s = theSections[i]->getStressResultant();
 			const Matrix& ks = theSections[i]->getSectionTangent();
 
-			Matrix ka(workArea, order, 3);
+			Matrix ka(theWork.workArea, order, 3);
 			ka.Zero();
 
 			double si;
@@ -2513,13 +2557,13 @@ DispBeamColumn2d::getResistingForceSensitivity(int gradNumber)
 		dqdh.addMatrixVector(1.0, kbmine, dAdh_u, oneOverL);
 
 		// dAdh^T q
-		P += crdTransf->getGlobalResistingForceShapeSensitivity(q, dp0dh, gradNumber);
+		theWork.P += crdTransf->getGlobalResistingForceShapeSensitivity(q, dp0dh, gradNumber);
 	}
 
 	// A^T (dqdh + k dAdh u)
-	P += crdTransf->getGlobalResistingForce(dqdh, dp0dh);
+	theWork.P += crdTransf->getGlobalResistingForce(dqdh, dp0dh);
 
-	return P;
+	return theWork.P;
 }
 
 
@@ -2528,6 +2572,7 @@ DispBeamColumn2d::getResistingForceSensitivity(int gradNumber)
 int
 DispBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// Get basic deformation and sensitivities
 	const Vector& v = crdTransf->getBasicTrialDisp();
 
@@ -2549,7 +2594,7 @@ DispBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
 		int order = theSections[i]->getOrder();
 		const ID& code = theSections[i]->getType();
 
-		Vector e(workArea, order);
+		Vector e(theWork.workArea, order);
 
 		//double xi6 = 6.0*pts(i,0);
 		double xi6 = 6.0 * xi[i];
@@ -2590,7 +2635,7 @@ DispBeamColumn2d::computeSectionForces(Vector& sp, double xi)
 	crdTransf->getLocalAxes(xVec, yVec, zVec);
 	double x = xi * L;
 	sp.Zero();
-	this->getResistingForce();
+	const Vector &P = this->getResistingForce();
 	//convert P to local system:
 	sp(0) = -P(0) * xVec(0) - P(1) * xVec(1);
 	sp(1) = -P(0) * yVec(0) - P(1) * yVec(1);
@@ -48,10 +48,26 @@
 #include <math.h>
 #include <elementAPI.h>
 #include <string>
+#include <ScratchArena.h>
 
-Matrix DispBeamColumn3d::K(12, 12);
-Vector DispBeamColumn3d::P(12);
-double DispBeamColumn3d::workArea[200];
+// work storage of DispBeamColumn3d; each thread obtains its own copy from
+// its ScratchArena so that elements can be formed concurrently
+struct DispBeamColumn3d::Workspace {
+  Matrix K;                 // element stiffness, damping, and mass matrix
+  Vector P;                 // element resisting force vector
+  double workArea[200];
+
+  Matrix kb, kbInit;        // basic stiffness
+  Matrix ml;                // local mass matrix
+  Vector Raccel, accel;
+
+  Workspace()
+    :K(12, 12), P(12), kb(6, 6), kbInit(6, 6), ml(12, 12),
+     Raccel(12), accel(12)
+  {}
+};
+
+static const int workSlot = ScratchArena::newSlot();
 
 void* OPS_DispBeamColumn3d()
 {
@@ -556,9 +572,25 @@ DispBeamColumn3d::revertToStart()
     return retVal;
 }
 
+bool
+DispBeamColumn3d::isReentrant(void) const
+{
+  // the element keeps its work storage per thread; its sections and
+  // transformation must be reentrant as well, its damping is not assumed to be
+  if (theDamping != 0 || crdTransf->isReentrant() == false)
+    return false;
+
+  for (int i = 0; i < numSections; i++)
+    if (theSections[i]->isReentrant() == false)
+      return false;
+
+  return true;
+}
+
 int
 DispBeamColumn3d::update(void)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	int err = 0;
 
 	// Update the transformation
@@ -580,7 +612,7 @@ DispBeamColumn3d::update(void)
 		int order = theSections[i]->getOrder();
 		const ID& code = theSections[i]->getType();
 
-		Vector e(workArea, order);
+		Vector e(theWork.workArea, order);
 
 		double xi6 = 6.0 * xi[i];
 
@@ -619,7 +651,8 @@ DispBeamColumn3d::update(void)
 const Matrix&
 DispBeamColumn3d::getTangentStiff()
 {
-	static Matrix kb(6, 6);
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+	Matrix &kb = theWork.kb;
 
 	// Zero for integral
 	kb.Zero();
@@ -641,7 +674,7 @@ DispBeamColumn3d::getTangentStiff()
 		int order = theSections[i]->getOrder();
 		const ID& code = theSections[i]->getType();
 
-		Matrix ka(workArea, order, 6);
+		Matrix ka(theWork.workArea, order, 6);
 		ka.Zero();
 
 		double xi6 = 6.0 * xi[i];
@@ -743,14 +776,15 @@ DispBeamColumn3d::getTangentStiff()
 	q(4) += q0[4];
 
 	// Transform to global stiffness
-	K = crdTransf->getGlobalStiffMatrix(kb, q);
+	theWork.K = crdTransf->getGlobalStiffMatrix(kb, q);
 	//   opserr << this->getTag() << " " << K;
-	return K;
+	return theWork.K;
 }
 
 void
 DispBeamColumn3d::getBasicStiff(Matrix &kb, int initial)
 {
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
   // Zero for integral
   kb.Zero();
   
@@ -770,7 +804,7 @@ DispBeamColumn3d::getBasicStiff(Matrix &kb, int initial)
     int order = theSections[i]->getOrder();
     const ID &code = theSections[i]->getType();
     
-    Matrix ka(workArea, order, 6);
+    Matrix ka(theWork.workArea, order, 6);
     ka.Zero();
     
     double xi6 = 6.0*xi[i];
@@ -848,33 +882,35 @@ DispBeamColumn3d::getBasicStiff(Matrix &kb, int initial)
 const Matrix&
 DispBeamColumn3d::getInitialStiff()
 {
-  static Matrix kb(6,6);
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+  Matrix &kb = theWork.kbInit;
 
   this->getBasicStiff(kb, 1);
 
 	// Transform to global stiffness
-	K = crdTransf->getInitialGlobalStiffMatrix(kb);
+	theWork.K = crdTransf->getInitialGlobalStiffMatrix(kb);
 
-	return K;
+	return theWork.K;
 }
 
 const Matrix&
 DispBeamColumn3d::getMass()
 {
-	K.Zero();
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+	theWork.K.Zero();
 
 	if (rho == 0.0)
-		return K;
+		return theWork.K;
 
 	double L = crdTransf->getInitialLength();
 	if (cMass == 0) {
 		// lumped mass matrix
 		double m = 0.5 * rho * L;
-		K(0, 0) = K(1, 1) = K(2, 2) = K(6, 6) = K(7, 7) = K(8, 8) = m;
+		theWork.K(0, 0) = theWork.K(1, 1) = theWork.K(2, 2) = theWork.K(6, 6) = theWork.K(7, 7) = theWork.K(8, 8) = m;
 	}
 	else {
 		// consistent mass matrix
-		static Matrix ml(12, 12);
+		Matrix &ml = theWork.ml;
 		double m = rho * L / 420.0;
 		ml(0, 0) = ml(6, 6) = m * 140.0;
 		ml(0, 6) = ml(6, 0) = m * 70.0;
@@ -900,10 +936,10 @@ DispBeamColumn3d::getMass()
 		ml(5, 7) = ml(7, 5) = -ml(1, 11);
 
 		// transform local mass matrix to global system
-		K = crdTransf->getGlobalMatrixFromLocal(ml);
+		theWork.K = crdTransf->getGlobalMatrixFromLocal(ml);
 	}
 
-	return K;
+	return theWork.K;
 }
 
 void
@@ -1010,6 +1046,7 @@ DispBeamColumn3d::addLoad(ElementalLoad* theLoad, double loadFactor)
 int
 DispBeamColumn3d::addInertiaLoadToUnbalance(const Vector& accel)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// Check for a quick return
 	if (rho == 0.0)
 		return 0;
@@ -1039,7 +1076,7 @@ DispBeamColumn3d::addInertiaLoadToUnbalance(const Vector& accel)
 	}
 	else {
 		// use matrix vector multip. for consistent mass matrix
-		static Vector Raccel(12);
+		Vector &Raccel = theWork.Raccel;
 		for (int i = 0; i < 6; i++) {
 			Raccel(i) = Raccel1(i);
 			Raccel(i + 6) = Raccel2(i);
@@ -1053,6 +1090,7 @@ DispBeamColumn3d::addInertiaLoadToUnbalance(const Vector& accel)
 const Vector&
 DispBeamColumn3d::getResistingForce()
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	double L = crdTransf->getInitialLength();
 
 	//const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
@@ -1112,13 +1150,13 @@ DispBeamColumn3d::getResistingForce()
 
   // Transform forces
   Vector p0Vec(p0, 5);
-  P = crdTransf->getGlobalResistingForce(q, p0Vec);
+  theWork.P = crdTransf->getGlobalResistingForce(q, p0Vec);
 
 	// Subtract other external nodal loads ... P_res = P_int - P_ext
 	if (rho != 0)
-		P.addVector(1.0, Q, -1.0);
+		theWork.P.addVector(1.0, Q, -1.0);
 
-	return P;
+	return theWork.P;
 }
 
 const Vector &
@@ -1132,9 +1170,10 @@ DispBeamColumn3d::getDampingForce(void)
 const Vector&
 DispBeamColumn3d::getResistingForceIncInertia()
 {
-  P = this->getResistingForce();
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+  theWork.P = this->getResistingForce();
   
-  if (theDamping) P += this->getDampingForce();
+  if (theDamping) theWork.P += this->getDampingForce();
   
   if (rho != 0.0) {
     const Vector &accel1 = theNodes[0]->getTrialAccel();
@@ -1145,35 +1184,35 @@ DispBeamColumn3d::getResistingForceIncInertia()
     double L = crdTransf->getInitialLength();
     double m = 0.5*rho*L;
   
-    P(0) += m*accel1(0);
-    P(1) += m*accel1(1);
-    P(2) += m*accel1(2);
-    P(6) += m*accel2(0);
-    P(7) += m*accel2(1);
-    P(8) += m*accel2(2);
+    theWork.P(0) += m*accel1(0);
+    theWork.P(1) += m*accel1(1);
+    theWork.P(2) += m*accel1(2);
+    theWork.P(6) += m*accel2(0);
+    theWork.P(7) += m*accel2(1);
+    theWork.P(8) += m*accel2(2);
   } else  {
     // use matrix vector multip. for consistent mass matrix
-    static Vector accel(12);
+    Vector &accel = theWork.accel;
     for (int i=0; i<6; i++)  {
       accel(i)   = accel1(i);
       accel(i+6) = accel2(i);
     }
-    P.addMatrixVector(1.0, this->getMass(), accel, 1.0);
+    theWork.P.addMatrixVector(1.0, this->getMass(), accel, 1.0);
   }
     
     // add the damping forces if rayleigh damping
     if (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
-      P.addVector(1.0, this->getRayleighDampingForces(), 1.0);
+      theWork.P.addVector(1.0, this->getRayleighDampingForces(), 1.0);
 
 	}
 	else {
 
 		// add the damping forces if rayleigh damping
 		if (betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
-			P.addVector(1.0, this->getRayleighDampingForces(), 1.0);
+			theWork.P.addVector(1.0, this->getRayleighDampingForces(), 1.0);
 	}
 
-	return P;
+	return theWork.P;
 }
 
 int
@@ -1574,6 +1613,7 @@ DispBeamColumn3d::displaySelf(Renderer& theViewer, int displayMode, float fact,
 Response*
 DispBeamColumn3d::setResponse(const char** argv, int argc, OPS_Stream& output)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 #ifdef _CSS
 	Response* theResponse = Element::setResponse(argv, argc, output);
 	if (theResponse != 0)
@@ -1611,7 +1651,7 @@ DispBeamColumn3d::setResponse(const char** argv, int argc, OPS_Stream& output)
 		output.tag("ResponseType", "Mz_2");
 
 
-		theResponse = new ElementResponse(this, 1, P);
+		theResponse = new ElementResponse(this, 1, theWork.P);
 
 		// local force -
 	}
@@ -1630,7 +1670,7 @@ DispBeamColumn3d::setResponse(const char** argv, int argc, OPS_Stream& output)
 		output.tag("ResponseType", "My_2");
 		output.tag("ResponseType", "Mz_2");
 
-      theResponse = new ElementResponse(this, 2, P);
+      theResponse = new ElementResponse(this, 2, theWork.P);
     }
     else if (strcmp(argv[0],"basicForce") == 0 || strcmp(argv[0],"basicForces") == 0) {
       output.tag("ResponseType","N");
@@ -1662,7 +1702,7 @@ DispBeamColumn3d::setResponse(const char** argv, int argc, OPS_Stream& output)
       output.tag("ResponseType","Mz_2");
 
 
-      theResponse = new ElementResponse(this, 21, P);
+      theResponse = new ElementResponse(this, 21, theWork.P);
 
     // local damping force -
     } else if (theDamping && (strcmp(argv[0],"localDampingForce") == 0 || strcmp(argv[0],"localDampingForces") == 0)) {
@@ -1680,7 +1720,7 @@ DispBeamColumn3d::setResponse(const char** argv, int argc, OPS_Stream& output)
       output.tag("ResponseType","My_2");
       output.tag("ResponseType","Mz_2");
 
-      theResponse = new ElementResponse(this, 22, P);
+      theResponse = new ElementResponse(this, 22, theWork.P);
 
     } else if (theDamping && (strcmp(argv[0],"basicDampingForce") == 0 || strcmp(argv[0],"basicDampingForces") == 0)) {
 
@@ -1723,7 +1763,7 @@ DispBeamColumn3d::setResponse(const char** argv, int argc, OPS_Stream& output)
 	}
 	else if (strcmp(argv[0], "RayleighForces") == 0 || strcmp(argv[0], "rayleighForces") == 0) {
 
-		theResponse = new ElementResponse(this, 12, P);
+		theResponse = new ElementResponse(this, 12, theWork.P);
 
 	}
 	else if (strcmp(argv[0], "integrationPoints") == 0)
@@ -1841,6 +1881,7 @@ DispBeamColumn3d::setResponse(const char** argv, int argc, OPS_Stream& output)
 int
 DispBeamColumn3d::getResponse(int responseID, Information& eleInfo)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 #ifdef _CSS
 	if (Element::getResponse(responseID, eleInfo) == 0)
 		return 0;
@@ -1858,33 +1899,33 @@ DispBeamColumn3d::getResponse(int responseID, Information& eleInfo)
 	else if (responseID == 2) {
 		// Axial
 		N = q(0);
-		P(6) = N;
-		P(0) = -N + p0[0];
+		theWork.P(6) = N;
+		theWork.P(0) = -N + p0[0];
 
 		// Torsion
 		T = q(5);
-		P(9) = T;
-		P(3) = -T;
+		theWork.P(9) = T;
+		theWork.P(3) = -T;
 
 		// Moments about z and shears along y
 		M1 = q(1);
 		M2 = q(2);
-		P(5) = M1;
-		P(11) = M2;
+		theWork.P(5) = M1;
+		theWork.P(11) = M2;
 		V = (M1 + M2) * oneOverL;
-		P(1) = V + p0[1];
-		P(7) = -V + p0[2];
+		theWork.P(1) = V + p0[1];
+		theWork.P(7) = -V + p0[2];
 
 		// Moments about y and shears along z
 		M1 = q(3);
 		M2 = q(4);
-		P(4) = M1;
-		P(10) = M2;
+		theWork.P(4) = M1;
+		theWork.P(10) = M2;
 		V = (M1 + M2) * oneOverL;
-		P(2) = -V + p0[3];
-		P(8) = V + p0[4];
+		theWork.P(2) = -V + p0[3];
+		theWork.P(8) = V + p0[4];
 
-    return eleInfo.setVector(P);
+    return eleInfo.setVector(theWork.P);
   }
 
   else if (responseID == 21)
@@ -1895,32 +1936,32 @@ DispBeamColumn3d::getResponse(int responseID, Information& eleInfo)
     Sd = theDamping->getDampingForce();
     // Axial
     N = Sd(0);
-    P(6) =  N;
-    P(0) = -N;
+    theWork.P(6) =  N;
+    theWork.P(0) = -N;
     
     // Torsion
     T = Sd(5);
-    P(9) =  T;
-    P(3) = -T;
+    theWork.P(9) =  T;
+    theWork.P(3) = -T;
     
     // Moments about z and shears along y
     M1 = Sd(1);
     M2 = Sd(2);
-    P(5)  = M1;
-    P(11) = M2;
+    theWork.P(5)  = M1;
+    theWork.P(11) = M2;
     V = (M1+M2)*oneOverL;
-    P(1) =  V;
-    P(7) = -V;
+    theWork.P(1) =  V;
+    theWork.P(7) = -V;
     
     // Moments about y and shears along z
     M1 = Sd(3);
     M2 = Sd(4);
-    P(4)  = M1;
-    P(10) = M2;
+    theWork.P(4)  = M1;
+    theWork.P(10) = M2;
     V = (M1+M2)*oneOverL;
-    P(2) = -V;
-    P(8) =  V;
-    return eleInfo.setVector(P);
+    theWork.P(2) = -V;
+    theWork.P(8) =  V;
+    return eleInfo.setVector(theWork.P);
   }
 
   else if (responseID == 23)
@@ -2114,24 +2155,26 @@ DispBeamColumn3d::activateParameter(int passedParameterID)
 const Matrix&
 DispBeamColumn3d::getInitialStiffSensitivity(int gradNumber)
 {
-	K.Zero();
-	return K;
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+	theWork.K.Zero();
+	return theWork.K;
 }
 
 const Matrix&
 DispBeamColumn3d::getMassSensitivity(int gradNumber)
 {
-	K.Zero();
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+	theWork.K.Zero();
 
 	if (rho == 0.0 || parameterID != 1)
-		return K;
+		return theWork.K;
 
 	double L = crdTransf->getInitialLength();
 	if (cMass == 0) {
 		// lumped mass matrix
 		//double m = 0.5*rho*L;
 		double m = 0.5 * L;
-		K(0, 0) = K(1, 1) = K(2, 2) = K(6, 6) = K(7, 7) = K(8, 8) = m;
+		theWork.K(0, 0) = theWork.K(1, 1) = theWork.K(2, 2) = theWork.K(6, 6) = theWork.K(7, 7) = theWork.K(8, 8) = m;
 	}
 	else {
 		// consistent mass matrix
@@ -2162,10 +2205,10 @@ DispBeamColumn3d::getMassSensitivity(int gradNumber)
 		ml(5, 7) = ml(7, 5) = -ml(1, 11);
 
 		// transform local mass matrix to global system
-		K = crdTransf->getGlobalMatrixFromLocal(ml);
+		theWork.K = crdTransf->getGlobalMatrixFromLocal(ml);
 	}
 
-	return K;
+	return theWork.K;
 }
 
 
@@ -2173,6 +2216,7 @@ DispBeamColumn3d::getMassSensitivity(int gradNumber)
 const Vector&
 DispBeamColumn3d::getResistingForceSensitivity(int gradNumber)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	double L = crdTransf->getInitialLength();
 	double oneOverL = 1.0 / L;
 
@@ -2229,7 +2273,7 @@ DispBeamColumn3d::getResistingForceSensitivity(int gradNumber)
 	// Transform forces
 	static Vector dp0dh(6);		// No distributed loads
 
-	P.Zero();
+	theWork.P.Zero();
 
 	//////////////////////////////////////////////////////////////
 
@@ -2258,7 +2302,7 @@ DispBeamColumn3d::getResistingForceSensitivity(int gradNumber)
 			const Vector& s = theSections[i]->getStressResultant();
 			const Matrix& ks = theSections[i]->getSectionTangent();
 
-			Matrix ka(workArea, order, 6);
+			Matrix ka(theWork.workArea, order, 6);
 			ka.Zero();
 
 			double si;
@@ -2342,13 +2386,13 @@ DispBeamColumn3d::getResistingForceSensitivity(int gradNumber)
 		dqdh.addMatrixVector(1.0, kbmine, dAdh_u, oneOverL);
 
 		// dAdh^T q
-		P += crdTransf->getGlobalResistingForceShapeSensitivity(q, dp0dh, gradNumber);
+		theWork.P += crdTransf->getGlobalResistingForceShapeSensitivity(q, dp0dh, gradNumber);
 	}
 
 	// A^T (dqdh + k dAdh u)
-	P += crdTransf->getGlobalResistingForce(dqdh, dp0dh);
+	theWork.P += crdTransf->getGlobalResistingForce(dqdh, dp0dh);
 
-	return P;
+	return theWork.P;
 }
 
 
@@ -2357,6 +2401,7 @@ DispBeamColumn3d::getResistingForceSensitivity(int gradNumber)
 int
 DispBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// Get basic deformation and sensitivities
 	const Vector& v = crdTransf->getBasicTrialDisp();
 
@@ -2378,7 +2423,7 @@ DispBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
 		int order = theSections[i]->getOrder();
 		const ID& code = theSections[i]->getType();
 
-		Vector e(workArea, order);
+		Vector e(theWork.workArea, order);
 
 		//double xi6 = 6.0*pts(i,0);
 		double xi6 = 6.0 * xi[i];
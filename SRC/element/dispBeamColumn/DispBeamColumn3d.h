@@ -73,6 +73,7 @@ class DispBeamColumn3d : public Element
     int commitState(void);
     int revertToLastCommit(void);
     int revertToStart(void);
+    bool isReentrant(void) const;
 
     // public methods to obtain stiffness, mass, damping and residual information    
     int update(void);
@@ -122,8 +123,9 @@ class DispBeamColumn3d : public Element
 
     Node *theNodes[2];
 
-    static Matrix K;		// Element stiffness, damping, and mass Matrix
-    static Vector P;		// Element resisting force vector
+    // work storage shared by all elements of this class; every thread
+    // obtains its own Workspace from its ScratchArena
+    struct Workspace;
 
     Vector Q;      // Applied nodal loads
     Vector q;      // Basic force
@@ -139,7 +141,6 @@ class DispBeamColumn3d : public Element
 
     enum {maxNumSections = 20};
 
-    static double workArea[];
 };
 
 #endif
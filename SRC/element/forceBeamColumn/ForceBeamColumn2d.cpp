@@ -78,15 +78,43 @@ Journal of Structural Engineering, Approved for publication, February 2007.
 #include <CompositeResponse.h>
 #include <ElementalLoad.h>
 #include <ElementIter.h>
+#include <ScratchArena.h>
+#include <FixedSizeInverse.h>
 #include <map>
 
-Matrix ForceBeamColumn2d::theMatrix(6, 6);
-Vector ForceBeamColumn2d::theVector(6);
-double ForceBeamColumn2d::workArea[200];
+struct ForceBeamColumn2d::Workspace {
+  Matrix theMatrix;
+  Vector theVector;
+  double workArea[200];
 
-Vector ForceBeamColumn2d::vsSubdivide[maxNumSections];
-Matrix ForceBeamColumn2d::fsSubdivide[maxNumSections];
-Vector ForceBeamColumn2d::SsrSubdivide[maxNumSections];
+  // subdivision of the displacement increment in update()
+  Vector vsSubdivide[maxNumSections];
+  Matrix fsSubdivide[maxNumSections];
+  Vector SsrSubdivide[maxNumSections];
+
+  // update()
+  Vector dv, vin, vr, dSe, dvToDo, dvTrial, SeTrial;
+  Matrix f, kvTrial;
+  Vector Ss, dSs, dvs;
+  Matrix fb;
+
+  // getInitialStiff()
+  Matrix fInit, kvInit;
+
+  // computedqdh() and computedfedh()
+  Vector dqdh;
+  Matrix dfedh;
+
+  Workspace()
+    :theMatrix(NEGD,NEGD), theVector(NEGD),
+     dv(NEBD), vin(NEBD), vr(NEBD), dSe(NEBD), dvToDo(NEBD), dvTrial(NEBD),
+     SeTrial(NEBD), f(NEBD,NEBD), kvTrial(NEBD,NEBD),
+     fInit(NEBD,NEBD), kvInit(NEBD,NEBD),
+     dqdh(NEBD), dfedh(NEBD,NEBD)
+  {}
+};
+
+static const int workSlot = ScratchArena::newSlot();
 
 void* OPS_ForceBeamColumn2d()
 {
@@ -685,7 +713,7 @@ ForceBeamColumn2d::ForceBeamColumn2d():
   fs(0), vs(0), Ssr(0), vscommit(0), 
   numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(6),
   Ki(0), maxSubdivisions(1), subdivideFactor(1.0), parameterID(0),
-  theDamping(0)
+  theDamping(0), numEleLoadsConverged(0), stateCurrent(false)
 {
 	load.Zero();
 
@@ -712,7 +740,7 @@ ForceBeamColumn2d::ForceBeamColumn2d (int tag, int nodeI, int nodeJ,
   fs(0), vs(0),Ssr(0), vscommit(0), 
   numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(6),
   Ki(0), maxSubdivisions(maxNumSub), subdivideFactor(subFac), parameterID(0),
-  theDamping(0)
+  theDamping(0), numEleLoadsConverged(0), stateCurrent(false)
 {
   if (maxSubdivisions < 1)
     maxSubdivisions = 1;
@@ -886,6 +914,8 @@ ForceBeamColumn2d::setDomain(Domain* theDomain)
 
 	if (initialFlag == 0)
 		this->initializeSectionHistoryVariables();
+
+	stateCurrent = false;
 }
 
 int
@@ -1021,6 +1051,21 @@ int ForceBeamColumn2d::revertToStart()
   return err;
 }
 
+bool
+ForceBeamColumn2d::isReentrant(void) const
+{
+  // the element keeps its work storage per thread; its sections and
+  // transformation must be reentrant as well, its damping is not assumed to be
+  if (theDamping != 0 || crdTransf->isReentrant() == false)
+    return false;
+
+  for (int i = 0; i < numSections; i++)
+    if (sections[i]->isReentrant() == false)
+      return false;
+
+  return true;
+}
+
 
 const Matrix&
 ForceBeamColumn2d::getInitialStiff(void)
@@ -1029,12 +1074,14 @@ ForceBeamColumn2d::getInitialStiff(void)
 	if (Ki != 0)
 		return *Ki;
 
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+
 	/*
 	else
 	  Ki = new Matrix(this->getTangentStiff());
 	*/
 
-	static Matrix f(NEBD, NEBD);   // element flexibility matrix  
+	Matrix &f = theWork.fInit;   // element flexibility matrix  
 	this->getInitialFlexibility(f);
 
 	/*
@@ -1051,8 +1098,9 @@ ForceBeamColumn2d::getInitialStiff(void)
 	  opserr << "ForceBeamColumn2d::getInitialStiff() -- could not invert flexibility\n";
 	*/
 
-  static Matrix kvInit(NEBD, NEBD);
-  f.Invert(kvInit);
+  Matrix &kvInit = theWork.kvInit;
+  if (invertFixedSize<NEBD>(&f(0,0), &kvInit(0,0)) < 0)
+    opserr << "ForceBeamColumn2d::getInitialStiff() -- could not invert flexibility for element with tag: " << this->getTag() << endln;
   if(theDamping) kvInit *= theDamping->getStiffnessMultiplier();
   Ki = new Matrix(crdTransf->getInitialGlobalStiffMatrix(kvInit));
   return *Ki;
@@ -1184,6 +1232,7 @@ ForceBeamColumn2d::computeReactionSensitivity(double* dp0dh, int gradNumber)
 const Vector&
 ForceBeamColumn2d::getResistingForce(void)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// Will remove once we clean up the corotational 2d transformation -- MHS
 	crdTransf->update();
 
@@ -1194,12 +1243,12 @@ ForceBeamColumn2d::getResistingForce(void)
 	if (numEleLoads > 0)
 		this->computeReactions(p0);
 	// Compute the current resisting force
-	theVector = crdTransf->getGlobalResistingForce(Se, p0Vec);
+	theWork.theVector = crdTransf->getGlobalResistingForce(Se, p0Vec);
 
 	if (rho != 0)
-		theVector.addVector(1.0, load, -1.0);
+		theWork.theVector.addVector(1.0, load, -1.0);
 
-	return theVector;
+	return theWork.theVector;
 }
 
 const Vector &
@@ -1229,6 +1278,7 @@ ForceBeamColumn2d::initializeSectionHistoryVariables(void)
 int
 ForceBeamColumn2d::update()
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// if have completed a recvSelf() - do a revertToLastCommit
 	// to get Ssr, etc. set correctly
 	if (initialFlag == 2)
@@ -1240,14 +1290,27 @@ ForceBeamColumn2d::update()
 	// get basic displacements and increments
 	const Vector& v = crdTransf->getBasicTrialDisp();
 
-	static Vector dv(NEBD);
+	Vector &dv = theWork.dv;
 
 	dv = crdTransf->getBasicIncrDeltaDisp();
 
 	if (initialFlag != 0 && dv.Norm() <= DBL_EPSILON && numEleLoads == 0)
 		return 0;
 
-	static Vector vin(NEBD);
+	// quick return if the basic deformations and element loads are those
+	// of the last converged state; the damping, which may depend on time,
+	// is always updated
+	if (initialFlag == 1 && stateCurrent && theDamping == 0 &&
+	    numEleLoads == numEleLoadsConverged) {
+		int k = 0;
+		while (k < NEBD && v(k) == vConverged[k])
+			k++;
+		if (k == NEBD)
+			return 0;
+	}
+	stateCurrent = false;
+
+	Vector &vin = theWork.vin;
 	vin = v;
 	vin -= dv;
 
@@ -1260,24 +1323,19 @@ ForceBeamColumn2d::update()
 	double wt[maxNumSections];
 	beamIntegr->getSectionWeights(numSections, L, wt);
 
-	static Vector vr(NEBD);       // element residual displacements
-	static Matrix f(NEBD, NEBD);   // element flexibility matrix
+	Vector &vr = theWork.vr;       // element residual displacements
+	Matrix &f = theWork.f;   // element flexibility matrix
 
-	static Matrix I(NEBD, NEBD);   // an identity matrix for matrix inverse
 	double dW;                    // section strain energy (work) norm 
 	int i, j;
 
-	I.Zero();
-	for (i = 0; i < NEBD; i++)
-		I(i, i) = 1.0;
-
 	int numSubdivide = 1;
 	bool converged = false;
-	static Vector dSe(NEBD);
-	static Vector dvToDo(NEBD);
-	static Vector dvTrial(NEBD);
-	static Vector SeTrial(NEBD);
-	static Matrix kvTrial(NEBD, NEBD);
+	Vector &dSe = theWork.dSe;
+	Vector &dvToDo = theWork.dvToDo;
+	Vector &dvTrial = theWork.dvTrial;
+	Vector &SeTrial = theWork.SeTrial;
+	Matrix &kvTrial = theWork.kvTrial;
 
 	dvToDo = dv;
 	dvTrial = dvToDo;
@@ -1308,9 +1366,9 @@ ForceBeamColumn2d::update()
 			SeTrial = Se;
 			kvTrial = kv;
 			for (i = 0; i < numSections; i++) {
-				vsSubdivide[i] = vs[i];
-				fsSubdivide[i] = fs[i];
-				SsrSubdivide[i] = Ssr[i];
+				theWork.vsSubdivide[i] = vs[i];
+				theWork.fsSubdivide[i] = fs[i];
+				theWork.SsrSubdivide[i] = Ssr[i];
 			}
 
 			// calculate nodal force increments and update nodal forces      
@@ -1334,15 +1392,15 @@ ForceBeamColumn2d::update()
 						int order = sections[i]->getOrder();
 						const ID& code = sections[i]->getType();
 
-						static Vector Ss;
-						static Vector dSs;
-						static Vector dvs;
-						static Matrix fb;
+						Vector &Ss = theWork.Ss;
+						Vector &dSs = theWork.dSs;
+						Vector &dvs = theWork.dvs;
+						Matrix &fb = theWork.fb;
 
-						Ss.setData(workArea, order);
-						dSs.setData(&workArea[order], order);
-						dvs.setData(&workArea[2 * order], order);
-						fb.setData(&workArea[3 * order], order, NEBD);
+						Ss.setData(theWork.workArea, order);
+						dSs.setData(&theWork.workArea[order], order);
+						dvs.setData(&theWork.workArea[2 * order], order);
+						fb.setData(&theWork.workArea[3 * order], order, NEBD);
 
 						double xL = xi[i];
 						double xL1 = xL - 1.0;
@@ -1376,7 +1434,7 @@ ForceBeamColumn2d::update()
 
 						// dSs = Ss - Ssr[i];
 						dSs = Ss;
-						dSs.addVector(1.0, SsrSubdivide[i], -1.0);
+						dSs.addVector(1.0, theWork.SsrSubdivide[i], -1.0);
 
 						// compute section deformation increments
 						if (l == 0) {
@@ -1384,7 +1442,7 @@ ForceBeamColumn2d::update()
 							//  regular newton 
 							//    vs += fs * dSs;     
 
-							dvs.addMatrixVector(0.0, fsSubdivide[i], dSs, 1.0);
+							dvs.addMatrixVector(0.0, theWork.fsSubdivide[i], dSs, 1.0);
 						}
 						else if (l == 2) {
 
@@ -1399,7 +1457,7 @@ ForceBeamColumn2d::update()
 								dvs.addMatrixVector(0.0, fs0, dSs, 1.0);
 							}
 							else
-								dvs.addMatrixVector(0.0, fsSubdivide[i], dSs, 1.0);
+								dvs.addMatrixVector(0.0, theWork.fsSubdivide[i], dSs, 1.0);
 
 						}
 						else {
@@ -1413,31 +1471,31 @@ ForceBeamColumn2d::update()
 
 						// set section deformations
 						if (initialFlag != 0)
-							vsSubdivide[i] += dvs;
+							theWork.vsSubdivide[i] += dvs;
 
-						if (sections[i]->setTrialSectionDeformation(vsSubdivide[i]) < 0) {
+						if (sections[i]->setTrialSectionDeformation(theWork.vsSubdivide[i]) < 0) {
 							opserr << "ForceBeamColumn2d::update() - section failed in setTrial\n";
 							return -1;
 						}
 
 						// get section resisting forces
-						SsrSubdivide[i] = sections[i]->getStressResultant();
+						theWork.SsrSubdivide[i] = sections[i]->getStressResultant();
 
 						// get section flexibility matrix
-						fsSubdivide[i] = sections[i]->getSectionFlexibility();
+						theWork.fsSubdivide[i] = sections[i]->getSectionFlexibility();
 
 						// calculate section residual deformations
 						// dvs = fs * (Ss - Ssr);
 						dSs = Ss;
-						dSs.addVector(1.0, SsrSubdivide[i], -1.0);  // dSs = Ss - Ssr[i];
+						dSs.addVector(1.0, theWork.SsrSubdivide[i], -1.0);  // dSs = Ss - Ssr[i];
 
-						dvs.addMatrixVector(0.0, fsSubdivide[i], dSs, 1.0);
+						dvs.addMatrixVector(0.0, theWork.fsSubdivide[i], dSs, 1.0);
 
 						// integrate element flexibility matrix
 						// f = f + (b^ fs * b) * wtL;
 						//f.addMatrixTripleProduct(1.0, b[i], fs[i], wtL);
 						int jj;
-						const Matrix& fSec = fsSubdivide[i];
+						const Matrix& fSec = theWork.fsSubdivide[i];
 						fb.Zero();
 						double tmp;
 						for (ii = 0; ii < order; ii++) {
@@ -1493,7 +1551,7 @@ ForceBeamColumn2d::update()
 						// integrate residual deformations
 						// vr += (b^ (vs + dvs)) * wtL;
 						//vr.addMatrixTransposeVector(1.0, b[i], vs[i] + dvs, wtL);
-						dvs.addVector(1.0, vsSubdivide[i], 1.0);
+						dvs.addVector(1.0, theWork.vsSubdivide[i], 1.0);
 						double dei;
 						for (ii = 0; ii < order; ii++) {
 							dei = dvs(ii) * wtL;
@@ -1516,7 +1574,7 @@ ForceBeamColumn2d::update()
 
 					// calculate element stiffness matrix
 					// invert3by3Matrix(f, kv);	  
-					if (f.Solve(I, kvTrial) < 0)
+					if (invertFixedSize<NEBD>(&f(0,0), &kvTrial(0,0)) < 0)
 						opserr << "ForceBeamColumn2d::update() -- could not invert flexibility for element with tag: " << this->getTag() << endln;
 
 					// dv = vin + dvTrial  - vr
@@ -1557,9 +1615,9 @@ ForceBeamColumn2d::update()
 						Se = SeTrial;
 
 						for (int k = 0; k < numSections; k++) {
-							vs[k] = vsSubdivide[k];
-							fs[k] = fsSubdivide[k];
-							Ssr[k] = SsrSubdivide[k];
+							vs[k] = theWork.vsSubdivide[k];
+							fs[k] = theWork.fsSubdivide[k];
+							Ssr[k] = theWork.SsrSubdivide[k];
 						}
 
 						// break out of j & l loops
@@ -1599,6 +1657,11 @@ ForceBeamColumn2d::update()
 
 	initialFlag = 1;
 
+	for (i = 0; i < NEBD; i++)
+		vConverged[i] = v(i);
+	numEleLoadsConverged = numEleLoads;
+	stateCurrent = true;
+
 	return 0;
 }
 
@@ -1650,13 +1713,14 @@ void ForceBeamColumn2d::getDistrLoadInterpolatMatrix(double xi, Matrix& bp, cons
 const Matrix&
 ForceBeamColumn2d::getMass(void)
 {
-	theMatrix.Zero();
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+	theWork.theMatrix.Zero();
 
 	double L = crdTransf->getInitialLength();
 	if (rho != 0.0)
-		theMatrix(0, 0) = theMatrix(1, 1) = theMatrix(3, 3) = theMatrix(4, 4) = 0.5 * L * rho;
+		theWork.theMatrix(0, 0) = theWork.theMatrix(1, 1) = theWork.theMatrix(3, 3) = theWork.theMatrix(4, 4) = 0.5 * L * rho;
 
-	return theMatrix;
+	return theWork.theMatrix;
 }
 
 void
@@ -1694,6 +1758,11 @@ ForceBeamColumn2d::addLoad(ElementalLoad* theLoad, double loadFactor)
 		sizeEleLoads += 1;
 	}
 
+	// a load other than that at this position in the last converged state
+	if (numEleLoads >= numEleLoadsConverged || eleLoads[numEleLoads] != theLoad ||
+	    eleLoadFactors[numEleLoads] != loadFactor)
+		stateCurrent = false;
+
 	eleLoadFactors[numEleLoads] = loadFactor;
 	eleLoads[numEleLoads] = theLoad;
 	numEleLoads++;
@@ -2007,10 +2076,11 @@ ForceBeamColumn2d::addInertiaLoadToUnbalance(const Vector& accel)
 const Vector&
 ForceBeamColumn2d::getResistingForceIncInertia()
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	// Compute the current resisting force
-	theVector = this->getResistingForce();
+	theWork.theVector = this->getResistingForce();
 
-  if (theDamping) theVector += this->getDampingForce();
+  if (theDamping) theWork.theVector += this->getDampingForce();
 
   // Check for a quick return
   if (rho != 0.0) {
@@ -2020,23 +2090,23 @@ ForceBeamColumn2d::getResistingForceIncInertia()
     double L = crdTransf->getInitialLength();
     double m = 0.5*rho*L;
 
-		theVector(0) += m * accel1(0);
-		theVector(1) += m * accel1(1);
-		theVector(3) += m * accel2(0);
-		theVector(4) += m * accel2(1);
+		theWork.theVector(0) += m * accel1(0);
+		theWork.theVector(1) += m * accel1(1);
+		theWork.theVector(3) += m * accel2(0);
+		theWork.theVector(4) += m * accel2(1);
 
 		// add the damping forces if rayleigh damping
 		if (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
-			theVector += this->getRayleighDampingForces();
+			theWork.theVector += this->getRayleighDampingForces();
 
 	}
 	else {
 		// add the damping forces if rayleigh damping
 		if (betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
-			theVector += this->getRayleighDampingForces();
+			theWork.theVector += this->getRayleighDampingForces();
 	}
 
-	return theVector;
+	return theWork.theVector;
 }
 
 int
@@ -2047,7 +2117,7 @@ ForceBeamColumn2d::sendSelf(int commitTag, Channel& theChannel)
 	int i, j, k;
 	int loc = 0;
 
-  static ID idData(13);  // one bigger than needed so no clash later
+  ID idData(13);  // one bigger than needed so no clash later
   idData(0) = this->getTag();
   idData(1) = connectedExternalNodes(0);
   idData(2) = connectedExternalNodes(1);
@@ -2203,7 +2273,7 @@ ForceBeamColumn2d::recvSelf(int commitTag, Channel& theChannel, FEM_ObjectBroker
   int dbTag = this->getDbTag();
   int i,j,k;
   
-  static ID idData(13); // one bigger than needed 
+  ID idData(13); // one bigger than needed 
 
 	if (theChannel.recvID(dbTag, commitTag, idData) < 0) {
 		opserr << "ForceBeamColumn2d::recvSelf() - failed to recv ID data\n";
@@ -2510,6 +2580,7 @@ ForceBeamColumn2d::recvSelf(int commitTag, Channel& theChannel, FEM_ObjectBroker
 int
 ForceBeamColumn2d::getInitialFlexibility(Matrix& fe)
 {
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
   fe.Zero();
   
   double L = crdTransf->getInitialLength();
@@ -2526,7 +2597,7 @@ ForceBeamColumn2d::getInitialFlexibility(Matrix& fe)
     int order      = sections[i]->getOrder();
     const ID &code = sections[i]->getType();
     
-    Matrix fb(workArea, order, NEBD);
+    Matrix fb(theWork.workArea, order, NEBD);
     
     double xL  = xi[i];
     double xL1 = xL-1.0;
@@ -2592,6 +2663,7 @@ ForceBeamColumn2d::getInitialFlexibility(Matrix& fe)
 int
 ForceBeamColumn2d::getInitialDeformations(Vector& v0)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	v0.Zero();
 	if (numEleLoads < 1)
 		return 0;
@@ -2614,16 +2686,14 @@ ForceBeamColumn2d::getInitialDeformations(Vector& v0)
 		double xL1 = xL - 1.0;
 		double wtL = wt[i] * L;
 
-		static Vector sp;
-		sp.setData(workArea, order);
+		Vector sp(theWork.workArea, order);
 		sp.Zero();
 
 		this->computeSectionForces(sp, i);
 
 		const Matrix& fse = sections[i]->getInitialFlexibility();
 
-		static Vector e;
-		e.setData(&workArea[order], order);
+		Vector e(&theWork.workArea[order], order);
 
 		e.addMatrixVector(0.0, fse, sp, 1.0);
 
@@ -2653,7 +2723,7 @@ ForceBeamColumn2d::getInitialDeformations(Vector& v0)
 void ForceBeamColumn2d::compSectionDisplacements(Vector sectionCoords[], Vector sectionDispls[]) const
 {
 	// get basic displacements and increments
-	static Vector ub(NEBD);
+	Vector ub(NEBD);
 	ub = crdTransf->getBasicTrialDisp();
 
 	double L = crdTransf->getInitialLength();
@@ -2661,7 +2731,7 @@ void ForceBeamColumn2d::compSectionDisplacements(Vector sectionCoords[], Vector
 	// get integration point positions and weights
 	//   const Matrix &xi_pt  = quadRule.getIntegrPointCoords(numSections);
 	// get integration point positions and weights
-	static double xi_pts[maxNumSections];
+	double xi_pts[maxNumSections];
 	beamIntegr->getSectionLocations(numSections, L, xi_pts);
 
 	// setup Vandermode and CBDI influence matrices
@@ -2674,7 +2744,7 @@ void ForceBeamColumn2d::compSectionDisplacements(Vector sectionCoords[], Vector
 
 	// get section curvatures
 	Vector kappa(numSections);  // curvature
-	static Vector vs;              // section deformations 
+	Vector vs;              // section deformations 
 
 	for (i = 0; i < numSections; i++)
 	{
@@ -2700,8 +2770,8 @@ void ForceBeamColumn2d::compSectionDisplacements(Vector sectionCoords[], Vector
 	}
 
 	Vector w(numSections);
-	static Vector xl(NDM), uxb(NDM);
-	static Vector xg(NDM), uxg(NDM);
+	Vector xl(NDM), uxb(NDM);
+	Vector xg(NDM), uxg(NDM);
 
 	// w = ls * kappa;  
 	w.addMatrixVector(0.0, ls, kappa, 1.0);
@@ -2729,6 +2799,7 @@ void ForceBeamColumn2d::compSectionDisplacements(Vector sectionCoords[], Vector
 void
 ForceBeamColumn2d::Print(OPS_Stream& s, int flag)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	if (flag == 2) {
 
 		s << "#ForceBeamColumn2D\n";
@@ -2758,8 +2829,8 @@ ForceBeamColumn2d::Print(OPS_Stream& s, int flag)
 		s << "#END_FORCES " << P << " " << -V + p0[2] << " " << M2 << endln;
 
 		// plastic hinge rotation
-		static Vector vp(3);
-		static Matrix fe(3, 3);
+		Vector vp(3);
+		Matrix fe(3, 3);
 		this->getInitialFlexibility(fe);
 		vp = crdTransf->getBasicTrialDisp();
 		vp.addMatrixVector(1.0, fe, Se, -1.0);
@@ -2778,8 +2849,8 @@ ForceBeamColumn2d::Print(OPS_Stream& s, int flag)
 		double M2 = Secommit(2);
 		double L = crdTransf->getInitialLength();
 		double V = (M1 + M2) / L;
-		theVector(1) = V;
-		theVector(4) = -V;
+		theWork.theVector(1) = V;
+		theWork.theVector(4) = -V;
 		double p0[3]; p0[0] = 0.0; p0[1] = 0.0; p0[2] = 0.0;
 		if (numEleLoads > 0)
 			this->computeReactions(p0);
@@ -2873,8 +2944,8 @@ ForceBeamColumn2d::setSectionPointers(int numSec, SectionForceDeformation** secP
 int
 ForceBeamColumn2d::displaySelf(Renderer& theViewer, int displayMode, float fact, const char** displayModes, int numModes)
 {
-	static Vector v1(3);
-	static Vector v2(3);
+	Vector v1(3);
+	Vector v2(3);
 
 	theNodes[0]->getDisplayCrds(v1, fact, displayMode);
 	theNodes[1]->getDisplayCrds(v2, fact, displayMode);
@@ -2910,7 +2981,7 @@ ForceBeamColumn2d::setResponse(const char** argv, int argc, OPS_Stream& output)
 		output.tag("ResponseType", "Py_2");
 		output.tag("ResponseType", "Mz_2");
 
-		theResponse = new ElementResponse(this, 1, theVector);
+		theResponse = new ElementResponse(this, 1, Vector(NEGD));
 
 		// local force -
 	}
@@ -2923,7 +2994,7 @@ ForceBeamColumn2d::setResponse(const char** argv, int argc, OPS_Stream& output)
 		output.tag("ResponseType", "V_2");
 		output.tag("ResponseType", "M_2");
 
-		theResponse = new ElementResponse(this, 2, theVector);
+		theResponse = new ElementResponse(this, 2, Vector(NEGD));
 
 		// basic force -
 	}
@@ -2945,7 +3016,7 @@ ForceBeamColumn2d::setResponse(const char** argv, int argc, OPS_Stream& output)
     output.tag("ResponseType","Py_2");
     output.tag("ResponseType","Mz_2");
 
-    theResponse =  new ElementResponse(this, 21, theVector);
+    theResponse =  new ElementResponse(this, 21, Vector(NEGD));
 
   // local damping force -
   } else if (theDamping && (strcmp(argv[0],"localDampingForce") == 0 || strcmp(argv[0],"localDampingForces") == 0)) {
@@ -2957,7 +3028,7 @@ ForceBeamColumn2d::setResponse(const char** argv, int argc, OPS_Stream& output)
     output.tag("ResponseType","V_2");
     output.tag("ResponseType","M_2");
 
-    theResponse =  new ElementResponse(this, 22, theVector);
+    theResponse =  new ElementResponse(this, 22, Vector(NEGD));
 
   // basic damping force -
   } else if (theDamping && (strcmp(argv[0],"basicDampingForce") == 0 || strcmp(argv[0],"basicDampingForces") == 0)) {
@@ -3058,7 +3129,7 @@ ForceBeamColumn2d::setResponse(const char** argv, int argc, OPS_Stream& output)
 		output.tag("ResponseType", "Py_2");
 		output.tag("ResponseType", "Mz_2");
 
-    theResponse =  new ElementResponse(this, 13, theVector);
+    theResponse =  new ElementResponse(this, 13, Vector(NEGD));
   
     // section response -
   } else if (strcmp(argv[0],"sectionX") == 0) {
@@ -3178,12 +3249,13 @@ ForceBeamColumn2d::setResponse(const char** argv, int argc, OPS_Stream& output)
 int
 ForceBeamColumn2d::getResponse(int responseID, Information& eleInfo)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 #ifdef _CSS
 	if (Element::getResponse(responseID, eleInfo) == 0)
 		return 0;
 #endif // _CSS
-	static Vector vp(3);
-	static Matrix fe(3, 3);
+	Vector vp(3);
+	Matrix fe(3, 3);
 
 	if (responseID == 1)
 		return eleInfo.setVector(this->getResistingForce());
@@ -3195,14 +3267,14 @@ ForceBeamColumn2d::getResponse(int responseID, Information& eleInfo)
 		double p0[3]; p0[0] = 0.0; p0[1] = 0.0; p0[2] = 0.0;
 		if (numEleLoads > 0)
 			this->computeReactions(p0);
-		theVector(3) = Se(0);
-		theVector(0) = -Se(0) + p0[0];
-		theVector(2) = Se(1);
-		theVector(5) = Se(2);
+		theWork.theVector(3) = Se(0);
+		theWork.theVector(0) = -Se(0) + p0[0];
+		theWork.theVector(2) = Se(1);
+		theWork.theVector(5) = Se(2);
 		double V = (Se(1) + Se(2)) / crdTransf->getInitialLength();
-		theVector(1) = V + p0[1];
-		theVector(4) = -V + p0[2];
-		return eleInfo.setVector(theVector);
+		theWork.theVector(1) = V + p0[1];
+		theWork.theVector(4) = -V + p0[2];
+		return eleInfo.setVector(theWork.theVector);
 	}
 
 	// Chord rotation
@@ -3216,7 +3288,7 @@ ForceBeamColumn2d::getResponse(int responseID, Information& eleInfo)
 		this->getInitialFlexibility(fe);
 		vp = crdTransf->getBasicTrialDisp();
 		vp.addMatrixVector(1.0, fe, Se, -1.0);
-		static Vector v0(3);
+		Vector v0(3);
 		this->getInitialDeformations(v0);
 		vp.addVector(1.0, v0, -1.0);
 		return eleInfo.setVector(vp);
@@ -3282,7 +3354,7 @@ ForceBeamColumn2d::getResponse(int responseID, Information& eleInfo)
       d3 += (wts[i]*L)*kappa*b;
     }
     
-    static Vector d(2);
+    Vector d(2);
     d(0) = d2;
     d(1) = d3;
 
@@ -3298,14 +3370,14 @@ ForceBeamColumn2d::getResponse(int responseID, Information& eleInfo)
   else if (responseID == 22) {
     Vector Sd(NEBD);
     Sd = theDamping->getDampingForce();
-    theVector(3) =  Sd(0);
-    theVector(0) = -Sd(0);
-    theVector(2) = Sd(1);
-    theVector(5) = Sd(2);
+    theWork.theVector(3) =  Sd(0);
+    theWork.theVector(0) = -Sd(0);
+    theWork.theVector(2) = Sd(1);
+    theWork.theVector(5) = Sd(2);
     double V = (Sd(1)+Sd(2))/crdTransf->getInitialLength();
-    theVector(1) =  V;
-    theVector(4) = -V;
-    return eleInfo.setVector(theVector);
+    theWork.theVector(1) =  V;
+    theWork.theVector(4) = -V;
+    return eleInfo.setVector(theWork.theVector);
   }
 
   else if (responseID == 23)
@@ -3380,8 +3452,8 @@ ForceBeamColumn2d::getResponse(int responseID, Information& eleInfo)
 		Vector dispsy(numSections);
 		dispsy.addMatrixVector(0.0, ls, kappa, 1.0);
 		beamIntegr->getSectionLocations(numSections, L, pts);
-		static Vector uxb(2);
-		static Vector uxg(2);
+		Vector uxb(2);
+		Vector uxg(2);
 		Matrix disps(numSections, 3);
 		vp = crdTransf->getBasicTrialDisp();
 		for (int i = 0; i < numSections; i++) {
@@ -3417,8 +3489,8 @@ ForceBeamColumn2d::getResponse(int responseID, Information& eleInfo)
     // Displacement vector
     Vector dispsy(1);
     dispsy.addMatrixVector(0.0, ls, kappa, 1.0);
-    static Vector uxb(2);
-    static Vector uxg(2);
+    Vector uxb(2);
+    Vector uxg(2);
     Matrix disps(1,3);
     vp = crdTransf->getBasicTrialDisp();
     uxb(0) = pts[0]*vp(0); // linear shape function
@@ -3459,7 +3531,7 @@ ForceBeamColumn2d::getResponseSensitivity(int responseID, int gradNumber,
 
 	// Basic force sensitivity
 	else if (responseID == 7) {
-		static Vector dqdh(3);
+		Vector dqdh(3);
 
 		const Vector& dvdh = crdTransf->getBasicDisplSensitivity(gradNumber);
 
@@ -3484,7 +3556,7 @@ ForceBeamColumn2d::getResponseSensitivity(int responseID, int gradNumber,
 			this->computeSectionForceSensitivity(dsdh, sectionNum - 1, gradNumber);
 		}
 		//opserr << "FBC2d::getRespSens dspdh: " << dsdh;
-		static Vector dqdh(3);
+		Vector dqdh(3);
 
 		const Vector& dvdh = crdTransf->getBasicDisplSensitivity(gradNumber);
 
@@ -3562,14 +3634,14 @@ ForceBeamColumn2d::getResponseSensitivity(int responseID, int gradNumber,
 
 	// Plastic deformation sensitivity
 	else if (responseID == 4) {
-		static Vector dvpdh(3);
+		Vector dvpdh(3);
 
 		const Vector& dvdh = crdTransf->getBasicDisplSensitivity(gradNumber);
 
 		dvpdh = dvdh;
 		//opserr << dvpdh;
 
-		static Matrix fe(3, 3);
+		Matrix fe(3, 3);
 		this->getInitialFlexibility(fe);
 
 		const Vector& dqdh = this->computedqdh(gradNumber);
@@ -3577,7 +3649,7 @@ ForceBeamColumn2d::getResponseSensitivity(int responseID, int gradNumber,
 		dvpdh.addMatrixVector(1.0, fe, dqdh, -1.0);
 		//opserr << dvpdh;
 
-		static Matrix fek(3, 3);
+		Matrix fek(3, 3);
 		fek.addMatrixProduct(0.0, fe, kv, 1.0);
 
 		dvpdh.addMatrixVector(1.0, fek, dvdh, -1.0);
@@ -3709,26 +3781,29 @@ ForceBeamColumn2d::activateParameter(int passedParameterID)
 const Matrix&
 ForceBeamColumn2d::getInitialStiffSensitivity(int gradNumber)
 {
-	theMatrix.Zero();
-	return theMatrix;
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+	theWork.theMatrix.Zero();
+	return theWork.theMatrix;
 }
 
 const Matrix&
 ForceBeamColumn2d::getMassSensitivity(int gradNumber)
 {
-	theMatrix.Zero();
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+	theWork.theMatrix.Zero();
 
 	double L = crdTransf->getInitialLength();
 	if (rho != 0.0 && parameterID == 1)
-		theMatrix(0, 0) = theMatrix(1, 1) = theMatrix(3, 3) = theMatrix(4, 4) = 0.5 * L;
+		theWork.theMatrix(0, 0) = theWork.theMatrix(1, 1) = theWork.theMatrix(3, 3) = theWork.theMatrix(4, 4) = 0.5 * L;
 
-	return theMatrix;
+	return theWork.theMatrix;
 }
 
 const Vector&
 ForceBeamColumn2d::getResistingForceSensitivity(int gradNumber)
 {
-	static Vector dqdh(3);
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+	Vector dqdh(3);
 	dqdh = this->computedqdh(gradNumber);
 
 	// Transform forces
@@ -3736,7 +3811,7 @@ ForceBeamColumn2d::getResistingForceSensitivity(int gradNumber)
 	this->computeReactionSensitivity(dp0dh, gradNumber);
 	Vector dp0dhVec(dp0dh, 3);
 
-	static Vector P(6);
+	Vector &P = theWork.theVector;
 	P.Zero();
 
 	if (crdTransf->isShapeSensitivity()) {
@@ -3756,6 +3831,7 @@ ForceBeamColumn2d::getResistingForceSensitivity(int gradNumber)
 int
 ForceBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	int err = 0;
 
 	double L = crdTransf->getInitialLength();
@@ -3774,7 +3850,7 @@ ForceBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
 
 	double d1oLdh = crdTransf->getd1overLdh();
 
-	static Vector dqdh(3);
+	Vector dqdh(3);
 	dqdh = this->computedqdh(gradNumber);
 
 	// dvdh = A dudh + dAdh u
@@ -3797,7 +3873,7 @@ ForceBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
 
 		double dxLdh = dptsdh[i];
 
-		Vector ds(workArea, order);
+		Vector ds(theWork.workArea, order);
 		ds.Zero();
 
 		// Add sensitivity wrt element loads
@@ -3839,7 +3915,7 @@ ForceBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
 			}
 		}
 
-		Vector de(&workArea[order], order);
+		Vector de(&theWork.workArea[order], order);
 		const Matrix& fs = sections[i]->getSectionFlexibility();
 		de.addMatrixVector(0.0, fs, ds, 1.0);
 
@@ -3852,6 +3928,7 @@ ForceBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
 const Vector&
 ForceBeamColumn2d::computedqdh(int gradNumber)
 {
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
 	//opserr << "FBC2d::computedqdh " << gradNumber << endln;
 
 	double L = crdTransf->getInitialLength();
@@ -3873,7 +3950,7 @@ ForceBeamColumn2d::computedqdh(int gradNumber)
 
 	double d1oLdh = crdTransf->getd1overLdh();
 
-	static Vector dvdh(3);
+	Vector dvdh(3);
 	dvdh.Zero();
 
 	// Loop over the integration points
@@ -3892,11 +3969,11 @@ ForceBeamColumn2d::computedqdh(int gradNumber)
 		//opserr << dptsdh[i] << ' ' << dwtsdh[i] << endln;
 
 		// Get section stress resultant gradient
-		Vector dsdh(&workArea[order], order);
+		Vector dsdh(&theWork.workArea[order], order);
 		dsdh = sections[i]->getStressResultantSensitivity(gradNumber, true);
 		//opserr << "FBC2d::dqdh -- " << gradNumber << ' ' << dsdh;
 
-		Vector dspdh(&workArea[2 * order], order);
+		Vector dspdh(&theWork.workArea[2 * order], order);
 		dspdh.Zero();
 		// Add sensitivity wrt element loads
 		if (numEleLoads > 0) {
@@ -3919,7 +3996,7 @@ ForceBeamColumn2d::computedqdh(int gradNumber)
 			}
 		}
 
-		Vector dedh(workArea, order);
+		Vector dedh(theWork.workArea, order);
 		const Matrix& fs = sections[i]->getSectionFlexibility();
 		dedh.addMatrixVector(0.0, fs, dsdh, 1.0);
 
@@ -3968,12 +4045,7 @@ ForceBeamColumn2d::computedqdh(int gradNumber)
 		}
 	}
 
-	static Matrix dfedh(3, 3);
-	dfedh.Zero();
-
-  //opserr << "dfedh: " << dfedh << endln;
-
-	static Vector dqdh(3);
+	Vector &dqdh = theWork.dqdh;
 	dqdh.addMatrixVector(0.0, kv, dvdh, 1.0);
 
 	//opserr << "dqdh: " << dqdh << endln;
@@ -3984,7 +4056,8 @@ ForceBeamColumn2d::computedqdh(int gradNumber)
 const Matrix&
 ForceBeamColumn2d::computedfedh(int gradNumber)
 {
-	static Matrix dfedh(3, 3);
+	Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+	Matrix &dfedh = theWork.dfedh;
 
 	dfedh.Zero();
 
@@ -4011,8 +4084,8 @@ ForceBeamColumn2d::computedfedh(int gradNumber)
 		int order = sections[i]->getOrder();
 		const ID& code = sections[i]->getType();
 
-		Matrix fb(workArea, order, NEBD);
-		Matrix fb2(&workArea[order * NEBD], order, NEBD);
+		Matrix fb(theWork.workArea, order, NEBD);
+		Matrix fb2(&theWork.workArea[order * NEBD], order, NEBD);
 
 		double xL = xi[i];
 		double xL1 = xL - 1.0;
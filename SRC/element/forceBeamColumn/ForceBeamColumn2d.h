@@ -101,6 +101,7 @@ class ForceBeamColumn2d: public Element
   int commitState(void);
   int revertToLastCommit(void);        
   int revertToStart(void);
+  bool isReentrant(void) const;
   int update(void);    
   
   const Matrix &getTangentStiff(void);
@@ -197,9 +198,9 @@ class ForceBeamColumn2d: public Element
 
   Matrix *Ki;
   
-  static Matrix theMatrix;
-  static Vector theVector;
-  static double workArea[];
+  // work storage shared by all elements of this class; every thread
+  // obtains its own Workspace from its ScratchArena
+  struct Workspace;
   
   enum {maxNumSections = 30};
   enum {maxSectionOrder = 5};
@@ -208,9 +209,6 @@ class ForceBeamColumn2d: public Element
   int    maxSubdivisions;       // maximum number of subdivisons of dv for local iterations
   double subdivideFactor;
   
-  static Vector vsSubdivide[];
-  static Vector SsrSubdivide[];
-  static Matrix fsSubdivide[];
   //static int maxNumSections;
 
   // AddingSensitivity:BEGIN //////////////////////////////////////////
@@ -222,6 +220,13 @@ class ForceBeamColumn2d: public Element
   // AddingSensitivity:END ///////////////////////////////////////////
 
   Damping *theDamping;
+
+  // basic deformations and number of element loads of the last converged
+  // update(); while they are unchanged update() keeps the element state
+  // and skips the local iterations
+  double vConverged[NEBD];
+  int    numEleLoadsConverged;
+  bool   stateCurrent;
 };
 
 #endif
@@ -81,16 +81,44 @@ using std::ifstream;
 #include <CompositeResponse.h>
 #include <ElementalLoad.h>
 #include <ElementIter.h>
+#include <ScratchArena.h>
+#include <FixedSizeInverse.h>
 
 #define DefaultLoverGJ 1.0e-10
 
-Matrix ForceBeamColumn3d::theMatrix(12,12);
-Vector ForceBeamColumn3d::theVector(12);
-double ForceBeamColumn3d::workArea[200];
+struct ForceBeamColumn3d::Workspace {
+  Matrix theMatrix;
+  Vector theVector;
+  double workArea[200];
 
-Vector ForceBeamColumn3d::vsSubdivide[maxNumSections];
-Matrix ForceBeamColumn3d::fsSubdivide[maxNumSections];
-Vector ForceBeamColumn3d::SsrSubdivide[maxNumSections];
+  // subdivision of the displacement increment in update()
+  Vector vsSubdivide[maxNumSections];
+  Matrix fsSubdivide[maxNumSections];
+  Vector SsrSubdivide[maxNumSections];
+
+  // update()
+  Vector dv, vin, vr, dSe, dvToDo, dvTrial, SeTrial;
+  Matrix f, kvTrial;
+  Vector Ss, dSs, dvs;
+  Matrix fb;
+
+  // getInitialStiff()
+  Matrix fInit, kvInit;
+
+  // computedqdh() and computedfedh()
+  Vector dqdh;
+  Matrix dfedh;
+
+  Workspace()
+    :theMatrix(NEGD,NEGD), theVector(NEGD),
+     dv(NEBD), vin(NEBD), vr(NEBD), dSe(NEBD), dvToDo(NEBD), dvTrial(NEBD),
+     SeTrial(NEBD), f(NEBD,NEBD), kvTrial(NEBD,NEBD),
+     fInit(NEBD,NEBD), kvInit(NEBD,NEBD),
+     dqdh(NEBD), dfedh(NEBD,NEBD)
+  {}
+};
+
+static const int workSlot = ScratchArena::newSlot();
 
 void* OPS_ForceBeamColumn3d()
 {
@@ -390,7 +418,7 @@ ForceBeamColumn3d::ForceBeamColumn3d():
   fs(0), vs(0), Ssr(0), vscommit(0),
   numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(12),
   Ki(0), isTorsion(false), maxSubdivisions(1), subdivideFactor(1.0), parameterID(0),
-  theDamping(0)
+  theDamping(0), numEleLoadsConverged(0), stateCurrent(false)
 {
   load.Zero();
 
@@ -417,7 +445,7 @@ ForceBeamColumn3d::ForceBeamColumn3d (int tag, int nodeI, int nodeJ,
   fs(0), vs(0),Ssr(0), vscommit(0),
   numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(12),
   Ki(0), isTorsion(false), maxSubdivisions(maxNumSub), subdivideFactor(subFac), parameterID(0),
-  theDamping(0)
+  theDamping(0), numEleLoadsConverged(0), stateCurrent(false)
 {
   if (maxSubdivisions < 1)
     maxSubdivisions = 1;
@@ -591,6 +619,8 @@ ForceBeamColumn3d::setDomain(Domain *theDomain)
 
   if (initialFlag == 0) 
     this->initializeSectionHistoryVariables();
+
+  stateCurrent = false;
 }
 
 int
@@ -726,6 +756,21 @@ int ForceBeamColumn3d::revertToStart()
   return err;
 }
 
+bool
+ForceBeamColumn3d::isReentrant(void) const
+{
+  // the element keeps its work storage per thread; its sections and
+  // transformation must be reentrant as well, its damping is not assumed to be
+  if (theDamping != 0 || crdTransf->isReentrant() == false)
+    return false;
+
+  for (int i = 0; i < numSections; i++)
+    if (sections[i]->isReentrant() == false)
+      return false;
+
+  return true;
+}
+
 
 const Matrix &
 ForceBeamColumn3d::getInitialStiff(void)
@@ -734,18 +779,15 @@ ForceBeamColumn3d::getInitialStiff(void)
   if (Ki != 0)
     return *Ki;
 
-  static Matrix f(NEBD,NEBD);   // element flexibility matrix  
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+
+  Matrix &f = theWork.fInit;   // element flexibility matrix  
   this->getInitialFlexibility(f);
   
-  static Matrix I(NEBD,NEBD);   // an identity matrix for matrix inverse  
-  I.Zero();
-  for (int i=0; i<NEBD; i++)
-    I(i,i) = 1.0;
-  
   // calculate element stiffness matrix
   // invert3by3Matrix(f, kv);
-  static Matrix kvInit(NEBD, NEBD);
-  if (f.Solve(I, kvInit) < 0)
+  Matrix &kvInit = theWork.kvInit;
+  if (invertFixedSize<NEBD>(&f(0,0), &kvInit(0,0)) < 0)
     opserr << "ForceBeamColumn3d::getInitialStiff() -- could not invert flexibility for element with tag: " << this->getTag() << endln;
 
   if(theDamping) kvInit *= theDamping->getStiffnessMultiplier();
@@ -908,6 +950,7 @@ ForceBeamColumn3d::computeReactionSensitivity(double *dp0dh, int gradNumber)
 const Vector &
 ForceBeamColumn3d::getResistingForce(void)
 {
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
   // Will remove once we clean up the corotational 3d transformation -- MHS
   crdTransf->update();
   
@@ -918,12 +961,12 @@ ForceBeamColumn3d::getResistingForce(void)
   if (numEleLoads > 0)
     this->computeReactions(p0);
   
-  theVector =  crdTransf->getGlobalResistingForce(Se, p0Vec);
+  theWork.theVector =  crdTransf->getGlobalResistingForce(Se, p0Vec);
   
   if (rho != 0)
-    theVector.addVector(1.0, load, -1.0);
+    theWork.theVector.addVector(1.0, load, -1.0);
   
-  return theVector;
+  return theWork.theVector;
 }
 
 const Vector &
@@ -953,6 +996,7 @@ void
   int
   ForceBeamColumn3d::update()
   {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // if have completed a recvSelf() - do a revertToLastCommit
     // to get Ssr, etc. set correctly
     if (initialFlag == 2)
@@ -964,13 +1008,26 @@ void
     // get basic displacements and increments
     const Vector &v = crdTransf->getBasicTrialDisp();    
 
-    static Vector dv(NEBD);
+    Vector &dv = theWork.dv;
     dv = crdTransf->getBasicIncrDeltaDisp();    
 
     if (initialFlag != 0 && dv.Norm() <= DBL_EPSILON && numEleLoads == 0)
       return 0;
 
-    static Vector vin(NEBD);
+    // quick return if the basic deformations and element loads are those
+    // of the last converged state; the damping, which may depend on time,
+    // is always updated
+    if (initialFlag == 1 && stateCurrent && theDamping == 0 &&
+	numEleLoads == numEleLoadsConverged) {
+      int k = 0;
+      while (k < NEBD && v(k) == vConverged[k])
+	k++;
+      if (k == NEBD)
+	return 0;
+    }
+    stateCurrent = false;
+
+    Vector &vin = theWork.vin;
     vin = v;
     vin -= dv;
     double L = crdTransf->getInitialLength();
@@ -982,24 +1039,19 @@ void
     double wt[maxNumSections];
     beamIntegr->getSectionWeights(numSections, L, wt);
 
-    static Vector vr(NEBD);       // element residual displacements
-    static Matrix f(NEBD,NEBD);   // element flexibility matrix
+    Vector &vr = theWork.vr;       // element residual displacements
+    Matrix &f = theWork.f;   // element flexibility matrix
 
-    static Matrix I(NEBD,NEBD);   // an identity matrix for matrix inverse
     double dW;                    // section strain energy (work) norm 
     int i, j;
 
-    I.Zero();
-    for (i=0; i<NEBD; i++)
-      I(i,i) = 1.0;
-
     int numSubdivide = 1;
     bool converged = false;
-    static Vector dSe(NEBD);
-    static Vector dvToDo(NEBD);
-    static Vector dvTrial(NEBD);
-    static Vector SeTrial(NEBD);
-    static Matrix kvTrial(NEBD, NEBD);
+    Vector &dSe = theWork.dSe;
+    Vector &dvToDo = theWork.dvToDo;
+    Vector &dvTrial = theWork.dvTrial;
+    Vector &SeTrial = theWork.SeTrial;
+    Matrix &kvTrial = theWork.kvTrial;
 
     dvToDo = dv;
     dvTrial = dvToDo;
@@ -1032,9 +1084,9 @@ void
 	SeTrial = Se;
 	kvTrial = kv;
 	for (i=0; i<numSections; i++) {
-	  vsSubdivide[i] = vs[i];
-	  fsSubdivide[i] = fs[i];
-	  SsrSubdivide[i] = Ssr[i];
+	  theWork.vsSubdivide[i] = vs[i];
+	  theWork.fsSubdivide[i] = fs[i];
+	  theWork.SsrSubdivide[i] = Ssr[i];
 	}
 
 	// calculate nodal force increments and update nodal forces      
@@ -1059,15 +1111,15 @@ void
 	  int order      = sections[i]->getOrder();
 	  const ID &code = sections[i]->getType();
 	  
-	  static Vector Ss;
-	  static Vector dSs;
-	  static Vector dvs;
-	  static Matrix fb;
+	  Vector &Ss = theWork.Ss;
+	  Vector &dSs = theWork.dSs;
+	  Vector &dvs = theWork.dvs;
+	  Matrix &fb = theWork.fb;
 	  
-	  Ss.setData(workArea, order);
-	  dSs.setData(&workArea[order], order);
-	  dvs.setData(&workArea[2*order], order);
-	  fb.setData(&workArea[3*order], order, NEBD);
+	  Ss.setData(theWork.workArea, order);
+	  dSs.setData(&theWork.workArea[order], order);
+	  dvs.setData(&theWork.workArea[2*order], order);
+	  fb.setData(&theWork.workArea[3*order], order, NEBD);
 	  
 	  double xL  = xi[i];
 	  double xL1 = xL-1.0;
@@ -1110,7 +1162,7 @@ void
 	  
 	  // dSs = Ss - Ssr[i];
 	  dSs = Ss;
-	  dSs.addVector(1.0, SsrSubdivide[i], -1.0);
+	  dSs.addVector(1.0, theWork.SsrSubdivide[i], -1.0);
 	  
 	  // compute section deformation increments
 	  if (l == 0) {
@@ -1118,7 +1170,7 @@ void
 	    //  regular newton 
 	    //    vs += fs * dSs;     
 	    
-	    dvs.addMatrixVector(0.0, fsSubdivide[i], dSs, 1.0);
+	    dvs.addMatrixVector(0.0, theWork.fsSubdivide[i], dSs, 1.0);
 	    
 	  } else if (l == 2) {
 	    
@@ -1132,7 +1184,7 @@ void
 	      
 	      dvs.addMatrixVector(0.0, fs0, dSs, 1.0);
 	    } else
-	      dvs.addMatrixVector(0.0, fsSubdivide[i], dSs, 1.0);
+	      dvs.addMatrixVector(0.0, theWork.fsSubdivide[i], dSs, 1.0);
 	    
 	  } else {
 	    
@@ -1145,19 +1197,19 @@ void
 	  
 	  // set section deformations
 	  if (initialFlag != 0)
-	    vsSubdivide[i] += dvs;
+	    theWork.vsSubdivide[i] += dvs;
 	  
-	  if ( sections[i]->setTrialSectionDeformation(vsSubdivide[i]) < 0) {
+	  if ( sections[i]->setTrialSectionDeformation(theWork.vsSubdivide[i]) < 0) {
 	    opserr << "ForceBeamColumn3d::update() - section failed in setTrial\n";
 	    return -1;
 	  }
 	  
 	  // get section resisting forces
-	  SsrSubdivide[i] = sections[i]->getStressResultant();
+	  theWork.SsrSubdivide[i] = sections[i]->getStressResultant();
 	  
 	  // get section flexibility matrix
 	  // FRANK 
-	  fsSubdivide[i] = sections[i]->getSectionFlexibility();
+	  theWork.fsSubdivide[i] = sections[i]->getSectionFlexibility();
 	  
 	  /*
 	    const Matrix &sectionStiff = sections[i]->getSectionTangent();
@@ -1165,21 +1217,21 @@ void
 	    Matrix I(n,n); I.Zero(); for (int l=0; l<n; l++) I(l,l) = 1.0;
 	    Matrix sectionFlex(n,n);
 	    sectionStiff.SolveSVD(I, sectionFlex, 1.0e-6);
-	    fsSubdivide[i] = sectionFlex;	    
+	    theWork.fsSubdivide[i] = sectionFlex;	    
 	  */
 	  
 	  // calculate section residual deformations
 	  // dvs = fs * (Ss - Ssr);
 	  dSs = Ss;
-	  dSs.addVector(1.0, SsrSubdivide[i], -1.0);  // dSs = Ss - Ssr[i];
+	  dSs.addVector(1.0, theWork.SsrSubdivide[i], -1.0);  // dSs = Ss - Ssr[i];
 	  
-	  dvs.addMatrixVector(0.0, fsSubdivide[i], dSs, 1.0);
+	  dvs.addMatrixVector(0.0, theWork.fsSubdivide[i], dSs, 1.0);
 	  
 	  // integrate element flexibility matrix
 	  // f = f + (b^ fs * b) * wtL;
 	  //f.addMatrixTripleProduct(1.0, b[i], fs[i], wtL);
 	  int jj;
-	  const Matrix &fSec = fsSubdivide[i];
+	  const Matrix &fSec = theWork.fsSubdivide[i];
 	  fb.Zero();
 	  double tmp;
 	  for (ii = 0; ii < order; ii++) {
@@ -1271,7 +1323,7 @@ void
 	      // integrate residual deformations
 	      // vr += (b^ (vs + dvs)) * wtL;
 	      //vr.addMatrixTransposeVector(1.0, b[i], vs[i] + dvs, wtL);
-	      dvs.addVector(1.0, vsSubdivide[i], 1.0);
+	      dvs.addVector(1.0, theWork.vsSubdivide[i], 1.0);
 	      double dei;
 	      for (ii = 0; ii < order; ii++) {
 		dei = dvs(ii)*wtL;
@@ -1311,7 +1363,7 @@ void
 	    // invert3by3Matrix(f, kv);	  
 	    // FRANK
 	    //	  if (f.SolveSVD(I, kvTrial, 1.0e-12) < 0)
-	    if (f.Solve(I, kvTrial) < 0)
+	    if (invertFixedSize<NEBD>(&f(0,0), &kvTrial(0,0)) < 0)
 	      opserr << "ForceBeamColumn3d::update() -- could not invert flexibility for element with tag: " << this->getTag() << endln;;
 	    
 	    // dv = vin + dvTrial  - vr
@@ -1353,9 +1405,9 @@ void
 	      Se = SeTrial;
 
 	      for (int k=0; k<numSections; k++) {
-		vs[k] = vsSubdivide[k];
-		fs[k] = fsSubdivide[k];
-		Ssr[k] = SsrSubdivide[k];
+		vs[k] = theWork.vsSubdivide[k];
+		fs[k] = theWork.fsSubdivide[k];
+		Ssr[k] = theWork.SsrSubdivide[k];
 	      }
 
 	      // break out of j & l loops
@@ -1405,6 +1457,11 @@ void
 
     initialFlag = 1;
 
+    for (i=0; i<NEBD; i++)
+      vConverged[i] = v(i);
+    numEleLoadsConverged = numEleLoads;
+    stateCurrent = true;
+
     return 0;
   }
 
@@ -1473,15 +1530,16 @@ void
 
   const Matrix &
   ForceBeamColumn3d::getMass(void)
-  { 
-    theMatrix.Zero();
+  {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+    theWork.theMatrix.Zero();
 
     double L = crdTransf->getInitialLength();
     if (rho != 0.0)
-      theMatrix(0,0) = theMatrix(1,1) = theMatrix(2,2) =
-	theMatrix(6,6) = theMatrix(7,7) = theMatrix(8,8) = 0.5*L*rho;
+      theWork.theMatrix(0,0) = theWork.theMatrix(1,1) = theWork.theMatrix(2,2) =
+	theWork.theMatrix(6,6) = theWork.theMatrix(7,7) = theWork.theMatrix(8,8) = 0.5*L*rho;
 
-    return theMatrix;
+    return theWork.theMatrix;
   }
 
   void 
@@ -1519,6 +1577,11 @@ ForceBeamColumn3d::addLoad(ElementalLoad *theLoad, double loadFactor)
     sizeEleLoads+=1;
   }
 
+  // a load other than that at this position in the last converged state
+  if (numEleLoads >= numEleLoadsConverged || eleLoads[numEleLoads] != theLoad ||
+      eleLoadFactors[numEleLoads] != loadFactor)
+    stateCurrent = false;
+
   eleLoadFactors[numEleLoads] = loadFactor;
   eleLoads[numEleLoads] = theLoad;
   numEleLoads++;
@@ -1910,11 +1973,12 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
 
   const Vector &
   ForceBeamColumn3d::getResistingForceIncInertia()
-  {	
+  {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // Compute the current resisting force
-    theVector = this->getResistingForce();
+    theWork.theVector = this->getResistingForce();
 
-    if (theDamping) theVector += this->getDampingForce();
+    if (theDamping) theWork.theVector += this->getDampingForce();
 
     if (rho != 0.0) {
       const Vector &accel1 = theNodes[0]->getTrialAccel();
@@ -1923,25 +1987,25 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
       double L = crdTransf->getInitialLength();
       double m = 0.5*rho*L;
 
-      theVector(0) += m*accel1(0);
-      theVector(1) += m*accel1(1);
-      theVector(2) += m*accel1(2);
-      theVector(6) += m*accel2(0);
-      theVector(7) += m*accel2(1);
-      theVector(8) += m*accel2(2);
+      theWork.theVector(0) += m*accel1(0);
+      theWork.theVector(1) += m*accel1(1);
+      theWork.theVector(2) += m*accel1(2);
+      theWork.theVector(6) += m*accel2(0);
+      theWork.theVector(7) += m*accel2(1);
+      theWork.theVector(8) += m*accel2(2);
 
       // add the damping forces if rayleigh damping
       if (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
-	theVector += this->getRayleighDampingForces();
+	theWork.theVector += this->getRayleighDampingForces();
 
     } else {
 
       // add the damping forces if rayleigh damping
       if (betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
-	theVector += this->getRayleighDampingForces();
+	theWork.theVector += this->getRayleighDampingForces();
     }
 
-    return theVector;
+    return theWork.theVector;
   }
 
   int
@@ -1952,7 +2016,7 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
     int i, j , k;
     int loc = 0;
 
-    static ID idData(15);  
+    ID idData(15);  
     idData(0) = this->getTag();
     idData(1) = connectedExternalNodes(0);
     idData(2) = connectedExternalNodes(1);
@@ -2111,7 +2175,7 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
     int dbTag = this->getDbTag();
     int i,j,k;
 
-    static ID idData(15); // one bigger than needed 
+    ID idData(15); // one bigger than needed 
 
     if (theChannel.recvID(dbTag, commitTag, idData) < 0)  {
       opserr << "ForceBeamColumn3d::recvSelf() - failed to recv ID data\n";
@@ -2417,6 +2481,7 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
   int
   ForceBeamColumn3d::getInitialFlexibility(Matrix &fe)
   {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     fe.Zero();
 
     double L = crdTransf->getInitialLength();
@@ -2433,7 +2498,7 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
       int order      = sections[i]->getOrder();
       const ID &code = sections[i]->getType();
 
-      Matrix fb(workArea, order, NEBD);
+      Matrix fb(theWork.workArea, order, NEBD);
 
       double xL  = xi[i];
       double xL1 = xL-1.0;
@@ -2538,6 +2603,7 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
 int
 ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 {
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
   v0.Zero();
   if (numEleLoads < 1)
       return 0;
@@ -2560,16 +2626,14 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
       double xL1 = xL - 1.0;
       double wtL = wt[i] * L;
 
-      static Vector sp;
-      sp.setData(workArea, order);
+      Vector sp(theWork.workArea, order);
       sp.Zero();
 
       this->computeSectionForces(sp, i);
 
       const Matrix &fse = sections[i]->getInitialFlexibility();
 
-      static Vector e;
-      e.setData(&workArea[order], order);
+      Vector e(&theWork.workArea[order], order);
 
       e.addMatrixVector(0.0, fse, sp, 1.0);
 
@@ -2608,13 +2672,13 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 					      Vector sectionDispls[]) const
   {
      // get basic displacements and increments
-     static Vector ub(NEBD);
+     Vector ub(NEBD);
      ub = crdTransf->getBasicTrialDisp();    
 
      double L = crdTransf->getInitialLength();
 
      // get integration point positions and weights
-     static double pts[maxNumSections];
+     double pts[maxNumSections];
      beamIntegr->getSectionLocations(numSections, L, pts);
 
      // setup Vandermode and CBDI influence matrices
@@ -2628,7 +2692,7 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
      // get section curvatures
      Vector kappa_y(numSections);  // curvature
      Vector kappa_z(numSections);  // curvature
-     static Vector vs;                // section deformations 
+     Vector vs;                // section deformations 
 
      for (i=0; i<numSections; i++) {
 	 // THIS IS VERY INEFFICIENT ... CAN CHANGE IF RUNS TOO SLOW
@@ -2663,8 +2727,8 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
      //cout << "kappa_z: " << kappa_z;   
 
      Vector v(numSections), w(numSections);
-     static Vector xl(NDM), uxb(NDM);
-     static Vector xg(NDM), uxg(NDM); 
+     Vector xl(NDM), uxb(NDM);
+     Vector xg(NDM), uxg(NDM); 
      // double theta;                             // angle of twist of the sections
 
      // v = ls * kappa_z;  
@@ -2698,6 +2762,7 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
   void
   ForceBeamColumn3d::Print(OPS_Stream &s, int flag)
   {
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
     // flags with negative values are used by GSA
     if (flag == -1) { 
       int eleTag = this->getTag();
@@ -2718,8 +2783,8 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
       double MY2 = Secommit(4);
       double L = crdTransf->getInitialLength();
       double VY = (MZ1+MZ2)/L;
-      theVector(1) =  VY;
-      theVector(4) = -VY;
+      theWork.theVector(1) =  VY;
+      theWork.theVector(4) = -VY;
       double VZ = (MY1+MY2)/L;
       double T  = Secommit(5);
 
@@ -2739,9 +2804,9 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 
     // flag set to 2 used to print everything .. used for viewing data for UCSD renderer  
     else if (flag == 2) {
-       static Vector xAxis(3);
-       static Vector yAxis(3);
-       static Vector zAxis(3);
+       Vector xAxis(3);
+       Vector yAxis(3);
+       Vector zAxis(3);
 
 
        crdTransf->getLocalAxes(xAxis, yAxis, zAxis);
@@ -2771,8 +2836,8 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
        double MY2 = Secommit(4);
        double L = crdTransf->getInitialLength();
        double VY = (MZ1+MZ2)/L;
-       theVector(1) =  VY;
-       theVector(4) = -VY;
+       theWork.theVector(1) =  VY;
+       theWork.theVector(4) = -VY;
        double VZ = (MY1+MY2)/L;
        double T  = Secommit(5);
 
@@ -2786,8 +2851,8 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 	 << T << ' ' << MY2 << ' '  <<  MZ2 << endln;
 
        // plastic hinge rotation
-       static Vector vp(6);
-       static Matrix fe(6,6);
+       Vector vp(6);
+       Matrix fe(6,6);
        this->getInitialFlexibility(fe);
        vp = crdTransf->getBasicTrialDisp();
        vp.addMatrixVector(1.0, fe, Se, -1.0);
@@ -2795,36 +2860,11 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 	 << " " << 0.1*L << " " << 0.1*L << endln;
 
        // allocate array of vectors to store section coordinates and displacements
-       static int maxNumSections = 0;
-       static Vector *coords = 0;
-       static Vector *displs = 0;
-       if (maxNumSections < numSections) {
-	 if (coords != 0) 
-	   delete [] coords;
-	 if (displs != 0)
-	   delete [] displs;
-
-	 coords = new Vector [numSections];
-	 displs = new Vector [numSections];
-
-	 if (!coords) {
-	   opserr << "ForceBeamColumn3d::Print() -- failed to allocate coords array";   
-	   exit(-1);
-	 }
-
-	 int i;
-	 for (i = 0; i < numSections; i++)
-	   coords[i] = Vector(NDM);
-
-	 if (!displs) {
-	   opserr << "ForceBeamColumn3d::Print() -- failed to allocate coords array";   
-	   exit(-1);
-	 }
-
-	 for (i = 0; i < numSections; i++)
-	   displs[i] = Vector(NDM);
-
-	 maxNumSections = numSections;
+       Vector *coords = new Vector [numSections];
+       Vector *displs = new Vector [numSections];
+       for (int i = 0; i < numSections; i++) {
+         coords[i] = Vector(NDM);
+         displs[i] = Vector(NDM);
        }
 
        // compute section location & displacements
@@ -2836,6 +2876,8 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 	 s << " " << (displs[i])(0) << " " << (displs[i])(1) << " " << (displs[i])(2) << endln;
 	 sections[i]->Print(s, flag); 
        }
+       delete [] coords;
+       delete [] displs;
      }
 
     if (flag == OPS_PRINT_CURRENTSTATE) {
@@ -2851,8 +2893,8 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
        double MY2 = Secommit(4);
        double L = crdTransf->getInitialLength();
        double VY = (MZ1+MZ2)/L;
-       theVector(1) =  VY;
-       theVector(4) = -VY;
+       theWork.theVector(1) =  VY;
+       theWork.theVector(4) = -VY;
        double VZ = (MY1+MY2)/L;
        double T  = Secommit(5);
 
@@ -2898,8 +2940,8 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
   int
   ForceBeamColumn3d::displaySelf(Renderer &theViewer, int displayMode, float fact, const char** displayModes, int numModes)
   {
-    static Vector v1(3);
-    static Vector v2(3);
+    Vector v1(3);
+    Vector v2(3);
 
     theNodes[0]->getDisplayCrds(v1, fact, displayMode);
     theNodes[1]->getDisplayCrds(v2, fact, displayMode);
@@ -2940,7 +2982,7 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
       output.tag("ResponseType","Mz_2");
 
 
-      theResponse = new ElementResponse(this, 1, theVector);
+      theResponse = new ElementResponse(this, 1, Vector(NEGD));
 
     // local force -
     }  else if (strcmp(argv[0],"localForce") == 0 || strcmp(argv[0],"localForces") == 0) {
@@ -2958,7 +3000,7 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
       output.tag("ResponseType","My_2");
       output.tag("ResponseType","Mz_2");
       
-      theResponse = new ElementResponse(this, 2, theVector);
+      theResponse = new ElementResponse(this, 2, Vector(NEGD));
 
     // basic force -
     } else if (strcmp(argv[0],"basicForce") == 0 || strcmp(argv[0],"basicForces") == 0) {
@@ -3001,7 +3043,7 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
       output.tag("ResponseType","Mz_2");
 
 
-      theResponse = new ElementResponse(this, 21, theVector);
+      theResponse = new ElementResponse(this, 21, Vector(NEGD));
 
     // local damping force -
     } else if (theDamping && (strcmp(argv[0],"localDampingForce") == 0 || strcmp(argv[0],"localDampingForces") == 0)) {
@@ -3019,7 +3061,7 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
       output.tag("ResponseType","My_2");
       output.tag("ResponseType","Mz_2");
       
-      theResponse = new ElementResponse(this, 22, theVector);
+      theResponse = new ElementResponse(this, 22, Vector(NEGD));
 
     } else if (theDamping && (strcmp(argv[0],"basicDampingForce") == 0 || strcmp(argv[0],"basicDampingForces") == 0)) {
 
@@ -3074,7 +3116,7 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
     } else if (strcmp(argv[0],"RayleighForces") == 0 || 
 	       strcmp(argv[0],"rayleighForces") == 0) {
 
-      theResponse = new ElementResponse(this, 12, theVector);
+      theResponse = new ElementResponse(this, 12, Vector(NEGD));
 
     } else if (strcmp(argv[0],"sections") ==0) { 
       CompositeResponse *theCResponse = new CompositeResponse();
@@ -3221,8 +3263,9 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 int 
 ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 {
-  static Vector vp(6);
-  static Matrix fe(6,6);
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+  Vector vp(6);
+  Matrix fe(6,6);
 
   if (responseID == 1)
     return eleInfo.setVector(this->getResistingForce());
@@ -3233,34 +3276,34 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
       this->computeReactions(p0);
     // Axial
     double N = Se(0);
-    theVector(6) =  N;
-    theVector(0) = -N+p0[0];
+    theWork.theVector(6) =  N;
+    theWork.theVector(0) = -N+p0[0];
     
     // Torsion
     double T = Se(5);
-    theVector(9) =  T;
-    theVector(3) = -T;
+    theWork.theVector(9) =  T;
+    theWork.theVector(3) = -T;
     
     // Moments about z and shears along y
     double M1 = Se(1);
     double M2 = Se(2);
-    theVector(5)  = M1;
-    theVector(11) = M2;
+    theWork.theVector(5)  = M1;
+    theWork.theVector(11) = M2;
     double L = crdTransf->getInitialLength();
     double V = (M1+M2)/L;
-    theVector(1) =  V+p0[1];
-    theVector(7) = -V+p0[2];
+    theWork.theVector(1) =  V+p0[1];
+    theWork.theVector(7) = -V+p0[2];
     
     // Moments about y and shears along z
     M1 = Se(3);
     M2 = Se(4);
-    theVector(4)  = M1;
-    theVector(10) = M2;
+    theWork.theVector(4)  = M1;
+    theWork.theVector(10) = M2;
     V = (M1+M2)/L;
-    theVector(2) = -V+p0[3];
-    theVector(8) =  V+p0[4];
+    theWork.theVector(2) = -V+p0[3];
+    theWork.theVector(8) =  V+p0[4];
       
-    return eleInfo.setVector(theVector);
+    return eleInfo.setVector(theWork.theVector);
 
   }
       
@@ -3272,34 +3315,34 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
     Sd = theDamping->getDampingForce();
     // Axial
     double N = Sd(0);
-    theVector(6) =  N;
-    theVector(0) = -N;
+    theWork.theVector(6) =  N;
+    theWork.theVector(0) = -N;
     
     // Torsion
     double T = Sd(5);
-    theVector(9) =  T;
-    theVector(3) = -T;
+    theWork.theVector(9) =  T;
+    theWork.theVector(3) = -T;
     
     // Moments about z and shears along y
     double M1 = Sd(1);
     double M2 = Sd(2);
-    theVector(5)  = M1;
-    theVector(11) = M2;
+    theWork.theVector(5)  = M1;
+    theWork.theVector(11) = M2;
     double L = crdTransf->getInitialLength();
     double V = (M1+M2)/L;
-    theVector(1) =  V;
-    theVector(7) = -V;
+    theWork.theVector(1) =  V;
+    theWork.theVector(7) = -V;
     
     // Moments about y and shears along z
     M1 = Sd(3);
     M2 = Sd(4);
-    theVector(4)  = M1;
-    theVector(10) = M2;
+    theWork.theVector(4)  = M1;
+    theWork.theVector(10) = M2;
     V = (M1+M2)/L;
-    theVector(2) = -V;
-    theVector(8) =  V;
+    theWork.theVector(2) = -V;
+    theWork.theVector(8) =  V;
       
-    return eleInfo.setVector(theVector);
+    return eleInfo.setVector(theWork.theVector);
   }
 
   else if (responseID == 23)
@@ -3382,8 +3425,8 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
     dispsy.addMatrixVector(0.0, ls, kappaz,  1.0);
     dispsz.addMatrixVector(0.0, ls, kappay, -1.0);    
     beamIntegr->getSectionLocations(numSections, L, pts);
-    static Vector uxb(3);
-    static Vector uxg(3);
+    Vector uxb(3);
+    Vector uxg(3);
     Matrix disps(numSections,3);
     vp = crdTransf->getBasicTrialDisp();
     for (int i = 0; i < numSections; i++) {
@@ -3429,8 +3472,8 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
     Vector dispsz(1); // along local z    
     dispsy.addMatrixVector(0.0, ls, kappaz,  1.0);
     dispsz.addMatrixVector(0.0, ls, kappay, -1.0);
-    static Vector uxb(3);
-    static Vector uxg(3);
+    Vector uxb(3);
+    Vector uxg(3);
     Matrix disps(1,3);
     vp = crdTransf->getBasicTrialDisp();
     uxb(0) = pts[0]*vp(0); // linear shape function
@@ -3449,7 +3492,7 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
   // Point of inflection
   else if (responseID == 5) {
-    static Vector LI(2);
+    Vector LI(2);
     LI(0) = 0.0;
     LI(1) = 0.0;
 
@@ -3533,7 +3576,7 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
       }
     }
 
-    static Vector d(4);
+    Vector d(4);
     d(0) = d2z;
     d(1) = d3z;
     d(2) = d2y;
@@ -3647,7 +3690,7 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 	indata.close();
       }
 
-      static Vector result8(2);
+      Vector result8(2);
       result8(0) = value;
       result8(1) = checkvalue1;      
       
@@ -3684,7 +3727,7 @@ ForceBeamColumn3d::getResponseSensitivity(int responseID, int gradNumber,
 
   // Basic force sensitivity
   else if (responseID == 7) {
-    static Vector dqdh(6);
+    Vector dqdh(6);
 
     const Vector &dvdh = crdTransf->getBasicDisplSensitivity(gradNumber);
 
@@ -3709,7 +3752,7 @@ ForceBeamColumn3d::getResponseSensitivity(int responseID, int gradNumber,
       this->computeSectionForceSensitivity(dsdh, sectionNum-1, gradNumber);
     }
     //opserr << "FBC3d::getRespSens dspdh: " << dsdh;
-    static Vector dqdh(6);
+    Vector dqdh(6);
 
     const Vector &dvdh = crdTransf->getBasicDisplSensitivity(gradNumber);
 
@@ -3802,14 +3845,14 @@ ForceBeamColumn3d::getResponseSensitivity(int responseID, int gradNumber,
 
   // Plastic deformation sensitivity
   else if (responseID == 4) {
-    static Vector dvpdh(6);
+    Vector dvpdh(6);
 
     const Vector &dvdh = crdTransf->getBasicDisplSensitivity(gradNumber);
 
     dvpdh = dvdh;
     //opserr << dvpdh;
 
-    static Matrix fe(6,6);
+    Matrix fe(6,6);
     this->getInitialFlexibility(fe);
 
     const Vector &dqdh = this->computedqdh(gradNumber);
@@ -3817,7 +3860,7 @@ ForceBeamColumn3d::getResponseSensitivity(int responseID, int gradNumber,
     dvpdh.addMatrixVector(1.0, fe, dqdh, -1.0);
     //opserr << dvpdh;
 
-    static Matrix fek(6,6);
+    Matrix fek(6,6);
     fek.addMatrixProduct(0.0, fe, kv, 1.0);
 
     dvpdh.addMatrixVector(1.0, fek, dvdh, -1.0);
@@ -3954,27 +3997,30 @@ ForceBeamColumn3d::activateParameter(int passedParameterID)
 const Matrix&
 ForceBeamColumn3d::getKiSensitivity(int gradNumber)
 {
-  theMatrix.Zero();
-  return theMatrix;
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+  theWork.theMatrix.Zero();
+  return theWork.theMatrix;
 }
 
 const Matrix&
 ForceBeamColumn3d::getMassSensitivity(int gradNumber)
 {
-    theMatrix.Zero();
+    Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+    theWork.theMatrix.Zero();
 
     double L = crdTransf->getInitialLength();
     if (rho != 0.0 && parameterID == 1)
-      theMatrix(0,0) = theMatrix(1,1) = theMatrix(2,2) =
-	theMatrix(6,6) = theMatrix(7,7) = theMatrix(8,8) = 0.5*L;
+      theWork.theMatrix(0,0) = theWork.theMatrix(1,1) = theWork.theMatrix(2,2) =
+	theWork.theMatrix(6,6) = theWork.theMatrix(7,7) = theWork.theMatrix(8,8) = 0.5*L;
 
-    return theMatrix;
+    return theWork.theMatrix;
 }
 
 const Vector&
 ForceBeamColumn3d::getResistingForceSensitivity(int gradNumber)
 {
-  static Vector dqdh(6);
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+  Vector dqdh(6);
   dqdh = this->computedqdh(gradNumber);
 
   // Transform forces
@@ -3984,7 +4030,7 @@ ForceBeamColumn3d::getResistingForceSensitivity(int gradNumber)
   this->computeReactionSensitivity(dp0dh, gradNumber);
   Vector dp0dhVec(dp0dh, 6);
 
-  static Vector P(12);
+  Vector &P = theWork.theVector;
   P.Zero();
 
   if (crdTransf->isShapeSensitivity()) {
@@ -4004,6 +4050,7 @@ ForceBeamColumn3d::getResistingForceSensitivity(int gradNumber)
 int
 ForceBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
 {
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
   int err = 0;
 
   double L = crdTransf->getInitialLength();
@@ -4022,7 +4069,7 @@ ForceBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
 
   double d1oLdh = crdTransf->getd1overLdh();
 
-  static Vector dqdh(6);
+  Vector dqdh(6);
   dqdh = this->computedqdh(gradNumber);
 
   // dvdh = A dudh + dAdh u
@@ -4045,7 +4092,7 @@ ForceBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
 
     double dxLdh  = dptsdh[i];    
 
-    Vector ds(workArea, order);
+    Vector ds(theWork.workArea, order);
     ds.Zero();
 
     // Add sensitivity wrt element loads
@@ -4102,7 +4149,7 @@ ForceBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
       }
     }
 
-    Vector de(&workArea[order], order);
+    Vector de(&theWork.workArea[order], order);
     const Matrix &fs = sections[i]->getSectionFlexibility();
     de.addMatrixVector(0.0, fs, ds, 1.0);
 
@@ -4115,6 +4162,7 @@ ForceBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
 const Vector &
 ForceBeamColumn3d::computedqdh(int gradNumber)
 {
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
   //opserr << "FBC3d::computedqdh " << gradNumber << endln;
 
   double L = crdTransf->getInitialLength();
@@ -4136,7 +4184,7 @@ ForceBeamColumn3d::computedqdh(int gradNumber)
 
   double d1oLdh = crdTransf->getd1overLdh();
 
-  static Vector dvdh(6);
+  Vector dvdh(6);
   dvdh.Zero();
 
   // Loop over the integration points
@@ -4155,11 +4203,11 @@ ForceBeamColumn3d::computedqdh(int gradNumber)
     //opserr << dptsdh[i] << ' ' << dwtsdh[i] << endln;
 
     // Get section stress resultant gradient
-    Vector dsdh(&workArea[order], order);
+    Vector dsdh(&theWork.workArea[order], order);
     dsdh = sections[i]->getStressResultantSensitivity(gradNumber,true);
     //opserr << "FBC2d::dqdh -- " << gradNumber << ' ' << dsdh;
     
-    Vector dspdh(&workArea[2*order], order);
+    Vector dspdh(&theWork.workArea[2*order], order);
     dspdh.Zero();
     // Add sensitivity wrt element loads
     if (numEleLoads > 0) {
@@ -4188,7 +4236,7 @@ ForceBeamColumn3d::computedqdh(int gradNumber)
       }
     }
 
-    Vector dedh(workArea, order);
+    Vector dedh(theWork.workArea, order);
     const Matrix &fs = sections[i]->getSectionFlexibility();
     dedh.addMatrixVector(0.0, fs, dsdh, 1.0);
 
@@ -4267,12 +4315,7 @@ ForceBeamColumn3d::computedqdh(int gradNumber)
     }
   }
 
-  static Matrix dfedh(6,6);
-  dfedh.Zero();
-
-  //opserr << "dfedh: " << dfedh << endln;
-
-  static Vector dqdh(6);
+  Vector &dqdh = theWork.dqdh;
   dqdh.addMatrixVector(0.0, kv, dvdh, 1.0);
   
   //opserr << "dqdh: " << dqdh << endln;
@@ -4283,7 +4326,8 @@ ForceBeamColumn3d::computedqdh(int gradNumber)
 const Matrix&
 ForceBeamColumn3d::computedfedh(int gradNumber)
 {
-  static Matrix dfedh(6,6);
+  Workspace &theWork = ScratchArena::local().get<Workspace>(workSlot);
+  Matrix &dfedh = theWork.dfedh;
 
   dfedh.Zero();
 
@@ -4310,8 +4354,8 @@ ForceBeamColumn3d::computedfedh(int gradNumber)
     int order      = sections[i]->getOrder();
     const ID &code = sections[i]->getType();
     
-    Matrix fb(workArea, order, NEBD);
-    Matrix fb2(&workArea[order*NEBD], order, NEBD);
+    Matrix fb(theWork.workArea, order, NEBD);
+    Matrix fb2(&theWork.workArea[order*NEBD], order, NEBD);
 
     double xL  = xi[i];
     double xL1 = xL-1.0;
@@ -101,6 +101,7 @@ class ForceBeamColumn3d: public Element
   int commitState(void);
   int revertToLastCommit(void);        
   int revertToStart(void);
+  bool isReentrant(void) const;
   int update(void);    
   
   const Matrix &getTangentStiff(void);
@@ -201,9 +202,9 @@ class ForceBeamColumn3d: public Element
 
   Damping *theDamping;
   
-  static Matrix theMatrix;
-  static Vector theVector;
-  static double workArea[];
+  // work storage shared by all elements of this class; every thread
+  // obtains its own Workspace from its ScratchArena
+  struct Workspace;
   
   enum {maxNumSections = 10};
   
@@ -211,9 +212,6 @@ class ForceBeamColumn3d: public Element
   int    maxSubdivisions;       // maximum number of subdivisons of dv for local iterations
   double subdivideFactor;
   
-  static Vector vsSubdivide[];
-  static Vector SsrSubdivide[];
-  static Matrix fsSubdivide[];
   //static int maxNumSections;
 
   // AddingSensitivity:BEGIN //////////////////////////////////////////
@@ -223,6 +221,13 @@ class ForceBeamColumn3d: public Element
   void computeReactionSensitivity(double *dp0dh, int gradNumber);
   void computeSectionForceSensitivity(Vector &dspdh, int isec, int gradNumber);
   // AddingSensitivity:END ///////////////////////////////////////////
+
+  // basic deformations and number of element loads of the last converged
+  // update(); while they are unchanged update() keeps the element state
+  // and skips the local iterations
+  double vConverged[NEBD];
+  int    numEleLoadsConverged;
+  bool   stateCurrent;
 };
 
 #endif
@@ -33,6 +33,7 @@
 #include <NDMaterial.h>
 #include <Matrix.h>
 #include <Vector.h>
+#include <MatrixND.h>
 #include <ID.h>
 #include <Renderer.h>
 #include <Domain.h>
@@ -291,7 +292,6 @@ void *OPS_FourNodeQuad(const ID &info) {
 double FourNodeQuad::matrixData[64];
 Matrix FourNodeQuad::K(matrixData, 8, 8);
 Vector FourNodeQuad::P(8);
-double FourNodeQuad::shp[3][4];
 double FourNodeQuad::pts[4][2];
 double FourNodeQuad::wts[4];
 
@@ -592,7 +592,7 @@ FourNodeQuad::update()
 	const Vector &disp3 = theNodes[2]->getTrialDisp();
 	const Vector &disp4 = theNodes[3]->getTrialDisp();
 	
-	static double u[2][4];
+	double u[2][4];
 
 	u[0][0] = disp1(0);
 	u[1][0] = disp1(1);
@@ -603,7 +603,7 @@ FourNodeQuad::update()
 	u[0][3] = disp4(0);
 	u[1][3] = disp4(1);
 
-	static Vector eps(3);
+	VectorND<3> eps;
 
 	int ret = 0;
 
@@ -634,7 +634,7 @@ FourNodeQuad::update()
 const Matrix&
 FourNodeQuad::getTangentStiff()
 {
-  static Matrix D(3,3);
+  MatrixND<3,3> D;
 
 	K.Zero();
 
@@ -695,7 +695,7 @@ FourNodeQuad::getTangentStiff()
 const Matrix&
 FourNodeQuad::getInitialStiff()
 {
-  static Matrix D(3,3);
+  MatrixND<3,3> D;
   if (Ki != 0)
     return *Ki;
 
@@ -753,7 +753,7 @@ FourNodeQuad::getMass()
 	K.Zero();
 
 	int i;
-	static double rhoi[4];
+	double rhoi[4];
 	double sum = 0.0;
 	for (i = 0; i < 4; i++) {
 	  if (rho == 0)
@@ -825,7 +825,7 @@ int
 FourNodeQuad::addInertiaLoadToUnbalance(const Vector &accel)
 {
   int i;
-  static double rhoi[4];
+  double rhoi[4];
   double sum = 0.0;
   for (i = 0; i < 4; i++) {
     if (rho == 0)
@@ -850,7 +850,7 @@ FourNodeQuad::addInertiaLoadToUnbalance(const Vector &accel)
     return -1;
   }
   
-  static double ra[8];
+  double ra[8];
   
   ra[0] = Raccel1(0);
   ra[1] = Raccel1(1);
@@ -875,7 +875,7 @@ FourNodeQuad::addInertiaLoadToUnbalance(const Vector &accel)
 const Vector&
 FourNodeQuad::getResistingForce()
 {
-  static Vector sigma(3);
+  VectorND<3> sigma;
 	P.Zero();
 
 	double dvol;
@@ -935,7 +935,7 @@ const Vector&
 FourNodeQuad::getResistingForceIncInertia()
 {
 	int i;
-	static double rhoi[4];
+	double rhoi[4];
 	double sum = 0.0;
 	for (i = 0; i < 4; i++) {
 	  if (rho == 0)
@@ -961,7 +961,7 @@ FourNodeQuad::getResistingForceIncInertia()
 	const Vector &accel3 = theNodes[2]->getTrialAccel();
 	const Vector &accel4 = theNodes[3]->getTrialAccel();
 	
-	static double a[8];
+	double a[8];
 
 	a[0] = accel1(0);
 	a[1] = accel1(1);
@@ -132,7 +132,7 @@ class FourNodeQuad : public Element
     double pressure;	        // Normal surface traction (pressure) over entire element
 					 // Note: positive for outward normal
     double rho;
-    static double shp[3][4];	// Stores shape functions and derivatives (overwritten)
+    double shp[3][4];		// Stores shape functions and derivatives (overwritten)
     static double pts[4][2];	// Stores quadrature points
     static double wts[4];		// Stores quadrature weights
 
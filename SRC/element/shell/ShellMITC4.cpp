@@ -37,6 +37,7 @@
 #include <ID.h> 
 #include <Vector.h>
 #include <Matrix.h>
+#include <MatrixND.h>
 #include <Element.h>
 #include <Node.h>
 #include <SectionForceDeformation.h>
@@ -359,8 +360,8 @@ ShellMITC4::~ShellMITC4( )
 void  ShellMITC4::setDomain( Domain *theDomain ) 
 {  
   int i, j ;
-  static Vector eig(3) ;
-  static Matrix ddMembrane(3,3) ;
+  Vector eig(3) ;
+  Matrix ddMembrane(3,3) ;
 
   //node pointers
   for ( i = 0; i < 4; i++ ) {
@@ -825,47 +826,37 @@ const Matrix&  ShellMITC4::getInitialStiff( )
 
   double volume = 0.0 ;
 
-  static double xsj ;  // determinant jacaobian matrix 
+  double xsj ;  // determinant jacaobian matrix 
 
-  static double dvol[ngauss] ; //volume element
+  double dvol[ngauss] ; //volume element
 
-  static double shp[3][numnodes] ;  //shape functions at a gauss point
+  double shp[3][numnodes] ;  //shape functions at a gauss point
 
   //  static double Shape[3][numnodes][ngauss] ; //all the shape functions
 
-  static Matrix stiffJK(ndf,ndf) ; //nodeJK stiffness 
-
-  static Matrix dd(nstress,nstress) ;  //material tangent
+  MatrixND<ndf,ndf> stiffJK ; //nodeJK stiffness 
 
-  static Matrix J0(2,2) ;  //Jacobian at center
- 
-  static Matrix J0inv(2,2) ; //inverse of Jacobian at center
+  MatrixND<nstress,nstress> dd ;  //material tangent
 
   //---------B-matrices------------------------------------
 
-    static Matrix BJ(nstress,ndf) ;      // B matrix node J
-
-    static Matrix BJtran(ndf,nstress) ;
-
-    static Matrix BK(nstress,ndf) ;      // B matrix node k
+    MatrixND<nstress,ndf> BJ ;      // B matrix node J
 
-    static Matrix BJtranD(ndf,nstress) ;
+    MatrixND<ndf,nstress> BJtranD ;
 
 
-    static Matrix Bbend(3,3) ;  // bending B matrix
+    MatrixND<3,2> Bbend ;  // bending B matrix
 
-    static Matrix Bshear(2,3) ; // shear B matrix
+    MatrixND<2,3> Bshear ; // shear B matrix
 
-    static Matrix Bmembrane(3,2) ; // membrane B matrix
+    MatrixND<3,2> Bmembrane ; // membrane B matrix
 
 
-    static double BdrillJ[ndf] ; //drill B matrix
+    double BdrillJ[ndf] ; //drill B matrix
 
-    static double BdrillK[ndf] ;  
+    double BdrillK[ndf] ;  
 
-    double *drillPointer ;
-
-    static double saveB[nstress][ndf][numnodes] ;
+    MatrixND<nstress,ndf> saveB[numnodes] ;
 
   //-------------------------------------------------------
 
@@ -974,30 +965,22 @@ const Matrix&  ShellMITC4::getInitialStiff( )
 
       //compute B matrix 
 
-      Bmembrane = computeBmembrane( j, shp ) ;
+      computeBmembrane( j, shp, Bmembrane ) ;
 
-      Bbend = computeBbend( j, shp ) ;
+      computeBbend( j, shp, Bbend ) ;
 
       for ( p = 0; p < 3; p++) {
 		  Bshear(0,p) = Bs(0,j*3+p);
 		  Bshear(1,p) = Bs(1,j*3+p);
       }//end for p
 
-      BJ = assembleB( Bmembrane, Bbend, Bshear ) ;
+      assembleB( Bmembrane, Bbend, Bshear, BJ ) ;
 
       //save the B-matrix
-      for (p=0; p<nstress; p++) {
-	    for (q=0; q<ndf; q++ )
-	      saveB[p][q][j] = BJ(p,q) ;
-      }//end for p
+      saveB[j] = BJ ;
 
       //drilling B matrix
-      drillPointer = computeBdrill( j, shp ) ;
-      for (p=0; p<ndf; p++ ) {
-	    //BdrillJ[p] = *drillPointer++ ;
-	    BdrillJ[p] = *drillPointer ; //set p-th component
-	    drillPointer++ ;             //pointer arithmetic
-      }//end for p
+      computeBdrill( j, shp, BdrillJ ) ;
     } // end for j
   
 
@@ -1011,10 +994,7 @@ const Matrix&  ShellMITC4::getInitialStiff( )
     for ( j = 0; j < numnodes; j++ ) {
 
       //extract BJ
-      for (p=0; p<nstress; p++) {
-	for (q=0; q<ndf; q++ )
-	  BJ(p,q) = saveB[p][q][j]   ;
-      }//end for p
+      BJ = saveB[j] ;
 
       //multiply bending terms by (-1.0) for correct statement
       // of equilibrium  
@@ -1024,22 +1004,11 @@ const Matrix&  ShellMITC4::getInitialStiff( )
       } //end for p
 
 
-      //transpose 
-      //BJtran = transpose( 8, ndf, BJ ) ;
-      for (p=0; p<ndf; p++) {
-	for (q=0; q<nstress; q++) 
-	  BJtran(p,q) = BJ(q,p) ;
-      }//end for p
-
       //drilling B matrix
-      drillPointer = computeBdrill( j, shp ) ;
-      for (p=0; p<ndf; p++ ) {
-	BdrillJ[p] = *drillPointer ;
-	drillPointer++ ;
-      }//end for p
+      computeBdrill( j, shp, BdrillJ ) ;
 
-      //BJtranD = BJtran * dd ;
-      BJtranD.addMatrixProduct(0.0, BJtran,dd,1.0 ) ;
+      //BJtranD = BJ' * dd ;
+      BJtranD.addMatrixTransposeProduct(0.0, BJ,dd,1.0 ) ;
       
       for (p=0; p<ndf; p++) 
 	BdrillJ[p] *= ( Ktt*dvol[i] ) ;
@@ -1047,23 +1016,12 @@ const Matrix&  ShellMITC4::getInitialStiff( )
       kk = 0 ;
       for ( k = 0; k < numnodes; k++ ) {
 
-	//extract BK
-	for (p=0; p<nstress; p++) {
-	  for (q=0; q<ndf; q++ )
-	    BK(p,q) = saveB[p][q][k]   ;
-	}//end for p
-	
-	
 	//drilling B matrix
-	drillPointer = computeBdrill( k, shp ) ;
-	for (p=0; p<ndf; p++ ) {
-	  BdrillK[p] = *drillPointer ;
-	  drillPointer++ ;
-	}//end for p
+	computeBdrill( k, shp, BdrillK ) ;
 	
-	//stiffJK = BJtranD * BK  ;
+	//stiffJK = BJtranD * BK  ;  with BK = saveB[k]
 	// +  transpose( 1,ndf,BdrillJ ) * BdrillK ; 
-	stiffJK.addMatrixProduct(0.0, BJtranD,BK,1.0 ) ;
+	stiffJK.addMatrixProduct(0.0, BJtranD,saveB[k],1.0 ) ;
 	
 	for ( p = 0; p < ndf; p++ )  {
 	  for ( q = 0; q < ndf; q++ ) {
@@ -1236,9 +1194,9 @@ ShellMITC4::formInertiaTerms( int tangFlag )
 
   double dvol ; //volume element
 
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
+  double shp[nShape][numberNodes] ;  //shape functions at a gauss point
 
-  static Vector momentum(ndf) ;
+  VectorND<ndf> momentum ;
 
 
   int i, j, k, p;
@@ -1262,11 +1220,12 @@ ShellMITC4::formInertiaTerms( int tangFlag )
 
     //node loop to compute accelerations
     momentum.Zero( ) ;
-    for ( j = 0; j < numberNodes; j++ ) 
+    for ( j = 0; j < numberNodes; j++ ) {
       //momentum += ( shp[massIndex][j] * nodePointers[j]->getTrialAccel() ) ;
-      momentum.addVector(1.0,  
-			 nodePointers[j]->getTrialAccel(),
-			 shp[massIndex][j] ) ;
+      const Vector &accel = nodePointers[j]->getTrialAccel( ) ;
+      for ( p = 0; p < ndf; p++ )
+	momentum(p) += shp[massIndex][j] * accel(p) ;
+    }
 
       
     //density
@@ -1367,29 +1326,25 @@ ShellMITC4::formResidAndTangent( int tang_flag )
   
   double volume = 0.0 ;
 
-  static double xsj ;  // determinant jacaobian matrix 
+  double xsj ;  // determinant jacaobian matrix 
 
-  static double dvol[ngauss] ; //volume element
+  double dvol[ngauss] ; //volume element
 
-  static Vector strain(nstress) ;  //strain
+  VectorND<nstress> strain ;  //strain
 
-  static double shp[3][numnodes] ;  //shape functions at a gauss point
+  double shp[3][numnodes] ;  //shape functions at a gauss point
 
   //  static double Shape[3][numnodes][ngauss] ; //all the shape functions
 
-  static Vector residJ(ndf) ; //nodeJ residual 
-
-  static Matrix stiffJK(ndf,ndf) ; //nodeJK stiffness 
+  VectorND<ndf> residJ ; //nodeJ residual 
 
-  static Vector stress(nstress) ;  //stress resultants
+  MatrixND<ndf,ndf> stiffJK ; //nodeJK stiffness 
 
-  static Vector dampingStress(nstress); // damping stress resultants
+  VectorND<nstress> stress ;  //stress resultants
 
-  static Matrix dd(nstress,nstress) ;  //material tangent
+  VectorND<nstress> dampingStress = {}; // damping stress resultants
 
-  static Matrix J0(2,2) ;  //Jacobian at center
- 
-  static Matrix J0inv(2,2) ; //inverse of Jacobian at center
+  MatrixND<nstress,nstress> dd ;  //material tangent
 
   double epsDrill = 0.0 ;  //drilling "strain"
 
@@ -1397,29 +1352,23 @@ ShellMITC4::formResidAndTangent( int tang_flag )
 
   //---------B-matrices------------------------------------
 
-    static Matrix BJ(nstress,ndf) ;      // B matrix node J
-
-    static Matrix BJtran(ndf,nstress) ;
-
-    static Matrix BK(nstress,ndf) ;      // B matrix node k
+    MatrixND<nstress,ndf> BJ ;      // B matrix node J
 
-    static Matrix BJtranD(ndf,nstress) ;
+    MatrixND<ndf,nstress> BJtranD ;
 
 
-    static Matrix Bbend(3,3) ;  // bending B matrix
+    MatrixND<3,2> Bbend ;  // bending B matrix
 
-    static Matrix Bshear(2,3) ; // shear B matrix
+    MatrixND<2,3> Bshear ; // shear B matrix
 
-    static Matrix Bmembrane(3,2) ; // membrane B matrix
+    MatrixND<3,2> Bmembrane ; // membrane B matrix
 
 
-    static double BdrillJ[ndf] ; //drill B matrix
+    double BdrillJ[ndf] ; //drill B matrix
 
-    static double BdrillK[ndf] ;  
+    double BdrillK[ndf] ;  
 
-    double *drillPointer ;
-
-    static double saveB[nstress][ndf][numnodes] ;
+    MatrixND<nstress,ndf> saveB[numnodes] ;
 
   //------------------------------------------------------- 
 
@@ -1539,27 +1488,24 @@ ShellMITC4::formResidAndTangent( int tang_flag )
 
       //compute B matrix 
 
-      Bmembrane = computeBmembrane( j, shp ) ;
+      computeBmembrane( j, shp, Bmembrane ) ;
 
-      Bbend = computeBbend( j, shp ) ;
+      computeBbend( j, shp, Bbend ) ;
 
       for ( p = 0; p < 3; p++) {
 		  Bshear(0,p) = Bs(0,j*3+p);
 		  Bshear(1,p) = Bs(1,j*3+p);
       }//end for p
 
-      BJ = assembleB( Bmembrane, Bbend, Bshear ) ;
+      assembleB( Bmembrane, Bbend, Bshear, BJ ) ;
 
       //save the B-matrix
-      for (p=0; p<nstress; p++) {
-	for (q=0; q<ndf; q++ )
-	  saveB[p][q][j] = BJ(p,q) ;
-      }//end for p
+      saveB[j] = BJ ;
 
 
       //nodal "displacements" 
       const Vector &ul_tmp = nodePointers[j]->getTrialDisp( ) ;
-      static Vector ul(6); ul.Zero();
+      VectorND<6> ul;
 
       ul(0) = ul_tmp(0) - init_disp[j][0];
       ul(1) = ul_tmp(1) - init_disp[j][1];
@@ -1573,11 +1519,7 @@ ShellMITC4::formResidAndTangent( int tang_flag )
       strain.addMatrixVector(1.0, BJ,ul,1.0 ) ;
 
       //drilling B matrix
-      drillPointer = computeBdrill( j, shp ) ;
-      for (p=0; p<ndf; p++ ) {
-	      BdrillJ[p] = *drillPointer ; //set p-th component
-	      drillPointer++ ;             //pointer arithmetic
-      }//end for p
+      computeBdrill( j, shp, BdrillJ ) ;
 
       //drilling "strain" 
       for ( p = 0; p < ndf; p++ )
@@ -1618,10 +1560,7 @@ ShellMITC4::formResidAndTangent( int tang_flag )
     for ( j = 0; j < numnodes; j++ ) {
 
       //extract BJ
-      for (p=0; p<nstress; p++) {
-	    for (q=0; q<ndf; q++ )
-	      BJ(p,q) = saveB[p][q][j]   ;
-      }//end for p
+      BJ = saveB[j] ;
 
       //multiply bending terms by (-1.0) for correct statement
       // of equilibrium  
@@ -1630,21 +1569,12 @@ ShellMITC4::formResidAndTangent( int tang_flag )
 	      BJ(p,q) *= (-1.0) ;
       } //end for p
 
-      //transpose 
-      for (p=0; p<ndf; p++) {
-	    for (q=0; q<nstress; q++) 
-	      BJtran(p,q) = BJ(q,p) ;
-      }//end for p
-
-      residJ.addMatrixVector(0.0, BJtran,stress,1.0 ) ;
-      if (theDamping[i]) residJ.addMatrixVector(1.0, BJtran,dampingStress,1.0 ) ;
+      //residJ = BJ' * stress ;
+      residJ.addMatrixTransposeVector(0.0, BJ,stress,1.0 ) ;
+      if (theDamping[i]) residJ.addMatrixTransposeVector(1.0, BJ,dampingStress,1.0 ) ;
 
       //drilling B matrix
-      drillPointer = computeBdrill( j, shp ) ;
-      for (p=0; p<ndf; p++ ) {
-	    BdrillJ[p] = *drillPointer ;
-	    drillPointer++ ;
-      }//end for p
+      computeBdrill( j, shp, BdrillJ ) ;
 
       //residual including drill
       for ( p = 0; p < ndf; p++ )
@@ -1652,7 +1582,7 @@ ShellMITC4::formResidAndTangent( int tang_flag )
 
       if ( tang_flag == 1 ) {
 
-	    BJtranD.addMatrixProduct(0.0, BJtran,dd,1.0 ) ;
+	    BJtranD.addMatrixTransposeProduct(0.0, BJ,dd,1.0 ) ;
 
 	    for (p=0; p<ndf; p++) 
 	      BdrillJ[p] *= ( Ktt*dvol[i] ) ;
@@ -1660,22 +1590,12 @@ ShellMITC4::formResidAndTangent( int tang_flag )
         kk = 0 ;
         for ( k = 0; k < numnodes; k++ ) {
 
-	      //extract BK
-	      for (p=0; p<nstress; p++) {
-	        for (q=0; q<ndf; q++ )
-	          BK(p,q) = saveB[p][q][k]   ;
-	      }//end for p
-	  
 	      //drilling B matrix
-	      drillPointer = computeBdrill( k, shp ) ;
-	      for (p=0; p<ndf; p++ ) {
-	        BdrillK[p] = *drillPointer ;
-	        drillPointer++ ;
-	      }//end for p
+	      computeBdrill( k, shp, BdrillK ) ;
  
-          //stiffJK = BJtranD * BK  ;
+          //stiffJK = BJtranD * BK  ;  with BK = saveB[k]
 	      // +  transpose( 1,ndf,BdrillJ ) * BdrillK ; 
-	      stiffJK.addMatrixProduct(0.0, BJtranD,BK,1.0 ) ;
+	      stiffJK.addMatrixProduct(0.0, BJtranD,saveB[k],1.0 ) ;
 
           for ( p = 0; p < ndf; p++ )  {
 	        for ( q = 0; q < ndf; q++ ) {
@@ -1703,7 +1623,7 @@ ShellMITC4::formResidAndTangent( int tang_flag )
       const int massIndex = nShape - 1 ;
       double temp, rhoH;
       //If defined, apply self-weight
-      static Vector momentum(ndf) ;
+      VectorND<ndf> momentum ;
       double ddvol = 0;
       for ( i = 0; i < numberGauss; i++ ) {
 
@@ -1753,11 +1673,11 @@ ShellMITC4::computeBasis( )
   //and use those as basis vectors but this is easier 
   //and the shell is flat anyway.
 
-  static Vector temp(3) ;
+  VectorND<3> temp ;
 
-  static Vector v1(3) ;
-  static Vector v2(3) ;
-  static Vector v3(3) ;
+  VectorND<3> v1 ;
+  VectorND<3> v2 ;
+  VectorND<3> v3 ;
 
   //get two vectors (v1, v2) in plane of shell by 
   // nodal coordinate differences
@@ -1794,7 +1714,7 @@ ShellMITC4::computeBasis( )
   //Gram-Schmidt process for v2 
 
   //double alpha = LovelyInnerProduct( v2, v1 ) ;
-  double alpha = v2^v1 ;
+  double alpha = v2.dot( v1 ) ;
 
   //v2 -= alpha*v1 ;
   temp = v1 ;
@@ -1807,7 +1727,7 @@ ShellMITC4::computeBasis( )
   v2 /= length ;
 
   //cross product for v3  
-  v3 = LovelyCrossProduct( v1, v2 ) ;
+  v3 = cross( v1, v2 ) ;
   
   //local nodal coordinates in plane of shell
 
@@ -1841,11 +1761,11 @@ ShellMITC4::updateBasis( )
   //and use those as basis vectors but this is easier 
   //and the shell is flat anyway.
 
-  static Vector temp(3) ;
+  VectorND<3> temp ;
 
-  static Vector v1(3) ;
-  static Vector v2(3) ;
-  static Vector v3(3) ;
+  VectorND<3> v1 ;
+  VectorND<3> v2 ;
+  VectorND<3> v3 ;
 
   //get two vectors (v1, v2) in plane of shell by 
   // nodal coordinate differences
@@ -1887,7 +1807,7 @@ ShellMITC4::updateBasis( )
   //Gram-Schmidt process for v2 
 
   //double alpha = LovelyInnerProduct( v2, v1 ) ;
-  double alpha = v2^v1 ;
+  double alpha = v2.dot( v1 ) ;
 
   //v2 -= alpha*v1 ;
   temp = v1 ;
@@ -1900,7 +1820,7 @@ ShellMITC4::updateBasis( )
   v2 /= length ;
 
   //cross product for v3  
-  v3 = LovelyCrossProduct( v1, v2 ) ;
+  v3 = cross( v1, v2 ) ;
   
   //local nodal coordinates in plane of shell
 
@@ -1927,15 +1847,14 @@ ShellMITC4::updateBasis( )
 //*************************************************************************
 //compute Bdrill
 
-double*
-ShellMITC4::computeBdrill( int node, const double shp[3][4] )
+void
+ShellMITC4::computeBdrill( int node, const double shp[3][4], double Bdrill[6] )
 {
 
   //static Matrix Bdrill(1,6) ;
-  static double Bdrill[6] ;
-  static double B1 ;
-  static double B2 ;
-  static double B6 ;
+  double B1 ;
+  double B2 ;
+  double B6 ;
 
 
 //---Bdrill Matrix in standard {1,2,3} mechanics notation---------
@@ -1969,7 +1888,7 @@ ShellMITC4::computeBdrill( int node, const double shp[3][4] )
   Bdrill[4] = B6*g3[1] ; 
   Bdrill[5] = B6*g3[2] ;
  
-  return Bdrill ;
+  return ;
 
 }
 
@@ -1977,10 +1896,11 @@ ShellMITC4::computeBdrill( int node, const double shp[3][4] )
 //********************************************************************
 //assemble a B matrix
 
-const Matrix&  
-ShellMITC4::assembleB( const Matrix &Bmembrane,
-                               const Matrix &Bbend, 
-                               const Matrix &Bshear ) 
+void
+ShellMITC4::assembleB( const MatrixND<3,2> &Bmembrane,
+		       const MatrixND<3,2> &Bbend, 
+		       const MatrixND<2,3> &Bshear,
+		       MatrixND<8,6> &B ) 
 {
 
   //Matrix Bbend(3,3) ;  // plate bending B matrix
@@ -1990,17 +1910,15 @@ ShellMITC4::assembleB( const Matrix &Bmembrane,
   //Matrix Bmembrane(3,2) ; // plate membrane B matrix
 
 
-    static Matrix B(8,6) ;
-
-    static Matrix BmembraneShell(3,3) ; 
+    MatrixND<3,3> BmembraneShell ; 
     
-    static Matrix BbendShell(3,3) ; 
+    MatrixND<3,3> BbendShell ; 
 
-    static Matrix BshearShell(2,6) ;
+    MatrixND<2,6> BshearShell ;
  
-    static Matrix Gmem(2,3) ;
+    MatrixND<2,3> Gmem ;
 
-    static Matrix Gshear(3,6) ;
+    MatrixND<3,6> Gshear ;
 
     int p, q ;
     int pp ;
@@ -2039,7 +1957,7 @@ ShellMITC4::assembleB( const Matrix &Bmembrane,
 
     //shell modified bending terms 
 
-    Matrix &Gbend = Gmem ;
+    MatrixND<2,3> &Gbend = Gmem ;
 
     //BbendShell = Bbend * Gbend ;
     BbendShell.addMatrixProduct(0.0, Bbend,Gbend,1.0 ) ; 
@@ -2096,19 +2014,18 @@ ShellMITC4::assembleB( const Matrix &Bmembrane,
  
   } //end for p
   
-  return B ;
+  return ;
 
 }
 
 //***********************************************************************
 //compute Bmembrane matrix
 
-const Matrix&   
-ShellMITC4::computeBmembrane( int node, const double shp[3][4] ) 
+void
+ShellMITC4::computeBmembrane( int node, const double shp[3][4],
+			      MatrixND<3,2> &Bmembrane ) 
 {
 
-  static Matrix Bmembrane(3,2) ;
-
 //---Bmembrane Matrix in standard {1,2,3} mechanics notation---------
 //
 //                -             -
@@ -2127,19 +2044,18 @@ ShellMITC4::computeBmembrane( int node, const double shp[3][4] )
   Bmembrane(2,0) = shp[1][node] ;
   Bmembrane(2,1) = shp[0][node] ;
 
-  return Bmembrane ;
+  return ;
 
 }
 
 //***********************************************************************
 //compute Bbend matrix
 
-const Matrix&   
-ShellMITC4::computeBbend( int node, const double shp[3][4] )
+void
+ShellMITC4::computeBbend( int node, const double shp[3][4],
+			  MatrixND<3,2> &Bbend )
 {
 
-    static Matrix Bbend(3,2) ;
-
 //---Bbend Matrix in standard {1,2,3} mechanics notation---------
 //
 //            -             -
@@ -2158,7 +2074,7 @@ ShellMITC4::computeBbend( int node, const double shp[3][4] )
     Bbend(2,0) =  shp[0][node] ;
     Bbend(2,1) = -shp[1][node] ; 
 
-    return Bbend ;
+    return ;
 }
 
 
@@ -2181,8 +2097,8 @@ ShellMITC4::shape2d( double ss, double tt,
   static const double s[] = { -0.5,  0.5, 0.5, -0.5 } ;
   static const double t[] = { -0.5, -0.5, 0.5,  0.5 } ;
 
-  static double xs[2][2] ;
-  static double sx[2][2] ;
+  double xs[2][2] ;
+  double sx[2][2] ;
 
   for ( i = 0; i < 4; i++ ) {
       shp[2][i] = ( 0.5 + s[i]*ss )*( 0.5 + t[i]*tt ) ;
@@ -40,6 +40,7 @@
 #include <ID.h> 
 #include <Vector.h>
 #include <Matrix.h>
+#include <MatrixND.h>
 #include <Element.h>
 #include <Node.h>
 #include <SectionForceDeformation.h>
@@ -174,18 +175,19 @@ class ShellMITC4 : public Element {
     void formResidAndTangent( int tang_flag ) ;
 
     //compute Bdrill matrix
-    double* computeBdrill( int node, const double shp[3][4] ) ;
+    void computeBdrill( int node, const double shp[3][4], double Bdrill[6] ) ;
 
     //assemble a B matrix 
-    const Matrix& assembleB( const Matrix &Bmembrane,
-			                 const Matrix &Bbend, 
-			                 const Matrix &Bshear ) ;
+    void assembleB( const MatrixND<3,2> &Bmembrane,
+		    const MatrixND<3,2> &Bbend, 
+		    const MatrixND<2,3> &Bshear,
+		    MatrixND<8,6> &B ) ;
   
     //compute Bmembrane matrix
-    const Matrix& computeBmembrane( int node, const double shp[3][4] ) ;
+    void computeBmembrane( int node, const double shp[3][4], MatrixND<3,2> &Bmembrane ) ;
   
     //compute Bbend matrix
-    const Matrix& computeBbend( int node, const double shp[3][4] ) ;
+    void computeBbend( int node, const double shp[3][4], MatrixND<3,2> &Bbend ) ;
   
     //Matrix transpose
     Matrix transpose( int dim1, int dim2, const Matrix &M ) ;
@@ -0,0 +1,220 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of CSRGraph.
+//
+#include <CSRGraph.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <ID.h>
+#include <ThreadPool.h>
+#include <OPS_Globals.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+
+// invokes func(begin, end) over chunks of [0, n), on the threads of the
+// pool if there is one
+template <class Func>
+static void
+forChunks(ThreadPool *thePool, int n, const Func &func)
+{
+  if (thePool == 0 || thePool->getNumThreads() == 1 || n < 2) {
+    func(0, n);
+    return;
+  }
+
+  int numChunks = 4*thePool->getNumThreads();
+  if (numChunks > n)
+    numChunks = n;
+  thePool->run(numChunks, [&](int chunk, int) {
+    func((int)((long long)n*chunk/numChunks),
+	 (int)((long long)n*(chunk+1)/numChunks));
+  });
+}
+
+CSRGraph::CSRGraph()
+  :start(1, 0)
+{
+
+}
+
+CSRGraph::~CSRGraph()
+{
+
+}
+
+int
+CSRGraph::build(int numVertex, const std::vector<const ID *> &theSets,
+		ThreadPool *thePool)
+{
+  start.assign(1, 0);
+  adjacency.clear();
+
+  if (numVertex <= 0)
+    return 0;
+
+  int numSets = theSets.size();
+
+  // count the entries of each row, duplicates included
+  std::vector<std::atomic<int> > count(numVertex);
+  for (int v=0; v<numVertex; v++)
+    count[v].store(0, std::memory_order_relaxed);
+
+  forChunks(thePool, numSets, [&](int begin, int end) {
+    for (int s=begin; s<end; s++) {
+      const ID &theSet = *theSets[s];
+      int size = theSet.Size();
+      for (int i=0; i<size; i++) {
+	int v = theSet(i);
+	if (v < 0 || v >= numVertex)
+	  continue;
+	int numAdj = 0;
+	for (int j=0; j<size; j++) {
+	  int w = theSet(j);
+	  if (w >= 0 && w < numVertex && w != v)
+	    numAdj++;
+	}
+	if (numAdj != 0)
+	  count[v].fetch_add(numAdj, std::memory_order_relaxed);
+      }
+    }
+  });
+
+  std::vector<int> bound(numVertex+1);
+  long long total = 0;
+  bound[0] = 0;
+  for (int v=0; v<numVertex; v++) {
+    total += count[v].load(std::memory_order_relaxed);
+    if (total > INT_MAX) {
+      opserr << "WARNING CSRGraph::build() - too many entries for int indexing\n";
+      return -1;
+    }
+    bound[v+1] = (int)total;
+    count[v].store(bound[v], std::memory_order_relaxed);
+  }
+
+  // fill the rows, count now serving as the cursor of each row
+  std::vector<int> entries(total);
+  forChunks(thePool, numSets, [&](int begin, int end) {
+    for (int s=begin; s<end; s++) {
+      const ID &theSet = *theSets[s];
+      int size = theSet.Size();
+      for (int i=0; i<size; i++) {
+	int v = theSet(i);
+	if (v < 0 || v >= numVertex)
+	  continue;
+	for (int j=0; j<size; j++) {
+	  int w = theSet(j);
+	  if (w >= 0 && w < numVertex && w != v)
+	    entries[count[v].fetch_add(1, std::memory_order_relaxed)] = w;
+	}
+      }
+    }
+  });
+
+  // sort each row and drop the duplicates
+  std::vector<int> degree(numVertex);
+  forChunks(thePool, numVertex, [&](int begin, int end) {
+    for (int v=begin; v<end; v++) {
+      int *first = total ? &entries[0] + bound[v] : 0;
+      int *last = total ? &entries[0] + bound[v+1] : 0;
+      std::sort(first, last);
+      degree[v] = std::unique(first, last) - first;
+    }
+  });
+
+  start.resize(numVertex+1);
+  start[0] = 0;
+  for (int v=0; v<numVertex; v++)
+    start[v+1] = start[v] + degree[v];
+
+  adjacency.resize(start[numVertex]);
+  forChunks(thePool, numVertex, [&](int begin, int end) {
+    for (int v=begin; v<end; v++)
+      std::copy(entries.begin() + bound[v], entries.begin() + bound[v] + degree[v],
+		adjacency.begin() + start[v]);
+  });
+
+  return 0;
+}
+
+int
+CSRGraph::build(Graph &theGraph)
+{
+  int numVertex = theGraph.getNumVertex();
+  start.assign(numVertex+1, 0);
+  adjacency.clear();
+
+  for (int v=0; v<numVertex; v++) {
+    Vertex *vertexPtr = theGraph.getVertexPtr(v + START_VERTEX_NUM);
+    if (vertexPtr == 0) {
+      opserr << "WARNING CSRGraph::build() - vertex tags are not consecutive\n";
+      start.assign(1, 0);
+      adjacency.clear();
+      return -1;
+    }
+
+    const ID &theAdjacency = vertexPtr->getAdjacency();
+    int degree = theAdjacency.Size();
+    for (int i=0; i<degree; i++)
+      adjacency.push_back(theAdjacency(i) - START_VERTEX_NUM);
+    std::sort(adjacency.begin() + start[v], adjacency.end());
+    start[v+1] = adjacency.size();
+  }
+
+  return 0;
+}
+
+int
+CSRGraph::getNumVertex(void) const
+{
+  return start.size() - 1;
+}
+
+int
+CSRGraph::getNumEdge(void) const
+{
+  return adjacency.size()/2;
+}
+
+int
+CSRGraph::getDegree(int vertex) const
+{
+  if (vertex < 0 || vertex >= (int)start.size() - 1)
+    return 0;
+  return start[vertex+1] - start[vertex];
+}
+
+const int *
+CSRGraph::getStart(void) const
+{
+  return &start[0];
+}
+
+const int *
+CSRGraph::getAdjacency(void) const
+{
+  if (adjacency.empty())
+    return 0;
+  return &adjacency[0];
+}
@@ -0,0 +1,66 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for CSRGraph.
+// A CSRGraph is a compact, immutable graph on the vertices 0 through
+// numVertex-1, held in compressed sparse row form: the neighbours of
+// vertex v are adjacency[start[v]] through adjacency[start[v+1]-1], in
+// ascending order. It is built from a collection of sets, the vertices
+// of each set being connected to one another, by counting the entries
+// of every row and then filling them, both passes optionally shared out
+// over the threads of a ThreadPool.
+//
+#ifndef CSRGraph_h
+#define CSRGraph_h
+
+#include <vector>
+
+class ID;
+class Graph;
+class ThreadPool;
+
+class CSRGraph
+{
+  public:
+    CSRGraph();
+    ~CSRGraph();
+
+    // forms the graph of numVertex vertices in which the entries of each
+    // set are connected; entries outside [0, numVertex) are ignored
+    int build(int numVertex, const std::vector<const ID *> &theSets,
+	      ThreadPool *thePool = 0);
+
+    // forms the graph from a Graph with vertex tags 0 through numVertex-1
+    int build(Graph &theGraph);
+
+    int getNumVertex(void) const;
+    int getNumEdge(void) const;
+    int getDegree(int vertex) const;
+
+    // the numVertex+1 row starts into the adjacency, and the adjacency
+    const int *getStart(void) const;
+    const int *getAdjacency(void) const;
+
+  private:
+    std::vector<int> start;
+    std::vector<int> adjacency;
+};
+
+#endif
@@ -37,6 +37,8 @@
 #include <Vertex.h>
 #include <VertexIter.h>
 #include <MapOfTaggedObjects.h>
+#include <ArrayOfTaggedObjects.h>
+#include <CSRGraph.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <Vector.h>
@@ -88,7 +90,8 @@ Graph::Graph(Graph &other)
   while ((vertexPtr = otherVertices()) != 0) {
     int vertexTag = vertexPtr->getTag();
     int vertexRef = vertexPtr->getRef();
-    vertexPtr = new Vertex(vertexTag, vertexRef);
+    vertexPtr = new Vertex(vertexTag, vertexRef, vertexPtr->getWeight(),
+			   vertexPtr->getColor());
     if (vertexPtr == 0) {
       opserr << "Graph::Graph - out of memory\n";
       return;
@@ -110,6 +113,31 @@ Graph::Graph(Graph &other)
   }
 }
 
+// creates a vertex with tag and ref i for each vertex i of the CSRGraph,
+// its adjacency set in one go rather than an edge at a time
+Graph::Graph(const CSRGraph &other)
+  :myVertices(0), theVertexIter(0), numEdge(other.getNumEdge()),
+  nextFreeTag(START_VERTEX_NUM), vertices()
+{
+  int numVertex = other.getNumVertex();
+  myVertices = new ArrayOfTaggedObjects(numVertex > 0 ? numVertex : 32);
+  theVertexIter = new VertexIter(myVertices);
+
+  const int *start = other.getStart();
+  const int *adjacency = other.getAdjacency();
+  ID theAdjacency(0, 8);
+  for (int i=0; i<numVertex; i++) {
+    int degree = start[i+1] - start[i];
+    theAdjacency.resize(degree);
+    for (int j=0; j<degree; j++)
+      theAdjacency(j) = adjacency[start[i]+j] + START_VERTEX_NUM;
+
+    Vertex *vertexPtr = new Vertex(i + START_VERTEX_NUM, i + START_VERTEX_NUM);
+    vertexPtr->setAdjacency(theAdjacency);
+    this->addVertex(vertexPtr, false);
+  }
+}
+
 Graph::~Graph()
 {
     // invoke delete on the Vertices
@@ -43,6 +43,7 @@
 class Vertex;
 class VertexIter;
 class TaggedObjectStorage;
+class CSRGraph;
 class Channel;
 class FEM_ObjectBroker;
 
@@ -53,6 +54,7 @@ class Graph
     Graph(int numVertices);    
     Graph(TaggedObjectStorage &theVerticesStorage);
     Graph(Graph &other);
+    explicit Graph(const CSRGraph &other);
     virtual ~Graph();
 
     virtual bool addVertex(Vertex *vertexPtr, bool checkAdjacency = true);
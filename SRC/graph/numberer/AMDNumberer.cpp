@@ -33,6 +33,7 @@
 #include <Graph.h>
 #include <Vertex.h>
 #include <VertexIter.h>
+#include <CSRGraph.h>
 #include <ID.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
@@ -104,6 +105,31 @@ AMD::number(Graph &theGraph, int startVertex)
 }
 
 
+// the CSRGraph is already in the form amd_order() wants
+const ID &
+AMD::number(const CSRGraph &theGraph, int startVertex)
+{
+  int numVertex = theGraph.getNumVertex();
+
+  if (numVertex == 0) 
+    return theResult;
+
+  theResult.resize(numVertex);
+
+  int *P = new int[numVertex];
+
+  amd_order(numVertex, theGraph.getStart(), theGraph.getAdjacency(), P,
+	    (double *)NULL, (double *)NULL);
+  
+  for (int i=0; i<numVertex; i++)
+    theResult[i] = P[i];
+
+  delete [] P;
+
+  return theResult;
+}
+
+
 
 int
 AMD::sendSelf(int commitTag, Channel &theChannel)
@@ -33,6 +33,9 @@
 
 
 #include <GraphNumberer.h>
+#include <Graph.h>
+#include <CSRGraph.h>
+
 GraphNumberer::GraphNumberer(int cTag)
 :MovableObject(cTag)
 {
@@ -44,6 +47,13 @@ GraphNumberer::~GraphNumberer()
     // does nothing
 }
 
+const ID &
+GraphNumberer::number(const CSRGraph &theGraph, int lastVertex)
+{
+    Graph theCopy(theGraph);
+    return this->number(theCopy, lastVertex);
+}
+
 
 
 
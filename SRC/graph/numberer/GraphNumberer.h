@@ -41,6 +41,7 @@
 
 class ID;
 class Graph;
+class CSRGraph;
 class Channel;
 class ObjectBroker;
 
@@ -52,6 +53,10 @@ class GraphNumberer : public MovableObject
     
     virtual const ID &number(Graph &theGraph, int lastVertex = -1) =0;
     virtual const ID &number(Graph &theGraph, const ID &lastVertices) =0;
+
+    // numbers the vertices of a CSRGraph, returning vertex indices; by
+    // default the vertices are numbered through a Graph copy
+    virtual const ID &number(const CSRGraph &theGraph, int lastVertex = -1);
     
   protected:
     
@@ -37,9 +37,11 @@
 #include <Graph.h>
 #include <Vertex.h>
 #include <VertexIter.h>
+#include <CSRGraph.h>
 #include <ID.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
+#include <vector>
 
 // Constructor
 RCM::RCM(bool gps)
@@ -272,6 +274,85 @@ RCM::number(Graph &theGraph, int startVertex)
 }
 
 
+// const ID &number(const CSRGraph &theGraph, int startVertex = -1)
+//    The same numbering on a CSRGraph, the vertices marked in an array
+// rather than through their Tmp values. Without a starting vertex
+// vertex 0 is used; the Gibbs-Poole-Stockmeyer start goes through
+// the Graph version.
+
+const ID &
+RCM::number(const CSRGraph &theGraph, int startVertex)
+{
+    if (GPS == true)
+	return this->GraphNumberer::number(theGraph, startVertex);
+
+    // first check our size, if not same make new
+    if (numVertex != theGraph.getNumVertex()) {
+
+	// delete the old
+	if (theRefResult != 0)
+	    delete theRefResult;
+	
+	numVertex = theGraph.getNumVertex();
+	theRefResult = new ID(numVertex);
+    }
+
+    // see if we can do quick return
+    if (numVertex == 0) 
+	return *theRefResult;
+
+    const int *start = theGraph.getStart();
+    const int *adjacency = theGraph.getAdjacency();
+
+    // mark[v] is -1 until vertex v has been added
+    std::vector<int> mark(numVertex, -1);
+
+    if (startVertex < 0 || startVertex >= numVertex) {
+	if (startVertex != -1) {
+	    opserr << "WARNING:  RCM::number - No vertex with tag ";
+	    opserr << startVertex << "Exists - using vertex 0\n";
+	}
+	startVertex = 0;
+    }
+
+    int nextUnmarked = 0;          // no vertex before this is unmarked
+    int currentMark = numVertex-1;  // marks current vertex visiting.
+    int nextMark = currentMark -1;  // indiactes where to put next Tag in ID.
+    (*theRefResult)(currentMark) = startVertex;
+    mark[startVertex] = currentMark;
+
+    // we continue till the ID is full
+    while (nextMark >= 0) {
+	// go through the adjacency of the current vertex and add vertices
+	// which have not yet been marked to the (*theRefResult)
+	int vertex = (*theRefResult)(currentMark);
+	for (int i=start[vertex]; i<start[vertex+1]; i++) {
+	    int other = adjacency[i];
+	    if (mark[other] == -1) {
+		mark[other] = nextMark;
+		(*theRefResult)(nextMark--) = other;
+	    }
+	}
+
+	// go to the next vertex
+	//  we decrement because we are doing reverse Cuthill-McKee
+	currentMark--;
+
+	// check to see if graph is disconnected
+	if ((currentMark == nextMark) && (currentMark >= 0)) {
+	    while (mark[nextUnmarked] != -1)
+		nextUnmarked++;
+	    
+	    nextMark--;
+	    mark[nextUnmarked] = currentMark;
+	    (*theRefResult)(currentMark) = nextUnmarked;
+	}
+    }
+
+    return *theRefResult;
+}
+
+
 
 int
 RCM::sendSelf(int commitTag, Channel &theChannel)
@@ -56,6 +56,7 @@ class RCM: public GraphNumberer
 
     const ID &number(Graph &theGraph, int lastVertex = -1);
     const ID &number(Graph &theGraph, const ID &lastVertices);
+    const ID &number(const CSRGraph &theGraph, int lastVertex = -1);
 
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, 
@@ -40,6 +40,7 @@
 #include "MetisWrapper.h"
 #include <Graph.h>
 #include <Vertex.h>
+#include <CSRGraph.h>
 
 /* stuff needed to get the program working on the clump & NOW machines*/
 #include <bool.h>
@@ -268,6 +269,29 @@ Metis::partition(Graph &theGraph, int numPart)
     xadj[vertex + 1] = indexEdge;
   }
 
+  // the vertices are weighted if their weights differ, as they do once the
+  // elements have been timed; metis needs integer weights, which are
+  // scaled so that the heaviest vertex weighs 1000 and none weigh 0
+  double maxWeight = 0.0;
+  double minWeight = 0.0;
+  for (int vertex = 0; vertex < numVertex; vertex++) {
+    double weight = theGraph.getVertexPtr(vertex + START_VERTEX_NUM)->getWeight();
+    if (vertex == 0 || weight > maxWeight)
+      maxWeight = weight;
+    if (vertex == 0 || weight < minWeight)
+      minWeight = weight;
+  }
+
+  if (maxWeight > 0.0 && minWeight != maxWeight) {
+    vwgts = new int [numVertex];
+    for (int vertex = 0; vertex < numVertex; vertex++) {
+      double weight = theGraph.getVertexPtr(vertex + START_VERTEX_NUM)->getWeight();
+      int vwgt = (int)(1000.0 * weight / maxWeight + 0.5);
+      vwgts[vertex] = (vwgt > 0) ? vwgt : 1;
+    }
+    weightflag = 2; // weights on the vertices only
+  }
+
 
   if (defaultOptions == true)
     options[0] = 0;
@@ -320,6 +344,8 @@ Metis::partition(Graph &theGraph, int numPart)
       if(errorflag == METIS_ERROR_INPUT)  opserr << "Indicates an input error." << endln;
       else if(errorflag == METIS_ERROR_MEMORY) opserr << "Indicates that it could not allocate the required memory." << endln;
       else if(errorflag == METIS_ERROR) opserr << "Indicates some other type of error." << endln;
+      if (vwgts != 0)
+        delete [] vwgts;
       return -1;
     }
 #else
@@ -341,6 +367,8 @@ Metis::partition(Graph &theGraph, int numPart)
   delete [] partition;
   delete [] xadj;
   delete [] adjncy;
+  if (vwgts != 0)
+    delete [] vwgts;
 
   return 0;
 }
@@ -414,6 +442,72 @@ Metis::partitionHexMesh(int* elmnts, int* epart, int* npart, int ne, int nn, int
 
 
 
+// int partitionForNumbering(int numVertex, int *xadj, int *adjncy,
+//                           int *partition, int numbering)
+//	Invokes metis to split the graph in xadj/adjncy, with vertices
+//	numbered from numbering (0 or 1), into numPartitions parts.
+
+int
+Metis::partitionForNumbering(int numVertex, int *xadj, int *adjncy, int *partition,
+                             int numbering)
+{
+  int options[5];
+  int *vwgts = 0;
+  int *ewgts = 0;
+  int weightflag = 0; // no weights on our graphs yet
+  int edgecut;
+
+  if (defaultOptions == true)
+    options[0] = 0;
+  else {
+    options[0] = 1;
+    options[1] = myCoarsenTo;
+    options[2] = myMtype;
+    options[3] = myIPtype;
+    options[4] = myRtype;
+  }
+
+
+  // we now the metis routines
+  //
+  if (myPtype == 1)
+  {
+#ifdef _USE_METIS_5p1
+    opserr << "METIS_PartGraphRecursive -- NOT AVAILABLE!!\n";
+#else
+    METIS_PartGraphRecursive(&numVertex, xadj, adjncy, vwgts, ewgts, &weightflag, &numbering, &numPartitions, options, &edgecut, partition);
+#endif
+  }
+  else
+  {
+#ifdef _USE_METIS_5p1
+      int ncon = 1;
+      idx_t * null_vsize = NULL;
+      idx_t * null_adjwgt = NULL;
+      real_t * null_tpwgts = NULL;
+      real_t * null_ubvec = NULL;
+      int errorflag = METIS_PartGraphKway( &numVertex,  &ncon,  xadj,  adjncy,  vwgts,  null_vsize,  null_adjwgt,  &numPartitions,  null_tpwgts,  null_ubvec,  options,  &edgecut,  partition);
+#else
+    METIS_PartGraphKway(&numVertex, xadj, adjncy, vwgts, ewgts, &weightflag,
+                        &numbering, &numPartitions, options, &edgecut, partition);
+#endif
+  }
+
+  //
+  /*
+  if (myPtype == 1)
+
+    PMETIS(&numVertex, xadj, adjncy, vwgts, ewgts, &weightflag,
+       &numPartitions, options, &numbering, &edgecut, partition);
+  else
+    KMETIS(&numVertex, xadj, adjncy, vwgts, ewgts, &weightflag,
+       &numPartitions, options, &numbering, &edgecut, partition);
+  */
+
+  return 0;
+}
+
+
 const ID &
 Metis::number(Graph &theGraph, int lastVertex)
 {
@@ -437,18 +531,7 @@ Metis::number(Graph &theGraph, int lastVertex)
     return *theRefResult;
   }
 
-  // now we get room for the data structures metis needs
-  int numEdge = theGraph.getNumEdge();
-
-  int *options = new int [5];
-  int *partition = new int [numVertex + 1];
-  int *xadj = new int [numVertex + 2];
-  int *adjncy = new int [2 * numEdge];
-  int *vwgts = 0;
-  int *ewgts = 0;
   int numbering = 0;
-  int weightflag = 0; // no weights on our graphs yet
-
   if (START_VERTEX_NUM == 0)
     numbering = 0;
   else if (START_VERTEX_NUM == 1)
@@ -458,9 +541,15 @@ Metis::number(Graph &theGraph, int lastVertex)
     opserr << " vertex numbering must start at 0 or 1\n";
     return *theRefResult;
   }
-  int edgecut;
 
-  if ((options == 0) || (partition == 0) || (xadj == 0) || (adjncy == 0)) {
+  // now we get room for the data structures metis needs
+  int numEdge = theGraph.getNumEdge();
+
+  int *partition = new int [numVertex + 1];
+  int *xadj = new int [numVertex + 2];
+  int *adjncy = new int [2 * numEdge];
+
+  if ((partition == 0) || (xadj == 0) || (adjncy == 0)) {
     opserr << "WARNING Metis::partition - No partitioning done";
     opserr << " as ran out of memory\n";
     return *theRefResult;
@@ -483,7 +572,6 @@ Metis::number(Graph &theGraph, int lastVertex)
       opserr << "WARNING Metis::partition - No partitioning done";
       opserr << " Metis requires consecutive Vertex Numbering\n";
 
-      delete [] options;
       delete [] partition;
       delete [] xadj;
       delete [] adjncy;
@@ -501,52 +589,13 @@ Metis::number(Graph &theGraph, int lastVertex)
   }
 
 
-  if (defaultOptions == true)
-    options[0] = 0;
-  else {
-    options[0] = 1;
-    options[1] = myCoarsenTo;
-    options[2] = myMtype;
-    options[3] = myIPtype;
-    options[4] = myRtype;
-  }
-
-
-  // we now the metis routines
-  //
-  if (myPtype == 1)
-  {
-#ifdef _USE_METIS_5p1
-    opserr << "METIS_PartGraphRecursive -- NOT AVAILABLE!!\n";
-#else
-    METIS_PartGraphRecursive(&numVertex, xadj, adjncy, vwgts, ewgts, &weightflag, &numbering, &numPartitions, options, &edgecut, partition);
-#endif
-  }
-  else
-  {
-#ifdef _USE_METIS_5p1
-      int ncon = 1;
-      idx_t * null_vsize = NULL;
-      idx_t * null_adjwgt = NULL;
-      real_t * null_tpwgts = NULL;
-      real_t * null_ubvec = NULL;
-      int errorflag = METIS_PartGraphKway( &numVertex,  &ncon,  xadj,  adjncy,  vwgts,  null_vsize,  null_adjwgt,  &numPartitions,  null_tpwgts,  null_ubvec,  options,  &edgecut,  partition);
-#else
-    METIS_PartGraphKway(&numVertex, xadj, adjncy, vwgts, ewgts, &weightflag,
-                        &numbering, &numPartitions, options, &edgecut, partition);
-#endif
+  if (this->partitionForNumbering(numVertex, xadj, adjncy, partition, numbering) < 0) {
+    delete [] partition;
+    delete [] xadj;
+    delete [] adjncy;
+    return *theRefResult;
   }
 
-  //
-  /*
-  if (myPtype == 1)
-
-    PMETIS(&numVertex, xadj, adjncy, vwgts, ewgts, &weightflag,
-       &numPartitions, options, &numbering, &edgecut, partition);
-  else
-    KMETIS(&numVertex, xadj, adjncy, vwgts, ewgts, &weightflag,
-       &numPartitions, options, &numbering, &edgecut, partition);
-  */
   opserr << "Metis::number -2\n";
   // we assign numbers now based on the partitions returned.
   // each vertex in partition i is assigned a number less than
@@ -565,7 +614,6 @@ Metis::number(Graph &theGraph, int lastVertex)
   }
   opserr << "Metis::number -3\n";
   // clean up the space and return
-  delete [] options;
   delete [] partition;
   delete [] xadj;
   delete [] adjncy;
@@ -574,6 +622,51 @@ Metis::number(Graph &theGraph, int lastVertex)
 }
 
 
+const ID &
+Metis::number(const CSRGraph &theGraph, int lastVertex)
+{
+  int numVertex = theGraph.getNumVertex();
+  if (theRefResult != 0)
+    delete theRefResult;
+
+  theRefResult = new ID(numVertex);
+
+  if (checkOptions() == false) {
+    opserr << "ERROR:  Metis::number - check options failed\n";
+    return *theRefResult;
+  }
+
+  if (numVertex == 0)
+    return *theRefResult;
+
+  // metis wants arrays it may write to
+  const int *start = theGraph.getStart();
+  const int *adjacency = theGraph.getAdjacency();
+  int numAdj = start[numVertex];
+  int *xadj = new int [numVertex + 1];
+  int *adjncy = new int [numAdj + 1];
+  int *partition = new int [numVertex + 1];
+  for (int i = 0; i <= numVertex; i++)
+    xadj[i] = start[i];
+  for (int i = 0; i < numAdj; i++)
+    adjncy[i] = adjacency[i];
+
+  if (this->partitionForNumbering(numVertex, xadj, adjncy, partition, 0) == 0) {
+    // each vertex in partition i is numbered before those in i+1
+    int count = 0;
+    for (int i = 0; i < numPartitions; i++)
+      for (int vert = 0; vert < numVertex; vert++)
+        if (partition[vert] == i)
+          (*theRefResult)(count++) = vert;
+  }
+
+  delete [] partition;
+  delete [] xadj;
+  delete [] adjncy;
+  return *theRefResult;
+}
+
+
 const ID &
 Metis::number(Graph &theGraph, const ID &lastVertices)
 {
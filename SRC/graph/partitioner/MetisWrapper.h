@@ -81,6 +81,7 @@ class Metis : public GraphPartitioner, public GraphNumberer
     // the following methods are if the object is to be used as a numberer
     const ID &number(Graph &theGraph, int lastVertex = -1);
     const ID &number(Graph &theGraph, const ID &lastVertices);
+    const ID &number(const CSRGraph &theGraph, int lastVertex = -1);
 
     int sendSelf(int commitTag, 
 		 Channel &theChannel);
@@ -91,6 +92,8 @@ class Metis : public GraphPartitioner, public GraphNumberer
 
   private:
     bool checkOptions(void);
+    int partitionForNumbering(int numVertex, int *xadj, int *adjncy, int *partition,
+                              int numbering);
     
     int myPtype ; 	// package type: 
                         //	pmetis = 1
@@ -0,0 +1,325 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of AsyncStreamWriter.
+//
+// A row takes n+2 consecutive doubles of the ring: the stream pointer,
+// n and the data. A row never wraps around the end of the ring; the
+// slots left at the end are skipped, marked by n = -1 if there are two
+// or more of them.
+//
+#include <AsyncStreamWriter.h>
+#include <OPS_Stream.h>
+#include <OPS_Globals.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <string.h>
+
+AsyncStreamWriter *AsyncStreamWriter::theWriter = 0;
+
+// a stream waiting for its rows, served by the writer once its tail has
+// passed end
+struct AsyncStreamWriter::SyncRequest {
+  OPS_Stream *theStream;
+  size_t end;
+  bool done;
+};
+
+static thread_local bool isWriterThread = false;
+
+static_assert(sizeof(OPS_Stream *) <= sizeof(double),
+	      "a stream pointer must fit in a slot of the ring");
+
+int
+AsyncStreamWriter::start(int bufferSize, double flushInterval)
+{
+  if (bufferSize < 1024) {
+    opserr << "WARNING AsyncStreamWriter::start() - buffer of at least 1024 doubles needed\n";
+    return -1;
+  }
+
+  static bool stopAtExit = false;
+  if (stopAtExit == false) {
+    std::atexit(AsyncStreamWriter::stop);
+    stopAtExit = true;
+  }
+
+  if (theWriter != 0)
+    AsyncStreamWriter::stop();
+
+  theWriter = new AsyncStreamWriter(bufferSize, flushInterval);
+  return 0;
+}
+
+void
+AsyncStreamWriter::stop(void)
+{
+  if (theWriter == 0 || isWriterThread == true)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(theWriter->theMutex);
+    theWriter->shutdown = true;
+    theWriter->wakeCondition.notify_one();
+  }
+  theWriter->theThread.join();
+
+  delete theWriter;
+  theWriter = 0;
+}
+
+bool
+AsyncStreamWriter::isRunning(void)
+{
+  return theWriter != 0;
+}
+
+int
+AsyncStreamWriter::queue(OPS_Stream *theStream, const double *data, int n)
+{
+  if (theWriter == 0 || isWriterThread == true)
+    return -1;
+
+  if (theWriter->push(theStream, data, n) == 0)
+    return 0;
+
+  // too long for the ring, written directly once the rows of the
+  // stream queued before it are
+  theWriter->waitForSync(theStream);
+  return -1;
+}
+
+void
+AsyncStreamWriter::sync(OPS_Stream *theStream)
+{
+  if (theWriter == 0 || isWriterThread == true)
+    return;
+
+  theWriter->waitForSync(theStream);
+}
+
+bool
+AsyncStreamWriter::onWriterThread(void)
+{
+  return isWriterThread;
+}
+
+AsyncStreamWriter::AsyncStreamWriter(int bufferSize, double interval)
+  :ring(bufferSize), capacity(bufferSize), head(0), tail(0), synced(0),
+   flushInterval(interval), sleeping(false), numSyncRequests(0), shutdown(false)
+{
+  theThread = std::thread(&AsyncStreamWriter::run, this);
+}
+
+AsyncStreamWriter::~AsyncStreamWriter()
+{
+
+}
+
+int
+AsyncStreamWriter::push(OPS_Stream *theStream, const double *data, int n)
+{
+  size_t need = n + 2;
+  if (n < 0 || need > capacity)
+    return -1;
+
+  std::lock_guard<std::mutex> pushLock(pushMutex);
+
+  size_t h = head.load(std::memory_order_relaxed);
+  size_t pos = h % capacity;
+  size_t skip = (capacity - pos < need) ? capacity - pos : 0;
+
+  // wait for the writer to make room
+  while (capacity - (h - tail.load(std::memory_order_acquire)) < skip + need) {
+    this->wake();
+    std::this_thread::yield();
+  }
+
+  if (skip != 0) {
+    if (skip >= 2)
+      ring[pos+1] = -1.0;
+    pos = 0;
+  }
+
+  memcpy(&ring[pos], &theStream, sizeof(OPS_Stream *));
+  ring[pos+1] = n;
+  if (n != 0)
+    memcpy(&ring[pos+2], data, n*sizeof(double));
+
+  head.store(h + skip + need);
+  lastRow[theStream] = h + skip + need;
+  if (sleeping.load())
+    this->wake();
+
+  return 0;
+}
+
+void
+AsyncStreamWriter::waitForSync(OPS_Stream *theStream)
+{
+  SyncRequest request;
+  request.theStream = theStream;
+  request.done = false;
+
+  {
+    std::lock_guard<std::mutex> pushLock(pushMutex);
+    std::map<OPS_Stream *, size_t>::iterator it = lastRow.find(theStream);
+    if (it == lastRow.end())
+      return;
+
+    // written and flushed when the writer last caught up
+    request.end = it->second;
+    if (request.end <= synced.load()) {
+      lastRow.erase(it);
+      return;
+    }
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(theMutex);
+    syncRequests.push_back(&request);
+    numSyncRequests++;
+    wakeCondition.notify_one();
+    syncCondition.wait(lock, [&] { return request.done; });
+  }
+
+  // forgotten unless it queued more rows meanwhile
+  std::lock_guard<std::mutex> pushLock(pushMutex);
+  std::map<OPS_Stream *, size_t>::iterator it = lastRow.find(theStream);
+  if (it != lastRow.end() && it->second == request.end)
+    lastRow.erase(it);
+}
+
+// invoked by the writer holding theMutex, t being its tail
+void
+AsyncStreamWriter::serveSyncs(size_t t)
+{
+  bool served = false;
+  size_t i = 0;
+  while (i < syncRequests.size()) {
+    SyncRequest *request = syncRequests[i];
+    if (request->end > t) {
+      i++;
+      continue;
+    }
+
+    request->theStream->flush();
+    for (size_t j=0; j<written.size(); j++)
+      if (written[j] == request->theStream) {
+	written.erase(written.begin()+j);
+	break;
+      }
+
+    request->done = true;
+    syncRequests.erase(syncRequests.begin()+i);
+    numSyncRequests--;
+    served = true;
+  }
+
+  if (served == true)
+    syncCondition.notify_all();
+}
+
+void
+AsyncStreamWriter::wake(void)
+{
+  std::lock_guard<std::mutex> lock(theMutex);
+  wakeCondition.notify_one();
+}
+
+void
+AsyncStreamWriter::flushStreams(void)
+{
+  for (size_t i=0; i<written.size(); i++)
+    written[i]->flush();
+  written.clear();
+}
+
+void
+AsyncStreamWriter::run(void)
+{
+  isWriterThread = true;
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point lastFlush = Clock::now();
+  std::chrono::duration<double> interval(flushInterval > 0.0 ? flushInterval : 0.1);
+
+  while (true) {
+    size_t t = tail.load(std::memory_order_relaxed);
+
+    if (t != head.load(std::memory_order_acquire)) {
+      size_t pos = t % capacity;
+      size_t remaining = capacity - pos;
+      if (remaining < 2 || ring[pos+1] < 0.0) {
+	tail.store(t + remaining, std::memory_order_release);
+	continue;
+      }
+
+      OPS_Stream *theStream;
+      memcpy(&theStream, &ring[pos], sizeof(OPS_Stream *));
+      int n = (int)ring[pos+1];
+      theStream->write(&ring[pos+2], n);
+
+      if (written.empty() || written.back() != theStream) {
+	size_t i = 0;
+	while (i < written.size() && written[i] != theStream)
+	  i++;
+	if (i == written.size())
+	  written.push_back(theStream);
+      }
+
+      tail.store(t + n + 2, std::memory_order_release);
+
+      if (numSyncRequests.load() != 0) {
+	std::lock_guard<std::mutex> lock(theMutex);
+	this->serveSyncs(t + n + 2);
+      }
+
+      if (flushInterval > 0.0 && Clock::now() - lastFlush >= interval) {
+	this->flushStreams();
+	lastFlush = Clock::now();
+      }
+      continue;
+    }
+
+    // caught up with the producer
+    std::unique_lock<std::mutex> lock(theMutex);
+    if (head.load() != t)
+      continue;
+
+    this->serveSyncs(t);
+
+    if (shutdown == true || flushInterval <= 0.0 || Clock::now() - lastFlush >= interval) {
+      this->flushStreams();
+      lastFlush = Clock::now();
+    }
+    if (written.empty())
+      synced.store(t);
+
+    if (shutdown == true)
+      break;
+
+    sleeping.store(true);
+    if (head.load() == t && numSyncRequests.load() == 0 && shutdown == false)
+      wakeCondition.wait_for(lock, interval);
+    sleeping.store(false);
+  }
+}
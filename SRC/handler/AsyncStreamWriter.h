@@ -0,0 +1,107 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for
+// AsyncStreamWriter. While it is running, the rows written to
+// DataFileStream and BinaryFileStream objects are copied into a ring
+// buffer and formatted and written to their files by a background
+// thread, so that recording does not hold up the analysis.
+//
+// The threads recording queue their rows under a producer lock, which is
+// uncontended unless several threads record at once; the writer thread
+// flushes the files it has written to at most every flushInterval
+// seconds. A stream invokes sync() before it touches its file in any
+// other way, so that its rows stay in order and are all on disk before
+// it is closed or deleted; only the rows of that stream are waited for.
+// The writer is stopped, and the ring drained, at exit.
+//
+#ifndef AsyncStreamWriter_h
+#define AsyncStreamWriter_h
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class OPS_Stream;
+
+class AsyncStreamWriter
+{
+  public:
+    // starts the writer with a ring of bufferSize doubles, or changes the
+    // settings of the one running
+    static int start(int bufferSize, double flushInterval);
+    // writes out all the rows queued and stops the writer
+    static void stop(void);
+    static bool isRunning(void);
+
+    // queues a row of theStream, returning 0 if it was queued or -1 if it
+    // must be written directly, the writer not running or the caller
+    // being the writer thread
+    static int queue(OPS_Stream *theStream, const double *data, int n);
+
+    // returns once all the rows queued by theStream have been written
+    // and its file flushed
+    static void sync(OPS_Stream *theStream);
+
+    static bool onWriterThread(void);
+
+  private:
+    AsyncStreamWriter(int bufferSize, double flushInterval);
+    ~AsyncStreamWriter();
+
+    struct SyncRequest;
+
+    int push(OPS_Stream *theStream, const double *data, int n);
+    void waitForSync(OPS_Stream *theStream);
+    void serveSyncs(size_t t);
+    void wake(void);
+    void run(void);
+    void flushStreams(void);
+
+    std::vector<double> ring;
+    size_t capacity;
+    std::atomic<size_t> head;        // written by the producers
+    std::atomic<size_t> tail;        // advanced by the writer once written
+    std::atomic<size_t> synced;      // head when the writer last caught up
+                                     // and flushed
+    double flushInterval;
+
+    std::mutex pushMutex;            // held by a producer queueing a row
+    std::map<OPS_Stream *, size_t> lastRow;  // end of the last row queued by
+                                             // each stream, under pushMutex
+
+    std::thread theThread;
+    std::mutex theMutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable syncCondition;
+    std::atomic<bool> sleeping;
+    std::vector<SyncRequest *> syncRequests;  // under theMutex
+    std::atomic<int> numSyncRequests;
+    bool shutdown;
+
+    std::vector<OPS_Stream *> written;  // streams written since the last flush
+
+    static AsyncStreamWriter *theWriter;
+};
+
+#endif
@@ -32,6 +32,7 @@
 #include <Message.h>
 #include <Matrix.h>
 #include <string.h>
+#include <AsyncStreamWriter.h>
 
 using std::cerr;
 using std::ios;
@@ -60,6 +61,7 @@ BinaryFileStream::BinaryFileStream(const char *file, openMode mode)
 
 BinaryFileStream::~BinaryFileStream()
 {
+  AsyncStreamWriter::sync(this);
   if (fileOpen == 1)
     theFile.close();
 
@@ -99,6 +101,7 @@ BinaryFileStream::~BinaryFileStream()
 int 
 BinaryFileStream::setFile(const char *name, openMode mode)
 {
+  AsyncStreamWriter::sync(this);
   if (name == 0) {
     std::cerr << "BinaryFileStream::setFile() - no name passed\n";
     return -1;
@@ -139,6 +142,7 @@ BinaryFileStream::setFile(const char *name, openMode mode)
 int 
 BinaryFileStream::open(void)
 {
+  AsyncStreamWriter::sync(this);
   // check setFile has been called
   if (fileName == 0) {
     std::cerr << "BinaryFileStream::open(void) - no file name has been set\n";
@@ -171,6 +175,7 @@ BinaryFileStream::open(void)
 int 
 BinaryFileStream::close(void)
 {
+  AsyncStreamWriter::sync(this);
   if (fileOpen != 0)
     theFile.close();
   fileOpen = 0;
@@ -248,6 +253,8 @@ BinaryFileStream::write(Vector &data)
   // otherwise parallel, send the data if not p0
   //
 
+  AsyncStreamWriter::sync(this);
+
   if (sendSelfCount < 0) {
     if (data.Size() != 0) {
       return theChannels[0]->sendVector(0, 0, data);
@@ -325,12 +332,18 @@ BinaryFileStream::write(const double *s, int n)
   if (fileOpen == 0)
     this->open();
 
+  // written by the background writer if it is running
+  if (fileOpen != 0 && AsyncStreamWriter::queue(this, s, n) == 0)
+    return *this;
+
   if (fileOpen != 0) {
     //    for (int i=0; i<n; i++)
     theFile.write((char *)(&s[0]), 8*n);
 
     theFile << '\n';
-    theFile.flush();
+    // the writer thread flushes at its own interval
+    if (AsyncStreamWriter::onWriterThread() == false)
+      theFile.flush();
   }
   return *this;
 }
@@ -375,6 +388,7 @@ BinaryFileStream::operator<<(signed char c)
 OPS_Stream& 
 BinaryFileStream::operator<<(const char *s)
 {
+  AsyncStreamWriter::sync(this);
   if (fileOpen == 0)
     this->open();
 
@@ -473,6 +487,7 @@ BinaryFileStream::operator<<(bool b)
 OPS_Stream& 
 BinaryFileStream::operator<<(double n)
 {
+  AsyncStreamWriter::sync(this);
   if (fileOpen == 0)
     this->open();
 
@@ -884,6 +899,7 @@ BinaryFileStream::setOrder(const ID &orderData)
 
 int
 BinaryFileStream::flush() {
+  AsyncStreamWriter::sync(this);
   if (theFile.is_open() && theFile.good()) {
     theFile.flush();
   }
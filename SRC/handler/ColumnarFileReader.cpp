@@ -0,0 +1,228 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of the
+// ColumnarFileReader class.
+//
+#include <ColumnarFileReader.h>
+#include <ColumnarFormat.h>
+#include <OPS_Globals.h>
+
+#include <string.h>
+
+ColumnarFileReader::ColumnarFileReader()
+  :data(0), size(0), numRows(0)
+{
+
+}
+
+ColumnarFileReader::~ColumnarFileReader()
+{
+  this->close();
+}
+
+int
+ColumnarFileReader::open(const char *fileName)
+{
+  this->close();
+
+  if (theFile.open(fileName) != 0)
+    return -1;
+  data = theFile.getData();
+  size = theFile.getSize();
+
+  if (this->readFooter() != 0) {
+    opserr << "WARNING ColumnarFileReader::open() - " << fileName
+	   << " is not a complete columnar result file\n";
+    this->close();
+    return -1;
+  }
+
+  return 0;
+}
+
+void
+ColumnarFileReader::close(void)
+{
+  theFile.close();
+
+  data = 0;
+  size = 0;
+  numRows = 0;
+  columns.clear();
+  groupFirstRow.clear();
+  groupNumRows.clear();
+  blocks.clear();
+}
+
+int
+ColumnarFileReader::readFooter(void)
+{
+  if (size < COLUMNAR_HEADER_SIZE + COLUMNAR_TRAILER_SIZE)
+    return -1;
+
+  unsigned int byteOrder, version;
+  memcpy(&byteOrder, data + 8, 4);
+  memcpy(&version, data + 12, 4);
+  if (memcmp(data, COLUMNAR_MAGIC, 8) != 0 || byteOrder != COLUMNAR_BYTE_ORDER ||
+      version != COLUMNAR_VERSION)
+    return -1;
+
+  const char *trailer = data + size - COLUMNAR_TRAILER_SIZE;
+  if (memcmp(trailer + 16, COLUMNAR_FOOTER_MAGIC, 8) != 0)
+    return -1;
+
+  unsigned long long footerOffset, rows;
+  memcpy(&footerOffset, trailer, 8);
+  memcpy(&rows, trailer + 8, 8);
+  if (footerOffset < COLUMNAR_HEADER_SIZE || footerOffset > size - COLUMNAR_TRAILER_SIZE)
+    return -1;
+  numRows = (long long)rows;
+
+  FooterCursor cursor(data + footerOffset, trailer);
+
+  unsigned int numColumns = cursor.get<unsigned int>();
+  for (unsigned int i = 0; i < numColumns && cursor.ok; i++) {
+    Column theColumn;
+    theColumn.width = cursor.get<unsigned char>();
+    theColumn.objectTag = cursor.get<int>();
+    theColumn.kind = cursor.getString();
+    theColumn.name = cursor.getString();
+    theColumn.path = cursor.getString();
+    if (theColumn.width != 4 && theColumn.width != 8)
+      return -1;
+    columns.push_back(theColumn);
+  }
+
+  unsigned int numGroups = cursor.get<unsigned int>();
+  for (unsigned int g = 0; g < numGroups && cursor.ok; g++) {
+    groupFirstRow.push_back((long long)cursor.get<unsigned long long>());
+    groupNumRows.push_back((int)cursor.get<unsigned int>());
+    for (unsigned int i = 0; i < numColumns; i++) {
+      Block theBlock;
+      theBlock.offset = cursor.get<unsigned long long>();
+      theBlock.size = cursor.get<unsigned int>();
+      theBlock.codec = cursor.get<unsigned char>();
+      if (theBlock.offset > footerOffset || theBlock.size > footerOffset - theBlock.offset)
+	return -1;
+      blocks.push_back(theBlock);
+    }
+  }
+
+  return cursor.ok ? 0 : -1;
+}
+
+int
+ColumnarFileReader::getNumColumns(void) const
+{
+  return (int)columns.size();
+}
+
+long long
+ColumnarFileReader::getNumRows(void) const
+{
+  return numRows;
+}
+
+const char *
+ColumnarFileReader::getColumnKind(int column) const
+{
+  if (column < 0 || column >= (int)columns.size())
+    return 0;
+  return columns[column].kind.c_str();
+}
+
+const char *
+ColumnarFileReader::getColumnName(int column) const
+{
+  if (column < 0 || column >= (int)columns.size())
+    return 0;
+  return columns[column].name.c_str();
+}
+
+const char *
+ColumnarFileReader::getColumnPath(int column) const
+{
+  if (column < 0 || column >= (int)columns.size())
+    return 0;
+  return columns[column].path.c_str();
+}
+
+int
+ColumnarFileReader::getColumnTag(int column) const
+{
+  if (column < 0 || column >= (int)columns.size())
+    return 0;
+  return columns[column].objectTag;
+}
+
+int
+ColumnarFileReader::findColumn(const char *kind, int objectTag, const char *name) const
+{
+  for (size_t i = 0; i < columns.size(); i++) {
+    const Column &theColumn = columns[i];
+    if (theColumn.objectTag == objectTag && theColumn.name == name &&
+	(kind == 0 || theColumn.kind == kind))
+      return (int)i;
+  }
+
+  return -1;
+}
+
+long long
+ColumnarFileReader::readColumn(int column, double *values,
+			       long long firstRow, long long rows) const
+{
+  if (column < 0 || column >= (int)columns.size() || firstRow < 0)
+    return -1;
+
+  if (firstRow > numRows)
+    firstRow = numRows;
+  if (rows < 0 || firstRow + rows > numRows)
+    rows = numRows - firstRow;
+
+  const Column &theColumn = columns[column];
+  size_t numColumns = columns.size();
+  long long lastRow = firstRow + rows;
+  std::vector<double> group;
+
+  for (size_t g = 0; g < groupNumRows.size(); g++) {
+    long long start = groupFirstRow[g];
+    long long end = start + groupNumRows[g];
+    if (end <= firstRow || start >= lastRow)
+      continue;
+
+    const Block &theBlock = blocks[g * numColumns + column];
+    group.resize(groupNumRows[g]);
+    if (columnarDecode(data + theBlock.offset, theBlock.size, theBlock.codec,
+		       theColumn.width, groupNumRows[g], &group[0]) != 0) {
+      opserr << "WARNING ColumnarFileReader::readColumn() - corrupt block in row group "
+	     << (int)g << endln;
+      return -1;
+    }
+
+    long long from = (start > firstRow) ? start : firstRow;
+    long long to = (end < lastRow) ? end : lastRow;
+    for (long long r = from; r < to; r++)
+      values[r - firstRow] = group[r - start];
+  }
+
+  return rows;
+}
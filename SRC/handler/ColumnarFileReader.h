@@ -0,0 +1,87 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for
+// ColumnarFileReader. A ColumnarFileReader memory-maps a file written by
+// a ColumnarFileStream and reads the history of a column, or a range of
+// it, by decoding only the blocks of that column which hold the rows.
+//
+#ifndef ColumnarFileReader_h
+#define ColumnarFileReader_h
+
+#include <MappedFile.h>
+
+#include <string>
+#include <vector>
+
+class ColumnarFileReader
+{
+  public:
+    ColumnarFileReader();
+    ~ColumnarFileReader();
+
+    // maps the file and reads its footer; returns 0 if successful
+    int open(const char *fileName);
+    void close(void);
+
+    int getNumColumns(void) const;
+    long long getNumRows(void) const;
+    const char *getColumnKind(int column) const;
+    const char *getColumnName(int column) const;
+    const char *getColumnPath(int column) const;
+    int getColumnTag(int column) const;
+
+    // returns the first column of the object of the given kind (any if
+    // kind is 0) and tag with the given response, -1 if there is none
+    int findColumn(const char *kind, int objectTag, const char *name) const;
+
+    // reads numRows rows of a column from firstRow on, all the rows to
+    // the end if numRows < 0; returns the number of rows read or -1
+    long long readColumn(int column, double *values,
+			 long long firstRow = 0, long long numRows = -1) const;
+
+  private:
+    int readFooter(void);
+
+    struct Column {
+      std::string kind;
+      std::string name;
+      std::string path;
+      int objectTag;
+      int width;
+    };
+    struct Block {
+      unsigned long long offset;
+      unsigned int size;
+      unsigned char codec;
+    };
+
+    MappedFile theFile;
+    const char *data;
+    size_t size;
+
+    long long numRows;
+    std::vector<Column> columns;
+    std::vector<long long> groupFirstRow;
+    std::vector<int> groupNumRows;
+    std::vector<Block> blocks;     // by group, then column
+};
+
+#endif
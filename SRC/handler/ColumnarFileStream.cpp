@@ -0,0 +1,548 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of the
+// ColumnarFileStream class.
+//
+#include <ColumnarFileStream.h>
+#include <ColumnarFormat.h>
+#include <OPS_Globals.h>
+#include <Vector.h>
+#include <classTags.h>
+
+#include <string.h>
+#include <stdio.h>
+
+using std::ios;
+
+ColumnarFileStream::ColumnarFileStream()
+  :OPS_Stream(OPS_STREAM_TAGS_ColumnarFileStream),
+   theOpenMode(OVERWRITE), fileOpen(0), singlePrecision(false), compress(false), rowsPerGroup(1024),
+   columnsFixed(false), warnedSize(false), rowsInGroup(0), numRows(0)
+{
+
+}
+
+ColumnarFileStream::ColumnarFileStream(const char *file, openMode mode,
+				       bool single, bool doCompress,
+				       int rows)
+  :OPS_Stream(OPS_STREAM_TAGS_ColumnarFileStream),
+   theOpenMode(mode), fileOpen(0), singlePrecision(single), compress(doCompress),
+   rowsPerGroup(rows > 0 ? rows : 1024),
+   columnsFixed(false), warnedSize(false), rowsInGroup(0), numRows(0)
+{
+  this->setFile(file, mode);
+}
+
+ColumnarFileStream::~ColumnarFileStream()
+{
+  this->close();
+}
+
+int
+ColumnarFileStream::setFile(const char *name, openMode mode)
+{
+  if (name == 0) {
+    opserr << "ColumnarFileStream::setFile() - no name passed\n";
+    return -1;
+  }
+
+  if (fileOpen != 0)
+    this->close();
+
+  fileName = name;
+  theOpenMode = mode;
+  return 0;
+}
+
+int
+ColumnarFileStream::open(void)
+{
+  if (fileOpen != 0)
+    return 0;
+
+  if (fileName.empty()) {
+    opserr << "ColumnarFileStream::open() - no file name has been set\n";
+    return -1;
+  }
+
+  // to append, the new row groups are written over the footer of the
+  // file, which close() writes again describing all of them
+  unsigned long long footerOffset = 0;
+  if (theOpenMode == APPEND && this->readFooter(footerOffset) == 0) {
+    theFile.open(fileName.c_str(), ios::in | ios::out | ios::binary);
+    if (theFile.bad() || !theFile.is_open()) {
+      opserr << "WARNING ColumnarFileStream::open() - could not open file "
+	     << fileName.c_str() << endln;
+      return -1;
+    }
+    theFile.seekp(footerOffset);
+
+    fileOpen = 1;
+    rowsInGroup = 0;
+    this->fixColumns();
+
+    return 0;
+  }
+
+  theFile.open(fileName.c_str(), ios::out | ios::trunc | ios::binary);
+  if (theFile.bad() || !theFile.is_open()) {
+    opserr << "WARNING ColumnarFileStream::open() - could not open file "
+	   << fileName.c_str() << endln;
+    return -1;
+  }
+
+  char header[COLUMNAR_HEADER_SIZE];
+  unsigned int byteOrder = COLUMNAR_BYTE_ORDER;
+  unsigned int version = COLUMNAR_VERSION;
+  memcpy(header, COLUMNAR_MAGIC, 8);
+  memcpy(header + 8, &byteOrder, 4);
+  memcpy(header + 12, &version, 4);
+  theFile.write(header, COLUMNAR_HEADER_SIZE);
+
+  fileOpen = 1;
+  rowsInGroup = 0;
+  numRows = 0;
+  groupFirstRow.clear();
+  groupNumRows.clear();
+  blocks.clear();
+
+  return 0;
+}
+
+int
+ColumnarFileStream::close(openMode nextOpen)
+{
+  if (fileOpen == 0)
+    return 0;
+
+  int result = 0;
+  if (rowsInGroup != 0 && this->writeRowGroup() != 0)
+    result = -1;
+  if (this->writeFooter() != 0)
+    result = -1;
+
+  theFile.close();
+  fileOpen = 0;
+  theOpenMode = nextOpen;
+
+  return result;
+}
+
+// reads the footer of an existing file to append to; returns 0 if the
+// file is complete and its columns match those described, -1 otherwise
+int
+ColumnarFileStream::readFooter(unsigned long long &footerOffset)
+{
+  std::ifstream in(fileName.c_str(), ios::in | ios::binary);
+  if (!in.is_open())
+    return -1;
+
+  in.seekg(0, ios::end);
+  unsigned long long size = (unsigned long long)in.tellg();
+  if (size == 0)
+    return -1;
+
+  char header[COLUMNAR_HEADER_SIZE];
+  char trailer[COLUMNAR_TRAILER_SIZE];
+  unsigned int byteOrder = 0, version = 0;
+  unsigned long long rows = 0;
+  bool complete = false;
+  std::vector<char> footer;
+
+  if (size >= COLUMNAR_HEADER_SIZE + COLUMNAR_TRAILER_SIZE) {
+    in.seekg(0, ios::beg);
+    in.read(header, COLUMNAR_HEADER_SIZE);
+    in.seekg(size - COLUMNAR_TRAILER_SIZE, ios::beg);
+    in.read(trailer, COLUMNAR_TRAILER_SIZE);
+    memcpy(&byteOrder, header + 8, 4);
+    memcpy(&version, header + 12, 4);
+    memcpy(&footerOffset, trailer, 8);
+    memcpy(&rows, trailer + 8, 8);
+
+    complete = in.good() && memcmp(header, COLUMNAR_MAGIC, 8) == 0 &&
+      byteOrder == COLUMNAR_BYTE_ORDER && version == COLUMNAR_VERSION &&
+      memcmp(trailer + 16, COLUMNAR_FOOTER_MAGIC, 8) == 0 &&
+      footerOffset >= COLUMNAR_HEADER_SIZE &&
+      footerOffset <= size - COLUMNAR_TRAILER_SIZE;
+  }
+
+  if (complete == true) {
+    footer.resize(size - COLUMNAR_TRAILER_SIZE - footerOffset);
+    in.seekg(footerOffset, ios::beg);
+    if (!footer.empty())
+      in.read(&footer[0], footer.size());
+    complete = in.good();
+  }
+
+  if (complete == false) {
+    opserr << "WARNING ColumnarFileStream::open() - " << fileName.c_str()
+	   << " is not a complete columnar result file, overwriting it\n";
+    return -1;
+  }
+
+  const char *start = footer.empty() ? 0 : &footer[0];
+  FooterCursor cursor(start, start + footer.size());
+
+  std::vector<Column> fileColumns;
+  unsigned int numColumns = cursor.get<unsigned int>();
+  for (unsigned int i = 0; i < numColumns && cursor.ok; i++) {
+    Column theColumn;
+    theColumn.width = cursor.get<unsigned char>();
+    theColumn.objectTag = cursor.get<int>();
+    theColumn.kind = cursor.getString();
+    theColumn.name = cursor.getString();
+    theColumn.path = cursor.getString();
+    if (theColumn.width != 4 && theColumn.width != 8)
+      cursor.ok = false;
+    fileColumns.push_back(theColumn);
+  }
+
+  std::vector<unsigned long long> fileFirstRow;
+  std::vector<int> fileNumRows;
+  std::vector<Block> fileBlocks;
+  unsigned int numGroups = cursor.get<unsigned int>();
+  for (unsigned int g = 0; g < numGroups && cursor.ok; g++) {
+    fileFirstRow.push_back(cursor.get<unsigned long long>());
+    fileNumRows.push_back((int)cursor.get<unsigned int>());
+    for (unsigned int i = 0; i < numColumns; i++) {
+      Block theBlock;
+      theBlock.offset = cursor.get<unsigned long long>();
+      theBlock.size = cursor.get<unsigned int>();
+      theBlock.codec = cursor.get<unsigned char>();
+      fileBlocks.push_back(theBlock);
+    }
+  }
+
+  if (cursor.ok == false) {
+    opserr << "WARNING ColumnarFileStream::open() - " << fileName.c_str()
+	   << " is not a complete columnar result file, overwriting it\n";
+    return -1;
+  }
+
+  // a file without columns holds no rows to keep
+  if (fileColumns.empty())
+    return -1;
+
+  if (!columns.empty() && columns.size() != fileColumns.size()) {
+    opserr << "WARNING ColumnarFileStream::open() - " << fileName.c_str() << " has "
+	   << (int)fileColumns.size() << " columns, not " << (int)columns.size()
+	   << ", overwriting it\n";
+    return -1;
+  }
+
+  columns = fileColumns;
+  columnsFixed = false;
+  numRows = rows;
+  groupFirstRow = fileFirstRow;
+  groupNumRows = fileNumRows;
+  blocks = fileBlocks;
+
+  return 0;
+}
+
+int
+ColumnarFileStream::flush()
+{
+  if (fileOpen != 0)
+    theFile.flush();
+
+  return 0;
+}
+
+int
+ColumnarFileStream::tag(const char *tagName)
+{
+  OpenTag theTag;
+  theTag.name = tagName;
+  theTag.objectTag = 0;
+  openTags.push_back(theTag);
+
+  return 0;
+}
+
+int
+ColumnarFileStream::tag(const char *tagName, const char *value)
+{
+  if (strcmp(tagName, "ResponseType") != 0)
+    return 0;
+
+  if (columnsFixed == true) {
+    opserr << "WARNING ColumnarFileStream::tag() - response " << value
+	   << " described after the first row, ignored\n";
+    return 0;
+  }
+
+  // the object is the outermost xxxOutput tag below OpenSeesOutput, its
+  // tag the first xxxTag attribute from there on
+  size_t first = 0;
+  while (first < openTags.size()) {
+    const std::string &name = openTags[first].name;
+    if (name.size() > 6 && name.compare(name.size() - 6, 6, "Output") == 0 &&
+	name != "OpenSeesOutput")
+      break;
+    first++;
+  }
+  if (first == openTags.size())
+    first = 0;
+
+  Column theColumn;
+  theColumn.name = value;
+  theColumn.objectTag = 0;
+  for (size_t i = first; i < openTags.size(); i++) {
+    if (i != first)
+      theColumn.path += "/";
+    theColumn.path += openTags[i].name + openTags[i].attributes;
+    if (theColumn.objectTag == 0)
+      theColumn.objectTag = openTags[i].objectTag;
+  }
+  if (first < openTags.size())
+    theColumn.kind = openTags[first].name;
+
+  theColumn.width = 8;
+  if (singlePrecision == true &&
+      !(theColumn.kind == "TimeOutput" || theColumn.name == "time"))
+    theColumn.width = 4;
+
+  columns.push_back(theColumn);
+
+  return 0;
+}
+
+int
+ColumnarFileStream::endTag()
+{
+  if (!openTags.empty())
+    openTags.pop_back();
+
+  return 0;
+}
+
+int
+ColumnarFileStream::attr(const char *name, int value)
+{
+  if (openTags.empty())
+    return 0;
+
+  OpenTag &theTag = openTags.back();
+  char buffer[32];
+  sprintf(buffer, "%d", value);
+  theTag.attributes += std::string(" ") + name + "=" + buffer;
+
+  size_t length = strlen(name);
+  if (theTag.objectTag == 0 && length > 3 && strcmp(name + length - 3, "Tag") == 0)
+    theTag.objectTag = value;
+
+  return 0;
+}
+
+int
+ColumnarFileStream::attr(const char *name, double value)
+{
+  if (openTags.empty())
+    return 0;
+
+  char buffer[32];
+  sprintf(buffer, "%.17g", value);
+  openTags.back().attributes += std::string(" ") + name + "=" + buffer;
+
+  return 0;
+}
+
+int
+ColumnarFileStream::attr(const char *name, const char *value)
+{
+  if (openTags.empty())
+    return 0;
+
+  openTags.back().attributes += std::string(" ") + name + "=" + value;
+
+  return 0;
+}
+
+int
+ColumnarFileStream::write(Vector &data)
+{
+  (*this) << data;
+  return 0;
+}
+
+OPS_Stream&
+ColumnarFileStream::write(const double *s, int n)
+{
+  // the recorders write the time ahead of the responses but do not all
+  // describe it; a first row one value longer than the columns starts
+  // with the time
+  if (columnsFixed == false && fileOpen == 0 && !columns.empty() &&
+      n == (int)columns.size() + 1 &&
+      columns[0].kind != "TimeOutput" && columns[0].name != "time") {
+    Column theColumn;
+    theColumn.kind = "TimeOutput";
+    theColumn.name = "time";
+    theColumn.path = "TimeOutput";
+    theColumn.objectTag = 0;
+    theColumn.width = 8;
+    columns.insert(columns.begin(), theColumn);
+  }
+
+  if (fileOpen == 0 && this->open() != 0)
+    return *this;
+
+  // the number of columns is fixed by the first row; responses the
+  // recorder did not describe get generic names
+  if (columnsFixed == false) {
+    for (int i = (int)columns.size(); i < n; i++) {
+      char name[32];
+      sprintf(name, "column%d", i + 1);
+      Column theColumn;
+      theColumn.name = name;
+      theColumn.objectTag = 0;
+      theColumn.width = singlePrecision ? 4 : 8;
+      columns.push_back(theColumn);
+    }
+    this->fixColumns();
+  }
+
+  int numColumns = (int)columns.size();
+  if (n != numColumns && warnedSize == false) {
+    opserr << "WARNING ColumnarFileStream::write() - " << fileName.c_str() << " has "
+	   << numColumns << " columns, a row of " << n << " values has been padded or cut\n";
+    warnedSize = true;
+  }
+
+  for (int i = 0; i < numColumns; i++)
+    buffer[(size_t)i * rowsPerGroup + rowsInGroup] = (i < n) ? s[i] : 0.0;
+
+  if (++rowsInGroup == rowsPerGroup)
+    this->writeRowGroup();
+
+  return *this;
+}
+
+void
+ColumnarFileStream::fixColumns(void)
+{
+  columnsFixed = true;
+
+  // keep the buffer of a recorder with many columns to about 16 MB
+  int maxRows = columns.empty() ? rowsPerGroup : 2097152 / (int)columns.size();
+  if (rowsPerGroup > maxRows)
+    rowsPerGroup = (maxRows > 16) ? maxRows : 16;
+  buffer.assign(columns.size() * rowsPerGroup, 0.0);
+}
+
+int
+ColumnarFileStream::writeRowGroup(void)
+{
+  int numColumns = (int)columns.size();
+  std::vector<char> block;
+
+  for (int i = 0; i < numColumns; i++) {
+    Block theBlock;
+    theBlock.codec = (unsigned char)columnarEncode(&buffer[(size_t)i * rowsPerGroup], rowsInGroup,
+						   columns[i].width,
+						   compress ? COLUMNAR_LZ : COLUMNAR_RAW, block);
+    theBlock.offset = (unsigned long long)theFile.tellp();
+    theBlock.size = (unsigned int)block.size();
+    if (!block.empty())
+      theFile.write(&block[0], block.size());
+    blocks.push_back(theBlock);
+  }
+
+  groupFirstRow.push_back(numRows);
+  groupNumRows.push_back(rowsInGroup);
+  numRows += rowsInGroup;
+  rowsInGroup = 0;
+
+  if (theFile.bad()) {
+    opserr << "WARNING ColumnarFileStream::write() - failed to write to "
+	   << fileName.c_str() << endln;
+    return -1;
+  }
+
+  return 0;
+}
+
+static void
+writeString(std::ofstream &theFile, const std::string &s)
+{
+  unsigned int length = (unsigned int)s.size();
+  theFile.write((const char *)&length, 4);
+  theFile.write(s.data(), length);
+}
+
+int
+ColumnarFileStream::writeFooter(void)
+{
+  unsigned long long footerOffset = (unsigned long long)theFile.tellp();
+
+  unsigned int numColumns = (unsigned int)columns.size();
+  theFile.write((const char *)&numColumns, 4);
+  for (unsigned int i = 0; i < numColumns; i++) {
+    const Column &theColumn = columns[i];
+    unsigned char width = (unsigned char)theColumn.width;
+    theFile.write((const char *)&width, 1);
+    theFile.write((const char *)&theColumn.objectTag, 4);
+    writeString(theFile, theColumn.kind);
+    writeString(theFile, theColumn.name);
+    writeString(theFile, theColumn.path);
+  }
+
+  unsigned int numGroups = (unsigned int)groupNumRows.size();
+  theFile.write((const char *)&numGroups, 4);
+  for (unsigned int g = 0; g < numGroups; g++) {
+    unsigned int rows = (unsigned int)groupNumRows[g];
+    theFile.write((const char *)&groupFirstRow[g], 8);
+    theFile.write((const char *)&rows, 4);
+    for (unsigned int i = 0; i < numColumns; i++) {
+      const Block &theBlock = blocks[(size_t)g * numColumns + i];
+      theFile.write((const char *)&theBlock.offset, 8);
+      theFile.write((const char *)&theBlock.size, 4);
+      theFile.write((const char *)&theBlock.codec, 1);
+    }
+  }
+
+  theFile.write((const char *)&footerOffset, 8);
+  theFile.write((const char *)&numRows, 8);
+  theFile.write(COLUMNAR_FOOTER_MAGIC, 8);
+
+  if (theFile.bad()) {
+    opserr << "WARNING ColumnarFileStream::close() - failed to write the footer of "
+	   << fileName.c_str() << endln;
+    return -1;
+  }
+
+  return 0;
+}
+
+int
+ColumnarFileStream::sendSelf(int commitTag, Channel &theChannel)
+{
+  opserr << "ColumnarFileStream::sendSelf() - not available in parallel, use -binary\n";
+  return -1;
+}
+
+int
+ColumnarFileStream::recvSelf(int commitTag, Channel &theChannel,
+			     FEM_ObjectBroker &theBroker)
+{
+  opserr << "ColumnarFileStream::recvSelf() - not available in parallel, use -binary\n";
+  return -1;
+}
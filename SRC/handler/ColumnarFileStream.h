@@ -0,0 +1,126 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for
+// ColumnarFileStream. A ColumnarFileStream writes the rows of a recorder
+// to a self-describing columnar file (see ColumnarFormat.h), so that the
+// history of one response can be read back without scanning the file.
+//
+// The columns are described by the tag() and attr() calls a recorder
+// makes when it is initialized: every ResponseType tag is a column,
+// named by its value, of the enclosing NodeOutput, ElementOutput, ...
+// object. The rows are buffered and written rowsPerGroup at a time, each
+// column as a separate block stored in single or double precision and
+// optionally compressed; the time column is always double precision.
+// The footer describing the columns and blocks is written when the
+// stream is closed, or deleted with its recorder. A stream opened to
+// APPEND to a complete columnar file with the same number of columns
+// reads its footer back and writes the new row groups over it.
+//
+#ifndef _ColumnarFileStream
+#define _ColumnarFileStream
+
+#include <OPS_Stream.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+class ColumnarFileStream : public OPS_Stream
+{
+ public:
+  ColumnarFileStream();
+  ColumnarFileStream(const char *fileName, openMode mode = OVERWRITE,
+		     bool singlePrecision = false, bool compress = false,
+		     int rowsPerGroup = 1024);
+  ~ColumnarFileStream();
+
+  int setFile(const char *fileName, openMode mode = OVERWRITE);
+  int open(void);
+  int close(openMode nextOpen = APPEND);
+  int flush();
+
+  int setPrecision(int precision) {return 0;}
+  int setFloatField(floatField) {return 0;}
+  const char *getFileName(void) {return fileName.c_str();}
+
+  // xml stuff
+  int tag(const char *);
+  int tag(const char *, const char *);
+  int endTag();
+  int attr(const char *name, int value);
+  int attr(const char *name, double value);
+  int attr(const char *name, const char *value);
+  int write(Vector &data);
+
+  // regular stuff
+  OPS_Stream& write(const double *s, int n);
+
+  // parallel stuff
+  int sendSelf(int commitTag, Channel &theChannel);
+  int recvSelf(int commitTag, Channel &theChannel,
+	       FEM_ObjectBroker &theBroker);
+
+ private:
+  struct Column {
+    std::string kind;      // NodeOutput, ElementOutput, ...
+    std::string name;      // the response
+    std::string path;      // the enclosing tags and their attributes
+    int objectTag;
+    int width;             // bytes per value
+  };
+  struct Block {
+    unsigned long long offset;
+    unsigned int size;
+    unsigned char codec;
+  };
+  struct OpenTag {
+    std::string name;
+    std::string attributes;
+    int objectTag;
+  };
+
+  void fixColumns(void);
+  int readFooter(unsigned long long &footerOffset);
+  int writeRowGroup(void);
+  int writeFooter(void);
+
+  std::ofstream theFile;
+  std::string fileName;
+  openMode theOpenMode;
+  int fileOpen;
+  bool singlePrecision;
+  bool compress;
+  int rowsPerGroup;
+
+  std::vector<Column> columns;
+  std::vector<OpenTag> openTags;
+  bool columnsFixed;               // set with the first row
+  bool warnedSize;
+
+  std::vector<double> buffer;      // the rows of the group, by column
+  int rowsInGroup;
+  unsigned long long numRows;
+  std::vector<unsigned long long> groupFirstRow;
+  std::vector<int> groupNumRows;
+  std::vector<Block> blocks;       // by group, then column
+};
+
+#endif
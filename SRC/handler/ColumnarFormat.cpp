@@ -0,0 +1,273 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the block encoding of the columnar
+// result files. The compressor is a greedy single pass one with a small
+// hash table, so that compressing a block costs about as much as copying
+// it; most of the gain on response histories comes from the shuffle,
+// which lines up the slowly varying exponent bytes.
+//
+#include <ColumnarFormat.h>
+#include <string.h>
+
+static const int minMatch     = 4;
+static const int lastLiterals = 5;
+static const int matchLimit   = 12;
+static const int maxOffset    = 65535;
+static const int hashLog      = 12;
+
+static inline unsigned int
+read32(const unsigned char *p)
+{
+  unsigned int v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+static inline int
+hashOf(unsigned int v)
+{
+  return (int)((v * 2654435761u) >> (32 - hashLog));
+}
+
+static unsigned char *
+writeLength(unsigned char *op, int length)
+{
+  while (length >= 255) {
+    *op++ = 255;
+    length -= 255;
+  }
+  *op++ = (unsigned char)length;
+  return op;
+}
+
+int
+lzBound(int n)
+{
+  return n + n/255 + 16;
+}
+
+int
+lzCompress(const unsigned char *src, int n, unsigned char *dst, int capacity)
+{
+  int table[1 << hashLog];
+  for (int i = 0; i < (1 << hashLog); i++)
+    table[i] = -1;
+
+  unsigned char *op = dst;
+  unsigned char *oend = dst + capacity;
+  int anchor = 0;
+  int ip = 0;
+
+  // a match starts at least matchLimit bytes and ends at least
+  // lastLiterals bytes before the end of the input
+  while (ip < n - matchLimit) {
+    unsigned int sequence = read32(src + ip);
+    int h = hashOf(sequence);
+    int ref = table[h];
+    table[h] = ip;
+    if (ref < 0 || ip - ref > maxOffset || read32(src + ref) != sequence) {
+      ip++;
+      continue;
+    }
+
+    while (ip > anchor && ref > 0 && src[ip-1] == src[ref-1]) {
+      ip--;
+      ref--;
+    }
+
+    int length = minMatch;
+    while (ip + length < n - lastLiterals && src[ip+length] == src[ref+length])
+      length++;
+
+    int numLiterals = ip - anchor;
+    if (op + numLiterals + numLiterals/255 + (length - minMatch)/255 + 5 > oend)
+      return -1;
+
+    unsigned char *token = op++;
+    if (numLiterals >= 15) {
+      *token = 15 << 4;
+      op = writeLength(op, numLiterals - 15);
+    } else
+      *token = (unsigned char)(numLiterals << 4);
+    memcpy(op, src + anchor, numLiterals);
+    op += numLiterals;
+
+    int offset = ip - ref;
+    *op++ = (unsigned char)(offset & 255);
+    *op++ = (unsigned char)(offset >> 8);
+
+    if (length - minMatch >= 15) {
+      *token |= 15;
+      op = writeLength(op, length - minMatch - 15);
+    } else
+      *token |= (unsigned char)(length - minMatch);
+
+    ip += length;
+    anchor = ip;
+  }
+
+  // the last literals
+  int numLiterals = n - anchor;
+  if (op + numLiterals + numLiterals/255 + 2 > oend)
+    return -1;
+  unsigned char *token = op++;
+  if (numLiterals >= 15) {
+    *token = 15 << 4;
+    op = writeLength(op, numLiterals - 15);
+  } else
+    *token = (unsigned char)(numLiterals << 4);
+  memcpy(op, src + anchor, numLiterals);
+  op += numLiterals;
+
+  return (int)(op - dst);
+}
+
+int
+lzDecompress(const unsigned char *src, int n, unsigned char *dst, int capacity)
+{
+  int ip = 0;
+  int op = 0;
+
+  while (ip < n) {
+    int token = src[ip++];
+
+    int numLiterals = token >> 4;
+    if (numLiterals == 15) {
+      int b;
+      do {
+	if (ip >= n)
+	  return -1;
+	b = src[ip++];
+	numLiterals += b;
+      } while (b == 255);
+    }
+    if (numLiterals > n - ip || numLiterals > capacity - op)
+      return -1;
+    memcpy(dst + op, src + ip, numLiterals);
+    ip += numLiterals;
+    op += numLiterals;
+
+    // the last sequence has no match
+    if (ip == n)
+      break;
+
+    if (ip + 2 > n)
+      return -1;
+    int offset = src[ip] | (src[ip+1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > op)
+      return -1;
+
+    int length = token & 15;
+    if (length == 15) {
+      int b;
+      do {
+	if (ip >= n)
+	  return -1;
+	b = src[ip++];
+	length += b;
+      } while (b == 255);
+    }
+    length += minMatch;
+    if (length > capacity - op)
+      return -1;
+
+    // the match may overlap the output
+    const unsigned char *match = dst + op - offset;
+    for (int i = 0; i < length; i++)
+      dst[op + i] = match[i];
+    op += length;
+  }
+
+  return op;
+}
+
+int
+columnarEncode(const double *values, int n, int width, int codec,
+	       std::vector<char> &block)
+{
+  int size = n * width;
+  std::vector<unsigned char> raw(size);
+  if (width == 4) {
+    for (int i = 0; i < n; i++) {
+      float value = (float)values[i];
+      memcpy(&raw[4*i], &value, 4);
+    }
+  } else if (size != 0)
+    memcpy(&raw[0], values, size);
+
+  if (codec == COLUMNAR_LZ && size != 0) {
+    std::vector<unsigned char> shuffled(size);
+    for (int b = 0; b < width; b++)
+      for (int i = 0; i < n; i++)
+	shuffled[b*n + i] = raw[i*width + b];
+
+    block.resize(lzBound(size));
+    int compressed = lzCompress(&shuffled[0], size, (unsigned char *)&block[0], (int)block.size());
+    if (compressed > 0 && compressed < size) {
+      block.resize(compressed);
+      return COLUMNAR_LZ;
+    }
+  }
+
+  block.assign(raw.begin(), raw.end());
+  return COLUMNAR_RAW;
+}
+
+int
+columnarDecode(const char *block, size_t size, int codec, int width,
+	       int n, double *values)
+{
+  int rawSize = n * width;
+  std::vector<unsigned char> raw(rawSize);
+
+  if (codec == COLUMNAR_RAW) {
+    if (size != (size_t)rawSize)
+      return -1;
+    if (rawSize != 0)
+      memcpy(&raw[0], block, rawSize);
+
+  } else if (codec == COLUMNAR_LZ) {
+    std::vector<unsigned char> shuffled(rawSize);
+    if (rawSize == 0 ||
+	lzDecompress((const unsigned char *)block, (int)size, &shuffled[0], rawSize) != rawSize)
+      return -1;
+    for (int b = 0; b < width; b++)
+      for (int i = 0; i < n; i++)
+	raw[i*width + b] = shuffled[b*n + i];
+
+  } else
+    return -1;
+
+  if (width == 4) {
+    for (int i = 0; i < n; i++) {
+      float value;
+      memcpy(&value, &raw[4*i], 4);
+      values[i] = value;
+    }
+  } else if (width == 8) {
+    if (rawSize != 0)
+      memcpy(values, &raw[0], rawSize);
+  } else
+    return -1;
+
+  return 0;
+}
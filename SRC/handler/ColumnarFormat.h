@@ -0,0 +1,115 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the layout of the columnar result files
+// written by ColumnarFileStream and read by ColumnarFileReader, and the
+// functions encoding and decoding their blocks.
+//
+// A file is a header, the blocks of data and a footer describing them:
+//
+//   header   "OPSCOL01", uint32 0x01020304 (byte order), uint32 version
+//   blocks   for each group of rows, the values of each column in turn
+//   footer   uint32 number of columns, then for each column
+//              uint8 bytes per value (4 or 8), int32 object tag,
+//              string kind, string name, string path
+//            uint32 number of row groups, then for each group
+//              uint64 first row, uint32 number of rows, then for each
+//              column uint64 offset, uint32 size, uint8 codec
+//   trailer  uint64 offset of the footer, uint64 number of rows,
+//            "OPSCOLFT"
+//
+// Strings are a uint32 length followed by the characters. All numbers
+// are in the byte order of the machine that wrote the file. A block is
+// either the raw values (COLUMNAR_RAW) or the values with their bytes
+// shuffled, all first bytes followed by all second bytes and so on, and
+// compressed in the LZ4 block format (COLUMNAR_LZ).
+//
+#ifndef ColumnarFormat_h
+#define ColumnarFormat_h
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include <string.h>
+
+#define COLUMNAR_MAGIC          "OPSCOL01"
+#define COLUMNAR_FOOTER_MAGIC   "OPSCOLFT"
+#define COLUMNAR_BYTE_ORDER     0x01020304u
+#define COLUMNAR_VERSION        1
+#define COLUMNAR_HEADER_SIZE    16
+#define COLUMNAR_TRAILER_SIZE   24
+
+enum ColumnarCodec {
+  COLUMNAR_RAW = 0,
+  COLUMNAR_LZ  = 1
+};
+
+// stores n values with width bytes each (4 or 8) in block, compressed if
+// codec is COLUMNAR_LZ and that makes the block smaller; returns the
+// codec used
+int columnarEncode(const double *values, int n, int width, int codec,
+		   std::vector<char> &block);
+
+// recovers n values from a block; returns 0 if successful, -1 if the
+// block is corrupt
+int columnarDecode(const char *block, size_t size, int codec, int width,
+		   int n, double *values);
+
+// the LZ4 block format; compress returns the size of the compressed data
+// or -1 if it does not fit in capacity, decompress the size of the data
+// or -1 if the input is corrupt or the data does not fit
+int lzCompress(const unsigned char *src, int n, unsigned char *dst, int capacity);
+int lzDecompress(const unsigned char *src, int n, unsigned char *dst, int capacity);
+int lzBound(int n);
+
+// reads the footer with every read checked against its end
+class FooterCursor
+{
+  public:
+    FooterCursor(const char *start, const char *end)
+      :p(start), end(end), ok(true) {}
+
+    template <class T> T get(void) {
+      T value = T();
+      if (ok && (size_t)(end - p) >= sizeof(T)) {
+	memcpy(&value, p, sizeof(T));
+	p += sizeof(T);
+      } else
+	ok = false;
+      return value;
+    }
+
+    std::string getString(void) {
+      unsigned int length = get<unsigned int>();
+      if (!ok || (size_t)(end - p) < length) {
+	ok = false;
+	return std::string();
+      }
+      std::string s(p, length);
+      p += length;
+      return s;
+    }
+
+    const char *p;
+    const char *end;
+    bool ok;
+};
+
+#endif
@@ -33,6 +33,7 @@
 #include <Channel.h>
 #include <Message.h>
 #include <Matrix.h>
+#include <AsyncStreamWriter.h>
 
 using std::cerr;
 using std::ios;
@@ -84,6 +85,7 @@ DataFileStream::DataFileStream(const char* file, openMode mode, int indent, int
 
 DataFileStream::~DataFileStream()
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 1)
 		theFile.close();
 
@@ -129,6 +131,7 @@ DataFileStream::~DataFileStream()
 int
 DataFileStream::setFile(const char* name, openMode mode)
 {
+	AsyncStreamWriter::sync(this);
 	if (name == 0) {
 		std::cerr << "DataFileStream::setFile() - no name passed\n";
 		return -1;
@@ -168,6 +171,7 @@ DataFileStream::setFile(const char* name, openMode mode)
 int
 DataFileStream::open(void)
 {
+	AsyncStreamWriter::sync(this);
 	// check setFile has been called
 	if (fileName == 0) {
 		std::cerr << "DataFileStream::open(void) - no file name has been set\n";
@@ -221,6 +225,7 @@ DataFileStream::open(void)
 int 
 DataFileStream::close(openMode nextOpenMode)
 {
+	AsyncStreamWriter::sync(this);
 #if _DLL
 	if (fileOpen == 1) {
 		for (int i = 0; i < numTag; i++) {
@@ -248,6 +253,7 @@ DataFileStream::close(openMode nextOpenMode)
 int
 DataFileStream::setPrecision(int prec)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -260,6 +266,7 @@ DataFileStream::setPrecision(int prec)
 int
 DataFileStream::setFloatField(floatField field)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -475,6 +482,8 @@ DataFileStream::write(Vector& data)
 	// otherwise parallel, send the data if not p0
 	//
 
+	AsyncStreamWriter::sync(this);
+
 	if (sendSelfCount < 0) {
 		if (data.Size() != 0) {
 			if (theChannels[0]->sendVector(0, 0, data) < 0) {
@@ -606,6 +615,7 @@ DataFileStream::write(Vector& data)
 OPS_Stream&
 DataFileStream::write(const char* s, int n)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -618,6 +628,7 @@ DataFileStream::write(const char* s, int n)
 OPS_Stream&
 DataFileStream::write(const unsigned char* s, int n)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -629,6 +640,7 @@ DataFileStream::write(const unsigned char* s, int n)
 OPS_Stream&
 DataFileStream::write(const signed char* s, int n)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -640,6 +652,7 @@ DataFileStream::write(const signed char* s, int n)
 OPS_Stream&
 DataFileStream::write(const void* s, int n)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -652,11 +665,15 @@ DataFileStream::write(const void* s, int n)
 OPS_Stream&
 DataFileStream::write(const double* s, int n)
 {
-	numDataRows++;
-
 	if (fileOpen == 0)
 		this->open();
 
+	// formatted and written by the background writer if it is running
+	if (fileOpen != 0 && AsyncStreamWriter::queue(this, s, n) == 0)
+		return *this;
+
+	numDataRows++;
+
 	if (fileOpen != 0) {
 		if (n > 0) {
 			if (doCSV == 0) {
@@ -682,6 +699,7 @@ DataFileStream::write(const double* s, int n)
 OPS_Stream&
 DataFileStream::operator<<(char c)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -693,6 +711,7 @@ DataFileStream::operator<<(char c)
 OPS_Stream&
 DataFileStream::operator<<(unsigned char c)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -704,6 +723,7 @@ DataFileStream::operator<<(unsigned char c)
 OPS_Stream&
 DataFileStream::operator<<(signed char c)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -715,6 +735,7 @@ DataFileStream::operator<<(signed char c)
 OPS_Stream&
 DataFileStream::operator<<(const char* s)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -730,6 +751,7 @@ DataFileStream::operator<<(const char* s)
 OPS_Stream&
 DataFileStream::operator<<(const unsigned char* s)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -741,6 +763,7 @@ DataFileStream::operator<<(const unsigned char* s)
 OPS_Stream&
 DataFileStream::operator<<(const signed char* s)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -752,6 +775,7 @@ DataFileStream::operator<<(const signed char* s)
 OPS_Stream&
 DataFileStream::operator<<(const void* p)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -764,6 +788,7 @@ DataFileStream::operator<<(const void* p)
 OPS_Stream&
 DataFileStream::operator<<(int n)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -775,6 +800,7 @@ DataFileStream::operator<<(int n)
 OPS_Stream&
 DataFileStream::operator<<(unsigned int n)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -786,6 +812,7 @@ DataFileStream::operator<<(unsigned int n)
 OPS_Stream&
 DataFileStream::operator<<(long n)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -798,6 +825,7 @@ DataFileStream::operator<<(long n)
 OPS_Stream&
 DataFileStream::operator<<(unsigned long n)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -810,6 +838,7 @@ DataFileStream::operator<<(unsigned long n)
 OPS_Stream&
 DataFileStream::operator<<(short n)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -822,6 +851,7 @@ DataFileStream::operator<<(short n)
 OPS_Stream&
 DataFileStream::operator<<(unsigned short n)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -834,6 +864,7 @@ DataFileStream::operator<<(unsigned short n)
 OPS_Stream&
 DataFileStream::operator<<(bool b)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -846,6 +877,7 @@ DataFileStream::operator<<(bool b)
 OPS_Stream&
 DataFileStream::operator<<(double n)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -857,6 +889,7 @@ DataFileStream::operator<<(double n)
 OPS_Stream&
 DataFileStream::operator<<(float n)
 {
+	AsyncStreamWriter::sync(this);
 	if (fileOpen == 0)
 		this->open();
 
@@ -1136,6 +1169,7 @@ DataFileStream::setOrder(const ID& orderData)
 }
 
 int DataFileStream::flush() {
+  AsyncStreamWriter::sync(this);
   if (theFile.is_open() && theFile.good()) {
     theFile.flush();
   }
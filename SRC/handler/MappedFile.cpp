@@ -0,0 +1,121 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of MappedFile.
+//
+#include <MappedFile.h>
+#include <OPS_Globals.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+MappedFile::MappedFile()
+  :data(0), size(0),
+#ifdef _WIN32
+   fileHandle(0), mapHandle(0)
+#else
+   fd(-1)
+#endif
+{
+
+}
+
+MappedFile::~MappedFile()
+{
+  this->close();
+}
+
+int
+MappedFile::open(const char *fileName)
+{
+  this->close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+			    NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    opserr << "WARNING MappedFile::open() - could not open " << fileName << endln;
+    return -1;
+  }
+  fileHandle = file;
+
+  LARGE_INTEGER fileSize;
+  if (GetFileSizeEx(file, &fileSize) != 0)
+    size = (size_t)fileSize.QuadPart;
+  if (size != 0) {
+    mapHandle = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapHandle != 0)
+      data = (const char *)MapViewOfFile(mapHandle, FILE_MAP_READ, 0, 0, 0);
+  }
+#else
+  fd = ::open(fileName, O_RDONLY);
+  if (fd < 0) {
+    opserr << "WARNING MappedFile::open() - could not open " << fileName << endln;
+    return -1;
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) == 0)
+    size = (size_t)fileStat.st_size;
+  if (size != 0) {
+    void *mapped = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapped != MAP_FAILED)
+      data = (const char *)mapped;
+  }
+#endif
+
+  if (size != 0 && data == 0) {
+    opserr << "WARNING MappedFile::open() - could not map " << fileName << endln;
+    this->close();
+    return -1;
+  }
+
+  return 0;
+}
+
+void
+MappedFile::close(void)
+{
+#ifdef _WIN32
+  if (data != 0)
+    UnmapViewOfFile(data);
+  if (mapHandle != 0)
+    CloseHandle((HANDLE)mapHandle);
+  if (fileHandle != 0)
+    CloseHandle((HANDLE)fileHandle);
+  mapHandle = 0;
+  fileHandle = 0;
+#else
+  if (data != 0)
+    munmap((void *)data, size);
+  if (fd >= 0)
+    ::close(fd);
+  fd = -1;
+#endif
+
+  data = 0;
+  size = 0;
+}
@@ -0,0 +1,57 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for MappedFile,
+// a file mapped read only into memory, used by the readers of recorder
+// output.
+//
+#ifndef MappedFile_h
+#define MappedFile_h
+
+#include <stddef.h>
+
+class MappedFile
+{
+  public:
+    MappedFile();
+    ~MappedFile();
+
+    // returns 0 if successful; an empty file is not mapped
+    int open(const char *fileName);
+    void close(void);
+
+    const char *getData(void) const {return data;}
+    size_t getSize(void) const {return size;}
+
+  private:
+    MappedFile(const MappedFile &);
+    MappedFile &operator=(const MappedFile &);
+
+    const char *data;
+    size_t size;
+#ifdef _WIN32
+    void *fileHandle;
+    void *mapHandle;
+#else
+    int fd;
+#endif
+};
+
+#endif
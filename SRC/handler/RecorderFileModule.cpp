@@ -0,0 +1,191 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the Python bindings of
+// RecorderFileReader, the class RecorderFile. They are part of the
+// OpenSeesPyRT module, and with _RECORDER_FILE_MODULE defined make up the
+// stand-alone module OpenSeesRecorderFile, which needs none of the rest
+// of OpenSees to read the output of a recorder.
+//
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+namespace py = pybind11;
+
+#include <RecorderFileReader.h>
+#include <ColumnarFileReader.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//
+// Views of recorder output; the values of binary and text files are
+// viewed in place, the reader being the base of the array so that the
+// mapping outlives it.
+//
+static void
+clip_rows(const RecorderFileReader &reader, long long &first, long long &last)
+{
+  long long rows = reader.getNumRows();
+  if (last < 0 || last > rows)
+    last = rows;
+  if (first < 0)
+    first = 0;
+  if (first > last)
+    first = last;
+}
+
+static py::array
+recorder_view(py::object self, long long first, long long last)
+{
+  const RecorderFileReader &reader = self.cast<const RecorderFileReader &>();
+  clip_rows(reader, first, last);
+  py::ssize_t nr = last - first;
+  py::ssize_t nc = reader.getNumColumns();
+
+  if (reader.getData() != nullptr) {
+    py::array view(py::dtype::of<double>(), {nr, nc},
+                   {(py::ssize_t)reader.getRowStride(), (py::ssize_t)reader.getColumnStride()},
+                   reader.getData() + first*reader.getRowStride(), self);
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+  }
+
+  py::array_t<double> array({nr, nc});
+  double *ptr = array.mutable_data();
+  std::vector<double> column(nr);
+  for (py::ssize_t j=0; j<nc; j++) {
+    if (nr != 0)
+      reader.readColumn((int)j, &column[0], first, nr);
+    for (py::ssize_t i=0; i<nr; i++)
+      ptr[i*nc+j] = column[i];
+  }
+  return array;
+}
+
+static py::array
+recorder_column(py::object self, int column, long long first, long long last)
+{
+  const RecorderFileReader &reader = self.cast<const RecorderFileReader &>();
+  if (column < 0 || column >= reader.getNumColumns())
+    throw py::index_error("no column " + std::to_string(column));
+  clip_rows(reader, first, last);
+  py::ssize_t nr = last - first;
+
+  if (reader.getData() != nullptr) {
+    py::array view(py::dtype::of<double>(), {nr}, {(py::ssize_t)reader.getRowStride()},
+                   reader.getData() + first*reader.getRowStride() + column*reader.getColumnStride(),
+                   self);
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+  }
+
+  py::array_t<double> array(nr);
+  if (nr != 0)
+    reader.readColumn(column, array.mutable_data(), first, nr);
+  return array;
+}
+
+void
+init_recorder_file(py::module &m)
+{
+  py::class_<RecorderFileReader>(m, "RecorderFile",
+     "Random access to the output of a recorder written with -binary, "
+     "-file/-csv or -columnar. Binary files are memory-mapped and their "
+     "rows viewed without copying; text files are parsed once."
+     )
+    .def (py::init([](std::string file, std::string format, int columns) {
+        int fmt = RecorderFileReader::Unknown;
+        if (format == "text")
+          fmt = RecorderFileReader::Text;
+        else if (format == "binary")
+          fmt = RecorderFileReader::Binary;
+        else if (format == "columnar")
+          fmt = RecorderFileReader::Columnar;
+        else if (!format.empty())
+          throw py::value_error("unknown recorder format " + format);
+
+        std::unique_ptr<RecorderFileReader> reader(new RecorderFileReader());
+        if (reader->open(file.c_str(), fmt, columns) != 0)
+          throw std::runtime_error("could not read recorder file " + file);
+        return reader;
+      }),
+      py::arg("file"), py::arg("format") = "", py::arg("columns") = 0
+    )
+    .def_property_readonly ("rows",    &RecorderFileReader::getNumRows)
+    .def_property_readonly ("columns", &RecorderFileReader::getNumColumns)
+    .def ("view",   &recorder_view,   py::arg("first") = 0, py::arg("last") = -1)
+    .def ("column", &recorder_column, py::arg("column"), py::arg("first") = 0, py::arg("last") = -1)
+    .def ("time_range", [](const RecorderFileReader &reader, double start, double end, int time_column) {
+        long long first, last;
+        if (reader.findTimeRange(start, end, first, last, time_column) != 0)
+          throw py::index_error("no time column " + std::to_string(time_column));
+        return py::make_tuple(first, last);
+      },
+      py::arg("start"), py::arg("end"), py::arg("time_column") = 0
+    )
+    .def_static ("node_column", &RecorderFileReader::getColumn,
+      py::arg("index"), py::arg("dof"), py::arg("ndf"), py::arg("time") = true
+    )
+    .def ("find", [](const RecorderFileReader &reader, int tag, std::string response, py::object kind) {
+        std::string type = kind.is_none() ? std::string() : kind.cast<std::string>();
+        return reader.findColumn(kind.is_none() ? nullptr : type.c_str(), tag, response.c_str());
+      },
+      py::arg("tag"), py::arg("response"), py::arg("kind") = py::none()
+    )
+    .def ("names", [](const RecorderFileReader &reader) {
+        py::list names;
+        const ColumnarFileReader *columnar = reader.getColumnarReader();
+        if (columnar != nullptr)
+          for (int i=0; i<columnar->getNumColumns(); i++)
+            names.append(py::make_tuple(columnar->getColumnKind(i),
+                                        columnar->getColumnTag(i),
+                                        columnar->getColumnName(i)));
+        return names;
+      }
+    )
+    .def ("reduce", [](const RecorderFileReader &reader, int column, long long first, long long last) {
+        clip_rows(reader, first, last);
+        double min, max, rms;
+        if (reader.reduce(column, first, last - first, min, max, rms) != 0)
+          throw py::index_error("could not reduce column " + std::to_string(column));
+        py::dict result;
+        result["min"] = min;
+        result["max"] = max;
+        result["rms"] = rms;
+        return result;
+      },
+      py::arg("column"), py::arg("first") = 0, py::arg("last") = -1
+    )
+  ;
+}
+
+#ifdef _RECORDER_FILE_MODULE
+#include <StandardStream.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+PYBIND11_MODULE(OpenSeesRecorderFile, m) {
+  m.doc() = "Random access to the output of OpenSees recorders";
+  init_recorder_file(m);
+}
+#endif
@@ -0,0 +1,392 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of the
+// RecorderFileReader class.
+//
+#include <RecorderFileReader.h>
+#include <ColumnarFormat.h>
+#include <BinaryFileStream.h>
+#include <OPS_Globals.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+RecorderFileReader::RecorderFileReader()
+  :format(Unknown), data(0), rowStride(0), numRows(0), numColumns(0)
+{
+
+}
+
+RecorderFileReader::~RecorderFileReader()
+{
+  this->close();
+}
+
+int
+RecorderFileReader::open(const char *fileName, int fileFormat, int columns)
+{
+  this->close();
+
+  if (fileFormat == Columnar || fileFormat == Unknown) {
+    if (fileFormat == Unknown) {
+      if (theFile.open(fileName) != 0)
+	return -1;
+      const char *start = theFile.getData();
+      size_t size = theFile.getSize();
+      if (size >= 8 && memcmp(start, COLUMNAR_MAGIC, 8) == 0)
+	fileFormat = Columnar;
+      else {
+	// a text file has nothing but printable characters and white space
+	fileFormat = Text;
+	size_t checked = (size < 4096) ? size : 4096;
+	for (size_t i = 0; i < checked; i++) {
+	  unsigned char c = (unsigned char)start[i];
+	  if ((c < 32 || c > 126) && c != '\n' && c != '\r' && c != '\t') {
+	    fileFormat = Binary;
+	    break;
+	  }
+	}
+      }
+    }
+
+    if (fileFormat == Columnar) {
+      theFile.close();
+      if (theColumnarReader.open(fileName) != 0)
+	return -1;
+      format = Columnar;
+      numRows = theColumnarReader.getNumRows();
+      numColumns = theColumnarReader.getNumColumns();
+      return 0;
+    }
+  }
+
+  if (theFile.getData() == 0 && theFile.open(fileName) != 0)
+    return -1;
+
+  int result = (fileFormat == Binary) ? this->openBinary(columns) : this->openText();
+  if (result != 0) {
+    opserr << "WARNING RecorderFileReader::open() - could not read the rows of "
+	   << fileName << endln;
+    this->close();
+    return -1;
+  }
+
+  return 0;
+}
+
+int
+RecorderFileReader::openBinary(int columns)
+{
+  format = Binary;
+
+  // each row is the doubles followed by a newline
+  const char *start = theFile.getData();
+  size_t size = theFile.getSize();
+  if (size == 0) {
+    numColumns = columns;
+    return 0;
+  }
+
+  // the number of columns, unless given, is the one for which every row
+  // ends with a newline
+  int first = (columns > 0) ? columns : 1;
+  size_t maxColumns = (size - 1)/8;
+  if (maxColumns > 1048576)
+    maxColumns = 1048576;
+  int last = (columns > 0) ? columns : (int)maxColumns;
+  for (int n = first; n <= last; n++) {
+    size_t stride = 8*(size_t)n + 1;
+    if (size % stride != 0)
+      continue;
+
+    long long rows = (long long)(size / stride);
+    bool found = true;
+    for (long long r = 0; r < rows && found; r++)
+      found = (start[r*stride + 8*n] == '\n');
+    if (found) {
+      data = start;
+      rowStride = stride;
+      numRows = rows;
+      numColumns = n;
+      return 0;
+    }
+  }
+
+  return -1;
+}
+
+int
+RecorderFileReader::openText(void)
+{
+  format = Text;
+
+  const char *p = theFile.getData();
+  const char *end = p + theFile.getSize();
+  std::string line;
+  std::vector<double> row;
+
+  while (p < end) {
+    const char *eol = (const char *)memchr(p, '\n', end - p);
+    bool complete = (eol != 0);
+    if (eol == 0)
+      eol = end;
+    line.assign(p, eol);
+    p = eol + 1;
+
+    row.clear();
+    const char *s = line.c_str();
+    while (*s == ' ' || *s == '\t')
+      s++;
+
+    // comment lines are skipped, as are the lines of text, e.g. column
+    // headings, before the first row
+    if (*s == '#')
+      continue;
+
+    bool isText = false;
+    while (*s != '\0') {
+      while (*s == ' ' || *s == ',' || *s == '\t' || *s == '\r')
+	s++;
+      if (*s == '\0')
+	break;
+      char *next;
+      double value = strtod(s, &next);
+      if (next == s) {
+	isText = true;
+	break;
+      }
+      row.push_back(value);
+      s = next;
+    }
+
+    if (isText == true) {
+      if (numRows == 0)
+	continue;
+      return -1;
+    }
+
+    if (row.empty())
+      continue;
+    if (numRows == 0)
+      numColumns = (int)row.size();
+    else if ((int)row.size() != numColumns) {
+      // a row still being written at the end is left out
+      if (complete == false)
+	break;
+      return -1;
+    }
+
+    textValues.insert(textValues.end(), row.begin(), row.end());
+    numRows++;
+  }
+
+  theFile.close();
+  data = textValues.empty() ? 0 : (const char *)&textValues[0];
+  rowStride = 8*(size_t)numColumns;
+
+  return 0;
+}
+
+void
+RecorderFileReader::close(void)
+{
+  theFile.close();
+  theColumnarReader.close();
+  textValues.clear();
+
+  format = Unknown;
+  data = 0;
+  rowStride = 0;
+  numRows = 0;
+  numColumns = 0;
+}
+
+int
+RecorderFileReader::getFormat(void) const
+{
+  return format;
+}
+
+long long
+RecorderFileReader::getNumRows(void) const
+{
+  return numRows;
+}
+
+int
+RecorderFileReader::getNumColumns(void) const
+{
+  return numColumns;
+}
+
+const char *
+RecorderFileReader::getData(void) const
+{
+  return data;
+}
+
+size_t
+RecorderFileReader::getRowStride(void) const
+{
+  return rowStride;
+}
+
+size_t
+RecorderFileReader::getColumnStride(void) const
+{
+  return sizeof(double);
+}
+
+double
+RecorderFileReader::getValue(long long row, int column) const
+{
+  if (row < 0 || row >= numRows || column < 0 || column >= numColumns)
+    return 0.0;
+
+  double value = 0.0;
+  if (format == Columnar)
+    theColumnarReader.readColumn(column, &value, row, 1);
+  else
+    memcpy(&value, data + row*rowStride + column*sizeof(double), sizeof(double));
+
+  return value;
+}
+
+long long
+RecorderFileReader::readColumn(int column, double *values,
+			       long long firstRow, long long rows) const
+{
+  if (format == Columnar)
+    return theColumnarReader.readColumn(column, values, firstRow, rows);
+
+  if (column < 0 || column >= numColumns || firstRow < 0)
+    return -1;
+  if (firstRow > numRows)
+    firstRow = numRows;
+  if (rows < 0 || firstRow + rows > numRows)
+    rows = numRows - firstRow;
+
+  const char *p = data + firstRow*rowStride + column*sizeof(double);
+  for (long long r = 0; r < rows; r++, p += rowStride)
+    memcpy(&values[r], p, sizeof(double));
+
+  return rows;
+}
+
+int
+RecorderFileReader::getColumn(int objectIndex, int component, int numComponents,
+			      bool hasTime)
+{
+  return (hasTime ? 1 : 0) + objectIndex*numComponents + component;
+}
+
+int
+RecorderFileReader::findColumn(const char *kind, int objectTag, const char *name) const
+{
+  if (format != Columnar)
+    return -1;
+
+  return theColumnarReader.findColumn(kind, objectTag, name);
+}
+
+const ColumnarFileReader *
+RecorderFileReader::getColumnarReader(void) const
+{
+  return (format == Columnar) ? &theColumnarReader : 0;
+}
+
+int
+RecorderFileReader::findTimeRange(double startTime, double endTime,
+				  long long &firstRow, long long &lastRow,
+				  int timeColumn) const
+{
+  if (timeColumn < 0 || timeColumn >= numColumns)
+    return -1;
+
+  // the first row with a time not less than startTime
+  long long low = 0, high = numRows;
+  while (low < high) {
+    long long mid = low + (high - low)/2;
+    if (this->getValue(mid, timeColumn) < startTime)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  firstRow = low;
+
+  // the first row with a time greater than endTime
+  high = numRows;
+  while (low < high) {
+    long long mid = low + (high - low)/2;
+    if (this->getValue(mid, timeColumn) <= endTime)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  lastRow = low;
+
+  return 0;
+}
+
+int
+RecorderFileReader::reduce(int column, long long firstRow, long long rows,
+			   double &min, double &max, double &rms) const
+{
+  if (column < 0 || column >= numColumns || firstRow < 0)
+    return -1;
+  if (firstRow > numRows)
+    firstRow = numRows;
+  if (rows < 0 || firstRow + rows > numRows)
+    rows = numRows - firstRow;
+
+  min = 0.0;
+  max = 0.0;
+  rms = 0.0;
+  if (rows == 0)
+    return 0;
+
+  const long long pieceSize = 65536;
+  std::vector<double> piece((size_t)((rows < pieceSize) ? rows : pieceSize));
+  double sumSquares = 0.0;
+  min = max = this->getValue(firstRow, column);
+
+  for (long long start = firstRow; start < firstRow + rows; start += pieceSize) {
+    long long count = firstRow + rows - start;
+    if (count > pieceSize)
+      count = pieceSize;
+    if (this->readColumn(column, &piece[0], start, count) != count)
+      return -1;
+
+    for (long long i = 0; i < count; i++) {
+      double value = piece[i];
+      if (value < min)
+	min = value;
+      if (value > max)
+	max = value;
+      sumSquares += value*value;
+    }
+  }
+
+  rms = sqrt(sumSquares / rows);
+  return 0;
+}
@@ -0,0 +1,109 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for
+// RecorderFileReader. A RecorderFileReader gives random access to the
+// output of a recorder written by a BinaryFileStream, a DataFileStream
+// or a ColumnarFileStream, for post-processing without re-parsing text.
+//
+// A binary file is memory-mapped and its values are used in place: the
+// value of row i and column j is the double at getData() + i*getRowStride()
+// + j*getColumnStride() bytes, which may not be aligned. A text file is
+// parsed once into memory and then accessed the same way. A columnar
+// file has no such layout, getData() returning 0; its columns are read
+// through readColumn(), which decodes only the blocks holding the rows.
+//
+#ifndef RecorderFileReader_h
+#define RecorderFileReader_h
+
+#include <MappedFile.h>
+#include <ColumnarFileReader.h>
+
+#include <vector>
+
+class RecorderFileReader
+{
+  public:
+    enum Format {
+      Unknown  = -1,
+      Text     = 0,
+      Binary   = 1,
+      Columnar = 2
+    };
+
+    RecorderFileReader();
+    ~RecorderFileReader();
+
+    // opens a recorder file, finding its format from its contents if it
+    // is Unknown; the number of columns of a binary file, unless given,
+    // is the smallest for which every row ends with a newline. Returns 0
+    // if successful.
+    int open(const char *fileName, int format = Unknown, int numColumns = 0);
+    void close(void);
+
+    int getFormat(void) const;
+    long long getNumRows(void) const;
+    int getNumColumns(void) const;
+
+    const char *getData(void) const;
+    size_t getRowStride(void) const;
+    size_t getColumnStride(void) const;
+
+    double getValue(long long row, int column) const;
+    long long readColumn(int column, double *values,
+			 long long firstRow = 0, long long numRows = -1) const;
+
+    // the column of a component of the objectIndex'th object of a
+    // recorder with numComponents columns per object, e.g. a dof of a
+    // node, after the time column if hasTime
+    static int getColumn(int objectIndex, int component, int numComponents,
+			 bool hasTime = true);
+    // the column of a response of an object of a columnar file, -1 if
+    // there is none or the file has no column descriptions
+    int findColumn(const char *kind, int objectTag, const char *name) const;
+    const ColumnarFileReader *getColumnarReader(void) const;
+
+    // finds the rows [firstRow, lastRow) with a time between startTime and
+    // endTime, the time being in timeColumn and increasing
+    int findTimeRange(double startTime, double endTime,
+		      long long &firstRow, long long &lastRow,
+		      int timeColumn = 0) const;
+
+    // the minimum, maximum and root mean square of numRows rows of a
+    // column from firstRow on, reading the rows in pieces
+    int reduce(int column, long long firstRow, long long numRows,
+	       double &min, double &max, double &rms) const;
+
+  private:
+    int openBinary(int numColumns);
+    int openText(void);
+
+    int format;
+    MappedFile theFile;
+    ColumnarFileReader theColumnarReader;
+    std::vector<double> textValues;  // the values of a text file
+
+    const char *data;
+    size_t rowStride;
+    long long numRows;
+    int numColumns;
+};
+
+#endif
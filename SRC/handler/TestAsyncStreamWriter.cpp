@@ -0,0 +1,175 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: a test of the background writer of the file recorders. Two
+// producer threads write the rows of a recorder each, through their own
+// DataFileStream, while the AsyncStreamWriter, with a ring small enough
+// to wrap many times, formats and writes them. Each file is read back and
+// checked to hold all the rows written so far, in order, after a sync(),
+// after the stream is closed, and after the writer is stopped with rows
+// still queued; the rows written once the writer is stopped must follow.
+//
+// Usage: testAsyncStreamWriter
+
+#include <StandardStream.h>
+#include <DataFileStream.h>
+#include <AsyncStreamWriter.h>
+#include <Vector.h>
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+static const int numProducers = 2;
+static const int numRows = 20000;
+static const int syncInterval = 2500;
+
+static std::atomic<int> numFailed(0);
+
+static void
+writeRows(OPS_Stream &theStream, int producer, int first, int last)
+{
+  Vector row(3);
+  for (int i = first; i < last; i++) {
+    row(0) = producer;
+    row(1) = i;
+    row(2) = 0.5*i;
+    theStream.write(row);
+  }
+}
+
+// reads a file back; returns the number of failed checks
+static int
+checkFile(const char *fileName, int producer, int numExpected, const char *when)
+{
+  std::ifstream theFile(fileName);
+  if (!theFile) {
+    opserr << fileName << " " << when << ": could not open the file\n";
+    return 1;
+  }
+
+  std::string line;
+  int numRead = 0;
+  while (std::getline(theFile, line)) {
+    std::istringstream values(line);
+    double p, i, x;
+    if (!(values >> p >> i >> x) || p != producer || i != numRead || x != 0.5*numRead) {
+      opserr << fileName << " " << when << ": row " << numRead << " is \"" << line.c_str() << "\"\n";
+      return 1;
+    }
+    numRead++;
+  }
+
+  if (numRead != numExpected) {
+    opserr << fileName << " " << when << ": " << numRead << " rows read, "
+           << numExpected << " written\n";
+    return 1;
+  }
+
+  return 0;
+}
+
+static void
+fileName(char *name, const char *prefix, int producer)
+{
+  sprintf(name, "%s%d.out", prefix, producer);
+}
+
+int main(int argc, char **argv)
+{
+  char names[numProducers][32];
+  std::thread producers[numProducers];
+
+  if (AsyncStreamWriter::start(1024, 0.001) != 0) {
+    opserr << "FAILED\n";
+    return -1;
+  }
+
+  // the rows of each stream are on disk after a sync() and after close()
+  {
+    DataFileStream *theStreams[numProducers];
+    for (int p = 0; p < numProducers; p++) {
+      fileName(names[p], "testAsyncSync", p);
+      theStreams[p] = new DataFileStream(names[p]);
+    }
+
+    for (int p = 0; p < numProducers; p++)
+      producers[p] = std::thread([&, p]() {
+	for (int i = 0; i < numRows; i += syncInterval) {
+	  writeRows(*theStreams[p], p, i, i + syncInterval);
+	  AsyncStreamWriter::sync(theStreams[p]);
+	  numFailed += checkFile(names[p], p, i + syncInterval, "after sync");
+	}
+      });
+    for (int p = 0; p < numProducers; p++)
+      producers[p].join();
+
+    for (int p = 0; p < numProducers; p++) {
+      writeRows(*theStreams[p], p, numRows, 2*numRows);
+      theStreams[p]->close();
+      numFailed += checkFile(names[p], p, 2*numRows, "after close");
+      delete theStreams[p];
+    }
+  }
+
+  // the rows queued are on disk after stop(), and those written once it
+  // has returned follow them
+  {
+    DataFileStream *theStreams[numProducers];
+    for (int p = 0; p < numProducers; p++) {
+      fileName(names[p], "testAsyncStop", p);
+      theStreams[p] = new DataFileStream(names[p]);
+    }
+
+    for (int p = 0; p < numProducers; p++)
+      producers[p] = std::thread([&, p]() {
+	writeRows(*theStreams[p], p, 0, numRows);
+      });
+    for (int p = 0; p < numProducers; p++)
+      producers[p].join();
+
+    AsyncStreamWriter::stop();
+    if (AsyncStreamWriter::isRunning() == true) {
+      opserr << "writer still running after stop\n";
+      numFailed++;
+    }
+
+    for (int p = 0; p < numProducers; p++)
+      numFailed += checkFile(names[p], p, numRows, "after stop");
+
+    for (int p = 0; p < numProducers; p++) {
+      writeRows(*theStreams[p], p, numRows, 2*numRows);
+      delete theStreams[p];
+      numFailed += checkFile(names[p], p, 2*numRows, "after the writer");
+    }
+  }
+
+  if (numFailed == 0)
+    opserr << "PASSED\n";
+  else
+    opserr << "FAILED\n";
+
+  return numFailed == 0 ? 0 : -1;
+}
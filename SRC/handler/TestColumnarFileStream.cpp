@@ -0,0 +1,246 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: a test of the columnar result files. The rows a recorder
+// would write, a time column and the responses of two nodes, are written
+// by a ColumnarFileStream in double precision, in single precision and
+// compressed, and appended to by a second stream, with the time column
+// described and not; every column, and a range of it crossing row groups,
+// is read back by a ColumnarFileReader and compared with the rows
+// written. lzCompress() and lzDecompress() are
+// checked to recover data that is repetitive, random and empty, and
+// lzDecompress() to reject a truncated block.
+//
+// Usage: testColumnarFileStream
+
+#include <StandardStream.h>
+#include <ColumnarFileStream.h>
+#include <ColumnarFileReader.h>
+#include <ColumnarFormat.h>
+#include <Vector.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+static const int numColumns = 4;
+
+static double
+rowValue(int row, int column)
+{
+  if (column == 0)
+    return 0.01*row;
+  return sin(0.05*row*column) + 0.001*column;
+}
+
+// describes the columns as a NodeRecorder does, which leaves the time
+// it writes first undescribed unless it records a list of nodes
+static void
+describeColumns(ColumnarFileStream &theStream, bool describeTime)
+{
+  theStream.tag("OpenSeesOutput");
+
+  if (describeTime == true) {
+    theStream.tag("TimeOutput");
+    theStream.tag("ResponseType", "time");
+    theStream.endTag();
+  }
+
+  theStream.tag("NodeOutput");
+  theStream.attr("nodeTag", 1);
+  theStream.tag("ResponseType", "UX");
+  theStream.tag("ResponseType", "UY");
+  theStream.endTag();
+
+  theStream.tag("NodeOutput");
+  theStream.attr("nodeTag", 2);
+  theStream.tag("ResponseType", "UX");
+  theStream.endTag();
+}
+
+static void
+writeRows(ColumnarFileStream &theStream, int firstRow, int numRows)
+{
+  Vector data(numColumns);
+  for (int row = firstRow; row < firstRow + numRows; row++) {
+    for (int j = 0; j < numColumns; j++)
+      data(j) = rowValue(row, j);
+    theStream.write(data);
+  }
+}
+
+// reads the file back; returns the number of failed checks
+static int
+checkFile(const char *fileName, int numRows, double tol)
+{
+  int numFailed = 0;
+
+  ColumnarFileReader theReader;
+  if (theReader.open(fileName) != 0) {
+    opserr << fileName << ": failed to open\n";
+    return 1;
+  }
+
+  if (theReader.getNumColumns() != numColumns || theReader.getNumRows() != numRows) {
+    opserr << fileName << ": " << theReader.getNumColumns() << " columns and "
+	   << (int)theReader.getNumRows() << " rows\n";
+    return 1;
+  }
+
+  if (theReader.findColumn("TimeOutput", 0, "time") != 0 ||
+      theReader.findColumn("NodeOutput", 1, "UY") != 2 ||
+      theReader.findColumn("NodeOutput", 2, "UX") != 3 ||
+      theReader.findColumn("NodeOutput", 3, "UX") != -1) {
+    opserr << fileName << ": columns not found by response\n";
+    numFailed++;
+  }
+
+  std::vector<double> values(numRows);
+  double maxDiff = 0.0;
+  for (int j = 0; j < numColumns; j++) {
+    if (theReader.readColumn(j, &values[0]) != numRows) {
+      opserr << fileName << ": failed to read column " << j << endln;
+      return numFailed + 1;
+    }
+    // the time column is always stored in double precision
+    double columnTol = (j == 0) ? 0.0 : tol;
+    for (int row = 0; row < numRows; row++) {
+      double diff = fabs(values[row] - rowValue(row, j));
+      if (diff > columnTol)
+	maxDiff = fmax(maxDiff, diff);
+    }
+  }
+
+  // a range starting and ending inside row groups
+  int firstRow = 1000;
+  int rangeRows = 1100;
+  if (theReader.readColumn(2, &values[0], firstRow, rangeRows) != rangeRows) {
+    opserr << fileName << ": failed to read a range of rows\n";
+    return numFailed + 1;
+  }
+  for (int row = 0; row < rangeRows; row++) {
+    double diff = fabs(values[row] - rowValue(firstRow + row, 2));
+    if (diff > tol)
+      maxDiff = fmax(maxDiff, diff);
+  }
+
+  opserr << fileName << " max difference: " << maxDiff << endln;
+  if (maxDiff != 0.0)
+    numFailed++;
+
+  return numFailed;
+}
+
+// returns the number of failed checks
+static int
+checkLZ(const std::vector<unsigned char> &data, const char *name)
+{
+  int n = (int)data.size();
+  std::vector<unsigned char> compressed(lzBound(n) + 1);
+  std::vector<unsigned char> recovered(n + 1);
+
+  int size = lzCompress(n ? &data[0] : 0, n, &compressed[0], lzBound(n));
+  if (size < 0) {
+    opserr << "lz " << name << ": failed to compress\n";
+    return 1;
+  }
+
+  int m = lzDecompress(&compressed[0], size, &recovered[0], n);
+  if (m != n || (n != 0 && memcmp(&recovered[0], &data[0], n) != 0)) {
+    opserr << "lz " << name << ": data not recovered\n";
+    return 1;
+  }
+
+  opserr << "lz " << name << ": " << n << " bytes compressed to " << size << endln;
+
+  if (size > 1 && lzDecompress(&compressed[0], size - 1, &recovered[0], n) == n &&
+      memcmp(&recovered[0], &data[0], n) == 0) {
+    opserr << "lz " << name << ": truncated block not rejected\n";
+    return 1;
+  }
+
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  int numFailed = 0;
+  const int numRows = 2500;
+
+  // double precision, three row groups of 1024 rows
+  {
+    ColumnarFileStream theStream("testColumnar.out");
+    describeColumns(theStream, true);
+    writeRows(theStream, 0, numRows);
+  }
+  numFailed += checkFile("testColumnar.out", numRows, 0.0);
+
+  // single precision and compressed, in smaller groups
+  {
+    ColumnarFileStream theStream("testColumnarFloat.out", OVERWRITE, true, true, 256);
+    describeColumns(theStream, false);
+    writeRows(theStream, 0, numRows);
+  }
+  numFailed += checkFile("testColumnarFloat.out", numRows, 1.0e-6);
+
+  // a second stream appending to a complete file
+  {
+    ColumnarFileStream theStream("testColumnarAppend.out");
+    describeColumns(theStream, false);
+    writeRows(theStream, 0, 1500);
+  }
+  {
+    ColumnarFileStream theStream("testColumnarAppend.out", APPEND);
+    describeColumns(theStream, true);
+    writeRows(theStream, 1500, numRows - 1500);
+  }
+  numFailed += checkFile("testColumnarAppend.out", numRows, 0.0);
+
+  std::vector<unsigned char> repetitive(100000);
+  for (int i = 0; i < (int)repetitive.size(); i++)
+    repetitive[i] = (unsigned char)("OpenSees"[i % 8]);
+  numFailed += checkLZ(repetitive, "repetitive");
+
+  std::vector<unsigned char> random(100000);
+  srand(1);
+  for (int i = 0; i < (int)random.size(); i++)
+    random[i] = (unsigned char)(rand() & 0xff);
+  numFailed += checkLZ(random, "random");
+
+  std::vector<double> history(20000);
+  for (int i = 0; i < (int)history.size(); i++)
+    history[i] = (i < 10000) ? 0.0 : rowValue(i, 1);
+  std::vector<unsigned char> bytes(history.size()*sizeof(double));
+  memcpy(&bytes[0], &history[0], bytes.size());
+  numFailed += checkLZ(bytes, "history");
+
+  numFailed += checkLZ(std::vector<unsigned char>(), "empty");
+
+  if (numFailed == 0)
+    opserr << "PASSED\n";
+  else
+    opserr << "FAILED\n";
+
+  return numFailed == 0 ? 0 : -1;
+}
@@ -1443,6 +1443,14 @@ int OPS_System()
 
 	theSOE = (LinearSOE*)OPS_UmfpackGenLinSolver();
 
+    } else if (strcmp(type, "Supernodal") == 0) {
+
+	theSOE = (LinearSOE*)OPS_SupernodalSymLinSolver();
+
+    } else if (strcmp(type, "AMG") == 0) {
+
+	theSOE = (LinearSOE*)OPS_AMGCLSolver();
+
     } else if (strcmp(type,"FullGeneral") == 0) {
 	// now must determine the type of solver to create from rest of args
 	theSOE = (LinearSOE*)OPS_FullGenLinLapackSolver();
@@ -490,6 +490,8 @@ void* OPS_BandSPDLinLapack();
 void* OPS_SuperLUSolver();
 void* OPS_ProfileSPDLinDirectSolver();
 void* OPS_UmfpackGenLinSolver();
+void* OPS_SupernodalSymLinSolver();
+void* OPS_AMGCLSolver();
 void* OPS_DiagonalDirectSolver();
 void* OPS_SProfileSPDLinSolver();
 void* OPS_PFEMSolver();
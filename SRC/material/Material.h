@@ -58,6 +58,11 @@ class Material : public TaggedObject, public MovableObject
 
     // method for this material to update itself according to its new parameters
     virtual void update(void) {return;}
+
+    // returns true if the state determination and commit methods may be
+    // invoked on this object while other objects of its class are used on
+    // other threads, i.e. the class keeps no shared work storage
+    virtual bool isReentrant(void) const {return false;}
 #ifdef _CSS
     virtual void resetResponse(int responseID, Information* myInfo) { return; };
 #endif // _CSS
@@ -0,0 +1,97 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of
+// SharedParameterBlocks.
+//
+#include <SharedParameters.h>
+#include <OPS_Globals.h>
+#include <mutex>
+#include <string.h>
+#include <vector>
+
+// the counts of every class of parameters in use; they live as long as
+// the program
+static std::mutex registryMutex;
+
+static std::vector<SharedParameterBlocks *> &
+registry(void)
+{
+  static std::vector<SharedParameterBlocks *> theRegistry;
+  return theRegistry;
+}
+
+SharedParameterBlocks::SharedParameterBlocks(const char *name, int pSize, int bSize)
+  :className(name), paramSize(pSize), blockSize(bSize),
+   numBlocks(0), numHolders(0)
+{
+  std::lock_guard<std::mutex> lock(registryMutex);
+  registry().push_back(this);
+}
+
+int
+SharedParameterBlocks::getCounts(const char *name, long &blocks, long &holders)
+{
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  for (std::size_t i = 0; i < registry().size(); i++) {
+    SharedParameterBlocks *theCounts = registry()[i];
+    if (strcmp(theCounts->className, name) == 0) {
+      blocks = theCounts->numBlocks.load();
+      holders = theCounts->numHolders.load();
+      return 0;
+    }
+  }
+
+  blocks = 0;
+  holders = 0;
+  return -1;
+}
+
+void
+SharedParameterBlocks::Print(OPS_Stream &s)
+{
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  long totalShared = 0;
+  long totalCopied = 0;
+
+  s << "Shared material parameters:\n";
+  for (std::size_t i = 0; i < registry().size(); i++) {
+    SharedParameterBlocks *theCounts = registry()[i];
+    long blocks = theCounts->numBlocks.load();
+    long holders = theCounts->numHolders.load();
+
+    // a pointer in each material and the blocks, against the parameters
+    // in each material
+    long shared = holders*(long)sizeof(void *) + blocks*theCounts->blockSize;
+    long copied = holders*theCounts->paramSize;
+    totalShared += shared;
+    totalCopied += copied;
+
+    // as doubles, which every stream prints, a count past the range of
+    // an int included
+    s << "  " << theCounts->className << ": " << 1.0*holders << " materials, "
+      << 1.0*blocks << " parameter blocks, " << 1.0*shared << " bytes shared, "
+      << 1.0*copied << " bytes copied\n";
+  }
+  s << "  total: " << 1.0*totalShared << " bytes shared, "
+    << 1.0*totalCopied << " bytes copied\n";
+}
@@ -0,0 +1,155 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definitions for
+// SharedParameters and SharedParameterBlocks. A SharedParameters<P>
+// holds the parameters of a material, a struct P of constants, in a
+// block that the copies of the material share, so that the fibers or
+// integration points made from one material keep a single copy of its
+// parameters and a pointer each. A material changing its parameters
+// does so through modify(), which first gives it a block of its own if
+// the block is shared, so that its copies are not changed with it, or
+// through assign(), which does so only if the parameters differ; P then
+// needs an operator==.
+//
+// P has a static getClassType() naming the material. The blocks of each
+// P are counted, and SharedParameterBlocks::Print() reports the memory
+// they take against that of a copy of the parameters in every material.
+//
+#ifndef SharedParameters_h
+#define SharedParameters_h
+
+#include <atomic>
+
+class OPS_Stream;
+
+class SharedParameterBlocks
+{
+  public:
+    static void Print(OPS_Stream &s);
+
+    // the blocks and the materials holding them of the named class; -1
+    // if no material of the class has been made
+    static int getCounts(const char *className, long &numBlocks, long &numHolders);
+
+  private:
+    template <class P> friend class SharedParameters;
+
+    SharedParameterBlocks(const char *className, int paramSize, int blockSize);
+
+    const char *className;
+    int paramSize;                  // bytes of the parameters
+    int blockSize;                  // bytes of a block holding them
+    std::atomic<long> numBlocks;
+    std::atomic<long> numHolders;   // materials holding a block
+};
+
+template <class P>
+class SharedParameters
+{
+  public:
+    SharedParameters()
+      :theBlock(new Block())
+    {
+      counts().numBlocks++;
+      counts().numHolders++;
+    }
+
+    explicit SharedParameters(const P &theParameters)
+      :theBlock(new Block(theParameters))
+    {
+      counts().numBlocks++;
+      counts().numHolders++;
+    }
+
+    SharedParameters(const SharedParameters &other)
+      :theBlock(other.theBlock)
+    {
+      theBlock->refs++;
+      counts().numHolders++;
+    }
+
+    ~SharedParameters()
+    {
+      this->release();
+      counts().numHolders--;
+    }
+
+    SharedParameters &operator=(const SharedParameters &other)
+    {
+      if (theBlock != other.theBlock) {
+	other.theBlock->refs++;
+	this->release();
+	theBlock = other.theBlock;
+      }
+      return *this;
+    }
+
+    const P &operator*() const {return theBlock->params;}
+    const P *operator->() const {return &theBlock->params;}
+
+    // the parameters to change, copied first if shared
+    P &modify(void)
+    {
+      if (theBlock->refs.load() > 1) {
+	Block *theCopy = new Block(theBlock->params);
+	counts().numBlocks++;
+	this->release();
+	theBlock = theCopy;
+      }
+      return theBlock->params;
+    }
+
+    // sets the parameters, leaving the block shared if they are the same
+    void assign(const P &theParameters)
+    {
+      if (!(theBlock->params == theParameters))
+	this->modify() = theParameters;
+    }
+
+    bool isShared(void) const {return theBlock->refs.load() > 1;}
+
+  private:
+    struct Block {
+      Block() :params(), refs(1) {}
+      Block(const P &theParameters) :params(theParameters), refs(1) {}
+      P params;
+      std::atomic<int> refs;
+    };
+
+    void release(void)
+    {
+      if (--(theBlock->refs) == 0) {
+	delete theBlock;
+	counts().numBlocks--;
+      }
+    }
+
+    static SharedParameterBlocks &counts(void)
+    {
+      static SharedParameterBlocks theCounts(P::getClassType(),
+					     (int)sizeof(P), (int)sizeof(Block));
+      return theCounts;
+    }
+
+    Block *theBlock;
+};
+
+#endif
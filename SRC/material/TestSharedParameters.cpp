@@ -0,0 +1,158 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: a test of the parameters that the copies of Steel02,
+// Concrete01 and Concrete02 share. A material of each class is copied as
+// the fibers of a section are, and the copies must hold one block of
+// parameters between them. The copies then receive the state of the
+// material sent through a SnapshotDatastore, which must leave the block
+// shared, and the state of a material with other parameters, which must
+// give the receiving copy a block of its own and the response of that
+// material; an updateParameter() must do the same where the class has
+// parameters to update. The memory report of
+// print -parameterBlocks is printed at the end.
+//
+// Usage: testSharedParameters
+
+#include <StandardStream.h>
+#include <SharedParameters.h>
+#include <Steel02.h>
+#include <Concrete01.h>
+#include <Concrete02.h>
+#include <Information.h>
+#include <Domain.h>
+#include <FEM_ObjectBroker.h>
+#include <SnapshotDatastore.h>
+
+#include <math.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+static const int numCopies = 100;
+
+static int numFaults = 0;
+
+static void
+checkBlocks(const char *className, long numBlocks, long numHolders, const char *when)
+{
+  long blocks, holders;
+  SharedParameterBlocks::getCounts(className, blocks, holders);
+  if (blocks != numBlocks || holders != numHolders) {
+    opserr << className << " " << when << ": " << blocks << " blocks for "
+	   << holders << " materials, expected " << numBlocks << " for "
+	   << numHolders << endln;
+    numFaults++;
+  }
+}
+
+// the stress of the material along a strain history
+static double
+stressAt(UniaxialMaterial &theMaterial, double strain)
+{
+  theMaterial.setTrialStrain(0.5*strain);
+  theMaterial.commitState();
+  theMaterial.setTrialStrain(strain);
+  double stress = theMaterial.getStress();
+  theMaterial.revertToStart();
+  return stress;
+}
+
+static void
+testClass(const char *className, UniaxialMaterial &theMaterial,
+	  UniaxialMaterial &otherMaterial, int parameterID, double value,
+	  double strain, SnapshotDatastore &theStore, FEM_ObjectBroker &theBroker)
+{
+  // otherMaterial holds a block of its own throughout
+  UniaxialMaterial *theCopies[numCopies];
+  for (int i = 0; i < numCopies; i++)
+    theCopies[i] = theMaterial.getCopy();
+  checkBlocks(className, 2, numCopies+2, "copied");
+
+  // the same parameters received
+  theMaterial.sendSelf(1, theStore);
+  for (int i = 0; i < numCopies; i++)
+    theCopies[i]->recvSelf(1, theStore, theBroker);
+  checkBlocks(className, 2, numCopies+2, "received unchanged");
+
+  // other parameters received
+  otherMaterial.sendSelf(2, theStore);
+  theCopies[0]->recvSelf(2, theStore, theBroker);
+  checkBlocks(className, 3, numCopies+2, "received changed");
+  double expected = stressAt(otherMaterial, strain);
+  if (fabs(stressAt(*theCopies[0], strain) - expected) > 1.0e-12*(1.0+fabs(expected))) {
+    opserr << className << ": the copy does not respond as the material received\n";
+    numFaults++;
+  }
+  expected = stressAt(theMaterial, strain);
+  if (fabs(stressAt(*theCopies[1], strain) - expected) > 1.0e-12*(1.0+fabs(expected))) {
+    opserr << className << ": the other copies were changed with it\n";
+    numFaults++;
+  }
+
+  // an updated parameter, for a class that has any
+  if (parameterID > 0) {
+    Information info(value);
+    theCopies[2]->updateParameter(parameterID, info);
+    checkBlocks(className, 4, numCopies+2, "updated");
+  }
+
+  for (int i = 0; i < numCopies; i++)
+    delete theCopies[i];
+  checkBlocks(className, 2, 2, "deleted");
+}
+
+int main(int argc, char **argv)
+{
+  Domain theDomain;
+  FEM_ObjectBroker theBroker;
+  SnapshotDatastore theStore(theDomain, theBroker);
+
+  Steel02 steel(1, 60.0, 29000.0, 0.02, 18.5, 0.925, 0.15);
+  Steel02 otherSteel(2, 50.0, 29000.0, 0.01, 18.5, 0.925, 0.15);
+  testClass("Steel02", steel, otherSteel, 1, 55.0, 0.004, theStore, theBroker);
+
+  Concrete01 concrete(3, -4.0, -0.002, -1.0, -0.006);
+  Concrete01 otherConcrete(4, -5.0, -0.0025, -1.5, -0.006);
+  testClass("Concrete01", concrete, otherConcrete, 1, -4.5, -0.0015, theStore, theBroker);
+
+  Concrete02 concrete2(5, -4.0, -0.002, -1.0, -0.006, 0.1, 0.5, 200.0);
+  Concrete02 otherConcrete2(6, -5.0, -0.0025, -1.5, -0.006, 0.1, 0.6, 250.0);
+  testClass("Concrete02", concrete2, otherConcrete2, 0, 0.0, -0.0015, theStore, theBroker);
+
+  // the report of print -parameterBlocks, with the copies of a section of
+  // 200 fibers of each material
+  UniaxialMaterial *theFibers[600];
+  for (int i = 0; i < 200; i++) {
+    theFibers[i] = steel.getCopy();
+    theFibers[200+i] = concrete.getCopy();
+    theFibers[400+i] = concrete2.getCopy();
+  }
+  SharedParameterBlocks::Print(opserr);
+  for (int i = 0; i < 600; i++)
+    delete theFibers[i];
+
+  if (numFaults == 0)
+    opserr << "PASSED\n";
+  else
+    opserr << "FAILED - " << numFaults << " faults\n";
+
+  return numFaults == 0 ? 0 : -1;
+}
@@ -0,0 +1,1359 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of FiberBatch. The
+// kernels repeat the setTrial() of their materials on the arrays of a
+// group; a change to one of those materials must be made to its kernel.
+//
+#include <FiberBatch.h>
+#include <math.h>
+#include <float.h>
+#include <UniaxialMaterial.h>
+#include <Steel02.h>
+#include <Concrete01.h>
+#include <Concrete02.h>
+#include <ElasticMaterial.h>
+#include <classTags.h>
+
+// adds a fiber of stress and tangent to the sums of a group
+template <int NC>
+static inline void
+sumFiber(double ay, double az, double A, double stress, double tangent,
+	 double *k, double *s)
+{
+  double kA = tangent*A;
+  double sA = stress*A;
+
+  k[0] += kA;
+  k[1] += kA*ay;
+  k[3] += kA*ay*ay;
+  s[0] += sA;
+  s[1] += sA*ay;
+
+  if (NC == 2) {
+    k[2] += kA*az;
+    k[4] += kA*ay*az;
+    k[5] += kA*az*az;
+    s[2] += sA*az;
+  }
+}
+
+static inline void
+addSums(const double *kSum, const double *sSum, double *k, double *s)
+{
+  for (int i = 0; i < 6; i++)
+    k[i] += kSum[i];
+  for (int i = 0; i < 3; i++)
+    s[i] += sSum[i];
+}
+
+// the elastic range of a material, if its strain is in it
+static bool
+inElasticRange(UniaxialMaterial *theMat, double &strainMin, double &strainMax,
+	       double &sigma0, double &tangent)
+{
+  if (theMat->getElasticRange(strainMin, strainMax, sigma0, tangent) != 0)
+    return false;
+
+  double strain = theMat->getStrain();
+  return (strain >= strainMin && strain <= strainMax);
+}
+
+
+// a group of fibers; ay is -y and az is z of each fiber, and stress and
+// tangent its trial stress and tangent
+class FiberBatch::Group
+{
+  public:
+    virtual ~Group() {}
+
+    void addFiber(UniaxialMaterial *theMat, double y, double z, double A)
+    {
+      theMaterials.push_back(theMat);
+      ay.push_back(-y);
+      az.push_back(z);
+      area.push_back(A);
+    }
+
+    int size(void) const {return (int)theMaterials.size();}
+
+    virtual void getState(void) = 0;
+    virtual void putState(void) = 0;
+    virtual int setTrial(int numCoords, const double *d, double *k, double *s) = 0;
+    virtual int commitState(void) = 0;
+    virtual int revertToLastCommit(void) = 0;
+
+    // whether a fiber has entered an elastic range at the committed state
+    virtual bool isRegrouped(void)
+    {
+      double strainMin, strainMax, sigma0, E;
+      int n = this->size();
+      for (int j = 0; j < n; j++)
+	if (inElasticRange(theMaterials[j], strainMin, strainMax, sigma0, E))
+	  return true;
+      return false;
+    }
+
+    void sumFibers(int numCoords, double *k, double *s)
+    {
+      double kSum[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+      double sSum[3] = {0.0, 0.0, 0.0};
+      int n = this->size();
+      if (numCoords == 1)
+	for (int j = 0; j < n; j++)
+	  sumFiber<1>(ay[j], 0.0, area[j], stress[j], tangent[j], kSum, sSum);
+      else
+	for (int j = 0; j < n; j++)
+	  sumFiber<2>(ay[j], az[j], area[j], stress[j], tangent[j], kSum, sSum);
+      addSums(kSum, sSum, k, s);
+    }
+
+  protected:
+    std::vector<UniaxialMaterial *> theMaterials;
+    std::vector<double> ay, az, area;
+    std::vector<double> stress, tangent;
+};
+
+
+// Steel02, as in Steel02::setTrialStrain()
+class FiberBatch::Steel02Group : public FiberBatch::Group
+{
+  public:
+    void getState(void)
+    {
+      int n = this->size();
+      Fy.resize(n); E0.resize(n); b.resize(n); R0.resize(n);
+      cR1.resize(n); cR2.resize(n);
+      a1.resize(n); a2.resize(n); a3.resize(n); a4.resize(n);
+      sigini.resize(n);
+      epsminP.resize(n); epsmaxP.resize(n); epsplP.resize(n);
+      epss0P.resize(n); sigs0P.resize(n); epssrP.resize(n); sigsrP.resize(n);
+      konP.resize(n); epsP.resize(n); sigP.resize(n); eP.resize(n);
+      EnergyP.resize(n);
+      epsmin.resize(n); epsmax.resize(n); epspl.resize(n);
+      epss0.resize(n); sigs0.resize(n); epsr.resize(n); sigr.resize(n);
+      kon.resize(n); eps.resize(n);
+      stress.resize(n); tangent.resize(n);
+
+      for (int j = 0; j < n; j++) {
+	Steel02 *theMat = static_cast<Steel02 *>(theMaterials[j]);
+	Fy[j] = theMat->par->Fy; E0[j] = theMat->par->E0; b[j] = theMat->par->b;
+	R0[j] = theMat->par->R0; cR1[j] = theMat->par->cR1; cR2[j] = theMat->par->cR2;
+	a1[j] = theMat->par->a1; a2[j] = theMat->par->a2;
+	a3[j] = theMat->par->a3; a4[j] = theMat->par->a4;
+	sigini[j] = theMat->par->sigini;
+
+	epsminP[j] = theMat->epsminP; epsmaxP[j] = theMat->epsmaxP;
+	epsplP[j] = theMat->epsplP; epss0P[j] = theMat->epss0P;
+	sigs0P[j] = theMat->sigs0P; epssrP[j] = theMat->epssrP;
+	sigsrP[j] = theMat->sigsrP; konP[j] = theMat->konP;
+	epsP[j] = theMat->epsP; sigP[j] = theMat->sigP; eP[j] = theMat->eP;
+	EnergyP[j] = theMat->EnergyP;
+
+	epsmin[j] = theMat->epsmin; epsmax[j] = theMat->epsmax;
+	epspl[j] = theMat->epspl; epss0[j] = theMat->epss0;
+	sigs0[j] = theMat->sigs0; epsr[j] = theMat->epsr;
+	sigr[j] = theMat->sigr; kon[j] = theMat->kon;
+	eps[j] = theMat->eps;
+	stress[j] = theMat->sig; tangent[j] = theMat->e;
+      }
+    }
+
+    void putState(void)
+    {
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	Steel02 *theMat = static_cast<Steel02 *>(theMaterials[j]);
+	theMat->epsminP = epsminP[j]; theMat->epsmaxP = epsmaxP[j];
+	theMat->epsplP = epsplP[j]; theMat->epss0P = epss0P[j];
+	theMat->sigs0P = sigs0P[j]; theMat->epssrP = epssrP[j];
+	theMat->sigsrP = sigsrP[j]; theMat->konP = konP[j];
+	theMat->epsP = epsP[j]; theMat->sigP = sigP[j]; theMat->eP = eP[j];
+	theMat->EnergyP = EnergyP[j];
+
+	theMat->epsmin = epsmin[j]; theMat->epsmax = epsmax[j];
+	theMat->epspl = epspl[j]; theMat->epss0 = epss0[j];
+	theMat->sigs0 = sigs0[j]; theMat->epsr = epsr[j];
+	theMat->sigr = sigr[j]; theMat->kon = kon[j];
+	theMat->eps = eps[j];
+	theMat->sig = stress[j]; theMat->e = tangent[j];
+      }
+    }
+
+    int setTrial(int numCoords, const double *d, double *k, double *s)
+    {
+      if (numCoords == 1)
+	return this->trial<1>(d, k, s);
+      else
+	return this->trial<2>(d, k, s);
+    }
+
+    int commitState(void)
+    {
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	epsminP[j] = epsmin[j];
+	epsmaxP[j] = epsmax[j];
+	epsplP[j] = epspl[j];
+	epss0P[j] = epss0[j];
+	sigs0P[j] = sigs0[j];
+	epssrP[j] = epsr[j];
+	sigsrP[j] = sigr[j];
+	konP[j] = kon[j];
+
+	EnergyP[j] += 0.5*(stress[j] + sigP[j])*(eps[j] - epsP[j]);
+
+	eP[j] = tangent[j];
+	sigP[j] = stress[j];
+	epsP[j] = eps[j];
+      }
+      return 0;
+    }
+
+    int revertToLastCommit(void)
+    {
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	epsmin[j] = epsminP[j];
+	epsmax[j] = epsmaxP[j];
+	epspl[j] = epsplP[j];
+	epss0[j] = epss0P[j];
+	sigs0[j] = sigs0P[j];
+	epsr[j] = epssrP[j];
+	sigr[j] = sigsrP[j];
+	kon[j] = konP[j];
+
+	tangent[j] = eP[j];
+	stress[j] = sigP[j];
+	eps[j] = epsP[j];
+      }
+      return 0;
+    }
+
+  private:
+    template <int NC> int trial(const double *d, double *k, double *s);
+
+    std::vector<double> Fy, E0, b, R0, cR1, cR2, a1, a2, a3, a4, sigini;
+    std::vector<double> epsminP, epsmaxP, epsplP, epss0P, sigs0P;
+    std::vector<double> epssrP, sigsrP, epsP, sigP, eP, EnergyP;
+    std::vector<int> konP;
+    std::vector<double> epsmin, epsmax, epspl, epss0, sigs0, epsr, sigr, eps;
+    std::vector<int> kon;
+};
+
+template <int NC>
+int
+FiberBatch::Steel02Group::trial(const double *d, double *k, double *s)
+{
+  double kSum[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  double sSum[3] = {0.0, 0.0, 0.0};
+
+  int n = this->size();
+  for (int j = 0; j < n; j++) {
+    double strain = d[0] + ay[j]*d[1];
+    if (NC == 2)
+      strain += az[j]*d[2];
+
+    double Fyj = Fy[j];
+    double E0j = E0[j];
+    double bj = b[j];
+    double Esh = bj * E0j;
+    double epsy = Fyj / E0j;
+
+    double epsj = strain;
+    if (sigini[j] != 0.0)
+      epsj = strain + sigini[j]/E0j;
+    double deps = epsj - epsP[j];
+
+    double epsmaxj = epsmaxP[j];
+    double epsminj = epsminP[j];
+    double epsplj = epsplP[j];
+    double epss0j = epss0P[j];
+    double sigs0j = sigs0P[j];
+    double epsrj = epssrP[j];
+    double sigrj = sigsrP[j];
+    int konj = konP[j];
+
+    double sig, e;
+    bool initial = false;
+
+    if (konj == 0 || konj == 3) {
+      if (fabs(deps) < 10.0*DBL_EPSILON) {
+	e = E0j;
+	sig = sigini[j];
+	konj = 3;
+	initial = true;
+      } else {
+	epsmaxj = epsy;
+	epsminj = -epsy;
+	if (deps < 0.0) {
+	  konj = 2;
+	  epss0j = epsminj;
+	  sigs0j = -Fyj;
+	  epsplj = epsminj;
+	} else {
+	  konj = 1;
+	  epss0j = epsmaxj;
+	  sigs0j = Fyj;
+	  epsplj = epsmaxj;
+	}
+      }
+    }
+
+    if (initial == false) {
+      if (konj == 2 && deps > 0.0) {
+	konj = 1;
+	epsrj = epsP[j];
+	sigrj = sigP[j];
+	if (epsP[j] < epsminj)
+	  epsminj = epsP[j];
+	double d1 = (epsmaxj - epsminj) / (2.0*(a4[j] * epsy));
+	double shft = 1.0 + a3[j] * pow(d1, 0.8);
+	epss0j = (Fyj * shft - Esh * epsy * shft - sigrj + E0j * epsrj) / (E0j - Esh);
+	sigs0j = Fyj * shft + Esh * (epss0j - epsy * shft);
+	epsplj = epsmaxj;
+
+      } else if (konj == 1 && deps < 0.0) {
+	konj = 2;
+	epsrj = epsP[j];
+	sigrj = sigP[j];
+	if (epsP[j] > epsmaxj)
+	  epsmaxj = epsP[j];
+	double d1 = (epsmaxj - epsminj) / (2.0*(a2[j] * epsy));
+	double shft = 1.0 + a1[j] * pow(d1, 0.8);
+	epss0j = (-Fyj * shft + Esh * epsy * shft - sigrj + E0j * epsrj) / (E0j - Esh);
+	sigs0j = -Fyj * shft + Esh * (epss0j + epsy * shft);
+	epsplj = epsminj;
+      }
+
+      double xi     = fabs((epsplj-epss0j)/epsy);
+      double R      = R0[j]*(1.0 - (cR1[j]*xi)/(cR2[j]+xi));
+      double epsrat = (epsj-epsrj)/(epss0j-epsrj);
+      double dum1  = 1.0 + pow(fabs(epsrat),R);
+      double dum2  = pow(dum1,(1/R));
+
+      sig   = bj*epsrat +(1.0-bj)*epsrat/dum2;
+      sig   = sig*(sigs0j-sigrj)+sigrj;
+
+      e = bj + (1.0-bj)/(dum1*dum2);
+      e = e*(sigs0j-sigrj)/(epss0j-epsrj);
+    }
+
+    epsmax[j] = epsmaxj;
+    epsmin[j] = epsminj;
+    epspl[j] = epsplj;
+    epss0[j] = epss0j;
+    sigs0[j] = sigs0j;
+    epsr[j] = epsrj;
+    sigr[j] = sigrj;
+    kon[j] = konj;
+    eps[j] = epsj;
+    stress[j] = sig;
+    tangent[j] = e;
+
+    sumFiber<NC>(ay[j], NC == 2 ? az[j] : 0.0, area[j], sig, e, kSum, sSum);
+  }
+
+  addSums(kSum, sSum, k, s);
+  return 0;
+}
+
+
+// Concrete01, as in Concrete01::setTrial()
+class FiberBatch::Concrete01Group : public FiberBatch::Group
+{
+  public:
+    void getState(void)
+    {
+      int n = this->size();
+      fpc.resize(n); epsc0.resize(n); fpcu.resize(n); epscu.resize(n);
+      CminStrain.resize(n); CunloadSlope.resize(n); CendStrain.resize(n);
+      Cstrain.resize(n); Cstress.resize(n); Ctangent.resize(n);
+      EnergyP.resize(n);
+      TminStrain.resize(n); TunloadSlope.resize(n); TendStrain.resize(n);
+      Tstrain.resize(n);
+      stress.resize(n); tangent.resize(n);
+
+      for (int j = 0; j < n; j++) {
+	Concrete01 *theMat = static_cast<Concrete01 *>(theMaterials[j]);
+	fpc[j] = theMat->par->fpc; epsc0[j] = theMat->par->epsc0;
+	fpcu[j] = theMat->par->fpcu; epscu[j] = theMat->par->epscu;
+
+	CminStrain[j] = theMat->CminStrain;
+	CunloadSlope[j] = theMat->CunloadSlope;
+	CendStrain[j] = theMat->CendStrain;
+	Cstrain[j] = theMat->Cstrain;
+	Cstress[j] = theMat->Cstress;
+	Ctangent[j] = theMat->Ctangent;
+	EnergyP[j] = theMat->EnergyP;
+
+	TminStrain[j] = theMat->TminStrain;
+	TunloadSlope[j] = theMat->TunloadSlope;
+	TendStrain[j] = theMat->TendStrain;
+	Tstrain[j] = theMat->Tstrain;
+	stress[j] = theMat->Tstress;
+	tangent[j] = theMat->Ttangent;
+      }
+    }
+
+    void putState(void)
+    {
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	Concrete01 *theMat = static_cast<Concrete01 *>(theMaterials[j]);
+	theMat->CminStrain = CminStrain[j];
+	theMat->CunloadSlope = CunloadSlope[j];
+	theMat->CendStrain = CendStrain[j];
+	theMat->Cstrain = Cstrain[j];
+	theMat->Cstress = Cstress[j];
+	theMat->Ctangent = Ctangent[j];
+	theMat->EnergyP = EnergyP[j];
+
+	theMat->TminStrain = TminStrain[j];
+	theMat->TunloadSlope = TunloadSlope[j];
+	theMat->TendStrain = TendStrain[j];
+	theMat->Tstrain = Tstrain[j];
+	theMat->Tstress = stress[j];
+	theMat->Ttangent = tangent[j];
+      }
+    }
+
+    int setTrial(int numCoords, const double *d, double *k, double *s)
+    {
+      if (numCoords == 1)
+	return this->trial<1>(d, k, s);
+      else
+	return this->trial<2>(d, k, s);
+    }
+
+    int commitState(void)
+    {
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	CminStrain[j] = TminStrain[j];
+	CunloadSlope[j] = TunloadSlope[j];
+	CendStrain[j] = TendStrain[j];
+
+	EnergyP[j] += 0.5*(Cstress[j] + stress[j])*(Tstrain[j] - Cstrain[j]);
+
+	Cstrain[j] = Tstrain[j];
+	Cstress[j] = stress[j];
+	Ctangent[j] = tangent[j];
+      }
+      return 0;
+    }
+
+    int revertToLastCommit(void)
+    {
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	TminStrain[j] = CminStrain[j];
+	TendStrain[j] = CendStrain[j];
+	TunloadSlope[j] = CunloadSlope[j];
+
+	Tstrain[j] = Cstrain[j];
+	stress[j] = Cstress[j];
+	tangent[j] = Ctangent[j];
+      }
+      return 0;
+    }
+
+  private:
+    template <int NC> int trial(const double *d, double *k, double *s);
+
+    std::vector<double> fpc, epsc0, fpcu, epscu;
+    std::vector<double> CminStrain, CunloadSlope, CendStrain;
+    std::vector<double> Cstrain, Cstress, Ctangent, EnergyP;
+    std::vector<double> TminStrain, TunloadSlope, TendStrain, Tstrain;
+};
+
+template <int NC>
+int
+FiberBatch::Concrete01Group::trial(const double *d, double *k, double *s)
+{
+  double kSum[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  double sSum[3] = {0.0, 0.0, 0.0};
+
+  int n = this->size();
+  for (int j = 0; j < n; j++) {
+    double strain = d[0] + ay[j]*d[1];
+    if (NC == 2)
+      strain += az[j]*d[2];
+
+    // reset the trial state to the last committed state
+    double minStrain = CminStrain[j];
+    double endStrain = CendStrain[j];
+    double unloadSlope = CunloadSlope[j];
+    double sig = Cstress[j];
+    double tan = Ctangent[j];
+    double eps = Cstrain[j];
+
+    double dStrain = strain - Cstrain[j];
+
+    if (fabs(dStrain) >= DBL_EPSILON) {
+      eps = strain;
+
+      if (eps > 0.0) {
+	sig = 0.0;
+	tan = 0.0;
+
+      } else {
+	double tempStress = Cstress[j] + unloadSlope*eps - unloadSlope*Cstrain[j];
+
+	// material goes further into compression
+	if (strain <= Cstrain[j]) {
+
+	  // reload
+	  if (eps <= minStrain) {
+	    minStrain = eps;
+
+	    // point on the envelope
+	    double fpcj = fpc[j];
+	    double epsc0j = epsc0[j];
+	    double epscuj = epscu[j];
+	    if (eps > epsc0j) {
+	      double eta = eps/epsc0j;
+	      sig = fpcj*(2*eta-eta*eta);
+	      double Ec0 = 2.0*fpcj/epsc0j;
+	      tan = Ec0*(1.0-eta);
+	    }
+	    else if (eps > epscuj) {
+	      tan = (fpcj-fpcu[j])/(epsc0j-epscuj);
+	      sig = fpcj + tan*(eps-epsc0j);
+	    }
+	    else {
+	      sig = fpcu[j];
+	      tan = 0.0;
+	    }
+
+	    // unload
+	    double tempStrain = minStrain;
+	    if (tempStrain < epscuj)
+	      tempStrain = epscuj;
+	    double eta = tempStrain/epsc0j;
+	    double ratio = 0.707*(eta-2.0) + 0.834;
+	    if (eta < 2.0)
+	      ratio = 0.145*eta*eta + 0.13*eta;
+	    endStrain = ratio*epsc0j;
+
+	    double temp1 = minStrain - endStrain;
+	    double Ec0 = 2.0*fpcj/epsc0j;
+	    double temp2 = sig/Ec0;
+	    if (temp1 > -DBL_EPSILON) {
+	      unloadSlope = Ec0;
+	    }
+	    else if (temp1 <= temp2) {
+	      endStrain = minStrain - temp1;
+	      unloadSlope = sig/temp1;
+	    }
+	    else {
+	      endStrain = minStrain - temp2;
+	      unloadSlope = Ec0;
+	    }
+	  }
+	  else if (eps <= endStrain) {
+	    tan = unloadSlope;
+	    sig = tan*(eps-endStrain);
+	  }
+	  else {
+	    sig = 0.0;
+	    tan = 0.0;
+	  }
+
+	  if (tempStress > sig) {
+	    sig = tempStress;
+	    tan = unloadSlope;
+	  }
+	}
+
+	// material goes toward tension
+	else if (tempStress <= 0.0) {
+	  sig = tempStress;
+	  tan = unloadSlope;
+	}
+
+	// made it into tension
+	else {
+	  sig = 0.0;
+	  tan = 0.0;
+	}
+      }
+    }
+
+    TminStrain[j] = minStrain;
+    TendStrain[j] = endStrain;
+    TunloadSlope[j] = unloadSlope;
+    Tstrain[j] = eps;
+    stress[j] = sig;
+    tangent[j] = tan;
+
+    sumFiber<NC>(ay[j], NC == 2 ? az[j] : 0.0, area[j], sig, tan, kSum, sSum);
+  }
+
+  addSums(kSum, sSum, k, s);
+  return 0;
+}
+
+
+// Concrete02, as in Concrete02::setTrialStrain()
+class FiberBatch::Concrete02Group : public FiberBatch::Group
+{
+  public:
+    void getState(void)
+    {
+      int n = this->size();
+      fc.resize(n); epsc0.resize(n); fcu.resize(n); epscu.resize(n);
+      rat.resize(n); ft.resize(n); Ets.resize(n);
+      ecminP.resize(n); deptP.resize(n); epsP.resize(n); sigP.resize(n);
+      eP.resize(n);
+      ecmin.resize(n); dept.resize(n); eps.resize(n);
+      stress.resize(n); tangent.resize(n);
+#ifdef _CSS
+      EnergyP.resize(n);
+#endif
+
+      for (int j = 0; j < n; j++) {
+	Concrete02 *theMat = static_cast<Concrete02 *>(theMaterials[j]);
+	fc[j] = theMat->par->fc; epsc0[j] = theMat->par->epsc0;
+	fcu[j] = theMat->par->fcu; epscu[j] = theMat->par->epscu;
+	rat[j] = theMat->par->rat; ft[j] = theMat->par->ft; Ets[j] = theMat->par->Ets;
+
+	ecminP[j] = theMat->ecminP; deptP[j] = theMat->deptP;
+	epsP[j] = theMat->epsP; sigP[j] = theMat->sigP; eP[j] = theMat->eP;
+#ifdef _CSS
+	EnergyP[j] = theMat->EnergyP;
+#endif
+
+	ecmin[j] = theMat->ecmin; dept[j] = theMat->dept;
+	eps[j] = theMat->eps;
+	stress[j] = theMat->sig; tangent[j] = theMat->e;
+      }
+    }
+
+    void putState(void)
+    {
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	Concrete02 *theMat = static_cast<Concrete02 *>(theMaterials[j]);
+	theMat->ecminP = ecminP[j]; theMat->deptP = deptP[j];
+	theMat->epsP = epsP[j]; theMat->sigP = sigP[j]; theMat->eP = eP[j];
+#ifdef _CSS
+	theMat->EnergyP = EnergyP[j];
+#endif
+
+	theMat->ecmin = ecmin[j]; theMat->dept = dept[j];
+	theMat->eps = eps[j];
+	theMat->sig = stress[j]; theMat->e = tangent[j];
+      }
+    }
+
+    int setTrial(int numCoords, const double *d, double *k, double *s)
+    {
+      if (numCoords == 1)
+	return this->trial<1>(d, k, s);
+      else
+	return this->trial<2>(d, k, s);
+    }
+
+    int commitState(void)
+    {
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	ecminP[j] = ecmin[j];
+	deptP[j] = dept[j];
+#ifdef _CSS
+	EnergyP[j] += 0.5 * (sigP[j] + stress[j]) * (eps[j] - epsP[j]);
+#endif
+	eP[j] = tangent[j];
+	sigP[j] = stress[j];
+	epsP[j] = eps[j];
+      }
+      return 0;
+    }
+
+    int revertToLastCommit(void)
+    {
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	ecmin[j] = ecminP[j];
+	dept[j] = deptP[j];
+	tangent[j] = eP[j];
+	stress[j] = sigP[j];
+	eps[j] = epsP[j];
+      }
+      return 0;
+    }
+
+  private:
+    template <int NC> int trial(const double *d, double *k, double *s);
+
+    // the envelopes of Concrete02::Compr_Envlp() and Tens_Envlp()
+    inline void comprEnvlp(int j, double epsc, double &sigc, double &Ect)
+    {
+      double Ec0  = 2.0*fc[j]/epsc0[j];
+
+      double ratLocal = epsc/epsc0[j];
+      if (epsc>=epsc0[j]) {
+	sigc = fc[j]*ratLocal*(2.0-ratLocal);
+	Ect  = Ec0*(1.0-ratLocal);
+      } else {
+	if (epsc>epscu[j]) {
+	  sigc = (fcu[j]-fc[j])*(epsc-epsc0[j])/(epscu[j]-epsc0[j])+fc[j];
+	  Ect  = (fcu[j]-fc[j])/(epscu[j]-epsc0[j]);
+	} else {
+	  sigc = fcu[j];
+	  Ect  = 1.0e-10;
+	}
+      }
+    }
+
+    inline void tensEnvlp(int j, double epsc, double &sigc, double &Ect)
+    {
+      double Ec0  = 2.0*fc[j]/epsc0[j];
+
+      double eps0 = ft[j]/Ec0;
+      double epsu = ft[j]*(1.0/Ets[j]+1.0/Ec0);
+      if (epsc<=eps0) {
+	sigc = epsc*Ec0;
+	Ect  = Ec0;
+      } else {
+	if (epsc<=epsu) {
+	  Ect  = -Ets[j];
+	  sigc = ft[j]-Ets[j]*(epsc-eps0);
+	} else {
+	  Ect  = 1.0e-10;
+	  sigc = 0.0;
+	}
+      }
+    }
+
+    std::vector<double> fc, epsc0, fcu, epscu, rat, ft, Ets;
+    std::vector<double> ecminP, deptP, epsP, sigP, eP;
+    std::vector<double> ecmin, dept, eps;
+#ifdef _CSS
+    std::vector<double> EnergyP;
+#endif
+};
+
+template <int NC>
+int
+FiberBatch::Concrete02Group::trial(const double *d, double *k, double *s)
+{
+  double kSum[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  double sSum[3] = {0.0, 0.0, 0.0};
+
+  int n = this->size();
+  for (int j = 0; j < n; j++) {
+    double strain = d[0] + ay[j]*d[1];
+    if (NC == 2)
+      strain += az[j]*d[2];
+
+    double ec0 = fc[j] * 2. / epsc0[j];
+
+    double ecminj = ecminP[j];
+    double deptj = deptP[j];
+    double epsj = strain;
+    double deps = epsj - epsP[j];
+
+    // the stress and tangent stay those of the last trial
+    double sig = stress[j];
+    double e = tangent[j];
+
+    if (fabs(deps) >= DBL_EPSILON) {
+
+      if (epsj < ecminj) {
+	this->comprEnvlp(j, epsj, sig, e);
+	ecminj = epsj;
+      } else {
+	double epsr = (fcu[j] - rat[j] * ec0 * epscu[j]) / (ec0 * (1.0 - rat[j]));
+	double sigmr = ec0 * epsr;
+
+	double sigmm;
+	double dumy;
+	this->comprEnvlp(j, ecminj, sigmm, dumy);
+
+	double er = (sigmm - sigmr) / (ecminj - epsr);
+	double ept = ecminj - sigmm / er;
+
+	if (epsj <= ept) {
+	  double sigmin = sigmm + er * (epsj - ecminj);
+	  double sigmax = er * .5f * (epsj - ept);
+	  sig = sigP[j] + ec0 * deps;
+	  e = ec0;
+	  if (sig <= sigmin) {
+	    sig = sigmin;
+	    e = er;
+	  }
+	  if (sig >= sigmax) {
+	    sig = sigmax;
+	    e = 0.5 * er;
+	  }
+	} else {
+	  double epn = ept + deptj;
+	  double sicn;
+	  if (epsj <= epn) {
+	    this->tensEnvlp(j, deptj, sicn, e);
+	    if (deptj != 0.0) {
+	      e = sicn / deptj;
+	    } else {
+	      e = ec0;
+	    }
+	    sig = e * (epsj - ept);
+	  } else {
+	    double epstmp = epsj - ept;
+	    this->tensEnvlp(j, epstmp, sig, e);
+	    deptj = epsj - ept;
+	  }
+	}
+      }
+    }
+
+    ecmin[j] = ecminj;
+    dept[j] = deptj;
+    eps[j] = epsj;
+    stress[j] = sig;
+    tangent[j] = e;
+
+    sumFiber<NC>(ay[j], NC == 2 ? az[j] : 0.0, area[j], sig, e, kSum, sSum);
+  }
+
+  addSums(kSum, sSum, k, s);
+  return 0;
+}
+
+
+// ElasticMaterial, as in ElasticMaterial::setTrial() with no strain rate
+class FiberBatch::ElasticGroup : public FiberBatch::Group
+{
+  public:
+    void getState(void)
+    {
+      int n = this->size();
+      Epos.resize(n); Eneg.resize(n); eta.resize(n);
+      trialStrain.resize(n); trialStrainRate.resize(n);
+      committedStrain.resize(n);
+      stress.resize(n); tangent.resize(n);
+
+      for (int j = 0; j < n; j++) {
+	ElasticMaterial *theMat = static_cast<ElasticMaterial *>(theMaterials[j]);
+	Epos[j] = theMat->Epos;
+	Eneg[j] = theMat->Eneg;
+	eta[j] = theMat->eta;
+	trialStrain[j] = theMat->trialStrain;
+	trialStrainRate[j] = theMat->trialStrainRate;
+	committedStrain[j] = theMat->committedStrain;
+	this->response(j);
+      }
+    }
+
+    void putState(void)
+    {
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	ElasticMaterial *theMat = static_cast<ElasticMaterial *>(theMaterials[j]);
+	theMat->trialStrain = trialStrain[j];
+	theMat->trialStrainRate = trialStrainRate[j];
+	theMat->committedStrain = committedStrain[j];
+      }
+    }
+
+    int setTrial(int numCoords, const double *d, double *k, double *s)
+    {
+      if (numCoords == 1)
+	return this->trial<1>(d, k, s);
+      else
+	return this->trial<2>(d, k, s);
+    }
+
+    // the state of an elastic material is its strain
+    int commitState(void)
+    {
+      committedStrain = trialStrain;
+      return 0;
+    }
+
+    int revertToLastCommit(void)
+    {
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	trialStrain[j] = committedStrain[j];
+	this->response(j);
+      }
+      return 0;
+    }
+
+  private:
+    template <int NC> int trial(const double *d, double *k, double *s);
+
+    void response(int j)
+    {
+      if (trialStrain[j] >= 0.0) {
+	stress[j] = Epos[j]*trialStrain[j] + eta[j]*trialStrainRate[j];
+	tangent[j] = Epos[j];
+      } else {
+	stress[j] = Eneg[j]*trialStrain[j] + eta[j]*trialStrainRate[j];
+	tangent[j] = Eneg[j];
+      }
+    }
+
+    std::vector<double> Epos, Eneg, eta;
+    std::vector<double> trialStrain, trialStrainRate, committedStrain;
+};
+
+template <int NC>
+int
+FiberBatch::ElasticGroup::trial(const double *d, double *k, double *s)
+{
+  double kSum[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  double sSum[3] = {0.0, 0.0, 0.0};
+
+  int n = this->size();
+  for (int j = 0; j < n; j++) {
+    double strain = d[0] + ay[j]*d[1];
+    if (NC == 2)
+      strain += az[j]*d[2];
+
+    double E = (strain >= 0.0) ? Epos[j] : Eneg[j];
+    double sig = E*strain;
+
+    trialStrain[j] = strain;
+    trialStrainRate[j] = 0.0;
+    stress[j] = sig;
+    tangent[j] = E;
+
+    sumFiber<NC>(ay[j], NC == 2 ? az[j] : 0.0, area[j], sig, E, kSum, sSum);
+  }
+
+  addSums(kSum, sSum, k, s);
+  return 0;
+}
+
+
+// the fibers in an elastic range, of any material; the materials hold
+// their own state, given their trial strain by putState() and set
+// through setTrial() only for a fiber out of range
+class FiberBatch::ElasticRangeGroup : public FiberBatch::Group
+{
+  public:
+    ElasticRangeGroup()
+      :haveTrial(false), materialsBehind(false), numOutside(0),
+       rangeChanged(false)
+    {
+    }
+
+    void getState(void)
+    {
+      int n = this->size();
+      strainMin.resize(n); strainMax.resize(n);
+      sigma0.resize(n); E.resize(n);
+      stress.resize(n); tangent.resize(n);
+
+      for (int i = 0; i < 6; i++)
+	kLinear[i] = 0.0;
+      for (int i = 0; i < 3; i++)
+	sLinear[i] = 0.0;
+
+      for (int j = 0; j < n; j++) {
+	if (inElasticRange(theMaterials[j], strainMin[j], strainMax[j],
+			   sigma0[j], E[j]) == false) {
+	  // no longer in range, always set through its material
+	  strainMin[j] = DBL_MAX;
+	  strainMax[j] = -DBL_MAX;
+	  sigma0[j] = 0.0;
+	  E[j] = 0.0;
+	}
+	sumFiber<2>(ay[j], az[j], area[j], sigma0[j], E[j], kLinear, sLinear);
+      }
+
+      haveTrial = false;
+      materialsBehind = false;
+      numOutside = 0;
+      rangeChanged = false;
+    }
+
+    void putState(void)
+    {
+      if (materialsBehind == false)
+	return;
+
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	double strain = d[0] + ay[j]*d[1] + az[j]*d[2];
+	theMaterials[j]->setTrialStrain(strain);
+      }
+      materialsBehind = false;
+    }
+
+    int setTrial(int numCoords, const double *dTrial, double *k, double *s)
+    {
+      d[0] = dTrial[0];
+      d[1] = dTrial[1];
+      d[2] = (numCoords == 2) ? dTrial[2] : 0.0;
+      haveTrial = true;
+      materialsBehind = true;
+
+      if (numCoords == 1)
+	return this->trial<1>(k, s);
+      else
+	return this->trial<2>(k, s);
+    }
+
+    int commitState(void)
+    {
+      this->putState();
+
+      int err = 0;
+      int n = this->size();
+      for (int j = 0; j < n; j++)
+	err += theMaterials[j]->commitState();
+
+      // a range may move with the committed state while the strain stays
+      // in it, that of a Steel01 with isotropic hardening at a reversal
+      for (int j = 0; j < n && rangeChanged == false; j++) {
+	if (strainMin[j] > strainMax[j])
+	  continue;
+	double min, max, s0, tan;
+	if (inElasticRange(theMaterials[j], min, max, s0, tan) == false ||
+	    min != strainMin[j] || max != strainMax[j] ||
+	    s0 != sigma0[j] || tan != E[j])
+	  rangeChanged = true;
+      }
+      return err;
+    }
+
+    int revertToLastCommit(void)
+    {
+      int err = 0;
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	UniaxialMaterial *theMat = theMaterials[j];
+	err += theMat->revertToLastCommit();
+	stress[j] = theMat->getStress();
+	tangent[j] = theMat->getTangent();
+      }
+
+      haveTrial = false;
+      materialsBehind = false;
+      numOutside = 0;
+      return err;
+    }
+
+    // a fiber out of range or with a range moved at the committed state
+    // is grouped again
+    bool isRegrouped(void)
+    {
+      return (haveTrial == true && numOutside > 0) || rangeChanged == true;
+    }
+
+  private:
+    template <int NC> int trial(double *k, double *s);
+
+    std::vector<double> strainMin, strainMax, sigma0, E;
+    double kLinear[6];              // the sums of the fibers in range,
+    double sLinear[3];              // sLinear those of sigma0
+
+    double d[3];                    // the deformation of the last trial
+    bool haveTrial;
+    bool materialsBehind;
+    int numOutside;                 // fibers out of range at the last trial
+    bool rangeChanged;              // a range has moved at the last commit
+};
+
+template <int NC>
+int
+FiberBatch::ElasticRangeGroup::trial(double *k, double *s)
+{
+  for (int i = 0; i < 6; i++)
+    k[i] += kLinear[i];
+
+  s[0] += sLinear[0] + kLinear[0]*d[0] + kLinear[1]*d[1];
+  s[1] += sLinear[1] + kLinear[1]*d[0] + kLinear[3]*d[1];
+  if (NC == 2) {
+    s[0] += kLinear[2]*d[2];
+    s[1] += kLinear[4]*d[2];
+    s[2] += sLinear[2] + kLinear[2]*d[0] + kLinear[4]*d[1] + kLinear[5]*d[2];
+  }
+
+  // the fibers out of range replace their part of the sums
+  double kSum[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  double sSum[3] = {0.0, 0.0, 0.0};
+
+  int res = 0;
+  numOutside = 0;
+  int n = this->size();
+  for (int j = 0; j < n; j++) {
+    double strain = d[0] + ay[j]*d[1];
+    if (NC == 2)
+      strain += az[j]*d[2];
+
+    if (strain < strainMin[j] || strain > strainMax[j]) {
+      double sig, tan;
+      res += theMaterials[j]->setTrial(strain, sig, tan);
+      sumFiber<NC>(ay[j], NC == 2 ? az[j] : 0.0, area[j],
+		   sig - sigma0[j] - E[j]*strain, tan - E[j], kSum, sSum);
+      numOutside++;
+    }
+  }
+
+  addSums(kSum, sSum, k, s);
+  return res;
+}
+
+
+// the fibers of all other materials, each set through setTrial()
+class FiberBatch::OtherGroup : public FiberBatch::Group
+{
+  public:
+    // the materials hold their own state
+    void getState(void)
+    {
+      int n = this->size();
+      stress.resize(n);
+      tangent.resize(n);
+    }
+
+    void putState(void)
+    {
+    }
+
+    int setTrial(int numCoords, const double *d, double *k, double *s)
+    {
+      int res = 0;
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	double strain = d[0] + ay[j]*d[1];
+	if (numCoords == 2)
+	  strain += az[j]*d[2];
+	res += theMaterials[j]->setTrial(strain, stress[j], tangent[j]);
+      }
+      this->sumFibers(numCoords, k, s);
+      return res;
+    }
+
+    int commitState(void)
+    {
+      int err = 0;
+      int n = this->size();
+      for (int j = 0; j < n; j++)
+	err += theMaterials[j]->commitState();
+      return err;
+    }
+
+    int revertToLastCommit(void)
+    {
+      int err = 0;
+      int n = this->size();
+      for (int j = 0; j < n; j++) {
+	UniaxialMaterial *theMat = theMaterials[j];
+	err += theMat->revertToLastCommit();
+	stress[j] = theMat->getStress();
+	tangent[j] = theMat->getTangent();
+      }
+      return err;
+    }
+};
+
+
+FiberBatch::FiberBatch(int numFibers, UniaxialMaterial **fiberMaterials,
+		       const double *yLocs, const double *zLocs,
+		       const double *areas)
+  :numCoords(zLocs == 0 ? 1 : 2),
+   theMaterials(fiberMaterials, fiberMaterials+numFibers),
+   yLoc(yLocs, yLocs+numFibers), zLoc(numFibers, 0.0),
+   area(areas, areas+numFibers),
+   holdsState(false), materialsBehind(false), trialCurrent(false)
+{
+  if (zLocs != 0)
+    zLoc.assign(zLocs, zLocs+numFibers);
+
+  this->partition();
+}
+
+FiberBatch::~FiberBatch()
+{
+  for (std::size_t g = 0; g < theGroups.size(); g++)
+    delete theGroups[g];
+}
+
+// groups the fibers from the state of their materials
+void
+FiberBatch::partition(void)
+{
+  for (std::size_t g = 0; g < theGroups.size(); g++)
+    delete theGroups[g];
+  theGroups.clear();
+
+  ElasticRangeGroup *inRange = 0;
+  Steel02Group *steel02 = 0;
+  Concrete01Group *concrete01 = 0;
+  Concrete02Group *concrete02 = 0;
+  ElasticGroup *elastic = 0;
+  OtherGroup *others = 0;
+
+  int numFibers = (int)theMaterials.size();
+  for (int i = 0; i < numFibers; i++) {
+    UniaxialMaterial *theMat = theMaterials[i];
+    Group *theGroup = 0;
+
+    double strainMin, strainMax, sigma0, E;
+    if (inElasticRange(theMat, strainMin, strainMax, sigma0, E)) {
+      if (inRange == 0)
+	theGroups.push_back(inRange = new ElasticRangeGroup());
+      theGroup = inRange;
+    }
+    else switch (theMat->getClassTag()) {
+    case MAT_TAG_Steel02:
+      if (steel02 == 0)
+	theGroups.push_back(steel02 = new Steel02Group());
+      theGroup = steel02;
+      break;
+    case MAT_TAG_Concrete01:
+      if (concrete01 == 0)
+	theGroups.push_back(concrete01 = new Concrete01Group());
+      theGroup = concrete01;
+      break;
+    case MAT_TAG_Concrete02:
+      if (concrete02 == 0)
+	theGroups.push_back(concrete02 = new Concrete02Group());
+      theGroup = concrete02;
+      break;
+    case MAT_TAG_ElasticMaterial:
+      if (elastic == 0)
+	theGroups.push_back(elastic = new ElasticGroup());
+      theGroup = elastic;
+      break;
+    default:
+      if (others == 0)
+	theGroups.push_back(others = new OtherGroup());
+      theGroup = others;
+      break;
+    }
+
+    theGroup->addFiber(theMat, yLoc[i], zLoc[i], area[i]);
+  }
+
+  holdsState = false;
+}
+
+int
+FiberBatch::getState(void)
+{
+  for (std::size_t g = 0; g < theGroups.size(); g++)
+    theGroups[g]->getState();
+  holdsState = true;
+  materialsBehind = false;
+  return 0;
+}
+
+int
+FiberBatch::putState(void)
+{
+  if (materialsBehind == false)
+    return 0;
+
+  for (std::size_t g = 0; g < theGroups.size(); g++)
+    theGroups[g]->putState();
+  materialsBehind = false;
+  return 0;
+}
+
+int
+FiberBatch::setTrial(const double *d, double *k, double *s)
+{
+  // nothing has changed since the last trial
+  if (trialCurrent == true && d[0] == trialD[0] && d[1] == trialD[1] &&
+      (numCoords == 1 || d[2] == trialD[2])) {
+    for (int i = 0; i < 6; i++)
+      k[i] = trialK[i];
+    for (int i = 0; i < 3; i++)
+      s[i] = trialS[i];
+    return 0;
+  }
+
+  if (holdsState == false)
+    this->getState();
+
+  for (int i = 0; i < 6; i++)
+    k[i] = 0.0;
+  for (int i = 0; i < 3; i++)
+    s[i] = 0.0;
+
+  int res = 0;
+  for (std::size_t g = 0; g < theGroups.size(); g++)
+    res += theGroups[g]->setTrial(numCoords, d, k, s);
+
+  for (int i = 0; i < numCoords+1; i++)
+    trialD[i] = d[i];
+  for (int i = 0; i < 6; i++)
+    trialK[i] = k[i];
+  for (int i = 0; i < 3; i++)
+    trialS[i] = s[i];
+  trialCurrent = (res == 0);
+
+  materialsBehind = true;
+  return res;
+}
+
+int
+FiberBatch::commitState(void)
+{
+  if (holdsState == false)
+    this->getState();
+
+  // the committed state is written back for the recorders
+  int err = 0;
+  for (std::size_t g = 0; g < theGroups.size(); g++) {
+    err += theGroups[g]->commitState();
+    theGroups[g]->putState();
+  }
+  materialsBehind = false;
+
+  // fibers that have entered or left an elastic range change group, the
+  // sums of the trial are unchanged
+  for (std::size_t g = 0; g < theGroups.size(); g++)
+    if (theGroups[g]->isRegrouped()) {
+      this->partition();
+      break;
+    }
+
+  return err;
+}
+
+int
+FiberBatch::revertToLastCommit(double *k, double *s)
+{
+  if (holdsState == false)
+    this->getState();
+
+  for (int i = 0; i < 6; i++)
+    k[i] = 0.0;
+  for (int i = 0; i < 3; i++)
+    s[i] = 0.0;
+
+  int err = 0;
+  for (std::size_t g = 0; g < theGroups.size(); g++) {
+    err += theGroups[g]->revertToLastCommit();
+    theGroups[g]->sumFibers(numCoords, k, s);
+  }
+
+  materialsBehind = true;
+  trialCurrent = false;
+  return err;
+}
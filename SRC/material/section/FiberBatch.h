@@ -0,0 +1,102 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for FiberBatch.
+// A FiberBatch evaluates the fibers of a FiberSection2d or FiberSection3d
+// a group at a time. The fibers of the Steel02, Concrete01, Concrete02
+// and ElasticMaterial materials are grouped by class, the state of each
+// group held in arrays, one per history variable, that a kernel for the
+// class sweeps without a virtual call per fiber; the fibers of all other
+// materials are left to their own setTrial(). The section stiffness and
+// stress resultants are summed in the same sweep.
+//
+// The fibers whose materials report an elastic range about their
+// committed state, see UniaxialMaterial::getElasticRange(), are grouped
+// apart whatever their class. Their stiffness and the constant part of
+// their resultants are summed once, when the group is formed, so that a
+// trial only checks that their strains remain in range; a fiber that
+// leaves its range is set through its material and its sums corrected.
+// The materials of these fibers are given their trial strain only when
+// their state is needed. The fibers are grouped again at a commit at
+// which a fiber has entered or left its elastic range. A trial with the
+// deformation of the last one returns its sums without any fiber being
+// set.
+//
+// The batch takes the state of the materials the first time it is used
+// and from then on holds it. It writes the state back to the materials
+// at every commitState(), so that they can be recorded, and otherwise
+// only on putState(), which the section invokes before the materials are
+// used on their own. A section whose materials are changed other than
+// through the batch discards it.
+//
+// The strain of fiber i is d0 - y(i) d1 + z(i) d2, y and z measured from
+// the centroid, z 0 in 2d. The stiffness is returned in k as the sums of
+// the fiber tangent times area times {1, -y, z, y*y, -y*z, z*z} and the
+// resultants in s as the sums of the fiber stress times area times
+// {1, -y, z}.
+//
+#ifndef FiberBatch_h
+#define FiberBatch_h
+
+#include <vector>
+
+class UniaxialMaterial;
+
+class FiberBatch
+{
+  public:
+    // zLocs is 0 for a 2d section
+    FiberBatch(int numFibers, UniaxialMaterial **fiberMaterials,
+	       const double *yLocs, const double *zLocs, const double *areas);
+    ~FiberBatch();
+
+    int setTrial(const double *d, double *k, double *s);
+    int commitState(void);
+    int revertToLastCommit(double *k, double *s);
+
+    // writes the state back to the materials
+    int putState(void);
+
+  private:
+    int getState(void);
+    void partition(void);
+
+    class Group;
+    class Steel02Group;
+    class Concrete01Group;
+    class Concrete02Group;
+    class ElasticGroup;
+    class ElasticRangeGroup;
+    class OtherGroup;
+
+    int numCoords;                  // 1 in 2d, 2 in 3d
+    std::vector<UniaxialMaterial *> theMaterials;
+    std::vector<double> yLoc, zLoc, area;
+    std::vector<Group *> theGroups;
+    bool holdsState;
+    bool materialsBehind;           // trial state not yet written back
+
+    double trialD[3];               // the deformation of the last trial
+    double trialK[6];               // and its sums
+    double trialS[3];
+    bool trialCurrent;              // false if they are not known
+};
+
+#endif
@@ -44,9 +44,26 @@
 #include <MaterialResponse.h>
 #include <UniaxialMaterial.h>
 #include <SectionIntegration.h>
+#include <FiberBatch.h>
 #include <elementAPI.h>
-
-ID FiberSection2d::code(2);
+#include <ScratchArena.h>
+
+// the section response codes are the same for all instances
+static int codeData[] = {SECTION_RESPONSE_P, SECTION_RESPONSE_MZ};
+ID FiberSection2d::code(codeData, 2);
+
+// slot of the per-thread fiber location and weight work arrays
+static const int fiberWorkSlot = ScratchArena::newSlot();
+
+// slot of the per-thread initial tangent returned by getInitialTangent()
+namespace {
+struct FiberSection2dInitialTangent {
+  double kInitial[4];
+  Matrix kInitialMatrix;
+  FiberSection2dInitialTangent() :kInitialMatrix(kInitial, 2, 2) {}
+};
+}
+static const int kInitialSlot = ScratchArena::newSlot();
 
 void* OPS_FiberSection2d()
 {
@@ -76,7 +93,8 @@ FiberSection2d::FiberSection2d(int tag, int num, Fiber **fibers, bool compCentro
   SectionForceDeformation(tag, SEC_TAG_FiberSection2d),
   numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
+  sectionIntegr(0), e(2), s(0), ks(0), dedh(2),
+  theBatch(0), batchFibers(true)
 
 {
   if (numFibers > 0) {
@@ -127,8 +145,6 @@ FiberSection2d::FiberSection2d(int tag, int num, Fiber **fibers, bool compCentro
   kData[2] = 0.0;
   kData[3] = 0.0;
 
-  code(0) = SECTION_RESPONSE_P;
-  code(1) = SECTION_RESPONSE_MZ;
 }
 
 // allocate memory for fibers
@@ -136,7 +152,8 @@ FiberSection2d::FiberSection2d(int tag, int num, bool compCentroid):
   SectionForceDeformation(tag, SEC_TAG_FiberSection2d),
   numFibers(0), sizeFibers(num), theMaterials(0), matData(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
+  sectionIntegr(0), e(2), s(0), ks(0), dedh(2),
+  theBatch(0), batchFibers(true)
 {
     if(sizeFibers > 0) {
 	theMaterials = new UniaxialMaterial *[sizeFibers];
@@ -171,8 +188,6 @@ FiberSection2d::FiberSection2d(int tag, int num, bool compCentroid):
     kData[2] = 0.0;
     kData[3] = 0.0;
 
-    code(0) = SECTION_RESPONSE_P;
-    code(1) = SECTION_RESPONSE_MZ;
 }
 
 FiberSection2d::FiberSection2d(int tag, int num, UniaxialMaterial **mats,
@@ -180,7 +195,8 @@ FiberSection2d::FiberSection2d(int tag, int num, UniaxialMaterial **mats,
   SectionForceDeformation(tag, SEC_TAG_FiberSection2d),
   numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
+  sectionIntegr(0), e(2), s(0), ks(0), dedh(2),
+  theBatch(0), batchFibers(true)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -236,8 +252,6 @@ FiberSection2d::FiberSection2d(int tag, int num, UniaxialMaterial **mats,
   kData[2] = 0.0;
   kData[3] = 0.0;
   
-  code(0) = SECTION_RESPONSE_P;
-  code(1) = SECTION_RESPONSE_MZ;
 }
 
 // constructor for blank object that recvSelf needs to be invoked upon
@@ -245,7 +259,8 @@ FiberSection2d::FiberSection2d():
   SectionForceDeformation(0, SEC_TAG_FiberSection2d),
   numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(true),
-  sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
+  sectionIntegr(0), e(2), s(0), ks(0), dedh(2),
+  theBatch(0), batchFibers(true)
 {
   s = new Vector(sData, 2);
   ks = new Matrix(kData, 2, 2);
@@ -258,8 +273,6 @@ FiberSection2d::FiberSection2d():
   kData[2] = 0.0;
   kData[3] = 0.0;
 
-  code(0) = SECTION_RESPONSE_P;
-  code(1) = SECTION_RESPONSE_MZ;
 }
 
 int
@@ -319,6 +332,8 @@ FiberSection2d::addFiber(Fiber &newFiber)
 
   numFibers++;
 
+  this->discardBatch();
+
   ABar += Area;
   QzBar += yLoc*Area;
   
@@ -352,6 +367,59 @@ FiberSection2d::~FiberSection2d()
 
   if (sectionIntegr != 0)
     delete sectionIntegr;
+
+  if (theBatch != 0)
+    delete theBatch;
+}
+
+// the fibers evaluated by material, the batch formed the first time the
+// fibers are set
+FiberBatch *
+FiberSection2d::getBatch(void)
+{
+  if (theBatch != 0 || batchFibers == false || numFibers == 0)
+    return theBatch;
+
+  double *fiberWork = ScratchArena::local().getDoubles(fiberWorkSlot, 2*numFibers);
+  double *fiberLocs = fiberWork;
+  double *fiberArea = &fiberWork[numFibers];
+
+  if (sectionIntegr != 0) {
+    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
+    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+  }  
+  else {
+    for (int i = 0; i < numFibers; i++) {
+      fiberLocs[i] = matData[2*i];
+      fiberArea[i] = matData[2*i+1];
+    }
+  }
+
+  for (int i = 0; i < numFibers; i++)
+    fiberLocs[i] -= yBar;
+
+  theBatch = new FiberBatch(numFibers, theMaterials, fiberLocs, 0, fiberArea);
+
+  return theBatch;
+}
+
+// brings the materials up to date before they are used on their own
+void
+FiberSection2d::putFiberState(void) const
+{
+  if (theBatch != 0)
+    theBatch->putState();
+}
+
+// for materials, or fibers, about to be changed other than by the batch
+void
+FiberSection2d::discardBatch(void)
+{
+  if (theBatch != 0) {
+    theBatch->putState();
+    delete theBatch;
+    theBatch = 0;
+  }
 }
 
 int
@@ -367,39 +435,55 @@ FiberSection2d::setTrialSectionDeformation (const Vector &deforms)
   double d0 = deforms(0);
   double d1 = deforms(1);
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  FiberBatch *batch = this->getBatch();
+  if (batch != 0) {
+    double d[2] = {d0, d1};
+    double kFibers[6], sFibers[3];
+    res += batch->setTrial(d, kFibers, sFibers);
 
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
+    kData[0] = kFibers[0];
+    kData[1] = kFibers[1];
+    kData[3] = kFibers[3];
+
+    sData[0] = sFibers[0];
+    sData[1] = sFibers[1];
+  }
   else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
+    double *fiberWork = ScratchArena::local().getDoubles(fiberWorkSlot, 2*numFibers);
+    double *fiberLocs = fiberWork;
+    double *fiberArea = &fiberWork[numFibers];
+
+    if (sectionIntegr != 0) {
+      sectionIntegr->getFiberLocations(numFibers, fiberLocs);
+      sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    }  
+    else {
+      for (int i = 0; i < numFibers; i++) {
+        fiberLocs[i] = matData[2*i];
+        fiberArea[i] = matData[2*i+1];
+      }
     }
-  }
   
-  for (int i = 0; i < numFibers; i++) {
-    UniaxialMaterial *theMat = theMaterials[i];
-    double y = fiberLocs[i] - yBar;
-    double A = fiberArea[i];
-
-    // determine material strain and set it
-    double strain = d0 - y*d1;
-    double tangent, stress;
-    res += theMat->setTrial(strain, stress, tangent);
-
-    double ks0 = tangent * A;
-    double ks1 = ks0 * -y;
-    kData[0] += ks0;
-    kData[1] += ks1;
-    kData[3] += ks1 * -y;
-
-    double fs0 = stress * A;
-    sData[0] += fs0;
-    sData[1] += fs0 * -y;
+    for (int i = 0; i < numFibers; i++) {
+      UniaxialMaterial *theMat = theMaterials[i];
+      double y = fiberLocs[i] - yBar;
+      double A = fiberArea[i];
+
+      // determine material strain and set it
+      double strain = d0 - y*d1;
+      double tangent, stress;
+      res += theMat->setTrial(strain, stress, tangent);
+
+      double ks0 = tangent * A;
+      double ks1 = ks0 * -y;
+      kData[0] += ks0;
+      kData[1] += ks1;
+      kData[3] += ks1 * -y;
+
+      double fs0 = stress * A;
+      sData[0] += fs0;
+      sData[1] += fs0 * -y;
+    }
   }
 
   kData[2] = kData[1];
@@ -416,12 +500,14 @@ FiberSection2d::getSectionDeformation(void)
 const Matrix&
 FiberSection2d::getInitialTangent(void)
 {
-  static double kInitial[4];
-  static Matrix kInitialMatrix(kInitial, 2, 2);
+  FiberSection2dInitialTangent &theWork = ScratchArena::local().get<FiberSection2dInitialTangent>(kInitialSlot);
+  double *kInitial = theWork.kInitial;
+  Matrix &kInitialMatrix = theWork.kInitialMatrix;
   kInitial[0] = 0.0; kInitial[1] = 0.0; kInitial[2] = 0.0; kInitial[3] = 0.0;
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  double *fiberWork = ScratchArena::local().getDoubles(fiberWorkSlot, 2*numFibers);
+  double *fiberLocs = fiberWork;
+  double *fiberArea = &fiberWork[numFibers];
   
   if (sectionIntegr != 0) {
     sectionIntegr->getFiberLocations(numFibers, fiberLocs);
@@ -468,6 +554,8 @@ FiberSection2d::getStressResultant(void)
 SectionForceDeformation*
 FiberSection2d::getCopy(void)
 {
+  this->putFiberState();
+
   FiberSection2d *theCopy = new FiberSection2d ();
   theCopy->setTag(this->getTag());
 
@@ -524,6 +612,17 @@ FiberSection2d::getCopy(void)
   return theCopy;
 }
 
+bool
+FiberSection2d::isReentrant(void) const
+{
+  // the section keeps its work storage per thread; its fibers decide
+  for (int i = 0; i < numFibers; i++)
+    if (theMaterials[i]->isReentrant() == false)
+      return false;
+
+  return true;
+}
+
 const ID&
 FiberSection2d::getType ()
 {
@@ -541,8 +640,12 @@ FiberSection2d::commitState(void)
 {
   int err = 0;
 
-  for (int i = 0; i < numFibers; i++)
-    err += theMaterials[i]->commitState();
+  FiberBatch *batch = this->getBatch();
+  if (batch != 0)
+    err += batch->commitState();
+  else
+    for (int i = 0; i < numFibers; i++)
+      err += theMaterials[i]->commitState();
 
   return err;
 }
@@ -555,40 +658,55 @@ FiberSection2d::revertToLastCommit(void)
   kData[0] = 0.0; kData[1] = 0.0; kData[2] = 0.0; kData[3] = 0.0;
   sData[0] = 0.0; sData[1] = 0.0;
   
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
-    }
-  }
+  FiberBatch *batch = this->getBatch();
+  if (batch != 0) {
+    double kFibers[6], sFibers[3];
+    err += batch->revertToLastCommit(kFibers, sFibers);
 
-  for (int i = 0; i < numFibers; i++) {
-    UniaxialMaterial *theMat = theMaterials[i];
-    double y = fiberLocs[i] - yBar;
-    double A = fiberArea[i];
+    kData[0] = kFibers[0];
+    kData[1] = kFibers[1];
+    kData[3] = kFibers[3];
 
-    // invoke revertToLast on the material
-    err += theMat->revertToLastCommit();
+    sData[0] = sFibers[0];
+    sData[1] = sFibers[1];
+  }
+  else {
+    double *fiberWork = ScratchArena::local().getDoubles(fiberWorkSlot, 2*numFibers);
+    double *fiberLocs = fiberWork;
+    double *fiberArea = &fiberWork[numFibers];
 
-    // get material stress & tangent for this strain and determine ks and fs
-    double tangent = theMat->getTangent();
-    double stress = theMat->getStress();
-    double ks0 = tangent * A;
-    double ks1 = ks0 * -y;
-    kData[0] += ks0;
-    kData[1] += ks1;
-    kData[3] += ks1 * -y;
+    if (sectionIntegr != 0) {
+      sectionIntegr->getFiberLocations(numFibers, fiberLocs);
+      sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    }  
+    else {
+      for (int i = 0; i < numFibers; i++) {
+        fiberLocs[i] = matData[2*i];
+        fiberArea[i] = matData[2*i+1];
+      }
+    }
 
-    double fs0 = stress * A;
-    sData[0] = fs0;
-    sData[1] = fs0 * -y;
+    for (int i = 0; i < numFibers; i++) {
+      UniaxialMaterial *theMat = theMaterials[i];
+      double y = fiberLocs[i] - yBar;
+      double A = fiberArea[i];
+
+      // invoke revertToLast on the material
+      err += theMat->revertToLastCommit();
+
+      // get material stress & tangent for this strain and determine ks and fs
+      double tangent = theMat->getTangent();
+      double stress = theMat->getStress();
+      double ks0 = tangent * A;
+      double ks1 = ks0 * -y;
+      kData[0] += ks0;
+      kData[1] += ks1;
+      kData[3] += ks1 * -y;
+
+      double fs0 = stress * A;
+      sData[0] = fs0;
+      sData[1] = fs0 * -y;
+    }
   }
 
   kData[2] = kData[1];
@@ -599,14 +717,17 @@ FiberSection2d::revertToLastCommit(void)
 int
 FiberSection2d::revertToStart(void)
 {
+  this->discardBatch();
+
   // revert the fibers to start    
   int err = 0;
 
   kData[0] = 0.0; kData[1] = 0.0; kData[2] = 0.0; kData[3] = 0.0;
   sData[0] = 0.0; sData[1] = 0.0;
   
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  double *fiberWork = ScratchArena::local().getDoubles(fiberWorkSlot, 2*numFibers);
+  double *fiberLocs = fiberWork;
+  double *fiberArea = &fiberWork[numFibers];
 
   if (sectionIntegr != 0) {
     sectionIntegr->getFiberLocations(numFibers, fiberLocs);
@@ -651,6 +772,8 @@ FiberSection2d::sendSelf(int commitTag, Channel &theChannel)
 {
   int res = 0;
 
+  this->putFiberState();
+
   // create an id to send objects tag and numFibers, 
   //     size 7 so no conflict with matData below if 3 fibers
   static ID data(7);
@@ -734,6 +857,8 @@ FiberSection2d::recvSelf(int commitTag, Channel &theChannel,
 {
   int res = 0;
 
+  this->discardBatch();
+
   static ID data(7);
   
   int dbTag = this->getDbTag();
@@ -888,6 +1013,8 @@ FiberSection2d::recvSelf(int commitTag, Channel &theChannel,
 void
 FiberSection2d::Print(OPS_Stream &s, int flag)
 {
+  this->putFiberState();
+
   if (flag == OPS_PRINT_PRINTMODEL_SECTION || flag == OPS_PRINT_PRINTMODEL_MATERIAL) {
     s << "\nFiberSection2d, tag: " << this->getTag() << endln;
     s << "\tSection code: " << code;
@@ -1110,6 +1237,8 @@ FiberSection2d::setResponse(const char **argv, int argc,
 int 
 FiberSection2d::getResponse(int responseID, Information &sectInfo)
 {
+  this->putFiberState();
+
   if (responseID == 5) {
     int numData = 5*numFibers;
     Vector data(numData);
@@ -1194,6 +1323,11 @@ FiberSection2d::setParameter(const char **argv, int argc, Parameter &param)
   if (argc < 1)
     return -1;
 
+  // the parameters are updated in the materials, and the fibers moved,
+  // directly, so the fibers are no longer batched
+  this->discardBatch();
+  batchFibers = false;
+
   int result = -1;
 
   if (strcmp(argv[0],"fiberIndex") == 0) {
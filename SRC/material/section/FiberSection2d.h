@@ -42,6 +42,7 @@ class UniaxialMaterial;
 class Fiber;
 class Response;
 class SectionIntegration;
+class FiberBatch;
 
 class FiberSection2d : public SectionForceDeformation
 {
@@ -65,6 +66,7 @@ class FiberSection2d : public SectionForceDeformation
     int   commitState(void);
     int   revertToLastCommit(void);    
     int   revertToStart(void);
+    bool  isReentrant(void) const;
  
     SectionForceDeformation *getCopy(void);
     const ID &getType (void);
@@ -122,6 +124,14 @@ class FiberSection2d : public SectionForceDeformation
 // AddingSensitivity:BEGIN //////////////////////////////////////////
     Vector dedh; // MHS hack
 // AddingSensitivity:END ///////////////////////////////////////////
+
+  private:
+    FiberBatch *getBatch(void);
+    void putFiberState(void) const;
+    void discardBatch(void);
+
+    FiberBatch *theBatch;  // fibers evaluated by material, 0 until needed
+    bool batchFibers;      // false once the fibers are parameterized
 };
 
 #endif
@@ -44,10 +44,28 @@
 #include <UniaxialMaterial.h>
 #include <ElasticMaterial.h>
 #include <SectionIntegration.h>
+#include <FiberBatch.h>
 #include <elementAPI.h>
 #include <string.h>
-
-ID FiberSection3d::code(4);
+#include <ScratchArena.h>
+
+// the section response codes are the same for all instances
+static int codeData[] = {SECTION_RESPONSE_P, SECTION_RESPONSE_MZ,
+                         SECTION_RESPONSE_MY, SECTION_RESPONSE_T};
+ID FiberSection3d::code(codeData, 4);
+
+// slot of the per-thread fiber location and weight work arrays
+static const int fiberWorkSlot = ScratchArena::newSlot();
+
+// slot of the per-thread initial tangent returned by getInitialTangent()
+namespace {
+struct FiberSection3dInitialTangent {
+  double kInitialData[16];
+  Matrix kInitial;
+  FiberSection3dInitialTangent() :kInitial(kInitialData, 4, 4) {}
+};
+}
+static const int kInitialSlot = ScratchArena::newSlot();
 
 void* OPS_FiberSection3d()
 {
@@ -116,7 +134,8 @@ FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers,
   SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
   numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0),
+  theBatch(0), batchFibers(true)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -176,17 +195,14 @@ FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers,
   for (int i=0; i<16; i++)
     kData[i] = 0.0;
 
-  code(0) = SECTION_RESPONSE_P;
-  code(1) = SECTION_RESPONSE_MZ;
-  code(2) = SECTION_RESPONSE_MY;
-  code(3) = SECTION_RESPONSE_T;
 }
 
 FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial &torsion, bool compCentroid): 
     SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
     numFibers(0), sizeFibers(num), theMaterials(0), matData(0),
     QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-    sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+    sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0),
+  theBatch(0), batchFibers(true)
 {
     if(sizeFibers != 0) {
 	theMaterials = new UniaxialMaterial *[sizeFibers];
@@ -226,10 +242,6 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial &torsion, bool
     for (int i=0; i<16; i++)
 	kData[i] = 0.0;
 
-    code(0) = SECTION_RESPONSE_P;
-    code(1) = SECTION_RESPONSE_MZ;
-    code(2) = SECTION_RESPONSE_MY;
-    code(3) = SECTION_RESPONSE_T;
 }
 
 FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
@@ -238,7 +250,8 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
   SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
   numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0),
+  theBatch(0), batchFibers(true)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -300,10 +313,6 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
   for (int i = 0; i < 16; i++)
     kData[i] = 0.0;
   
-  code(0) = SECTION_RESPONSE_P;
-  code(1) = SECTION_RESPONSE_MZ;
-  code(2) = SECTION_RESPONSE_MY;
-  code(3) = SECTION_RESPONSE_T;
 }
 
 // constructor for blank object that recvSelf needs to be invoked upon
@@ -311,7 +320,8 @@ FiberSection3d::FiberSection3d():
   SectionForceDeformation(0, SEC_TAG_FiberSection3d),
   numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(true),
-  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0),
+  theBatch(0), batchFibers(true)
 {
   s = new Vector(sData, 4);
   ks = new Matrix(kData, 4, 4);
@@ -324,10 +334,6 @@ FiberSection3d::FiberSection3d():
   for (int i=0; i<16; i++)
     kData[i] = 0.0;
 
-  code(0) = SECTION_RESPONSE_P;
-  code(1) = SECTION_RESPONSE_MZ;
-  code(2) = SECTION_RESPONSE_MY;
-  code(3) = SECTION_RESPONSE_T;
 }
 
 int
@@ -388,6 +394,8 @@ FiberSection3d::addFiber(Fiber &newFiber)
 
   numFibers++;
 
+  this->discardBatch();
+
   // Recompute centroid
   if (computeCentroid) {
     Abar  += Area;
@@ -428,6 +436,63 @@ FiberSection3d::~FiberSection3d()
 
   if (theTorsion != 0)
     delete theTorsion;
+
+  if (theBatch != 0)
+    delete theBatch;
+}
+
+// the fibers evaluated by material, the batch formed the first time the
+// fibers are set
+FiberBatch *
+FiberSection3d::getBatch(void)
+{
+  if (theBatch != 0 || batchFibers == false || numFibers == 0)
+    return theBatch;
+
+  double *fiberWork = ScratchArena::local().getDoubles(fiberWorkSlot, 3*numFibers);
+  double *yLocs = fiberWork;
+  double *zLocs = &fiberWork[numFibers];
+  double *fiberArea = &fiberWork[2*numFibers];
+
+  if (sectionIntegr != 0) {
+    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
+    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+  }  
+  else {
+    for (int i = 0; i < numFibers; i++) {
+      yLocs[i] = matData[3*i];
+      zLocs[i] = matData[3*i+1];
+      fiberArea[i] = matData[3*i+2];
+    }
+  }
+
+  for (int i = 0; i < numFibers; i++) {
+    yLocs[i] -= yBar;
+    zLocs[i] -= zBar;
+  }
+
+  theBatch = new FiberBatch(numFibers, theMaterials, yLocs, zLocs, fiberArea);
+
+  return theBatch;
+}
+
+// brings the materials up to date before they are used on their own
+void
+FiberSection3d::putFiberState(void) const
+{
+  if (theBatch != 0)
+    theBatch->putState();
+}
+
+// for materials, or fibers, about to be changed other than by the batch
+void
+FiberSection3d::discardBatch(void)
+{
+  if (theBatch != 0) {
+    theBatch->putState();
+    delete theBatch;
+    theBatch = 0;
+  }
 }
 
 int
@@ -446,53 +511,74 @@ FiberSection3d::setTrialSectionDeformation (const Vector &deforms)
   double d2 = deforms(2);
   double d3 = deforms(3);
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
- 
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
+  double tangent, stress;
+
+  FiberBatch *batch = this->getBatch();
+  if (batch != 0) {
+    double d[3] = {d0, d1, d2};
+    double kFibers[6], sFibers[3];
+    res += batch->setTrial(d, kFibers, sFibers);
+
+    kData[0] = kFibers[0];
+    kData[1] = kFibers[1];
+    kData[2] = kFibers[2];
+    kData[5] = kFibers[3];
+    kData[6] = kFibers[4];
+    kData[10] = kFibers[5];
+
+    sData[0] = sFibers[0];
+    sData[1] = sFibers[1];
+    sData[2] = sFibers[2];
+  }
   else {
+    double *fiberWork = ScratchArena::local().getDoubles(fiberWorkSlot, 3*numFibers);
+    double *yLocs = fiberWork;
+    double *zLocs = &fiberWork[numFibers];
+    double *fiberArea = &fiberWork[2*numFibers];
+ 
+    if (sectionIntegr != 0) {
+      sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
+      sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    }  
+    else {
 	
-    for (int i = 0; i < numFibers; i++) {
+      for (int i = 0; i < numFibers; i++) {
 		
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
+        yLocs[i] = matData[3*i];
+        zLocs[i] = matData[3*i+1];
+        fiberArea[i] = matData[3*i+2];
+      }
     }
-  }
  
-  double tangent, stress;
-  for (int i = 0; i < numFibers; i++) {
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
-
-    // determine material strain and set it
-    double strain = d0 - y*d1 + z*d2;
-    res += theMaterials[i]->setTrial(strain, stress, tangent);
-
-    double value = tangent * A;
-    double vas1 = -y*value;
-    double vas2 = z*value;
-    double vas1as2 = vas1*z;
-
-    kData[0] += value;
-    kData[1] += vas1;
-    kData[2] += vas2;
+    for (int i = 0; i < numFibers; i++) {
+      double y = yLocs[i] - yBar;
+      double z = zLocs[i] - zBar;
+      double A = fiberArea[i];
+
+      // determine material strain and set it
+      double strain = d0 - y*d1 + z*d2;
+      res += theMaterials[i]->setTrial(strain, stress, tangent);
+
+      double value = tangent * A;
+      double vas1 = -y*value;
+      double vas2 = z*value;
+      double vas1as2 = vas1*z;
+
+      kData[0] += value;
+      kData[1] += vas1;
+      kData[2] += vas2;
     
-    kData[5] += vas1 * -y;
-    kData[6] += vas1as2;
+      kData[5] += vas1 * -y;
+      kData[6] += vas1as2;
     
-    kData[10] += vas2 * z; 
+      kData[10] += vas2 * z; 
 
-    double fs0 = stress * A;
+      double fs0 = stress * A;
 
-    sData[0] += fs0;
-    sData[1] += fs0 * -y;
-    sData[2] += fs0 * z;
+      sData[0] += fs0;
+      sData[1] += fs0 * -y;
+      sData[2] += fs0 * z;
+    }
   }
 
   kData[4] = kData[1];
@@ -511,14 +597,16 @@ FiberSection3d::setTrialSectionDeformation (const Vector &deforms)
 const Matrix&
 FiberSection3d::getInitialTangent(void)
 {
-  static double kInitialData[16];
-  static Matrix kInitial(kInitialData, 4, 4);
+  FiberSection3dInitialTangent &theWork = ScratchArena::local().get<FiberSection3dInitialTangent>(kInitialSlot);
+  double *kInitialData = theWork.kInitialData;
+  Matrix &kInitial = theWork.kInitial;
   
   kInitial.Zero();
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
+  double *fiberWork = ScratchArena::local().getDoubles(fiberWorkSlot, 3*numFibers);
+  double *yLocs = fiberWork;
+  double *zLocs = &fiberWork[numFibers];
+  double *fiberArea = &fiberWork[2*numFibers];
 
   if (sectionIntegr != 0) {
     sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
@@ -585,6 +673,8 @@ FiberSection3d::getStressResultant(void)
 SectionForceDeformation*
 FiberSection3d::getCopy(void)
 {
+  this->putFiberState();
+
   FiberSection3d *theCopy = new FiberSection3d ();
   theCopy->setTag(this->getTag());
 
@@ -649,6 +739,20 @@ FiberSection3d::getCopy(void)
   return theCopy;
 }
 
+bool
+FiberSection3d::isReentrant(void) const
+{
+  // the section keeps its work storage per thread; its fibers decide
+  for (int i = 0; i < numFibers; i++)
+    if (theMaterials[i]->isReentrant() == false)
+      return false;
+
+  if (theTorsion != 0 && theTorsion->isReentrant() == false)
+    return false;
+
+  return true;
+}
+
 const ID&
 FiberSection3d::getType ()
 {
@@ -666,8 +770,12 @@ FiberSection3d::commitState(void)
 {
   int err = 0;
 
-  for (int i = 0; i < numFibers; i++)
-    err += theMaterials[i]->commitState();
+  FiberBatch *batch = this->getBatch();
+  if (batch != 0)
+    err += batch->commitState();
+  else
+    for (int i = 0; i < numFibers; i++)
+      err += theMaterials[i]->commitState();
 
   if (theTorsion != 0)
     err += theTorsion->commitState();
@@ -686,52 +794,71 @@ FiberSection3d::revertToLastCommit(void)
   kData[15] = 0.0;
   sData[0] = 0.0; sData[1] = 0.0;  sData[2] = 0.0; sData[3] = 0.0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
+  FiberBatch *batch = this->getBatch();
+  if (batch != 0) {
+    double kFibers[6], sFibers[3];
+    err += batch->revertToLastCommit(kFibers, sFibers);
+
+    kData[0] = kFibers[0];
+    kData[1] = kFibers[1];
+    kData[2] = kFibers[2];
+    kData[5] = kFibers[3];
+    kData[6] = kFibers[4];
+    kData[10] = kFibers[5];
+
+    sData[0] = sFibers[0];
+    sData[1] = sFibers[1];
+    sData[2] = sFibers[2];
+  }
   else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
+    double *fiberWork = ScratchArena::local().getDoubles(fiberWorkSlot, 3*numFibers);
+    double *yLocs = fiberWork;
+    double *zLocs = &fiberWork[numFibers];
+    double *fiberArea = &fiberWork[2*numFibers];
+
+    if (sectionIntegr != 0) {
+      sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
+      sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    }  
+    else {
+      for (int i = 0; i < numFibers; i++) {
+        yLocs[i] = matData[3*i];
+        zLocs[i] = matData[3*i+1];
+        fiberArea[i] = matData[3*i+2];
+      }
     }
-  }
 
-  for (int i = 0; i < numFibers; i++) {
-    UniaxialMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    for (int i = 0; i < numFibers; i++) {
+      UniaxialMaterial *theMat = theMaterials[i];
+      double y = yLocs[i] - yBar;
+      double z = zLocs[i] - zBar;
+      double A = fiberArea[i];
 
-    // invoke revertToLast on the material
-    err += theMat->revertToLastCommit();
+      // invoke revertToLast on the material
+      err += theMat->revertToLastCommit();
 
-    double tangent = theMat->getTangent();
-    double stress = theMat->getStress();
+      double tangent = theMat->getTangent();
+      double stress = theMat->getStress();
 
-    double value = tangent * A;
-    double vas1 = -y*value;
-    double vas2 = z*value;
-    double vas1as2 = vas1*z;
+      double value = tangent * A;
+      double vas1 = -y*value;
+      double vas2 = z*value;
+      double vas1as2 = vas1*z;
 
-    kData[0] += value;
-    kData[1] += vas1;
-    kData[2] += vas2;
+      kData[0] += value;
+      kData[1] += vas1;
+      kData[2] += vas2;
     
-    kData[5] += vas1 * -y;
-    kData[6] += vas1as2;
+      kData[5] += vas1 * -y;
+      kData[6] += vas1as2;
     
-    kData[10] += vas2 * z; 
+      kData[10] += vas2 * z; 
 
-    double fs0 = stress * A;
-    sData[0] += fs0;
-    sData[1] += fs0 * -y;
-    sData[2] += fs0 * z;
+      double fs0 = stress * A;
+      sData[0] += fs0;
+      sData[1] += fs0 * -y;
+      sData[2] += fs0 * z;
+    }
   }
 
   kData[4] = kData[1];
@@ -750,6 +877,8 @@ FiberSection3d::revertToLastCommit(void)
 int
 FiberSection3d::revertToStart(void)
 {
+  this->discardBatch();
+
   // revert the fibers to start    
   int err = 0;
 
@@ -759,9 +888,10 @@ FiberSection3d::revertToStart(void)
   kData[15] = 0.0; 
   sData[0] = 0.0; sData[1] = 0.0;  sData[2] = 0.0; sData[3] = 0.0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
+  double *fiberWork = ScratchArena::local().getDoubles(fiberWorkSlot, 3*numFibers);
+  double *yLocs = fiberWork;
+  double *zLocs = &fiberWork[numFibers];
+  double *fiberArea = &fiberWork[2*numFibers];
 
   if (sectionIntegr != 0) {
     sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
@@ -828,6 +958,8 @@ FiberSection3d::sendSelf(int commitTag, Channel &theChannel)
 {
   int res = 0;
 
+  this->putFiberState();
+
   // create an id to send objects tag and numFibers, 
   static ID data(9);
   data(0) = this->getTag();
@@ -924,6 +1056,8 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
 {
   int res = 0;
 
+  this->discardBatch();
+
   static ID data(9);
   
   int dbTag = this->getDbTag();
@@ -1101,6 +1235,8 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
 void
 FiberSection3d::Print(OPS_Stream &s, int flag)
 {
+  this->putFiberState();
+
   if (flag == OPS_PRINT_PRINTMODEL_SECTION || flag == OPS_PRINT_PRINTMODEL_MATERIAL) {
     s << "\nFiberSection3d, tag: " << this->getTag() << endln;
     s << "\tSection code: " << code;
@@ -1355,6 +1491,8 @@ FiberSection3d::setResponse(const char **argv, int argc, OPS_Stream &output)
 int 
 FiberSection3d::getResponse(int responseID, Information &sectInfo)
 {
+  this->putFiberState();
+
   if (responseID == 5) {
     int numData = 5*numFibers;
     Vector data(numData);
@@ -1434,6 +1572,11 @@ FiberSection3d::setParameter(const char **argv, int argc, Parameter &param)
   if (argc < 1)
     return -1;
 
+  // the parameters are updated in the materials, and the fibers moved,
+  // directly, so the fibers are no longer batched
+  this->discardBatch();
+  batchFibers = false;
+
   int result = -1;
 
   // A material parameter
@@ -42,6 +42,7 @@ class UniaxialMaterial;
 class Fiber;
 class Response;
 class SectionIntegration;
+class FiberBatch;
 
 class FiberSection3d : public SectionForceDeformation
 {
@@ -66,6 +67,7 @@ class FiberSection3d : public SectionForceDeformation
     int   commitState(void);
     int   revertToLastCommit(void);    
     int   revertToStart(void);
+    bool  isReentrant(void) const;
  
     SectionForceDeformation *getCopy(void);
     const ID &getType (void);
@@ -104,6 +106,10 @@ class FiberSection3d : public SectionForceDeformation
   protected:
     
   private:
+    FiberBatch *getBatch(void);
+    void putFiberState(void) const;
+    void discardBatch(void);
+
     int numFibers, sizeFibers;       // number of fibers in the section
     UniaxialMaterial **theMaterials; // array of pointers to materials
     double   *matData;               // data for the materials [yloc, zloc, area]
@@ -124,6 +130,9 @@ class FiberSection3d : public SectionForceDeformation
     Matrix *ks;        // section stiffness
 
     UniaxialMaterial *theTorsion;
+
+    FiberBatch *theBatch;  // fibers evaluated by material, 0 until needed
+    bool batchFibers;      // false once the fibers are parameterized
 };
 
 #endif
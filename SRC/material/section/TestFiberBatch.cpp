@@ -0,0 +1,197 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: a test of FiberBatch against UniaxialMaterial::setTrialStrain().
+// Two sets of the same fibers, of Steel02, Concrete01, Concrete02,
+// ElasticMaterial, Steel01 with and without isotropic hardening and
+// ElasticPPMaterial, are taken through a
+// cyclic deformation history of growing amplitude, with commits, reverts
+// and repeated trials, once by a FiberBatch and once fiber by fiber with
+// setTrialStrain(), getStress() and getTangent(). The stiffness and
+// resultants of the batch must agree with the sums of the fibers at every
+// trial and after a revert, in 2d and 3d, and the materials of the batch
+// must end in the state of the others.
+//
+// Usage: testFiberBatch
+
+#include <StandardStream.h>
+#include <FiberBatch.h>
+#include <UniaxialMaterial.h>
+#include <Steel02.h>
+#include <Steel01.h>
+#include <Concrete01.h>
+#include <Concrete02.h>
+#include <ElasticMaterial.h>
+#include <ElasticPPMaterial.h>
+
+#include <math.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+static const int numFibers = 60;
+
+static UniaxialMaterial *
+fiberMaterial(int i)
+{
+  switch (i % 7) {
+  case 0:
+    return new Steel02(1, 60.0, 29000.0, 0.02, 18.5, 0.925, 0.15);
+  case 1:
+    return new Concrete01(2, -4.0, -0.002, -1.0, -0.006);
+  case 2:
+    return new Concrete02(3, -4.0, -0.002, -1.0, -0.006, 0.1, 0.5, 200.0);
+  case 3:
+    return new ElasticMaterial(4, 3000.0, 0.0, 1500.0);
+  case 4:
+    return new Steel01(5, 60.0, 29000.0, 0.01);
+  case 5:
+    // isotropic hardening, the elastic range moving at each reversal
+    return new Steel01(7, 60.0, 29000.0, 0.01, 0.08, 1.0, 0.08, 1.0);
+  default:
+    return new ElasticPPMaterial(6, 29000.0, 0.002);
+  }
+}
+
+// adds the stiffness and resultants of a fiber as FiberBatch sums them
+static void
+sumFiber(UniaxialMaterial *theMaterial, double y, double z, double A,
+	 double *k, double *s)
+{
+  double sig = theMaterial->getStress()*A;
+  double E = theMaterial->getTangent()*A;
+  k[0] += E; k[1] -= E*y; k[2] += E*z;
+  k[3] += E*y*y; k[4] -= E*y*z; k[5] += E*z*z;
+  s[0] += sig; s[1] -= sig*y; s[2] += sig*z;
+}
+
+// returns the largest relative difference found, the section 2d if
+// numCoords is 1
+static double
+runHistory(int numCoords)
+{
+  UniaxialMaterial *theMaterials[numFibers];
+  UniaxialMaterial *batchMaterials[numFibers];
+  double y[numFibers], z[numFibers], A[numFibers];
+
+  for (int i = 0; i < numFibers; i++) {
+    theMaterials[i] = fiberMaterial(i);
+    batchMaterials[i] = theMaterials[i]->getCopy();
+    y[i] = -12.0 + 0.4*i;
+    z[i] = (numCoords == 2) ? 4.0*sin(1.0*i) : 0.0;
+    A[i] = 0.5 + 0.01*i;
+  }
+
+  FiberBatch theBatch(numFibers, batchMaterials, y, (numCoords == 2) ? z : 0, A);
+
+  double maxDiff = 0.0;
+  const int numSteps = 2400;
+  for (int step = 0; step < numSteps; step++) {
+    // cycles of growing amplitude, the curvatures out of phase with the
+    // axial strain
+    double amp = 0.0005 + 0.006*step/numSteps;
+    double d[3];
+    d[0] = amp*sin(0.02*step);
+    d[1] = 0.0002*amp*sin(0.031*step);
+    d[2] = (numCoords == 2) ? 0.0002*amp*cos(0.017*step) : 0.0;
+
+    // repeated trials from the same committed state
+    int numTrials = (step % 5 == 0) ? 3 : 1;
+    for (int trial = 0; trial < numTrials; trial++) {
+      double dTrial[3];
+      double scale = 1.0 - 0.1*trial;
+      for (int c = 0; c < 3; c++)
+	dTrial[c] = d[c]*scale;
+
+      double k[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+      double s[3] = {0.0, 0.0, 0.0};
+      for (int i = 0; i < numFibers; i++) {
+	double strain = dTrial[0] - y[i]*dTrial[1] + z[i]*dTrial[2];
+	theMaterials[i]->setTrialStrain(strain);
+	sumFiber(theMaterials[i], y[i], z[i], A[i], k, s);
+      }
+
+      double kBatch[6], sBatch[3];
+      theBatch.setTrial(dTrial, kBatch, sBatch);
+
+      for (int c = 0; c < 6; c++)
+	maxDiff = fmax(maxDiff, fabs(k[c]-kBatch[c])/(1.0+fabs(k[c])));
+      for (int c = 0; c < 3; c++)
+	maxDiff = fmax(maxDiff, fabs(s[c]-sBatch[c])/(1.0+fabs(s[c])));
+    }
+
+    if (step % 7 == 3) {
+      double k[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+      double s[3] = {0.0, 0.0, 0.0};
+      for (int i = 0; i < numFibers; i++) {
+	theMaterials[i]->revertToLastCommit();
+	sumFiber(theMaterials[i], y[i], z[i], A[i], k, s);
+      }
+
+      double kBatch[6], sBatch[3];
+      theBatch.revertToLastCommit(kBatch, sBatch);
+
+      for (int c = 0; c < 6; c++)
+	maxDiff = fmax(maxDiff, fabs(k[c]-kBatch[c])/(1.0+fabs(k[c])));
+      for (int c = 0; c < 3; c++)
+	maxDiff = fmax(maxDiff, fabs(s[c]-sBatch[c])/(1.0+fabs(s[c])));
+    } else {
+      for (int i = 0; i < numFibers; i++)
+	theMaterials[i]->commitState();
+      theBatch.commitState();
+    }
+  }
+
+  // the batch has written its committed state back to the materials
+  for (int i = 0; i < numFibers; i++) {
+    UniaxialMaterial *a = theMaterials[i];
+    UniaxialMaterial *b = batchMaterials[i];
+    maxDiff = fmax(maxDiff, fabs(a->getStrain()-b->getStrain()));
+    maxDiff = fmax(maxDiff, fabs(a->getStress()-b->getStress())/(1.0+fabs(a->getStress())));
+    maxDiff = fmax(maxDiff, fabs(a->getTangent()-b->getTangent())/(1.0+fabs(a->getTangent())));
+  }
+
+  for (int i = 0; i < numFibers; i++) {
+    delete theMaterials[i];
+    delete batchMaterials[i];
+  }
+
+  return maxDiff;
+}
+
+int main(int argc, char **argv)
+{
+  const double tol = 1.0e-10;
+  int numFailed = 0;
+
+  for (int numCoords = 1; numCoords <= 2; numCoords++) {
+    double maxDiff = runHistory(numCoords);
+    opserr << (numCoords == 1 ? "2d" : "3d") << " max difference: " << maxDiff << endln;
+    if (!(maxDiff < tol))
+      numFailed++;
+  }
+
+  if (numFailed == 0)
+    opserr << "PASSED\n";
+  else
+    opserr << "FAILED\n";
+
+  return numFailed == 0 ? 0 : -1;
+}
@@ -87,14 +87,10 @@ OPS_Concrete01()
 
 
 
-Concrete01::Concrete01
-(int tag, double FPC, double EPSC0, double FPCU, double EPSCU)
-  :UniaxialMaterial(tag, MAT_TAG_Concrete01),
-   fpc(FPC), epsc0(EPSC0), fpcu(FPCU), epscu(EPSCU), 
-   CminStrain(0.0), CendStrain(0.0),
-   Cstrain(0.0), Cstress(0.0) 
+Concrete01::Parameters::Parameters
+(double FPC, double EPSC0, double FPCU, double EPSCU)
+  :fpc(FPC), epsc0(EPSC0), fpcu(FPCU), epscu(EPSCU)
 {
-	EnergyP = 0;	//SAJalali
   // Make all concrete parameters negative
   if (fpc > 0.0)
     fpc = -fpc;
@@ -107,9 +103,49 @@ Concrete01::Concrete01
   
   if (epscu > 0.0)
     epscu = -epscu;
+}
+
+bool
+Concrete01::Parameters::operator==(const Parameters &other) const
+{
+  return fpc == other.fpc && epsc0 == other.epsc0 &&
+    fpcu == other.fpcu && epscu == other.epscu;
+}
+
+Concrete01::Concrete01
+(int tag, double FPC, double EPSC0, double FPCU, double EPSCU)
+  :UniaxialMaterial(tag, MAT_TAG_Concrete01),
+   par(Parameters(FPC, EPSC0, FPCU, EPSCU)),
+   CminStrain(0.0), CendStrain(0.0),
+   Cstrain(0.0), Cstress(0.0) 
+{
+	EnergyP = 0;	//SAJalali
+  // Initial tangent
+  double Ec0 = 2*par->fpc/par->epsc0;
+  Ctangent = Ec0;
+  CunloadSlope = Ec0;
+  Ttangent = Ec0;
+  
+  // Set trial values
+  this->revertToLastCommit();
   
+  // AddingSensitivity:BEGIN /////////////////////////////////////
+  parameterID = 0;
+  SHVs = 0;
+  // AddingSensitivity:END //////////////////////////////////////
+}
+
+// a copy of a material, sharing its parameters
+Concrete01::Concrete01
+(int tag, const SharedParameters<Parameters> &theParameters)
+  :UniaxialMaterial(tag, MAT_TAG_Concrete01),
+   par(theParameters),
+   CminStrain(0.0), CendStrain(0.0),
+   Cstrain(0.0), Cstress(0.0) 
+{
+  EnergyP = 0;
   // Initial tangent
-  double Ec0 = 2*fpc/epsc0;
+  double Ec0 = 2*par->fpc/par->epsc0;
   Ctangent = Ec0;
   CunloadSlope = Ec0;
   Ttangent = Ec0;
@@ -124,7 +160,6 @@ Concrete01::Concrete01
 }
 
 Concrete01::Concrete01():UniaxialMaterial(0, MAT_TAG_Concrete01),
- fpc(0.0), epsc0(0.0), fpcu(0.0), epscu(0.0),
  CminStrain(0.0), CunloadSlope(0.0), CendStrain(0.0),
  Cstrain(0.0), Cstress(0.0)
 {
@@ -146,6 +181,8 @@ Concrete01::~Concrete01 ()
 
 int Concrete01::setTrialStrain (double strain, double strainRate)
 {
+   // setTrial() below and FiberBatch::Concrete01Group::trial(), which sets
+   // the Concrete01 fibers of a section, follow the same steps as this
    // Reset trial history variables to last committed state
    TminStrain = CminStrain;
    TendStrain = CendStrain;
@@ -334,18 +371,18 @@ void Concrete01::reload ()
 
 void Concrete01::envelope ()
 {
-  if (Tstrain > epsc0) {
-    double eta = Tstrain/epsc0;
-    Tstress = fpc*(2*eta-eta*eta);
-    double Ec0 = 2.0*fpc/epsc0;
+  if (Tstrain > par->epsc0) {
+    double eta = Tstrain/par->epsc0;
+    Tstress = par->fpc*(2*eta-eta*eta);
+    double Ec0 = 2.0*par->fpc/par->epsc0;
     Ttangent = Ec0*(1.0-eta);
   }
-  else if (Tstrain > epscu) {
-    Ttangent = (fpc-fpcu)/(epsc0-epscu);
-    Tstress = fpc + Ttangent*(Tstrain-epsc0);
+  else if (Tstrain > par->epscu) {
+    Ttangent = (par->fpc-par->fpcu)/(par->epsc0-par->epscu);
+    Tstress = par->fpc + Ttangent*(Tstrain-par->epsc0);
   }
   else {
-    Tstress = fpcu;
+    Tstress = par->fpcu;
     Ttangent = 0.0;
   }
 }
@@ -354,21 +391,21 @@ void Concrete01::unload ()
 {
   double tempStrain = TminStrain;
   
-  if (tempStrain < epscu)
-    tempStrain = epscu;
+  if (tempStrain < par->epscu)
+    tempStrain = par->epscu;
   
-  double eta = tempStrain/epsc0;
+  double eta = tempStrain/par->epsc0;
   
   double ratio = 0.707*(eta-2.0) + 0.834;
   
   if (eta < 2.0)
     ratio = 0.145*eta*eta + 0.13*eta;
   
-  TendStrain = ratio*epsc0;
+  TendStrain = ratio*par->epsc0;
   
   double temp1 = TminStrain - TendStrain;
   
-  double Ec0 = 2.0*fpc/epsc0;
+  double Ec0 = 2.0*par->fpc/par->epsc0;
   
   double temp2 = Tstress/Ec0;
   
@@ -435,7 +472,7 @@ int Concrete01::revertToLastCommit ()
 
 int Concrete01::revertToStart ()
 {
-	double Ec0 = 2.0*fpc/epsc0;
+	double Ec0 = 2.0*par->fpc/par->epsc0;
 
    // History variables
    CminStrain = 0.0;
@@ -459,8 +496,7 @@ int Concrete01::revertToStart ()
 
 UniaxialMaterial* Concrete01::getCopy ()
 {
-   Concrete01* theCopy = new Concrete01(this->getTag(),
-                                    fpc, epsc0, fpcu, epscu);
+   Concrete01* theCopy = new Concrete01(this->getTag(), par);
 
    // Converged history variables
    theCopy->CminStrain = CminStrain;
@@ -475,6 +511,21 @@ UniaxialMaterial* Concrete01::getCopy ()
    return theCopy;
 }
 
+int Concrete01::getElasticRange (double &strainMin, double &strainMax,
+				 double &sigma0, double &tangent)
+{
+   // cracked, the stress is zero for any strain in tension
+   if (Cstrain <= 0.0)
+     return -1;
+
+   strainMin = DBL_MIN;
+   strainMax = DBL_MAX;
+   sigma0 = 0.0;
+   tangent = 0.0;
+
+   return 0;
+}
+
 int Concrete01::sendSelf (int commitTag, Channel& theChannel)
 {
    int res = 0;
@@ -482,10 +533,10 @@ int Concrete01::sendSelf (int commitTag, Channel& theChannel)
    data(0) = this->getTag();
 
    // Material properties
-   data(1) = fpc;
-   data(2) = epsc0;
-   data(3) = fpcu;
-   data(4) = epscu;
+   data(1) = par->fpc;
+   data(2) = par->epsc0;
+   data(3) = par->fpcu;
+   data(4) = par->epscu;
 
    // History variables from last converged state
    data(5) = CminStrain;
@@ -521,11 +572,13 @@ int Concrete01::recvSelf (int commitTag, Channel& theChannel,
    else {
       this->setTag(int(data(0)));
 
-      // Material properties 
-      fpc = data(1);
-      epsc0 = data(2);
-      fpcu = data(3);
-      epscu = data(4);
+      // Material properties, still shared if unchanged
+      Parameters p = *par;
+      p.fpc = data(1);
+      p.epsc0 = data(2);
+      p.fpcu = data(3);
+      p.epscu = data(4);
+      par.assign(p);
 
       // History variables from last converged state
       CminStrain = data(5);
@@ -550,21 +603,21 @@ void Concrete01::Print (OPS_Stream& s, int flag)
 {
   if (flag == OPS_PRINT_PRINTMODEL_MATERIAL) {      
     s << "Concrete01, tag: " << this->getTag() << endln;
-    s << "  fpc: " << fpc << endln;
-    s << "  epsc0: " << epsc0 << endln;
-    s << "  fpcu: " << fpcu << endln;
-    s << "  epscu: " << epscu << endln;
+    s << "  fpc: " << par->fpc << endln;
+    s << "  epsc0: " << par->epsc0 << endln;
+    s << "  fpcu: " << par->fpcu << endln;
+    s << "  epscu: " << par->epscu << endln;
   }
   
   if (flag == OPS_PRINT_PRINTMODEL_JSON) {
     s << "\t\t\t{";
 	s << "\"name\": \"" << this->getTag() << "\", ";
 	s << "\"type\": \"Concrete01\", ";
-	s << "\"Ec\": " << 2.0*fpc/epsc0 << ", ";
-	s << "\"fc\": " << fpc << ", ";
-    s << "\"epsc\": " << epsc0 << ", ";
-    s << "\"fcu\": " << fpcu << ", ";
-    s << "\"epscu\": " << epscu << "}";
+	s << "\"Ec\": " << 2.0*par->fpc/par->epsc0 << ", ";
+	s << "\"fc\": " << par->fpc << ", ";
+    s << "\"epsc\": " << par->epsc0 << ", ";
+    s << "\"fcu\": " << par->fpcu << ", ";
+    s << "\"epscu\": " << par->epscu << "}";
   }
 }
 
@@ -577,19 +630,19 @@ Concrete01::setParameter(const char **argv, int argc, Parameter &param)
 {
 
   if (strcmp(argv[0],"fc") == 0) {// Compressive strength
-    param.setValue(fpc);
+    param.setValue(par->fpc);
     return param.addObject(1, this);
   }
   else if (strcmp(argv[0],"epsco") == 0) {// Strain at compressive strength
-    param.setValue(epsc0);
+    param.setValue(par->epsc0);
     return param.addObject(2, this);
   }
   else if (strcmp(argv[0],"fcu") == 0) {// Crushing strength
-    param.setValue(fpcu);
+    param.setValue(par->fpcu);
     return param.addObject(3, this);
   }
   else if (strcmp(argv[0],"epscu") == 0) {// Strain at crushing strength
-    param.setValue(epscu);
+    param.setValue(par->epscu);
     return param.addObject(4, this);
   }
   
@@ -601,38 +654,39 @@ Concrete01::setParameter(const char **argv, int argc, Parameter &param)
 int
 Concrete01::updateParameter(int parameterID, Information &info)
 {
+	Parameters &p = par.modify();
 	switch (parameterID) {
 	case 1:
-		this->fpc = info.theDouble;
+		p.fpc = info.theDouble;
 		break;
 	case 2:
-		this->epsc0 = info.theDouble;
+		p.epsc0 = info.theDouble;
 		break;
 	case 3:
-		this->fpcu = info.theDouble;
+		p.fpcu = info.theDouble;
 		break;
 	case 4:
-		this->epscu = info.theDouble;
+		p.epscu = info.theDouble;
 		break;
 	default:
 		break;
 	}
         
 	// Make all concrete parameters negative
-	if (fpc > 0.0)
-		fpc = -fpc;
+	if (p.fpc > 0.0)
+		p.fpc = -p.fpc;
 
-	if (epsc0 > 0.0)
-		epsc0 = -epsc0;
+	if (p.epsc0 > 0.0)
+		p.epsc0 = -p.epsc0;
 
-	if (fpcu > 0.0)
-		fpcu = -fpcu;
+	if (p.fpcu > 0.0)
+		p.fpcu = -p.fpcu;
 
-	if (epscu > 0.0)
-		epscu = -epscu;
+	if (p.epscu > 0.0)
+		p.epscu = -p.epscu;
 
 	// Initial tangent
-	double Ec0 = 2*fpc/epsc0;
+	double Ec0 = 2*p.fpc/p.epsc0;
 	Ctangent = Ec0;
 	CunloadSlope = Ec0;
 	Ttangent = Ec0;
@@ -704,30 +758,30 @@ Concrete01::getStressSensitivity(int gradIndex, bool conditional)
 
 		if (Tstrain < CminStrain) {			// loading along the backbone curve
 
-			if (Tstrain > epsc0) {			//on the parabola
+			if (Tstrain > par->epsc0) {			//on the parabola
 				
-				TstressSensitivity = fpcSensitivity*(2.0*Tstrain/epsc0-(Tstrain/epsc0)*(Tstrain/epsc0))
-					      + fpc*( (2.0*TstrainSensitivity*epsc0-2.0*Tstrain*epsc0Sensitivity)/(epsc0*epsc0) 
-						  - 2.0*(Tstrain/epsc0)*(TstrainSensitivity*epsc0-Tstrain*epsc0Sensitivity)/(epsc0*epsc0));
+				TstressSensitivity = fpcSensitivity*(2.0*Tstrain/par->epsc0-(Tstrain/par->epsc0)*(Tstrain/par->epsc0))
+					      + par->fpc*( (2.0*TstrainSensitivity*par->epsc0-2.0*Tstrain*epsc0Sensitivity)/(par->epsc0*par->epsc0) 
+						  - 2.0*(Tstrain/par->epsc0)*(TstrainSensitivity*par->epsc0-Tstrain*epsc0Sensitivity)/(par->epsc0*par->epsc0));
 				
-				dktdh = 2.0*((fpcSensitivity*epsc0-fpc*epsc0Sensitivity)/(epsc0*epsc0))
-					  * (1.0-Tstrain/epsc0)
-					  - 2.0*(fpc/epsc0)*(TstrainSensitivity*epsc0-Tstrain*epsc0Sensitivity)
-					  / (epsc0*epsc0);
+				dktdh = 2.0*((fpcSensitivity*par->epsc0-par->fpc*epsc0Sensitivity)/(par->epsc0*par->epsc0))
+					  * (1.0-Tstrain/par->epsc0)
+					  - 2.0*(par->fpc/par->epsc0)*(TstrainSensitivity*par->epsc0-Tstrain*epsc0Sensitivity)
+					  / (par->epsc0*par->epsc0);
 			}
-			else if (Tstrain > epscu) {		// on the straight inclined line
+			else if (Tstrain > par->epscu) {		// on the straight inclined line
 //cerr << "ON THE STRAIGHT INCLINED LINE" << endl;
 
 				dktdh = ( (fpcSensitivity-fpcuSensitivity)
-					  * (epsc0-epscu) 
-					  - (fpc-fpcu)
+					  * (par->epsc0-par->epscu) 
+					  - (par->fpc-par->fpcu)
 					  * (epsc0Sensitivity-epscuSensitivity) )
-					  / ((epsc0-epscu)*(epsc0-epscu));
+					  / ((par->epsc0-par->epscu)*(par->epsc0-par->epscu));
 
-				double kt = (fpc-fpcu)/(epsc0-epscu);
+				double kt = (par->fpc-par->fpcu)/(par->epsc0-par->epscu);
 
 				TstressSensitivity = fpcSensitivity 
-					      + dktdh*(Tstrain-epsc0)
+					      + dktdh*(Tstrain-par->epsc0)
 						  + kt*(TstrainSensitivity-epsc0Sensitivity);
 			}
 			else {							// on the horizontal line
@@ -810,7 +864,7 @@ Concrete01::commitSensitivity(double TstrainSensitivity, int gradIndex, int numG
 	
 	if (SHVs == 0) {
 		SHVs = new Matrix(5,numGrads);
-		CunloadSlopeSensitivity = (2.0*fpcSensitivity*epsc0-2.0*fpc*epsc0Sensitivity) / (epsc0*epsc0);
+		CunloadSlopeSensitivity = (2.0*fpcSensitivity*par->epsc0-2.0*par->fpc*epsc0Sensitivity) / (par->epsc0*par->epsc0);
 	}
 	else {
 		CminStrainSensitivity   = (*SHVs)(0,gradIndex);
@@ -829,29 +883,29 @@ Concrete01::commitSensitivity(double TstrainSensitivity, int gradIndex, int numG
 
 		if (Tstrain < CminStrain) {			// loading along the backbone curve
 
-			if (Tstrain > epsc0) {			//on the parabola
+			if (Tstrain > par->epsc0) {			//on the parabola
 				
-				TstressSensitivity = fpcSensitivity*(2.0*Tstrain/epsc0-(Tstrain/epsc0)*(Tstrain/epsc0))
-					      + fpc*( (2.0*TstrainSensitivity*epsc0-2.0*Tstrain*epsc0Sensitivity)/(epsc0*epsc0) 
-						  - 2.0*(Tstrain/epsc0)*(TstrainSensitivity*epsc0-Tstrain*epsc0Sensitivity)/(epsc0*epsc0));
+				TstressSensitivity = fpcSensitivity*(2.0*Tstrain/par->epsc0-(Tstrain/par->epsc0)*(Tstrain/par->epsc0))
+					      + par->fpc*( (2.0*TstrainSensitivity*par->epsc0-2.0*Tstrain*epsc0Sensitivity)/(par->epsc0*par->epsc0) 
+						  - 2.0*(Tstrain/par->epsc0)*(TstrainSensitivity*par->epsc0-Tstrain*epsc0Sensitivity)/(par->epsc0*par->epsc0));
 				
-				dktdh = 2.0*((fpcSensitivity*epsc0-fpc*epsc0Sensitivity)/(epsc0*epsc0))
-					  * (1.0-Tstrain/epsc0)
-					  - 2.0*(fpc/epsc0)*(TstrainSensitivity*epsc0-Tstrain*epsc0Sensitivity)
-					  / (epsc0*epsc0);
+				dktdh = 2.0*((fpcSensitivity*par->epsc0-par->fpc*epsc0Sensitivity)/(par->epsc0*par->epsc0))
+					  * (1.0-Tstrain/par->epsc0)
+					  - 2.0*(par->fpc/par->epsc0)*(TstrainSensitivity*par->epsc0-Tstrain*epsc0Sensitivity)
+					  / (par->epsc0*par->epsc0);
 			}
-			else if (Tstrain > epscu) {		// on the straight inclined line
+			else if (Tstrain > par->epscu) {		// on the straight inclined line
 
 				dktdh = ( (fpcSensitivity-fpcuSensitivity)
-					  * (epsc0-epscu) 
-					  - (fpc-fpcu)
+					  * (par->epsc0-par->epscu) 
+					  - (par->fpc-par->fpcu)
 					  * (epsc0Sensitivity-epscuSensitivity) )
-					  / ((epsc0-epscu)*(epsc0-epscu));
+					  / ((par->epsc0-par->epscu)*(par->epsc0-par->epscu));
 
-				double kt = (fpc-fpcu)/(epsc0-epscu);
+				double kt = (par->fpc-par->fpcu)/(par->epsc0-par->epscu);
 
 				TstressSensitivity = fpcSensitivity 
-					      + dktdh*(Tstrain-epsc0)
+					      + dktdh*(Tstrain-par->epsc0)
 						  + kt*(TstrainSensitivity-epsc0Sensitivity);
 			}
 			else {							// on the horizontal line
@@ -912,9 +966,9 @@ Concrete01::commitSensitivity(double TstrainSensitivity, int gradIndex, int numG
 
 		TminStrainSensitivity = TstrainSensitivity;
 
-		if (Tstrain < epscu) {
+		if (Tstrain < par->epscu) {
 
-			epsTemp = epscu; 
+			epsTemp = par->epscu; 
 
 			epsTempSensitivity = epscuSensitivity;
 
@@ -926,9 +980,9 @@ Concrete01::commitSensitivity(double TstrainSensitivity, int gradIndex, int numG
 			epsTempSensitivity = TstrainSensitivity;
 		}
 
-		eta = epsTemp/epsc0;
+		eta = epsTemp/par->epsc0;
 
-		etaSensitivity = (epsTempSensitivity*epsc0-epsTemp*epsc0Sensitivity) / (epsc0*epsc0);
+		etaSensitivity = (epsTempSensitivity*par->epsc0-epsTemp*epsc0Sensitivity) / (par->epsc0*par->epsc0);
 
 		if (eta < 2.0) {
 
@@ -944,19 +998,19 @@ Concrete01::commitSensitivity(double TstrainSensitivity, int gradIndex, int numG
 			ratioSensitivity = 0.707 * etaSensitivity;
 		}
 
-		temp1 = Tstrain - ratio * epsc0;
+		temp1 = Tstrain - ratio * par->epsc0;
 
-		temp1Sensitivity = TstrainSensitivity - ratioSensitivity * epsc0
+		temp1Sensitivity = TstrainSensitivity - ratioSensitivity * par->epsc0
 			                                  - ratio * epsc0Sensitivity;
 
-		temp2 = Tstress * epsc0 / (2.0*fpc); 
+		temp2 = Tstress * par->epsc0 / (2.0*par->fpc); 
 		
-		temp2Sensitivity = (2.0*fpc*(TstressSensitivity*epsc0+Tstress*epsc0Sensitivity)
-			-2.0*Tstress*epsc0*fpcSensitivity) / (4.0*fpc*fpc);
+		temp2Sensitivity = (2.0*par->fpc*(TstressSensitivity*par->epsc0+Tstress*epsc0Sensitivity)
+			-2.0*Tstress*par->epsc0*fpcSensitivity) / (4.0*par->fpc*par->fpc);
 
 		if (temp1 == 0.0) {
 
-			TunloadSlopeSensitivity = (2.0*fpcSensitivity*epsc0-2.0*fpc*epsc0Sensitivity) / (epsc0*epsc0);
+			TunloadSlopeSensitivity = (2.0*fpcSensitivity*par->epsc0-2.0*par->fpc*epsc0Sensitivity) / (par->epsc0*par->epsc0);
 		}
 		else if (temp1 < temp2) {
 
@@ -969,7 +1023,7 @@ Concrete01::commitSensitivity(double TstrainSensitivity, int gradIndex, int numG
 
 			TendStrainSensitivity = TstrainSensitivity - temp2Sensitivity;
 
-			TunloadSlopeSensitivity = (2.0*fpcSensitivity*epsc0-2.0*fpc*epsc0Sensitivity) / (epsc0*epsc0);
+			TunloadSlopeSensitivity = (2.0*fpcSensitivity*par->epsc0-2.0*par->fpc*epsc0Sensitivity) / (par->epsc0*par->epsc0);
 		}
 	}
 	else {
@@ -1099,7 +1153,7 @@ int
 Concrete01::getVariable(const char *varName, Information &theInfo)
 {
   if (strcmp(varName,"ec") == 0) {
-    theInfo.theDouble = epsc0;
+    theInfo.theDouble = par->epsc0;
     return 0;
   } else
     return -1;
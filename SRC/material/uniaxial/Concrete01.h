@@ -40,6 +40,7 @@
 
 
 #include <UniaxialMaterial.h>
+#include <SharedParameters.h>
 
 class Concrete01 : public UniaxialMaterial
 {
@@ -55,13 +56,16 @@ class Concrete01 : public UniaxialMaterial
   double getStrain(void);      
   double getStress(void);
   double getTangent(void);
-  double getInitialTangent(void) {return 2.0*fpc/epsc0;}
+  double getInitialTangent(void) {return 2.0*par->fpc/par->epsc0;}
 
   int commitState(void);
   int revertToLastCommit(void);    
   int revertToStart(void);        
   
   UniaxialMaterial *getCopy(void);
+  bool isReentrant(void) const {return true;}
+  int getElasticRange(double &strainMin, double &strainMax,
+		      double &sigma0, double &tangent);
   
   int sendSelf(int commitTag, Channel &theChannel);  
   int recvSelf(int commitTag, Channel &theChannel, 
@@ -82,18 +86,31 @@ class Concrete01 : public UniaxialMaterial
   double getEnergy() { return EnergyP; }
 #ifdef _CSS
   //by SAJalali
-  double getInitYieldStrain() { return fabs(epsc0/2); }
+  double getInitYieldStrain() { return fabs(par->epsc0/2); }
   virtual void resetEnergy(void) { EnergyP = 0; }
 #endif // _CSS
 
  protected:
 
  private:
-  /*** Material Properties ***/
-  double fpc;    // Compressive strength
-  double epsc0;  // Strain at compressive strength
-  double fpcu;   // Crushing strength
-  double epscu;  // Strain at crushing strength
+  friend class FiberBatch;   // evaluates the fibers of a section
+
+  /*** Material Properties, shared by the copies of a material ***/
+  struct Parameters {
+    Parameters(double fpc = 0.0, double epsc0 = 0.0,
+	       double fpcu = 0.0, double epscu = 0.0);
+    static const char *getClassType(void) {return "Concrete01";}
+    bool operator==(const Parameters &other) const;
+
+    double fpc;    // Compressive strength
+    double epsc0;  // Strain at compressive strength
+    double fpcu;   // Crushing strength
+    double epscu;  // Strain at crushing strength
+  };
+
+  Concrete01 (int tag, const SharedParameters<Parameters> &theParameters);
+
+  SharedParameters<Parameters> par;
   
   /*** CONVERGED History Variables ***/
   double CminStrain;   // Smallest previous concrete strain (compression)
@@ -91,10 +91,29 @@ OPS_Concrete02()
   return theMaterial;
 }
 
+Concrete02::Parameters::Parameters(double _fc, double _epsc0, double _fcu,
+				   double _epscu, double _rat, double _ft,
+				   double _Ets):
+  fc(_fc), epsc0(_epsc0), fcu(_fcu), epscu(_epscu), rat(_rat), ft(_ft), Ets(_Ets)
+{
+  if (fc > 0) fc = -fc;
+  if (epsc0 > 0) epsc0 = -epsc0;
+  if (fcu > 0) fcu = -fcu;
+  if (epscu > 0) epscu = -epscu;
+}
+
+bool
+Concrete02::Parameters::operator==(const Parameters &other) const
+{
+  return fc == other.fc && epsc0 == other.epsc0 && fcu == other.fcu &&
+    epscu == other.epscu && rat == other.rat && ft == other.ft &&
+    Ets == other.Ets;
+}
+
 Concrete02::Concrete02(int tag, double _fc, double _epsc0, double _fcu,
 		       double _epscu, double _rat, double _ft, double _Ets):
   UniaxialMaterial(tag, MAT_TAG_Concrete02),
-  fc(_fc), epsc0(_epsc0), fcu(_fcu), epscu(_epscu), rat(_rat), ft(_ft), Ets(_Ets)
+  par(Parameters(_fc, _epsc0, _fcu, _epscu, _rat, _ft, _Ets))
 {
 #ifdef _CSS
     EnergyP = 0;
@@ -103,44 +122,49 @@ Concrete02::Concrete02(int tag, double _fc, double _epsc0, double _fcu,
   ecminP = 0.0;
   deptP = 0.0;
 
-  if (fc > 0) fc = -fc;
-  if (epsc0 > 0) epsc0 = -epsc0;
-  if (fcu > 0) fcu = -fcu;
-  if (epscu > 0) epscu = -epscu;
-
-  eP = 2.0*fc/epsc0;
+  eP = 2.0*par->fc/par->epsc0;
   epsP = 0.0;
   sigP = 0.0;
   eps = 0.0;
   sig = 0.0;
-  e = 2.0*fc/epsc0;
+  e = 2.0*par->fc/par->epsc0;
 }
 
 Concrete02::Concrete02(int tag, double _fc, double _epsc0, double _fcu,
 		       double _epscu):
   UniaxialMaterial(tag, MAT_TAG_Concrete02),
-  fc(_fc), epsc0(_epsc0), fcu(_fcu), epscu(_epscu)
+  par(Parameters(_fc, _epsc0, _fcu, _epscu,
+		 0.1, 0.1*fabs(_fc), 0.1*fabs(_fc)/fabs(_epsc0)))
 {
   ecminP = 0.0;
   deptP = 0.0;
-
-  if (fc > 0) fc = -fc;
-  if (epsc0 > 0) epsc0 = -epsc0;
-  if (fcu > 0) fcu = -fcu;
-  if (epscu > 0) epscu = -epscu;
 	  
-  eP = 2.0*fc/epsc0;
+  eP = 2.0*par->fc/par->epsc0;
   epsP = 0.0;
   sigP = 0.0;
   eps = 0.0;
   sig = 0.0;
-  e = 2.0*fc/epsc0;
+  e = 2.0*par->fc/par->epsc0;
+}
+
+// a copy of a material, sharing its parameters
+Concrete02::Concrete02(int tag, const SharedParameters<Parameters> &theParameters):
+  UniaxialMaterial(tag, MAT_TAG_Concrete02),
+  par(theParameters)
+{
+#ifdef _CSS
+    EnergyP = 0;
+#endif // _CSS
+
+  ecminP = 0.0;
+  deptP = 0.0;
 
-  rat = 0.1;
-  ft = 0.1*fc;
-  if (ft < 0.0)
-    ft = -ft;
-  Ets = 0.1*fc/epsc0;
+  eP = 2.0*par->fc/par->epsc0;
+  epsP = 0.0;
+  sigP = 0.0;
+  eps = 0.0;
+  sig = 0.0;
+  e = 2.0*par->fc/par->epsc0;
 }
 
 Concrete02::Concrete02(void):
@@ -160,7 +184,7 @@ Concrete02::~Concrete02(void)
 UniaxialMaterial*
 Concrete02::getCopy(void)
 {
-  Concrete02 *theCopy = new Concrete02(this->getTag(), fc, epsc0, fcu, epscu, rat, ft, Ets);
+  Concrete02 *theCopy = new Concrete02(this->getTag(), par);
   
   return theCopy;
 }
@@ -168,13 +192,15 @@ Concrete02::getCopy(void)
 double
 Concrete02::getInitialTangent(void)
 {
-  return 2.0*fc/epsc0;
+  return 2.0*par->fc/par->epsc0;
 }
 
 int
 Concrete02::setTrialStrain(double trialStrain, double strainRate)
 {
-  double  ec0 = fc * 2. / epsc0;
+  // FiberBatch::Concrete02Group::trial() sets the Concrete02 fibers of a
+  // section with a copy of this and of Compr_Envlp() and Tens_Envlp()
+  double  ec0 = par->fc * 2. / par->epsc0;
 
   // retrieve concrete history variables
 
@@ -206,7 +232,7 @@ Concrete02::setTrialStrain(double trialStrain, double strainRate)
     // (corresponding equations are 2.31 and 2.32 
     // the strain of point R is epsR and the stress is sigmR 
     
-    double epsr = (fcu - rat * ec0 * epscu) / (ec0 * (1.0 - rat));
+    double epsr = (par->fcu - par->rat * ec0 * par->epscu) / (ec0 * (1.0 - par->rat));
     double sigmr = ec0 * epsr;
     
     // calculate the previous minimum stress sigmm from the minimum 
@@ -333,12 +359,12 @@ Concrete02::revertToStart(void)
     ecminP = 0.0;
   deptP = 0.0;
 
-  eP = 2.0*fc/epsc0;
+  eP = 2.0*par->fc/par->epsc0;
   epsP = 0.0;
   sigP = 0.0;
   eps = 0.0;
   sig = 0.0;
-  e = 2.0*fc/epsc0;
+  e = 2.0*par->fc/par->epsc0;
 
   return 0;
 }
@@ -351,13 +377,13 @@ Concrete02::sendSelf(int commitTag, Channel &theChannel)
 #else
     static Vector data(13);
 #endif // _CSS
-  data(0) =fc;    
-  data(1) =epsc0; 
-  data(2) =fcu;   
-  data(3) =epscu; 
-  data(4) =rat;   
-  data(5) =ft;    
-  data(6) =Ets;   
+  data(0) =par->fc;    
+  data(1) =par->epsc0; 
+  data(2) =par->fcu;   
+  data(3) =par->epscu; 
+  data(4) =par->rat;   
+  data(5) =par->ft;    
+  data(6) =par->Ets;   
   data(7) =ecminP;
   data(8) =deptP; 
   data(9) =epsP;  
@@ -390,13 +416,16 @@ Concrete02::recvSelf(int commitTag, Channel &theChannel,
     return -1;
   }
 
-  fc = data(0);
-  epsc0 = data(1);
-  fcu = data(2);
-  epscu = data(3);
-  rat = data(4);
-  ft = data(5);
-  Ets = data(6);
+  // the parameters stay shared with the copies if they are unchanged
+  Parameters p = *par;
+  p.fc = data(0);
+  p.epsc0 = data(1);
+  p.fcu = data(2);
+  p.epscu = data(3);
+  p.rat = data(4);
+  p.ft = data(5);
+  p.Ets = data(6);
+  par.assign(p);
   ecminP = data(7);
   deptP = data(8);
   epsP = data(9);
@@ -425,14 +454,14 @@ Concrete02::Print(OPS_Stream &s, int flag)
     s << "\t\t\t{";
 	s << "\"name\": \"" << this->getTag() << "\", ";
 	s << "\"type\": \"Concrete02\", ";
-	s << "\"Ec\": " << 2.0*fc/epsc0 << ", ";
-	s << "\"fc\": " << fc << ", ";
-    s << "\"epsc\": " << epsc0 << ", ";
-    s << "\"fcu\": " << fcu << ", ";
-    s << "\"epscu\": " << epscu << ", ";
-    s << "\"ratio\": " << rat << ", ";
-    s << "\"ft\": " << ft << ", ";
-    s << "\"Ets\": " << Ets << "}";
+	s << "\"Ec\": " << 2.0*par->fc/par->epsc0 << ", ";
+	s << "\"fc\": " << par->fc << ", ";
+    s << "\"epsc\": " << par->epsc0 << ", ";
+    s << "\"fcu\": " << par->fcu << ", ";
+    s << "\"epscu\": " << par->epscu << ", ";
+    s << "\"ratio\": " << par->rat << ", ";
+    s << "\"ft\": " << par->ft << ", ";
+    s << "\"Ets\": " << par->Ets << "}";
   }
 }
 
@@ -453,17 +482,17 @@ Concrete02::Tens_Envlp (double epsc, double &sigc, double &Ect)
 !    Ect  = tangent concrete modulus
 !-----------------------------------------------------------------------*/
   
-  double Ec0  = 2.0*fc/epsc0;
+  double Ec0  = 2.0*par->fc/par->epsc0;
 
-  double eps0 = ft/Ec0;
-  double epsu = ft*(1.0/Ets+1.0/Ec0);
+  double eps0 = par->ft/Ec0;
+  double epsu = par->ft*(1.0/par->Ets+1.0/Ec0);
   if (epsc<=eps0) {
     sigc = epsc*Ec0;
     Ect  = Ec0;
   } else {
     if (epsc<=epsu) {
-      Ect  = -Ets;
-      sigc = ft-Ets*(epsc-eps0);
+      Ect  = -par->Ets;
+      sigc = par->ft-par->Ets*(epsc-eps0);
     } else {
       //      Ect  = 0.0
       Ect  = 1.0e-10;
@@ -492,23 +521,23 @@ Concrete02::Compr_Envlp (double epsc, double &sigc, double &Ect)
 !   Ect   = tangent concrete modulus
 -----------------------------------------------------------------------*/
 
-  double Ec0  = 2.0*fc/epsc0;
+  double Ec0  = 2.0*par->fc/par->epsc0;
 
-  double ratLocal = epsc/epsc0;
-  if (epsc>=epsc0) {
-    sigc = fc*ratLocal*(2.0-ratLocal);
+  double ratLocal = epsc/par->epsc0;
+  if (epsc>=par->epsc0) {
+    sigc = par->fc*ratLocal*(2.0-ratLocal);
     Ect  = Ec0*(1.0-ratLocal);
   } else {
     
     //   linear descending branch between epsc0 and epscu
-    if (epsc>epscu) {
-      sigc = (fcu-fc)*(epsc-epsc0)/(epscu-epsc0)+fc;
-      Ect  = (fcu-fc)/(epscu-epsc0);
+    if (epsc>par->epscu) {
+      sigc = (par->fcu-par->fc)*(epsc-par->epsc0)/(par->epscu-par->epsc0)+par->fc;
+      Ect  = (par->fcu-par->fc)/(par->epscu-par->epsc0);
     } else {
 	   
       // flat friction branch for strains larger than epscu
       
-      sigc = fcu;
+      sigc = par->fcu;
       Ect  = 1.0e-10;
       //       Ect  = 0.0
     }
@@ -520,7 +549,7 @@ int
 Concrete02::getVariable(const char *varName, Information &theInfo)
 {
   if (strcmp(varName,"ec") == 0) {
-    theInfo.theDouble = epsc0;
+    theInfo.theDouble = par->epsc0;
     return 0;
   } else
     return -1;
@@ -41,6 +41,7 @@
 #define Concrete02_h
 
 #include <UniaxialMaterial.h>
+#include <SharedParameters.h>
 
 class Concrete02 : public UniaxialMaterial
 {
@@ -57,6 +58,7 @@ class Concrete02 : public UniaxialMaterial
     const char *getClassType(void) const {return "Concrete02";};    
     double getInitialTangent(void);
     UniaxialMaterial *getCopy(void);
+    bool isReentrant(void) const {return true;}
 
     int setTrialStrain(double strain, double strainRate = 0.0); 
     double getStrain(void);      
@@ -78,24 +80,38 @@ class Concrete02 : public UniaxialMaterial
     //by SAJalali
     double EnergyP;
     double getEnergy() { return EnergyP; }
-    double getInitYieldStrain() { return fabs(epsc0/2); }
+    double getInitYieldStrain() { return fabs(par->epsc0/2); }
     virtual void resetEnergy(void) { EnergyP = 0; }
 #endif // _CSS
 
  protected:
     
  private:
+    friend class FiberBatch;   // evaluates the fibers of a section
+
     void Tens_Envlp (double epsc, double &sigc, double &Ect);
     void Compr_Envlp (double epsc, double &sigc, double &Ect);
 
-    // matpar : Concrete FIXED PROPERTIES
-    double fc;    // concrete compression strength           : mp(1)
-    double epsc0; // strain at compression strength          : mp(2)
-    double fcu;   // stress at ultimate (crushing) strain    : mp(3)
-    double epscu; // ultimate (crushing) strain              : mp(4)       
-    double rat;   // ratio between unloading slope at epscu and original slope : mp(5)
-    double ft;    // concrete tensile strength               : mp(6)
-    double Ets;   // tension stiffening slope                : mp(7)
+    // matpar : Concrete FIXED PROPERTIES, shared by the copies of a material
+    struct Parameters {
+      Parameters(double fc = 0.0, double epsc0 = 0.0, double fcu = 0.0,
+		 double epscu = 0.0, double rat = 0.0, double ft = 0.0,
+		 double Ets = 0.0);
+      static const char *getClassType(void) {return "Concrete02";}
+      bool operator==(const Parameters &other) const;
+
+      double fc;    // concrete compression strength           : mp(1)
+      double epsc0; // strain at compression strength          : mp(2)
+      double fcu;   // stress at ultimate (crushing) strain    : mp(3)
+      double epscu; // ultimate (crushing) strain              : mp(4)       
+      double rat;   // ratio between unloading slope at epscu and original slope : mp(5)
+      double ft;    // concrete tensile strength               : mp(6)
+      double Ets;   // tension stiffening slope                : mp(7)
+    };
+
+    Concrete02(int tag, const SharedParameters<Parameters> &theParameters);
+
+    SharedParameters<Parameters> par;
 
     // hstvP : Concerete HISTORY VARIABLES last committed step
     double ecminP;  //  hstP(1)
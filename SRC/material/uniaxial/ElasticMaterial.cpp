@@ -38,6 +38,7 @@
 #include <Information.h>
 #include <Parameter.h>
 #include <string.h>
+#include <float.h>
 
 #include <OPS_Globals.h>
 
@@ -100,7 +101,7 @@ OPS_ElasticMaterial(void)
 
 ElasticMaterial::ElasticMaterial(int tag, double e, double et)
 :UniaxialMaterial(tag,MAT_TAG_ElasticMaterial),
- trialStrain(0.0),  trialStrainRate(0.0),
+ trialStrain(0.0),  trialStrainRate(0.0), committedStrain(0.0),
  Epos(e), Eneg(e), eta(et), parameterID(0)
 {
 
@@ -109,7 +110,7 @@ ElasticMaterial::ElasticMaterial(int tag, double e, double et)
 
 ElasticMaterial::ElasticMaterial(int tag, double ep, double et, double en)
 :UniaxialMaterial(tag,MAT_TAG_ElasticMaterial),
- trialStrain(0.0),  trialStrainRate(0.0),
+ trialStrain(0.0),  trialStrainRate(0.0), committedStrain(0.0),
  Epos(ep), Eneg(en), eta(et), parameterID(0)
 {
 
@@ -118,7 +119,7 @@ ElasticMaterial::ElasticMaterial(int tag, double ep, double et, double en)
 
 ElasticMaterial::ElasticMaterial()
 :UniaxialMaterial(0,MAT_TAG_ElasticMaterial),
- trialStrain(0.0),  trialStrainRate(0.0),
+ trialStrain(0.0),  trialStrainRate(0.0), committedStrain(0.0),
  Epos(0.0), Eneg(0.0), eta(0.0), parameterID(0)
 {
 
@@ -134,6 +135,9 @@ ElasticMaterial::~ElasticMaterial()
 int 
 ElasticMaterial::setTrialStrain(double strain, double strainRate)
 {
+    // the fibers of a section are not set through here or setTrial() but
+    // by FiberBatch::ElasticGroup::trial(), with the same stress for the
+    // zero strain rate a section gives its fibers
     trialStrain     = strain;
     trialStrainRate = strainRate;
     return 0;
@@ -188,6 +192,7 @@ ElasticMaterial::getInitialTangent(void)
 int 
 ElasticMaterial::commitState(void)
 {
+  committedStrain = trialStrain;
   return 0;
 }
 
@@ -195,6 +200,7 @@ ElasticMaterial::commitState(void)
 int 
 ElasticMaterial::revertToLastCommit(void)
 {
+  trialStrain = committedStrain;
   return 0;
 }
 
@@ -204,6 +210,7 @@ ElasticMaterial::revertToStart(void)
 {
     trialStrain      = 0.0;
     trialStrainRate  = 0.0;
+    committedStrain  = 0.0;
     return 0;
 }
 
@@ -214,10 +221,36 @@ ElasticMaterial::getCopy(void)
     ElasticMaterial *theCopy = new ElasticMaterial(this->getTag(),Epos,eta,Eneg);
     theCopy->trialStrain     = trialStrain;
     theCopy->trialStrainRate = trialStrainRate;
+    theCopy->committedStrain = committedStrain;
     theCopy->parameterID = parameterID;
     return theCopy;
 }
 
+int
+ElasticMaterial::getElasticRange(double &strainMin, double &strainMax,
+				 double &sigma0, double &tangent)
+{
+    // the stress depends on the strain rate
+    if (eta != 0.0)
+      return -1;
+
+    sigma0 = 0.0;
+    if (Epos == Eneg) {
+      strainMin = -DBL_MAX;
+      strainMax = DBL_MAX;
+      tangent = Epos;
+    } else if (committedStrain >= 0.0) {
+      strainMin = 0.0;
+      strainMax = DBL_MAX;
+      tangent = Epos;
+    } else {
+      strainMin = -DBL_MAX;
+      strainMax = -DBL_MIN;
+      tangent = Eneg;
+    }
+    return 0;
+}
+
 
 int 
 ElasticMaterial::sendSelf(int cTag, Channel &theChannel)
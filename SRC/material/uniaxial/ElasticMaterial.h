@@ -62,6 +62,9 @@ class ElasticMaterial : public UniaxialMaterial
     int revertToStart(void);        
 
     UniaxialMaterial *getCopy(void);
+    bool isReentrant(void) const {return true;}
+    int getElasticRange(double &strainMin, double &strainMax,
+			double &sigma0, double &tangent);
     
     int sendSelf(int commitTag, Channel &theChannel);  
     int recvSelf(int commitTag, Channel &theChannel, 
@@ -89,8 +92,11 @@ class ElasticMaterial : public UniaxialMaterial
   protected:
     
   private:
+    friend class FiberBatch;   // evaluates the fibers of a section
+
     double trialStrain;
     double trialStrainRate;
+    double committedStrain;
     double Epos;
     double Eneg;
     double eta;
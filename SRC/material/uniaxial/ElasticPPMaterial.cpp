@@ -269,6 +269,23 @@ ElasticPPMaterial::getCopy(void)
   return theCopy;
 }
 
+int
+ElasticPPMaterial::getElasticRange(double &strainMin, double &strainMax,
+				   double &sigma0, double &tangent)
+{
+  if (E <= 0.0)
+    return -1;
+
+  // the trial stress of setTrialStrain() within the yield surface
+  double fYieldSurface = - E * DBL_EPSILON;
+  strainMin = ezero + ep + (fyn - fYieldSurface)/E;
+  strainMax = ezero + ep + (fyp + fYieldSurface)/E;
+  sigma0 = -E*(ezero + ep);
+  tangent = E;
+
+  return 0;
+}
+
 
 int 
 ElasticPPMaterial::sendSelf(int cTag, Channel &theChannel)
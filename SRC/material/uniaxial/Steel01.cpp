@@ -433,6 +433,27 @@ UniaxialMaterial* Steel01::getCopy ()
    return theCopy;
 }
 
+int Steel01::getElasticRange (double &strainMin, double &strainMax,
+			      double &sigma0, double &tangent)
+{
+   // from the elastic branch only, between the bounds on the stress in
+   // determineTrialState(); with isotropic hardening a reversal changes
+   // the committed shifts, and so the range, without leaving it
+   double Esh = b*E0;
+   if (Ctangent != E0 || Esh >= E0)
+     return -1;
+
+   double fyOneMinusB = fy * (1.0 - b);
+   double c0 = Cstress - E0*Cstrain;
+
+   strainMin = (-CshiftN*fyOneMinusB - c0)/(E0 - Esh);
+   strainMax = (CshiftP*fyOneMinusB - c0)/(E0 - Esh);
+   sigma0 = c0;
+   tangent = E0;
+
+   return 0;
+}
+
 int Steel01::sendSelf (int commitTag, Channel& theChannel)
 {
    int res = 0;
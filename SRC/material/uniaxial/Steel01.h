@@ -69,6 +69,9 @@ class Steel01 : public UniaxialMaterial
     int revertToStart(void);        
 
     UniaxialMaterial *getCopy(void);
+    bool isReentrant(void) const {return true;}
+    int getElasticRange(double &strainMin, double &strainMax,
+			double &sigma0, double &tangent);
     
     int sendSelf(int commitTag, Channel &theChannel);  
     int recvSelf(int commitTag, Channel &theChannel, 
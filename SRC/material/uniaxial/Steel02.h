@@ -40,6 +40,7 @@
 #define Steel02_h
 
 #include <UniaxialMaterial.h>
+#include <SharedParameters.h>
 
 class Steel02 : public UniaxialMaterial
 {
@@ -66,6 +67,7 @@ class Steel02 : public UniaxialMaterial
 
     double getInitialTangent(void);
     UniaxialMaterial *getCopy(void);
+    bool isReentrant(void) const {return true;}
 
     int setTrialStrain(double strain, double strainRate = 0.0); 
     double getStrain(void);      
@@ -90,26 +92,49 @@ class Steel02 : public UniaxialMaterial
 
 #ifdef _CSS
 	//by SAJalali
-	double getInitYieldStrain() { return Fy / E0; }
+	double getInitYieldStrain() { return par->Fy / par->E0; }
    virtual void resetEnergy(void) { EnergyP = 0; }
 #endif // _CSS
 
 protected:
     
  private:
+    friend class FiberBatch;   // evaluates the fibers of a section
+
+    // matpar : STEEL FIXED PROPERTIES, shared by the copies of a material
+    struct Parameters {
+      Parameters(double fy = 0.0, double E0 = 0.0, double b = 0.0,
+		 double R0 = 15.0, double cR1 = 0.925, double cR2 = 0.15,
+		 double a1 = 0.0, double a2 = 1.0, double a3 = 0.0, double a4 = 1.0,
+		 double sigini = 0.0)
+	:Fy(fy), E0(E0), b(b), R0(R0), cR1(cR1), cR2(cR2),
+	 a1(a1), a2(a2), a3(a3), a4(a4), sigini(sigini) {}
+      static const char *getClassType(void) {return "Steel02";}
+      bool operator==(const Parameters &other) const {
+	return Fy == other.Fy && E0 == other.E0 && b == other.b &&
+	  R0 == other.R0 && cR1 == other.cR1 && cR2 == other.cR2 &&
+	  a1 == other.a1 && a2 == other.a2 && a3 == other.a3 &&
+	  a4 == other.a4 && sigini == other.sigini;
+      }
+
+      double Fy;  //  = matpar(1)  : yield stress
+      double E0;  //  = matpar(2)  : initial stiffness
+      double b;   //  = matpar(3)  : hardening ratio (Esh/E0)
+      double R0;  //  = matpar(4)  : exp transition elastic-plastic
+      double cR1; //  = matpar(5)  : coefficient for changing R0 to R
+      double cR2; //  = matpar(6)  : coefficient for changing R0 to R
+      double a1;  //  = matpar(7)  : coefficient for isotropic hardening in compression
+      double a2;  //  = matpar(8)  : coefficient for isotropic hardening in compression
+      double a3;  //  = matpar(9)  : coefficient for isotropic hardening in tension
+      double a4;  //  = matpar(10) : coefficient for isotropic hardening in tension
+      double sigini; // initial 
+    };
+
+    Steel02(int tag, const SharedParameters<Parameters> &theParameters);
+
+    SharedParameters<Parameters> par;
+
 	 double EnergyP; //by SAJalali
-	 // matpar : STEEL FIXED PROPERTIES
-    double Fy;  //  = matpar(1)  : yield stress
-    double E0;  //  = matpar(2)  : initial stiffness
-    double b;   //  = matpar(3)  : hardening ratio (Esh/E0)
-    double R0;  //  = matpar(4)  : exp transition elastic-plastic
-    double cR1; //  = matpar(5)  : coefficient for changing R0 to R
-    double cR2; //  = matpar(6)  : coefficient for changing R0 to R
-    double a1;  //  = matpar(7)  : coefficient for isotropic hardening in compression
-    double a2;  //  = matpar(8)  : coefficient for isotropic hardening in compression
-    double a3;  //  = matpar(9)  : coefficient for isotropic hardening in tension
-    double a4;  //  = matpar(10) : coefficient for isotropic hardening in tension
-    double sigini; // initial 
     // hstvP : STEEL HISTORY VARIABLES
     double epsminP; //  = hstvP(1) : max eps in compression
     double epsmaxP; //  = hstvP(2) : max eps in tension
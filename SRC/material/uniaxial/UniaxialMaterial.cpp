@@ -227,6 +227,14 @@ UniaxialMaterial::getRho(void)
 	return 0.0;
 }
 
+// default operation, no range of linear response is known
+int
+UniaxialMaterial::getElasticRange(double &strainMin, double &strainMax,
+				  double &sigma0, double &tangent)
+{
+  return -1;
+}
+
 UniaxialMaterial*
 UniaxialMaterial::getCopy(SectionForceDeformation* s)
 {
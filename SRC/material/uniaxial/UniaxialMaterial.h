@@ -84,6 +84,13 @@ class UniaxialMaterial : public Material
     virtual int getResponse (int responseID, Information &matInformation);    
     virtual bool hasFailed(void) {return false;}
 
+    // if, from its last committed state, the stress of the material is
+    // sigma0 + tangent*strain for the strains in [strainMin, strainMax],
+    // sets them and returns 0; returns -1 otherwise. the range holds
+    // until the next commit, which may move it
+    virtual int getElasticRange(double &strainMin, double &strainMax,
+				double &sigma0, double &tangent);
+
     // AddingSensitivity:BEGIN //////////////////////////////////////////
     virtual double getStressSensitivity     (int gradIndex, bool conditional);
     virtual double getStrainSensitivity     (int gradIndex);
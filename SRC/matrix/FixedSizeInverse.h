@@ -0,0 +1,106 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains invertFixedSize(), which inverts an
+// N by N matrix whose size is known at compile time. It is intended for
+// the small matrices, 3 by 3 to 6 by 6, inverted in the inner loops of
+// element state determination, where the work arrays and the call to
+// LAPACK made by Matrix::Solve() cost more than the inversion itself.
+// The matrix is reduced by Gauss-Jordan elimination with partial
+// pivoting in an array on the stack; with N known the loops unroll.
+//
+// The N*N entries may be stored by row or by column, the inverse being
+// returned in the same order, e.g. for a Matrix f of size N by N:
+//
+//   if (invertFixedSize<N>(&f(0,0), &fInv(0,0)) < 0)
+//     ... f is singular
+//
+#ifndef FixedSizeInverse_h
+#define FixedSizeInverse_h
+
+#include <math.h>
+
+// sets Ainv to the inverse of A; returns 0 if successful, -1 if A is
+// singular, in which case Ainv is left undefined. A and Ainv may be the
+// same array.
+template <int N>
+inline int
+invertFixedSize(const double *A, double *Ainv)
+{
+  double a[N*N];
+  int pivot[N];
+
+  for (int k = 0; k < N*N; k++)
+    a[k] = A[k];
+
+  for (int k = 0; k < N; k++) {
+
+    // row with the largest entry in column k
+    int p = k;
+    double max = fabs(a[k+k*N]);
+    for (int i = k+1; i < N; i++)
+      if (fabs(a[i+k*N]) > max) {
+	max = fabs(a[i+k*N]);
+	p = i;
+      }
+    if (max == 0.0)
+      return -1;
+
+    pivot[k] = p;
+    if (p != k)
+      for (int j = 0; j < N; j++) {
+	double t = a[k+j*N];
+	a[k+j*N] = a[p+j*N];
+	a[p+j*N] = t;
+      }
+
+    double d = 1.0/a[k+k*N];
+    a[k+k*N] = 1.0;
+    for (int j = 0; j < N; j++)
+      a[k+j*N] *= d;
+
+    for (int i = 0; i < N; i++) {
+      if (i == k)
+	continue;
+      double t = a[i+k*N];
+      a[i+k*N] = 0.0;
+      for (int j = 0; j < N; j++)
+	a[i+j*N] -= t*a[k+j*N];
+    }
+  }
+
+  // the row interchanges become column interchanges of the inverse
+  for (int k = N-1; k >= 0; k--) {
+    int p = pivot[k];
+    if (p != k)
+      for (int i = 0; i < N; i++) {
+	double t = a[i+k*N];
+	a[i+k*N] = a[i+p*N];
+	a[i+p*N] = t;
+      }
+  }
+
+  for (int k = 0; k < N*N; k++)
+    Ainv[k] = a[k];
+
+  return 0;
+}
+
+#endif
@@ -97,6 +97,7 @@ class ID
     friend class MPI_Channel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
+    friend class SharedMemoryChannel;
     
   private:
     static int ID_NOT_VALID_ENTRY;
@@ -34,23 +34,19 @@
 #include "Matrix.h"
 #include "Vector.h"
 #include "ID.h"
+#include "ScratchArena.h"
 
 #include <stdlib.h>
 #include <iostream>
 using std::nothrow;
 
-#define MATRIX_WORK_AREA 400
-#define INT_WORK_AREA 20
-
 #include <math.h>
 
-int Matrix::sizeDoubleWork = MATRIX_WORK_AREA;
-int Matrix::sizeIntWork = INT_WORK_AREA;
 double Matrix::MATRIX_NOT_VALID_ENTRY =0.0;
-double *Matrix::matrixWork = 0;
-int    *Matrix::intWork =0;
 
-//double *Matrix::matrixWork = (double *)malloc(400*sizeof(double));
+// slot of the work areas used by Solve(), Invert() and
+// addMatrixTripleProduct(); each thread has its own
+static const int workSlot = ScratchArena::newSlot();
 
 //
 // CONSTRUCTORS
@@ -62,15 +58,6 @@ Matrix::Matrix()
 	, IsDiagonal(-1)
 #endif // _CSS
 {
-	// allocate work areas if the first
-	if (matrixWork == 0) {
-		matrixWork = new (nothrow) double[sizeDoubleWork];
-		intWork = new (nothrow) int[sizeIntWork];
-		if (matrixWork == 0 || intWork == 0) {
-			opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-			exit(-1);
-		}
-	}
 }
 
 
@@ -81,16 +68,6 @@ Matrix::Matrix(int nRows, int nCols)
 #endif // _CSS
 {
 
-	// allocate work areas if the first matrix
-	if (matrixWork == 0) {
-		matrixWork = new (nothrow) double[sizeDoubleWork];
-		intWork = new (nothrow) int[sizeIntWork];
-		if (matrixWork == 0 || intWork == 0) {
-			opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-			exit(-1);
-		}
-	}
-
 #ifdef _G3DEBUG
 	if (nRows < 0) {
 		opserr << "WARNING: Matrix::Matrix(int,int): tried to init matrix ";
@@ -129,16 +106,6 @@ Matrix::Matrix(double *theData, int row, int col)
 , IsDiagonal(-1)
 #endif // _CSS
 {
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
-
 #ifdef _G3DEBUG
     if (row < 0) {
       opserr << "WARNING: Matrix::Matrix(int,int): tried to init matrix with numRows: ";
@@ -161,16 +128,6 @@ Matrix::Matrix(const Matrix &other)
 , IsDiagonal(other.isDiagonal())
 #endif // _CSS
 {
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
-
     numRows = other.numRows;
     numCols = other.numCols;
     dataSize = other.dataSize;
@@ -426,38 +383,13 @@ Matrix::Solve(const Vector &b, Vector &x) const
     }
 #endif
     
-    // check work area can hold all the data
-    if (dataSize > sizeDoubleWork) {
-
-      if (matrixWork != 0) {
-	delete [] matrixWork;
-        matrixWork = 0;
-      }
-      matrixWork = new (nothrow) double[dataSize];
-      sizeDoubleWork = dataSize;
-      
-      if (matrixWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeDoubleWork = 0;      
-	return -3;
-      }
-    }
-
-    // check work area can hold all the data
-    if (n > sizeIntWork) {
-
-      if (intWork != 0) {
-	delete [] intWork;
-        intWork = 0;
-      }
-      intWork = new (nothrow) int[n];
-      sizeIntWork = n;
-      
-      if (intWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeIntWork = 0;      
-	return -3;
-      }
+    // get the work areas of the calling thread
+    ScratchArena &theArena = ScratchArena::local();
+    double *matrixWork = theArena.getDoubles(workSlot, dataSize);
+    int *intWork = theArena.getInts(workSlot, n);
+    if (matrixWork == 0 || intWork == 0) {
+      opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
+      return -3;
     }
 
     
@@ -527,38 +459,13 @@ Matrix::Solve(const Matrix &b, Matrix &x) const
     }
 #endif
 
-    // check work area can hold all the data
-    if (dataSize > sizeDoubleWork) {
-
-      if (matrixWork != 0) {
-	delete [] matrixWork;
-        matrixWork = 0;
-      }
-      matrixWork = new (nothrow) double[dataSize];
-      sizeDoubleWork = dataSize;
-      
-      if (matrixWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeDoubleWork = 0;      
-	return -3;
-      }
-    }
-
-    // check work area can hold all the data
-    if (n > sizeIntWork) {
-
-      if (intWork != 0) {
-	delete [] intWork;
-        intWork = 0;
-      }
-      intWork = new (nothrow) int[n];
-      sizeIntWork = n;
-      
-      if (intWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeIntWork = 0;      
-	return -3;
-      }
+    // get the work areas of the calling thread
+    ScratchArena &theArena = ScratchArena::local();
+    double *matrixWork = theArena.getDoubles(workSlot, dataSize);
+    int *intWork = theArena.getInts(workSlot, n);
+    if (matrixWork == 0 || intWork == 0) {
+      opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
+      return -3;
     }
     
     x = b;
@@ -633,38 +540,13 @@ Matrix::Invert(Matrix &theInverse) const
     }
 #endif
 
-    // check work area can hold all the data
-    if (dataSize > sizeDoubleWork) {
-
-      if (matrixWork != 0) {
-	delete [] matrixWork;
-        matrixWork = 0;
-      }
-      matrixWork = new (nothrow) double[dataSize];
-      sizeDoubleWork = dataSize;
-      
-      if (matrixWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeDoubleWork = 0;      
-	return -3;
-      }
-    }
-
-    // check work area can hold all the data
-    if (n > sizeIntWork) {
-
-      if (intWork != 0) {
-	delete [] intWork;
-        intWork = 0;
-      }
-      intWork = new (nothrow) int[n];
-      sizeIntWork = n;
-      
-      if (intWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeIntWork = 0;      
-	return -3;
-      }
+    // get the work areas of the calling thread
+    ScratchArena &theArena = ScratchArena::local();
+    double *matrixWork = theArena.getDoubles(workSlot, dataSize);
+    int *intWork = theArena.getInts(workSlot, n);
+    if (matrixWork == 0 || intWork == 0) {
+      opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
+      return -3;
     }
     
     // copy the data
@@ -677,7 +559,7 @@ Matrix::Invert(Matrix &theInverse) const
     int info = 0;
     double *Wptr = matrixWork;
     double *Aptr = theInverse.data;
-    int workSize = sizeDoubleWork;
+    int workSize = dataSize;
     
     int *iPIV = intWork;
     
@@ -1045,7 +927,8 @@ Matrix::addMatrixTripleProduct(double thisFact,
     int dimB = B.numCols;
     int sizeWork = dimB * numCols;
 
-    if (sizeWork > sizeDoubleWork) {
+    double *matrixWork = ScratchArena::local().getDoubles(workSlot, sizeWork);
+    if (matrixWork == 0) {
       this->addMatrix(thisFact, T^B*T, otherFact);
       return 0;
     }
@@ -1147,7 +1030,8 @@ Matrix::addMatrixTripleProduct(double thisFact,
     // cheack work area can hold the temporary matrix
     int sizeWork = B.numRows * numCols;
 
-    if (sizeWork > sizeDoubleWork) {
+    double *matrixWork = ScratchArena::local().getDoubles(workSlot, sizeWork);
+    if (matrixWork == 0) {
       this->addMatrix(thisFact, A^B*C, otherFact);
       return 0;
     }
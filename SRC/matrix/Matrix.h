@@ -163,6 +163,7 @@ class Matrix
     friend class MPI_Channel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
+    friend class SharedMemoryChannel;
 
   protected:
 
@@ -171,10 +172,6 @@ class Matrix
 	  int IsDiagonal;	//1:true, 0: flase, -1:not determined
 #endif
     static double MATRIX_NOT_VALID_ENTRY;
-    static double *matrixWork;
-    static int *intWork;
-    static int sizeDoubleWork;
-    static int sizeIntWork;
 
     int numRows;
     int numCols;
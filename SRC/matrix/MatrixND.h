@@ -0,0 +1,200 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the definition of MatrixND, an NR by NC
+// matrix of doubles whose size is known at compile time, for the small
+// matrices of element and coordinate transformation kernels. Like
+// VectorND it has no constructors and holds its values in place, by
+// column as in Matrix; MatrixND<NR,NC> A{}; is a zero matrix on the
+// stack. Its products loop over the compile-time sizes, which the
+// compiler unrolls, rather than going through the run-time sized, and
+// with _G3DEBUG bounds checked, loops of Matrix. A MatrixND converts to
+// a Matrix that refers to its values, and is set from a Matrix of the
+// same size:
+//
+//   MatrixND<6,6> D;
+//   D = theMaterial->getTangent();    // copies the 36 values
+//   K.addMatrixTripleProduct(0.0, B, D, dV);
+//   theMatrix = K;                    // K is viewed as a Matrix
+//
+#ifndef MatrixND_h
+#define MatrixND_h
+
+#include <Matrix.h>
+#include <VectorND.h>
+#include <FixedSizeInverse.h>
+#include <OPS_Globals.h>
+
+template <int NR, int NC>
+struct MatrixND
+{
+  double values[NC][NR];
+
+  int noRows(void) const {return NR;}
+  int noCols(void) const {return NC;}
+
+  double &operator()(int i, int j) {return values[j][i];}
+  double operator()(int i, int j) const {return values[j][i];}
+
+  // a Matrix referring to the values of this MatrixND
+  operator Matrix() {return Matrix(&values[0][0], NR, NC);}
+  operator const Matrix() const {return Matrix(const_cast<double *>(&values[0][0]), NR, NC);}
+
+  MatrixND &operator=(const Matrix &other) {
+    if (other.noRows() != NR || other.noCols() != NC) {
+      opserr << "MatrixND::operator=() - size mismatch, " << NR << "x" << NC
+	     << " and " << other.noRows() << "x" << other.noCols() << endln;
+      return *this;
+    }
+    for (int j = 0; j < NC; j++)
+      for (int i = 0; i < NR; i++)
+	values[j][i] = other(i,j);
+    return *this;
+  }
+
+  void Zero(void) {
+    for (int j = 0; j < NC; j++)
+      for (int i = 0; i < NR; i++)
+	values[j][i] = 0.0;
+  }
+
+  MatrixND &operator*=(double fact) {
+    for (int j = 0; j < NC; j++)
+      for (int i = 0; i < NR; i++)
+	values[j][i] *= fact;
+    return *this;
+  }
+
+  MatrixND &operator+=(const MatrixND &other) {
+    for (int j = 0; j < NC; j++)
+      for (int i = 0; i < NR; i++)
+	values[j][i] += other.values[j][i];
+    return *this;
+  }
+
+  MatrixND &operator-=(const MatrixND &other) {
+    for (int j = 0; j < NC; j++)
+      for (int i = 0; i < NR; i++)
+	values[j][i] -= other.values[j][i];
+    return *this;
+  }
+
+  MatrixND<NC,NR> transpose(void) const {
+    MatrixND<NC,NR> t;
+    for (int j = 0; j < NC; j++)
+      for (int i = 0; i < NR; i++)
+	t.values[i][j] = values[j][i];
+    return t;
+  }
+
+  // this = thisFact*this + otherFact*other
+  void addMatrix(double thisFact, const MatrixND &other, double otherFact) {
+    if (thisFact == 0.0)
+      this->Zero();
+    for (int j = 0; j < NC; j++)
+      for (int i = 0; i < NR; i++)
+	values[j][i] = thisFact*values[j][i] + otherFact*other.values[j][i];
+  }
+
+  // this = thisFact*this + otherFact*other, for a Matrix of the same size
+  void addMatrix(double thisFact, const Matrix &other, double otherFact) {
+    if (other.noRows() != NR || other.noCols() != NC) {
+      opserr << "MatrixND::addMatrix() - size mismatch, " << NR << "x" << NC
+	     << " and " << other.noRows() << "x" << other.noCols() << endln;
+      return;
+    }
+    if (thisFact == 0.0)
+      this->Zero();
+    for (int j = 0; j < NC; j++)
+      for (int i = 0; i < NR; i++)
+	values[j][i] = thisFact*values[j][i] + otherFact*other(i,j);
+  }
+
+  // this = thisFact*this + fact*A*B
+  template <int NK>
+  void addMatrixProduct(double thisFact, const MatrixND<NR,NK> &A,
+			const MatrixND<NK,NC> &B, double fact) {
+    for (int j = 0; j < NC; j++) {
+      double sum[NR];
+      for (int i = 0; i < NR; i++)
+	sum[i] = 0.0;
+      for (int k = 0; k < NK; k++) {
+	double bkj = B.values[j][k];
+	for (int i = 0; i < NR; i++)
+	  sum[i] += A.values[k][i]*bkj;
+      }
+      if (thisFact == 0.0)
+	for (int i = 0; i < NR; i++)
+	  values[j][i] = fact*sum[i];
+      else
+	for (int i = 0; i < NR; i++)
+	  values[j][i] = thisFact*values[j][i] + fact*sum[i];
+    }
+  }
+
+  // this = thisFact*this + fact*A'*B
+  template <int NK>
+  void addMatrixTransposeProduct(double thisFact, const MatrixND<NK,NR> &A,
+				 const MatrixND<NK,NC> &B, double fact) {
+    for (int j = 0; j < NC; j++)
+      for (int i = 0; i < NR; i++) {
+	double sum = 0.0;
+	for (int k = 0; k < NK; k++)
+	  sum += A.values[i][k]*B.values[j][k];
+	if (thisFact == 0.0)
+	  values[j][i] = fact*sum;
+	else
+	  values[j][i] = thisFact*values[j][i] + fact*sum;
+      }
+  }
+
+  // this = thisFact*this + fact*T'*B*T, for a square this
+  template <int NK>
+  void addMatrixTripleProduct(double thisFact, const MatrixND<NK,NR> &T,
+			      const MatrixND<NK,NK> &B, double fact) {
+    MatrixND<NK,NC> BT;
+    BT.addMatrixProduct(0.0, B, T, 1.0);
+    this->addMatrixTransposeProduct(thisFact, T, BT, fact);
+  }
+
+  // adds fact*M to the block of this matrix starting at (row,col)
+  template <int nr, int nc>
+  void Assemble(const MatrixND<nr,nc> &M, int row, int col, double fact) {
+    for (int j = 0; j < nc; j++)
+      for (int i = 0; i < nr; i++)
+	values[col+j][row+i] += fact*M.values[j][i];
+  }
+
+  // adds fact*M' to the block of this matrix starting at (row,col)
+  template <int nr, int nc>
+  void AssembleTranspose(const MatrixND<nr,nc> &M, int row, int col, double fact) {
+    for (int j = 0; j < nc; j++)
+      for (int i = 0; i < nr; i++)
+	values[col+i][row+j] += fact*M.values[j][i];
+  }
+
+  // sets res to the inverse of this square matrix; returns 0 if
+  // successful, -1 if this matrix is singular
+  int Invert(MatrixND &res) const {
+    return invertFixedSize<NR>(&values[0][0], &res.values[0][0]);
+  }
+};
+
+#endif
@@ -0,0 +1,92 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of ScratchArena.
+//
+#include <ScratchArena.h>
+#include <atomic>
+#include <new>
+
+ScratchArena &
+ScratchArena::local(void)
+{
+  thread_local ScratchArena theArena;
+  return theArena;
+}
+
+int
+ScratchArena::newSlot(void)
+{
+  static std::atomic<int> numSlots(0);
+  return numSlots++;
+}
+
+ScratchArena::ScratchArena()
+{
+
+}
+
+ScratchArena::~ScratchArena()
+{
+  for (Entry &theEntry : theEntries) {
+    if (theEntry.object != 0)
+      (*theEntry.destroy)(theEntry.object);
+    if (theEntry.doubles != 0)
+      delete [] theEntry.doubles;
+    if (theEntry.ints != 0)
+      delete [] theEntry.ints;
+  }
+}
+
+ScratchArena::Entry &
+ScratchArena::getEntry(int slot)
+{
+  if (slot >= (int)theEntries.size()) {
+    Entry empty = {0, 0, 0, 0, 0, 0};
+    theEntries.resize(slot+1, empty);
+  }
+  return theEntries[slot];
+}
+
+double *
+ScratchArena::getDoubles(int slot, int size)
+{
+  Entry &theEntry = this->getEntry(slot);
+  if (size > theEntry.numDoubles) {
+    if (theEntry.doubles != 0)
+      delete [] theEntry.doubles;
+    theEntry.doubles = new (std::nothrow) double[size];
+    theEntry.numDoubles = (theEntry.doubles != 0) ? size : 0;
+  }
+  return theEntry.doubles;
+}
+
+int *
+ScratchArena::getInts(int slot, int size)
+{
+  Entry &theEntry = this->getEntry(slot);
+  if (size > theEntry.numInts) {
+    if (theEntry.ints != 0)
+      delete [] theEntry.ints;
+    theEntry.ints = new (std::nothrow) int[size];
+    theEntry.numInts = (theEntry.ints != 0) ? size : 0;
+  }
+  return theEntry.ints;
+}
@@ -0,0 +1,97 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for ScratchArena.
+// A ScratchArena holds the temporary work storage of the calling thread.
+// Classes that previously kept class-wide static work matrices, vectors
+// and arrays obtain a slot once, and then ask the arena of the current
+// thread for the object or buffer registered under that slot. Each thread
+// thereby gets its own copy, so element and section state determination
+// may be performed concurrently.
+//
+// Typical use:
+//
+//   static const int workSlot = ScratchArena::newSlot();
+//   ...
+//   MyWork &work = ScratchArena::local().get<MyWork>(workSlot);
+//
+#ifndef ScratchArena_h
+#define ScratchArena_h
+
+#include <vector>
+
+class ScratchArena
+{
+  public:
+    // the arena of the calling thread
+    static ScratchArena &local(void);
+
+    // a new process-wide slot identifier
+    static int newSlot(void);
+
+    // the object of type T held in the slot, default constructed on
+    // first use by this thread; a slot must always be used with one type
+    template <class T> T &get(int slot);
+
+    // work arrays of at least the requested size; the contents are not
+    // preserved when an array grows. 0 is returned if out of memory.
+    double *getDoubles(int slot, int size);
+    int    *getInts(int slot, int size);
+
+  private:
+    ScratchArena();
+    ~ScratchArena();
+    ScratchArena(const ScratchArena &);
+    ScratchArena &operator=(const ScratchArena &);
+
+    struct Entry {
+      void   *object;
+      void  (*destroy)(void *);
+      double *doubles;
+      int     numDoubles;
+      int    *ints;
+      int     numInts;
+    };
+
+    Entry &getEntry(int slot);
+
+    template <class T> static void destroyObject(void *object);
+
+    std::vector<Entry> theEntries;
+};
+
+template <class T> T &
+ScratchArena::get(int slot)
+{
+  Entry &theEntry = this->getEntry(slot);
+  if (theEntry.object == 0) {
+    theEntry.object  = new T();
+    theEntry.destroy = &ScratchArena::destroyObject<T>;
+  }
+  return *static_cast<T *>(theEntry.object);
+}
+
+template <class T> void
+ScratchArena::destroyObject(void *object)
+{
+  delete static_cast<T *>(object);
+}
+
+#endif
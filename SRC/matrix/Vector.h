@@ -148,6 +148,7 @@ class Vector
     friend class MPI_Channel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
+    friend class SharedMemoryChannel;
     
   private:
     static double VECTOR_NOT_VALID_ENTRY;
@@ -0,0 +1,182 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the definition of VectorND, a vector of
+// N doubles whose size is known at compile time. A VectorND has no
+// constructors and holds its values in place, so that it lives on the
+// stack of the function using it and is zeroed by VectorND<N> v{};
+// Its kernels loop over the compile-time size and are unrolled by the
+// compiler. It converts to a Vector that refers to its values, so that
+// it may be passed wherever a Vector is expected, and it is set from a
+// Vector of the same size:
+//
+//   VectorND<3> v{};
+//   v = theNode->getTrialDisp();     // copies the 3 values
+//   theVector.addVector(1.0, v, 2.0); // v is viewed as a Vector
+//
+#ifndef VectorND_h
+#define VectorND_h
+
+#include <Vector.h>
+#include <OPS_Globals.h>
+#include <math.h>
+
+template <int NR, int NC> struct MatrixND;
+
+template <int N>
+struct VectorND
+{
+  double values[N];
+
+  int Size(void) const {return N;}
+
+  double &operator()(int i) {return values[i];}
+  double operator()(int i) const {return values[i];}
+  double &operator[](int i) {return values[i];}
+  double operator[](int i) const {return values[i];}
+
+  // a Vector referring to the values of this VectorND
+  operator Vector() {return Vector(values, N);}
+  operator const Vector() const {return Vector(const_cast<double *>(values), N);}
+
+  VectorND &operator=(const Vector &other) {
+    if (other.Size() != N) {
+      opserr << "VectorND::operator=() - size mismatch, " << N
+	     << " and " << other.Size() << endln;
+      return *this;
+    }
+    for (int i = 0; i < N; i++)
+      values[i] = other(i);
+    return *this;
+  }
+
+  void Zero(void) {
+    for (int i = 0; i < N; i++)
+      values[i] = 0.0;
+  }
+
+  VectorND &operator*=(double fact) {
+    for (int i = 0; i < N; i++)
+      values[i] *= fact;
+    return *this;
+  }
+
+  VectorND &operator/=(double fact) {
+    for (int i = 0; i < N; i++)
+      values[i] /= fact;
+    return *this;
+  }
+
+  VectorND &operator+=(const VectorND &other) {
+    for (int i = 0; i < N; i++)
+      values[i] += other.values[i];
+    return *this;
+  }
+
+  VectorND &operator-=(const VectorND &other) {
+    for (int i = 0; i < N; i++)
+      values[i] -= other.values[i];
+    return *this;
+  }
+
+  // adds a Vector of the same size, e.g. a damping force
+  VectorND &operator+=(const Vector &other) {
+    if (other.Size() != N) {
+      opserr << "VectorND::operator+=() - size mismatch, " << N
+	     << " and " << other.Size() << endln;
+      return *this;
+    }
+    for (int i = 0; i < N; i++)
+      values[i] += other(i);
+    return *this;
+  }
+
+  VectorND &operator-=(const Vector &other) {
+    if (other.Size() != N) {
+      opserr << "VectorND::operator-=() - size mismatch, " << N
+	     << " and " << other.Size() << endln;
+      return *this;
+    }
+    for (int i = 0; i < N; i++)
+      values[i] -= other(i);
+    return *this;
+  }
+
+  double dot(const VectorND &other) const {
+    double sum = 0.0;
+    for (int i = 0; i < N; i++)
+      sum += values[i]*other.values[i];
+    return sum;
+  }
+
+  double Norm(void) const {
+    return sqrt(this->dot(*this));
+  }
+
+  // this = thisFact*this + otherFact*other
+  void addVector(double thisFact, const VectorND &other, double otherFact) {
+    if (thisFact == 0.0)
+      this->Zero();
+    for (int i = 0; i < N; i++)
+      values[i] = thisFact*values[i] + otherFact*other.values[i];
+  }
+
+  // this = thisFact*this + fact*A*x
+  template <int NC>
+  void addMatrixVector(double thisFact, const MatrixND<N,NC> &A,
+		       const VectorND<NC> &x, double fact) {
+    if (thisFact == 0.0)
+      this->Zero();
+    for (int i = 0; i < N; i++)
+      values[i] *= thisFact;
+    for (int j = 0; j < NC; j++) {
+      double xj = fact*x.values[j];
+      for (int i = 0; i < N; i++)
+	values[i] += A.values[j][i]*xj;
+    }
+  }
+
+  // this = thisFact*this + fact*A'*x
+  template <int NR>
+  void addMatrixTransposeVector(double thisFact, const MatrixND<NR,N> &A,
+				const VectorND<NR> &x, double fact) {
+    if (thisFact == 0.0)
+      this->Zero();
+    for (int j = 0; j < N; j++) {
+      double sum = 0.0;
+      for (int i = 0; i < NR; i++)
+	sum += A.values[j][i]*x.values[i];
+      values[j] = thisFact*values[j] + fact*sum;
+    }
+  }
+};
+
+// cross product of two vectors of size 3
+inline VectorND<3>
+cross(const VectorND<3> &a, const VectorND<3> &b)
+{
+  VectorND<3> c;
+  c.values[0] = a.values[1]*b.values[2] - a.values[2]*b.values[1];
+  c.values[1] = a.values[2]*b.values[0] - a.values[0]*b.values[2];
+  c.values[2] = a.values[0]*b.values[1] - a.values[1]*b.values[0];
+  return c;
+}
+
+#endif
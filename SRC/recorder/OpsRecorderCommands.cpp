@@ -101,6 +101,7 @@
 #include <DataFileStreamAdd.h>
 #include <XmlFileStream.h>
 #include <BinaryFileStream.h>
+#include <ColumnarFileStream.h>
 #include <DatabaseStream.h>
 #include <DummyStream.h>
 #include <TCP_Stream.h>
@@ -124,9 +125,9 @@ typedef struct externalRecorderCommand {
 static ExternalRecorderCommand* theExternalRecorderCommands = NULL;
 
 #ifdef _CSS
-enum outputMode { No_Output, STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, DATA_STREAM_ADD };
+enum outputMode { No_Output, STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, DATA_STREAM_ADD, COLUMNAR_STREAM };
 #else
-enum outputMode { STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, DATA_STREAM_ADD };
+enum outputMode { STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, DATA_STREAM_ADD, COLUMNAR_STREAM };
 #endif
 
 #include <SimulationInformation.h>
@@ -163,6 +164,9 @@ void* OPS_NodeRecorder(const char* type)
 
 	 bool closeOnWrite = false;
 
+	 bool singlePrecision = false;
+	 bool doCompress = false;
+
 	 const char* inetAddr = 0;
 	 int inetPort;
 
@@ -230,6 +234,18 @@ void* OPS_NodeRecorder(const char* type)
 				}
 				eMode = BINARY_STREAM;
 		  }
+		  else if (strcmp(option, "-columnar") == 0) {
+				if (OPS_GetNumRemainingInputArgs() > 0) {
+					 filename = OPS_GetString();
+				}
+				eMode = COLUMNAR_STREAM;
+		  }
+		  else if (strcmp(option, "-float32") == 0) {
+				singlePrecision = true;
+		  }
+		  else if (strcmp(option, "-compress") == 0) {
+				doCompress = true;
+		  }
 		  else if (strcmp(option, "-dT") == 0) {
 				if (OPS_GetNumRemainingInputArgs() > 0) {
 					 if (OPS_GetDoubleInput(&numData, &dT) < 0) {
@@ -391,6 +407,8 @@ void* OPS_NodeRecorder(const char* type)
 	 //    theOutputStream = new DatabaseStream(theDatabase, tableName);
 	 else if (eMode == BINARY_STREAM && filename != 0)
 		  theOutputStream = new BinaryFileStream(filename);
+	 else if (eMode == COLUMNAR_STREAM && filename != 0)
+		  theOutputStream = new ColumnarFileStream(filename, OVERWRITE, singlePrecision, doCompress);
 	 else if (eMode == TCP_STREAM && inetAddr != 0)
 		  theOutputStream = new TCP_Stream(inetPort, inetAddr);
 	 if (theOutputStream != 0)
@@ -441,6 +459,9 @@ void* OPS_ElementRecorder(const char* type)
 
 	 bool closeOnWrite = false;
 
+	 bool singlePrecision = false;
+	 bool doCompress = false;
+
 	 const char* inetAddr = 0;
 	 int inetPort;
 
@@ -508,6 +529,18 @@ void* OPS_ElementRecorder(const char* type)
 				}
 				eMode = BINARY_STREAM;
 		  }
+		  else if (strcmp(option, "-columnar") == 0) {
+				if (OPS_GetNumRemainingInputArgs() > 0) {
+					 filename = OPS_GetString();
+				}
+				eMode = COLUMNAR_STREAM;
+		  }
+		  else if (strcmp(option, "-float32") == 0) {
+				singlePrecision = true;
+		  }
+		  else if (strcmp(option, "-compress") == 0) {
+				doCompress = true;
+		  }
 		  else if (strcmp(option, "-dT") == 0) {
 				if (OPS_GetNumRemainingInputArgs() > 0) {
 
@@ -663,6 +696,8 @@ void* OPS_ElementRecorder(const char* type)
 	 //    theOutputStream = new DatabaseStream(theDatabase, tableName);
 	 else if (eMode == BINARY_STREAM && filename != 0)
 		  theOutputStream = new BinaryFileStream(filename);
+	 else if (eMode == COLUMNAR_STREAM && filename != 0)
+		  theOutputStream = new ColumnarFileStream(filename, OVERWRITE, singlePrecision, doCompress);
 	 else if (eMode == TCP_STREAM && inetAddr != 0)
 		  theOutputStream = new TCP_Stream(inetPort, inetAddr);
 	 if (theOutputStream != 0)
@@ -707,6 +742,8 @@ void* OPS_DriftRecorder(const char* type)
 	 int precision = 6;
 	 bool doScientific = false;
 	 bool closeOnWrite = false;
+	 bool singlePrecision = false;
+	 bool doCompress = false;
 	 int cntrlRcrdrTag = 0;
 	 int procDataMethod = 0;
 	 int nProcGrp = -1;
@@ -779,6 +816,21 @@ void* OPS_DriftRecorder(const char* type)
 				pos += 2;
 		  }
 
+		  else if ((strcmp(option, "-columnar") == 0)) {
+				fileName = OPS_GetString();
+				const char* pwd = OPS_GetInterpPWD();
+				simulationInfo.addOutputFile(fileName, pwd);
+				eMode = COLUMNAR_STREAM;
+		  }
+
+		  else if (strcmp(option, "-float32") == 0) {
+				singlePrecision = true;
+		  }
+
+		  else if (strcmp(option, "-compress") == 0) {
+				doCompress = true;
+		  }
+
 		  else if ((strcmp(option, "-nees") == 0) || (strcmp(option, "-xml") == 0)) {
 				// allow user to specify load pattern other than current
 				fileName = OPS_GetString();
@@ -876,6 +928,9 @@ void* OPS_DriftRecorder(const char* type)
 	 }*/ else if (eMode == BINARY_STREAM) {
 		  theOutputStream = new BinaryFileStream(fileName);
 	 }
+	 else if (eMode == COLUMNAR_STREAM && fileName != 0) {
+		  theOutputStream = new ColumnarFileStream(fileName, OVERWRITE, singlePrecision, doCompress);
+	 }
 	 if (theOutputStream != 0)
 		  theOutputStream->setPrecision(precision);
 	 // Subtract one from dof and perpDirn for C indexing
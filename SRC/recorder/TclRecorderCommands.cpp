@@ -101,6 +101,7 @@ extern void* OPS_NodeRecorderRMS();
 #include <DataFileStreamAdd.h>
 #include <XmlFileStream.h>
 #include <BinaryFileStream.h>
+#include <ColumnarFileStream.h>
 #include <DatabaseStream.h>
 #include <DummyStream.h>
 #include <TCP_Stream.h>
@@ -125,9 +126,9 @@ typedef struct externalRecorderCommand {
 static ExternalRecorderCommand* theExternalRecorderCommands = NULL;
 
 #ifdef _CSS
-enum outputMode { No_Output, STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, DATA_STREAM_ADD };
+enum outputMode { No_Output, STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, DATA_STREAM_ADD, COLUMNAR_STREAM };
 #else
-enum outputMode { STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, DATA_STREAM_ADD };
+enum outputMode { STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, DATA_STREAM_ADD, COLUMNAR_STREAM };
 #endif
 
 
@@ -219,12 +220,30 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp* interp, int argc,
 		  }
 
 
+		  bool columnar = false;
+		  bool singlePrecision = false;
+		  bool doCompress = false;
 		  if (strcmp(argv[loc], "-file") == 0) {
 				// allow user to specify load pattern other than current
 				loc++;
 				fileName = argv[loc];
 				loc++;
 		  }
+		  else if (strcmp(argv[loc], "-columnar") == 0) {
+				loc++;
+				fileName = argv[loc];
+				columnar = true;
+				loc++;
+				while (loc < argc) {
+					 if (strcmp(argv[loc], "-float32") == 0)
+						  singlePrecision = true;
+					 else if (strcmp(argv[loc], "-compress") == 0)
+						  doCompress = true;
+					 else
+						  break;
+					 loc++;
+				}
+		  }
 
 		  if (strcmp(argv[loc], "-section") != 0 && strcmp(argv[loc], "section") != 0) {
 				opserr << "WARNING recorder ElementDamage: Section keyword not specified ";
@@ -287,7 +306,11 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp* interp, int argc,
 
 		  //	const char **data = new const char *[argc-eleData];
 
-		  OPS_Stream* theOutput = new DataFileStream(fileName);
+		  OPS_Stream* theOutput;
+		  if (columnar)
+				theOutput = new ColumnarFileStream(fileName, OVERWRITE, singlePrecision, doCompress);
+		  else
+				theOutput = new DataFileStream(fileName);
 
 		  // now construct the recorder
 		  (*theRecorder) = new DamageRecorder(eleID, secIDs, dofID, dmgPTR, theDomain, echoTime, dT, rTolDt, *theOutput);
@@ -36,6 +36,8 @@
 
 #include <TransientIntegrator.h>
 #include <StaticIntegrator.h>
+#include <ThreadPool.h>
+#include <TclPackageClassBroker.h>
 
 // constraint handlers
 #include <PlainHandler.h>
@@ -458,6 +460,100 @@ resetModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** cons
 }
 
 
+//
+// restoreState id
+//
+// Goes back to a state of the domain kept by saveState; the transient
+// integrator takes its copy of the response, e.g. the U, Udot and Udotdot
+// of the Newmark family, from the restored nodes.
+//
+static int
+restoreDomainState(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const argv)
+{
+  assert(clientData != nullptr);
+  BasicAnalysisBuilder *builder = (BasicAnalysisBuilder*)clientData;
+
+  int id;
+  if (argc < 2 || Tcl_GetInt(interp, argv[1], &id) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "want - restoreState id\n";
+    return TCL_ERROR;
+  }
+
+  static TclPackageClassBroker theBroker;
+
+  Domain* domain = builder->getDomain();
+  assert(domain != nullptr);
+  if (domain->restoreState(id, theBroker) < 0) {
+    opserr << G3_ERROR_PROMPT << "restoreState - failed for state " << id << "\n";
+    return TCL_ERROR;
+  }
+
+  TransientIntegrator *theTransientIntegrator = builder->getTransientIntegrator();
+  if (builder->CurrentAnalysisFlag == BasicAnalysisBuilder::TRANSIENT_ANALYSIS &&
+      theTransientIntegrator != nullptr &&
+      theTransientIntegrator->domainChanged() < 0) {
+    opserr << G3_ERROR_PROMPT << "restoreState - the integrator failed to take state " << id << "\n";
+    return TCL_ERROR;
+  }
+
+  return TCL_OK;
+}
+
+
+//
+// threads <n>       set the number of threads used for element assembly
+//                   and the element update, commit and revert sweeps
+// threads           return the number of threads
+// threads -timing   return {coloring tangent residual numColors} for the
+//                   integrator of the current analysis
+//
+static int
+specifyThreads(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const argv)
+{
+  assert(clientData != nullptr);
+  BasicAnalysisBuilder *builder = (BasicAnalysisBuilder*)clientData;
+
+  if (argc < 2) {
+    Tcl_SetObjResult(interp, Tcl_NewIntObj(builder->getNumThreads()));
+    return TCL_OK;
+  }
+
+  if (strcmp(argv[1], "-timing") == 0) {
+    IncrementalIntegrator *theIntegrator = builder->getStaticIntegrator();
+    if (theIntegrator == nullptr)
+      theIntegrator = builder->getTransientIntegrator();
+
+    if (theIntegrator == nullptr) {
+      opserr << G3_ERROR_PROMPT << "no integrator has been specified\n";
+      return TCL_ERROR;
+    }
+
+    Tcl_Obj* list = Tcl_NewListObj(0, nullptr);
+    for (int i = 0; i < IncrementalIntegrator::NumAssemblyPhases; i++)
+      Tcl_ListObjAppendElement(interp, list, Tcl_NewDoubleObj(theIntegrator->getAssemblyTime(i)));
+    Tcl_ListObjAppendElement(interp, list, Tcl_NewIntObj(theIntegrator->getNumColors()));
+    Tcl_SetObjResult(interp, list);
+    return TCL_OK;
+  }
+
+  int numThreads;
+  if (Tcl_GetInt(interp, argv[1], &numThreads) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "threads failed to read number of threads \n";
+    return TCL_ERROR;
+  }
+  if (numThreads == 0)
+    numThreads = ThreadPool::getNumHardwareThreads();
+
+  if (numThreads < 0 || builder->setNumThreads(numThreads) != 0) {
+    opserr << G3_ERROR_PROMPT << "threads invalid number of threads " << argv[1] << "\n";
+    return TCL_ERROR;
+  }
+
+  Tcl_SetObjResult(interp, Tcl_NewIntObj(builder->getNumThreads()));
+  return TCL_OK;
+}
+
+
 int
 printIntegrator(ClientData clientData, Tcl_Interp *interp, int argc,
                 TCL_Char ** const argv, OPS_Stream &output)
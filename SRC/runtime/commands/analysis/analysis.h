@@ -22,6 +22,8 @@ static Tcl_CmdProc resetModel;
 static Tcl_CmdProc analyzeModel;
 static Tcl_CmdProc specifyConstraintHandler;
 static Tcl_CmdProc modalDamping;
+static Tcl_CmdProc specifyThreads;
+static Tcl_CmdProc restoreDomainState;
 
 // commands/analysis/integrator.cpp
 extern Tcl_CmdProc specifyIntegrator;
@@ -29,6 +31,7 @@ extern Tcl_CmdProc specifyIntegrator;
 // commands/analysis/solver.cpp
 extern Tcl_CmdProc specifySOE;
 extern Tcl_CmdProc specifySysOfEqnTable;
+extern Tcl_CmdProc TclCommand_solverStats;
 
 // commands/analysis/algorithm.cpp
 extern Tcl_CmdProc TclCommand_specifyAlgorithm;
@@ -49,6 +52,7 @@ struct char_cmd {
   Tcl_CmdProc*  func;
 }  const tcl_analysis_cmds[] =  {
     {"system",              &specifySysOfEqnTable},
+    {"solverStats",         &TclCommand_solverStats},
 
     {"test",                &specifyCTest},
     {"testIter",            &getCTestIter},
@@ -68,6 +72,8 @@ struct char_cmd {
     {"printA",              &printA},
     {"printB",              &printB},
     {"reset",               &resetModel},
+    {"threads",             &specifyThreads},
+    {"restoreState",        &restoreDomainState},
 
   // From algorithm.cpp
     {"algorithm",           &TclCommand_specifyAlgorithm},
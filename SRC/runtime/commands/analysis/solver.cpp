@@ -9,6 +9,7 @@
 //
 #include <string>
 #include <algorithm>
+#include <assert.h>
 #ifdef _MSC_VER 
 #  include <string.h>
 #  define strcasecmp _stricmp
@@ -38,6 +39,7 @@
 #include <SparseGenRowLinSOE.h>
 #include <SymSparseLinSOE.h>
 #include <SymSparseLinSolver.h>
+#include <LinearSOESolver.h>
 
 #ifdef _CUDA
 #  include <BandGenLinSOE_Single.h>
@@ -103,6 +105,44 @@ TclCommand_systemSize(ClientData clientData, Tcl_Interp *interp, int argc, TCL_C
 }
 #endif
 
+//
+// solverStats          return {symbolic numeric solve}, the number of
+//                      symbolic analyses, numeric factorizations and
+//                      solves performed by the solver of the current system
+// solverStats -reset   set the counts to zero
+//
+int
+TclCommand_solverStats(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const argv)
+{
+  assert(clientData != nullptr);
+  LinearSOE *theSOE = ((BasicAnalysisBuilder *)clientData)->getLinearSOE();
+
+  LinearSOESolver *theSolver = nullptr;
+  if (theSOE != nullptr)
+    theSolver = theSOE->getSolver();
+
+  if (theSolver == nullptr) {
+    opserr << G3_ERROR_PROMPT << "no system has been specified\n";
+    return TCL_ERROR;
+  }
+
+  if (argc > 1) {
+    if (strcmp(argv[1], "-reset") != 0) {
+      opserr << G3_ERROR_PROMPT << "solverStats unknown option " << argv[1] << "\n";
+      return TCL_ERROR;
+    }
+    theSolver->resetCounts();
+    return TCL_OK;
+  }
+
+  Tcl_Obj* list = Tcl_NewListObj(0, nullptr);
+  Tcl_ListObjAppendElement(interp, list, Tcl_NewIntObj(theSolver->getNumSymbolic()));
+  Tcl_ListObjAppendElement(interp, list, Tcl_NewIntObj(theSolver->getNumNumeric()));
+  Tcl_ListObjAppendElement(interp, list, Tcl_NewIntObj(theSolver->getNumSolve()));
+  Tcl_SetObjResult(interp, list);
+  return TCL_OK;
+}
+
 int
 specifySysOfEqnTable(ClientData clientData, Tcl_Interp *interp, int argc, G3_Char ** const argv)
 {
@@ -308,6 +348,187 @@ specifySparseGen(G3_Runtime* rt, int argc, G3_Char ** const argv)
 }
 
 
+#include <SupernodalSymLinSOE.h>
+#include <SupernodalSymLinSolver.h>
+
+LinearSOE*
+specifySupernodal(G3_Runtime* rt, int argc, G3_Char ** const argv)
+{
+  // system Supernodal <-ordering AMD|METIS> <-LDL> <-threads n> <-mixed>
+    Tcl_Interp *interp = G3_getInterpreter(rt);
+
+    int ordering = SupernodalSymLinSolver::ORDER_AMD;
+    bool ldlt = false;
+    bool mixed = false;
+    int numThreads = 1;
+
+    for (int count = 2; count < argc; count++) {
+      if ((strcmp(argv[count], "-LDL") == 0) ||
+          (strcmp(argv[count], "-ldl") == 0)) {
+        ldlt = true;
+
+      } else if (strcmp(argv[count], "-mixed") == 0) {
+        mixed = true;
+
+      } else if (strcmp(argv[count], "-ordering") == 0 && count+1 < argc) {
+        count++;
+        if (strcasecmp(argv[count], "METIS") == 0)
+          ordering = SupernodalSymLinSolver::ORDER_METIS;
+        else if (strcasecmp(argv[count], "AMD") == 0)
+          ordering = SupernodalSymLinSolver::ORDER_AMD;
+        else {
+          opserr << G3_ERROR_PROMPT << "system Supernodal - unknown ordering "
+                 << argv[count] << ", expected AMD or METIS\n";
+          return nullptr;
+        }
+
+      } else if (strcmp(argv[count], "-threads") == 0 && count+1 < argc) {
+        count++;
+        if (Tcl_GetInt(interp, argv[count], &numThreads) != TCL_OK) {
+          opserr << G3_ERROR_PROMPT << "system Supernodal - invalid -threads "
+                 << argv[count] << "\n";
+          return nullptr;
+        }
+
+      } else {
+        opserr << G3_ERROR_PROMPT << "system Supernodal - unknown option "
+               << argv[count] << "\n";
+        return nullptr;
+      }
+    }
+
+    SupernodalSymLinSolver *theSolver =
+      new SupernodalSymLinSolver(ordering, ldlt, numThreads, mixed);
+    return new SupernodalSymLinSOE(*theSolver);
+}
+
+
+#include <BandSPDLinSOE.h>
+#include <BandSPDLinLapackSolver.h>
+#include <BandGenLinSOE.h>
+#include <BandGenLinLapackSolver.h>
+
+// parses the options of the band systems; returns -1 if one is unknown
+static int
+parseBandOptions(const char *name, int argc, G3_Char ** const argv, bool &mixed)
+{
+    mixed = false;
+    for (int count = 2; count < argc; count++) {
+      if (strcmp(argv[count], "-mixed") == 0)
+        mixed = true;
+      else {
+        opserr << G3_ERROR_PROMPT << "system " << name << " - unknown option "
+               << argv[count] << "\n";
+        return -1;
+      }
+    }
+    return 0;
+}
+
+LinearSOE*
+specifyBandSPD(G3_Runtime* rt, int argc, G3_Char ** const argv)
+{
+  // system BandSPD <-mixed>
+    bool mixed;
+    if (parseBandOptions("BandSPD", argc, argv, mixed) < 0)
+      return nullptr;
+
+    return new BandSPDLinSOE(*(new BandSPDLinLapackSolver(mixed)));
+}
+
+LinearSOE*
+specifyBandGen(G3_Runtime* rt, int argc, G3_Char ** const argv)
+{
+  // system BandGeneral <-mixed>
+    bool mixed;
+    if (parseBandOptions("BandGeneral", argc, argv, mixed) < 0)
+      return nullptr;
+
+    return new BandGenLinSOE(*(new BandGenLinLapackSolver(mixed)));
+}
+
+
+#include <SparseGenRowAMGCLSolver.h>
+#include <SparseGenColAMGCLSolver.h>
+
+LinearSOE*
+specifyAMG(G3_Runtime* rt, int argc, G3_Char ** const argv)
+{
+  // system AMG <-cg|-bicgstab|-gmres> <-tol tol> <-maxIter n> <-restart m>
+  //            <-reuse n> <-col> <-print>
+    Tcl_Interp *interp = G3_getInterpreter(rt);
+
+    int method = AMGCLKrylov::GMRES;
+    double tol = 1.0e-8;
+    int maxIter = 500;
+    int restart = 30;
+    int maxReuse = 10;
+    bool byColumn = false;
+    bool print = false;
+
+    for (int count = 2; count < argc; count++) {
+      if (strcasecmp(argv[count], "-cg") == 0) {
+        method = AMGCLKrylov::CG;
+
+      } else if (strcasecmp(argv[count], "-bicgstab") == 0) {
+        method = AMGCLKrylov::BiCGStab;
+
+      } else if (strcasecmp(argv[count], "-gmres") == 0) {
+        method = AMGCLKrylov::GMRES;
+
+      } else if (strcmp(argv[count], "-col") == 0) {
+        byColumn = true;
+
+      } else if (strcmp(argv[count], "-print") == 0) {
+        print = true;
+
+      } else if (strcmp(argv[count], "-tol") == 0 && count+1 < argc) {
+        if (Tcl_GetDouble(interp, argv[++count], &tol) != TCL_OK) {
+          opserr << G3_ERROR_PROMPT << "system AMG - invalid -tol "
+                 << argv[count] << "\n";
+          return nullptr;
+        }
+
+      } else if (strcmp(argv[count], "-maxIter") == 0 && count+1 < argc) {
+        if (Tcl_GetInt(interp, argv[++count], &maxIter) != TCL_OK) {
+          opserr << G3_ERROR_PROMPT << "system AMG - invalid -maxIter "
+                 << argv[count] << "\n";
+          return nullptr;
+        }
+
+      } else if (strcmp(argv[count], "-restart") == 0 && count+1 < argc) {
+        if (Tcl_GetInt(interp, argv[++count], &restart) != TCL_OK) {
+          opserr << G3_ERROR_PROMPT << "system AMG - invalid -restart "
+                 << argv[count] << "\n";
+          return nullptr;
+        }
+
+      } else if (strcmp(argv[count], "-reuse") == 0 && count+1 < argc) {
+        if (Tcl_GetInt(interp, argv[++count], &maxReuse) != TCL_OK) {
+          opserr << G3_ERROR_PROMPT << "system AMG - invalid -reuse "
+                 << argv[count] << "\n";
+          return nullptr;
+        }
+
+      } else {
+        opserr << G3_ERROR_PROMPT << "system AMG - unknown option "
+               << argv[count] << "\n";
+        return nullptr;
+      }
+    }
+
+    if (byColumn) {
+      SparseGenColAMGCLSolver *theSolver =
+        new SparseGenColAMGCLSolver(method, tol, maxIter, restart, maxReuse, print);
+      return new SparseGenColLinSOE(*theSolver);
+    }
+
+    SparseGenRowAMGCLSolver *theSolver =
+      new SparseGenRowAMGCLSolver(method, tol, maxIter, restart, maxReuse, print);
+    return new SparseGenRowLinSOE(*theSolver);
+}
+
+
 #if 0 // Some misc solvers i play with
 
 else if (strcmp(argv[2],"Block") == 0) {
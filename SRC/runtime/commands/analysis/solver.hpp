@@ -96,6 +96,10 @@ typedef LinearSOE*(G3_SysOfEqnSpecifier)(G3_Runtime*, int, G3_Char**);
 // Specifiers defined in solver.cpp
 G3_SysOfEqnSpecifier specify_SparseSPD;
 G3_SysOfEqnSpecifier specifySparseGen;
+G3_SysOfEqnSpecifier specifySupernodal;
+G3_SysOfEqnSpecifier specifyAMG;
+G3_SysOfEqnSpecifier specifyBandSPD;
+G3_SysOfEqnSpecifier specifyBandGen;
 TclDispatch<LinearSOE*> TclDispatch_newMumpsLinearSOE;
 // TclDispatch<LinearSOE*> TclDispatch_newUmfpackLinearSOE;
 LinearSOE* TclDispatch_newUmfpackLinearSOE(ClientData, Tcl_Interp*, int, const char** const);
@@ -114,16 +118,16 @@ struct soefps {fn ss, sp, mp;};
 
 std::unordered_map<std::string, struct soefps> soe_table = {
   {"bandspd", {
-     G3_SOE(BandSPDLinLapackSolver,      BandSPDLinSOE),
+     specifyBandSPD,
      SP_SOE(BandSPDLinLapackSolver,      DistributedBandSPDLinSOE),
      MP_SOE(BandSPDLinLapackSolver,      DistributedBandSPDLinSOE)}},
 
   {"bandgeneral", { // BandGen, BandGEN
-     G3_SOE(BandGenLinLapackSolver,      BandGenLinSOE),
+     specifyBandGen,
      SP_SOE(BandGenLinLapackSolver,      DistributedBandGenLinSOE),
      MP_SOE(BandGenLinLapackSolver,      DistributedBandGenLinSOE)}},
   {"bandgen", { // BandGen, BandGEN
-     G3_SOE(BandGenLinLapackSolver,      BandGenLinSOE),
+     specifyBandGen,
      SP_SOE(BandGenLinLapackSolver,      DistributedBandGenLinSOE),
      MP_SOE(BandGenLinLapackSolver,      DistributedBandGenLinSOE)}},
 #if 0
@@ -145,6 +149,10 @@ std::unordered_map<std::string, struct soefps> soe_table = {
      // Legacy specifier
      specify_SparseSPD, nullptr, nullptr}},
 
+  {"supernodal",    {specifySupernodal, nullptr, nullptr}},
+
+  {"amg",           {specifyAMG, nullptr, nullptr}},
+
   {"diagonal", {
      G3_SOE(DiagonalDirectSolver,        DiagonalSOE),
      SP_SOE(DistributedDiagonalSolver,   DistributedDiagonalSOE),
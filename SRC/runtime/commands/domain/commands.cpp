@@ -152,6 +152,11 @@ G3_AddTclDomainCommands(Tcl_Interp *interp, Domain* the_domain)
   Tcl_CreateObjCommand(interp, "constrainedNodes",    &constrainedNodes,    domain, nullptr);
   Tcl_CreateObjCommand(interp, "constrainedDOFs",     &constrainedDOFs,     domain, nullptr);
   Tcl_CreateObjCommand(interp, "domainChange",        &domainChange,        domain, nullptr);
+  Tcl_CreateObjCommand(interp, "nodalStateStore",     &nodalStateStore,     domain, nullptr);
+  Tcl_CreateObjCommand(interp, "recorderWriter",      &recorderWriter,      domain, nullptr);
+  Tcl_CreateObjCommand(interp, "snapshot",            &snapshot,            domain, nullptr);
+  Tcl_CreateObjCommand(interp, "saveState",           &domainState,         domain, nullptr);
+  Tcl_CreateObjCommand(interp, "removeState",         &domainState,         domain, nullptr);
   Tcl_CreateObjCommand(interp, "remove",              &removeObject,        domain, nullptr);
   Tcl_CreateCommand(interp,    "retainedNodes",       &retainedNodes,       domain, nullptr);
   Tcl_CreateCommand(interp,    "retainedDOFs",        &retainedDOFs,        domain, nullptr);
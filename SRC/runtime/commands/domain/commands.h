@@ -105,6 +105,10 @@ Tcl_ObjCmdProc constrainedNodes;
 Tcl_ObjCmdProc fixedDOFs;
 Tcl_ObjCmdProc constrainedDOFs;
 Tcl_ObjCmdProc domainChange;
+Tcl_ObjCmdProc nodalStateStore;
+Tcl_ObjCmdProc recorderWriter;
+Tcl_ObjCmdProc snapshot;
+Tcl_ObjCmdProc domainState;
 Tcl_CmdProc retainedDOFs;
 Tcl_CmdProc updateElementDomain;
 
@@ -18,6 +18,9 @@
 
 #include <tcl.h>
 #include <FileStream.h>
+#include <AsyncStreamWriter.h>
+#include <SnapshotDatastore.h>
+#include <TclPackageClassBroker.h>
 #include <G3_Logging.h>
 #include <Domain.h>
 #include <LoadPattern.h>
@@ -46,6 +49,185 @@ domainChange(ClientData clientData, Tcl_Interp *interp, int argc,
 }
 
 
+//
+// nodalStateStore ?on|off?
+//
+// Keeps the response of the nodes in a contiguous NodalStateStore; with
+// no argument returns 1 if the store is in use.
+//
+int
+nodalStateStore(ClientData clientData, Tcl_Interp *interp, int argc,
+                Tcl_Obj *const *objv)
+{
+  assert(clientData != nullptr);
+  Domain *the_domain = (Domain*)clientData;
+
+  if (argc < 2) {
+    Tcl_SetObjResult(interp, Tcl_NewIntObj(the_domain->getNodalStateStore() != nullptr));
+    return TCL_OK;
+  }
+
+  int useStore;
+  if (Tcl_GetBooleanFromObj(interp, objv[1], &useStore) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "want - nodalStateStore on|off\n";
+    return TCL_ERROR;
+  }
+
+  if (the_domain->setNodalStateStore(useStore != 0) != 0)
+    return TCL_ERROR;
+
+  return TCL_OK;
+}
+
+
+//
+// recorderWriter on ?-buffer MB? ?-flush seconds?
+// recorderWriter off
+//
+// Writes the rows of the file recorders from a background thread, with a
+// ring buffer of the given size and the files flushed at most every given
+// number of seconds (0 when the writer catches up); off writes out the
+// rows queued. With no argument returns 1 if the writer is running.
+//
+int
+recorderWriter(ClientData clientData, Tcl_Interp *interp, int argc,
+               Tcl_Obj *const *objv)
+{
+  if (argc < 2) {
+    Tcl_SetObjResult(interp, Tcl_NewIntObj(AsyncStreamWriter::isRunning()));
+    return TCL_OK;
+  }
+
+  int useWriter;
+  if (Tcl_GetBooleanFromObj(interp, objv[1], &useWriter) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "want - recorderWriter on|off ?-buffer MB? ?-flush seconds?\n";
+    return TCL_ERROR;
+  }
+
+  if (useWriter == 0) {
+    AsyncStreamWriter::stop();
+    return TCL_OK;
+  }
+
+  double bufferSize = 8.0;
+  double flushInterval = 1.0;
+  for (int i = 2; i < argc; i++) {
+    const char *flag = Tcl_GetString(objv[i]);
+    if (strcmp(flag, "-buffer") == 0 && i+1 < argc) {
+      if (Tcl_GetDoubleFromObj(interp, objv[++i], &bufferSize) != TCL_OK || bufferSize <= 0.0) {
+        opserr << G3_ERROR_PROMPT << "recorderWriter - invalid buffer size " << Tcl_GetString(objv[i]) << "\n";
+        return TCL_ERROR;
+      }
+    }
+    else if (strcmp(flag, "-flush") == 0 && i+1 < argc) {
+      if (Tcl_GetDoubleFromObj(interp, objv[++i], &flushInterval) != TCL_OK || flushInterval < 0.0) {
+        opserr << G3_ERROR_PROMPT << "recorderWriter - invalid flush interval " << Tcl_GetString(objv[i]) << "\n";
+        return TCL_ERROR;
+      }
+    }
+    else {
+      opserr << G3_ERROR_PROMPT << "recorderWriter - unknown option " << flag << "\n";
+      return TCL_ERROR;
+    }
+  }
+
+  int numDoubles = (int)(bufferSize*1048576.0/sizeof(double));
+  if (AsyncStreamWriter::start(numDoubles, flushInterval) != 0)
+    return TCL_ERROR;
+
+  return TCL_OK;
+}
+
+
+//
+// snapshot save fileName
+// snapshot restore fileName
+//
+// Writes the state of the domain to a single binary file, or brings it
+// back from one; the domain is rebuilt from the file if its components
+// are not those it was saved with, so that a snapshot may be restored
+// after wipe. The analysis is then defined again by the script.
+//
+int
+snapshot(ClientData clientData, Tcl_Interp *interp, int argc,
+         Tcl_Obj *const *objv)
+{
+  assert(clientData != nullptr);
+  Domain *the_domain = (Domain*)clientData;
+
+  if (argc < 3) {
+    opserr << G3_ERROR_PROMPT << "want - snapshot save|restore fileName\n";
+    return TCL_ERROR;
+  }
+  const char *action = Tcl_GetString(objv[1]);
+  const char *fileName = Tcl_GetString(objv[2]);
+
+  static TclPackageClassBroker theBroker;
+  SnapshotDatastore theSnapshot(*the_domain, theBroker);
+
+  if (strcmp(action, "save") == 0) {
+    if (theSnapshot.commitState(the_domain->getCommitTag()) < 0 ||
+        theSnapshot.write(fileName) != 0) {
+      opserr << G3_ERROR_PROMPT << "snapshot - failed to save " << fileName << "\n";
+      return TCL_ERROR;
+    }
+  }
+  else if (strcmp(action, "restore") == 0) {
+    if (theSnapshot.read(fileName) != 0 ||
+        theSnapshot.restoreState(theSnapshot.getCommitTag()) < 0) {
+      opserr << G3_ERROR_PROMPT << "snapshot - failed to restore " << fileName << "\n";
+      return TCL_ERROR;
+    }
+    the_domain->domainChange();
+  }
+  else {
+    opserr << G3_ERROR_PROMPT << "snapshot - unknown action " << action << ", want save or restore\n";
+    return TCL_ERROR;
+  }
+
+  return TCL_OK;
+}
+
+
+//
+// saveState id
+// removeState id
+//
+// Keeps a copy of the committed state of the domain in memory under the
+// given id, or discards it; restoreState, which goes back to it, is an
+// analysis command as the integrator takes the restored response.
+//
+int
+domainState(ClientData clientData, Tcl_Interp *interp, int argc,
+            Tcl_Obj *const *objv)
+{
+  assert(clientData != nullptr);
+  Domain *the_domain = (Domain*)clientData;
+
+  const char *action = Tcl_GetString(objv[0]);
+  int id;
+  if (argc < 2 || Tcl_GetIntFromObj(interp, objv[1], &id) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "want - " << action << " id\n";
+    return TCL_ERROR;
+  }
+
+  static TclPackageClassBroker theBroker;
+
+  int res;
+  if (strcmp(action, "saveState") == 0)
+    res = the_domain->saveState(id, theBroker);
+  else
+    res = the_domain->removeState(id);
+
+  if (res < 0) {
+    opserr << G3_ERROR_PROMPT << action << " - failed for state " << id << "\n";
+    return TCL_ERROR;
+  }
+
+  return TCL_OK;
+}
+
+
 int
 removeObject(ClientData clientData, Tcl_Interp *interp, int argc,
              Tcl_Obj *const *objv)
@@ -41,6 +41,7 @@
 #include <DataFileStreamAdd.h>
 #include <XmlFileStream.h>
 #include <BinaryFileStream.h>
+#include <ColumnarFileStream.h>
 #include <DatabaseStream.h>
 #include <DummyStream.h>
 #include <TCP_Stream.h>
@@ -98,6 +99,8 @@ struct OutputOptions {
   int writeBufferSize   = 0;
   bool doScientific     = false;
   bool closeOnWrite     = false;
+  bool singlePrecision  = false;
+  bool doCompress       = false;
 
   FE_Datastore *theDatabase = nullptr;
 
@@ -110,6 +113,7 @@ struct OutputOptions {
     DATA_STREAM_CSV,
     TCP_STREAM,
     DATA_STREAM_ADD,
+    COLUMNAR_STREAM,
     MODE_UNSPECIFIED
   } eMode = STANDARD_STREAM;
 };
@@ -155,6 +159,13 @@ createOutputStream(OutputOptions &options)
 
     } else if (options.eMode == OutputOptions::BINARY_STREAM) {
       theOutputStream = new BinaryFileStream(options.filename);
+
+    } else if (options.eMode == OutputOptions::COLUMNAR_STREAM) {
+      theOutputStream = new ColumnarFileStream(
+          options.filename,
+          openMode::OVERWRITE,
+          options.singlePrecision,
+          options.doCompress);
     }
 
   } else if (options.eMode == OutputOptions::TCP_STREAM && options.inetAddr != 0) {
@@ -292,6 +303,17 @@ parseOutputOption(OutputOptions *options, Tcl_Interp* interp, int argc, TCL_Char
       loc++;
     }
 
+    // for -columnar
+    else if (strcmp(argv[loc], "-float32") == 0) {
+      options->singlePrecision = true;
+      loc++;
+    }
+
+    else if (strcmp(argv[loc], "-compress") == 0) {
+      options->doCompress = true;
+      loc++;
+    }
+
     else if (strcmp(argv[loc], "-buffer") == 0 ||
              strcmp(argv[loc], "-bufferSize") == 0) {
       loc++;
@@ -320,6 +342,9 @@ parseOutputOption(OutputOptions *options, Tcl_Interp* interp, int argc, TCL_Char
       else if ((strcmp(argv[loc], "-binary") == 0)) {
         eMode = OutputOptions::BINARY_STREAM;
       }
+      else if ((strcmp(argv[loc], "-columnar") == 0)) {
+        eMode = OutputOptions::COLUMNAR_STREAM;
+      }
       else if ((strcmp(argv[loc], "-TCP") == 0) ||
                (strcmp(argv[loc], "-tcp") == 0)) {
         options->inetAddr = argv[loc + 1];
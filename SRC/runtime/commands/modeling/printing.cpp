@@ -36,6 +36,7 @@
 #include <NDMaterial.h>
 #include <SectionForceDeformation.h>
 #include <FrameSection.h>
+#include <SharedParameters.h>
 
 #include <Pressure_Constraint.h>
 #include <Element.h>
@@ -301,6 +302,14 @@ TclCommand_print(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char *
       done = true;
     }
 
+    // if 'print -parameterBlocks' print out the memory held by the
+    // parameters of the materials and of their copies
+    else if ((strcmp(argv[currentArg], "-parameterBlocks") == 0)) {
+      currentArg++;
+      SharedParameterBlocks::Print(*output);
+      done = true;
+    }
+
     // if 'print integrator flag' print out the integrator
     else if ((strcmp(argv[currentArg], "integrator") == 0) ||
              (strcmp(argv[currentArg], "-integrator") == 0)) {
@@ -28,6 +28,11 @@
 #  include <MPIDiagonalSolver.h>
 #  include <StaticDomainDecompositionAnalysis.h>
 #  include <TransientDomainDecompositionAnalysis.h>
+#  include <DomainDecompositionAnalysis.h>
+#  include <DomainDecompAlgo.h>
+#  include <SupernodalSymLinSOE.h>
+#  include <SupernodalSymLinSubstrSolver.h>
+#  include <ThreadPool.h>
 
 #  define MPIPP_H
 #  include <DistributedSuperLU.h>
@@ -115,6 +120,20 @@ getNP(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const arg
 
 
 #ifdef _PARALLEL_SP
+// the send buffer of the channels to the subdomains while the model is
+// moved to them, coalescing the many small messages of the sendSelf()s
+static int sendBufferSize = 4194304;
+
+// condense the subdomains onto their interface, the main analysis then
+// solving the interface problem
+static bool substructure = false;
+
+// move elements between the subdomains during the analysis when the
+// measured update time of the heaviest is more than balanceRatio times
+// the mean, checked every balanceInterval commits
+static double balanceRatio = 0.0;
+static int balanceInterval = 1;
+
 static int
 partitionModel(int eleTag)
 {
@@ -140,17 +159,31 @@ partitionModel(int eleTag)
 
   // create a partitioner & partition the domain
   if (OPS_DOMAIN_PARTITIONER == nullptr) {
-    //      OPS_BALANCER = new ShedHeaviest();
     OPS_GRAPH_PARTITIONER = new Metis;
-    // OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER,
-    // *OPS_BALANCER);
-    OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
+    if (balanceRatio > 0.0) {
+      OPS_BALANCER = new ShedHeaviest();
+      OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER,
+                                                     *OPS_BALANCER);
+    } else
+      OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
     theDomain.setPartitioner(OPS_DOMAIN_PARTITIONER);
   }
 
+  for (int i = 1; i <= OPS_NUM_SUBDOMAINS; i++)
+    if (i != OPS_MAIN_DOMAIN_PARTITION_ID)
+      OPS_theChannels[i - 1]->setSendBuffer(sendBufferSize);
+
   result = theDomain.partition(OPS_NUM_SUBDOMAINS, OPS_USING_MAIN_DOMAIN,
                                OPS_MAIN_DOMAIN_PARTITION_ID, eleTag);
 
+  // send what is held and go back to sending as given
+  for (int i = 1; i <= OPS_NUM_SUBDOMAINS; i++)
+    if (i != OPS_MAIN_DOMAIN_PARTITION_ID)
+      OPS_theChannels[i - 1]->setSendBuffer(0);
+
+  if (balanceRatio > 0.0)
+    theDomain.setLoadBalancing(balanceRatio, balanceInterval);
+
   if (result < 0)
     return result;
 
@@ -162,6 +195,23 @@ partitionModel(int eleTag)
 
   // create the appropriate domain decomposition analysis
   while ((theSub = theSubdomains()) != 0) {
+    if (substructure == true) {
+      // the interior is factored, and the Schur complement formed, with the
+      // threads of the subdomain; the analysis sets itself on the subdomain
+      SupernodalSymLinSubstrSolver *theSubSolver =
+          new SupernodalSymLinSubstrSolver(SupernodalSymLinSolver::ORDER_AMD,
+                                           false, theDomain.getNumThreads());
+      SupernodalSymLinSOE *theSubSOE = new SupernodalSymLinSOE(*theSubSolver);
+      IncrementalIntegrator *theSubIntegrator = theStaticIntegrator;
+      if (the_static_analysis == 0)
+        theSubIntegrator = theTransientIntegrator;
+      theSubAnalysis = new DomainDecompositionAnalysis(
+          *theSub, *theHandler, *theNumberer, *the_analysis_model,
+          *(new DomainDecompAlgo()), *theSubIntegrator, *theSubSOE,
+          *theSubSolver, theTest, false);
+      continue;
+    }
+
     if (the_static_analysis != 0) {
       theSubAnalysis = new StaticDomainDecompositionAnalysis(
           *theSub, *theHandler, *theNumberer, *the_analysis_model, *theAlgorithm,
@@ -325,9 +375,51 @@ opsPartition(ClientData clientData, Tcl_Interp *interp, int argc,
              TCL_Char ** const argv)
 {
 #ifdef _PARALLEL_SP
-  int eleTag;
-  if (argc == 2) {
-    if (Tcl_GetInt(interp, argv[1], &eleTag) != TCL_OK) {
+  int eleTag = 0;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-sendBuffer") == 0 && i+1 < argc) {
+      if (Tcl_GetInt(interp, argv[++i], &sendBufferSize) != TCL_OK || sendBufferSize < 0) {
+        opserr << "WARNING partition -sendBuffer numBytes? - invalid size " << argv[i] << endln;
+        return TCL_ERROR;
+      }
+    }
+    else if (strcmp(argv[i], "-threads") == 0 && i+1 < argc) {
+      // threads used by each subdomain, 0 for all of the hardware threads
+      int numThreads = 0;
+      if (Tcl_GetInt(interp, argv[++i], &numThreads) != TCL_OK || numThreads < 0) {
+        opserr << "WARNING partition -threads numThreads? - invalid number " << argv[i] << endln;
+        return TCL_ERROR;
+      }
+      if (numThreads == 0)
+        numThreads = ThreadPool::getNumHardwareThreads();
+      // the threads may each send to the subdomains
+      int provided = MPI_THREAD_SINGLE;
+      MPI_Query_thread(&provided);
+      if (numThreads > 1 && provided < MPI_THREAD_MULTIPLE) {
+        opserr << "WARNING partition -threads - the MPI library does not provide MPI_THREAD_MULTIPLE,";
+        opserr << " a partitioned model can only use 1 thread\n";
+        return TCL_ERROR;
+      }
+      if (theDomain.setNumThreads(numThreads) != 0)
+        return TCL_ERROR;
+    }
+    else if (strcmp(argv[i], "-substructure") == 0) {
+      substructure = true;
+    }
+    else if (strcmp(argv[i], "-balance") == 0 && i+1 < argc) {
+      // rebalance when the heaviest subdomain exceeds ratio times the mean
+      if (Tcl_GetDouble(interp, argv[++i], &balanceRatio) != TCL_OK || balanceRatio <= 1.0) {
+        opserr << "WARNING partition -balance ratio? - ratio must exceed 1.0 " << argv[i] << endln;
+        return TCL_ERROR;
+      }
+    }
+    else if (strcmp(argv[i], "-balanceEvery") == 0 && i+1 < argc) {
+      if (Tcl_GetInt(interp, argv[++i], &balanceInterval) != TCL_OK || balanceInterval < 1) {
+        opserr << "WARNING partition -balanceEvery numCommits? - invalid number " << argv[i] << endln;
+        return TCL_ERROR;
+      }
+    }
+    else if (Tcl_GetInt(interp, argv[i], &eleTag) != TCL_OK) {
       ;
     }
   }
@@ -14,6 +14,7 @@ namespace py = pybind11;
 #include <G3_Runtime.h>
 #include <elementAPI.h> // G3_getRuntime/SafeBuilder
 #include <runtime/runtime/BasicModelBuilder.h>
+#include <runtime/runtime/TclPackageClassBroker.h>
 
 #include <Domain.h>
 #include <Vector.h>
@@ -42,6 +43,11 @@ namespace py = pybind11;
 #include <LinearSeries.h>
 #include <GroundMotion.h>
 
+//
+// RECORDER OUTPUT
+//
+void init_recorder_file(py::module &m);
+
 #define ARRAY_FLAGS py::array::c_style|py::array::forcecast
 
 
@@ -502,6 +508,15 @@ init_obj_module(py::module &m)
       return copy_vector(*domain.getNodeResponse(node, typ));
     })
     .def ("getTime", &Domain::getCurrentTime)
+    .def ("saveState", [](Domain &domain, int id) {
+      static TclPackageClassBroker broker;
+      return domain.saveState(id, broker);
+    })
+    .def ("restoreState", [](Domain &domain, int id) {
+      static TclPackageClassBroker broker;
+      return domain.restoreState(id, broker);
+    })
+    .def ("removeState", &Domain::removeState)
   ;
   
   py::class_<G3_Runtime>(m, "_Runtime")
@@ -522,6 +537,8 @@ init_obj_module(py::module &m)
     .def ("analyze", &DirectIntegrationAnalysis::analyze)
   ;
 
+  init_recorder_file(m);
+
   //
   // Module-Level Functions
   //
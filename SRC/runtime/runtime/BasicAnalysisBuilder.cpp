@@ -126,6 +126,7 @@ BasicAnalysisBuilder::wipe()
   if (theAnalysisModel != nullptr) {
     delete theAnalysisModel;
     theAnalysisModel = new AnalysisModel();
+    theAnalysisModel->setNumThreads(numThreads);
   }
   theVariableTimeStepTransientAnalysis = nullptr;
 }
@@ -160,6 +161,9 @@ BasicAnalysisBuilder::setLinks(CurrentAnalysis flag)
     if (theAnalysisModel && theSOE && theTest && theTransientIntegrator) {
       theTransientIntegrator->setLinks(*theAnalysisModel, *theSOE, theTest);
     }
+
+    if (theTransientIntegrator)
+      theTransientIntegrator->setNumThreads(numThreads);
     // if (theTransientIntegrator && domainStamp != 0)
     //   theTransientIntegrator->domainChanged();
       // this->domainChanged();
@@ -175,6 +179,9 @@ BasicAnalysisBuilder::setLinks(CurrentAnalysis flag)
     if (theAnalysisModel && theSOE && theTest && theStaticIntegrator)
       theStaticIntegrator->setLinks(*theAnalysisModel, *theSOE, theTest);
 
+    if (theStaticIntegrator)
+      theStaticIntegrator->setNumThreads(numThreads);
+
     if (theAnalysisModel && theStaticIntegrator && theSOE && theTest && theAlgorithm)
       theAlgorithm->setLinks(*theAnalysisModel, *theStaticIntegrator, *theSOE, theTest);
 
@@ -493,6 +500,29 @@ BasicAnalysisBuilder::analyzeStep(double dT)
 
 
 
+int
+BasicAnalysisBuilder::setNumThreads(int threads)
+{
+  if (threads < 1)
+    return -1;
+
+  numThreads = threads;
+
+  if (theDomain != nullptr)
+    theDomain->setNumThreads(numThreads);
+
+  if (theAnalysisModel != nullptr)
+    theAnalysisModel->setNumThreads(numThreads);
+
+  if (theStaticIntegrator != nullptr)
+    theStaticIntegrator->setNumThreads(numThreads);
+
+  if (theTransientIntegrator != nullptr)
+    theTransientIntegrator->setNumThreads(numThreads);
+
+  return 0;
+}
+
 void
 BasicAnalysisBuilder::set(ConstraintHandler* obj)
 {
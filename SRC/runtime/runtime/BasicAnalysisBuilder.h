@@ -88,6 +88,10 @@ public:
 
     int domainChanged();
 
+    // number of threads used to form and assemble the element contributions
+    int  setNumThreads(int numThreads);
+    int  getNumThreads() {return numThreads;};
+
     // Performing analysis
     int analyze(int num_steps, double size_steps=0.0);
     int analyzeStatic(int num_steps);
@@ -123,6 +127,8 @@ private:
     int numSubLevels = 0;
     int numSubSteps  = 0;
 
+    int numThreads   = 1;
+
     bool freeSOE = true;
     bool freeTI  = true;
 
@@ -472,6 +472,8 @@ using namespace OpenSees::Hash::literals;
 #include "bandSPD/BandSPDLinSOE.h"
 #include "profileSPD/ProfileSPDLinSOE.h"
 #include "profileSPD/ProfileSPDLinSubstrSolver.h"
+#include "supernodal/SupernodalSymLinSOE.h"
+#include "supernodal/SupernodalSymLinSubstrSolver.h"
 #include "sparseGEN/SparseGenColLinSOE.h"
 #include "DomainDecompositionAnalysis.h"
 
@@ -2110,6 +2112,21 @@ TclPackageClassBroker::getPtrNewDDLinearSOE(int classTagSOE,
       return 0;
     }
 
+  case LinSOE_TAGS_SupernodalSymLinSOE:
+
+    if (classTagDDSolver == SOLVER_TAGS_SupernodalSymLinSubstrSolver) {
+      SupernodalSymLinSubstrSolver *theSupernodalSolver =
+          new SupernodalSymLinSubstrSolver();
+      LinearSOE *theSOE = new SupernodalSymLinSOE(*theSupernodalSolver);
+      lastDomainSolver = theSupernodalSolver;
+      return theSOE;
+    } else {
+      opserr << "TclPackageClassBroker::getNewLinearSOE - ";
+      opserr << " - no Supernodal Domain Solver type exists for class tag ";
+      opserr << classTagDDSolver << endln;
+      return 0;
+    }
+
   default:
     opserr << "TclPackageClassBroker::getNewLinearSOE - ";
     opserr << " - no LinearSOE type exists for class tag ";
@@ -2123,8 +2140,8 @@ TclPackageClassBroker::getNewDomainDecompAnalysis(int classTag,
                                                   Subdomain &theSubdomain)
 {
   switch (classTag) {
-//case DomDecompANALYSIS_TAGS_DomainDecompositionAnalysis:
-//  return new DomainDecompositionAnalysis(theSubdomain);
+  case DomDecompANALYSIS_TAGS_DomainDecompositionAnalysis:
+    return new DomainDecompositionAnalysis(theSubdomain);
 
 #ifdef _PARALLEL_PROCESSING
   case ANALYSIS_TAGS_StaticDomainDecompositionAnalysis:
@@ -0,0 +1,84 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of
+// IterativeRefinement.
+//
+#include <IterativeRefinement.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+IterativeRefinement::IterativeRefinement(int max)
+  :maxIter(max), numRefine(0)
+{
+  if (maxIter < 1)
+    maxIter = 1;
+}
+
+int
+IterativeRefinement::refine(int n, double *x, double normA,
+			    const Residual &residual,
+			    const Correction &correction)
+{
+  if (n == 0)
+    return 0;
+
+  r.resize(n);
+  const double eps = std::numeric_limits<double>::epsilon();
+  const double cte = normA * eps * std::sqrt((double)n);
+
+  double lastNormR = 0.0;
+  for (int k=0; k<=maxIter; k++) {
+
+    residual(x, &r[0]);
+
+    double normR = 0.0;
+    double normX = 0.0;
+    for (int i=0; i<n; i++) {
+      normR = std::max(normR, std::fabs(r[i]));
+      normX = std::max(normX, std::fabs(x[i]));
+    }
+
+    if (normR <= normX*cte)
+      return k;
+
+    // stalled, overflowed, or out of steps
+    if (!(normR <= std::numeric_limits<double>::max()) ||
+	(k > 0 && normR > 0.5*lastNormR) || k == maxIter)
+      return -1;
+    lastNormR = normR;
+
+    if (correction(&r[0]) != 0)
+      return -1;
+
+    for (int i=0; i<n; i++)
+      x[i] += r[i];
+    numRefine++;
+  }
+
+  return -1;
+}
+
+int
+IterativeRefinement::getNumRefine(void) const
+{
+  return numRefine;
+}
@@ -0,0 +1,64 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for
+// IterativeRefinement. A direct solver that factors A in single precision
+// uses it to recover a solution of double precision accuracy: with the
+// residual r = b - Ax formed in double precision, the correction d from
+// the single precision factors of A (Ad = r) is added to x until
+//
+//   max|r| <= max|x| * normA * eps * sqrt(n)
+//
+// as in LAPACK's dsgesv. If the residual fails to halve in a step, or the
+// maximum number of steps is reached, the refinement is said to stall and
+// the solver is expected to factor A in double precision instead.
+//
+#ifndef IterativeRefinement_h
+#define IterativeRefinement_h
+
+#include <functional>
+#include <vector>
+
+class IterativeRefinement
+{
+  public:
+    // forms r = b - Ax in double precision
+    typedef std::function<void(const double *x, double *r)> Residual;
+    // overwrites r with the single precision solution d of Ad = r; returns
+    // 0 if successful
+    typedef std::function<int(double *r)> Correction;
+
+    IterativeRefinement(int maxIter = 30);
+
+    // refines x, on entry the single precision solution of Ax = b; returns
+    // the number of steps taken, or -1 if the refinement stalled, in which
+    // case x must be discarded
+    int refine(int n, double *x, double normA,
+	       const Residual &residual, const Correction &correction);
+
+    int getNumRefine(void) const;
+
+  private:
+    int maxIter;
+    int numRefine;              // steps taken in all calls to refine()
+    std::vector<double> r;
+};
+
+#endif
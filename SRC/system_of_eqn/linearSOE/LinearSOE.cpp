@@ -32,15 +32,18 @@
 
 #include<LinearSOE.h>
 #include<LinearSOESolver.h>
+#include<FE_Element.h>
 
 LinearSOE::LinearSOE(LinearSOESolver &theLinearSOESolver, int classtag)
-    :MovableObject(classtag), theModel(0), theSolver(&theLinearSOESolver)
+    :MovableObject(classtag), theModel(0), theSolver(&theLinearSOESolver),
+     patternStamp(0), valuesStamp(0)
 {
 
 }
 
 LinearSOE::LinearSOE(int classtag)
-:MovableObject(classtag), theModel(0), theSolver(0)
+:MovableObject(classtag), theModel(0), theSolver(0),
+ patternStamp(0), valuesStamp(0)
 {
 
 }
@@ -91,6 +94,31 @@ LinearSOE::getSolver(void)
     return theSolver;
 }
 
+int
+LinearSOE::getPatternStamp(void) const
+{
+    return patternStamp;
+}
+
+int
+LinearSOE::getValuesStamp(void) const
+{
+    return valuesStamp;
+}
+
+void
+LinearSOE::patternChanged(void)
+{
+    patternStamp++;
+    valuesStamp++;
+}
+
+void
+LinearSOE::valuesChanged(void)
+{
+    valuesStamp++;
+}
+
 int 
 LinearSOE::setLinks(AnalysisModel &theModel)
 {
@@ -104,7 +132,19 @@ LinearSOE::addA(const Matrix &) {
   return -1;
 }
 
+int
+LinearSOE::addA(const Matrix &m, const FE_Element &theEle, double fact)
+{
+  return this->addA(m, theEle.getID(), fact);
+}
+
 int
 LinearSOE::addColA(const Vector &col, int colIndex, double fact) {
   return -1;
 }
+
+bool
+LinearSOE::canAddConcurrently(void) const
+{
+  return false;
+}
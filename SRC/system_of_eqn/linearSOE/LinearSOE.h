@@ -47,6 +47,7 @@ class Matrix;
 class Vector;
 class ID;
 class AnalysisModel;
+class FE_Element;
 
 class LinearSOE : public MovableObject
 {
@@ -69,6 +70,17 @@ class LinearSOE : public MovableObject
     virtual int addA(const Matrix &);
     virtual int addColA(const Vector &col, int colIndex, double fact = 1.0);
 
+    // adds the tangent m of theEle, whose equations are given by its ID;
+    // SOEs with a sparse storage scheme override this to use a ScatterMap
+    virtual int addA(const Matrix &m, const FE_Element &theEle, double fact = 1.0);
+
+    // returns true if addA() and addB() may be invoked from several threads
+    // at once, provided the IDs passed in the concurrent calls share no
+    // equation numbers; an SOE may only return true if these methods write
+    // nothing but the entries of A and B of the equations in the ID and
+    // read nothing that another addA() or addB() call modifies
+    virtual bool canAddConcurrently(void) const;
+
     virtual void zeroA(void) =0;
     virtual void zeroB(void) =0;
 
@@ -84,13 +96,27 @@ class LinearSOE : public MovableObject
     virtual void setX(const Vector &X) =0;
     
     LinearSOESolver *getSolver(void);
+
+    // stamps of the sparsity pattern and of the values of A. An SOE that
+    // maintains them advances the pattern stamp in setSize() (it may skip
+    // this if the structure of A is unchanged) and the values stamp in
+    // zeroA(), with which every assembly of A starts. A solver that records
+    // both when it factors A redoes the symbolic analysis only when the
+    // pattern has changed and the numeric factorization only when the
+    // values have.
+    int getPatternStamp(void) const;
+    int getValuesStamp(void) const;
     
   protected:
     int setSolver(LinearSOESolver &newSolver);	        
+    void patternChanged(void);
+    void valuesChanged(void);
     AnalysisModel* theModel;
     
   private:
     LinearSOESolver *theSolver;    
+    int patternStamp;
+    int valuesStamp;
 };
 
 
@@ -38,7 +38,7 @@
 
 
 LinearSOESolver::LinearSOESolver(int classtag)
-:MovableObject(classtag)
+:MovableObject(classtag), numSymbolic(0), numNumeric(0), numSolve(0)
 {
     
 }
@@ -48,6 +48,32 @@ LinearSOESolver::~LinearSOESolver()
     
 }
 
+int
+LinearSOESolver::getNumSymbolic(void) const
+{
+    return numSymbolic;
+}
+
+int
+LinearSOESolver::getNumNumeric(void) const
+{
+    return numNumeric;
+}
+
+int
+LinearSOESolver::getNumSolve(void) const
+{
+    return numSolve;
+}
+
+void
+LinearSOESolver::resetCounts(void)
+{
+    numSymbolic = 0;
+    numNumeric = 0;
+    numSolve = 0;
+}
+
 
 
 
@@ -49,8 +49,19 @@ class LinearSOESolver : public MovableObject
     virtual int solve(void) = 0;
     virtual int setSize(void) = 0;
     virtual double getDeterminant(void) {return 1.0;};
+
+    // number of symbolic analyses, numeric factorizations and solves
+    // (forward and backward substitutions) performed by a direct solver
+    // since it was created or the counts were last reset
+    int getNumSymbolic(void) const;
+    int getNumNumeric(void) const;
+    int getNumSolve(void) const;
+    void resetCounts(void);
     
   protected:
+    int numSymbolic;
+    int numNumeric;
+    int numSolve;
     
   private:
 
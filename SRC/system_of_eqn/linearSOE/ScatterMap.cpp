@@ -0,0 +1,115 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of ScatterMap.
+//
+#include <ScatterMap.h>
+#include <Matrix.h>
+#include <OPS_Globals.h>
+
+ScatterMap::ScatterMap()
+{
+
+}
+
+void
+ScatterMap::clear(void)
+{
+  theLocations.clear();
+  theStart.clear();
+  theNumDOF.clear();
+}
+
+bool
+ScatterMap::isEmpty(void) const
+{
+  return theStart.empty();
+}
+
+int
+ScatterMap::addFE_Element(int tag, int numDOF)
+{
+  if (tag < 0) {
+    opserr << "ScatterMap::addFE_Element() - FE_Element with negative tag " << tag
+	   << ", no scatter map used\n";
+    return -1;
+  }
+
+  if (tag >= (int)theStart.size()) {
+    theStart.resize(tag+1, -1);
+    theNumDOF.resize(tag+1, 0);
+  }
+
+  if (theStart[tag] >= 0) {
+    opserr << "ScatterMap::addFE_Element() - two FE_Elements with tag " << tag
+	   << ", no scatter map used\n";
+    return -1;
+  }
+
+  int offset = theLocations.size();
+  theLocations.resize(offset + numDOF*numDOF);
+  theStart[tag] = offset;
+  theNumDOF[tag] = numDOF;
+
+  return offset;
+}
+
+int
+ScatterMap::getLocation(const FE_Element &theEle, int i, int j) const
+{
+  int tag = theEle.getTag();
+  if (tag < 0 || tag >= (int)theStart.size() || theStart[tag] < 0)
+    return -2;
+
+  int numDOF = theNumDOF[tag];
+  if (i < 0 || i >= numDOF || j < 0 || j >= numDOF)
+    return -1;
+
+  return theLocations[theStart[tag] + j*numDOF + i];
+}
+
+bool
+ScatterMap::add(double *A, const Matrix &m, const FE_Element &theEle,
+		double fact) const
+{
+  int tag = theEle.getTag();
+  if (tag < 0 || tag >= (int)theStart.size() || theStart[tag] < 0)
+    return false;
+
+  int numDOF = theNumDOF[tag];
+  if (m.noRows() != numDOF || m.noCols() != numDOF ||
+      theEle.getID().Size() != numDOF)
+    return false;
+
+  const int *location = theLocations.data() + theStart[tag];
+  if (fact == 1.0) {
+    for (int j=0; j<numDOF; j++)
+      for (int i=0; i<numDOF; i++, location++)
+	if (*location >= 0)
+	  A[*location] += m(i,j);
+  } else {
+    for (int j=0; j<numDOF; j++)
+      for (int i=0; i<numDOF; i++, location++)
+	if (*location >= 0)
+	  A[*location] += fact * m(i,j);
+  }
+
+  return true;
+}
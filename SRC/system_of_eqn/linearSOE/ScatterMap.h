@@ -0,0 +1,143 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for ScatterMap.
+// A ScatterMap holds, for every FE_Element of an AnalysisModel, the
+// location in the compressed storage of a sparse LinearSOE of every entry
+// of the FE_Element tangent. It is built once in setSize(), after the
+// equations have been numbered, so that addA() becomes an indexed add in
+// place of a search of the column (or row) for each entry.
+//
+// The map of an FE_Element is stored in column order of its tangent, i.e.
+// location[j*n+i] is the location of entry (i,j); a location of -1 marks
+// an entry that is not assembled (a constrained equation, or an entry of
+// the upper triangle when only the lower triangle is stored).
+//
+#ifndef ScatterMap_h
+#define ScatterMap_h
+
+#include <vector>
+
+class AnalysisModel;
+class FE_Element;
+class Matrix;
+
+class ScatterMap
+{
+  public:
+    // how the SOE compresses A; start[] and index[] are the column start
+    // and row index arrays (or the row start and column index arrays)
+    enum Storage {
+      ColumnCompressed,        // start by column, index is the row
+      RowCompressed,           // start by row, index is the column
+      LowerColumnCompressed    // as ColumnCompressed, rows >= column only
+    };
+
+    ScatterMap();
+
+    // build the maps of all the FE_Elements in theModel; returns 0 if
+    // successful, a negative number if an FE_Element could not be mapped
+    // or has an equation number outside -1..size-1, in which case no map
+    // is kept and addA() must search as before
+    template <class INT>
+    int build(AnalysisModel &theModel, int size,
+              const INT *start, const INT *index, Storage storage);
+
+    void clear(void);
+    bool isEmpty(void) const;
+
+    // adds fact*m to A at the locations mapped for theEle; returns false,
+    // leaving A untouched, if no map of matching size exists for it
+    bool add(double *A, const Matrix &m, const FE_Element &theEle,
+             double fact) const;
+
+    // the location in A of entry (i,j) of the tangent of theEle, -1 if
+    // the entry is not stored, -2 if theEle has no map
+    int getLocation(const FE_Element &theEle, int i, int j) const;
+
+  private:
+    int addFE_Element(int tag, int numDOF);
+
+    std::vector<int> theLocations;   // maps of all FE_Elements, one after another
+    std::vector<int> theStart;       // by FE_Element tag, start in theLocations or -1
+    std::vector<int> theNumDOF;      // by FE_Element tag, size of the ID mapped
+};
+
+#include <ID.h>
+#include <OPS_Globals.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <AnalysisModel.h>
+
+template <class INT> int
+ScatterMap::build(AnalysisModel &theModel, int size,
+                  const INT *start, const INT *index, Storage storage)
+{
+  this->clear();
+
+  FE_EleIter &theEles = theModel.getFEs();
+  FE_Element *elePtr;
+  while ((elePtr = theEles()) != 0) {
+    const ID &id = elePtr->getID();
+    int numDOF = id.Size();
+
+    // once numbered, an equation is -1 (constrained) or in 0..size-1
+    for (int i=0; i<numDOF; i++)
+      if (id(i) < -1 || id(i) >= size) {
+        opserr << "ScatterMap::build() - FE_Element " << elePtr->getTag()
+               << " has equation number " << id(i) << " outside -1.."
+               << size-1 << ", no scatter map used\n";
+        this->clear();
+        return -1;
+      }
+
+    int offset = this->addFE_Element(elePtr->getTag(), numDOF);
+    if (offset < 0) {
+      this->clear();
+      return -1;
+    }
+
+    int *location = theLocations.data() + offset;
+    for (int j=0; j<numDOF; j++) {
+      int col = id(j);
+      for (int i=0; i<numDOF; i++, location++) {
+        int row = id(i);
+        *location = -1;
+        if (row < 0 || col < 0)
+          continue;
+        if (storage == LowerColumnCompressed && row < col)
+          continue;
+
+        // the compressed array to search and the index to look for
+        int outer = (storage == RowCompressed) ? row : col;
+        int inner = (storage == RowCompressed) ? col : row;
+        for (int k=start[outer]; k<start[outer+1]; k++)
+          if (index[k] == inner) {
+            *location = k;
+            break;
+          }
+      }
+    }
+  }
+
+  return 0;
+}
+
+#endif
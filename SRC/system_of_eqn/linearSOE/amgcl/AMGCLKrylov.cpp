@@ -0,0 +1,289 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of AMGCLKrylov.
+//
+#include <AMGCLKrylov.h>
+#include <OPS_Globals.h>
+#include <sstream>
+#include <exception>
+#include <tuple>
+
+#ifndef AMGCL_NO_BOOST
+#define AMGCL_NO_BOOST
+#endif
+#include <amgcl/backend/builtin.hpp>
+#include <amgcl/adapter/zero_copy.hpp>
+#include <amgcl/make_solver.hpp>
+#include <amgcl/amg.hpp>
+#include <amgcl/coarsening/smoothed_aggregation.hpp>
+#include <amgcl/relaxation/spai0.hpp>
+#include <amgcl/solver/cg.hpp>
+#include <amgcl/solver/bicgstab.hpp>
+#include <amgcl/solver/gmres.hpp>
+
+typedef amgcl::backend::builtin<double> AMGCLBackend;
+typedef amgcl::backend::crs<double> AMGCLMatrix;
+
+typedef amgcl::amg<AMGCLBackend,
+		   amgcl::coarsening::smoothed_aggregation,
+		   amgcl::relaxation::spai0> AMGCLPrecond;
+
+// the hierarchy with the Krylov method chosen at run time
+class AMGCLHierarchy
+{
+  public:
+    virtual ~AMGCLHierarchy() {}
+    virtual std::tuple<size_t, double> solve(const AMGCLMatrix &A,
+					     const std::vector<double> &rhs,
+					     std::vector<double> &x) = 0;
+    virtual void print(void) = 0;
+};
+
+template <class Krylov>
+class AMGCLHierarchyT : public AMGCLHierarchy
+{
+  public:
+    typedef amgcl::make_solver<AMGCLPrecond, Krylov> Solver;
+
+    AMGCLHierarchyT(std::shared_ptr<AMGCLMatrix> A,
+		    const typename Solver::params &prm)
+      :theSolver(A, prm)
+    {
+    }
+
+    std::tuple<size_t, double> solve(const AMGCLMatrix &A,
+				     const std::vector<double> &rhs,
+				     std::vector<double> &x)
+    {
+      return theSolver(A, rhs, x);
+    }
+
+    void print(void)
+    {
+      std::ostringstream theSummary;
+      theSummary << theSolver;
+      opserr << theSummary.str().c_str() << endln;
+    }
+
+  private:
+    Solver theSolver;
+};
+
+// the restart length applies to GMRES only
+static void
+setRestart(amgcl::solver::gmres<AMGCLBackend>::params &prm, int restart)
+{
+  prm.M = restart;
+}
+
+template <class Params>
+static void
+setRestart(Params &prm, int restart)
+{
+}
+
+template <class Krylov>
+static AMGCLHierarchy *
+newHierarchy(std::shared_ptr<AMGCLMatrix> A, double tol, int maxIter,
+	     int restart)
+{
+  typename AMGCLHierarchyT<Krylov>::Solver::params prm;
+  prm.solver.tol = tol;
+  prm.solver.maxiter = maxIter;
+  setRestart(prm.solver, restart);
+  return new AMGCLHierarchyT<Krylov>(A, prm);
+}
+
+AMGCLKrylov::AMGCLKrylov(int meth, double tolerance, int maxIterations,
+			 int restartGMRES, int maxReuses, bool printIt)
+  :method(meth), tol(tolerance), maxIter(maxIterations),
+   restart(restartGMRES), maxReuse(maxReuses), print(printIt),
+   size(0), theHierarchy(0), lastStamp(-1), numReuse(0), numIter(0)
+{
+  if (method != CG && method != BiCGStab && method != GMRES)
+    method = GMRES;
+  if (maxIter < 1)
+    maxIter = 1;
+  if (restart < 1)
+    restart = 30;
+  if (maxReuse < 0)
+    maxReuse = 0;
+}
+
+AMGCLKrylov::~AMGCLKrylov()
+{
+  if (theHierarchy != 0)
+    delete theHierarchy;
+}
+
+int
+AMGCLKrylov::setPattern(int n, const int *start, const int *index,
+			bool columnCompressed)
+{
+  if (theHierarchy != 0)
+    delete theHierarchy;
+  theHierarchy = 0;
+  lastStamp = -1;
+  numReuse = 0;
+
+  size = n;
+  int nnz = (n > 0) ? start[n] : 0;
+  ptr.assign(n+1, 0);
+  col.resize(nnz);
+  val.assign(nnz, 0.0);
+  rhs.assign(n, 0.0);
+  x.assign(n, 0.0);
+  valueMap.clear();
+
+  if (columnCompressed == false) {
+    for (int i=0; i<=n; i++)
+      ptr[i] = start[i];
+    for (int k=0; k<nnz; k++)
+      col[k] = index[k];
+    return 0;
+  }
+
+  // by column: form the rows of A, remembering where each entry is in the
+  // input so that the values can be gathered in row order
+  for (int k=0; k<nnz; k++)
+    ptr[index[k]+1]++;
+  for (int i=0; i<n; i++)
+    ptr[i+1] += ptr[i];
+
+  valueMap.resize(nnz);
+  std::vector<std::ptrdiff_t> next(ptr.begin(), ptr.end()-1);
+  for (int j=0; j<n; j++)
+    for (int k=start[j]; k<start[j+1]; k++) {
+      std::ptrdiff_t loc = next[index[k]]++;
+      col[loc] = j;
+      valueMap[loc] = k;
+    }
+
+  return 0;
+}
+
+int
+AMGCLKrylov::setup(void)
+{
+  if (theHierarchy != 0)
+    delete theHierarchy;
+  theHierarchy = 0;
+  numReuse = 0;
+
+  std::shared_ptr<AMGCLMatrix> A =
+    amgcl::adapter::zero_copy(size, &ptr[0], &col[0], &val[0]);
+
+  try {
+    if (method == CG)
+      theHierarchy = newHierarchy< amgcl::solver::cg<AMGCLBackend> >(A, tol, maxIter, restart);
+    else if (method == BiCGStab)
+      theHierarchy = newHierarchy< amgcl::solver::bicgstab<AMGCLBackend> >(A, tol, maxIter, restart);
+    else
+      theHierarchy = newHierarchy< amgcl::solver::gmres<AMGCLBackend> >(A, tol, maxIter, restart);
+  } catch (std::exception &e) {
+    opserr << "WARNING AMGCLKrylov::solve() - hierarchy setup failed: "
+	   << e.what() << endln;
+    theHierarchy = 0;
+    return -1;
+  }
+
+  if (print)
+    theHierarchy->print();
+
+  return 0;
+}
+
+int
+AMGCLKrylov::solve(const double *A, int valuesStamp, const double *b, double *xOut)
+{
+  numIter = 0;
+  if (size == 0)
+    return 0;
+
+  int nnz = (int)col.size();
+  if (valueMap.empty()) {
+    for (int k=0; k<nnz; k++)
+      val[k] = A[k];
+  } else {
+    for (int k=0; k<nnz; k++)
+      val[k] = A[valueMap[k]];
+  }
+
+  for (int i=0; i<size; i++) {
+    rhs[i] = b[i];
+    x[i] = 0.0;
+  }
+
+  // keep the hierarchy for up to maxReuse further matrices
+  int numSetup = 0;
+  bool reused = true;
+  if (theHierarchy == 0 || (valuesStamp != lastStamp && numReuse >= maxReuse)) {
+    if (this->setup() < 0)
+      return -1;
+    numSetup++;
+    reused = false;
+  } else if (valuesStamp != lastStamp)
+    numReuse++;
+  lastStamp = valuesStamp;
+
+  std::shared_ptr<AMGCLMatrix> theA =
+    amgcl::adapter::zero_copy(size, &ptr[0], &col[0], &val[0]);
+
+  size_t iters = 0;
+  double error = 0.0;
+  try {
+    std::tie(iters, error) = theHierarchy->solve(*theA, rhs, x);
+
+    if ((int)iters >= maxIter && error > tol && reused == true) {
+      if (this->setup() < 0)
+	return -1;
+      numSetup++;
+      for (int i=0; i<size; i++)
+	x[i] = 0.0;
+      std::tie(iters, error) = theHierarchy->solve(*theA, rhs, x);
+    }
+  } catch (std::exception &e) {
+    opserr << "WARNING AMGCLKrylov::solve() - " << e.what() << endln;
+    return -1;
+  }
+
+  numIter = (int)iters;
+  if (print)
+    opserr << "AMGCLKrylov::solve() - iterations: " << numIter
+	   << " relative residual: " << error << endln;
+
+  if ((int)iters >= maxIter && error > tol) {
+    opserr << "WARNING AMGCLKrylov::solve() - no convergence after "
+	   << numIter << " iterations, relative residual " << error << endln;
+    return -1;
+  }
+
+  for (int i=0; i<size; i++)
+    xOut[i] = x[i];
+
+  return numSetup;
+}
+
+int
+AMGCLKrylov::getNumIterations(void) const
+{
+  return numIter;
+}
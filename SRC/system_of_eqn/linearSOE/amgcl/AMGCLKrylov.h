@@ -0,0 +1,91 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for AMGCLKrylov.
+// AMGCLKrylov solves a sparse system Ax=b with a CG, BiCGStab or GMRES
+// iteration preconditioned by an AMGCL smoothed aggregation hierarchy.
+// It is not itself a LinearSOESolver; the SparseGenRowAMGCLSolver and
+// SparseGenColAMGCLSolver use it on the storage of their SOE.
+//
+// The hierarchy is built from A the first time it is needed and then
+// reused for up to maxReuse further matrices with the same pattern, so
+// that the setup is not repeated in every Newton iteration. The finest
+// level always sees the current values of A. If the iteration does not
+// converge with a reused hierarchy it is rebuilt and the solve repeated.
+//
+#ifndef AMGCLKrylov_h
+#define AMGCLKrylov_h
+
+#include <vector>
+#include <cstddef>
+
+class AMGCLHierarchy;
+
+class AMGCLKrylov
+{
+  public:
+    enum Method {
+      CG       = 0,
+      BiCGStab = 1,
+      GMRES    = 2
+    };
+
+    AMGCLKrylov(int method = GMRES, double tol = 1.0e-8, int maxIter = 500,
+		int restart = 30, int maxReuse = 10, bool print = false);
+    ~AMGCLKrylov();
+
+    // sets the pattern of A from its start and index arrays, by row or,
+    // if columnCompressed, by column; any hierarchy is discarded
+    int setPattern(int n, const int *start, const int *index,
+		   bool columnCompressed);
+
+    // solves Ax=b with the values of A in the order of the index array,
+    // valuesStamp identifying them; returns the number of hierarchies set
+    // up (0, 1 or 2) if successful, a negative number otherwise
+    int solve(const double *A, int valuesStamp, const double *b, double *x);
+
+    int getNumIterations(void) const;
+
+  private:
+    int setup(void);
+
+    int method;
+    double tol;
+    int maxIter;
+    int restart;
+    int maxReuse;
+    bool print;
+
+    int size;
+    std::vector<std::ptrdiff_t> ptr;   // row start of A
+    std::vector<std::ptrdiff_t> col;   // column of each entry of A
+    std::vector<int> valueMap;         // for column storage, the location
+                                       // in the input of each entry
+    std::vector<double> val;
+    std::vector<double> rhs, x;
+
+    AMGCLHierarchy *theHierarchy;
+    int lastStamp;                     // values stamp of the last solve
+    int numReuse;                      // matrices solved with the hierarchy
+                                       // since it was set up
+    int numIter;
+};
+
+#endif
@@ -0,0 +1,91 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of
+// SparseGenColAMGCLSolver.
+//
+#include <SparseGenColAMGCLSolver.h>
+#include <SparseGenColLinSOE.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <classTags.h>
+
+SparseGenColAMGCLSolver::SparseGenColAMGCLSolver(int method, double tol,
+						 int maxIter, int restart,
+						 int maxReuse, bool print)
+    :SparseGenColLinSolver(SOLVER_TAGS_SparseGenColAMGCLSolver),
+     theKrylov(method, tol, maxIter, restart, maxReuse, print)
+{
+}
+
+
+SparseGenColAMGCLSolver::~SparseGenColAMGCLSolver()
+{
+}
+
+int
+SparseGenColAMGCLSolver::setSize(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SparseGenColAMGCLSolver::setSize() - no SOE\n";
+	return -1;
+    }
+
+    numSymbolic++;
+    return theKrylov.setPattern(theSOE->size, theSOE->colStartA, theSOE->rowA, true);
+}
+
+int
+SparseGenColAMGCLSolver::solve(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SparseGenColAMGCLSolver::solve() - no SOE\n";
+	return -1;
+    }
+
+    if (theSOE->size == 0)
+	return 0;
+
+    // the hierarchies set up play the part of the numeric factorizations
+    int numSetup = theKrylov.solve(theSOE->A, theSOE->getValuesStamp(),
+				   theSOE->B, theSOE->X);
+    if (numSetup < 0)
+	return -1;
+
+    numNumeric += numSetup;
+    numSolve++;
+
+    return 0;
+}
+
+int
+SparseGenColAMGCLSolver::sendSelf(int cTag, Channel &theChannel)
+{
+    opserr << "SparseGenColAMGCLSolver::sendSelf() - not implemented\n";
+    return -1;
+}
+
+int
+SparseGenColAMGCLSolver::recvSelf(int ctag, Channel &theChannel,
+				    FEM_ObjectBroker &theBroker)
+{
+    opserr << "SparseGenColAMGCLSolver::recvSelf() - not implemented\n";
+    return -1;
+}
@@ -0,0 +1,157 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of
+// SparseGenRowAMGCLSolver.
+//
+#include <SparseGenRowAMGCLSolver.h>
+#include <SparseGenRowLinSOE.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <SparseGenColAMGCLSolver.h>
+#include <SparseGenColLinSOE.h>
+#include <elementAPI.h>
+#include <classTags.h>
+#include <string>
+
+void* OPS_AMGCLSolver()
+{
+    // system AMG <-cg|-bicgstab|-gmres> <-tol tol> <-maxIter n> <-restart m>
+    //            <-reuse n> <-col> <-print>
+    int method = AMGCLKrylov::GMRES;
+    double tol = 1.0e-8;
+    int maxIter = 500;
+    int restart = 30;
+    int maxReuse = 10;
+    bool byColumn = false;
+    bool print = false;
+
+    int numData = 1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	std::string type = OPS_GetString();
+	if (type == "-cg" || type == "-CG") {
+	    method = AMGCLKrylov::CG;
+	} else if (type == "-bicgstab" || type == "-BiCGStab") {
+	    method = AMGCLKrylov::BiCGStab;
+	} else if (type == "-gmres" || type == "-GMRES") {
+	    method = AMGCLKrylov::GMRES;
+	} else if (type == "-col") {
+	    byColumn = true;
+	} else if (type == "-print") {
+	    print = true;
+	} else if (type == "-tol" && OPS_GetNumRemainingInputArgs() > 0) {
+	    if (OPS_GetDoubleInput(&numData, &tol) < 0) {
+		opserr << "WARNING system AMG - invalid -tol\n";
+		return 0;
+	    }
+	} else if (type == "-maxIter" && OPS_GetNumRemainingInputArgs() > 0) {
+	    if (OPS_GetIntInput(&numData, &maxIter) < 0) {
+		opserr << "WARNING system AMG - invalid -maxIter\n";
+		return 0;
+	    }
+	} else if (type == "-restart" && OPS_GetNumRemainingInputArgs() > 0) {
+	    if (OPS_GetIntInput(&numData, &restart) < 0) {
+		opserr << "WARNING system AMG - invalid -restart\n";
+		return 0;
+	    }
+	} else if (type == "-reuse" && OPS_GetNumRemainingInputArgs() > 0) {
+	    if (OPS_GetIntInput(&numData, &maxReuse) < 0) {
+		opserr << "WARNING system AMG - invalid -reuse\n";
+		return 0;
+	    }
+	} else {
+	    opserr << "WARNING system AMG - unknown option " << type.c_str() << "\n";
+	    return 0;
+	}
+    }
+
+    if (byColumn) {
+	SparseGenColAMGCLSolver *theSolver =
+	    new SparseGenColAMGCLSolver(method, tol, maxIter, restart, maxReuse, print);
+	return new SparseGenColLinSOE(*theSolver);
+    }
+
+    SparseGenRowAMGCLSolver *theSolver =
+	new SparseGenRowAMGCLSolver(method, tol, maxIter, restart, maxReuse, print);
+    return new SparseGenRowLinSOE(*theSolver);
+}
+
+SparseGenRowAMGCLSolver::SparseGenRowAMGCLSolver(int method, double tol,
+						 int maxIter, int restart,
+						 int maxReuse, bool print)
+    :SparseGenRowLinSolver(SOLVER_TAGS_SparseGenRowAMGCLSolver),
+     theKrylov(method, tol, maxIter, restart, maxReuse, print)
+{
+}
+
+
+SparseGenRowAMGCLSolver::~SparseGenRowAMGCLSolver()
+{
+}
+
+int
+SparseGenRowAMGCLSolver::setSize(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SparseGenRowAMGCLSolver::setSize() - no SOE\n";
+	return -1;
+    }
+
+    numSymbolic++;
+    return theKrylov.setPattern(theSOE->size, theSOE->rowStartA, theSOE->colA, false);
+}
+
+int
+SparseGenRowAMGCLSolver::solve(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SparseGenRowAMGCLSolver::solve() - no SOE\n";
+	return -1;
+    }
+
+    if (theSOE->size == 0)
+	return 0;
+
+    // the hierarchies set up play the part of the numeric factorizations
+    int numSetup = theKrylov.solve(theSOE->A, theSOE->getValuesStamp(),
+				   theSOE->B, theSOE->X);
+    if (numSetup < 0)
+	return -1;
+
+    numNumeric += numSetup;
+    numSolve++;
+
+    return 0;
+}
+
+int
+SparseGenRowAMGCLSolver::sendSelf(int cTag, Channel &theChannel)
+{
+    opserr << "SparseGenRowAMGCLSolver::sendSelf() - not implemented\n";
+    return -1;
+}
+
+int
+SparseGenRowAMGCLSolver::recvSelf(int ctag, Channel &theChannel,
+				    FEM_ObjectBroker &theBroker)
+{
+    opserr << "SparseGenRowAMGCLSolver::recvSelf() - not implemented\n";
+    return -1;
+}
@@ -0,0 +1,53 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for
+// SparseGenRowAMGCLSolver. It solves the SparseGenRowLinSOE, which
+// stores A in the sparse row-compacted scheme, iteratively with an AMGCL
+// preconditioned Krylov method (see AMGCLKrylov).
+//
+#ifndef SparseGenRowAMGCLSolver_h
+#define SparseGenRowAMGCLSolver_h
+
+#include <SparseGenRowLinSolver.h>
+#include <AMGCLKrylov.h>
+
+class SparseGenRowAMGCLSolver : public SparseGenRowLinSolver
+{
+  public:
+    SparseGenRowAMGCLSolver(int method = AMGCLKrylov::GMRES, double tol = 1.0e-8,
+			  int maxIter = 500, int restart = 30, int maxReuse = 10,
+			  bool print = false);
+    ~SparseGenRowAMGCLSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    AMGCLKrylov theKrylov;
+};
+
+#endif
@@ -37,18 +37,32 @@
 
 #include <BandGenLinLapackSolver.h>
 #include <BandGenLinSOE.h>
+#include <elementAPI.h>
 #include <math.h>
+#include <string.h>
 
 void* OPS_BandGenLinLapack()
 {
-    BandGenLinSolver *theSolver = new BandGenLinLapackSolver();
+    // system BandGen <-mixed>
+    bool mixed = false;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *type = OPS_GetString();
+	if (strcmp(type, "-mixed") == 0)
+	    mixed = true;
+	else {
+	    opserr << "WARNING system BandGen - unknown option " << type << "\n";
+	    return 0;
+	}
+    }
+
+    BandGenLinSolver *theSolver = new BandGenLinLapackSolver(mixed);
     BandGenLinSOE *theSOE = new BandGenLinSOE(*theSolver);
     return theSOE;
 }
 
-BandGenLinLapackSolver::BandGenLinLapackSolver()
+BandGenLinLapackSolver::BandGenLinLapackSolver(bool mix)
 :BandGenLinSolver(SOLVER_TAGS_BandGenLinLapackSolver),
- iPiv(0), iPivSize(0)
+ iPiv(0), iPivSize(0), mixed(mix), singleFactored(false), normA(0.0)
 {
     
 }
@@ -70,6 +84,17 @@ extern "C" int DGBTRS(char *TRANS,
 			       double *A, int *LDA, int *iPiv, 
 			       double *B, int *LDB, int *INFO);
 
+extern "C" int SGBTRF(int *M, int *N, int *KL, int *KU, float *A,
+			       int *LDA, int *iPiv, int *INFO);
+
+extern "C" int SGBTRS(char *TRANS, 
+			       int *N, int *KL, int *KU, int *NRHS,
+			       float *A, int *LDA, int *iPiv, 
+			       float *B, int *LDB, int *INFO);
+
+#define sgbtrf_ SGBTRF
+#define sgbtrs_ SGBTRS
+
 #else
 
 extern "C" int dgbsv_(int *N, int *KL, int *KU, int *NRHS, double *A, 
@@ -79,6 +104,13 @@ extern "C" int dgbsv_(int *N, int *KL, int *KU, int *NRHS, double *A,
 extern "C" int dgbtrs_(char *TRANS, int *N, int *KL, int *KU, int *NRHS, 
 		       double *A, int *LDA, int *iPiv, double *B, int *LDB, 
 		       int *INFO);
+
+extern "C" int sgbtrf_(int *M, int *N, int *KL, int *KU, float *A, 
+		       int *LDA, int *iPiv, int *INFO);
+
+extern "C" int sgbtrs_(char *TRANS, int *N, int *KL, int *KU, int *NRHS, 
+		       float *A, int *LDA, int *iPiv, float *B, int *LDB, 
+		       int *INFO);
 #endif
 int
 BandGenLinLapackSolver::solve(void)
@@ -108,6 +140,25 @@ BandGenLinLapackSolver::solve(void)
     double *Bptr = theSOE->B;
     int    *iPIV = iPiv;
     
+    // in mixed precision mode factor a new A in single precision, keeping
+    // A itself for the residuals of the refinement
+    if (theSOE->factored == false) {
+	singleFactored = false;
+	if (mixed == true && this->factorSingle() == 0) {
+	    singleFactored = true;
+	    theSOE->factored = true;
+	}
+    }
+
+    if (singleFactored == true) {
+	if (this->solveSingle() == 0)
+	    return 0;
+
+	// the refinement stalled, A is still unfactored
+	singleFactored = false;
+	theSOE->factored = false;
+    }
+
     // first copy B into X
     for (int i=0; i<n; i++) {
 	*(Xptr++) = *(Bptr++);
@@ -154,6 +205,87 @@ BandGenLinLapackSolver::solve(void)
     
 
 
+int
+BandGenLinLapackSolver::factorSingle(void)
+{
+    int n = theSOE->size;
+    int kl = theSOE->numSubD;
+    int ku = theSOE->numSuperD;
+    int ldA = 2*kl + ku +1;
+    int info = 0;
+    const double *A = theSOE->A;
+    if (n == 0)
+	return -1;
+
+    Af.resize(ldA*n);
+    Xf.resize(n);
+    for (int k=0; k<ldA*n; k++)
+	Af[k] = (float)A[k];
+
+    // row sums of |A|; A(i,j) is in row kl+ku+i-j of column j
+    std::vector<double> rowSum(n, 0.0);
+    for (int j=0; j<n; j++) {
+	const double *colj = A + j*ldA + kl + ku - j;
+	int iStart = (j > ku) ? j-ku : 0;
+	int iEnd = (j+kl < n) ? j+kl+1 : n;
+	for (int i=iStart; i<iEnd; i++)
+	    rowSum[i] += fabs(colj[i]);
+    }
+    normA = 0.0;
+    for (int i=0; i<n; i++)
+	if (rowSum[i] > normA)
+	    normA = rowSum[i];
+
+    sgbtrf_(&n, &n, &kl, &ku, &Af[0], &ldA, iPiv, &info);
+
+    return info;
+}
+
+int
+BandGenLinLapackSolver::solveSingle(void)
+{
+    int n = theSOE->size;
+    int kl = theSOE->numSubD;
+    int ku = theSOE->numSuperD;
+    int ldA = 2*kl + ku +1;
+    const double *A = theSOE->A;
+    const double *B = theSOE->B;
+    double *X = theSOE->X;
+
+    IterativeRefinement::Residual residual =
+	[&](const double *x, double *r) {
+	for (int i=0; i<n; i++)
+	    r[i] = B[i];
+	for (int j=0; j<n; j++) {
+	    const double *colj = A + j*ldA + kl + ku - j;
+	    int iStart = (j > ku) ? j-ku : 0;
+	    int iEnd = (j+kl < n) ? j+kl+1 : n;
+	    for (int i=iStart; i<iEnd; i++)
+		r[i] -= colj[i]*x[j];
+	}
+    };
+
+    IterativeRefinement::Correction correction = [&](double *r) {
+	char trans[] = "N";
+	int nrhs = 1;
+	int info = 0;
+	for (int i=0; i<n; i++)
+	    Xf[i] = (float)r[i];
+	sgbtrs_(trans, &n, &kl, &ku, &nrhs, &Af[0], &ldA, iPiv, &Xf[0], &n, &info);
+	for (int i=0; i<n; i++)
+	    r[i] = Xf[i];
+	return info;
+    };
+
+    // the first solution is the correction to x = 0
+    for (int i=0; i<n; i++)
+	X[i] = B[i];
+    if (correction(X) != 0)
+	return -1;
+
+    return (theRefinement.refine(n, X, normA, residual, correction) < 0) ? -1 : 0;
+}
+
 int
 BandGenLinLapackSolver::setSize()
 {
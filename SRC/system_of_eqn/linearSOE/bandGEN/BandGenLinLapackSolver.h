@@ -31,7 +31,9 @@
 //
 // Description: This file contains the class definition for 
 // BandGenLinLapackSolver. It solves the BandGenLinSOE object by calling
-// Lapack routines.
+// Lapack routines. In mixed precision mode A is factored in single
+// precision and the solution refined to double precision accuracy; if
+// the refinement stalls A is factored in double precision instead.
 //
 // What: "@(#) BandGenLinLapackSolver.h, revA"
 
@@ -39,11 +41,13 @@
 #define BandGenLinLapackSolver_h
 
 #include <BandGenLinSolver.h>
+#include <IterativeRefinement.h>
+#include <vector>
 
 class BandGenLinLapackSolver : public BandGenLinSolver
 {
   public:
-    BandGenLinLapackSolver();    
+    BandGenLinLapackSolver(bool mixed = false);
     ~BandGenLinLapackSolver();
 
     int solve(void);
@@ -56,8 +60,18 @@ class BandGenLinLapackSolver : public BandGenLinSolver
   protected:
 
   private:
+    int factorSingle(void);
+    int solveSingle(void);
+
     int *iPiv;
     int iPivSize;
+
+    bool mixed;                    // factor in single precision
+    bool singleFactored;           // A factored in Af, not in place
+    std::vector<float> Af;         // single precision factors of A
+    std::vector<float> Xf;
+    double normA;
+    IterativeRefinement theRefinement;
 };
 
 #endif
@@ -383,6 +383,14 @@ BandGenLinSOE::addColA(const Vector &colData, int col, double fact)
 }
 
     
+
+// the band location of an entry is computed from its row and column
+bool
+BandGenLinSOE::canAddConcurrently(void) const
+{
+    return true;
+}
+
 int 
 BandGenLinSOE::addB(const Vector &v, const ID &id, double fact)
 {
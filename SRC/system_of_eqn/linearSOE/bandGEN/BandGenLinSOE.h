@@ -59,6 +59,7 @@ class BandGenLinSOE : public LinearSOE
     virtual int addA(const Matrix &, const ID &, double fact = 1.0);
     virtual int addColA(const Vector &col, int colIndex, double fact = 1.0);
     virtual int addB(const Vector &, const ID &, double fact = 1.0);    
+    virtual bool canAddConcurrently(void) const;
     virtual int setB(const Vector &, double fact = 1.0);        
 
     virtual void zeroA(void);
@@ -33,17 +33,32 @@
 #include <BandSPDLinLapackSolver.h>
 #include <BandSPDLinSOE.h>
 //#include <f2c.h>
+#include <elementAPI.h>
 #include <math.h>
+#include <string.h>
 
 void* OPS_BandSPDLinLapack()
 {
-    BandSPDLinSolver *theSolver = new BandSPDLinLapackSolver();
+    // system BandSPD <-mixed>
+    bool mixed = false;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *type = OPS_GetString();
+	if (strcmp(type, "-mixed") == 0)
+	    mixed = true;
+	else {
+	    opserr << "WARNING system BandSPD - unknown option " << type << "\n";
+	    return 0;
+	}
+    }
+
+    BandSPDLinSolver *theSolver = new BandSPDLinLapackSolver(mixed);
     BandSPDLinSOE *theSOE = new BandSPDLinSOE(*theSolver);
     return theSOE;
 }
 
-BandSPDLinLapackSolver::BandSPDLinLapackSolver()
-:BandSPDLinSolver(SOLVER_TAGS_BandSPDLinLapackSolver)
+BandSPDLinLapackSolver::BandSPDLinLapackSolver(bool mix)
+:BandSPDLinSolver(SOLVER_TAGS_BandSPDLinLapackSolver),
+ mixed(mix), singleFactored(false), normA(0.0)
 {
     
 }
@@ -64,6 +79,17 @@ extern "C" int  DPBTRS(char *UPLO,
 			       int *N, int *KD, int *NRHS, 
 			       double *A, int *LDA, double *B, int *LDB, 
 			       int *INFO);
+
+extern "C" int  SPBTRF(char *UPLO, int *N, int *KD,
+			       float *A, int *LDA, int *INFO);
+
+extern "C" int  SPBTRS(char *UPLO,
+			       int *N, int *KD, int *NRHS, 
+			       float *A, int *LDA, float *B, int *LDB, 
+			       int *INFO);
+
+#define spbtrf_ SPBTRF
+#define spbtrs_ SPBTRS
 #else
 
 extern "C" int dpbsv_(char *UPLO, int *N, int *KD, int *NRHS, 
@@ -74,6 +100,13 @@ extern "C" int dpbtrs_(char *UPLO, int *N, int *KD, int *NRHS,
 		       double *A, int *LDA, double *B, int *LDB, 
 		       int *INFO);
 
+extern "C" int spbtrf_(char *UPLO, int *N, int *KD,
+		       float *A, int *LDA, int *INFO);
+
+extern "C" int spbtrs_(char *UPLO, int *N, int *KD, int *NRHS, 
+		       float *A, int *LDA, float *B, int *LDB, 
+		       int *INFO);
+
 #endif
 		       
 
@@ -96,6 +129,25 @@ BandSPDLinLapackSolver::solve(void)
     double *Xptr = theSOE->X;
     double *Bptr = theSOE->B;
 
+    // in mixed precision mode factor a new A in single precision, keeping
+    // A itself for the residuals of the refinement
+    if (theSOE->factored == false) {
+	singleFactored = false;
+	if (mixed == true && this->factorSingle() == 0) {
+	    singleFactored = true;
+	    theSOE->factored = true;
+	}
+    }
+
+    if (singleFactored == true) {
+	if (this->solveSingle() == 0)
+	    return 0;
+
+	// the refinement stalled, A is still unfactored
+	singleFactored = false;
+	theSOE->factored = false;
+    }
+
     // first copy B into X
     for (int i=0; i<n; i++)
 	*(Xptr++) = *(Bptr++);
@@ -143,6 +195,93 @@ BandSPDLinLapackSolver::solve(void)
     
 
 
+int
+BandSPDLinLapackSolver::factorSingle(void)
+{
+    int n = theSOE->size;
+    int kd = theSOE->half_band -1;
+    int ldA = kd +1;
+    int info = 0;
+    const double *A = theSOE->A;
+    if (n == 0)
+	return -1;
+
+    Af.resize(ldA*n);
+    Xf.resize(n);
+    for (int k=0; k<ldA*n; k++)
+	Af[k] = (float)A[k];
+
+    // row sums of |A|; column j holds A(i,j) for j-kd <= i <= j in its
+    // last i-j+kd+1 entries
+    std::vector<double> rowSum(n, 0.0);
+    for (int j=0; j<n; j++) {
+	const double *colj = A + j*ldA + kd - j;
+	int iStart = (j > kd) ? j-kd : 0;
+	for (int i=iStart; i<j; i++) {
+	    rowSum[i] += fabs(colj[i]);
+	    rowSum[j] += fabs(colj[i]);
+	}
+	rowSum[j] += fabs(colj[j]);
+    }
+    normA = 0.0;
+    for (int i=0; i<n; i++)
+	if (rowSum[i] > normA)
+	    normA = rowSum[i];
+
+    char uplo[] = "U";
+    spbtrf_(uplo, &n, &kd, &Af[0], &ldA, &info);
+
+    return info;
+}
+
+int
+BandSPDLinLapackSolver::solveSingle(void)
+{
+    int n = theSOE->size;
+    int kd = theSOE->half_band -1;
+    int ldA = kd +1;
+    const double *A = theSOE->A;
+    const double *B = theSOE->B;
+    double *X = theSOE->X;
+
+    // r = b - Ax, with the symmetric A stored by its upper band
+    IterativeRefinement::Residual residual =
+	[&](const double *x, double *r) {
+	for (int i=0; i<n; i++)
+	    r[i] = B[i];
+	for (int j=0; j<n; j++) {
+	    const double *colj = A + j*ldA + kd - j;
+	    int iStart = (j > kd) ? j-kd : 0;
+	    double sum = colj[j]*x[j];
+	    for (int i=iStart; i<j; i++) {
+		r[i] -= colj[i]*x[j];
+		sum += colj[i]*x[i];
+	    }
+	    r[j] -= sum;
+	}
+    };
+
+    IterativeRefinement::Correction correction = [&](double *r) {
+	char uplo[] = "U";
+	int nrhs = 1;
+	int info = 0;
+	for (int i=0; i<n; i++)
+	    Xf[i] = (float)r[i];
+	spbtrs_(uplo, &n, &kd, &nrhs, &Af[0], &ldA, &Xf[0], &n, &info);
+	for (int i=0; i<n; i++)
+	    r[i] = Xf[i];
+	return info;
+    };
+
+    // the first solution is the correction to x = 0
+    for (int i=0; i<n; i++)
+	X[i] = B[i];
+    if (correction(X) != 0)
+	return -1;
+
+    return (theRefinement.refine(n, X, normA, residual, correction) < 0) ? -1 : 0;
+}
+
 int
 BandSPDLinLapackSolver::setSize()
 {
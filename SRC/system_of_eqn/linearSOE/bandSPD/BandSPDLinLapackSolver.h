@@ -31,17 +31,21 @@
 //
 // Description: This file contains the class definition for 
 // BandSPDLinLapackSolver. It solves the BandSPDLinSOE object by calling
-// Lapack routines.
+// Lapack routines. In mixed precision mode A is factored in single
+// precision and the solution refined to double precision accuracy; if
+// the refinement stalls A is factored in double precision instead.
 //
 // What: "@(#) BandSPDLinLapackSolver.h, revA"
 
 
 #include <BandSPDLinSolver.h>
+#include <IterativeRefinement.h>
+#include <vector>
 
 class BandSPDLinLapackSolver : public BandSPDLinSolver
 {
   public:
-    BandSPDLinLapackSolver();    
+    BandSPDLinLapackSolver(bool mixed = false);
     ~BandSPDLinLapackSolver();
 
     int solve(void);
@@ -54,7 +58,15 @@ class BandSPDLinLapackSolver : public BandSPDLinSolver
   protected:
 
   private:
+    int factorSingle(void);
+    int solveSingle(void);
 
+    bool mixed;                    // factor in single precision
+    bool singleFactored;           // A factored in Af, not in place
+    std::vector<float> Af;         // single precision factors of A
+    std::vector<float> Xf;
+    double normA;
+    IterativeRefinement theRefinement;
 };
 
 #endif
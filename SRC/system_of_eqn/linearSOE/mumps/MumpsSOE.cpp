@@ -115,6 +115,7 @@ MumpsSOE::setSize(Graph &theGraph)
   int result = 0;
   int oldSize = size;
   size = theGraph.getNumVertex();
+  theScatterMap.clear();
   
   // fist itearte through the vertices of the graph to get nnz
   Vertex *theVertex;
@@ -157,6 +158,7 @@ MumpsSOE::setSize(Graph &theGraph)
     A[i] = 0;
   
   factored = false;
+  this->patternChanged();
   
   if (size > Bsize) { // we have to get space for the vectors
     
@@ -278,6 +280,13 @@ MumpsSOE::setSize(Graph &theGraph)
   for (int i=0; i<size; i++)
     for (int k=colStartA[i]; k<colStartA[i+1]; k++)
       colA[count++] = i;
+
+  // locate the entries of the FE_Element tangents in A; with matType != 0
+  // only the lower triangle is stored
+  if (theModel != 0 && size != 0)
+    theScatterMap.build(*theModel, size, colStartA, rowA,
+			matType != 0 ? ScatterMap::LowerColumnCompressed :
+			ScatterMap::ColumnCompressed);
   
   // invoke setSize() on the Solver    
   LinearSOESolver *the_Solver = this->getSolver();
@@ -399,6 +408,22 @@ MumpsSOE::addA(const Matrix &m, const ID &id, double fact)
     return 0;
 }
 
+
+int 
+MumpsSOE::addA(const Matrix &m, const FE_Element &theEle, double fact)
+{
+  // check for a quick return 
+  if (fact == 0.0)  
+    return 0;
+
+  // use the locations found in setSize(); search as in addA(m, id, fact)
+  // for an FE_Element without a map
+  if (theScatterMap.add(A, m, theEle, fact))
+    return 0;
+
+  return this->addA(m, theEle.getID(), fact);
+}
+
     
 int 
 MumpsSOE::addB(const Vector &v, const ID &id, double fact)
@@ -476,6 +501,7 @@ MumpsSOE::zeroA(void)
 	*Aptr++ = 0;
 
 	factored = false;
+	this->valuesChanged();
 }
 	
 void 
@@ -41,6 +41,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <ScatterMap.h>
 #include <mumps_c_types.h>
 class MumpsSolver;
 class MumpsParallelSolver;
@@ -59,6 +60,7 @@ class MumpsSOE : public LinearSOE
     virtual int getNumEqn(void) const;
     virtual int setSize(Graph &theGraph);
     virtual int addA(const Matrix &, const ID &, double fact = 1.0);
+    virtual int addA(const Matrix &, const FE_Element &, double fact = 1.0);
     virtual int addB(const Vector &, const ID &, double fact = 1.0);    
     virtual int setB(const Vector &, double fact = 1.0);        
     
@@ -91,6 +93,7 @@ class MumpsSOE : public LinearSOE
     int matType;
 
   private:
+    ScatterMap theScatterMap;  // location in A of the FE_Element tangents
 };
 
 
@@ -126,6 +126,7 @@ MumpsSolver::initializeMumps(void)
     // Call the MUMPS package to factor & solve the system
     id.job = 1;
     dmumps_c(&id);
+    numSymbolic++;
 
     int info = id.infog[0];
     if (info != 0) {
@@ -183,6 +184,8 @@ MumpsSolver::solveAfterInitialization(void)
     // Call the MUMPS package to factor & solve the system
     id.job = 5;
     dmumps_c(&id);
+    numNumeric++;
+    numSolve++;
 
     theMumpsSOE->factored = true;
   } else {
@@ -199,6 +202,7 @@ MumpsSolver::solveAfterInitialization(void)
     // Call the MUMPS package to factor & solve the system
     id.job = 3;
     dmumps_c(&id);
+    numSolve++;
   }	
 
 
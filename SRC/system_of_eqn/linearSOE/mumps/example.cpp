@@ -45,7 +45,7 @@ SimulationInformation simulationInfo;
  
 double        ops_Dt = 0;
 Domain       *ops_TheActiveDomain = 0;
-Element      *ops_TheActiveElement = 0;
+thread_local Element      *ops_TheActiveElement = 0;
 
 int main(int argc, char ** argv)
 {
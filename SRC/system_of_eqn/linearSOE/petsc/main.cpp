@@ -47,7 +47,7 @@ OPS_Stream *opserrPtr = &sserr;
  
 double        ops_Dt = 0;
 Domain       *ops_TheActiveDomain = 0;
-Element      *ops_TheActiveElement = 0;
+thread_local Element      *ops_TheActiveElement = 0;
 
 main() 
 {
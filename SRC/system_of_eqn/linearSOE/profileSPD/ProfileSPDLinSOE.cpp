@@ -422,6 +422,14 @@ ProfileSPDLinSOE::addColA(const Vector &colData, int col, double fact)
 }
 
     
+
+// the location of an entry is found from iDiagLoc, fixed in setSize()
+bool
+ProfileSPDLinSOE::canAddConcurrently(void) const
+{
+    return true;
+}
+
 int 
 ProfileSPDLinSOE::addB(const Vector &v, const ID &id, double fact)
 {
@@ -55,6 +55,7 @@ class ProfileSPDLinSOE : public LinearSOE
     virtual int addColA(const Vector &col, int colIndex, double fact = 1.0);
 
     virtual int addB(const Vector &, const ID &, double fact = 1.0);    
+    virtual bool canAddConcurrently(void) const;
     virtual int setB(const Vector &, double fact = 1.0);
     
     virtual void zeroA(void);
@@ -167,6 +167,7 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
     int result = 0;
     int oldSize = size;
     size = theGraph.getNumVertex();
+    theScatterMap.clear();
 
     // fist itearte through the vertices of the graph to get nnz
     Vertex *theVertex;
@@ -203,6 +204,7 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
 	A[i] = 0;
 	
     factored = false;
+    this->patternChanged();
     
     if (size > Bsize) { // we have to get space for the vectors
 	
@@ -291,6 +293,10 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
       }
     }
 
+    // locate the entries of the FE_Element tangents in A
+    if (theModel != 0 && size != 0)
+      theScatterMap.build(*theModel, size, colStartA, rowA,
+			  ScatterMap::ColumnCompressed);
     
     // invoke setSize() on the Solver    
     LinearSOESolver *the_Solver = this->getSolver();
@@ -362,7 +368,31 @@ SparseGenColLinSOE::addA(const Matrix &m, const ID &id, double fact)
     return 0;
 }
 
+
+int 
+SparseGenColLinSOE::addA(const Matrix &m, const FE_Element &theEle, double fact)
+{
+    // check for a quick return 
+    if (fact == 0.0)  
+	return 0;
+
+    // use the locations found in setSize(); search as in addA(m, id, fact)
+    // for an FE_Element without a map
+    if (theScatterMap.add(A, m, theEle, fact))
+	return 0;
+
+    return this->addA(m, theEle.getID(), fact);
+}
     
+
+// the location of an entry is found by a search of rowA or from the
+// ScatterMap, both only read after setSize()
+bool
+SparseGenColLinSOE::canAddConcurrently(void) const
+{
+    return true;
+}
+
 int 
 SparseGenColLinSOE::addB(const Vector &v, const ID &id, double fact)
 {
@@ -438,6 +468,7 @@ SparseGenColLinSOE::zeroA(void)
 	*Aptr++ = 0;
 
     factored = false;
+    this->valuesChanged();
 }
 	
 void 
@@ -38,6 +38,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <ScatterMap.h>
 
 class SparseGenColLinSolver;
 
@@ -56,7 +57,9 @@ class SparseGenColLinSOE : public LinearSOE
     virtual int getNumEqn(void) const;
     virtual int setSize(Graph &theGraph);
     virtual int addA(const Matrix &, const ID &, double fact = 1.0);
+    virtual int addA(const Matrix &, const FE_Element &, double fact = 1.0);
     virtual int addB(const Vector &, const ID &, double fact = 1.0);    
+    virtual bool canAddConcurrently(void) const;
     virtual int setB(const Vector &, double fact = 1.0);        
     
     virtual void zeroA(void);
@@ -86,6 +89,7 @@ class SparseGenColLinSOE : public LinearSOE
 #endif
 #endif
     friend class PFEMSolver;
+    friend class SparseGenColAMGCLSolver;
 
   protected:
     int size;            // order of A
@@ -98,6 +102,7 @@ class SparseGenColLinSOE : public LinearSOE
     bool factored;
     
   private:
+    ScatterMap theScatterMap;  // location in A of the FE_Element tangents
 
 };
 
@@ -131,6 +131,7 @@ SparseGenRowLinSOE::setSize(Graph &theGraph)
     int result = 0;
     int oldSize = size;
     size = theGraph.getNumVertex();
+    theScatterMap.clear();
 
     // fist itearte through the vertices of the graph to get nnz
     Vertex *theVertex;
@@ -167,6 +168,7 @@ SparseGenRowLinSOE::setSize(Graph &theGraph)
 	A[i] = 0;
 	
     factored = false;
+    this->patternChanged();
     
     if (size > Bsize) { // we have to get space for the vectors
 	
@@ -255,6 +257,11 @@ SparseGenRowLinSOE::setSize(Graph &theGraph)
       }
     }
 
+    // locate the entries of the FE_Element tangents in A
+    if (theModel != 0 && size != 0)
+      theScatterMap.build(*theModel, size, rowStartA, colA,
+			  ScatterMap::RowCompressed);
+
     // invoke setSize() on the Solver   
      LinearSOESolver *the_Solver = this->getSolver();
     int solverOK = the_Solver->setSize();
@@ -324,6 +331,22 @@ SparseGenRowLinSOE::addA(const Matrix &m, const ID &id, double fact)
     return 0;
 }
 
+
+int 
+SparseGenRowLinSOE::addA(const Matrix &m, const FE_Element &theEle, double fact)
+{
+    // check for a quick return 
+    if (fact == 0.0)  
+	return 0;
+
+    // use the locations found in setSize(); search as in addA(m, id, fact)
+    // for an FE_Element without a map
+    if (theScatterMap.add(A, m, theEle, fact))
+	return 0;
+
+    return this->addA(m, theEle.getID(), fact);
+}
+
     
 int 
 SparseGenRowLinSOE::addB(const Vector &v, const ID &id, double fact)
@@ -400,6 +423,7 @@ SparseGenRowLinSOE::zeroA(void)
 	*Aptr++ = 0;
 
     factored = false;
+    this->valuesChanged();
 }
 	
 void 
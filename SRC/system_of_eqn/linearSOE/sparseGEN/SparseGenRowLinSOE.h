@@ -38,6 +38,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <ScatterMap.h>
 
 class SparseGenRowLinSolver;
 
@@ -51,6 +52,7 @@ class SparseGenRowLinSOE : public LinearSOE
     int getNumEqn(void) const;
     int setSize(Graph &theGraph);
     int addA(const Matrix &, const ID &, double fact = 1.0);
+    int addA(const Matrix &, const FE_Element &, double fact = 1.0);
     int addB(const Vector &, const ID &, double fact = 1.0);    
     int setB(const Vector &, double fact = 1.0);        
     
@@ -71,6 +73,7 @@ class SparseGenRowLinSOE : public LinearSOE
     friend class CulaSparseSolverS4;    
     friend class CulaSparseSolverS5;    
 	friend class CuSPSolver;
+    friend class SparseGenRowAMGCLSolver;
 
   protected:
     
@@ -83,6 +86,7 @@ class SparseGenRowLinSOE : public LinearSOE
     Vector *vectB;    
     int Asize, Bsize;    // size of the 1d array holding A
     bool factored;
+    ScatterMap theScatterMap;  // location in A of the FE_Element tangents
 };
 
 
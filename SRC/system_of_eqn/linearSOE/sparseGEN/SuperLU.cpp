@@ -244,6 +244,7 @@ SuperLU::solve(void)
 
 	dgstrf(&options, &AC, relax, panelSize,
 	       etree, NULL, 0, perm_c, perm_r, &L, &U, &Glu, &stat, &info);
+	numNumeric++;
 
 
 	if (info != 0) {	
@@ -264,6 +265,7 @@ SuperLU::solve(void)
     trans_t trans = NOTRANS;
     int info;
     dgstrs (trans, &L, &U, perm_c, perm_r, &B, &stat, &info);    
+    numSolve++;
 
     if (info != 0) {	
        opserr << "WARNING SuperLU::solve(void)- ";
@@ -320,6 +322,7 @@ SuperLU::setSize()
       get_perm_c(permSpec, &A, perm_c);
 
       sp_preorder(&options, &A, perm_c, etree, &AC);
+      numSymbolic++;
 
       // create the rhs SuperMatrix B 
       dCreate_Dense_Matrix(&B, n, 1, theSOE->X, n, SLU_DN, SLU_D, SLU_GE);
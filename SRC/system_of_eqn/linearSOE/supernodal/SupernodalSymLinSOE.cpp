@@ -0,0 +1,370 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of
+// SupernodalSymLinSOE.
+//
+#include <SupernodalSymLinSOE.h>
+#include <SupernodalSymLinSolver.h>
+#include <DomainSolver.h>
+#include <Matrix.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <ID.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <classTags.h>
+
+SupernodalSymLinSOE::SupernodalSymLinSOE(SupernodalSymLinSolver &the_Solver)
+    :LinearSOE(the_Solver, LinSOE_TAGS_SupernodalSymLinSOE),
+     X(), B(), colStartA(), rowA(), A()
+{
+    the_Solver.setLinearSOE(*this);
+}
+
+
+SupernodalSymLinSOE::SupernodalSymLinSOE()
+    :LinearSOE(LinSOE_TAGS_SupernodalSymLinSOE),
+     X(), B(), colStartA(), rowA(), A()
+{
+}
+
+
+SupernodalSymLinSOE::~SupernodalSymLinSOE()
+{
+}
+
+
+int
+SupernodalSymLinSOE::getNumEqn(void) const
+{
+    return X.Size();
+}
+
+int
+SupernodalSymLinSOE::setSize(Graph &theGraph)
+{
+    int size = theGraph.getNumVertex();
+    if (size < 0) {
+	opserr << "WARNING SupernodalSymLinSOE::setSize - size of soe < 0\n";
+	return -1;
+    }
+    theScatterMap.clear();
+
+    // keep the old structure to find out if the pattern has changed
+    std::vector<int> oldColStart, oldRow;
+    oldColStart.swap(colStartA);
+    oldRow.swap(rowA);
+
+    // only the lower triangle is stored: the diagonal and, from the
+    // adjacency of each vertex, the rows below it
+    Vertex *theVertex;
+    int nnz = 0;
+    VertexIter &theVertices = theGraph.getVertices();
+    while ((theVertex = theVertices()) != 0) {
+	const ID &theAdjacency = theVertex->getAdjacency();
+	nnz += theAdjacency.Size()/2 + 1;
+    }
+
+    colStartA.reserve(size+1);
+    rowA.reserve(nnz);
+    B.resize(size);
+    B.Zero();
+    X.resize(size);
+    X.Zero();
+
+    colStartA.push_back(0);
+    for (int a=0; a<size; a++) {
+
+	theVertex = theGraph.getVertexPtr(a);
+	if (theVertex == 0) {
+	    opserr << "WARNING:SupernodalSymLinSOE::setSize :";
+	    opserr << " vertex " << a << " not in graph! - size set to 0\n";
+	    colStartA.clear();
+	    rowA.clear();
+	    A.clear();
+	    X.resize(0);
+	    B.resize(0);
+	    this->patternChanged();
+	    return -1;
+	}
+
+	const ID &theAdjacency = theVertex->getAdjacency();
+	int idSize = theAdjacency.Size();
+	ID col(0,idSize+1);
+
+	// diagonal, then the rows below it in order
+	col.insert(a);
+	for (int i=0; i<idSize; i++) {
+	    int row = theAdjacency(i);
+	    if (row > a && row < size)
+		col.insert(row);
+	}
+
+	for (int i=0; i<col.Size(); i++)
+	    rowA.push_back(col(i));
+
+	colStartA.push_back(colStartA[a]+col.Size());
+    }
+
+    A.assign(rowA.size(), 0.0);
+
+    // the ordering and the symbolic factorization are redone only if the
+    // structure of A differs from the last one
+    if (colStartA != oldColStart || rowA != oldRow)
+	this->patternChanged();
+    else
+	this->valuesChanged();
+
+    // locate the entries of the FE_Element tangents in A
+    if (theModel != 0 && size != 0)
+	theScatterMap.build(*theModel, size, &colStartA[0], &rowA[0],
+			    ScatterMap::LowerColumnCompressed);
+
+    // invoke setSize() on the Solver
+    LinearSOESolver *the_Solver = this->getSolver();
+    int solverOK = the_Solver->setSize();
+    if (solverOK < 0) {
+	opserr << "WARNING:SupernodalSymLinSOE::setSize :";
+	opserr << " solver failed setSize()\n";
+	return solverOK;
+    }
+
+    return 0;
+}
+
+int
+SupernodalSymLinSOE::addA(const Matrix &m, const ID &id, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0) return 0;
+
+    int idSize = id.Size();
+
+    // check that m and id are of similar size
+    if (idSize != m.noRows() && idSize != m.noCols()) {
+	opserr << "SupernodalSymLinSOE::addA() ";
+	opserr << " - Matrix and ID not of similar sizes\n";
+	return -1;
+    }
+
+    // only the entries in the lower triangle are added, A is assumed
+    // symmetric
+    int size = X.Size();
+    for (int j=0; j<idSize; j++) {
+	int col = id(j);
+	if (col<0 || col>=size)
+	    continue;
+	for (int i=0; i<idSize; i++) {
+	    int row = id(i);
+	    if (row<col || row>=size)
+		continue;
+
+	    for (int k=colStartA[col]; k<colStartA[col+1]; k++) {
+		if (rowA[k] == row) {
+		    A[k] += fact*m(i,j);
+		    break;
+		}
+	    }
+	}
+    }
+
+    return 0;
+}
+
+int
+SupernodalSymLinSOE::addA(const Matrix &m, const FE_Element &theEle, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0) return 0;
+
+    if (A.size() > 0 && theScatterMap.add(&A[0], m, theEle, fact))
+	return 0;
+
+    return this->addA(m, theEle.getID(), fact);
+}
+
+bool
+SupernodalSymLinSOE::canAddConcurrently(void) const
+{
+    return true;
+}
+
+int
+SupernodalSymLinSOE::addB(const Vector &v, const ID &id, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)  return 0;
+
+    int idSize = id.Size();
+    // check that m and id are of similar size
+    if (idSize != v.Size() ) {
+	opserr << "SupernodalSymLinSOE::addB() ";
+	opserr << " - Vector and ID not of similar sizes\n";
+	return -1;
+    }
+
+    int size = B.Size();
+    if (fact == 1.0) { // do not need to multiply if fact == 1.0
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0) B[pos] += v(i);
+	}
+    } else if (fact == -1.0) { // do not need to multiply if fact == -1.0
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0) B[pos] -= v(i);
+	}
+    } else {
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0) B[pos] += v(i) * fact;
+	}
+    }
+
+    return 0;
+}
+
+
+int
+SupernodalSymLinSOE::setB(const Vector &v, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)  {
+	B.Zero();
+	return 0;
+    }
+
+    int size = B.Size();
+    if (v.Size() != size) {
+	opserr << "WARNING SupernodalSymLinSOE::setB() -";
+	opserr << " incomptable sizes " << size << " and " << v.Size() << endln;
+	return -1;
+    }
+
+    if (fact == 1.0) { // do not need to multiply if fact == 1.0
+	for (int i=0; i<size; i++) {
+	    B[i] = v(i);
+	}
+    } else if (fact == -1.0) {
+	for (int i=0; i<size; i++) {
+	    B[i] = -v(i);
+	}
+    } else {
+	for (int i=0; i<size; i++) {
+	    B[i] = v(i) * fact;
+	}
+    }
+
+    return 0;
+}
+
+void
+SupernodalSymLinSOE::zeroA(void)
+{
+    A.assign(A.size(),0.0);
+    this->valuesChanged();
+}
+
+void
+SupernodalSymLinSOE::zeroB(void)
+{
+    B.Zero();
+}
+
+void
+SupernodalSymLinSOE::setX(int loc, double value)
+{
+    if (loc<X.Size() && loc>=0) {
+	X(loc) = value;
+    }
+}
+
+
+void
+SupernodalSymLinSOE::setX(const Vector &x)
+{
+    if (x.Size() == X.Size()) {
+	X = x;
+    }
+}
+
+
+const Vector &
+SupernodalSymLinSOE::getX(void)
+{
+    return X;
+}
+
+const Vector &
+SupernodalSymLinSOE::getB(void)
+{
+    return B;
+}
+
+double
+SupernodalSymLinSOE::normRHS(void)
+{
+    return B.Norm();
+}
+
+
+int
+SupernodalSymLinSOE::setSupernodalSymLinSolver(SupernodalSymLinSolver &newSolver)
+{
+    newSolver.setLinearSOE(*this);
+    if (X.Size() != 0) {
+	int solverOK = newSolver.setSize();
+	if (solverOK < 0) {
+	    opserr << "WARNING:SupernodalSymLinSOE::setSolver :";
+	    opserr << "the new solver could not setSeize() - staying with old\n";
+	    return -1;
+	}
+    }
+    return this->LinearSOE::setSolver(newSolver);
+}
+
+
+// the SOE is only moved when it condenses a subdomain; A, B and X are
+// then formed again by setSize() on the receiving side and the
+// SupernodalSymLinSubstrSolver is sent by the analysis
+int
+SupernodalSymLinSOE::sendSelf(int cTag, Channel &theChannel)
+{
+    if (dynamic_cast<DomainSolver *>(this->getSolver()) == 0) {
+	opserr << "SupernodalSymLinSOE::sendSelf() - not implemented";
+	opserr << " without a SupernodalSymLinSubstrSolver\n";
+	return -1;
+    }
+    return 0;
+}
+
+int
+SupernodalSymLinSOE::recvSelf(int cTag, Channel &theChannel,
+			      FEM_ObjectBroker &theBroker)
+{
+    if (dynamic_cast<DomainSolver *>(this->getSolver()) == 0) {
+	opserr << "SupernodalSymLinSOE::recvSelf() - not implemented";
+	opserr << " without a SupernodalSymLinSubstrSolver\n";
+	return -1;
+    }
+    return 0;
+}
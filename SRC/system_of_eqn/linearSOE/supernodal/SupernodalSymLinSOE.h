@@ -0,0 +1,81 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for
+// SupernodalSymLinSOE. SupernodalSymLinSOE is a subclass of LinearSOE.
+// It stores the symmetric matrix equation Ax=b, keeping only the lower
+// triangle of A (diagonal included) in a column compressed scheme, for
+// the SupernodalSymLinSolver.
+//
+#ifndef SupernodalSymLinSOE_h
+#define SupernodalSymLinSOE_h
+
+#include <LinearSOE.h>
+#include <Vector.h>
+#include <ScatterMap.h>
+#include <vector>
+
+class SupernodalSymLinSolver;
+
+class SupernodalSymLinSOE : public LinearSOE
+{
+  public:
+    SupernodalSymLinSOE(SupernodalSymLinSolver &theSolver);
+    SupernodalSymLinSOE();
+
+    ~SupernodalSymLinSOE();
+
+    int getNumEqn(void) const;
+    int setSize(Graph &theGraph);
+    int addA(const Matrix &, const ID &, double fact = 1.0);
+    int addA(const Matrix &, const FE_Element &, double fact = 1.0);
+    int addB(const Vector &, const ID &, double fact = 1.0);
+    bool canAddConcurrently(void) const;
+    int setB(const Vector &, double fact = 1.0);
+
+    void zeroA(void);
+    void zeroB(void);
+
+    const Vector &getX(void);
+    const Vector &getB(void);
+    double normRHS(void);
+
+    void setX(int loc, double value);
+    void setX(const Vector &x);
+    int setSupernodalSymLinSolver(SupernodalSymLinSolver &newSolver);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+    friend class SupernodalSymLinSolver;
+    friend class SupernodalSymLinSubstrSolver;
+
+  protected:
+
+  private:
+    Vector X, B;
+    std::vector<int> colStartA;    // start of each column in rowA and A
+    std::vector<int> rowA;         // row of each entry, rows >= column only
+    std::vector<double> A;
+    ScatterMap theScatterMap;      // location in A of the FE_Element tangents
+};
+
+#endif
@@ -0,0 +1,1020 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of
+// SupernodalSymLinSolver.
+//
+#include <SupernodalSymLinSolver.h>
+#include <SupernodalSymLinSOE.h>
+#include <ThreadPool.h>
+#include <ScratchArena.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <elementAPI.h>
+#include <classTags.h>
+#include <algorithm>
+#include <string>
+#include <math.h>
+#include <string.h>
+
+#include <amd.h>
+#ifdef _USE_METIS_5p1
+#include <metis.h>
+#endif
+
+#ifdef _WIN32
+extern "C" int DGEMM(char *transA, char *transB, int *m, int *n, int *k,
+		     double *alpha, double *A, int *ldA, double *B, int *ldB,
+		     double *beta, double *C, int *ldC);
+
+extern "C" int DTRSM(char *side, char *uplo, char *transA, char *diag,
+		     int *m, int *n, double *alpha, double *A, int *ldA,
+		     double *B, int *ldB);
+
+extern "C" int DPOTRF(char *uplo, int *n, double *A, int *ldA, int *info);
+
+extern "C" int DTRSV(char *uplo, char *trans, char *diag, int *n,
+		     double *A, int *ldA, double *x, int *incx);
+
+extern "C" int SGEMM(char *transA, char *transB, int *m, int *n, int *k,
+		     float *alpha, float *A, int *ldA, float *B, int *ldB,
+		     float *beta, float *C, int *ldC);
+
+extern "C" int STRSM(char *side, char *uplo, char *transA, char *diag,
+		     int *m, int *n, float *alpha, float *A, int *ldA,
+		     float *B, int *ldB);
+
+extern "C" int SPOTRF(char *uplo, int *n, float *A, int *ldA, int *info);
+
+extern "C" int STRSV(char *uplo, char *trans, char *diag, int *n,
+		     float *A, int *ldA, float *x, int *incx);
+
+#define dgemm_  DGEMM
+#define dtrsm_  DTRSM
+#define dpotrf_ DPOTRF
+#define dtrsv_  DTRSV
+#define sgemm_  SGEMM
+#define strsm_  STRSM
+#define spotrf_ SPOTRF
+#define strsv_  STRSV
+#else
+extern "C" int dgemm_(char *transA, char *transB, int *m, int *n, int *k,
+		      double *alpha, double *A, int *ldA, double *B, int *ldB,
+		      double *beta, double *C, int *ldC);
+
+extern "C" int dtrsm_(char *side, char *uplo, char *transA, char *diag,
+		      int *m, int *n, double *alpha, double *A, int *ldA,
+		      double *B, int *ldB);
+
+extern "C" int dpotrf_(char *uplo, int *n, double *A, int *ldA, int *info);
+
+extern "C" int dtrsv_(char *uplo, char *trans, char *diag, int *n,
+		      double *A, int *ldA, double *x, int *incx);
+
+extern "C" int sgemm_(char *transA, char *transB, int *m, int *n, int *k,
+		      float *alpha, float *A, int *ldA, float *B, int *ldB,
+		      float *beta, float *C, int *ldC);
+
+extern "C" int strsm_(char *side, char *uplo, char *transA, char *diag,
+		      int *m, int *n, float *alpha, float *A, int *ldA,
+		      float *B, int *ldB);
+
+extern "C" int spotrf_(char *uplo, int *n, float *A, int *ldA, int *info);
+
+extern "C" int strsv_(char *uplo, char *trans, char *diag, int *n,
+		      float *A, int *ldA, float *x, int *incx);
+#endif
+
+// the dense kernels by precision
+static inline void
+gemm(char *transA, char *transB, int *m, int *n, int *k, double *alpha,
+     double *A, int *ldA, double *B, int *ldB, double *beta, double *C, int *ldC)
+{
+    dgemm_(transA, transB, m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC);
+}
+
+static inline void
+gemm(char *transA, char *transB, int *m, int *n, int *k, float *alpha,
+     float *A, int *ldA, float *B, int *ldB, float *beta, float *C, int *ldC)
+{
+    sgemm_(transA, transB, m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC);
+}
+
+static inline void
+trsm(char *side, char *uplo, char *transA, char *diag, int *m, int *n,
+     double *alpha, double *A, int *ldA, double *B, int *ldB)
+{
+    dtrsm_(side, uplo, transA, diag, m, n, alpha, A, ldA, B, ldB);
+}
+
+static inline void
+trsm(char *side, char *uplo, char *transA, char *diag, int *m, int *n,
+     float *alpha, float *A, int *ldA, float *B, int *ldB)
+{
+    strsm_(side, uplo, transA, diag, m, n, alpha, A, ldA, B, ldB);
+}
+
+static inline void
+potrf(char *uplo, int *n, double *A, int *ldA, int *info)
+{
+    dpotrf_(uplo, n, A, ldA, info);
+}
+
+static inline void
+potrf(char *uplo, int *n, float *A, int *ldA, int *info)
+{
+    spotrf_(uplo, n, A, ldA, info);
+}
+
+static inline void
+trsv(char *uplo, char *trans, char *diag, int *n, double *A, int *ldA,
+     double *x, int *incx)
+{
+    dtrsv_(uplo, trans, diag, n, A, ldA, x, incx);
+}
+
+static inline void
+trsv(char *uplo, char *trans, char *diag, int *n, float *A, int *ldA,
+     float *x, int *incx)
+{
+    strsv_(uplo, trans, diag, n, A, ldA, x, incx);
+}
+
+// per thread work storage of the numeric factorization: the map from
+// equation to row of the supernode, the update block and the L*D block
+template <class T>
+struct SupernodalWork {
+    std::vector<int> relRow;
+    std::vector<T> C;
+    std::vector<T> W;
+};
+
+static const int doubleWorkSlot = ScratchArena::newSlot();
+static const int floatWorkSlot = ScratchArena::newSlot();
+
+static inline SupernodalWork<double> &
+getWork(double *)
+{
+    return ScratchArena::local().get< SupernodalWork<double> >(doubleWorkSlot);
+}
+
+static inline SupernodalWork<float> &
+getWork(float *)
+{
+    return ScratchArena::local().get< SupernodalWork<float> >(floatWorkSlot);
+}
+
+void* OPS_SupernodalSymLinSolver()
+{
+    int ordering = SupernodalSymLinSolver::ORDER_AMD;
+    bool ldlt = false;
+    bool mixed = false;
+    int numThreads = 1;
+
+    int numData = 1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	std::string type = OPS_GetString();
+	if (type == "-LDL" || type == "-ldl") {
+	    ldlt = true;
+	} else if (type == "-mixed") {
+	    mixed = true;
+	} else if (type == "-ordering" && OPS_GetNumRemainingInputArgs() > 0) {
+	    std::string order = OPS_GetString();
+	    if (order == "METIS" || order == "Metis")
+		ordering = SupernodalSymLinSolver::ORDER_METIS;
+	    else if (order == "AMD")
+		ordering = SupernodalSymLinSolver::ORDER_AMD;
+	    else {
+		opserr << "WARNING system Supernodal - unknown ordering " << order.c_str()
+		       << ", AMD or METIS\n";
+		return 0;
+	    }
+	} else if (type == "-threads" && OPS_GetNumRemainingInputArgs() > 0) {
+	    if (OPS_GetIntInput(&numData, &numThreads) < 0) {
+		opserr << "WARNING system Supernodal - invalid -threads\n";
+		return 0;
+	    }
+	}
+    }
+
+    SupernodalSymLinSolver *theSolver =
+	new SupernodalSymLinSolver(ordering, ldlt, numThreads, mixed);
+    return new SupernodalSymLinSOE(*theSolver);
+}
+
+SupernodalSymLinSolver::SupernodalSymLinSolver(int order, bool ldl, int numThreads,
+					       bool mix)
+    :LinearSOESolver(SOLVER_TAGS_SupernodalSymLinSolver),
+     ordering(order), ldlt(ldl), mixed(mix), theThreads(0), size(0), numSuper(0),
+     maxUpdate(0), maxWork(0), singleFactored(false), normA(0.0),
+     symbolicStamp(-1), numericStamp(-1), theSOE(0)
+{
+    if (numThreads < 1)
+	numThreads = ThreadPool::getNumHardwareThreads();
+    if (numThreads > 1)
+	theThreads = new ThreadPool(numThreads);
+
+#ifndef _USE_METIS_5p1
+    if (ordering == ORDER_METIS) {
+	opserr << "WARNING SupernodalSymLinSolver - METIS not available, using AMD\n";
+	ordering = ORDER_AMD;
+    }
+#endif
+}
+
+
+SupernodalSymLinSolver::~SupernodalSymLinSolver()
+{
+    if (theThreads != 0)
+	delete theThreads;
+}
+
+int
+SupernodalSymLinSolver::setLinearSOE(SupernodalSymLinSOE &theLinearSOE)
+{
+    theSOE = &theLinearSOE;
+    return 0;
+}
+
+int
+SupernodalSymLinSolver::setSize(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SupernodalSymLinSolver::setSize() - no SOE\n";
+	return -1;
+    }
+
+    // keep the analysis while the structure of A is unchanged
+    if (symbolicStamp == theSOE->getPatternStamp() && size == theSOE->X.Size())
+	return 0;
+
+    return this->symbolic();
+}
+
+int
+SupernodalSymLinSolver::solve(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SupernodalSymLinSolver::solve() - no SOE\n";
+	return -1;
+    }
+
+    int n = theSOE->X.Size();
+    if (n == 0)
+	return 0;
+
+    if (this->factorize() < 0)
+	return -1;
+
+    if (singleFactored == true) {
+	if (this->solveSingle() == 0) {
+	    numSolve++;
+	    return 0;
+	}
+
+	// the refinement stalled, factor A in double precision instead
+	singleFactored = false;
+	if (this->factorDouble() < 0) {
+	    numericStamp = -1;
+	    return -1;
+	}
+    }
+
+    // forward and backward substitution in the new ordering
+    double *y = &Y[0];
+    const double *B = &(theSOE->B(0));
+    for (int i=0; i<n; i++)
+	y[i] = B[perm[i]];
+
+    this->substitute(L, D, y);
+
+    double *X = &(theSOE->X(0));
+    for (int i=0; i<n; i++)
+	X[perm[i]] = y[i];
+
+    numSolve++;
+
+    return 0;
+}
+
+int
+SupernodalSymLinSolver::factorize(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SupernodalSymLinSolver::factorize() - no SOE\n";
+	return -1;
+    }
+
+    int n = theSOE->X.Size();
+    if (n == 0)
+	return 0;
+
+    if (symbolicStamp != theSOE->getPatternStamp() || size != n) {
+	if (this->symbolic() < 0)
+	    return -1;
+    }
+
+    // refactor only if A has been changed since the last factorization,
+    // in single precision first in mixed precision mode
+    if (numericStamp != theSOE->getValuesStamp()) {
+	numericStamp = -1;
+	singleFactored = false;
+	if (mixed == true) {
+	    this->computeNorm();
+	    if (this->factor(Lf, Df) == 0)
+		singleFactored = true;
+	}
+	if (singleFactored == false && this->factorDouble() < 0)
+	    return -1;
+	numericStamp = theSOE->getValuesStamp();
+    }
+
+    return 0;
+}
+
+int
+SupernodalSymLinSolver::solveFactored(int numRHS, double *x)
+{
+    if (size == 0 || numRHS < 1)
+	return 0;
+
+    if (numericStamp == -1) {
+	opserr << "WARNING SupernodalSymLinSolver::solveFactored() - A has not been factored\n";
+	return -1;
+    }
+
+    // without refinement single precision factors are not accurate enough
+    if (singleFactored == true && this->factorDouble() < 0)
+	return -1;
+    singleFactored = false;
+
+    int n = size;
+    int numThreads = (theThreads != 0) ? theThreads->getNumThreads() : 1;
+    std::vector<double> work(numThreads*n);
+
+    if (theThreads == 0 || numRHS == 1) {
+	for (int k=0; k<numRHS; k++) {
+	    double *xk = x + k*n;
+	    for (int i=0; i<n; i++)
+		work[i] = xk[perm[i]];
+	    this->substitute(L, D, &work[0]);
+	    for (int i=0; i<n; i++)
+		xk[perm[i]] = work[i];
+	}
+    } else {
+	theThreads->run(numRHS, [&](int k, int threadID) {
+	    double *xk = x + k*n;
+	    double *y = &work[threadID*n];
+	    for (int i=0; i<n; i++)
+		y[i] = xk[perm[i]];
+	    this->substitute(L, D, y);
+	    for (int i=0; i<n; i++)
+		xk[perm[i]] = y[i];
+	});
+    }
+
+    numSolve += numRHS;
+
+    return 0;
+}
+
+int
+SupernodalSymLinSolver::factorDouble(void)
+{
+    int result = this->factor(L, D);
+    if (result == 0)
+	return 0;
+
+    int eqn = perm[result-1];
+    if (ldlt)
+	opserr << "WARNING SupernodalSymLinSolver::solve() - zero pivot at equation "
+	       << eqn << endln;
+    else
+	opserr << "WARNING SupernodalSymLinSolver::solve() - matrix not positive definite at equation "
+	       << eqn << ", use -LDL for an indefinite matrix\n";
+
+    return -1;
+}
+
+// the infinity norm of A, stored by its lower triangle, for the
+// convergence test of the refinement
+void
+SupernodalSymLinSolver::computeNorm(void)
+{
+    const std::vector<int> &colStartA = theSOE->colStartA;
+    const std::vector<int> &rowA = theSOE->rowA;
+    const double *A = &(theSOE->A[0]);
+
+    double *rowSum = &Y[0];
+    for (int i=0; i<size; i++)
+	rowSum[i] = 0.0;
+    for (int c=0; c<size; c++)
+	for (int k=colStartA[c]; k<colStartA[c+1]; k++) {
+	    int row = rowA[k];
+	    rowSum[row] += fabs(A[k]);
+	    if (row != c)
+		rowSum[c] += fabs(A[k]);
+	}
+
+    normA = 0.0;
+    for (int i=0; i<size; i++)
+	if (rowSum[i] > normA)
+	    normA = rowSum[i];
+}
+
+int
+SupernodalSymLinSolver::solveSingle(void)
+{
+    int n = size;
+    const std::vector<int> &colStartA = theSOE->colStartA;
+    const std::vector<int> &rowA = theSOE->rowA;
+    const double *A = &(theSOE->A[0]);
+    const double *B = &(theSOE->B(0));
+    double *X = &(theSOE->X(0));
+    Yf.resize(n);
+    float *yf = &Yf[0];
+
+    // r = b - Ax, with the symmetric A stored by its lower triangle
+    IterativeRefinement::Residual residual =
+	[&](const double *x, double *r) {
+	for (int i=0; i<n; i++)
+	    r[i] = B[i];
+	for (int c=0; c<n; c++) {
+	    double sum = 0.0;
+	    for (int k=colStartA[c]; k<colStartA[c+1]; k++) {
+		int row = rowA[k];
+		sum += A[k]*x[row];
+		if (row != c)
+		    r[row] -= A[k]*x[c];
+	    }
+	    r[c] -= sum;
+	}
+    };
+
+    IterativeRefinement::Correction correction = [&](double *r) {
+	for (int i=0; i<n; i++)
+	    yf[i] = (float)r[perm[i]];
+	this->substitute(Lf, Df, yf);
+	for (int i=0; i<n; i++)
+	    r[perm[i]] = yf[i];
+	return 0;
+    };
+
+    // the first solution is the correction to x = 0
+    for (int i=0; i<n; i++)
+	X[i] = B[i];
+    correction(X);
+
+    return (theRefinement.refine(n, X, normA, residual, correction) < 0) ? -1 : 0;
+}
+
+// forward and backward substitution with L, and D for LDL^T, in place
+template <class T> void
+SupernodalSymLinSolver::substitute(const std::vector<T> &Lv,
+				   const std::vector<T> &Dv, T *y)
+{
+    char uplo = 'L';
+    char transN = 'N';
+    char transT = 'T';
+    char diag = ldlt ? 'U' : 'N';
+    int incx = 1;
+
+    for (int s=0; s<numSuper; s++) {
+	int first = superStart[s];
+	int ncols = superStart[s+1] - first;
+	int nrows = rowStart[s+1] - rowStart[s];
+	const int *rows = &superRows[rowStart[s]];
+	T *Ls = const_cast<T *>(&Lv[valueStart[s]]);
+
+	trsv(&uplo, &transN, &diag, &ncols, Ls, &nrows, y+first, &incx);
+
+	for (int c=0; c<ncols; c++) {
+	    T yc = y[first+c];
+	    const T *Lc = Ls + c*nrows;
+	    for (int r=ncols; r<nrows; r++)
+		y[rows[r]] -= Lc[r]*yc;
+	}
+    }
+
+    if (ldlt) {
+	for (int i=0; i<size; i++)
+	    y[i] /= Dv[i];
+    }
+
+    for (int s=numSuper-1; s>=0; s--) {
+	int first = superStart[s];
+	int ncols = superStart[s+1] - first;
+	int nrows = rowStart[s+1] - rowStart[s];
+	const int *rows = &superRows[rowStart[s]];
+	T *Ls = const_cast<T *>(&Lv[valueStart[s]]);
+
+	for (int c=0; c<ncols; c++) {
+	    T sum = 0.0;
+	    const T *Lc = Ls + c*nrows;
+	    for (int r=ncols; r<nrows; r++)
+		sum += Lc[r]*y[rows[r]];
+	    y[first+c] -= sum;
+	}
+
+	trsv(&uplo, &transT, &diag, &ncols, Ls, &nrows, y+first, &incx);
+    }
+}
+
+int
+SupernodalSymLinSolver::order(const std::vector<int> &xadj,
+			      const std::vector<int> &adjncy)
+{
+    int n = size;
+    perm.resize(n);
+
+#ifdef _USE_METIS_5p1
+    if (ordering == ORDER_METIS && n > 1) {
+	std::vector<idx_t> mXadj(xadj.begin(), xadj.end());
+	std::vector<idx_t> mAdjncy(adjncy.begin(), adjncy.end());
+	std::vector<idx_t> mPerm(n), mIperm(n);
+	idx_t nvtxs = n;
+	if (mAdjncy.empty())
+	    mAdjncy.push_back(0);
+	int ok = METIS_NodeND(&nvtxs, &mXadj[0], &mAdjncy[0], NULL, NULL,
+			      &mPerm[0], &mIperm[0]);
+	if (ok == METIS_OK) {
+	    for (int i=0; i<n; i++)
+		perm[i] = mPerm[i];
+	    return 0;
+	}
+	opserr << "WARNING SupernodalSymLinSolver::setSize() - METIS_NodeND failed, using AMD\n";
+    }
+#endif
+
+    std::vector<int> Ap(xadj), Ai(adjncy);
+    if (Ai.empty())
+	Ai.push_back(0);
+    int ok = amd_order(n, &Ap[0], &Ai[0], &perm[0], (double *)NULL, (double *)NULL);
+    if (ok < AMD_OK) {
+	opserr << "WARNING SupernodalSymLinSolver::setSize() - amd_order failed\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+int
+SupernodalSymLinSolver::symbolic(void)
+{
+    int n = theSOE->X.Size();
+    const std::vector<int> &colStartA = theSOE->colStartA;
+    const std::vector<int> &rowA = theSOE->rowA;
+
+    size = n;
+    numSuper = 0;
+    symbolicStamp = -1;
+    numericStamp = -1;
+    if (n == 0)
+	return 0;
+
+    // full adjacency of A, without the diagonal
+    std::vector<int> xadj(n+1, 0);
+    for (int c=0; c<n; c++)
+	for (int k=colStartA[c]; k<colStartA[c+1]; k++)
+	    if (rowA[k] != c) {
+		xadj[c+1]++;
+		xadj[rowA[k]+1]++;
+	    }
+    for (int i=0; i<n; i++)
+	xadj[i+1] += xadj[i];
+
+    std::vector<int> adjncy(xadj[n]);
+    std::vector<int> next(xadj.begin(), xadj.end()-1);
+    for (int c=0; c<n; c++)
+	for (int k=colStartA[c]; k<colStartA[c+1]; k++) {
+	    int r = rowA[k];
+	    if (r != c) {
+		adjncy[next[c]++] = r;
+		adjncy[next[r]++] = c;
+	    }
+	}
+
+    if (this->order(xadj, adjncy) < 0)
+	return -1;
+
+    iperm.resize(n);
+    for (int i=0; i<n; i++)
+	iperm[perm[i]] = i;
+
+    // elimination tree of the permuted matrix
+    std::vector<int> parent(n, -1);
+    std::vector<int> ancestor(n, -1);
+    for (int j=0; j<n; j++) {
+	int oldj = perm[j];
+	for (int k=xadj[oldj]; k<xadj[oldj+1]; k++) {
+	    int i = iperm[adjncy[k]];
+	    while (i != -1 && i < j) {
+		int nexti = ancestor[i];
+		ancestor[i] = j;
+		if (nexti == -1)
+		    parent[i] = j;
+		i = nexti;
+	    }
+	}
+    }
+
+    // postorder the tree, so that the columns of a supernode and the
+    // subtree of every column are numbered consecutively
+    std::vector<int> head(n, -1), sibling(n, -1), post, stack;
+    post.reserve(n);
+    for (int j=n-1; j>=0; j--)
+	if (parent[j] != -1) {
+	    sibling[j] = head[parent[j]];
+	    head[parent[j]] = j;
+	}
+    for (int root=0; root<n; root++) {
+	if (parent[root] != -1)
+	    continue;
+	stack.push_back(root);
+	while (!stack.empty()) {
+	    int j = stack.back();
+	    int child = head[j];
+	    if (child == -1) {
+		post.push_back(j);
+		stack.pop_back();
+	    } else {
+		head[j] = sibling[child];
+		stack.push_back(child);
+	    }
+	}
+    }
+
+    std::vector<int> ipost(n);
+    for (int k=0; k<n; k++)
+	ipost[post[k]] = k;
+
+    std::vector<int> newPerm(n), newParent(n);
+    for (int k=0; k<n; k++) {
+	newPerm[k] = perm[post[k]];
+	newParent[k] = (parent[post[k]] == -1) ? -1 : ipost[parent[post[k]]];
+    }
+    perm.swap(newPerm);
+    parent.swap(newParent);
+    for (int i=0; i<n; i++)
+	iperm[perm[i]] = i;
+
+    // column counts of L from the row subtrees: row i of L has an entry in
+    // every column on the path up the tree from k to i, for A(i,k) != 0
+    std::vector<int> colCount(n, 1), mark(n, -1), numChild(n, 0);
+    for (int i=0; i<n; i++) {
+	mark[i] = i;
+	int oldi = perm[i];
+	for (int k=xadj[oldi]; k<xadj[oldi+1]; k++) {
+	    int j = iperm[adjncy[k]];
+	    while (j < i && mark[j] != i) {
+		colCount[j]++;
+		mark[j] = i;
+		j = parent[j];
+	    }
+	}
+	if (parent[i] != -1)
+	    numChild[parent[i]]++;
+    }
+
+    // fundamental supernodes: chains of columns with nested structure
+    colToSuper.resize(n);
+    superStart.clear();
+    superStart.push_back(0);
+    for (int j=0; j<n; j++) {
+	colToSuper[j] = (int)superStart.size() - 1;
+	if (j+1 < n && parent[j] == j+1 && colCount[j] == colCount[j+1]+1 &&
+	    numChild[j+1] == 1)
+	    continue;
+	superStart.push_back(j+1);
+    }
+    numSuper = (int)superStart.size() - 1;
+
+    // rows of the supernodes; a row appears in the supernode of every
+    // column of its row subtree, rows are found in increasing order
+    rowStart.resize(numSuper+1);
+    valueStart.resize(numSuper+1);
+    rowStart[0] = 0;
+    valueStart[0] = 0;
+    for (int s=0; s<numSuper; s++) {
+	int nrows = colCount[superStart[s]];
+	int ncols = superStart[s+1] - superStart[s];
+	rowStart[s+1] = rowStart[s] + nrows;
+	valueStart[s+1] = valueStart[s] + nrows*ncols;
+    }
+
+    superRows.resize(rowStart[numSuper]);
+    std::vector<int> rowNext(rowStart.begin(), rowStart.end()-1);
+    std::vector<int> superMark(numSuper, -1);
+    mark.assign(n, -1);
+    for (int i=0; i<n; i++) {
+	mark[i] = i;
+	superMark[colToSuper[i]] = i;
+	superRows[rowNext[colToSuper[i]]++] = i;
+	int oldi = perm[i];
+	for (int k=xadj[oldi]; k<xadj[oldi+1]; k++) {
+	    int j = iperm[adjncy[k]];
+	    while (j < i && mark[j] != i) {
+		mark[j] = i;
+		int s = colToSuper[j];
+		if (superMark[s] != i) {
+		    superMark[s] = i;
+		    superRows[rowNext[s]++] = i;
+		}
+		j = parent[j];
+	    }
+	}
+    }
+
+    // descendants updating each supernode; the rows of descendant K below
+    // its own columns fall, in order, into the supernodes they update
+    std::vector<int> numUpdate(numSuper+1, 0);
+    for (int K=0; K<numSuper; K++) {
+	int ncols = superStart[K+1] - superStart[K];
+	int last = -1;
+	for (int p=rowStart[K]+ncols; p<rowStart[K+1]; p++) {
+	    int J = colToSuper[superRows[p]];
+	    if (J != last) {
+		numUpdate[J+1]++;
+		last = J;
+	    }
+	}
+    }
+    updateStart.resize(numSuper+1);
+    updateStart[0] = 0;
+    for (int J=0; J<numSuper; J++)
+	updateStart[J+1] = updateStart[J] + numUpdate[J+1];
+    updateSuper.resize(updateStart[numSuper]);
+    updateRow.resize(updateStart[numSuper]);
+
+    std::vector<int> updateNext(updateStart.begin(), updateStart.end()-1);
+    maxUpdate = 0;
+    maxWork = 0;
+    for (int K=0; K<numSuper; K++) {
+	int ncols = superStart[K+1] - superStart[K];
+	int nrows = rowStart[K+1] - rowStart[K];
+	int last = -1;
+	for (int p=ncols; p<nrows; p++) {
+	    int J = colToSuper[superRows[rowStart[K]+p]];
+	    if (J == last)
+		continue;
+	    last = J;
+	    updateSuper[updateNext[J]] = K;
+	    updateRow[updateNext[J]] = p;
+	    updateNext[J]++;
+
+	    int p2 = p;
+	    while (p2 < nrows && superRows[rowStart[K]+p2] < superStart[J+1])
+		p2++;
+	    int m = nrows - p;
+	    int m1 = p2 - p;
+	    maxUpdate = std::max(maxUpdate, m*m1);
+	    maxWork = std::max(maxWork, m1*ncols);
+	}
+    }
+
+    // levels of the supernodal tree; the supernodes of a level depend only
+    // on those of lower levels
+    std::vector<int> level(numSuper, 0);
+    int numLevel = 1;
+    for (int s=0; s<numSuper; s++) {
+	int j = parent[superStart[s+1]-1];
+	if (j != -1) {
+	    int p = colToSuper[j];
+	    level[p] = std::max(level[p], level[s]+1);
+	}
+	numLevel = std::max(numLevel, level[s]+1);
+    }
+    levelStart.assign(numLevel+1, 0);
+    for (int s=0; s<numSuper; s++)
+	levelStart[level[s]+1]++;
+    for (int l=0; l<numLevel; l++)
+	levelStart[l+1] += levelStart[l];
+    levelSuper.resize(numSuper);
+    std::vector<int> levelNext(levelStart.begin(), levelStart.end()-1);
+    for (int s=0; s<numSuper; s++)
+	levelSuper[levelNext[level[s]]++] = s;
+
+    // location in L of every entry of A, grouped by supernode
+    int nnzA = colStartA[n];
+    std::vector<int> entrySuper(nnzA);
+    assembleStart.assign(numSuper+1, 0);
+    for (int c=0; c<n; c++)
+	for (int k=colStartA[c]; k<colStartA[c+1]; k++) {
+	    int j = std::min(iperm[c], iperm[rowA[k]]);
+	    entrySuper[k] = colToSuper[j];
+	    assembleStart[entrySuper[k]+1]++;
+	}
+    for (int s=0; s<numSuper; s++)
+	assembleStart[s+1] += assembleStart[s];
+    assembleFrom.resize(nnzA);
+    assembleTo.resize(nnzA);
+
+    std::vector<int> assembleNext(assembleStart.begin(), assembleStart.end()-1);
+    for (int c=0; c<n; c++)
+	for (int k=colStartA[c]; k<colStartA[c+1]; k++) {
+	    int i = std::max(iperm[c], iperm[rowA[k]]);
+	    int j = std::min(iperm[c], iperm[rowA[k]]);
+	    int s = entrySuper[k];
+	    const int *rows = &superRows[rowStart[s]];
+	    int nrows = rowStart[s+1] - rowStart[s];
+	    int pos = std::lower_bound(rows, rows+nrows, i) - rows;
+	    int q = assembleNext[s]++;
+	    assembleFrom[q] = k;
+	    assembleTo[q] = valueStart[s] + (j-superStart[s])*nrows + pos;
+	}
+
+    // the factors are sized by factor() in the precision used
+    Y.resize(n);
+
+    symbolicStamp = theSOE->getPatternStamp();
+    numSymbolic++;
+
+    return 0;
+}
+
+// numeric factorization into Lv and, for LDL^T, Dv in the precision of T;
+// returns 0 if successful, else one plus the column of the failed pivot
+template <class T> int
+SupernodalSymLinSolver::factor(std::vector<T> &Lv, std::vector<T> &Dv)
+{
+    Lv.resize(valueStart[numSuper]);
+    if (ldlt)
+	Dv.resize(size);
+
+    int result = 0;
+
+    if (theThreads == 0) {
+	for (int s=0; s<numSuper && result == 0; s++)
+	    result = this->factorSupernode(s, Lv, Dv);
+    } else {
+	int numLevel = (int)levelStart.size() - 1;
+	std::vector<int> info(numSuper, 0);
+	for (int l=0; l<numLevel; l++) {
+	    int first = levelStart[l];
+	    int num = levelStart[l+1] - first;
+	    theThreads->run(num, [&](int i, int threadID) {
+		info[first+i] = this->factorSupernode(levelSuper[first+i], Lv, Dv);
+	    });
+	    for (int i=first; i<first+num; i++)
+		if (info[i] != 0 && result == 0)
+		    result = info[i];
+	    if (result != 0)
+		break;
+	}
+    }
+
+    if (result != 0)
+	return result;
+
+    numNumeric++;
+
+    return 0;
+}
+
+// left looking factorization of supernode J; returns 0 if successful,
+// else one plus the column of the failed pivot
+template <class T> int
+SupernodalSymLinSolver::factorSupernode(int J, std::vector<T> &Lv,
+					std::vector<T> &Dv)
+{
+    int first = superStart[J];
+    int ncols = superStart[J+1] - first;
+    int nrows = rowStart[J+1] - rowStart[J];
+    const int *rows = &superRows[rowStart[J]];
+    T *LJ = &Lv[valueStart[J]];
+
+    SupernodalWork<T> &theWork = getWork((T *)0);
+    theWork.relRow.resize(size);
+    theWork.C.resize(maxUpdate);
+    if (ldlt)
+	theWork.W.resize(maxWork);
+    int *relRow = &theWork.relRow[0];
+    T *C = theWork.C.empty() ? 0 : &theWork.C[0];
+    T *W = theWork.W.empty() ? 0 : &theWork.W[0];
+
+    // assemble A
+    for (int k=0; k<nrows*ncols; k++)
+	LJ[k] = 0.0;
+    const double *A = &(theSOE->A[0]);
+    int offset = valueStart[J];
+    for (int q=assembleStart[J]; q<assembleStart[J+1]; q++)
+	LJ[assembleTo[q]-offset] += (T)A[assembleFrom[q]];
+
+    for (int r=0; r<nrows; r++)
+	relRow[rows[r]] = r;
+
+    // updates from the descendants: LJ -= LK(p1:,:) * D * LK(p1:p2,:)^T
+    char transN = 'N';
+    char transT = 'T';
+    T one = 1.0;
+    T zero = 0.0;
+    for (int u=updateStart[J]; u<updateStart[J+1]; u++) {
+	int K = updateSuper[u];
+	int p1 = updateRow[u];
+	int ncolsK = superStart[K+1] - superStart[K];
+	int nrowsK = rowStart[K+1] - rowStart[K];
+	const int *rowsK = &superRows[rowStart[K]];
+	T *LK = &Lv[valueStart[K]];
+
+	int p2 = p1;
+	while (p2 < nrowsK && rowsK[p2] < superStart[J+1])
+	    p2++;
+	int m = nrowsK - p1;
+	int m1 = p2 - p1;
+
+	T *right = LK + p1;
+	int ldRight = nrowsK;
+	if (ldlt) {
+	    const T *DK = &Dv[superStart[K]];
+	    for (int c=0; c<ncolsK; c++)
+		for (int r=0; r<m1; r++)
+		    W[c*m1+r] = LK[c*nrowsK+p1+r]*DK[c];
+	    right = W;
+	    ldRight = m1;
+	}
+
+	gemm(&transN, &transT, &m, &m1, &ncolsK, &one, LK+p1, &nrowsK,
+	     right, &ldRight, &zero, C, &m);
+
+	for (int c=0; c<m1; c++) {
+	    T *LJc = LJ + (rowsK[p1+c]-first)*nrows;
+	    const T *Cc = C + c*m;
+	    for (int r=c; r<m; r++)
+		LJc[relRow[rowsK[p1+r]]] -= Cc[r];
+	}
+    }
+
+    // factor the diagonal block
+    char uplo = 'L';
+    if (ldlt) {
+	for (int k=0; k<ncols; k++) {
+	    T dk = LJ[k*nrows+k];
+	    if (dk == 0.0)
+		return first+k+1;
+	    for (int c=k+1; c<ncols; c++) {
+		T f = LJ[k*nrows+c]/dk;
+		for (int r=c; r<ncols; r++)
+		    LJ[c*nrows+r] -= LJ[k*nrows+r]*f;
+	    }
+	    for (int r=k+1; r<ncols; r++)
+		LJ[k*nrows+r] /= dk;
+	    Dv[first+k] = dk;
+	}
+    } else {
+	int info = 0;
+	potrf(&uplo, &ncols, LJ, &nrows, &info);
+	if (info != 0)
+	    return first + (info > 0 ? info : 1);
+    }
+
+    // and the rows below it
+    int nbelow = nrows - ncols;
+    if (nbelow > 0) {
+	char side = 'R';
+	char diag = ldlt ? 'U' : 'N';
+	trsm(&side, &uplo, &transT, &diag, &nbelow, &ncols, &one, LJ, &nrows,
+	     LJ+ncols, &nrows);
+	if (ldlt) {
+	    for (int c=0; c<ncols; c++) {
+		T *Lc = LJ + c*nrows;
+		T dInv = 1.0/Dv[first+c];
+		for (int r=ncols; r<nrows; r++)
+		    Lc[r] *= dInv;
+	    }
+	}
+    }
+
+    return 0;
+}
+
+int
+SupernodalSymLinSolver::sendSelf(int cTag, Channel &theChannel)
+{
+    opserr << "SupernodalSymLinSolver::sendSelf() - not implemented\n";
+    return -1;
+}
+
+int
+SupernodalSymLinSolver::recvSelf(int ctag, Channel &theChannel,
+				 FEM_ObjectBroker &theBroker)
+{
+    opserr << "SupernodalSymLinSolver::recvSelf() - not implemented\n";
+    return -1;
+}
@@ -0,0 +1,148 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for
+// SupernodalSymLinSolver. It solves the SupernodalSymLinSOE object by a
+// sparse Cholesky (LL^T) or, for indefinite matrices, LDL^T factorization.
+//
+// setSize() performs the symbolic analysis: a fill reducing ordering
+// (AMD, or METIS if available), the elimination tree, and the grouping of
+// columns with identical structure into supernodes, which are stored as
+// dense blocks so that the numeric factorization is done with BLAS-3
+// kernels. The symbolic analysis is kept for as long as the pattern stamp
+// of the SOE is unchanged, and the numeric factorization for as long as
+// its values stamp is. With more than one thread, the supernodes of each
+// level of the supernodal elimination tree are factored concurrently.
+//
+// In mixed precision mode L is computed in single precision and the
+// solution refined to double precision accuracy (see IterativeRefinement);
+// if the refinement stalls A is factored in double precision instead.
+//
+#ifndef SupernodalSymLinSolver_h
+#define SupernodalSymLinSolver_h
+
+#include <LinearSOESolver.h>
+#include <IterativeRefinement.h>
+#include <vector>
+
+class SupernodalSymLinSOE;
+class ThreadPool;
+
+class SupernodalSymLinSolver : public LinearSOESolver
+{
+  public:
+    enum Ordering {
+      ORDER_AMD   = 0,
+      ORDER_METIS = 1
+    };
+
+    SupernodalSymLinSolver(int ordering = ORDER_AMD, bool ldlt = false,
+			   int numThreads = 1, bool mixed = false);
+    ~SupernodalSymLinSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    // factors A if it has changed since the last factorization, without
+    // solving for the B of the SOE
+    int factorize(void);
+
+    // solves A x = b, with the factors of the last factorize(), for numRHS
+    // right hand sides stored one after the other in x, overwriting them
+    // with the solutions; the right hand sides are solved concurrently
+    int solveFactored(int numRHS, double *x);
+
+    virtual int setLinearSOE(SupernodalSymLinSOE &theSOE);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    int symbolic(void);
+    int order(const std::vector<int> &xadj, const std::vector<int> &adjncy);
+    template <class T> int factor(std::vector<T> &L, std::vector<T> &D);
+    template <class T> int factorSupernode(int s, std::vector<T> &L,
+					   std::vector<T> &D);
+    template <class T> void substitute(const std::vector<T> &L,
+				       const std::vector<T> &D, T *y);
+    int factorDouble(void);
+    void computeNorm(void);
+    int solveSingle(void);
+
+    int ordering;
+    bool ldlt;
+    bool mixed;
+    ThreadPool *theThreads;
+
+    int size;
+    std::vector<int> perm;         // new -> old equation number
+    std::vector<int> iperm;        // old -> new equation number
+
+    // supernodes; the columns of supernode s are superStart[s] to
+    // superStart[s+1]-1, its rows (own columns first) are stored in
+    // superRows from rowStart[s], its values, column major with one
+    // column for each row, in L from valueStart[s]
+    int numSuper;
+    std::vector<int> superStart;
+    std::vector<int> colToSuper;
+    std::vector<int> rowStart;
+    std::vector<int> superRows;
+    std::vector<int> valueStart;
+
+    // for each supernode, the descendants updating it and the position in
+    // the descendant rows of its first row within the supernode
+    std::vector<int> updateStart;
+    std::vector<int> updateSuper;
+    std::vector<int> updateRow;
+
+    // supernodes grouped by level of the supernodal elimination tree
+    std::vector<int> levelStart;
+    std::vector<int> levelSuper;
+
+    // for each supernode, the entries of A and their locations in L
+    std::vector<int> assembleStart;
+    std::vector<int> assembleFrom;
+    std::vector<int> assembleTo;
+
+    int maxUpdate;                 // largest update block C
+    int maxWork;                   // largest L*D block of an LDL^T update
+
+    std::vector<double> L;
+    std::vector<double> D;
+    std::vector<double> Y;
+
+    // single precision factors of the mixed precision mode
+    std::vector<float> Lf;
+    std::vector<float> Df;
+    std::vector<float> Yf;
+    bool singleFactored;           // L is in Lf and Df
+    double normA;
+    IterativeRefinement theRefinement;
+
+    int symbolicStamp;             // SOE pattern stamp of the structure
+    int numericStamp;              // SOE values stamp of L
+
+    SupernodalSymLinSOE *theSOE;
+};
+
+#endif
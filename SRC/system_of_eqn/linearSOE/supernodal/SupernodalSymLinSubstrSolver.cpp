@@ -0,0 +1,425 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of
+// SupernodalSymLinSubstrSolver.
+//
+#include <SupernodalSymLinSubstrSolver.h>
+#include <SupernodalSymLinSOE.h>
+#include <ThreadPool.h>
+#include <ID.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <classTags.h>
+#include <algorithm>
+
+SupernodalSymLinSubstrSolver::SupernodalSymLinSubstrSolver(int order, bool ldl,
+							   int threads)
+    :SupernodalSymLinSolver(order, ldl, 1),
+     DomainSolver(SOLVER_TAGS_SupernodalSymLinSubstrSolver),
+     ordering(order), ldlt(ldl), numThreads(threads),
+     theSOE(0), theInteriorSOE(0), theInteriorSolver(0),
+     numInt(0), numExt(0), patternStamp(-1), condensedStamp(-1), condensed(false),
+     Aext(), Yext(), Yint(), Xext(), SU(), numReused(0)
+{
+    if (numThreads < 1)
+	numThreads = ThreadPool::getNumHardwareThreads();
+
+    // the interior is factored, and its solves done, with the threads
+    theInteriorSolver = new SupernodalSymLinSolver(ordering, ldlt, numThreads);
+    theInteriorSOE = new SupernodalSymLinSOE(*theInteriorSolver);
+}
+
+
+SupernodalSymLinSubstrSolver::~SupernodalSymLinSubstrSolver()
+{
+    // the SOE deletes its solver
+    if (theInteriorSOE != 0)
+	delete theInteriorSOE;
+}
+
+int
+SupernodalSymLinSubstrSolver::setLinearSOE(SupernodalSymLinSOE &theLinearSOE)
+{
+    theSOE = &theLinearSOE;
+    patternStamp = -1;
+    condensed = false;
+    return this->SupernodalSymLinSolver::setLinearSOE(theLinearSOE);
+}
+
+int
+SupernodalSymLinSubstrSolver::setSize(void)
+{
+    // the symbolic analyses are done when A is first condensed or solved
+    condensed = false;
+    return 0;
+}
+
+int
+SupernodalSymLinSubstrSolver::solve(void)
+{
+    return this->SupernodalSymLinSolver::solve();
+}
+
+// splits the pattern of A into A_II, which goes to the interior SOE, and
+// A_EI, kept by exterior row
+int
+SupernodalSymLinSubstrSolver::setPattern(int nInt)
+{
+    const std::vector<int> &colStartA = theSOE->colStartA;
+    const std::vector<int> &rowA = theSOE->rowA;
+    int n = theSOE->X.Size();
+
+    numInt = nInt;
+    numExt = n - nInt;
+
+    SupernodalSymLinSOE &theInterior = *theInteriorSOE;
+    theInterior.colStartA.assign(1, 0);
+    theInterior.rowA.clear();
+    interiorLoc.clear();
+    extStart.assign(numExt+1, 0);
+
+    for (int j=0; j<numInt; j++) {
+	for (int k=colStartA[j]; k<colStartA[j+1]; k++) {
+	    int i = rowA[k];
+	    if (i < numInt) {
+		theInterior.rowA.push_back(i);
+		interiorLoc.push_back(k);
+	    } else
+		extStart[i-numInt+1]++;
+	}
+	theInterior.colStartA.push_back((int)theInterior.rowA.size());
+    }
+
+    for (int e=0; e<numExt; e++)
+	extStart[e+1] += extStart[e];
+    extCol.resize(extStart[numExt]);
+    extLoc.resize(extStart[numExt]);
+
+    std::vector<int> extNext(extStart.begin(), extStart.end()-1);
+    for (int j=0; j<numInt; j++)
+	for (int k=colStartA[j]; k<colStartA[j+1]; k++) {
+	    int i = rowA[k];
+	    if (i >= numInt) {
+		int p = extNext[i-numInt]++;
+		extCol[p] = j;
+		extLoc[p] = k;
+	    }
+	}
+
+    theInterior.A.assign(interiorLoc.size(), 0.0);
+    theInterior.X.resize(numInt);
+    theInterior.X.Zero();
+    theInterior.B.resize(numInt);
+    theInterior.B.Zero();
+    theInterior.patternChanged();
+
+    if (Aext.noRows() != numExt)
+	Aext.resize(numExt, numExt);
+    Yext.resize(numExt);
+    Yint.resize(numInt);
+    Xext.resize(numExt);
+    SU.resize(numExt);
+
+    patternStamp = theSOE->getPatternStamp();
+    condensed = false;
+
+    return 0;
+}
+
+int
+SupernodalSymLinSubstrSolver::solveInterior(int numRHS, double *x)
+{
+    if (numInt == 0)
+	return 0;
+    return theInteriorSolver->solveFactored(numRHS, x);
+}
+
+
+int
+SupernodalSymLinSubstrSolver::condenseA(int nInt)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SupernodalSymLinSubstrSolver::condenseA() - no SOE\n";
+	return -1;
+    }
+
+    int n = theSOE->X.Size();
+    if (nInt < 0 || nInt > n) {
+	opserr << "WARNING SupernodalSymLinSubstrSolver::condenseA() - numInt "
+	       << nInt << " not in [0, " << n << "]\n";
+	return -1;
+    }
+
+    if (patternStamp != theSOE->getPatternStamp() || numInt != nInt ||
+	numInt+numExt != n)
+	this->setPattern(nInt);
+
+    // until A is formed again the factors of A_II and S are still valid
+    if (condensed == true && condensedStamp == theSOE->getValuesStamp()) {
+	numReused++;
+	return 0;
+    }
+    condensed = false;
+    const std::vector<double> &A = theSOE->A;
+    const double *a = A.empty() ? 0 : &A[0];
+
+    // factor A_II
+    SupernodalSymLinSOE &theInterior = *theInteriorSOE;
+    int numIntEntries = (int)interiorLoc.size();
+    for (int k=0; k<numIntEntries; k++)
+	theInterior.A[k] = a[interiorLoc[k]];
+    theInterior.valuesChanged();
+
+    if (numInt > 0 && theInteriorSolver->factorize() < 0) {
+	opserr << "WARNING SupernodalSymLinSubstrSolver::condenseA() - failed to factor the interior\n";
+	return -1;
+    }
+
+    // S = A_EE ...
+    const std::vector<int> &colStartA = theSOE->colStartA;
+    const std::vector<int> &rowA = theSOE->rowA;
+    Aext.Zero();
+    for (int j=numInt; j<n; j++)
+	for (int k=colStartA[j]; k<colStartA[j+1]; k++) {
+	    int e1 = rowA[k] - numInt;
+	    int e2 = j - numInt;
+	    Aext(e1, e2) = a[k];
+	    Aext(e2, e1) = a[k];
+	}
+
+    // ... - A_EI inv(A_II) A_IE, solving for blocks of columns of A_IE
+    int blockSize = std::min(std::max(8*numThreads, 16), std::max(numExt, 1));
+    if ((int)work.size() < numInt*blockSize)
+	work.resize(numInt*blockSize);
+
+    for (int e0=0; e0<numExt && numInt>0; e0+=blockSize) {
+	int numCols = std::min(blockSize, numExt-e0);
+	double *y = &work[0];
+	std::fill(y, y+numInt*numCols, 0.0);
+	for (int c=0; c<numCols; c++)
+	    for (int p=extStart[e0+c]; p<extStart[e0+c+1]; p++)
+		y[c*numInt + extCol[p]] = a[extLoc[p]];
+
+	if (this->solveInterior(numCols, y) < 0)
+	    return -1;
+
+	for (int c=0; c<numCols; c++) {
+	    int e = e0 + c;
+	    const double *yc = y + c*numInt;
+	    for (int e2=e; e2<numExt; e2++) {
+		double sum = 0.0;
+		for (int p=extStart[e2]; p<extStart[e2+1]; p++)
+		    sum += a[extLoc[p]]*yc[extCol[p]];
+		Aext(e2, e) -= sum;
+		if (e2 != e)
+		    Aext(e, e2) -= sum;
+	    }
+	}
+    }
+
+    condensed = true;
+    condensedStamp = theSOE->getValuesStamp();
+
+    return 0;
+}
+
+
+int
+SupernodalSymLinSubstrSolver::condenseRHS(int nInt, Vector *u)
+{
+    if (condensed == false || numInt != nInt ||
+	condensedStamp != theSOE->getValuesStamp()) {
+	int ok = this->condenseA(nInt);
+	if (ok < 0) {
+	    opserr << "WARNING SupernodalSymLinSubstrSolver::condenseRHS()";
+	    opserr << " - failed to condenseA\n";
+	    return ok;
+	}
+    }
+
+    // Yint = inv(A_II) b_I, Yext = b_E - A_EI Yint
+    const Vector &B = theSOE->B;
+    for (int i=0; i<numInt; i++)
+	Yint(i) = B(i);
+
+    if (numInt > 0 && this->solveInterior(1, &Yint(0)) < 0)
+	return -1;
+
+    const double *a = theSOE->A.empty() ? 0 : &theSOE->A[0];
+    for (int e=0; e<numExt; e++) {
+	double sum = B(numInt+e);
+	for (int p=extStart[e]; p<extStart[e+1]; p++)
+	    sum -= a[extLoc[p]]*Yint(extCol[p]);
+	Yext(e) = sum;
+    }
+
+    return 0;
+}
+
+
+int
+SupernodalSymLinSubstrSolver::computeCondensedMatVect(int nInt, const Vector &u)
+{
+    if (condensed == false || numInt != nInt ||
+	condensedStamp != theSOE->getValuesStamp()) {
+	int ok = this->condenseA(nInt);
+	if (ok < 0)
+	    return ok;
+    }
+
+    if (u.Size() != numExt) {
+	opserr << "WARNING SupernodalSymLinSubstrSolver::computeCondensedMatVect() - size mismatch "
+	       << u.Size() << " and " << numExt << endln;
+	return -1;
+    }
+
+    SU.addMatrixVector(0.0, Aext, u, 1.0);
+    return 0;
+}
+
+
+const Matrix &
+SupernodalSymLinSubstrSolver::getCondensedA(void)
+{
+    return Aext;
+}
+
+
+const Vector &
+SupernodalSymLinSubstrSolver::getCondensedRHS(void)
+{
+    return Yext;
+}
+
+
+const Vector &
+SupernodalSymLinSubstrSolver::getCondensedMatVect(void)
+{
+    return SU;
+}
+
+
+int
+SupernodalSymLinSubstrSolver::setComputedXext(const Vector &xExt)
+{
+    if (xExt.Size() != numExt) {
+	opserr << "WARNING SupernodalSymLinSubstrSolver::setComputedXext() - size mismatch "
+	       << xExt.Size() << " and " << numExt << endln;
+	return -1;
+    }
+
+    for (int e=0; e<numExt; e++)
+	theSOE->X(numInt+e) = xExt(e);
+
+    return 0;
+}
+
+
+// x_I = inv(A_II) (b_I - A_IE x_E) = Yint - inv(A_II) A_IE x_E
+int
+SupernodalSymLinSubstrSolver::solveXint(void)
+{
+    if (condensed == false || condensedStamp != theSOE->getValuesStamp()) {
+	opserr << "WARNING SupernodalSymLinSubstrSolver::solveXint() - A has not been condensed\n";
+	return -1;
+    }
+
+    if (numInt == 0)
+	return 0;
+
+    Vector &X = theSOE->X;
+    const double *a = theSOE->A.empty() ? 0 : &theSOE->A[0];
+
+    if ((int)work.size() < numInt)
+	work.resize(numInt);
+    double *r = &work[0];
+    std::fill(r, r+numInt, 0.0);
+    for (int e=0; e<numExt; e++) {
+	double xe = X(numInt+e);
+	for (int p=extStart[e]; p<extStart[e+1]; p++)
+	    r[extCol[p]] += a[extLoc[p]]*xe;
+    }
+
+    if (this->solveInterior(1, r) < 0)
+	return -1;
+
+    for (int i=0; i<numInt; i++)
+	X(i) = Yint(i) - r[i];
+
+    return 0;
+}
+
+
+int
+SupernodalSymLinSubstrSolver::getNumReused(void) const
+{
+    return numReused;
+}
+
+
+int
+SupernodalSymLinSubstrSolver::getClassTag(void) const
+{
+    return SOLVER_TAGS_SupernodalSymLinSubstrSolver;
+}
+
+
+int
+SupernodalSymLinSubstrSolver::sendSelf(int cTag, Channel &theChannel)
+{
+    static ID data(3);
+    data(0) = ordering;
+    data(1) = ldlt ? 1 : 0;
+    data(2) = numThreads;
+
+    if (theChannel.sendID(this->DomainSolver::getDbTag(), cTag, data) < 0) {
+	opserr << "WARNING SupernodalSymLinSubstrSolver::sendSelf() - failed to send data\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+
+int
+SupernodalSymLinSubstrSolver::recvSelf(int cTag, Channel &theChannel,
+				       FEM_ObjectBroker &theBroker)
+{
+    static ID data(3);
+    if (theChannel.recvID(this->DomainSolver::getDbTag(), cTag, data) < 0) {
+	opserr << "WARNING SupernodalSymLinSubstrSolver::recvSelf() - failed to recv data\n";
+	return -1;
+    }
+
+    ordering = data(0);
+    ldlt = (data(1) == 1);
+    numThreads = data(2);
+
+    // a new interior solver with the options of the sending object
+    if (theInteriorSOE != 0)
+	delete theInteriorSOE;
+    theInteriorSolver = new SupernodalSymLinSolver(ordering, ldlt, numThreads);
+    theInteriorSOE = new SupernodalSymLinSOE(*theInteriorSolver);
+    patternStamp = -1;
+    condensed = false;
+
+    return 0;
+}
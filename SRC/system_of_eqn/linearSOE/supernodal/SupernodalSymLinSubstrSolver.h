@@ -0,0 +1,117 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for
+// SupernodalSymLinSubstrSolver. SupernodalSymLinSubstrSolver is a
+// subclass of DomainSolver and SupernodalSymLinSolver. It performs the
+// static condensation of a substructuring domain decomposition method
+// on a SupernodalSymLinSOE object, whose first numInt equations are
+// those of the interior of the subdomain:
+//
+//    | A_II  A_IE | | x_I |   | b_I |
+//    | A_EI  A_EE | | x_E | = | b_E |
+//
+// A_II is factored with a SupernodalSymLinSolver, its supernodes
+// factored concurrently, and the condensed tangent
+//
+//    S = A_EE - A_EI inv(A_II) A_IE
+//
+// formed from solves for the columns of A_IE, which are done
+// concurrently. If A has not been formed again since the last
+// condensation, as with a modified Newton or a linear algorithm, the
+// factors of A_II and S are reused, so that only the right hand side is
+// condensed again; the values stamp of the SOE tells when it has been.
+//
+#ifndef SupernodalSymLinSubstrSolver_h
+#define SupernodalSymLinSubstrSolver_h
+
+#include <DomainSolver.h>
+#include <SupernodalSymLinSolver.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <vector>
+
+class SupernodalSymLinSOE;
+
+class SupernodalSymLinSubstrSolver : public SupernodalSymLinSolver,
+                                     public DomainSolver
+{
+  public:
+    SupernodalSymLinSubstrSolver(int ordering = ORDER_AMD, bool ldlt = false,
+				 int numThreads = 1);
+    ~SupernodalSymLinSubstrSolver();
+
+    int solve(void);
+    int setSize(void);
+    int setLinearSOE(SupernodalSymLinSOE &theSOE);
+
+    int condenseA(int numInt);
+    int condenseRHS(int numInt, Vector *u =0);
+    int computeCondensedMatVect(int numInt, const Vector &u);
+    const Matrix &getCondensedA(void);
+    const Vector &getCondensedRHS(void);
+    const Vector &getCondensedMatVect(void);
+
+    int setComputedXext(const Vector &);
+    int solveXint(void);
+
+    // number of condensations that reused the factors of A_II and S
+    int getNumReused(void) const;
+
+    int getClassTag(void) const;
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    int setPattern(int numInt);
+    int solveInterior(int numRHS, double *x);
+
+    int ordering;
+    bool ldlt;
+    int numThreads;
+
+    SupernodalSymLinSOE *theSOE;
+    SupernodalSymLinSOE *theInteriorSOE;      // A_II
+    SupernodalSymLinSolver *theInteriorSolver;
+
+    int numInt;                    // interior equations of the pattern
+    int numExt;
+    int patternStamp;              // SOE pattern stamp of the pattern
+    std::vector<int> interiorLoc;  // location in A of the entries of A_II
+    std::vector<int> extStart;     // entries of A_EI by exterior row: the
+    std::vector<int> extCol;       // interior column and location in A
+    std::vector<int> extLoc;
+    int condensedStamp;            // SOE values stamp of the condensed A
+    bool condensed;
+
+    Matrix Aext;                   // S
+    Vector Yext;                   // condensed right hand side
+    Vector Yint;                   // inv(A_II) b_I
+    Vector Xext;
+    Vector SU;                     // S u
+    std::vector<double> work;
+
+    int numReused;
+};
+
+#endif
@@ -0,0 +1,199 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: a test of SupernodalSymLinSubstrSolver. The equations of a
+// grid of nx by ny points, coupled to their neighbours, are solved by
+// condensing them onto the last row of points and solving the condensed
+// system with Matrix::Solve, and directly with a SupernodalSymLinSolver.
+// The solutions must agree for a first right hand side, for a second one
+// while the condensed tangent is reused, and once more after A is formed
+// again with other values, when it must be condensed again.
+//
+// Usage: testSupernodalSubstr
+
+#include <StandardStream.h>
+#include <SupernodalSymLinSOE.h>
+#include <SupernodalSymLinSolver.h>
+#include <SupernodalSymLinSubstrSolver.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+
+#include <math.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+static const int nx = 12;
+static const int ny = 9;
+
+// the points of the grid, row by row, the last row the interface
+static Graph *
+createGraph(void)
+{
+  Graph *theGraph = new Graph(nx*ny);
+  for (int i=0; i<nx*ny; i++)
+    theGraph->addVertex(new Vertex(i, i));
+
+  for (int j=0; j<ny; j++)
+    for (int i=0; i<nx; i++) {
+      int a = j*nx + i;
+      if (i+1 < nx)
+	theGraph->addEdge(a, a+1);
+      if (j+1 < ny)
+	theGraph->addEdge(a, a+nx);
+    }
+
+  return theGraph;
+}
+
+// a spring between each pair of neighbours and to the ground at each point
+static void
+formA(SupernodalSymLinSOE &theSOE, double ground)
+{
+  theSOE.zeroA();
+
+  Matrix k(2,2);
+  ID id(2);
+  for (int j=0; j<ny; j++)
+    for (int i=0; i<nx; i++) {
+      int a = j*nx + i;
+      double stiffness = 1.0 + 0.1*((a*7) % 5);
+      k(0,0) = stiffness; k(0,1) = -stiffness;
+      k(1,0) = -stiffness; k(1,1) = stiffness;
+      id(0) = a;
+      if (i+1 < nx) {
+	id(1) = a+1;
+	theSOE.addA(k, id);
+      }
+      if (j+1 < ny) {
+	id(1) = a+nx;
+	theSOE.addA(k, id);
+      }
+    }
+
+  Matrix g(1,1);
+  ID gid(1);
+  for (int a=0; a<nx*ny; a++) {
+    g(0,0) = ground*(1.0 + 0.05*(a % 3));
+    gid(0) = a;
+    theSOE.addA(g, gid);
+  }
+}
+
+static void
+formB(SupernodalSymLinSOE &theSOE, double phase)
+{
+  Vector b(nx*ny);
+  for (int a=0; a<nx*ny; a++)
+    b(a) = sin(0.37*a + phase);
+  theSOE.setB(b);
+}
+
+// solves by condensing onto the last row and returns the largest
+// difference from the direct solution
+static double
+compare(SupernodalSymLinSOE &theDirectSOE, SupernodalSymLinSOE &theSubstrSOE,
+	SupernodalSymLinSubstrSolver &theSubstrSolver)
+{
+  int numInt = nx*(ny-1);
+
+  if (theDirectSOE.solve() < 0)
+    return -1.0;
+
+  if (theSubstrSolver.condenseA(numInt) < 0 ||
+      theSubstrSolver.condenseRHS(numInt) < 0)
+    return -1.0;
+
+  Matrix S(theSubstrSolver.getCondensedA());
+  const Vector &Y = theSubstrSolver.getCondensedRHS();
+  Vector xExt(nx);
+  if (S.Solve(Y, xExt) < 0)
+    return -1.0;
+
+  if (theSubstrSolver.setComputedXext(xExt) < 0 ||
+      theSubstrSolver.solveXint() < 0)
+    return -1.0;
+
+  const Vector &xDirect = theDirectSOE.getX();
+  const Vector &xSubstr = theSubstrSOE.getX();
+  double maxDiff = 0.0;
+  for (int a=0; a<nx*ny; a++) {
+    double diff = fabs(xDirect(a) - xSubstr(a))/(1.0 + fabs(xDirect(a)));
+    if (diff > maxDiff)
+      maxDiff = diff;
+  }
+  return maxDiff;
+}
+
+int main(int argc, char **argv)
+{
+  int numErrors = 0;
+  double tol = 1.0e-10;
+
+  Graph *theGraph = createGraph();
+
+  SupernodalSymLinSolver *theDirectSolver = new SupernodalSymLinSolver();
+  SupernodalSymLinSOE theDirectSOE(*theDirectSolver);
+  SupernodalSymLinSubstrSolver *theSubstrSolver =
+    new SupernodalSymLinSubstrSolver(SupernodalSymLinSolver::ORDER_AMD, false, 2);
+  SupernodalSymLinSOE theSubstrSOE(*theSubstrSolver);
+  theDirectSOE.setSize(*theGraph);
+  theSubstrSOE.setSize(*theGraph);
+
+  // a first right hand side
+  formA(theDirectSOE, 0.05);
+  formA(theSubstrSOE, 0.05);
+  formB(theDirectSOE, 0.0);
+  formB(theSubstrSOE, 0.0);
+  double diff = compare(theDirectSOE, theSubstrSOE, *theSubstrSolver);
+  opserr << "first right hand side, difference " << diff << endln;
+  if (diff < 0.0 || diff > tol)
+    numErrors++;
+
+  // a second one, with the same A
+  formB(theDirectSOE, 1.0);
+  formB(theSubstrSOE, 1.0);
+  diff = compare(theDirectSOE, theSubstrSOE, *theSubstrSolver);
+  opserr << "second right hand side, difference " << diff;
+  opserr << ", condensations reused " << theSubstrSolver->getNumReused() << endln;
+  if (diff < 0.0 || diff > tol || theSubstrSolver->getNumReused() != 1)
+    numErrors++;
+
+  // A formed again with other values
+  formA(theDirectSOE, 0.5);
+  formA(theSubstrSOE, 0.5);
+  diff = compare(theDirectSOE, theSubstrSOE, *theSubstrSolver);
+  opserr << "A formed again, difference " << diff;
+  opserr << ", condensations reused " << theSubstrSolver->getNumReused() << endln;
+  if (diff < 0.0 || diff > tol || theSubstrSolver->getNumReused() != 1)
+    numErrors++;
+
+  delete theGraph;
+
+  if (numErrors == 0)
+    opserr << "PASSED testSupernodalSubstr\n";
+  else
+    opserr << "FAILED testSupernodalSubstr: " << numErrors << " errors\n";
+
+  return numErrors == 0 ? 0 : 1;
+}
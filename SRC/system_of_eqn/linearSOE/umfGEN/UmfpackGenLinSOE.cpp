@@ -79,6 +79,7 @@ UmfpackGenLinSOE::setSize(Graph &theGraph)
 	opserr<<"size of soe < 0\n";
 	return -1;
     }
+    theScatterMap.clear();
 
     // fist itearte through the vertices of the graph to get nnz
     Vertex *theVertex;
@@ -89,6 +90,11 @@ UmfpackGenLinSOE::setSize(Graph &theGraph)
 	nnz += theAdjacency.Size() +1; // the +1 is for the diag entry
     }
 
+    // keep the old structure to find out if the pattern has changed
+    std::vector<int> oldAp, oldAi;
+    oldAp.swap(Ap);
+    oldAi.swap(Ai);
+
     // resize A, B, X
     Ap.reserve(size+1);
     Ai.reserve(nnz);
@@ -107,6 +113,7 @@ UmfpackGenLinSOE::setSize(Graph &theGraph)
 	    opserr << "WARNING:UmfpackGenLinSOE::setSize :";
 	    opserr << " vertex " << a << " not in graph! - size set to 0\n";
 	    size = 0;
+	    this->patternChanged();
 	    return -1;
 	}
 
@@ -132,6 +139,18 @@ UmfpackGenLinSOE::setSize(Graph &theGraph)
 	Ap.push_back(Ap[a]+col.Size());
     }
 
+    // A has been resized, the symbolic analysis is redone only if its
+    // structure differs from the last one
+    if (Ap != oldAp || Ai != oldAi)
+	this->patternChanged();
+    else
+	this->valuesChanged();
+
+    // locate the entries of the FE_Element tangents in Ax
+    if (theModel != 0 && size != 0)
+	theScatterMap.build(*theModel, size, &Ap[0], &Ai[0],
+			    ScatterMap::ColumnCompressed);
+
     // invoke setSize() on the Solver
     LinearSOESolver *the_Solver = this->getSolver();
     int solverOK = the_Solver->setSize();
@@ -158,6 +177,8 @@ UmfpackGenLinSOE::addA(const Matrix &m, const ID &id, double fact)
 	return -1;
     }
 
+    this->valuesChanged();
+
     int size = X.Size();
     if (fact == 1.0) { // do not need to multiply
 	for (int j=0; j<idSize; j++) {
@@ -206,6 +227,22 @@ UmfpackGenLinSOE::addA(const Matrix &m, const ID &id, double fact)
     return 0;
 }
 
+int
+UmfpackGenLinSOE::addA(const Matrix &m, const FE_Element &theEle, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0) return 0;
+
+    // use the locations found in setSize(); search as in addA(m, id, fact)
+    // for an FE_Element without a map
+    if (Ax.size() > 0 && theScatterMap.add(&Ax[0], m, theEle, fact)) {
+	this->valuesChanged();
+	return 0;
+    }
+
+    return this->addA(m, theEle.getID(), fact);
+}
+
 
 int
 UmfpackGenLinSOE::addB(const Vector &v, const ID &id, double fact)
@@ -280,6 +317,7 @@ void
 UmfpackGenLinSOE::zeroA(void)
 {
     Ax.assign(Ax.size(),0.0);
+    this->valuesChanged();
 }
 
 void
@@ -37,6 +37,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <ScatterMap.h>
 #include <vector>
 
 class UmfpackGenLinSolver;
@@ -52,6 +53,7 @@ public:
     int getNumEqn(void) const;
     int setSize(Graph &theGraph);
     int addA(const Matrix &, const ID &, double fact = 1.0);
+    int addA(const Matrix &, const FE_Element &, double fact = 1.0);
     int addB(const Vector &, const ID &, double fact = 1.0);    
     int setB(const Vector &, double fact = 1.0);        
     
@@ -78,6 +80,7 @@ private:
     Vector X,B;
     std::vector<int> Ap, Ai;
     std::vector<double> Ax;
+    ScatterMap theScatterMap;  // location in Ax of the FE_Element tangents
 };
 
 
@@ -46,13 +46,17 @@ void* OPS_UmfpackGenLinSolver()
 
 UmfpackGenLinSolver::
 UmfpackGenLinSolver()
-    :LinearSOESolver(SOLVER_TAGS_UmfpackGenLinSolver), Symbolic(0), theSOE(0)
+    :LinearSOESolver(SOLVER_TAGS_UmfpackGenLinSolver), Symbolic(0), Numeric(0),
+     symbolicStamp(-1), numericStamp(-1), theSOE(0)
 {
 }
 
 
 UmfpackGenLinSolver::~UmfpackGenLinSolver()
 {
+    if (Numeric != 0) {
+	umfpack_di_free_numeric(&Numeric);
+    }
     if (Symbolic != 0) {
 	umfpack_di_free_symbolic(&Symbolic);
     }
@@ -77,23 +81,29 @@ UmfpackGenLinSolver::solve(void)
 	return -1;
     }
     
-    // numerical analysis
-    void* Numeric = 0;
-    int status = umfpack_di_numeric(Ap,Ai,Ax,Symbolic,&Numeric,Control,Info);
-
-    // check error
-    if (status!=UMFPACK_OK) {
-	opserr<<"WARNING: numeric analysis returns "<<status<<" -- Umfpackgenlinsolver::solve\n";
-	return -1;
+    // numerical analysis, only if A has changed since the last one
+    if (Numeric == 0 || numericStamp != theSOE->getValuesStamp()) {
+	if (Numeric != 0) {
+	    umfpack_di_free_numeric(&Numeric);
+	}
+	int status = umfpack_di_numeric(Ap,Ai,Ax,Symbolic,&Numeric,Control,Info);
+	numNumeric++;
+
+	// check error
+	if (status!=UMFPACK_OK) {
+	    opserr<<"WARNING: numeric analysis returns "<<status<<" -- Umfpackgenlinsolver::solve\n";
+	    if (Numeric != 0) {
+		umfpack_di_free_numeric(&Numeric);
+	    }
+	    Numeric = 0;
+	    return -1;
+	}
+	numericStamp = theSOE->getValuesStamp();
     }
 
     // solve
-    status = umfpack_di_solve(UMFPACK_A,Ap,Ai,Ax,X,B,Numeric,Control,Info);
-
-    // delete Numeric
-    if (Numeric != 0) {
-	umfpack_di_free_numeric(&Numeric);
-    }
+    int status = umfpack_di_solve(UMFPACK_A,Ap,Ai,Ax,X,B,Numeric,Control,Info);
+    numSolve++;
     
     // check error
     if (status!=UMFPACK_OK) {
@@ -116,16 +126,26 @@ UmfpackGenLinSolver::setSize()
     int n = theSOE->X.Size();
     int nnz = (int)theSOE->Ai.size();
     if (n == 0 || nnz==0) return 0;
+
+    // nothing to do if the pattern of A is the one last analysed
+    if (Symbolic != 0 && symbolicStamp == theSOE->getPatternStamp())
+	return 0;
     
     int* Ap = &(theSOE->Ap[0]);
     int* Ai = &(theSOE->Ai[0]);
     double* Ax = &(theSOE->Ax[0]);
 
+    // the factorization belongs to the old pattern
+    if (Numeric != 0) {
+	umfpack_di_free_numeric(&Numeric);
+    }
+
     // symbolic analysis
     if (Symbolic != 0) {
 	umfpack_di_free_symbolic(&Symbolic);
     }
     int status = umfpack_di_symbolic(n,n,Ap,Ai,Ax,&Symbolic,Control,Info);
+    numSymbolic++;
 
     // check error
     if (status!=UMFPACK_OK) {
@@ -133,6 +153,7 @@ UmfpackGenLinSolver::setSize()
 	Symbolic = 0;
 	return -1;
     }
+    symbolicStamp = theSOE->getPatternStamp();
     return 0;
 }
 
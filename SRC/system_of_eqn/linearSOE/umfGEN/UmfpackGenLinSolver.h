@@ -59,6 +59,9 @@ class UmfpackGenLinSolver : public LinearSOESolver
 
   private:
     void *Symbolic;
+    void *Numeric;
+    int symbolicStamp;     // SOE pattern stamp of Symbolic
+    int numericStamp;      // SOE values stamp of Numeric
     double Control[UMFPACK_CONTROL], Info[UMFPACK_INFO];
     UmfpackGenLinSOE *theSOE;
 };
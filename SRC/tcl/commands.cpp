@@ -79,6 +79,7 @@ using std::ofstream;
 #include <StandardStream.h>
 #include <FileStream.h>
 #include <DummyStream.h>
+#include <AsyncStreamWriter.h>
 
 bool OPS_suppressOpenSeesOutput = false;
 bool OPS_showHeader = true;
@@ -107,6 +108,7 @@ extern "C" int         OPS_ResetInputNoBuilder(ClientData clientData, Tcl_Interp
 // domain
 #ifdef _PARALLEL_PROCESSING
 #include <PartitionedDomain.h>
+#include <ThreadPool.h>
 #else
 #include <Domain.h>
 #endif
@@ -116,6 +118,7 @@ extern "C" int         OPS_ResetInputNoBuilder(ClientData clientData, Tcl_Interp
 #include <Node.h>
 #include <ElementIter.h>
 #include <NodeIter.h>
+#include <SharedParameters.h>
 #include <LoadPattern.h>
 #include <LoadPatternIter.h>
 #include <NodalLoad.h>
@@ -403,6 +406,7 @@ extern void OPS_SetReliabilityDomain(ReliabilityDomain *);
 #endif
 
 #include <FE_Datastore.h>
+#include <SnapshotDatastore.h>
 
 #ifdef _RELIABILITY
 // AddingSensitivity:BEGIN /////////////////////////////////////////////////
@@ -456,6 +460,10 @@ ModelBuilder* theBuilder = 0;
 // parallel analysis
 #include <StaticDomainDecompositionAnalysis.h>
 #include <TransientDomainDecompositionAnalysis.h>
+#include <DomainDecompositionAnalysis.h>
+#include <DomainDecompAlgo.h>
+#include <SupernodalSymLinSOE.h>
+#include <SupernodalSymLinSubstrSolver.h>
 #include <ParallelNumberer.h>
 
 //  parallel soe & solvers
@@ -605,6 +613,9 @@ char* simulationInfoOutputFilename = 0;
 FE_Datastore* theDatabase = 0;
 FEM_ObjectBrokerAllClasses theBroker;
 
+// threads of the domain sweeps and of the assembly, set by threads
+static int numThreads = 1;
+
 // init the global variabled defined in OPS_Globals.h
 // double        ops_Dt = 1.0;
 // Element    *ops_TheActiveElement = 0;
@@ -645,6 +656,21 @@ getPID(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
 int
 getNP(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
 
+int
+setNumThreads(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
+
+int
+nodalStateStore(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
+
+int
+recorderWriter(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
+
+int
+snapshot(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
+
+int
+domainState(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
+
 int
 opsBarrier(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
 
@@ -932,6 +958,14 @@ int OpenSeesAppInit(Tcl_Interp* interp) {
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
     Tcl_CreateCommand(interp, "database", &addDatabase, 
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
+    Tcl_CreateCommand(interp, "snapshot", &snapshot, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
+    Tcl_CreateCommand(interp, "saveState", &domainState, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
+    Tcl_CreateCommand(interp, "restoreState", &domainState, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
+    Tcl_CreateCommand(interp, "removeState", &domainState, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
     Tcl_CreateCommand(interp, "eigen", &eigenAnalysis, 
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);       
     Tcl_CreateCommand(interp, "modalProperties", &modalProperties,
@@ -1019,6 +1053,12 @@ int OpenSeesAppInit(Tcl_Interp* interp) {
 
 	Tcl_CreateCommand(interp, "getNP", &getNP,
 		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+	Tcl_CreateCommand(interp, "threads", &setNumThreads,
+		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+	Tcl_CreateCommand(interp, "nodalStateStore", &nodalStateStore,
+		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+	Tcl_CreateCommand(interp, "recorderWriter", &recorderWriter,
+		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
 	Tcl_CreateCommand(interp, "getPID", &getPID,
 		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
 	Tcl_CreateCommand(interp, "barrier", &opsBarrier,
@@ -2035,6 +2075,36 @@ buildModel(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
 
 #ifdef _PARALLEL_PROCESSING
 
+// the send buffer of the channels to the subdomains while the model is
+// moved to them, set with partition -sendBuffer numBytes
+static int partitionSendBuffer = 4194304;
+
+// condense the subdomains onto their interface, the main analysis then
+// solving the interface problem, set with partition -substructure
+static bool partitionSubstructure = false;
+
+// move elements between the subdomains during the analysis when the
+// measured update time of the heaviest is more than partitionBalanceRatio
+// times the mean, checked every partitionBalanceInterval commits, set with
+// partition -balance ratio and -balanceEvery numCommits
+static double partitionBalanceRatio = 0.0;
+static int partitionBalanceInterval = 1;
+
+// the threads of a process may each send to the subdomains, which MPI
+// allows only if it provides MPI_THREAD_MULTIPLE
+static int
+checkThreadSupport(int num)
+{
+	int provided = MPI_THREAD_SINGLE;
+	MPI_Query_thread(&provided);
+	if (num > 1 && provided < MPI_THREAD_MULTIPLE) {
+		opserr << "WARNING threads - the MPI library does not provide MPI_THREAD_MULTIPLE,";
+		opserr << " a partitioned model can only use 1 thread\n";
+		return -1;
+	}
+	return 0;
+}
+
 int
 partitionModel(int eleTag)
 {
@@ -2059,17 +2129,32 @@ partitionModel(int eleTag)
 
 	// create a partitioner & partition the domain
 	if (OPS_DOMAIN_PARTITIONER == 0) {
-		//      OPS_BALANCER = new ShedHeaviest();
 		OPS_GRAPH_PARTITIONER = new Metis;
-		//OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER, *OPS_BALANCER);
-		OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
+		if (partitionBalanceRatio > 0.0) {
+			OPS_BALANCER = new ShedHeaviest();
+			OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER, *OPS_BALANCER);
+		}
+		else
+			OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
 		theDomain.setPartitioner(OPS_DOMAIN_PARTITIONER);
 	}
 
 	// opserr << "commands.cpp - partition numPartitions: " << OPS_NUM_SUBDOMAINS << endln;
 
+	// coalesce the many small messages sent in moving the model
+	for (int i = 1; i <= OPS_NUM_SUBDOMAINS; i++)
+		if (i != OPS_MAIN_DOMAIN_PARTITION_ID)
+			OPS_theChannels[i - 1]->setSendBuffer(partitionSendBuffer);
+
 	result = theDomain.partition(OPS_NUM_SUBDOMAINS, OPS_USING_MAIN_DOMAIN, OPS_MAIN_DOMAIN_PARTITION_ID, eleTag);
 
+	for (int i = 1; i <= OPS_NUM_SUBDOMAINS; i++)
+		if (i != OPS_MAIN_DOMAIN_PARTITION_ID)
+			OPS_theChannels[i - 1]->setSendBuffer(0);
+
+	if (partitionBalanceRatio > 0.0)
+		theDomain.setLoadBalancing(partitionBalanceRatio, partitionBalanceInterval);
+
 	if (result < 0)
 		return result;
 
@@ -2081,6 +2166,28 @@ partitionModel(int eleTag)
 
 	// create the appropriate domain decomposition analysis
 	while ((theSub = theSubdomains()) != 0) {
+		if (partitionSubstructure == true) {
+			// the interior is factored, and the Schur complement formed, with the
+			// threads of the subdomain; the analysis sets itself on the subdomain
+			SupernodalSymLinSubstrSolver* theSubSolver =
+				new SupernodalSymLinSubstrSolver(SupernodalSymLinSolver::ORDER_AMD, false, theDomain.getNumThreads());
+			SupernodalSymLinSOE* theSubSOE = new SupernodalSymLinSOE(*theSubSolver);
+			IncrementalIntegrator* theSubIntegrator = theStaticIntegrator;
+			if (theStaticAnalysis == 0)
+				theSubIntegrator = theTransientIntegrator;
+			theSubAnalysis = new DomainDecompositionAnalysis(*theSub,
+				*theHandler,
+				*theNumberer,
+				*theAnalysisModel,
+				*(new DomainDecompAlgo()),
+				*theSubIntegrator,
+				*theSubSOE,
+				*theSubSolver,
+				theTest,
+				false);
+			continue;
+		}
+
 		if (theStaticAnalysis != 0) {
 			theSubAnalysis = new StaticDomainDecompositionAnalysis(*theSub,
 				*theHandler,
@@ -2121,9 +2228,45 @@ opsPartition(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** arg
 	printArgv(interp, argc, argv); //SAJalali
 #endif // _CSS
 #ifdef _PARALLEL_PROCESSING
-	int eleTag;
-	if (argc == 2) {
-		if (Tcl_GetInt(interp, argv[1], &eleTag) != TCL_OK) {
+	int eleTag = 0;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-sendBuffer") == 0 && i + 1 < argc) {
+			// 0 sends each message as it is given
+			if (Tcl_GetInt(interp, argv[++i], &partitionSendBuffer) != TCL_OK || partitionSendBuffer < 0) {
+				opserr << "WARNING partition -sendBuffer numBytes? - invalid size " << argv[i] << endln;
+				return TCL_ERROR;
+			}
+		}
+		else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc) {
+			// threads used by each subdomain, 0 for all of the hardware threads
+			int num = 0;
+			if (Tcl_GetInt(interp, argv[++i], &num) != TCL_OK || num < 0) {
+				opserr << "WARNING partition -threads numThreads? - invalid number " << argv[i] << endln;
+				return TCL_ERROR;
+			}
+			if (num == 0)
+				num = ThreadPool::getNumHardwareThreads();
+			if (checkThreadSupport(num) != 0 || theDomain.setNumThreads(num) != 0)
+				return TCL_ERROR;
+			numThreads = num;
+		}
+		else if (strcmp(argv[i], "-substructure") == 0) {
+			partitionSubstructure = true;
+		}
+		else if (strcmp(argv[i], "-balance") == 0 && i + 1 < argc) {
+			// rebalance when the heaviest subdomain exceeds ratio times the mean
+			if (Tcl_GetDouble(interp, argv[++i], &partitionBalanceRatio) != TCL_OK || partitionBalanceRatio <= 1.0) {
+				opserr << "WARNING partition -balance ratio? - ratio must exceed 1.0 " << argv[i] << endln;
+				return TCL_ERROR;
+			}
+		}
+		else if (strcmp(argv[i], "-balanceEvery") == 0 && i + 1 < argc) {
+			if (Tcl_GetInt(interp, argv[++i], &partitionBalanceInterval) != TCL_OK || partitionBalanceInterval < 1) {
+				opserr << "WARNING partition -balanceEvery numCommits? - invalid number " << argv[i] << endln;
+				return TCL_ERROR;
+			}
+		}
+		else if (Tcl_GetInt(interp, argv[i], &eleTag) != TCL_OK) {
 			;
 		}
 	}
@@ -2301,6 +2444,14 @@ printModel(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
 			done = true;
 		}
 
+		// if 'print -parameterBlocks' print out the memory held by the
+		// parameters of the materials and of their copies
+		else if ((strcmp(argv[currentArg], "-parameterBlocks") == 0)) {
+			currentArg++;
+			SharedParameterBlocks::Print(*output);
+			done = true;
+		}
+
 		// if 'print integrator flag' print out the integrator
 		else if ((strcmp(argv[currentArg], "integrator") == 0) ||
 			(strcmp(argv[currentArg], "-integrator") == 0)) {
@@ -3201,6 +3352,15 @@ specifyAnalysis(ClientData clientData, Tcl_Interp* interp, int argc,
 		}
 	}
 
+	// the threads of the domain also assemble the system of equations
+	if (numThreads > 1) {
+		if (theAnalysisModel != 0)
+			theAnalysisModel->setNumThreads(numThreads);
+		if (theStaticAnalysis != 0 && theStaticIntegrator != 0)
+			theStaticIntegrator->setNumThreads(numThreads);
+		else if (theTransientAnalysis != 0 && theTransientIntegrator != 0)
+			theTransientIntegrator->setNumThreads(numThreads);
+	}
 
 	return TCL_OK;
 	}
@@ -5915,6 +6075,99 @@ addDatabase(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv
 	return TclAddDatabase(clientData, interp, argc, argv, theDomain, theBroker);
 }
 
+// snapshot save fileName
+// snapshot restore fileName
+//   writes the state of the domain and of the integrator of the analysis
+//   to a single binary file, or brings it back from one. The domain is
+//   rebuilt from the file if its components are not those it was saved
+//   with, so that a snapshot may be restored after wipe; the state of the
+//   integrator is restored if an analysis has been defined whose
+//   integrator is of the class saved.
+int
+snapshot(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+	if (argc != 3) {
+		opserr << "WARNING want - snapshot save|restore fileName\n";
+		return TCL_ERROR;
+	}
+
+	Integrator* theIntegrator = 0;
+	if (theStaticAnalysis != 0)
+		theIntegrator = theStaticIntegrator;
+	else if (theTransientAnalysis != 0 || theVariableTimeStepTransientAnalysis != 0)
+		theIntegrator = theTransientIntegrator;
+
+	SnapshotDatastore theSnapshot(theDomain, theBroker);
+
+	if (strcmp(argv[1], "save") == 0) {
+		if (theSnapshot.commitState(theDomain.getCommitTag()) < 0 ||
+			(theIntegrator != 0 && theSnapshot.commitAnalysis(*theIntegrator) < 0) ||
+			theSnapshot.write(argv[2]) != 0) {
+			opserr << "WARNING snapshot - failed to save " << argv[2] << "\n";
+			return TCL_ERROR;
+		}
+	}
+	else if (strcmp(argv[1], "restore") == 0) {
+		if (theSnapshot.read(argv[2]) != 0 ||
+			theSnapshot.restoreState(theSnapshot.getCommitTag()) < 0 ||
+			(theIntegrator != 0 && theSnapshot.restoreAnalysis(*theIntegrator) < 0)) {
+			opserr << "WARNING snapshot - failed to restore " << argv[2] << "\n";
+			return TCL_ERROR;
+		}
+
+		// the analysis sets itself up again from the restored domain,
+		// the transient integrators taking the committed response of the
+		// nodes as their history
+		theDomain.domainChange();
+	}
+	else {
+		opserr << "WARNING snapshot - unknown action " << argv[1] << ", want save or restore\n";
+		return TCL_ERROR;
+	}
+
+	return TCL_OK;
+}
+
+// saveState id
+// restoreState id
+// removeState id
+//   keeps a copy of the committed state of the domain in memory under the
+//   given id, goes back to it, or discards it
+int
+domainState(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+	int id;
+	if (argc != 2 || Tcl_GetInt(interp, argv[1], &id) != TCL_OK) {
+		opserr << "WARNING want - " << argv[0] << " id\n";
+		return TCL_ERROR;
+	}
+
+	int res;
+	if (strcmp(argv[0], "saveState") == 0)
+		res = theDomain.saveState(id, theBroker);
+	else if (strcmp(argv[0], "restoreState") == 0)
+		res = theDomain.restoreState(id, theBroker);
+	else
+		res = theDomain.removeState(id);
+
+	if (res < 0) {
+		opserr << "WARNING " << argv[0] << " - failed for state " << id << "\n";
+		return TCL_ERROR;
+	}
+
+	// a transient integrator takes its copy of the response, e.g. the U,
+	// Udot and Udotdot of the Newmark family, from the restored nodes
+	if (strcmp(argv[0], "restoreState") == 0) {
+		if ((theTransientAnalysis != 0 || theVariableTimeStepTransientAnalysis != 0) &&
+			theTransientIntegrator != 0 && theTransientIntegrator->domainChanged() < 0) {
+			opserr << "WARNING restoreState - the integrator failed to take state " << id << "\n";
+			return TCL_ERROR;
+		}
+	}
+
+	return TCL_OK;
+}
+
 
 /*
 int
@@ -9434,6 +9687,125 @@ getNP(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
 	return TCL_OK;
 }
 
+// threads <numThreads>
+//   sweeps the elements of the domain with numThreads threads, which also
+//   assemble the system of equations of the analysis; returns the number
+//   of threads
+int
+setNumThreads(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+	if (argc > 2) {
+		opserr << "WARNING want - threads <numThreads>\n";
+		return TCL_ERROR;
+	}
+
+	if (argc == 2) {
+		int num;
+		if (Tcl_GetInt(interp, argv[1], &num) != TCL_OK || num < 1) {
+			opserr << "WARNING threads - invalid number of threads " << argv[1] << "\n";
+			return TCL_ERROR;
+		}
+
+#ifdef _PARALLEL_PROCESSING
+		if (checkThreadSupport(num) != 0)
+			return TCL_ERROR;
+#endif
+		if (theDomain.setNumThreads(num) != 0)
+			return TCL_ERROR;
+		numThreads = num;
+
+		if (theAnalysisModel != 0)
+			theAnalysisModel->setNumThreads(numThreads);
+		if (theStaticAnalysis != 0 && theStaticIntegrator != 0)
+			theStaticIntegrator->setNumThreads(numThreads);
+		else if (theTransientAnalysis != 0 && theTransientIntegrator != 0)
+			theTransientIntegrator->setNumThreads(numThreads);
+	}
+
+	char buffer[30];
+	sprintf(buffer, "%d", numThreads);
+	Tcl_SetResult(interp, buffer, TCL_VOLATILE);
+
+	return TCL_OK;
+}
+
+// nodalStateStore ?on|off?
+//   keeps the response of the nodes in a contiguous NodalStateStore; with
+//   no argument returns 1 if the store is in use
+int
+nodalStateStore(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+	if (argc > 2) {
+		opserr << "WARNING want - nodalStateStore ?on|off?\n";
+		return TCL_ERROR;
+	}
+
+	if (argc == 2) {
+		int useStore;
+		if (Tcl_GetBoolean(interp, argv[1], &useStore) != TCL_OK) {
+			opserr << "WARNING want - nodalStateStore on|off\n";
+			return TCL_ERROR;
+		}
+		if (theDomain.setNodalStateStore(useStore != 0) != 0)
+			return TCL_ERROR;
+	}
+
+	Tcl_SetResult(interp, (char*)(theDomain.getNodalStateStore() != 0 ? "1" : "0"), TCL_VOLATILE);
+
+	return TCL_OK;
+}
+
+// recorderWriter on ?-buffer MB? ?-flush seconds?
+// recorderWriter off
+//   writes the rows of the file recorders from a background thread, with a
+//   ring buffer of the given size and the files flushed at most every given
+//   number of seconds (0 when the writer catches up); off writes out the
+//   rows queued. With no argument returns 1 if the writer is running
+int
+recorderWriter(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+	if (argc >= 2) {
+		int useWriter;
+		if (Tcl_GetBoolean(interp, argv[1], &useWriter) != TCL_OK) {
+			opserr << "WARNING want - recorderWriter on|off ?-buffer MB? ?-flush seconds?\n";
+			return TCL_ERROR;
+		}
+
+		if (useWriter == 0)
+			AsyncStreamWriter::stop();
+		else {
+			double bufferSize = 8.0;
+			double flushInterval = 1.0;
+			for (int i = 2; i < argc; i++) {
+				if (strcmp(argv[i], "-buffer") == 0 && i + 1 < argc) {
+					if (Tcl_GetDouble(interp, argv[++i], &bufferSize) != TCL_OK || bufferSize <= 0.0) {
+						opserr << "WARNING recorderWriter - invalid buffer size " << argv[i] << "\n";
+						return TCL_ERROR;
+					}
+				}
+				else if (strcmp(argv[i], "-flush") == 0 && i + 1 < argc) {
+					if (Tcl_GetDouble(interp, argv[++i], &flushInterval) != TCL_OK || flushInterval < 0.0) {
+						opserr << "WARNING recorderWriter - invalid flush interval " << argv[i] << "\n";
+						return TCL_ERROR;
+					}
+				}
+				else {
+					opserr << "WARNING recorderWriter - unknown option " << argv[i] << "\n";
+					return TCL_ERROR;
+				}
+			}
+
+			int numDoubles = (int)(bufferSize * 1048576.0 / sizeof(double));
+			if (AsyncStreamWriter::start(numDoubles, flushInterval) != 0)
+				return TCL_ERROR;
+		}
+	}
+
+	Tcl_SetResult(interp, (char*)(AsyncStreamWriter::isRunning() ? "1" : "0"), TCL_VOLATILE);
+
+	return TCL_OK;
+}
+
 int
 getNumElements(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
 {
@@ -147,10 +147,12 @@ extern int		Tclxttest_Init _ANSI_ARGS_((Tcl_Interp *interp));
 
 extern void g3TclMain(int argc, char **argv, Tcl_AppInitProc *appInitProc, int rank, int np);
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <PartitionedDomain.h>
 #include <MPI_MachineBroker.h>
+#include <SharedMemoryMachineBroker.h>
 #include <ShadowSubdomain.h>
 #include <ActorSubdomain.h>
 #include <FEM_ObjectBrokerAllClasses.h>
@@ -181,12 +183,39 @@ extern int OPS_np;
 
 #include <mpi.h>
 
+//
+// OpenSeesSP runs its processes under MPI, or on one machine without MPI
+// when started as
+//   OpenSeesSP -sharedMemory np ?script? ...
+// the processes then being started by a SharedMemoryMachineBroker as
+// they are needed, each running this program with the arguments the
+// broker adds for it.
+//
+
 int
 main(int argc, char **argv)
 {
-  theMachineBroker = new MPI_MachineBroker(0, argc, argv);
   FEM_ObjectBrokerAllClasses theBroker;
-  theMachineBroker->setObjectBroker(&theBroker);
+
+  if (argc >= 5 && strcmp(argv[1], "4") == 0) {
+    // an actor process started by a SharedMemoryMachineBroker
+    theMachineBroker = new SharedMemoryMachineBroker(&theBroker, argc, argv);
+  } else if (argc >= 3 && strcmp(argv[1], "-sharedMemory") == 0) {
+    int np = atoi(argv[2]);
+    if (np < 1) {
+      fprintf(stderr, "WARNING OpenSeesSP -sharedMemory np - invalid number of processes %s\n", argv[2]);
+      return -1;
+    }
+    theMachineBroker = new SharedMemoryMachineBroker(&theBroker, argv[0], np);
+
+    // the interpreter gets the remaining arguments
+    for (int i = 3; i <= argc; i++)
+      argv[i-2] = argv[i];
+    argc -= 2;
+  } else {
+    theMachineBroker = new MPI_MachineBroker(0, argc, argv);
+    theMachineBroker->setObjectBroker(&theBroker);
+  }
 
   OPS_rank = theMachineBroker->getPID();
   OPS_np = theMachineBroker->getNP();
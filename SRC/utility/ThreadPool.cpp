@@ -0,0 +1,120 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the implementation of ThreadPool.
+//
+#include <ThreadPool.h>
+
+ThreadPool::ThreadPool(int nThreads)
+  :numThreads(nThreads < 1 ? 1 : nThreads),
+   currentTask(0), numTasks(0), nextTask(0), numPending(0),
+   generation(0), shutdown(false)
+{
+  // thread 0 is the caller of run(), only the others are spawned
+  for (int i = 1; i < numThreads; i++)
+    theWorkers.emplace_back(&ThreadPool::work, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(theMutex);
+    shutdown = true;
+  }
+  startCondition.notify_all();
+
+  for (std::thread &worker : theWorkers)
+    worker.join();
+}
+
+int
+ThreadPool::getNumThreads(void) const
+{
+  return numThreads;
+}
+
+int
+ThreadPool::getNumHardwareThreads(void)
+{
+  int n = std::thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+void
+ThreadPool::run(int nTasks, const Task &task)
+{
+  if (nTasks <= 0)
+    return;
+
+  // nothing to share; execute in order on the caller
+  if (numThreads == 1 || nTasks == 1) {
+    for (int i = 0; i < nTasks; i++)
+      task(i, 0);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(theMutex);
+    currentTask = &task;
+    numTasks    = nTasks;
+    nextTask.store(0);
+    numPending  = numThreads - 1;
+    generation++;
+  }
+  startCondition.notify_all();
+
+  this->drain(0);
+
+  std::unique_lock<std::mutex> lock(theMutex);
+  doneCondition.wait(lock, [this] { return numPending == 0; });
+  currentTask = 0;
+}
+
+void
+ThreadPool::drain(int threadID)
+{
+  int i;
+  while ((i = nextTask.fetch_add(1)) < numTasks)
+    (*currentTask)(i, threadID);
+}
+
+void
+ThreadPool::work(int threadID)
+{
+  unsigned long lastGeneration = 0;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(theMutex);
+      startCondition.wait(lock, [&] { return shutdown || generation != lastGeneration; });
+      if (shutdown)
+        return;
+      lastGeneration = generation;
+    }
+
+    this->drain(threadID);
+
+    {
+      std::lock_guard<std::mutex> lock(theMutex);
+      if (--numPending == 0)
+        doneCondition.notify_one();
+    }
+  }
+}
@@ -0,0 +1,75 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+//
+// Description: This file contains the class definition for ThreadPool.
+// A ThreadPool is a fixed set of worker threads that cooperatively
+// execute a range of independent tasks. The thread invoking run() takes
+// part in the work, so a pool of size 1 creates no threads and simply
+// executes the tasks in order on the caller.
+//
+// run() must not be invoked from inside a task of the same pool.
+//
+#ifndef ThreadPool_h
+#define ThreadPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+  public:
+    // the task is invoked as task(taskIndex, threadID), 0 <= threadID < numThreads
+    typedef std::function<void(int, int)> Task;
+
+    ThreadPool(int numThreads);
+    ~ThreadPool();
+
+    int getNumThreads(void) const;
+
+    // invoke task(i, threadID) for every i in [0, numTasks) and return
+    // once all of them have completed
+    void run(int numTasks, const Task &task);
+
+    static int getNumHardwareThreads(void);
+
+  private:
+    void work(int threadID);
+    void drain(int threadID);
+
+    int numThreads;
+    std::vector<std::thread> theWorkers;
+
+    std::mutex              theMutex;
+    std::condition_variable startCondition;
+    std::condition_variable doneCondition;
+
+    const Task       *currentTask;
+    int               numTasks;
+    std::atomic<int>  nextTask;
+    int               numPending;   // workers still draining the current batch
+    unsigned long     generation;   // incremented for each batch handed out
+    bool              shutdown;
+};
+
+#endif
@@ -0,0 +1,235 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: a microbenchmark of the fixed-size MatrixND and VectorND
+// against Matrix and Vector, for the kernels of the element and
+// coordinate transformation code that use them: the products of B and
+// D, the triple products B'DB and T'KT, the 6x6 inverse and the matrix
+// vector product. Each kernel is first checked against Matrix on the
+// same values and then timed with both; every repetition perturbs the
+// input by its result, so that the compiler cannot drop or hoist the
+// work. The kernels are reported in ns per call.
+//
+// Usage: benchMatrixND [scale]
+//   scale - multiplies the number of repetitions (default 1.0)
+
+#include <StandardStream.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <MatrixND.h>
+#include <VectorND.h>
+
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+// the result of each benchmark is added to this, so it is not optimized away
+static volatile double sink = 0.0;
+
+static double scale = 1.0;
+
+template <int NR, int NC>
+static void
+fill(MatrixND<NR,NC> &a, Matrix &m)
+{
+  for (int j = 0; j < NC; j++)
+    for (int i = 0; i < NR; i++)
+      a(i,j) = m(i,j) = (rand()%2000 - 1000)/100.0;
+}
+
+template <int NR, int NC>
+static double
+maxDiff(const MatrixND<NR,NC> &a, const Matrix &m)
+{
+  double diff = 0.0;
+  for (int j = 0; j < NC; j++)
+    for (int i = 0; i < NR; i++)
+      diff = fmax(diff, fabs(a(i,j) - m(i,j)));
+  return diff;
+}
+
+static double
+maxAbs(const Matrix &m)
+{
+  double size = 0.0;
+  for (int j = 0; j < m.noCols(); j++)
+    for (int i = 0; i < m.noRows(); i++)
+      size = fmax(size, fabs(m(i,j)));
+  return size;
+}
+
+template <int N>
+static double
+maxDiff(const VectorND<N> &a, const Vector &v)
+{
+  double diff = 0.0;
+  for (int i = 0; i < N; i++)
+    diff = fmax(diff, fabs(a(i) - v(i)));
+  return diff;
+}
+
+// times numReps calls of each of two kernels and prints the ns per call
+template <class M, class ND>
+static void
+bench(const char *name, int numReps, M matrixKernel, ND matrixNDKernel)
+{
+  numReps = (int)(numReps*scale);
+  if (numReps < 1)
+    numReps = 1;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < numReps; r++)
+    matrixKernel(r);
+  auto t1 = std::chrono::steady_clock::now();
+  for (int r = 0; r < numReps; r++)
+    matrixNDKernel(r);
+  auto t2 = std::chrono::steady_clock::now();
+
+  double tM = std::chrono::duration<double, std::nano>(t1 - t0).count()/numReps;
+  double tND = std::chrono::duration<double, std::nano>(t2 - t1).count()/numReps;
+  opserr << name << ": Matrix " << tM << " ns, MatrixND " << tND
+	 << " ns, speedup " << tM/tND << endln;
+}
+
+// returns the number of kernels that do not agree with Matrix
+static int
+check(const char *name, double diff, double size)
+{
+  if (diff > 1.0e-12*(1.0 + size)) {
+    opserr << name << " differs from Matrix by " << diff << endln;
+    return 1;
+  }
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  if (argc > 1)
+    scale = atof(argv[1]);
+
+  srand(1);
+
+  MatrixND<3,6> A; Matrix Am(3,6);
+  MatrixND<6,6> D; Matrix Dm(6,6);
+  MatrixND<6,3> B; Matrix Bm(6,3);
+  MatrixND<12,12> T; Matrix Tm(12,12);
+  MatrixND<12,12> Kl; Matrix Klm(12,12);
+  fill(A, Am);
+  fill(D, Dm);
+  fill(B, Bm);
+  fill(T, Tm);
+  fill(Kl, Klm);
+  for (int i = 0; i < 6; i++) {
+    D(i,i) += 100.0;
+    Dm(i,i) += 100.0;
+  }
+
+  VectorND<6> x; Vector xm(6);
+  for (int i = 0; i < 6; i++)
+    x(i) = xm(i) = i - 2.5;
+
+  MatrixND<3,6> AD; Matrix ADm(3,6);
+  MatrixND<3,6> BtD; Matrix BtDm(3,6);
+  MatrixND<3,3> K; Matrix Km(3,3);
+  MatrixND<12,12> Kg; Matrix Kgm(12,12);
+  MatrixND<6,6> Dinv; Matrix Dinvm(6,6);
+  VectorND<3> y; Vector ym(3);
+
+  //
+  // the kernels must give the results of Matrix
+  //
+
+  int numFaults = 0;
+
+  AD.addMatrixProduct(0.0, A, D, 2.0);
+  ADm.addMatrixProduct(0.0, Am, Dm, 2.0);
+  numFaults += check("A*D", maxDiff(AD, ADm), maxAbs(ADm));
+
+  BtD.addMatrixTransposeProduct(0.0, B, D, 1.5);
+  BtDm.addMatrixTransposeProduct(0.0, Bm, Dm, 1.5);
+  numFaults += check("B'*D", maxDiff(BtD, BtDm), maxAbs(BtDm));
+
+  K.addMatrixTripleProduct(0.0, B, D, 1.0);
+  Km.addMatrixTripleProduct(0.0, Bm, Dm, 1.0);
+  K.addMatrixTripleProduct(1.0, B, D, 0.5);
+  Km.addMatrixTripleProduct(1.0, Bm, Dm, 0.5);
+  numFaults += check("B'*D*B", maxDiff(K, Km), maxAbs(Km));
+
+  Kg.addMatrixTripleProduct(0.0, T, Kl, 1.0);
+  Kgm.addMatrixTripleProduct(0.0, Tm, Klm, 1.0);
+  numFaults += check("T'*K*T", maxDiff(Kg, Kgm), maxAbs(Kgm));
+
+  D.Invert(Dinv);
+  Dm.Invert(Dinvm);
+  numFaults += check("inv(D)", maxDiff(Dinv, Dinvm), maxAbs(Dinvm));
+
+  y.addMatrixVector(0.0, A, x, 1.0);
+  ym.addMatrixVector(0.0, Am, xm, 1.0);
+  numFaults += check("A*x", maxDiff(y, ym), ym.Norm());
+
+  // a MatrixND is viewed as a Matrix without a copy
+  Matrix view = Kg;
+  if (&view(0,0) != &Kg(0,0)) {
+    opserr << "a MatrixND is copied when viewed as a Matrix\n";
+    numFaults++;
+  }
+
+  //
+  // the timings; each repetition feeds its result back into an input
+  //
+
+  bench("3x6 * 6x6 product", 2000000,
+	[&](int r) {ADm.addMatrixProduct(0.0, Am, Dm, 1.0); Dm(r%6, (r/6)%6) += 1.0e-9*ADm(2,5);},
+	[&](int r) {AD.addMatrixProduct(0.0, A, D, 1.0); D(r%6, (r/6)%6) += 1.0e-9*AD(2,5);});
+
+  bench("B'D (6x3, 6x6)", 2000000,
+	[&](int r) {BtDm.addMatrixTransposeProduct(0.0, Bm, Dm, 1.0); Dm(r%6, (r/6)%6) += 1.0e-9*BtDm(2,5);},
+	[&](int r) {BtD.addMatrixTransposeProduct(0.0, B, D, 1.0); D(r%6, (r/6)%6) += 1.0e-9*BtD(2,5);});
+
+  bench("B'DB, 3x3 result", 2000000,
+	[&](int r) {Km.addMatrixTripleProduct(0.0, Bm, Dm, 1.0); Dm(r%6, (r/6)%6) += 1.0e-12*Km(2,2);},
+	[&](int r) {K.addMatrixTripleProduct(0.0, B, D, 1.0); D(r%6, (r/6)%6) += 1.0e-12*K(2,2);});
+
+  bench("T'KT, 12x12", 200000,
+	[&](int r) {Kgm.addMatrixTripleProduct(0.0, Tm, Klm, 1.0); Klm(r%12, (r/12)%12) += 1.0e-15*Kgm(11,11);},
+	[&](int r) {Kg.addMatrixTripleProduct(0.0, T, Kl, 1.0); Kl(r%12, (r/12)%12) += 1.0e-15*Kg(11,11);});
+
+  bench("6x6 inverse", 1000000,
+	[&](int r) {Dm.Invert(Dinvm); Dm(r%6, r%6) += 1.0e-12*Dinvm(0,0);},
+	[&](int r) {D.Invert(Dinv); D(r%6, r%6) += 1.0e-12*Dinv(0,0);});
+
+  bench("3x6 matrix-vector", 5000000,
+	[&](int r) {ym.addMatrixVector(0.0, Am, xm, 1.0); xm(r%6) += 1.0e-12*ym(r%3);},
+	[&](int r) {y.addMatrixVector(0.0, A, x, 1.0); x(r%6) += 1.0e-12*y(r%3);});
+
+  sink = AD(0,0) + ADm(0,0) + BtD(0,0) + BtDm(0,0) + K(0,0) + Km(0,0) +
+    Kg(1,1) + Kgm(1,1) + Dinv(0,0) + Dinvm(0,0) + y(0) + ym(0);
+
+  if (numFaults == 0)
+    opserr << "PASSED\n";
+  else
+    opserr << "FAILED - " << numFaults << " kernels differ from Matrix\n";
+
+  return numFaults == 0 ? 0 : -1;
+}